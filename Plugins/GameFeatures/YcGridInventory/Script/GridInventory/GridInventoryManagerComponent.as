@@ -54,6 +54,9 @@ class UGridInventoryManagerComponent : UYcInventoryManagerComponent
 	UPROPERTY(Replicated)
 	int32 InventoryGridRevision = 0;
 	TMap<UYcInventoryItemInstance, FItemGridInfo> ItemInstanceToTileMap;
+	// 原生占用表（每行一个位掩码）：服务端随放置/移除增量维护，客户端在网格版本号变化后按 InventorySlots 重建
+	FYcGridOccupancy Occupancy;
+	private int32 OccupancyRevision = -1;
 
 	UPROPERTY()
 	FInventoryGridChanged OnInventoryGridChanged;
@@ -140,6 +143,8 @@ class UGridInventoryManagerComponent : UYcInventoryManagerComponent
 		{
 			InventorySlots[i].Reset();
 		}
+		Occupancy.InitOccupancy(InventoryColumns, InventoryRows);
+		OccupancyRevision = -1;
 	}
 	UFUNCTION()
 	void OnInventoryChanged(FGameplayTag ActualTag, FYcInventoryItemChangeMessage Data)
@@ -219,6 +224,7 @@ class UGridInventoryManagerComponent : UYcInventoryManagerComponent
 				bValidRemove = true;
 			}
 		}
+		Occupancy.RemoveItem(ItemInst);
 		RemoveItemInstance(ItemInst);
 		return bValidRemove;
 	}
@@ -254,7 +260,9 @@ class UGridInventoryManagerComponent : UYcInventoryManagerComponent
 				InventorySlots[Index].ItemRelativeY = Y - Tile.Y;
 			}
 		}
+		Occupancy.PlaceItem(ItemInst, Tile, FIntPoint(ItemWidth, ItemHeight));
 		InventoryGridRevision++;
+		OccupancyRevision = InventoryGridRevision;
 		OnInventoryGridChanged.Broadcast();
 		return true;
 	}
@@ -265,6 +273,7 @@ class UGridInventoryManagerComponent : UYcInventoryManagerComponent
 		{
 			return;
 		}
+		EnsureOccupancy();
 		auto ItemGridInfo = ItemInstanceToTileMap[ItemInst];
 		for (int X = ItemGridInfo.TilePos.X; X < ItemGridInfo.TilePos.X + ItemGridInfo.ItemSize.X; X++)
 		{
@@ -275,7 +284,9 @@ class UGridInventoryManagerComponent : UYcInventoryManagerComponent
 			}
 		}
 		ItemInstanceToTileMap.Remove(ItemInst);
+		Occupancy.RemoveItem(ItemInst);
 		InventoryGridRevision++;
+		OccupancyRevision = InventoryGridRevision;
 		OnInventoryGridChanged.Broadcast();
 	}
 
@@ -646,20 +657,8 @@ class UGridInventoryManagerComponent : UYcInventoryManagerComponent
 			return false;
 		}
 
-		for (int32 i = 0; i < ContainerInventory.InventorySlots.Num(); i++)
-		{
-			auto Slot = ContainerInventory.InventorySlots[i];
-			if (!Slot.bOccupied || Slot.ItemInstance == nullptr)
-			{
-				continue;
-			}
-			if (Slot.ItemInstance == ItemInst)
-			{
-				return true;
-			}
-		}
-
-		return false;
+		// 仅在服务端调用，服务端占用表始终与格子同步
+		return ContainerInventory.Occupancy.ContainsItem(ItemInst);
 	}
 
 	private void RebuildSearchQueueFromContainerPreserveCurrent()
@@ -1134,59 +1133,30 @@ class UGridInventoryManagerComponent : UYcInventoryManagerComponent
 		}
 		return Items;
 	}
+	// 按行优先顺序查找第一个可放置位置（先不旋转，再旋转）
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	bool FindFirstFitPosition(FDataRegistryId ItemDefId, FIntPoint&out Tile, bool&out OutRotated)
 	{
 		auto IF_Grid = GetItemFragmentGrid(ItemDefId);
-		for (int32 Y = 0; Y < InventoryRows; Y++)
-		{
-			for (int32 X = 0; X < InventoryColumns; X++)
-			{
-				if (CanPlaceGridItem(ItemDefId, FIntPoint(X, Y), false))
-				{
-					Tile = FIntPoint(X, Y);
-					OutRotated = false;
-					return true;
-				}
-			}
-		}
-
-		if (!IF_Grid.bCanRotate)
-			return false;
-		for (int32 Y = 0; Y < InventoryRows; Y++)
-		{
-			for (int32 X = 0; X < InventoryColumns; X++)
-			{
-				if (CanPlaceGridItem(ItemDefId, FIntPoint(X, Y), true))
-				{
-					Tile = FIntPoint(X, Y);
-					OutRotated = true;
-					return true;
-				}
-			}
-		}
-		return false;
-	};
+		EnsureOccupancy();
+		return Occupancy.FindFirstFit(IF_Grid.Dimensions, IF_Grid.bCanRotate, Tile, OutRotated);
+	}
+	// 查找与边界/已有物品贴合最紧的位置，适合整理时减少碎片
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool FindBestFitPosition(FDataRegistryId ItemDefId, FIntPoint&out Tile, bool&out OutRotated)
+	{
+		auto IF_Grid = GetItemFragmentGrid(ItemDefId);
+		EnsureOccupancy();
+		return Occupancy.FindBestFit(IF_Grid.Dimensions, IF_Grid.bCanRotate, Tile, OutRotated);
+	}
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	bool CanPlaceGridItem(FDataRegistryId ItemDefId, FIntPoint Tile, bool bRotated = false)
 	{
 		auto IF_Grid = GetItemFragmentGrid(ItemDefId);
 		int32 ItemWidth = bRotated ? IF_Grid.Dimensions.Y : IF_Grid.Dimensions.X;
 		int32 ItemHeight = bRotated ? IF_Grid.Dimensions.X : IF_Grid.Dimensions.Y;
-		if (Tile.X < 0 || Tile.Y < 0 || Tile.X + ItemWidth > InventoryColumns || Tile.Y + ItemHeight > InventoryRows)
-		{
-			return false;
-		}
-		for (int32 Y = Tile.Y; Y < Tile.Y + ItemHeight; Y++)
-		{
-			for (int32 X = Tile.X; X < Tile.X + ItemWidth; X++)
-			{
-				int32 Index = TileToIndex(FIntPoint(X, Y));
-				if (InventorySlots[Index].bOccupied)
-					return false;
-			}
-		}
-		return true;
+		EnsureOccupancy();
+		return Occupancy.CanPlace(Tile, FIntPoint(ItemWidth, ItemHeight), nullptr);
 	}
 
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
@@ -1200,28 +1170,61 @@ class UGridInventoryManagerComponent : UYcInventoryManagerComponent
 		auto IF_Grid = GetItemFragmentGrid(ItemInst.ItemRegistryId);
 		int32 ItemWidth = bRotated ? IF_Grid.Dimensions.Y : IF_Grid.Dimensions.X;
 		int32 ItemHeight = bRotated ? IF_Grid.Dimensions.X : IF_Grid.Dimensions.Y;
-		if (Tile.X < 0 || Tile.Y < 0 || Tile.X + ItemWidth > InventoryColumns || Tile.Y + ItemHeight > InventoryRows)
+		EnsureOccupancy();
+		return Occupancy.CanPlace(Tile, FIntPoint(ItemWidth, ItemHeight), ItemInst);
+	}
+
+	// 两个物品能否同时移动到各自的新位置（例如互换），ItemB 为空时等价于只移动 ItemA
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool CanSwapGridItems(UYcInventoryItemInstance ItemA, FIntPoint TileA, bool bRotatedA, UYcInventoryItemInstance ItemB, FIntPoint TileB, bool bRotatedB)
+	{
+		if (ItemA == nullptr)
 		{
 			return false;
 		}
-		for (int32 Y = Tile.Y; Y < Tile.Y + ItemHeight; Y++)
+		auto GridA = GetItemFragmentGrid(ItemA.ItemRegistryId);
+		FIntPoint SizeA = bRotatedA ? FIntPoint(GridA.Dimensions.Y, GridA.Dimensions.X) : GridA.Dimensions;
+		FIntPoint SizeB = FIntPoint(0, 0);
+		if (ItemB != nullptr)
 		{
-			for (int32 X = Tile.X; X < Tile.X + ItemWidth; X++)
+			auto GridB = GetItemFragmentGrid(ItemB.ItemRegistryId);
+			SizeB = bRotatedB ? FIntPoint(GridB.Dimensions.Y, GridB.Dimensions.X) : GridB.Dimensions;
+		}
+		EnsureOccupancy();
+		return Occupancy.CanSwap(ItemA, TileA, SizeA, ItemB, TileB, SizeB);
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	UYcInventoryItemInstance GetGridItemAt(FIntPoint Tile)
+	{
+		EnsureOccupancy();
+		return Occupancy.GetItemAt(Tile);
+	}
+
+	// 客户端的 InventorySlots 来自复制，网格版本号变化后按格子重建占用表
+	private void EnsureOccupancy()
+	{
+		if (OccupancyRevision == InventoryGridRevision)
+		{
+			return;
+		}
+
+		Occupancy.InitOccupancy(InventoryColumns, InventoryRows);
+		for (int32 i = 0; i < InventorySlots.Num(); i++)
+		{
+			if (InventorySlots[i].bOccupied)
 			{
-				int32 Index = TileToIndex(FIntPoint(X, Y));
-				if (InventorySlots[Index].bOccupied && InventorySlots[Index].ItemInstance != ItemInst)
-					return false;
+				Occupancy.MarkCell(InventorySlots[i].ItemInstance, IndexToTile(i));
 			}
 		}
-		return true;
+		OccupancyRevision = InventoryGridRevision;
 	}
 
 	UFUNCTION(BlueprintPure)
 	FItemFragment_GridItem GetItemFragmentGrid(FDataRegistryId ItemDefId)
 	{
-		FYcInventoryItemDefinition ItemDef;
-		YcInventory::GetItemDefinition(ItemDefId, ItemDef);
-		FInstancedStruct Result = YcInventory::FindItemFragment(ItemDef, FItemFragment_GridItem);
+		// 按Id直接在DataRegistry缓存的定义上查找, 避免先拷贝整个物品定义
+		FInstancedStruct Result = YcInventory::FindItemFragmentById(ItemDefId, FItemFragment_GridItem);
 		if (!Result.IsValid())
 		{
 			return FItemFragment_GridItem();
@@ -0,0 +1,435 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Grid/YcGridOccupancy.h"
+
+#include "YcInventoryItemInstance.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcGridOccupancy)
+
+namespace
+{
+	/** 低 Width 位全为 1。 / Mask with the low Width bits set. */
+	uint64 LowBits(const int32 Width)
+	{
+		return Width >= 64 ? ~0ull : ((1ull << Width) - 1);
+	}
+
+	/** 矩形在所覆盖的行中的列掩码。 / Column mask of a rectangle within each covered row. */
+	uint64 RectRowMask(const FIntPoint Tile, const FIntPoint Size)
+	{
+		return Size.X > 0 ? LowBits(Size.X) << Tile.X : 0;
+	}
+
+	bool CoversRow(const FIntPoint Tile, const FIntPoint Size, const int32 Y)
+	{
+		return Y >= Tile.Y && Y < Tile.Y + Size.Y;
+	}
+}
+
+// ==================== FYcGridOccupancy ====================
+
+void FYcGridOccupancy::Init(const int32 InColumns, const int32 InRows)
+{
+	ensureMsgf(InColumns <= MaxColumns, TEXT("FYcGridOccupancy supports at most %d columns, got %d."), MaxColumns, InColumns);
+	Columns = FMath::Clamp(InColumns, 0, MaxColumns);
+	Rows = FMath::Max(InRows, 0);
+	Reset();
+}
+
+void FYcGridOccupancy::Reset()
+{
+	RowBits.Reset();
+	RowBits.SetNumZeroed(Rows);
+	CellItems.Reset();
+	CellItems.Init(INDEX_NONE, Columns * Rows);
+	Items.Reset();
+	FreeItemIndices.Reset();
+	ItemSlots.Reset();
+}
+
+bool FYcGridOccupancy::IsInBounds(const FIntPoint Tile, const FIntPoint Size) const
+{
+	return Tile.X >= 0 && Tile.Y >= 0 && Tile.X + Size.X <= Columns && Tile.Y + Size.Y <= Rows;
+}
+
+uint64 FYcGridOccupancy::GetItemRowBits(const int32 ItemIndex, const int32 Y) const
+{
+	if (ItemIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	// 按格子归属取位（MarkCell 重建出的包围盒内可能混有其他物品的格子）
+	const FYcGridOccupancyItem& Record = Items[ItemIndex];
+	if (!CoversRow(Record.Tile, Record.Size, Y))
+	{
+		return 0;
+	}
+	uint64 Bits = 0;
+	for (int32 X = Record.Tile.X; X < Record.Tile.X + Record.Size.X; ++X)
+	{
+		if (CellItems[Y * Columns + X] == ItemIndex)
+		{
+			Bits |= 1ull << X;
+		}
+	}
+	return Bits;
+}
+
+int32 FYcGridOccupancy::FindItemIndex(const UYcInventoryItemInstance* Item) const
+{
+	const int32* Index = Item ? ItemSlots.Find(Item) : nullptr;
+	return Index ? *Index : INDEX_NONE;
+}
+
+bool FYcGridOccupancy::CanPlace(const FIntPoint Tile, const FIntPoint Size, const UYcInventoryItemInstance* IgnoredItem) const
+{
+	if (!IsInBounds(Tile, Size))
+	{
+		return false;
+	}
+
+	const int32 IgnoredIndex = FindItemIndex(IgnoredItem);
+	const uint64 Mask = RectRowMask(Tile, Size);
+	for (int32 Y = Tile.Y; Y < Tile.Y + Size.Y; ++Y)
+	{
+		if (RowBits[Y] & ~GetItemRowBits(IgnoredIndex, Y) & Mask)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FYcGridOccupancy::ForEachFitCandidates(const FIntPoint Size, TFunctionRef<bool(int32 Y, uint64 Candidates)> Visitor) const
+{
+	if (Size.X <= 0 || Size.Y <= 0 || Size.X > Columns || Size.Y > Rows)
+	{
+		return;
+	}
+
+	// 每行第 X 位为 1 表示从第 X 列开始有连续 Size.X 个空格：空闲位与自身右移相与，每次把已覆盖长度翻倍
+	TArray<uint64, TInlineAllocator<64>> RunMasks;
+	RunMasks.SetNumUninitialized(Rows);
+	const uint64 ColumnMask = LowBits(Columns);
+	for (int32 Y = 0; Y < Rows; ++Y)
+	{
+		uint64 Run = ~RowBits[Y] & ColumnMask;
+		for (int32 Covered = 1; Covered < Size.X && Run; )
+		{
+			const int32 Shift = FMath::Min(Covered, Size.X - Covered);
+			Run &= Run >> Shift;
+			Covered += Shift;
+		}
+		RunMasks[Y] = Run;
+	}
+
+	for (int32 Y = 0; Y + Size.Y <= Rows; ++Y)
+	{
+		uint64 Candidates = RunMasks[Y];
+		for (int32 Offset = 1; Offset < Size.Y && Candidates; ++Offset)
+		{
+			Candidates &= RunMasks[Y + Offset];
+		}
+		if (Candidates && Visitor(Y, Candidates))
+		{
+			return;
+		}
+	}
+}
+
+bool FYcGridOccupancy::FindFirstFit(const FIntPoint Size, const bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated) const
+{
+	auto FindInOrientation = [this, &OutTile, &bOutRotated](const FIntPoint OrientedSize, const bool bRotated)
+	{
+		bool bFound = false;
+		ForEachFitCandidates(OrientedSize, [&](const int32 Y, const uint64 Candidates)
+		{
+			OutTile = FIntPoint(static_cast<int32>(FMath::CountTrailingZeros64(Candidates)), Y);
+			bOutRotated = bRotated;
+			bFound = true;
+			return true;
+		});
+		return bFound;
+	};
+
+	return FindInOrientation(Size, false) || (bCanRotate && FindInOrientation(FIntPoint(Size.Y, Size.X), true));
+}
+
+int32 FYcGridOccupancy::ScoreContact(const FIntPoint Tile, const FIntPoint Size) const
+{
+	const uint64 Mask = RectRowMask(Tile, Size);
+	const int32 Bottom = Tile.Y + Size.Y;
+	const int32 Right = Tile.X + Size.X;
+
+	int32 Score = 0;
+	Score += Tile.Y == 0 ? Size.X : FMath::CountBits(RowBits[Tile.Y - 1] & Mask);
+	Score += Bottom == Rows ? Size.X : FMath::CountBits(RowBits[Bottom] & Mask);
+	for (int32 Y = Tile.Y; Y < Bottom; ++Y)
+	{
+		Score += Tile.X == 0 ? 1 : static_cast<int32>((RowBits[Y] >> (Tile.X - 1)) & 1);
+		Score += Right == Columns ? 1 : static_cast<int32>((RowBits[Y] >> Right) & 1);
+	}
+	return Score;
+}
+
+bool FYcGridOccupancy::FindBestFit(const FIntPoint Size, const bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated) const
+{
+	int32 BestScore = INDEX_NONE;
+	auto ScoreOrientation = [&](const FIntPoint OrientedSize, const bool bRotated)
+	{
+		ForEachFitCandidates(OrientedSize, [&](const int32 Y, uint64 Candidates)
+		{
+			while (Candidates)
+			{
+				const FIntPoint Tile(static_cast<int32>(FMath::CountTrailingZeros64(Candidates)), Y);
+				Candidates &= Candidates - 1;
+
+				const int32 Score = ScoreContact(Tile, OrientedSize);
+				if (Score > BestScore)
+				{
+					BestScore = Score;
+					OutTile = Tile;
+					bOutRotated = bRotated;
+				}
+			}
+			return false;
+		});
+	};
+
+	ScoreOrientation(Size, false);
+	if (bCanRotate)
+	{
+		ScoreOrientation(FIntPoint(Size.Y, Size.X), true);
+	}
+	return BestScore != INDEX_NONE;
+}
+
+bool FYcGridOccupancy::CanSwap(const UYcInventoryItemInstance* ItemA, const FIntPoint TileA, const FIntPoint SizeA,
+	const UYcInventoryItemInstance* ItemB, const FIntPoint TileB, const FIntPoint SizeB) const
+{
+	if (!IsInBounds(TileA, SizeA) || (ItemB && !IsInBounds(TileB, SizeB)))
+	{
+		return false;
+	}
+
+	// 不在本表中的物品（跨库存移动）没有需要忽略的格子
+	const int32 IndexA = FindItemIndex(ItemA);
+	const int32 IndexB = FindItemIndex(ItemB);
+	auto RowWithoutBoth = [&](const int32 Y)
+	{
+		return RowBits[Y] & ~GetItemRowBits(IndexA, Y) & ~GetItemRowBits(IndexB, Y);
+	};
+
+	const uint64 MaskA = RectRowMask(TileA, SizeA);
+	for (int32 Y = TileA.Y; Y < TileA.Y + SizeA.Y; ++Y)
+	{
+		if (RowWithoutBoth(Y) & MaskA)
+		{
+			return false;
+		}
+	}
+
+	if (ItemB)
+	{
+		const uint64 MaskB = RectRowMask(TileB, SizeB);
+		for (int32 Y = TileB.Y; Y < TileB.Y + SizeB.Y; ++Y)
+		{
+			const uint64 Bits = RowWithoutBoth(Y) | (CoversRow(TileA, SizeA, Y) ? MaskA : 0);
+			if (Bits & MaskB)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool FYcGridOccupancy::PlaceItem(UYcInventoryItemInstance* Item, const FIntPoint Tile, const FIntPoint Size)
+{
+	if (!Item || Size.X <= 0 || Size.Y <= 0 || !CanPlace(Tile, Size, Item))
+	{
+		return false;
+	}
+
+	RemoveItem(Item);
+
+	const int32 Index = FreeItemIndices.Num() > 0 ? FreeItemIndices.Pop(EAllowShrinking::No) : Items.AddDefaulted();
+	FYcGridOccupancyItem& Record = Items[Index];
+	Record.Item = Item;
+	Record.Tile = Tile;
+	Record.Size = Size;
+	ItemSlots.Add(Item, Index);
+
+	const uint64 Mask = RectRowMask(Tile, Size);
+	for (int32 Y = Tile.Y; Y < Tile.Y + Size.Y; ++Y)
+	{
+		RowBits[Y] |= Mask;
+		for (int32 X = Tile.X; X < Tile.X + Size.X; ++X)
+		{
+			CellItems[Y * Columns + X] = Index;
+		}
+	}
+	return true;
+}
+
+bool FYcGridOccupancy::RemoveItem(const UYcInventoryItemInstance* Item)
+{
+	int32 Index = INDEX_NONE;
+	if (!Item || !ItemSlots.RemoveAndCopyValue(Item, Index))
+	{
+		return false;
+	}
+
+	// 只清理仍归属该物品的格子（MarkCell 重建时包围盒内可能混有其他物品）
+	const FYcGridOccupancyItem& Record = Items[Index];
+	for (int32 Y = Record.Tile.Y; Y < Record.Tile.Y + Record.Size.Y; ++Y)
+	{
+		for (int32 X = Record.Tile.X; X < Record.Tile.X + Record.Size.X; ++X)
+		{
+			int32& CellItem = CellItems[Y * Columns + X];
+			if (CellItem == Index)
+			{
+				CellItem = INDEX_NONE;
+				RowBits[Y] &= ~(1ull << X);
+			}
+		}
+	}
+
+	Items[Index] = FYcGridOccupancyItem();
+	FreeItemIndices.Add(Index);
+	return true;
+}
+
+void FYcGridOccupancy::MarkCell(UYcInventoryItemInstance* Item, const FIntPoint Tile)
+{
+	if (!IsInBounds(Tile, FIntPoint(1, 1)))
+	{
+		return;
+	}
+
+	// 物品尚未复制到时只记占用位
+	RowBits[Tile.Y] |= 1ull << Tile.X;
+	if (!Item)
+	{
+		return;
+	}
+
+	int32 Index = INDEX_NONE;
+	if (const int32* ExistingIndex = ItemSlots.Find(Item))
+	{
+		Index = *ExistingIndex;
+		FYcGridOccupancyItem& Record = Items[Index];
+		const FIntPoint Min = Record.Tile.ComponentMin(Tile);
+		const FIntPoint Max = (Record.Tile + Record.Size).ComponentMax(Tile + FIntPoint(1, 1));
+		Record.Tile = Min;
+		Record.Size = Max - Min;
+	}
+	else
+	{
+		Index = FreeItemIndices.Num() > 0 ? FreeItemIndices.Pop(EAllowShrinking::No) : Items.AddDefaulted();
+		FYcGridOccupancyItem& Record = Items[Index];
+		Record.Item = Item;
+		Record.Tile = Tile;
+		Record.Size = FIntPoint(1, 1);
+		ItemSlots.Add(Item, Index);
+	}
+
+	CellItems[Tile.Y * Columns + Tile.X] = Index;
+}
+
+bool FYcGridOccupancy::IsOccupied(const FIntPoint Tile) const
+{
+	return IsInBounds(Tile, FIntPoint(1, 1)) && ((RowBits[Tile.Y] >> Tile.X) & 1) != 0;
+}
+
+UYcInventoryItemInstance* FYcGridOccupancy::GetItemAt(const FIntPoint Tile) const
+{
+	if (!IsInBounds(Tile, FIntPoint(1, 1)))
+	{
+		return nullptr;
+	}
+	const int32 Index = CellItems[Tile.Y * Columns + Tile.X];
+	return Index != INDEX_NONE ? Items[Index].Item.Get() : nullptr;
+}
+
+const FYcGridOccupancyItem* FYcGridOccupancy::FindItem(const UYcInventoryItemInstance* Item) const
+{
+	const int32 Index = FindItemIndex(Item);
+	return Index != INDEX_NONE ? &Items[Index] : nullptr;
+}
+
+// ==================== UYcGridOccupancyLibrary ====================
+
+void UYcGridOccupancyLibrary::InitOccupancy(FYcGridOccupancy& Occupancy, const int32 Columns, const int32 Rows)
+{
+	Occupancy.Init(Columns, Rows);
+}
+
+void UYcGridOccupancyLibrary::ResetOccupancy(FYcGridOccupancy& Occupancy)
+{
+	Occupancy.Reset();
+}
+
+bool UYcGridOccupancyLibrary::CanPlace(const FYcGridOccupancy& Occupancy, const FIntPoint Tile, const FIntPoint Size, const UYcInventoryItemInstance* IgnoredItem)
+{
+	return Occupancy.CanPlace(Tile, Size, IgnoredItem);
+}
+
+bool UYcGridOccupancyLibrary::FindFirstFit(const FYcGridOccupancy& Occupancy, const FIntPoint Size, const bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated)
+{
+	return Occupancy.FindFirstFit(Size, bCanRotate, OutTile, bOutRotated);
+}
+
+bool UYcGridOccupancyLibrary::FindBestFit(const FYcGridOccupancy& Occupancy, const FIntPoint Size, const bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated)
+{
+	return Occupancy.FindBestFit(Size, bCanRotate, OutTile, bOutRotated);
+}
+
+bool UYcGridOccupancyLibrary::CanSwap(const FYcGridOccupancy& Occupancy, const UYcInventoryItemInstance* ItemA, const FIntPoint TileA, const FIntPoint SizeA,
+	const UYcInventoryItemInstance* ItemB, const FIntPoint TileB, const FIntPoint SizeB)
+{
+	return Occupancy.CanSwap(ItemA, TileA, SizeA, ItemB, TileB, SizeB);
+}
+
+bool UYcGridOccupancyLibrary::PlaceItem(FYcGridOccupancy& Occupancy, UYcInventoryItemInstance* Item, const FIntPoint Tile, const FIntPoint Size)
+{
+	return Occupancy.PlaceItem(Item, Tile, Size);
+}
+
+bool UYcGridOccupancyLibrary::RemoveItem(FYcGridOccupancy& Occupancy, const UYcInventoryItemInstance* Item)
+{
+	return Occupancy.RemoveItem(Item);
+}
+
+void UYcGridOccupancyLibrary::MarkCell(FYcGridOccupancy& Occupancy, UYcInventoryItemInstance* Item, const FIntPoint Tile)
+{
+	Occupancy.MarkCell(Item, Tile);
+}
+
+bool UYcGridOccupancyLibrary::IsOccupied(const FYcGridOccupancy& Occupancy, const FIntPoint Tile)
+{
+	return Occupancy.IsOccupied(Tile);
+}
+
+UYcInventoryItemInstance* UYcGridOccupancyLibrary::GetItemAt(const FYcGridOccupancy& Occupancy, const FIntPoint Tile)
+{
+	return Occupancy.GetItemAt(Tile);
+}
+
+bool UYcGridOccupancyLibrary::GetItemPlacement(const FYcGridOccupancy& Occupancy, const UYcInventoryItemInstance* Item, FIntPoint& OutTile, FIntPoint& OutSize)
+{
+	const FYcGridOccupancyItem* Record = Occupancy.FindItem(Item);
+	if (!Record)
+	{
+		return false;
+	}
+	OutTile = Record->Tile;
+	OutSize = Record->Size;
+	return true;
+}
+
+bool UYcGridOccupancyLibrary::ContainsItem(const FYcGridOccupancy& Occupancy, const UYcInventoryItemInstance* Item)
+{
+	return Occupancy.FindItem(Item) != nullptr;
+}
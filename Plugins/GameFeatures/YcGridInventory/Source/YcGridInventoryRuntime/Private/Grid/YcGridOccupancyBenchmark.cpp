@@ -0,0 +1,446 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Grid/YcGridOccupancy.h"
+#include "YcInventoryItemInstance.h"
+#include "YiChenInventory.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+
+/**
+ * 网格占用表的一致性校验与性能对比（控制台命令）
+ * Consistency checks and benchmark for FYcGridOccupancy (console commands).
+ *
+ * 参照实现逐格移植自 GridInventoryManagerComponent.as 中改造前的 CanPlaceGridItem / CanPlaceGridItemInst / FindFirstFitPosition，
+ * 在随机填充的网格上与位掩码实现逐一比对结果，并在 10×40 仓库网格上计时。
+ * The reference is a cell-by-cell port of the script's former CanPlaceGridItem / CanPlaceGridItemInst / FindFirstFitPosition;
+ * results are compared on randomly filled grids and timed on a 10x40 stash grid.
+ */
+namespace YcGridOccupancyBenchmark
+{
+	/** 改造前脚本的逐格实现 / Former per-cell script implementation */
+	struct FLegacyGrid
+	{
+		int32 Columns = 0;
+		int32 Rows = 0;
+		TArray<const UYcInventoryItemInstance*> Slots;
+
+		void Init(const int32 InColumns, const int32 InRows)
+		{
+			Columns = InColumns;
+			Rows = InRows;
+			Slots.Init(nullptr, Columns * Rows);
+		}
+
+		bool CanPlace(const FIntPoint Tile, const FIntPoint Size, const UYcInventoryItemInstance* IgnoredItem) const
+		{
+			if (Tile.X < 0 || Tile.Y < 0 || Tile.X + Size.X > Columns || Tile.Y + Size.Y > Rows)
+			{
+				return false;
+			}
+			for (int32 Y = Tile.Y; Y < Tile.Y + Size.Y; ++Y)
+			{
+				for (int32 X = Tile.X; X < Tile.X + Size.X; ++X)
+				{
+					const UYcInventoryItemInstance* Slot = Slots[Y * Columns + X];
+					if (Slot && Slot != IgnoredItem)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		bool FindFirstFit(const FIntPoint Size, const bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated) const
+		{
+			for (int32 Pass = 0; Pass < (bCanRotate ? 2 : 1); ++Pass)
+			{
+				const FIntPoint OrientedSize = Pass == 0 ? Size : FIntPoint(Size.Y, Size.X);
+				for (int32 Y = 0; Y < Rows; ++Y)
+				{
+					for (int32 X = 0; X < Columns; ++X)
+					{
+						if (CanPlace(FIntPoint(X, Y), OrientedSize, nullptr))
+						{
+							OutTile = FIntPoint(X, Y);
+							bOutRotated = Pass == 1;
+							return true;
+						}
+					}
+				}
+			}
+			return false;
+		}
+
+		bool IsBlocked(const int32 X, const int32 Y) const
+		{
+			return X < 0 || Y < 0 || X >= Columns || Y >= Rows || Slots[Y * Columns + X] != nullptr;
+		}
+
+		/** 逐格统计接触数的最佳位置 / Brute-force contact-score best fit */
+		bool FindBestFit(const FIntPoint Size, const bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated) const
+		{
+			int32 BestScore = INDEX_NONE;
+			for (int32 Pass = 0; Pass < (bCanRotate ? 2 : 1); ++Pass)
+			{
+				const FIntPoint OrientedSize = Pass == 0 ? Size : FIntPoint(Size.Y, Size.X);
+				for (int32 Y = 0; Y < Rows; ++Y)
+				{
+					for (int32 X = 0; X < Columns; ++X)
+					{
+						if (!CanPlace(FIntPoint(X, Y), OrientedSize, nullptr))
+						{
+							continue;
+						}
+						int32 Score = 0;
+						for (int32 DX = 0; DX < OrientedSize.X; ++DX)
+						{
+							Score += IsBlocked(X + DX, Y - 1) + IsBlocked(X + DX, Y + OrientedSize.Y);
+						}
+						for (int32 DY = 0; DY < OrientedSize.Y; ++DY)
+						{
+							Score += IsBlocked(X - 1, Y + DY) + IsBlocked(X + OrientedSize.X, Y + DY);
+						}
+						if (Score > BestScore)
+						{
+							BestScore = Score;
+							OutTile = FIntPoint(X, Y);
+							bOutRotated = Pass == 1;
+						}
+					}
+				}
+			}
+			return BestScore != INDEX_NONE;
+		}
+
+		/** 复制一份网格，擦掉两个物品后依次尝试放置 / Erase both items on a copy, then place them in turn */
+		bool CanSwap(const UYcInventoryItemInstance* ItemA, const FIntPoint TileA, const FIntPoint SizeA,
+			const UYcInventoryItemInstance* ItemB, const FIntPoint TileB, const FIntPoint SizeB) const
+		{
+			FLegacyGrid Scratch = *this;
+			for (const UYcInventoryItemInstance*& Slot : Scratch.Slots)
+			{
+				if (Slot == ItemA || (ItemB && Slot == ItemB))
+				{
+					Slot = nullptr;
+				}
+			}
+			if (!Scratch.CanPlace(TileA, SizeA, nullptr))
+			{
+				return false;
+			}
+			if (!ItemB)
+			{
+				return true;
+			}
+			Scratch.Place(ItemA, TileA, SizeA);
+			return Scratch.CanPlace(TileB, SizeB, nullptr);
+		}
+
+		void Place(const UYcInventoryItemInstance* Item, const FIntPoint Tile, const FIntPoint Size)
+		{
+			for (int32 Y = Tile.Y; Y < Tile.Y + Size.Y; ++Y)
+			{
+				for (int32 X = Tile.X; X < Tile.X + Size.X; ++X)
+				{
+					Slots[Y * Columns + X] = Item;
+				}
+			}
+		}
+
+		void Remove(const UYcInventoryItemInstance* Item)
+		{
+			for (const UYcInventoryItemInstance*& Slot : Slots)
+			{
+				if (Slot == Item)
+				{
+					Slot = nullptr;
+				}
+			}
+		}
+	};
+
+	struct FFixture
+	{
+		TArray<UYcInventoryItemInstance*> Items;
+		TArray<FIntPoint> Sizes;
+
+		void Init(const int32 NumItems, FRandomStream& Stream)
+		{
+			for (int32 i = 0; i < NumItems; ++i)
+			{
+				UYcInventoryItemInstance* Item = NewObject<UYcInventoryItemInstance>(GetTransientPackage());
+				Item->AddToRoot();
+				Items.Add(Item);
+				Sizes.Add(FIntPoint(Stream.RandRange(1, 4), Stream.RandRange(1, 3)));
+			}
+		}
+
+		void Shutdown()
+		{
+			for (UYcInventoryItemInstance* Item : Items)
+			{
+				Item->RemoveFromRoot();
+			}
+			Items.Reset();
+		}
+
+		/** 两种实现按相同顺序随机放置物品 / Randomly place items into both implementations in the same order */
+		void Fill(FRandomStream& Stream, FLegacyGrid& Legacy, FYcGridOccupancy& Occupancy, const float FillRatio) const
+		{
+			for (int32 i = 0; i < Items.Num(); ++i)
+			{
+				// 已放置的物品跳过（PlaceItem 会移动物品，参照实现不会）
+				if (Stream.FRand() > FillRatio || Occupancy.FindItem(Items[i]))
+				{
+					continue;
+				}
+				const FIntPoint Tile(Stream.RandRange(0, Legacy.Columns - 1), Stream.RandRange(0, Legacy.Rows - 1));
+				if (Legacy.CanPlace(Tile, Sizes[i], nullptr))
+				{
+					Legacy.Place(Items[i], Tile, Sizes[i]);
+					Occupancy.PlaceItem(Items[i], Tile, Sizes[i]);
+				}
+			}
+		}
+	};
+
+	FIntPoint RandomSize(FRandomStream& Stream)
+	{
+		return FIntPoint(Stream.RandRange(1, 5), Stream.RandRange(1, 4));
+	}
+
+	FIntPoint RandomTile(FRandomStream& Stream, const FLegacyGrid& Legacy)
+	{
+		return FIntPoint(Stream.RandRange(-1, Legacy.Columns), Stream.RandRange(-1, Legacy.Rows));
+	}
+
+	/** 与参照实现比对单个网格上的全部查询 / Compare every query against the reference on one grid */
+	int32 CompareGrid(FRandomStream& Stream, const FFixture& Fixture, const FLegacyGrid& Legacy, const FYcGridOccupancy& Occupancy, const int32 NumQueries)
+	{
+		int32 NumErrors = 0;
+		auto Report = [&NumErrors](const TCHAR* What)
+		{
+			if (NumErrors++ < 10)
+			{
+				UE_LOG(LogYcInventory, Error, TEXT("Yc.GridInventory.OccupancyTest: %s 与参照实现不一致"), What);
+			}
+		};
+
+		for (int32 Y = 0; Y < Legacy.Rows; ++Y)
+		{
+			for (int32 X = 0; X < Legacy.Columns; ++X)
+			{
+				const UYcInventoryItemInstance* Expected = Legacy.Slots[Y * Legacy.Columns + X];
+				if (Occupancy.GetItemAt(FIntPoint(X, Y)) != Expected || Occupancy.IsOccupied(FIntPoint(X, Y)) != (Expected != nullptr))
+				{
+					Report(TEXT("GetItemAt/IsOccupied"));
+				}
+			}
+		}
+
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			const FIntPoint Size = RandomSize(Stream);
+			const FIntPoint Tile = RandomTile(Stream, Legacy);
+			const UYcInventoryItemInstance* Ignored = Stream.FRand() < 0.5f ? Fixture.Items[Stream.RandRange(0, Fixture.Items.Num() - 1)] : nullptr;
+			if (Occupancy.CanPlace(Tile, Size, Ignored) != Legacy.CanPlace(Tile, Size, Ignored))
+			{
+				Report(TEXT("CanPlace"));
+			}
+
+			const bool bCanRotate = Stream.FRand() < 0.5f;
+			FIntPoint ExpectedTile = FIntPoint::NoneValue, ActualTile = FIntPoint::NoneValue;
+			bool bExpectedRotated = false, bActualRotated = false;
+			const bool bExpectedFound = Legacy.FindFirstFit(Size, bCanRotate, ExpectedTile, bExpectedRotated);
+			const bool bActualFound = Occupancy.FindFirstFit(Size, bCanRotate, ActualTile, bActualRotated);
+			if (bExpectedFound != bActualFound || (bExpectedFound && (ExpectedTile != ActualTile || bExpectedRotated != bActualRotated)))
+			{
+				Report(TEXT("FindFirstFit"));
+			}
+
+			const bool bExpectedBest = Legacy.FindBestFit(Size, bCanRotate, ExpectedTile, bExpectedRotated);
+			const bool bActualBest = Occupancy.FindBestFit(Size, bCanRotate, ActualTile, bActualRotated);
+			if (bExpectedBest != bActualBest || (bExpectedBest && (ExpectedTile != ActualTile || bExpectedRotated != bActualRotated)))
+			{
+				Report(TEXT("FindBestFit"));
+			}
+
+			const int32 IndexA = Stream.RandRange(0, Fixture.Items.Num() - 1);
+			const int32 IndexB = Stream.RandRange(0, Fixture.Items.Num() - 1);
+			const UYcInventoryItemInstance* ItemA = Fixture.Items[IndexA];
+			const UYcInventoryItemInstance* ItemB = IndexB != IndexA && Stream.FRand() < 0.75f ? Fixture.Items[IndexB] : nullptr;
+			const FIntPoint TileA = RandomTile(Stream, Legacy);
+			const FIntPoint TileB = RandomTile(Stream, Legacy);
+			if (Occupancy.CanSwap(ItemA, TileA, Fixture.Sizes[IndexA], ItemB, TileB, Fixture.Sizes[IndexB])
+				!= Legacy.CanSwap(ItemA, TileA, Fixture.Sizes[IndexA], ItemB, TileB, Fixture.Sizes[IndexB]))
+			{
+				Report(TEXT("CanSwap"));
+			}
+		}
+		return NumErrors;
+	}
+
+	/** 按格子重建出的占用表应与增量维护的结果一致 / A table rebuilt through MarkCell must match the incrementally maintained one */
+	int32 CompareRebuild(const FLegacyGrid& Legacy, const FYcGridOccupancy& Occupancy)
+	{
+		FYcGridOccupancy Rebuilt;
+		Rebuilt.Init(Legacy.Columns, Legacy.Rows);
+		for (int32 Index = 0; Index < Legacy.Slots.Num(); ++Index)
+		{
+			if (const UYcInventoryItemInstance* Slot = Legacy.Slots[Index])
+			{
+				Rebuilt.MarkCell(const_cast<UYcInventoryItemInstance*>(Slot), FIntPoint(Index % Legacy.Columns, Index / Legacy.Columns));
+			}
+		}
+
+		int32 NumErrors = 0;
+		for (int32 Y = 0; Y < Legacy.Rows; ++Y)
+		{
+			for (int32 X = 0; X < Legacy.Columns; ++X)
+			{
+				if (Rebuilt.GetItemAt(FIntPoint(X, Y)) != Occupancy.GetItemAt(FIntPoint(X, Y)))
+				{
+					++NumErrors;
+				}
+			}
+		}
+		if (Rebuilt.GetNumItems() != Occupancy.GetNumItems())
+		{
+			++NumErrors;
+		}
+		if (NumErrors > 0)
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.GridInventory.OccupancyTest: MarkCell 重建结果与增量维护不一致"));
+		}
+		return NumErrors;
+	}
+
+	void RunTest(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumGrids = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+		FRandomStream Stream(0x6121D);
+
+		FFixture Fixture;
+		Fixture.Init(48, Stream);
+
+		int32 NumErrors = 0;
+		for (int32 GridIndex = 0; GridIndex < NumGrids; ++GridIndex)
+		{
+			// 覆盖窄网格、常见背包与 64 列边界
+			const int32 Columns = GridIndex % 7 == 0 ? FYcGridOccupancy::MaxColumns : Stream.RandRange(1, 16);
+			const int32 Rows = Stream.RandRange(1, 40);
+
+			FLegacyGrid Legacy;
+			Legacy.Init(Columns, Rows);
+			FYcGridOccupancy Occupancy;
+			Occupancy.Init(Columns, Rows);
+			Fixture.Fill(Stream, Legacy, Occupancy, Stream.FRand());
+
+			NumErrors += CompareGrid(Stream, Fixture, Legacy, Occupancy, 32);
+			NumErrors += CompareRebuild(Legacy, Occupancy);
+
+			// 随机移除一部分后再次比对，覆盖空位复用
+			for (int32 i = 0; i < Fixture.Items.Num(); ++i)
+			{
+				if (Stream.FRand() < 0.3f)
+				{
+					Legacy.Remove(Fixture.Items[i]);
+					Occupancy.RemoveItem(Fixture.Items[i]);
+				}
+			}
+			Fixture.Fill(Stream, Legacy, Occupancy, 0.5f);
+			NumErrors += CompareGrid(Stream, Fixture, Legacy, Occupancy, 32);
+		}
+
+		Fixture.Shutdown();
+
+		UE_LOG(LogYcInventory, Display, TEXT("Yc.GridInventory.OccupancyTest: %s (网格 %d 个, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumGrids, NumErrors);
+	}
+
+	void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumIterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 2000;
+		const float FillRatio = Args.Num() > 1 ? FMath::Clamp(FCString::Atof(*Args[1]), 0.f, 1.f) : 0.7f;
+		constexpr int32 Columns = 10;
+		constexpr int32 Rows = 40;
+
+		FRandomStream Stream(0xB17B0A2D);
+		FFixture Fixture;
+		Fixture.Init(160, Stream);
+
+		FLegacyGrid Legacy;
+		Legacy.Init(Columns, Rows);
+		FYcGridOccupancy Occupancy;
+		Occupancy.Init(Columns, Rows);
+		Fixture.Fill(Stream, Legacy, Occupancy, FillRatio);
+
+		TArray<FIntPoint> QuerySizes;
+		TArray<FIntPoint> QueryTiles;
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			QuerySizes.Add(RandomSize(Stream));
+			QueryTiles.Add(RandomTile(Stream, Legacy));
+		}
+
+		// 结果累加进校验和，避免被优化掉，同时顺便比对两种实现
+		int32 LegacySum = 0;
+		int32 NativeSum = 0;
+		FIntPoint Tile;
+		bool bRotated = false;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			LegacySum += Legacy.CanPlace(QueryTiles[i], QuerySizes[i], nullptr);
+			LegacySum += Legacy.FindFirstFit(QuerySizes[i], true, Tile, bRotated) ? Tile.X + Tile.Y * Columns + bRotated : -1;
+		}
+		const double LegacyFirstFitSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			NativeSum += Occupancy.CanPlace(QueryTiles[i], QuerySizes[i], nullptr);
+			NativeSum += Occupancy.FindFirstFit(QuerySizes[i], true, Tile, bRotated) ? Tile.X + Tile.Y * Columns + bRotated : -1;
+		}
+		const double NativeFirstFitSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			LegacySum += Legacy.FindBestFit(QuerySizes[i], true, Tile, bRotated) ? Tile.X + Tile.Y * Columns + bRotated : -1;
+		}
+		const double LegacyBestFitSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			NativeSum += Occupancy.FindBestFit(QuerySizes[i], true, Tile, bRotated) ? Tile.X + Tile.Y * Columns + bRotated : -1;
+		}
+		const double NativeBestFitSeconds = FPlatformTime::Seconds() - StartTime;
+
+		Fixture.Shutdown();
+
+		const bool bPassed = LegacySum == NativeSum;
+		UE_LOG(LogYcInventory, Display, TEXT("Yc.GridInventory.BenchmarkOccupancy: %s (%dx%d, 物品 %d 个, 查询 %d 次)"),
+			bPassed ? TEXT("PASSED") : TEXT("FAILED"), Columns, Rows, Occupancy.GetNumItems(), NumIterations);
+		UE_LOG(LogYcInventory, Display, TEXT("  CanPlace+FirstFit: 逐格 %.3f us / 位掩码 %.3f us (%.1fx)"),
+			LegacyFirstFitSeconds * 1e6 / NumIterations, NativeFirstFitSeconds * 1e6 / NumIterations,
+			NativeFirstFitSeconds > 0.0 ? LegacyFirstFitSeconds / NativeFirstFitSeconds : 0.0);
+		UE_LOG(LogYcInventory, Display, TEXT("  BestFit: 逐格 %.3f us / 位掩码 %.3f us (%.1fx)"),
+			LegacyBestFitSeconds * 1e6 / NumIterations, NativeBestFitSeconds * 1e6 / NumIterations,
+			NativeBestFitSeconds > 0.0 ? LegacyBestFitSeconds / NativeBestFitSeconds : 0.0);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdTest(
+		TEXT("Yc.GridInventory.OccupancyTest"),
+		TEXT("网格占用表与改造前逐格实现的一致性校验：Yc.GridInventory.OccupancyTest [网格数量=200]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunTest));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+		TEXT("Yc.GridInventory.BenchmarkOccupancy"),
+		TEXT("10x40 仓库网格上位掩码与逐格实现的性能对比：Yc.GridInventory.BenchmarkOccupancy [迭代次数=2000] [填充率=0.7]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBenchmark));
+}
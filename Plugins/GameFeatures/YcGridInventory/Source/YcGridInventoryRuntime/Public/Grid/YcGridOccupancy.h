@@ -0,0 +1,186 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Templates/Function.h"
+
+#include "YcGridOccupancy.generated.h"
+
+class UYcInventoryItemInstance;
+
+/**
+ * 占用表中单个物品的摆放记录。
+ * Placement record of one item in the occupancy grid.
+ */
+USTRUCT(BlueprintType)
+struct YCGRIDINVENTORYRUNTIME_API FYcGridOccupancyItem
+{
+	GENERATED_BODY()
+
+	/** 物品实例。 / Item instance. */
+	UPROPERTY(BlueprintReadOnly)
+	TObjectPtr<UYcInventoryItemInstance> Item = nullptr;
+
+	/** 左上角格子。 / Top-left tile. */
+	UPROPERTY(BlueprintReadOnly)
+	FIntPoint Tile = FIntPoint::ZeroValue;
+
+	/** 占用尺寸（已考虑旋转）。 / Occupied size (rotation applied). */
+	UPROPERTY(BlueprintReadOnly)
+	FIntPoint Size = FIntPoint::ZeroValue;
+};
+
+/**
+ * 网格库存占用表：每行一个 64 位掩码，第 X 位表示第 X 列被占用。
+ * Grid occupancy table: one 64-bit mask per row, bit X set means column X is occupied.
+ *
+ * 说明 / Notes:
+ * - 放置检测按行做整字 AND，查找时先算出每行“可容纳宽度 W 的起点”掩码，再按物品高度逐行相与。
+ *   Fit tests AND whole rows; searches build per-row "start of W free columns" masks and AND them over the item height.
+ * - 同时维护格子 -> 物品索引，用于按格子取物品与忽略自身的移动检测。
+ *   Also keeps a tile -> item index for lookups and self-ignoring move checks.
+ * - 列数上限为 64。 / Up to 64 columns.
+ */
+USTRUCT(BlueprintType)
+struct YCGRIDINVENTORYRUNTIME_API FYcGridOccupancy
+{
+	GENERATED_BODY()
+
+	/** 支持的最大列数。 / Maximum supported column count. */
+	static constexpr int32 MaxColumns = 64;
+
+	/** 按尺寸初始化并清空。 / Resize and clear. */
+	void Init(int32 InColumns, int32 InRows);
+
+	/** 清空全部占用。 / Clear all occupancy. */
+	void Reset();
+
+	int32 GetColumns() const { return Columns; }
+	int32 GetRows() const { return Rows; }
+	int32 GetNumItems() const { return ItemSlots.Num(); }
+
+	/** 矩形是否可放置（越界视为不可放置，IgnoredItem 占用的格子视为空闲）。 / Whether the rectangle fits; tiles of IgnoredItem count as free. */
+	bool CanPlace(FIntPoint Tile, FIntPoint Size, const UYcInventoryItemInstance* IgnoredItem = nullptr) const;
+
+	/** 按行优先顺序查找第一个可放置位置，先找不旋转再找旋转。 / Row-major first fit, unrotated before rotated. */
+	bool FindFirstFit(FIntPoint Size, bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated) const;
+
+	/** 查找与边界/已占用格子接触最多的位置，得分相同时取行优先顺序靠前者。 / Position touching the most walls/occupied tiles; ties keep row-major order. */
+	bool FindBestFit(FIntPoint Size, bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated) const;
+
+	/**
+	 * 两个物品能否同时移动到各自的新位置（例如互换位置），ItemB 为空时等价于移动 ItemA。
+	 * Whether both items can move to their new rectangles at once (e.g. swapping); a null ItemB is a plain move of ItemA.
+	 */
+	bool CanSwap(const UYcInventoryItemInstance* ItemA, FIntPoint TileA, FIntPoint SizeA, const UYcInventoryItemInstance* ItemB, FIntPoint TileB, FIntPoint SizeB) const;
+
+	/** 放置物品，已存在时先移除旧位置；目标被占用时返回 false。 / Place an item, moving it if already placed; false if blocked. */
+	bool PlaceItem(UYcInventoryItemInstance* Item, FIntPoint Tile, FIntPoint Size);
+
+	/** 移除物品。 / Remove an item. */
+	bool RemoveItem(const UYcInventoryItemInstance* Item);
+
+	/** 按格子标记占用（从格子数组重建时使用），物品记录扩展为包围盒；Item 为空时只记占用位。 / Mark one tile (rebuild from slot arrays); the item's record grows to the bounding box. A null Item only sets the bit. */
+	void MarkCell(UYcInventoryItemInstance* Item, FIntPoint Tile);
+
+	/** 格子是否被占用。 / Whether a tile is occupied. */
+	bool IsOccupied(FIntPoint Tile) const;
+
+	/** 占用该格子的物品。 / Item occupying the tile. */
+	UYcInventoryItemInstance* GetItemAt(FIntPoint Tile) const;
+
+	/** 物品的摆放记录。 / Placement record of an item. */
+	const FYcGridOccupancyItem* FindItem(const UYcInventoryItemInstance* Item) const;
+
+private:
+	bool IsInBounds(FIntPoint Tile, FIntPoint Size) const;
+
+	/** Items 下标，不存在时为 INDEX_NONE。 / Index into Items, INDEX_NONE if absent. */
+	int32 FindItemIndex(const UYcInventoryItemInstance* Item) const;
+
+	/** 第 Y 行中归属该物品的位。 / Bits of row Y owned by the item. */
+	uint64 GetItemRowBits(int32 ItemIndex, int32 Y) const;
+
+	/**
+	 * 按行优先顺序访问每一行可放置的起点列掩码，Visitor 返回 true 时停止。
+	 * Visits per-row masks of valid start columns in row-major order; stops when Visitor returns true.
+	 */
+	void ForEachFitCandidates(FIntPoint Size, TFunctionRef<bool(int32 Y, uint64 Candidates)> Visitor) const;
+
+	/** 物品四周接触的边界/占用格子数。 / Count of wall/occupied tiles touching the rectangle. */
+	int32 ScoreContact(FIntPoint Tile, FIntPoint Size) const;
+
+	UPROPERTY()
+	int32 Columns = 0;
+
+	UPROPERTY()
+	int32 Rows = 0;
+
+	/** 每行的占用位。 / Occupancy bits per row. */
+	TArray<uint64> RowBits;
+
+	/** 格子 -> Items 下标，INDEX_NONE 表示空。 / Tile -> index into Items. */
+	TArray<int32> CellItems;
+
+	/** 摆放记录（下标稳定，空位复用）。 / Placement records (stable indices, holes reused). */
+	UPROPERTY()
+	TArray<FYcGridOccupancyItem> Items;
+
+	/** Items 中的空位。 / Free indices in Items. */
+	TArray<int32> FreeItemIndices;
+
+	/** 物品 -> Items 下标。 / Item -> index into Items. */
+	TMap<const UYcInventoryItemInstance*, int32> ItemSlots;
+};
+
+/**
+ * 网格占用表的脚本/蓝图接口（脚本中可直接以 Occupancy.FindFirstFit(...) 的方式调用）。
+ * Script/Blueprint access to FYcGridOccupancy (callable as Occupancy.FindFirstFit(...) from script).
+ */
+UCLASS(Meta = (ScriptMixin = "FYcGridOccupancy"))
+class YCGRIDINVENTORYRUNTIME_API UYcGridOccupancyLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Yc|Inventory|Grid")
+	static void InitOccupancy(UPARAM(ref) FYcGridOccupancy& Occupancy, int32 Columns, int32 Rows);
+
+	UFUNCTION(BlueprintCallable, Category = "Yc|Inventory|Grid")
+	static void ResetOccupancy(UPARAM(ref) FYcGridOccupancy& Occupancy);
+
+	UFUNCTION(BlueprintPure, Category = "Yc|Inventory|Grid")
+	static bool CanPlace(const FYcGridOccupancy& Occupancy, FIntPoint Tile, FIntPoint Size, const UYcInventoryItemInstance* IgnoredItem = nullptr);
+
+	UFUNCTION(BlueprintPure, Category = "Yc|Inventory|Grid")
+	static bool FindFirstFit(const FYcGridOccupancy& Occupancy, FIntPoint Size, bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated);
+
+	UFUNCTION(BlueprintPure, Category = "Yc|Inventory|Grid")
+	static bool FindBestFit(const FYcGridOccupancy& Occupancy, FIntPoint Size, bool bCanRotate, FIntPoint& OutTile, bool& bOutRotated);
+
+	UFUNCTION(BlueprintPure, Category = "Yc|Inventory|Grid")
+	static bool CanSwap(const FYcGridOccupancy& Occupancy, const UYcInventoryItemInstance* ItemA, FIntPoint TileA, FIntPoint SizeA, const UYcInventoryItemInstance* ItemB, FIntPoint TileB, FIntPoint SizeB);
+
+	UFUNCTION(BlueprintCallable, Category = "Yc|Inventory|Grid")
+	static bool PlaceItem(UPARAM(ref) FYcGridOccupancy& Occupancy, UYcInventoryItemInstance* Item, FIntPoint Tile, FIntPoint Size);
+
+	UFUNCTION(BlueprintCallable, Category = "Yc|Inventory|Grid")
+	static bool RemoveItem(UPARAM(ref) FYcGridOccupancy& Occupancy, const UYcInventoryItemInstance* Item);
+
+	UFUNCTION(BlueprintCallable, Category = "Yc|Inventory|Grid")
+	static void MarkCell(UPARAM(ref) FYcGridOccupancy& Occupancy, UYcInventoryItemInstance* Item, FIntPoint Tile);
+
+	UFUNCTION(BlueprintPure, Category = "Yc|Inventory|Grid")
+	static bool IsOccupied(const FYcGridOccupancy& Occupancy, FIntPoint Tile);
+
+	UFUNCTION(BlueprintPure, Category = "Yc|Inventory|Grid")
+	static UYcInventoryItemInstance* GetItemAt(const FYcGridOccupancy& Occupancy, FIntPoint Tile);
+
+	UFUNCTION(BlueprintPure, Category = "Yc|Inventory|Grid")
+	static bool GetItemPlacement(const FYcGridOccupancy& Occupancy, const UYcInventoryItemInstance* Item, FIntPoint& OutTile, FIntPoint& OutSize);
+
+	UFUNCTION(BlueprintPure, Category = "Yc|Inventory|Grid")
+	static bool ContainsItem(const FYcGridOccupancy& Occupancy, const UYcInventoryItemInstance* Item);
+};
@@ -0,0 +1,233 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "Engine/World.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * Console test and benchmark for queued gameplay message channels.
+ *
+ * The test checks the ordering guarantees of Queued and QueuedKeepLatest channels against an Immediate one,
+ * the benchmark simulates bursty producers and counts the listener calls saved by coalescing.
+ * Both run on tags nobody listens to and restore the channel modes they change.
+ */
+struct FGameplayMessageQueueTest
+{
+	// Returns up to NumChannels tags without game listeners or queue modes on them or their parents
+	static TArray<FGameplayTag> FindFreeChannels(const UGameplayMessageSubsystem& Router, const int32 NumChannels)
+	{
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, /*OnlyIncludeDictionaryTags=*/ false);
+
+		TArray<FGameplayTag> Channels;
+		for (const FGameplayTag& Tag : AllTags)
+		{
+			bool bInUse = Router.ChannelQueueModes.Contains(Tag);
+			for (FGameplayTag Parent = Tag; Parent.IsValid() && !bInUse; Parent = Parent.RequestDirectParent())
+			{
+				bInUse = Router.ListenerMap.Contains(Parent);
+			}
+			if (!bInUse && !Channels.ContainsByPredicate([&Tag](const FGameplayTag& Other) { return Tag.MatchesTag(Other) || Other.MatchesTag(Tag); }))
+			{
+				Channels.Add(Tag);
+				if (Channels.Num() == NumChannels)
+				{
+					break;
+				}
+			}
+		}
+		return Channels;
+	}
+
+	static void RunTest(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !UGameplayMessageSubsystem::HasInstance(World))
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.TestQueue: requires a world with a game instance"));
+			return;
+		}
+
+		UGameplayMessageSubsystem& Router = UGameplayMessageSubsystem::Get(World);
+		const TArray<FGameplayTag> Channels = FindFreeChannels(Router, 3);
+		if (Channels.Num() < 3)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.TestQueue: not enough unused gameplay tags"));
+			return;
+		}
+
+		// Deliver whatever the game queued so far, so the checks below only see this test's messages
+		Router.FlushQueuedMessages();
+
+		const FGameplayTag QueuedChannel = Channels[0];
+		const FGameplayTag LatestChannel = Channels[1];
+		const FGameplayTag ImmediateChannel = Channels[2];
+		Router.SetChannelQueueMode(QueuedChannel, EGameplayMessageQueueMode::Queued);
+		Router.SetChannelQueueMode(LatestChannel, EGameplayMessageQueueMode::QueuedKeepLatest);
+
+		// Each received message is logged as its X value, listeners on the queued channel re-broadcast 100 as 101
+		TArray<int32> Received;
+		TArray<FGameplayMessageListenerHandle> Handles;
+		for (const FGameplayTag& Channel : Channels)
+		{
+			Handles.Add(Router.RegisterListener<FVector>(Channel, [&Router, &Received, QueuedChannel](FGameplayTag ActualChannel, const FVector& Message)
+			{
+				Received.Add(static_cast<int32>(Message.X));
+				if (ActualChannel == QueuedChannel && Message.X == 100.0)
+				{
+					Router.BroadcastMessage(QueuedChannel, FVector(101.0));
+				}
+			}));
+		}
+
+		int32 NumErrors = 0;
+		auto Check = [&NumErrors, &Received](const TArray<int32>& Expected, const TCHAR* What)
+		{
+			if (Received != Expected)
+			{
+				const FString ReceivedString = FString::JoinBy(Received, TEXT(", "), [](const int32 Value) { return FString::FromInt(Value); });
+				UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.TestQueue: %s (received: %s)"), What, *ReceivedString);
+				++NumErrors;
+			}
+		};
+
+		Router.BroadcastMessage(QueuedChannel, FVector(1.0));
+		Router.BroadcastMessage(LatestChannel, FVector(2.0), 7);
+		Router.BroadcastMessage(QueuedChannel, FVector(3.0));
+		Router.BroadcastMessage(LatestChannel, FVector(4.0), 8);
+		Router.BroadcastMessage(LatestChannel, FVector(5.0), 7);
+		Router.BroadcastMessage(ImmediateChannel, FVector(6.0));
+		Check({ 6 }, TEXT("only the immediate channel should deliver during the broadcast"));
+
+		Router.FlushQueuedMessages();
+		Check({ 6, 1, 5, 3, 4 }, TEXT("queued messages should arrive in broadcast order, a replaced message keeping the first one's place"));
+
+		Received.Reset();
+		Router.BroadcastMessage(QueuedChannel, FVector(100.0));
+		Router.FlushQueuedMessages();
+		Check({ 100 }, TEXT("messages queued by a listener during a flush should wait for the next flush"));
+		Router.FlushQueuedMessages();
+		Check({ 100, 101 }, TEXT("the next flush should deliver the message queued by the listener"));
+
+		Received.Reset();
+		Router.BroadcastMessage(LatestChannel, FVector(9.0), 7);
+		Router.FlushQueuedMessages();
+		Router.BroadcastMessage(LatestChannel, FVector(10.0), 7);
+		Router.FlushQueuedMessages();
+		Check({ 9, 10 }, TEXT("coalescing should not reach across flushes"));
+
+		Received.Reset();
+		Router.BroadcastMessage(QueuedChannel, FVector(11.0));
+		Handles[0].Unregister();
+		Router.FlushQueuedMessages();
+		Check({}, TEXT("listeners unregistered before the flush should not be called"));
+
+		for (FGameplayMessageListenerHandle& Handle : Handles)
+		{
+			if (Handle.IsValid())
+			{
+				Handle.Unregister();
+			}
+		}
+		Router.SetChannelQueueMode(QueuedChannel, EGameplayMessageQueueMode::Immediate);
+		Router.SetChannelQueueMode(LatestChannel, EGameplayMessageQueueMode::Immediate);
+
+		UE_LOG(LogGameplayMessageSubsystem, Display, TEXT("GameplayMessageSubsystem.TestQueue: %s (%d errors)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumErrors);
+	}
+
+	static void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !UGameplayMessageSubsystem::HasInstance(World))
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.BenchmarkQueue: requires a world with a game instance"));
+			return;
+		}
+
+		const int32 NumFrames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+		const int32 NumMessagesPerFrame = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 64;
+		const int32 NumKeys = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 8;
+		const int32 NumListeners = Args.Num() > 3 ? FMath::Max(1, FCString::Atoi(*Args[3])) : 4;
+
+		UGameplayMessageSubsystem& Router = UGameplayMessageSubsystem::Get(World);
+		const TArray<FGameplayTag> Channels = FindFreeChannels(Router, 1);
+		if (Channels.Num() == 0)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.BenchmarkQueue: no unused gameplay tag found"));
+			return;
+		}
+		const FGameplayTag Channel = Channels[0];
+		Router.FlushQueuedMessages();
+
+		// Listeners stand in for UI refreshes, each call does a little work on the payload
+		int64 NumCalls = 0;
+		double Sink = 0.0;
+		TArray<FGameplayMessageListenerHandle> Handles;
+		for (int32 i = 0; i < NumListeners; ++i)
+		{
+			Handles.Add(Router.RegisterListener<FTransform>(Channel, [&NumCalls, &Sink](FGameplayTag, const FTransform& Message)
+			{
+				++NumCalls;
+				Sink += Message.GetTranslation().Size();
+			}));
+		}
+
+		auto RunFrames = [&](const EGameplayMessageQueueMode QueueMode, int64& OutCalls, double& OutSeconds)
+		{
+			Router.SetChannelQueueMode(Channel, QueueMode);
+			NumCalls = 0;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				for (int32 i = 0; i < NumMessagesPerFrame; ++i)
+				{
+					Router.BroadcastMessage(Channel, FTransform(FVector(Frame, i, 0.0)), static_cast<uint64>(i % NumKeys));
+				}
+				Router.FlushQueuedMessages();
+			}
+			OutSeconds = FPlatformTime::Seconds() - StartTime;
+			OutCalls = NumCalls;
+		};
+
+		int64 ImmediateCalls = 0, QueuedCalls = 0, LatestCalls = 0;
+		double ImmediateSeconds = 0.0, QueuedSeconds = 0.0, LatestSeconds = 0.0;
+		const int64 CoalescedBefore = Router.NumCoalescedMessages;
+		RunFrames(EGameplayMessageQueueMode::Immediate, ImmediateCalls, ImmediateSeconds);
+		RunFrames(EGameplayMessageQueueMode::Queued, QueuedCalls, QueuedSeconds);
+		RunFrames(EGameplayMessageQueueMode::QueuedKeepLatest, LatestCalls, LatestSeconds);
+		const int64 NumCoalesced = Router.NumCoalescedMessages - CoalescedBefore;
+
+		for (FGameplayMessageListenerHandle& Handle : Handles)
+		{
+			Handle.Unregister();
+		}
+		Router.SetChannelQueueMode(Channel, EGameplayMessageQueueMode::Immediate);
+
+		const int64 ExpectedLatestCalls = static_cast<int64>(NumFrames) * FMath::Min(NumKeys, NumMessagesPerFrame) * NumListeners;
+		const bool bPassed = QueuedCalls == ImmediateCalls && LatestCalls == ExpectedLatestCalls;
+		const double NumMessages = static_cast<double>(NumFrames) * NumMessagesPerFrame;
+
+		UE_LOG(LogGameplayMessageSubsystem, Display, TEXT("GameplayMessageSubsystem.BenchmarkQueue: %s (%d frames x %d messages over %d keys, %d listeners, %lld coalesced, checksum %.0f)"),
+			bPassed ? TEXT("PASSED") : TEXT("FAILED"), NumFrames, NumMessagesPerFrame, NumKeys, NumListeners, NumCoalesced, Sink);
+		UE_LOG(LogGameplayMessageSubsystem, Display, TEXT("  Immediate:        %lld listener calls, %.1f ns per message"), ImmediateCalls, ImmediateSeconds * 1e9 / NumMessages);
+		UE_LOG(LogGameplayMessageSubsystem, Display, TEXT("  Queued:           %lld listener calls, %.1f ns per message"), QueuedCalls, QueuedSeconds * 1e9 / NumMessages);
+		UE_LOG(LogGameplayMessageSubsystem, Display, TEXT("  QueuedKeepLatest: %lld listener calls (%.1f%% saved), %.1f ns per message"),
+			LatestCalls, ImmediateCalls > 0 ? 100.0 * (ImmediateCalls - LatestCalls) / ImmediateCalls : 0.0, LatestSeconds * 1e9 / NumMessages);
+	}
+};
+
+namespace UE
+{
+	namespace GameplayMessageSubsystem
+	{
+		static FAutoConsoleCommandWithWorldAndArgs CmdTestQueue(
+			TEXT("GameplayMessageSubsystem.TestQueue"),
+			TEXT("Checks the delivery order of Queued and QueuedKeepLatest channels: GameplayMessageSubsystem.TestQueue"),
+			FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FGameplayMessageQueueTest::RunTest));
+
+		static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkQueue(
+			TEXT("GameplayMessageSubsystem.BenchmarkQueue"),
+			TEXT("Counts the listener calls saved by queued channels for bursty producers: GameplayMessageSubsystem.BenchmarkQueue [Frames=1000] [MessagesPerFrame=64] [Keys=8] [Listeners=4]"),
+			FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FGameplayMessageQueueTest::RunBenchmark));
+	}
+}
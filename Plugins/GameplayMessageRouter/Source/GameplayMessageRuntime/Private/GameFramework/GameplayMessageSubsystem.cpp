@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameFramework/GameplayMessageSubsystem.h"
+#include "Algo/BinarySearch.h"
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
@@ -68,10 +69,46 @@ void UGameplayMessageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 void UGameplayMessageSubsystem::Deinitialize()
 {
 	ListenerMap.Reset();
+	DispatchCache.Reset();
+	ActorListenerIndex.Reset();
+	WorldListenerIndex.Reset();
+
+	DestroyQueuedPayloads(QueuedMessages);
+	QueuedMessages.Reset();
+	CoalescedMessageIndices.Reset();
+	for (FMemStackBase& Arena : MessageArenas)
+	{
+		Arena.Flush();
+	}
 
 	Super::Deinitialize();
 }
 
+void UGameplayMessageSubsystem::Tick(float DeltaTime)
+{
+	FlushQueuedMessages();
+}
+
+ETickableTickType UGameplayMessageSubsystem::GetTickableTickType() const
+{
+	return ETickableTickType::Conditional;
+}
+
+bool UGameplayMessageSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && QueuedMessages.Num() > 0;
+}
+
+TStatId UGameplayMessageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGameplayMessageSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UGameplayMessageSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
 void UGameplayMessageSubsystem::OnWorldDestroyed(UWorld* World)
 {
 	/**
@@ -82,34 +119,19 @@ void UGameplayMessageSubsystem::OnWorldDestroyed(UWorld* World)
 	 */
 	if (GetWorld() != World) return;
 
-	TArray<FGameplayTag> KeysToRemove;
-	for (TPair<FGameplayTag, FChannelListenerList> Pair : ListenerMap)
+	// Only visit listeners scoped to the world, game instance lifetime listeners are left alone
+	const TArray<FListenerKey> Keys = WorldListenerIndex.Array();
+	for (const FListenerKey& Key : Keys)
 	{
-		FChannelListenerList& List = Pair.Value;
-		for (int i = List.Listeners.Num() - 1; i >= 0; i--)
-		{
-			if (
-				List.Listeners[i].bUnregisterOnWorldDestroyed ||
-				List.Listeners[i].UnregisterOnActorDestroyed != nullptr
-			) {
-				List.Listeners.RemoveAt(i);
-			}
-		}
-
-
-		if (List.Listeners.Num() == 0)
-		{
-			KeysToRemove.Add(Pair.Key);
-		}
+		RemoveListenerInternal(Key.Channel, Key.HandleID, /*bInvalidateDispatchLists=*/ false);
 	}
 
-	for (FGameplayTag Key : KeysToRemove)
-	{
-		ListenerMap.Remove(Key);
-	}
+	WorldListenerIndex.Reset();
+	ActorListenerIndex.Reset();
+	DispatchCache.Reset();
 }
 
-void UGameplayMessageSubsystem::BroadcastMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes)
+void UGameplayMessageSubsystem::BroadcastMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, uint64 CoalesceKey)
 {
 	// Log the message if enabled
 	if (UE::GameplayMessageSubsystem::ShouldLogMessages != 0)
@@ -129,43 +151,200 @@ void UGameplayMessageSubsystem::BroadcastMessageInternal(FGameplayTag Channel, c
 	}
 
 	// Broadcast the message
+	// Hold a reference to the dispatch list instead of copying it: (un)registering from a callback replaces the cached list
+	// rather than modifying this one, and unregistered listeners are flagged so they are skipped here
+	const FDispatchListRef DispatchList = GetDispatchList(Channel);
+	if (DispatchList->QueueMode == EGameplayMessageQueueMode::Immediate)
+	{
+		DispatchMessage(Channel, StructType, MessageBytes, *DispatchList);
+	}
+	else if (DispatchList->Entries.Num() > 0)
+	{
+		QueueMessage(Channel, StructType, MessageBytes, DispatchList->QueueMode, CoalesceKey);
+	}
+}
+
+void UGameplayMessageSubsystem::DispatchMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, const FChannelDispatchList& DispatchList)
+{
+	for (const FDispatchEntry& Entry : DispatchList.Entries)
+	{
+		const FGameplayMessageListenerData& Listener = *Entry.Listener;
+		if (Listener.bRemoved)
+		{
+			continue;
+		}
+
+		if (Listener.bHadValidType && !Listener.ListenerStructType.IsValid())
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Warning, TEXT("Listener struct type has gone invalid on Channel %s. Removing listener from list"), *Channel.ToString());
+			UnregisterListenerInternal(Entry.ListenerChannel, Listener.HandleID);
+			continue;
+		}
+
+		// The receiving type must be either a parent of the sending type or completely ambiguous (for internal use)
+		if (!Listener.bHadValidType || StructType->IsChildOf(Listener.ListenerStructType.Get()))
+		{
+			Listener.ReceivedCallback(Channel, StructType, MessageBytes);
+		}
+		else
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("Struct type mismatch on channel %s (broadcast type %s, listener at %s was expecting type %s)"),
+				*Channel.ToString(),
+				*StructType->GetPathName(),
+				*Entry.ListenerChannel.ToString(),
+				*Listener.ListenerStructType->GetPathName());
+		}
+	}
+}
+
+UGameplayMessageSubsystem::FDispatchListRef UGameplayMessageSubsystem::GetDispatchList(FGameplayTag Channel)
+{
+	if (const FDispatchListRef* CachedList = DispatchCache.Find(Channel))
+	{
+		return *CachedList;
+	}
+
+	// Channels without listeners are cached too, so broadcasting nobody listens to stays a single lookup
+	TSharedRef<FChannelDispatchList, ESPMode::NotThreadSafe> NewList = MakeShared<FChannelDispatchList, ESPMode::NotThreadSafe>();
+	NewList->QueueMode = GetChannelQueueMode(Channel);
 	bool bOnInitialTag = true;
 	for (FGameplayTag Tag = Channel; Tag.IsValid(); Tag = Tag.RequestDirectParent())
 	{
 		if (const FChannelListenerList* pList = ListenerMap.Find(Tag))
 		{
-			// Copy in case there are removals while handling callbacks
-			TArray<FGameplayMessageListenerData> ListenerArray(pList->Listeners);
-
-			for (const FGameplayMessageListenerData& Listener : ListenerArray)
+			for (const FListenerRef& Listener : pList->Listeners)
 			{
-				if (bOnInitialTag || (Listener.MatchType == EGameplayMessageMatch::PartialMatch))
+				if (bOnInitialTag || (Listener->MatchType == EGameplayMessageMatch::PartialMatch))
 				{
-					if (Listener.bHadValidType && !Listener.ListenerStructType.IsValid())
-					{
-						UE_LOG(LogGameplayMessageSubsystem, Warning, TEXT("Listener struct type has gone invalid on Channel %s. Removing listener from list"), *Channel.ToString());
-						UnregisterListenerInternal(Channel, Listener.HandleID);
-						continue;
-					}
-
-					// The receiving type must be either a parent of the sending type or completely ambiguous (for internal use)
-					if (!Listener.bHadValidType || StructType->IsChildOf(Listener.ListenerStructType.Get()))
-					{
-						Listener.ReceivedCallback(Channel, StructType, MessageBytes);
-					}
-					else
-					{
-						UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("Struct type mismatch on channel %s (broadcast type %s, listener at %s was expecting type %s)"),
-							*Channel.ToString(),
-							*StructType->GetPathName(),
-							*Tag.ToString(),
-							*Listener.ListenerStructType->GetPathName());
-					}
+					NewList->Entries.Add({ Listener, Tag });
 				}
 			}
 		}
 		bOnInitialTag = false;
 	}
+
+	DispatchCache.Add(Channel, NewList);
+	return NewList;
+}
+
+void UGameplayMessageSubsystem::InvalidateDispatchLists(FGameplayTag Channel, EGameplayMessageMatch MatchType)
+{
+	// An exact match listener only ever appears in its own channel's list
+	if (MatchType == EGameplayMessageMatch::ExactMatch)
+	{
+		DispatchCache.Remove(Channel);
+		return;
+	}
+
+	for (auto It = DispatchCache.CreateIterator(); It; ++It)
+	{
+		if (It.Key().MatchesTag(Channel))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UGameplayMessageSubsystem::SetChannelQueueMode(FGameplayTag Channel, EGameplayMessageQueueMode QueueMode)
+{
+	if (QueueMode == EGameplayMessageQueueMode::Immediate)
+	{
+		ChannelQueueModes.Remove(Channel);
+	}
+	else
+	{
+		ChannelQueueModes.Add(Channel, QueueMode);
+	}
+
+	// Messages already queued on the channel are still delivered by the next flush
+	DispatchCache.Remove(Channel);
+}
+
+EGameplayMessageQueueMode UGameplayMessageSubsystem::GetChannelQueueMode(FGameplayTag Channel) const
+{
+	const EGameplayMessageQueueMode* QueueMode = ChannelQueueModes.Find(Channel);
+	return QueueMode ? *QueueMode : EGameplayMessageQueueMode::Immediate;
+}
+
+void UGameplayMessageSubsystem::QueueMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, EGameplayMessageQueueMode QueueMode, uint64 CoalesceKey)
+{
+	++NumQueuedMessages;
+
+	auto CopyToArena = [this, StructType, MessageBytes]()
+	{
+		void* Payload = MessageArenas[ActiveArenaIndex].Alloc(StructType->GetStructureSize(), FMath::Max(StructType->GetMinAlignment(), 1));
+		StructType->InitializeStruct(Payload);
+		StructType->CopyScriptStruct(Payload, MessageBytes);
+		return Payload;
+	};
+
+	if (QueueMode == EGameplayMessageQueueMode::QueuedKeepLatest)
+	{
+		int32& CoalescedIndex = CoalescedMessageIndices.FindOrAdd(TPair<FGameplayTag, uint64>(Channel, CoalesceKey), INDEX_NONE);
+		if (CoalescedIndex != INDEX_NONE)
+		{
+			// Replace the earlier payload, the message keeps its position in the queue
+			FQueuedMessage& Existing = QueuedMessages[CoalescedIndex];
+			++NumCoalescedMessages;
+			if (Existing.StructType == StructType)
+			{
+				StructType->CopyScriptStruct(Existing.Payload, MessageBytes);
+			}
+			else
+			{
+				Existing.StructType->DestroyStruct(Existing.Payload);
+				Existing.StructType = StructType;
+				Existing.Payload = CopyToArena();
+			}
+			return;
+		}
+		CoalescedIndex = QueuedMessages.Num();
+	}
+
+	QueuedMessages.Add({ Channel, StructType, CopyToArena() });
+}
+
+void UGameplayMessageSubsystem::FlushQueuedMessages()
+{
+	// A listener flushing from within a flush would deliver messages out of order
+	if (bFlushingQueuedMessages || QueuedMessages.Num() == 0)
+	{
+		return;
+	}
+
+	TGuardValue<bool> FlushingGuard(bFlushingQueuedMessages, true);
+
+	// Messages queued by listeners from here on go to the other arena and wait for the next flush
+	TArray<FQueuedMessage> Messages = MoveTemp(QueuedMessages);
+	QueuedMessages.Reset();
+	CoalescedMessageIndices.Reset();
+	FMemStackBase& Arena = MessageArenas[ActiveArenaIndex];
+	ActiveArenaIndex ^= 1;
+
+	for (const FQueuedMessage& Message : Messages)
+	{
+		// Listeners may have changed since the message was queued
+		const FDispatchListRef DispatchList = GetDispatchList(Message.Channel);
+		DispatchMessage(Message.Channel, Message.StructType, Message.Payload, *DispatchList);
+	}
+
+	DestroyQueuedPayloads(Messages);
+	Arena.Flush();
+
+	// Keep the allocation for the next frame
+	if (QueuedMessages.Num() == 0)
+	{
+		Messages.Reset();
+		Swap(QueuedMessages, Messages);
+	}
+}
+
+void UGameplayMessageSubsystem::DestroyQueuedPayloads(TArrayView<const FQueuedMessage> Messages)
+{
+	for (const FQueuedMessage& Message : Messages)
+	{
+		Message.StructType->DestroyStruct(Message.Payload);
+	}
 }
 
 void UGameplayMessageSubsystem::K2_BroadcastMessage(FGameplayTag Channel, const int32& Message)
@@ -201,17 +380,31 @@ FGameplayMessageListenerHandle UGameplayMessageSubsystem::RegisterListenerIntern
 ) {
 	FChannelListenerList& List = ListenerMap.FindOrAdd(Channel);
 
-	FGameplayMessageListenerData& Entry = List.Listeners.AddDefaulted_GetRef();
+	FGameplayMessageListenerData& Entry = *List.Listeners.Add_GetRef(MakeShared<FGameplayMessageListenerData, ESPMode::NotThreadSafe>());
 	Entry.bUnregisterOnWorldDestroyed = bUnregisterOnWorldDestroyed;
 	Entry.UnregisterOnActorDestroyed = UnregisterOnActorDestroyed;
+	Entry.UnregisterOnActorDestroyedKey = FObjectKey(UnregisterOnActorDestroyed);
 	Entry.ReceivedCallback = MoveTemp(Callback);
 	Entry.ListenerStructType = StructType;
 	Entry.bHadValidType = StructType != nullptr;
 	Entry.HandleID = ++List.HandleID;
 	Entry.MatchType = MatchType;
 
+	InvalidateDispatchLists(Channel, MatchType);
+
 	FGameplayMessageListenerHandle Handle = FGameplayMessageListenerHandle(this, Channel, Entry.HandleID);
 
+	const FListenerKey Key{ Channel, Entry.HandleID };
+	if (bUnregisterOnWorldDestroyed || UnregisterOnActorDestroyed != nullptr)
+	{
+		WorldListenerIndex.Add(Key);
+	}
+
+	if (UnregisterOnActorDestroyed != nullptr)
+	{
+		ActorListenerIndex.FindOrAdd(Entry.UnregisterOnActorDestroyedKey).Add(Key);
+	}
+
 	if (IsValid(UnregisterOnActorDestroyed))
 	{
 		UnregisterOnActorDestroyed->OnDestroyed.AddUniqueDynamic(this, &UGameplayMessageSubsystem::OnActorDestroyed);
@@ -222,33 +415,15 @@ FGameplayMessageListenerHandle UGameplayMessageSubsystem::RegisterListenerIntern
 
 void UGameplayMessageSubsystem::OnActorDestroyed(AActor* Actor)
 {
-	TArray<FGameplayTag> KeysToRemove;
-	for (TPair<FGameplayTag, FChannelListenerList>& Pair : ListenerMap)
+	// Only the destroyed actor's own listeners are visited; listeners of actors that went away without
+	// broadcasting OnDestroyed are removed with the world
+	TArray<FListenerKey> Keys;
+	if (ActorListenerIndex.RemoveAndCopyValue(FObjectKey(Actor), Keys))
 	{
-		FChannelListenerList& List = Pair.Value;
-		for (int i = List.Listeners.Num() - 1; i >= 0; i--)
+		for (const FListenerKey& Key : Keys)
 		{
-			if (
-				List.Listeners[i].UnregisterOnActorDestroyed != nullptr &&
-				(
-					List.Listeners[i].UnregisterOnActorDestroyed == Actor ||
-					!IsValid(List.Listeners[i].UnregisterOnActorDestroyed) // even if this isn't the actor, let's remove it if it's invalid
-				)
-			) {
-				List.Listeners.RemoveAt(i);
-			}
+			RemoveListenerInternal(Key.Channel, Key.HandleID, /*bInvalidateDispatchLists=*/ true);
 		}
-
-
-		if (List.Listeners.Num() == 0)
-		{
-			KeysToRemove.Add(Pair.Key);
-		}
-	}
-
-	for (FGameplayTag Key : KeysToRemove)
-	{
-		ListenerMap.Remove(Key);
 	}
 }
 
@@ -273,13 +448,37 @@ void UGameplayMessageSubsystem::UnregisterListener(FGameplayMessageListenerHandl
 }
 
 void UGameplayMessageSubsystem::UnregisterListenerInternal(FGameplayTag Channel, int32 HandleID)
+{
+	RemoveListenerInternal(Channel, HandleID, /*bInvalidateDispatchLists=*/ true);
+}
+
+void UGameplayMessageSubsystem::RemoveListenerInternal(FGameplayTag Channel, int32 HandleID, bool bInvalidateDispatchLists)
 {
 	if (FChannelListenerList* pList = ListenerMap.Find(Channel))
 	{
-		int32 MatchIndex = pList->Listeners.IndexOfByPredicate([ID = HandleID](const FGameplayMessageListenerData& Other) { return Other.HandleID == ID; });
-		if (MatchIndex != INDEX_NONE)
+		// Listeners are appended with increasing handle IDs and removed without reordering
+		int32 MatchIndex = Algo::LowerBoundBy(pList->Listeners, HandleID, [](const FListenerRef& Other) { return Other->HandleID; });
+		if (pList->Listeners.IsValidIndex(MatchIndex) && pList->Listeners[MatchIndex]->HandleID == HandleID)
 		{
-			pList->Listeners.RemoveAtSwap(MatchIndex);
+			const FGameplayMessageListenerData& Listener = *pList->Listeners[MatchIndex];
+			const FListenerKey Key{ Channel, HandleID };
+			WorldListenerIndex.Remove(Key);
+			if (TArray<FListenerKey>* ActorKeys = ActorListenerIndex.Find(Listener.UnregisterOnActorDestroyedKey))
+			{
+				ActorKeys->RemoveSingleSwap(Key);
+				if (ActorKeys->Num() == 0)
+				{
+					ActorListenerIndex.Remove(Listener.UnregisterOnActorDestroyedKey);
+				}
+			}
+
+			// A broadcast in progress may still hold this listener, it is released once that broadcast finishes
+			pList->Listeners[MatchIndex]->bRemoved = true;
+			if (bInvalidateDispatchLists)
+			{
+				InvalidateDispatchLists(Channel, Listener.MatchType);
+			}
+			pList->Listeners.RemoveAt(MatchIndex);
 		}
 
 		if (pList->Listeners.Num() == 0)
@@ -0,0 +1,184 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "Engine/World.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * Console benchmark for UGameplayMessageSubsystem broadcasts.
+ *
+ * Registers listeners spread over every level of the deepest registered gameplay tag, alternating exact and
+ * partial matches, then broadcasts on each level in turn. The cached dispatch lists are compared against the
+ * previous implementation, which walked the tag parents and copied each level's listeners on every broadcast.
+ * Also checks that listeners (un)registered from within a callback follow the documented rules.
+ */
+struct FGameplayMessageSubsystemBenchmark
+{
+	// The previous BroadcastMessageInternal: walk the tag parents and copy the listeners of each level before calling them
+	static void LegacyBroadcast(UGameplayMessageSubsystem& Router, FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes)
+	{
+		bool bOnInitialTag = true;
+		for (FGameplayTag Tag = Channel; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+		{
+			if (const UGameplayMessageSubsystem::FChannelListenerList* pList = Router.ListenerMap.Find(Tag))
+			{
+				TArray<FGameplayMessageListenerData> ListenerArray;
+				ListenerArray.Reserve(pList->Listeners.Num());
+				for (const UGameplayMessageSubsystem::FListenerRef& Listener : pList->Listeners)
+				{
+					ListenerArray.Add(*Listener);
+				}
+
+				for (const FGameplayMessageListenerData& Listener : ListenerArray)
+				{
+					if ((bOnInitialTag || (Listener.MatchType == EGameplayMessageMatch::PartialMatch))
+						&& (!Listener.bHadValidType || StructType->IsChildOf(Listener.ListenerStructType.Get())))
+					{
+						Listener.ReceivedCallback(Channel, StructType, MessageBytes);
+					}
+				}
+			}
+			bOnInitialTag = false;
+		}
+	}
+
+	// Returns the deepest registered tag and all of its parents, root first
+	// Tags with game listeners anywhere along the chain are skipped so the benchmark messages only reach its own listeners
+	static TArray<FGameplayTag> FindDeepestTagChain(const UGameplayMessageSubsystem& Router)
+	{
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, /*OnlyIncludeDictionaryTags=*/ false);
+
+		TArray<FGameplayTag> DeepestChain;
+		for (const FGameplayTag& Tag : AllTags)
+		{
+			TArray<FGameplayTag> Chain;
+			for (FGameplayTag Parent = Tag; Parent.IsValid(); Parent = Parent.RequestDirectParent())
+			{
+				Chain.Insert(Parent, 0);
+			}
+			const bool bHasGameListeners = Chain.ContainsByPredicate([&Router](const FGameplayTag& ChainTag) { return Router.ListenerMap.Contains(ChainTag); });
+			if (!bHasGameListeners && Chain.Num() > DeepestChain.Num())
+			{
+				DeepestChain = MoveTemp(Chain);
+			}
+		}
+		return DeepestChain;
+	}
+
+	static int32 CheckReentrancy(UGameplayMessageSubsystem& Router, FGameplayTag Channel)
+	{
+		int32 NumErrors = 0;
+		int32 NumVictimCalls = 0;
+		int32 NumLateCalls = 0;
+		FGameplayMessageListenerHandle VictimHandle;
+		FGameplayMessageListenerHandle LateHandle;
+		FGameplayMessageListenerHandle RemoverHandle;
+
+		// The remover is registered first so it is dispatched before the victim
+		RemoverHandle = Router.RegisterListener<FVector>(Channel, [&](FGameplayTag, const FVector&)
+		{
+			if (!LateHandle.IsValid())
+			{
+				VictimHandle.Unregister();
+				LateHandle = Router.RegisterListener<FVector>(Channel, [&NumLateCalls](FGameplayTag, const FVector&) { ++NumLateCalls; });
+				RemoverHandle.Unregister();
+			}
+		});
+		VictimHandle = Router.RegisterListener<FVector>(Channel, [&NumVictimCalls](FGameplayTag, const FVector&) { ++NumVictimCalls; });
+
+		Router.BroadcastMessage(Channel, FVector::ZeroVector);
+		if (NumVictimCalls != 0 || NumLateCalls != 0)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.Benchmark: listeners changed during a broadcast must not be called by it (victim %d, late %d)"), NumVictimCalls, NumLateCalls);
+			++NumErrors;
+		}
+
+		Router.BroadcastMessage(Channel, FVector::ZeroVector);
+		if (NumVictimCalls != 0 || NumLateCalls != 1)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.Benchmark: the next broadcast should reach only the late listener (victim %d, late %d)"), NumVictimCalls, NumLateCalls);
+			++NumErrors;
+		}
+
+		LateHandle.Unregister();
+		return NumErrors;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !UGameplayMessageSubsystem::HasInstance(World))
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.Benchmark: requires a world with a game instance"));
+			return;
+		}
+
+		const int32 NumMessages = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000000;
+		const int32 NumListeners = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 200;
+
+		UGameplayMessageSubsystem& Router = UGameplayMessageSubsystem::Get(World);
+		const TArray<FGameplayTag> Chain = FindDeepestTagChain(Router);
+		if (Chain.Num() == 0)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.Benchmark: no gameplay tag without game listeners found"));
+			return;
+		}
+
+		int32 NumErrors = CheckReentrancy(Router, Chain.Last());
+
+		int64 NumCalls = 0;
+		TArray<FGameplayMessageListenerHandle> Handles;
+		for (int32 i = 0; i < NumListeners; ++i)
+		{
+			const EGameplayMessageMatch MatchType = (i % 2 == 0) ? EGameplayMessageMatch::PartialMatch : EGameplayMessageMatch::ExactMatch;
+			Handles.Add(Router.RegisterListener<FVector>(Chain[i % Chain.Num()], [&NumCalls](FGameplayTag, const FVector&) { ++NumCalls; }, nullptr, MatchType));
+		}
+
+		const UScriptStruct* StructType = TBaseStructure<FVector>::Get();
+		const FVector Message = FVector::OneVector;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumMessages; ++i)
+		{
+			LegacyBroadcast(Router, Chain[i % Chain.Num()], StructType, &Message);
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - StartTime;
+		const int64 LegacyCalls = NumCalls;
+
+		NumCalls = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumMessages; ++i)
+		{
+			Router.BroadcastMessage(Chain[i % Chain.Num()], Message);
+		}
+		const double CachedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		if (NumCalls != LegacyCalls)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.Benchmark: listener calls differ (legacy %lld, cached %lld)"), LegacyCalls, NumCalls);
+			++NumErrors;
+		}
+
+		for (FGameplayMessageListenerHandle& Handle : Handles)
+		{
+			Handle.Unregister();
+		}
+
+		UE_LOG(LogGameplayMessageSubsystem, Display, TEXT("GameplayMessageSubsystem.Benchmark: %s (%d messages, %d listeners over %d tag levels ending at %s, %lld listener calls, %d errors)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumMessages, NumListeners, Chain.Num(), *Chain.Last().ToString(), NumCalls, NumErrors);
+		UE_LOG(LogGameplayMessageSubsystem, Display, TEXT("  Broadcast: legacy %.1f ns / cached dispatch list %.1f ns (%.1fx)"),
+			LegacySeconds * 1e9 / NumMessages, CachedSeconds * 1e9 / NumMessages, CachedSeconds > 0.0 ? LegacySeconds / CachedSeconds : 0.0);
+	}
+};
+
+namespace UE
+{
+	namespace GameplayMessageSubsystem
+	{
+		static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+			TEXT("GameplayMessageSubsystem.Benchmark"),
+			TEXT("Compares cached dispatch lists against walking tag parents on every broadcast: GameplayMessageSubsystem.Benchmark [Messages=1000000] [Listeners=200]"),
+			FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FGameplayMessageSubsystemBenchmark::Run));
+	}
+}
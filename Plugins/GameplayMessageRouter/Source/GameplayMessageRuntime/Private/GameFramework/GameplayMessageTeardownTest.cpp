@@ -0,0 +1,191 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * Console stress test for listener cleanup when actors are destroyed.
+ *
+ * Spawns actors that each register listeners on several channels, alongside listeners that belong to no
+ * actor, then destroys every actor at once (as a round reset would). Checks that exactly the actors'
+ * listeners are gone and that the owner index is empty afterwards, and compares the time spent against
+ * the previous cleanup, which scanned every listener of every channel for each destroyed actor.
+ */
+struct FGameplayMessageTeardownTest
+{
+	// The previous OnActorDestroyed lookup: visit every listener of every channel
+	static int32 LegacyScan(const UGameplayMessageSubsystem& Router, const AActor* Actor)
+	{
+		int32 NumMatches = 0;
+		for (const TPair<FGameplayTag, UGameplayMessageSubsystem::FChannelListenerList>& Pair : Router.ListenerMap)
+		{
+			for (const UGameplayMessageSubsystem::FListenerRef& Listener : Pair.Value.Listeners)
+			{
+				NumMatches += (Listener->UnregisterOnActorDestroyed != nullptr && Listener->UnregisterOnActorDestroyed == Actor) ? 1 : 0;
+			}
+		}
+		return NumMatches;
+	}
+
+	static int32 CountListeners(const UGameplayMessageSubsystem& Router)
+	{
+		int32 NumListeners = 0;
+		for (const TPair<FGameplayTag, UGameplayMessageSubsystem::FChannelListenerList>& Pair : Router.ListenerMap)
+		{
+			NumListeners += Pair.Value.Listeners.Num();
+		}
+		return NumListeners;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !UGameplayMessageSubsystem::HasInstance(World))
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.TestTeardown: requires a world with a game instance"));
+			return;
+		}
+
+		const int32 NumActors = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 2000;
+		const int32 NumListenersPerActor = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 4;
+		const int32 NumChannels = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 64;
+
+		UGameplayMessageSubsystem& Router = UGameplayMessageSubsystem::Get(World);
+
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, /*OnlyIncludeDictionaryTags=*/ false);
+		// Skip channels the game listens to so the test broadcasts below reach no game code
+		TArray<FGameplayTag> Channels;
+		for (const FGameplayTag& Tag : AllTags)
+		{
+			bool bInUse = false;
+			for (FGameplayTag Parent = Tag; Parent.IsValid() && !bInUse; Parent = Parent.RequestDirectParent())
+			{
+				bInUse = Router.ListenerMap.Contains(Parent);
+			}
+			if (bInUse)
+			{
+				continue;
+			}
+			Channels.Add(Tag);
+			if (Channels.Num() == NumChannels)
+			{
+				break;
+			}
+		}
+		if (Channels.Num() == 0)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.TestTeardown: no unused gameplay tag found"));
+			return;
+		}
+
+		const int32 NumListenersBefore = CountListeners(Router);
+		const int32 NumIndexedActorsBefore = Router.ActorListenerIndex.Num();
+
+		// Listeners without an owner must survive the teardown
+		TArray<FGameplayMessageListenerHandle> UnownedHandles;
+		for (const FGameplayTag& Channel : Channels)
+		{
+			UnownedHandles.Add(Router.RegisterListener<FVector>(Channel, [](FGameplayTag, const FVector&) {}));
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<AActor*> Actors;
+		for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+		{
+			AActor* Actor = World->SpawnActor<AActor>(SpawnParams);
+			if (!Actor)
+			{
+				continue;
+			}
+			Actors.Add(Actor);
+
+			for (int32 i = 0; i < NumListenersPerActor; ++i)
+			{
+				const FGameplayTag& Channel = Channels[(ActorIndex * NumListenersPerActor + i) % Channels.Num()];
+				const EGameplayMessageMatch MatchType = (i % 2 == 0) ? EGameplayMessageMatch::ExactMatch : EGameplayMessageMatch::PartialMatch;
+				Router.RegisterListener<FVector>(Channel, [](FGameplayTag, const FVector&) {}, Actor, MatchType);
+			}
+		}
+
+		int32 NumErrors = 0;
+		const int32 NumRegistered = CountListeners(Router);
+		if (NumRegistered != NumListenersBefore + Channels.Num() + Actors.Num() * NumListenersPerActor)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.TestTeardown: %d listeners registered, expected %d"),
+				NumRegistered, NumListenersBefore + Channels.Num() + Actors.Num() * NumListenersPerActor);
+			++NumErrors;
+		}
+
+		// The previous cleanup, measured without removing anything
+		int64 NumLegacyMatches = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (const AActor* Actor : Actors)
+		{
+			NumLegacyMatches += LegacyScan(Router, Actor);
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - StartTime;
+
+		// Broadcasting keeps dispatch lists cached, as they would be in a running game
+		for (const FGameplayTag& Channel : Channels)
+		{
+			Router.BroadcastMessage(Channel, FVector::ZeroVector);
+		}
+
+		StartTime = FPlatformTime::Seconds();
+		for (AActor* Actor : Actors)
+		{
+			Actor->Destroy();
+		}
+		const double IndexedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const int32 NumRemaining = CountListeners(Router);
+		if (NumRemaining != NumListenersBefore + Channels.Num())
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.TestTeardown: %d listeners remain after destroying the actors, expected %d"),
+				NumRemaining, NumListenersBefore + Channels.Num());
+			++NumErrors;
+		}
+		if (Router.ActorListenerIndex.Num() != NumIndexedActorsBefore)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.TestTeardown: owner index still holds %d destroyed actors"),
+				Router.ActorListenerIndex.Num() - NumIndexedActorsBefore);
+			++NumErrors;
+		}
+		if (NumLegacyMatches != static_cast<int64>(Actors.Num()) * NumListenersPerActor)
+		{
+			++NumErrors;
+		}
+
+		for (FGameplayMessageListenerHandle& Handle : UnownedHandles)
+		{
+			Handle.Unregister();
+		}
+		if (CountListeners(Router) != NumListenersBefore)
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("GameplayMessageSubsystem.TestTeardown: unowned listeners were not unregistered"));
+			++NumErrors;
+		}
+
+		UE_LOG(LogGameplayMessageSubsystem, Display, TEXT("GameplayMessageSubsystem.TestTeardown: %s (%d actors x %d listeners over %d channels, %d errors)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), Actors.Num(), NumListenersPerActor, Channels.Num(), NumErrors);
+		UE_LOG(LogGameplayMessageSubsystem, Display, TEXT("  Per destroyed actor: legacy scan alone %.2f us / owner index incl. actor destruction %.2f us"),
+			Actors.Num() > 0 ? LegacySeconds * 1e6 / Actors.Num() : 0.0, Actors.Num() > 0 ? IndexedSeconds * 1e6 / Actors.Num() : 0.0);
+	}
+};
+
+namespace UE
+{
+	namespace GameplayMessageSubsystem
+	{
+		static FAutoConsoleCommandWithWorldAndArgs CmdTestTeardown(
+			TEXT("GameplayMessageSubsystem.TestTeardown"),
+			TEXT("Destroys many actors with registered listeners and checks the owner index cleanup: GameplayMessageSubsystem.TestTeardown [Actors=2000] [ListenersPerActor=4] [Channels=64]"),
+			FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FGameplayMessageTeardownTest::Run));
+	}
+}
@@ -4,7 +4,10 @@
 
 #include "GameFramework/GameplayMessageTypes2.h"
 #include "GameplayTagContainer.h"
+#include "Misc/MemStack.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
 #include "UObject/WeakObjectPtr.h"
 
 #include "GameplayMessageSubsystem.generated.h"
@@ -60,6 +63,9 @@ struct FGameplayMessageListenerData
 	bool bUnregisterOnWorldDestroyed = true;
 	AActor* UnregisterOnActorDestroyed = nullptr;
 
+	// Key of UnregisterOnActorDestroyed, still usable once the actor has been garbage collected
+	FObjectKey UnregisterOnActorDestroyedKey;
+
 	// Callback for when a message has been received
 	TFunction<void(FGameplayTag, const UScriptStruct*, const void*)> ReceivedCallback;
 
@@ -69,6 +75,9 @@ struct FGameplayMessageListenerData
 	// Adding some logging and extra variables around some potential problems with this
 	TWeakObjectPtr<const UScriptStruct> ListenerStructType = nullptr;
 	bool bHadValidType = false;
+
+	// Set when the listener is unregistered, so a dispatch already in flight skips it
+	bool bRemoved = false;
 };
 
 /**
@@ -84,13 +93,31 @@ struct FGameplayMessageListenerData
  *
  * Note that call order when there are multiple listeners for the same channel is
  * not guaranteed and can change over time!
+ *
+ * Each broadcast channel has a cached dispatch list holding its exact match listeners
+ * followed by the partial match listeners of its parent tags, so a broadcast neither
+ * walks the tag hierarchy nor copies listeners. Registering or unregistering only drops
+ * the cached lists it affects. Listeners unregistered during a broadcast are skipped by
+ * that broadcast and released once it finishes; listeners registered during a broadcast
+ * receive messages from the next one.
+ *
+ * Listeners bound to an actor or to the world are also indexed by owner, so destroying an
+ * actor only touches that actor's own listeners.
+ *
+ * Channels can opt into queued delivery with SetChannelQueueMode, for bursty producers that
+ * would otherwise make listeners do the same work several times per frame. Queued messages
+ * are copied into a per-frame arena and delivered in broadcast order when the subsystem
+ * ticks, after the world's actors have ticked.
  */
 UCLASS()
-class GAMEPLAYMESSAGERUNTIME_API UGameplayMessageSubsystem : public UGameInstanceSubsystem
+class GAMEPLAYMESSAGERUNTIME_API UGameplayMessageSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 
 	friend UAsyncAction_ListenForGameplayMessage;
+	friend struct FGameplayMessageSubsystemBenchmark;
+	friend struct FGameplayMessageQueueTest;
+	friend struct FGameplayMessageTeardownTest;
 
 public:
 
@@ -109,6 +136,15 @@ public:
 	virtual void Deinitialize() override;
 	//~End of USubsystem interface
 
+	//~FTickableObjectBase interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	//~End of FTickableObjectBase interface
+
 	UFUNCTION()
 	void OnWorldDestroyed(UWorld* World);
 
@@ -131,8 +167,40 @@ public:
 		BroadcastMessageInternal(Channel, StructType, &Message);
 	}
 
+	/**
+	 * Broadcast a message on the specified channel, identifying it for QueuedKeepLatest channels
+	 *
+	 * @param Channel			The message channel to broadcast on
+	 * @param Message			The message to send (must be the same type of UScriptStruct expected by the listeners for this channel, otherwise an error will be logged)
+	 * @param CoalesceKey		On a QueuedKeepLatest channel, replaces the message queued this frame with the same key (e.g. an item or actor id); ignored otherwise
+	 */
+	template <typename FMessageStructType>
+	void BroadcastMessage(FGameplayTag Channel, const FMessageStructType& Message, uint64 CoalesceKey)
+	{
+		const UScriptStruct* StructType = TBaseStructure<FMessageStructType>::Get();
+		BroadcastMessageInternal(Channel, StructType, &Message, CoalesceKey);
+	}
+
 	// Internal helper for broadcasting a message
-	void BroadcastMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes);
+	void BroadcastMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, uint64 CoalesceKey = 0);
+
+	/**
+	 * Set how broadcasts on a channel are delivered
+	 * Only applies to broadcasts on exactly this channel, child channels keep their own mode
+	 *
+	 * @param Channel			The message channel
+	 * @param QueueMode			Immediate (default), Queued or QueuedKeepLatest
+	 */
+	void SetChannelQueueMode(FGameplayTag Channel, EGameplayMessageQueueMode QueueMode);
+
+	// @return how broadcasts on the channel are delivered
+	EGameplayMessageQueueMode GetChannelQueueMode(FGameplayTag Channel) const;
+
+	/**
+	 * Deliver every queued message now, in broadcast order
+	 * Called automatically once per frame; messages queued by listeners during the flush are delivered by the next one
+	 */
+	void FlushQueuedMessages();
 
 	/**
 	 * Register to receive messages on a specified channel
@@ -263,14 +331,96 @@ private:
 
 	void UnregisterListenerInternal(FGameplayTag Channel, int32 HandleID);
 
+	// Removes a listener and its owner index entries, bulk teardown skips the dispatch list invalidation and resets the cache once
+	void RemoveListenerInternal(FGameplayTag Channel, int32 HandleID, bool bInvalidateDispatchLists);
+
 private:
-	// List of all entries for a given channel
+	// Identifies a registered listener the same way a handle does
+	struct FListenerKey
+	{
+		FGameplayTag Channel;
+		int32 HandleID = 0;
+
+		bool operator==(const FListenerKey& Other) const { return HandleID == Other.HandleID && Channel == Other.Channel; }
+		friend uint32 GetTypeHash(const FListenerKey& Key) { return HashCombine(GetTypeHash(Key.Channel), ::GetTypeHash(Key.HandleID)); }
+	};
+
+	// Listener data is shared with the dispatch lists so it stays alive while a broadcast is calling it
+	using FListenerRef = TSharedRef<FGameplayMessageListenerData, ESPMode::NotThreadSafe>;
+
+	// List of all entries for a given channel, sorted by HandleID
 	struct FChannelListenerList
 	{
-		TArray<FGameplayMessageListenerData> Listeners;
+		TArray<FListenerRef> Listeners;
 		int32 HandleID = 0;
 	};
 
+	// A listener to call for a broadcast channel, along with the channel it was registered on
+	struct FDispatchEntry
+	{
+		FListenerRef Listener;
+		FGameplayTag ListenerChannel;
+	};
+
+	// Every listener that receives a broadcast on one channel: its exact match listeners followed by the partial match listeners of its parents
+	struct FChannelDispatchList
+	{
+		TArray<FDispatchEntry> Entries;
+		EGameplayMessageQueueMode QueueMode = EGameplayMessageQueueMode::Immediate;
+	};
+
+	// A message waiting to be delivered, its payload lives in the arena of the frame it was queued in
+	struct FQueuedMessage
+	{
+		FGameplayTag Channel;
+		const UScriptStruct* StructType = nullptr;
+		void* Payload = nullptr;
+	};
+
+	using FDispatchListRef = TSharedRef<const FChannelDispatchList, ESPMode::NotThreadSafe>;
+
+	// Returns the cached dispatch list for a broadcast channel, building it on first use
+	FDispatchListRef GetDispatchList(FGameplayTag Channel);
+
+	// Drops the cached dispatch lists that a listener registered on Channel with MatchType belongs to
+	void InvalidateDispatchLists(FGameplayTag Channel, EGameplayMessageMatch MatchType);
+
+	// Calls the listeners of a dispatch list
+	void DispatchMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, const FChannelDispatchList& DispatchList);
+
+	// Copies a message into the current frame's arena, or over the message it replaces
+	void QueueMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, EGameplayMessageQueueMode QueueMode, uint64 CoalesceKey);
+
+	// Destroys the payloads of queued messages without delivering them
+	static void DestroyQueuedPayloads(TArrayView<const FQueuedMessage> Messages);
+
 private:
 	TMap<FGameplayTag, FChannelListenerList> ListenerMap;
+
+	// Broadcast channel -> listeners to call, rebuilt lazily after registrations change
+	TMap<FGameplayTag, FDispatchListRef> DispatchCache;
+
+	// Actor -> listeners to remove when it is destroyed
+	TMap<FObjectKey, TArray<FListenerKey>> ActorListenerIndex;
+
+	// Listeners to remove when the world is destroyed: bUnregisterOnWorldDestroyed or bound to an actor
+	TSet<FListenerKey> WorldListenerIndex;
+
+	// Channels that do not deliver immediately
+	TMap<FGameplayTag, EGameplayMessageQueueMode> ChannelQueueModes;
+
+	// Messages waiting for the next flush, in broadcast order
+	TArray<FQueuedMessage> QueuedMessages;
+
+	// (Channel, CoalesceKey) -> index in QueuedMessages, for QueuedKeepLatest channels
+	TMap<TPair<FGameplayTag, uint64>, int32> CoalescedMessageIndices;
+
+	// Payload storage, one arena fills up while the other one's messages are being delivered
+	FMemStackBase MessageArenas[2];
+	int32 ActiveArenaIndex = 0;
+	bool bFlushingQueuedMessages = false;
+
+	// Totals since the subsystem was created
+	int64 NumQueuedMessages = 0;
+	int64 NumCoalescedMessages = 0;
 };
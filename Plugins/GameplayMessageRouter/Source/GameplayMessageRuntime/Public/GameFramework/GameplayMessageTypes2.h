@@ -22,6 +22,21 @@ enum class EGameplayMessageMatch : uint8
 	PartialMatch
 };
 
+// How broadcasts on a channel are delivered to its listeners
+UENUM(BlueprintType)
+enum class EGameplayMessageQueueMode : uint8
+{
+	// Listeners are called from within the broadcast
+	Immediate,
+
+	// Messages are buffered and delivered in broadcast order once per frame, after the world has ticked
+	Queued,
+
+	// Like Queued, but a message replaces the one already queued this frame with the same channel and coalesce key,
+	// keeping that message's place in the delivery order
+	QueuedKeepLatest
+};
+
 /**
  * Struct used to specify advanced behavior when registering a listener for gameplay messages
  */
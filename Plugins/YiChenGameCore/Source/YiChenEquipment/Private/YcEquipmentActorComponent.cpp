@@ -16,9 +16,9 @@ void UYcEquipmentActorComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProp
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	// 只在初始化时同步一次，后续不会修改
-	DOREPLIFETIME_CONDITION(UYcEquipmentActorComponent, EquipmentInst, COND_InitialOnly);
-	DOREPLIFETIME_CONDITION(UYcEquipmentActorComponent, EquipmentTags, COND_InitialOnly);
+	// 同一装备实例内不会修改，但对象池复用Actor时会变化，所以不能只同步初始值
+	DOREPLIFETIME(UYcEquipmentActorComponent, EquipmentInst);
+	DOREPLIFETIME(UYcEquipmentActorComponent, EquipmentTags);
 }
 
 UYcEquipmentInstance* UYcEquipmentActorComponent::GetEquipmentFromActor(const AActor* Actor)
@@ -46,8 +46,10 @@ void UYcEquipmentActorComponent::OnRep_EquipmentInst()
 	 * 补充Actor显示隐藏方式选择原因：
 	 * 之所以不直接用Actor的bHidden开控制显隐藏是因为它是网络复制的, 在为主控客户端做连续多次预测时bHidden的同步会影响预测表现, 导致Actor出现多余的显隐问题
 	 * 所以我们采用了服务端/客户端通过特定的属性同步通知来独立控制显隐的方案, 这也可以正确的保持多端同步
+	 * 
+	 * 对象池：Actor归还到服务器的对象池时 EquipmentInst 被置空，客户端同样按未装备处理
 	 */
-	if (!GetOwner()->HasAuthority() && EquipmentInst && !EquipmentInst->IsEquipped())
+	if (!GetOwner()->HasAuthority() && (!EquipmentInst || !EquipmentInst->IsEquipped()))
 	{
 		// 如果所属的装备实例处于Unequipped状态就隐藏
 		UYcEquipmentInstance::SetActorVisualVisibility(GetOwner(), false);
@@ -56,7 +58,10 @@ void UYcEquipmentActorComponent::OnRep_EquipmentInst()
 		// 关闭碰撞
 		GetOwner()->SetActorEnableCollision(false);
 	}
-	OnEquipmentRep.Broadcast(GetOwningEquipment());
+	if (EquipmentInst)
+	{
+		OnEquipmentRep.Broadcast(GetOwningEquipment());
+	}
 }
 
 void UYcEquipmentActorComponent::NotifyEquipmentStateChanged(const bool bEquipped) const
@@ -70,3 +75,16 @@ void UYcEquipmentActorComponent::NotifyEquipmentStateChanged(const bool bEquippe
 		OnUnequipped.Broadcast(EquipmentInst);
 	}
 }
+
+void UYcEquipmentActorComponent::NotifyAcquiredFromPool() const
+{
+	OnAcquiredFromPool.Broadcast(EquipmentInst);
+}
+
+void UYcEquipmentActorComponent::ResetForPool()
+{
+	OnReturnedToPool.Broadcast(EquipmentInst);
+	
+	EquipmentInst = nullptr;
+	EquipmentTags.Reset();
+}
@@ -0,0 +1,266 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcEquipmentActorPoolBenchmark.h"
+
+#include "YcEquipmentActorComponent.h"
+#include "YcEquipmentActorPoolSubsystem.h"
+#include "YcEquipmentInstance.h"
+#include "YcEquipmentManagerComponent.h"
+#include "YcInventoryItemInstance.h"
+#include "YiChenEquipment.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Fragments/InventoryFragment_Equippable.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/UObjectArray.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcEquipmentActorPoolBenchmark)
+
+AYcEquipmentActorPoolBenchmarkActor::AYcEquipmentActorPoolBenchmarkActor()
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	EquipmentActorComponent = CreateDefaultSubobject<UYcEquipmentActorComponent>(TEXT("EquipmentActorComponent"));
+
+	bReplicates = true;
+	SetActorEnableCollision(false);
+}
+
+void AYcEquipmentActorPoolBenchmarkActor::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	EquipmentActorComponent->OnAcquiredFromPool.AddDynamic(this, &ThisClass::HandleAcquiredFromPool);
+	EquipmentActorComponent->OnReturnedToPool.AddDynamic(this, &ThisClass::HandleReturnedToPool);
+}
+
+void AYcEquipmentActorPoolBenchmarkActor::HandleAcquiredFromPool(UYcEquipmentInstance* EquipmentInst)
+{
+	++NumAcquiredFromPool;
+}
+
+void AYcEquipmentActorPoolBenchmarkActor::HandleReturnedToPool(UYcEquipmentInstance* EquipmentInst)
+{
+	++NumReturnedToPool;
+}
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * 装备Actor对象池压力测试（控制台命令，需在服务端/单机世界中执行，可在 -nullrhi 的无头模式下运行）
+ *
+ * 模拟装备栏/QuickBar 反复切换装备：每个循环 CreateEquipment -> EquipItem -> UnequipItem -> DestroyEquipment，
+ * 分别在关闭对象池（Yc.Equipment.ActorPoolSize=0，即改造前每次生成/销毁Actor）与开启对象池时运行，对比：
+ * - 生成/复用的Actor数量
+ * - UObject 数量与物理内存的增长（关闭对象池时被销毁的Actor要等到GC才会回收）
+ * - 单个循环耗时的平均值、P99、最大值以及超过 1ms 的尖峰次数
+ *
+ * 每个循环同时核对装备Actor组件：装备期间指向当前装备实例，归还后被清空，复用并从休眠唤醒的Actor保持类默认的碰撞设置；
+ * 使用默认测试Actor时还核对对象池复用/归还事件的广播次数。
+ * 通过 SetItemDefForTesting 给物品实例注入定义，不依赖DataRegistry中的数据。
+ */
+struct FYcEquipmentActorPoolBenchmark
+{
+	struct FRunResult
+	{
+		int64 NumSpawned = 0;
+		int64 NumReused = 0;
+		int32 NumAcquiredEvents = 0;
+		int32 NumReturnedEvents = 0;
+		int32 ObjectDelta = 0;
+		int64 MemoryDeltaBytes = 0;
+		double AverageMs = 0.0;
+		double P99Ms = 0.0;
+		double MaxMs = 0.0;
+		int32 NumSpikes = 0;
+	};
+
+	static FRunResult RunCycles(UYcEquipmentManagerComponent* Manager, UYcInventoryItemInstance* Item, UYcEquipmentActorPoolSubsystem* PoolSubsystem,
+		const int32 NumCycles, int32& NumErrors)
+	{
+		const FYcEquipmentActorPoolStats StatsBefore = PoolSubsystem->GetPoolStats();
+		const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+		const uint64 MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+		TArray<double> CycleMs;
+		CycleMs.Reserve(NumCycles);
+		TArray<TWeakObjectPtr<AYcEquipmentActorPoolBenchmarkActor>> TestActors;
+		for (int32 i = 0; i < NumCycles; ++i)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+
+			UYcEquipmentInstance* Instance = Manager->CreateEquipment(Item);
+			if (!Instance)
+			{
+				++NumErrors;
+				break;
+			}
+			Manager->EquipItem(Instance);
+			if (Instance->GetSpawnedActors().Num() != 1)
+			{
+				++NumErrors;
+				break;
+			}
+
+			AActor* Actor = Instance->GetSpawnedActors()[0];
+			UYcEquipmentActorComponent* EquipComp = Actor->FindComponentByClass<UYcEquipmentActorComponent>();
+			if (!EquipComp || EquipComp->GetOwningEquipment() != Instance
+				|| Actor->GetActorEnableCollision() != Actor->GetClass()->GetDefaultObject<AActor>()->GetActorEnableCollision())
+			{
+				UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.BenchmarkActorPool: 第 %d 次循环的装备Actor %s 状态不正确"), i, *GetNameSafe(Actor));
+				++NumErrors;
+				break;
+			}
+			if (AYcEquipmentActorPoolBenchmarkActor* TestActor = Cast<AYcEquipmentActorPoolBenchmarkActor>(Actor))
+			{
+				TestActors.AddUnique(TestActor);
+			}
+
+			Manager->UnequipItem(Instance);
+			Manager->DestroyEquipment(Instance);
+
+			// 留在对象池中的Actor应已清除装备数据
+			if (IsValid(Actor) && EquipComp->GetOwningEquipment() != nullptr)
+			{
+				UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.BenchmarkActorPool: 第 %d 次循环归还的装备Actor %s 仍引用装备实例"), i, *GetNameSafe(Actor));
+				++NumErrors;
+				break;
+			}
+
+			CycleMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+
+		const FYcEquipmentActorPoolStats StatsAfter = PoolSubsystem->GetPoolStats();
+
+		FRunResult Result;
+		Result.NumSpawned = StatsAfter.NumSpawned - StatsBefore.NumSpawned;
+		Result.NumReused = StatsAfter.NumReused - StatsBefore.NumReused;
+		for (const TWeakObjectPtr<AYcEquipmentActorPoolBenchmarkActor>& TestActor : TestActors)
+		{
+			if (TestActor.IsValid())
+			{
+				Result.NumAcquiredEvents += TestActor->NumAcquiredFromPool;
+				Result.NumReturnedEvents += TestActor->NumReturnedToPool;
+			}
+		}
+		Result.ObjectDelta = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+		Result.MemoryDeltaBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(MemoryBefore);
+
+		if (CycleMs.Num() > 0)
+		{
+			double TotalMs = 0.0;
+			for (const double Ms : CycleMs)
+			{
+				TotalMs += Ms;
+				Result.NumSpikes += Ms > 1.0 ? 1 : 0;
+			}
+			Result.AverageMs = TotalMs / CycleMs.Num();
+
+			CycleMs.Sort();
+			Result.P99Ms = CycleMs[FMath::Min(CycleMs.Num() - 1, FMath::FloorToInt(CycleMs.Num() * 0.99))];
+			Result.MaxMs = CycleMs.Last();
+		}
+		return Result;
+	}
+
+	static void LogResult(const TCHAR* Label, const FRunResult& Result)
+	{
+		UE_LOG(LogYcEquipment, Display, TEXT("  %s: 生成 %lld / 复用 %lld, UObject +%d, 内存 %+.2f MB, 单次 平均 %.3f ms / P99 %.3f ms / 最大 %.3f ms, >1ms 尖峰 %d 次"),
+			Label, Result.NumSpawned, Result.NumReused, Result.ObjectDelta, Result.MemoryDeltaBytes / (1024.0 * 1024.0),
+			Result.AverageMs, Result.P99Ms, Result.MaxMs, Result.NumSpikes);
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		UYcEquipmentActorPoolSubsystem* PoolSubsystem = UYcEquipmentActorPoolSubsystem::Get(World);
+		if (!World || World->GetNetMode() == NM_Client || !PoolSubsystem)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.BenchmarkActorPool: 需要在服务端或单机的游戏世界中执行"));
+			return;
+		}
+
+		const int32 NumCycles = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		UClass* ActorClass = Args.Num() > 1 ? LoadClass<AActor>(nullptr, *Args[1]) : AYcEquipmentActorPoolBenchmarkActor::StaticClass();
+		if (!ActorClass)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.BenchmarkActorPool: 无法加载Actor类 %s"), *Args[1]);
+			return;
+		}
+
+		IConsoleVariable* PoolSizeCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Yc.Equipment.ActorPoolSize"));
+		if (!PoolSizeCVar)
+		{
+			return;
+		}
+		const int32 SavedPoolSize = PoolSizeCVar->GetInt();
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		APawn* Pawn = World->SpawnActor<APawn>(SpawnParams);
+		if (!Pawn)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.BenchmarkActorPool: 无法生成测试Actor"));
+			return;
+		}
+		UYcEquipmentManagerComponent* Manager = NewObject<UYcEquipmentManagerComponent>(Pawn, TEXT("BenchmarkEquipmentManager"));
+		Manager->RegisterComponent();
+
+		FYcEquipmentActorToSpawn SpawnInfo;
+		SpawnInfo.ActorToSpawn = ActorClass;
+		SpawnInfo.bReplicateActor = true;
+
+		FInventoryFragment_Equippable Equippable;
+		Equippable.EquipmentDef.ActorsToSpawn.Add(SpawnInfo);
+		FYcInventoryItemDefinition ItemDef;
+		ItemDef.Fragments.Add(TInstancedStruct<FYcInventoryItemFragment>::Make<FInventoryFragment_Equippable>(Equippable));
+
+		UYcInventoryItemInstance* Item = NewObject<UYcInventoryItemInstance>(Pawn);
+		Item->SetItemDefForTesting(&ItemDef);
+
+		int32 NumErrors = 0;
+		PoolSubsystem->ClearPool();
+		PoolSizeCVar->Set(0, ECVF_SetByConsole);
+		const FRunResult Unpooled = RunCycles(Manager, Item, PoolSubsystem, NumCycles, NumErrors);
+
+		PoolSizeCVar->Set(FMath::Max(1, SavedPoolSize), ECVF_SetByConsole);
+		const FRunResult Pooled = RunCycles(Manager, Item, PoolSubsystem, NumCycles, NumErrors);
+
+		PoolSizeCVar->Set(SavedPoolSize, ECVF_SetByConsole);
+
+		// 开启对象池后只有第一次需要生成，之后全部复用
+		if (Unpooled.NumReused != 0 || Pooled.NumSpawned > 1 || Pooled.NumReused < NumCycles - 1)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.BenchmarkActorPool: 对象池复用次数不符合预期"));
+			++NumErrors;
+		}
+
+		// 测试Actor在每次归还时广播一次，复用时广播一次；对象池关闭时Actor直接销毁，不广播
+		if (ActorClass->IsChildOf<AYcEquipmentActorPoolBenchmarkActor>()
+			&& (Unpooled.NumReturnedEvents != 0 || Pooled.NumAcquiredEvents != Pooled.NumReused || Pooled.NumReturnedEvents != NumCycles))
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.BenchmarkActorPool: 对象池复用/归还事件次数不符合预期 (复用 %d/%lld, 归还 %d/%d)"),
+				Pooled.NumAcquiredEvents, Pooled.NumReused, Pooled.NumReturnedEvents, NumCycles);
+			++NumErrors;
+		}
+
+		PoolSubsystem->ClearPool();
+		Pawn->Destroy();
+
+		UE_LOG(LogYcEquipment, Display, TEXT("Yc.Equipment.BenchmarkActorPool: %s (%d 次装备/卸下循环, Actor类 %s, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumCycles, *ActorClass->GetName(), NumErrors);
+		LogResult(TEXT("关闭对象池"), Unpooled);
+		LogResult(TEXT("开启对象池"), Pooled);
+	}
+};
+
+namespace YcEquipmentActorPoolBenchmark
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+		TEXT("Yc.Equipment.BenchmarkActorPool"),
+		TEXT("装备Actor反复生成/销毁与对象池复用的分配和耗时尖峰对比：Yc.Equipment.BenchmarkActorPool [循环次数=10000] [Actor类路径=带装备Actor组件的测试Actor]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcEquipmentActorPoolBenchmark::Run));
+}
+
+#endif // #if !UE_BUILD_SHIPPING
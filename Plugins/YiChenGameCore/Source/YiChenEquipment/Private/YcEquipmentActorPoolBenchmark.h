@@ -0,0 +1,42 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "YcEquipmentActorPoolBenchmark.generated.h"
+
+class UYcEquipmentActorComponent;
+class UYcEquipmentInstance;
+
+/**
+ * 对象池压力测试用的装备Actor
+ * 带有装备Actor组件并默认关闭碰撞，统计对象池复用/归还事件，用于核对对象池的重置与恢复
+ */
+UCLASS(Transient, NotBlueprintable)
+class AYcEquipmentActorPoolBenchmarkActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AYcEquipmentActorPoolBenchmarkActor();
+
+	virtual void PostInitializeComponents() override;
+
+	UYcEquipmentActorComponent* GetEquipmentActorComponent() const { return EquipmentActorComponent; }
+
+	/** 从对象池复用的次数 */
+	int32 NumAcquiredFromPool = 0;
+
+	/** 归还到对象池的次数 */
+	int32 NumReturnedToPool = 0;
+
+private:
+	UFUNCTION()
+	void HandleAcquiredFromPool(UYcEquipmentInstance* EquipmentInst);
+
+	UFUNCTION()
+	void HandleReturnedToPool(UYcEquipmentInstance* EquipmentInst);
+
+	UPROPERTY()
+	TObjectPtr<UYcEquipmentActorComponent> EquipmentActorComponent;
+};
@@ -0,0 +1,244 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcEquipmentActorPoolSubsystem.h"
+
+#include "YcEquipmentActorComponent.h"
+#include "YcEquipmentInstance.h"
+#include "YiChenEquipment.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcEquipmentActorPoolSubsystem)
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Equipment Actors"), STAT_YcEquipment_PooledActors, STATGROUP_YcEquipment);
+DECLARE_CYCLE_STAT(TEXT("Deferred Equipment Actor Spawn"), STAT_YcEquipment_DeferredSpawn, STATGROUP_YcEquipment);
+
+namespace YcEquipmentActorPoolCVars
+{
+	static int32 ActorPoolSize = 4;
+	static FAutoConsoleVariableRef CVarActorPoolSize(
+		TEXT("Yc.Equipment.ActorPoolSize"),
+		ActorPoolSize,
+		TEXT("每个装备Actor类最多保留的空闲Actor数量，0 表示关闭对象池，装备Actor销毁时直接销毁"),
+		ECVF_Default);
+
+	static float DeferredSpawnBudgetMs = 1.0f;
+	static FAutoConsoleVariableRef CVarDeferredSpawnBudgetMs(
+		TEXT("Yc.Equipment.DeferredSpawnBudgetMs"),
+		DeferredSpawnBudgetMs,
+		TEXT("未装备的装备实例分帧生成Actor时每帧的时间预算（毫秒），<=0 表示不分帧，创建装备实例时立即生成"),
+		ECVF_Default);
+}
+
+bool UYcEquipmentActorPoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// 只在游戏世界中创建
+	if (const UWorld* World = Cast<UWorld>(Outer))
+	{
+		return World->IsGameWorld();
+	}
+	return false;
+}
+
+void UYcEquipmentActorPoolSubsystem::Deinitialize()
+{
+	DeferredSpawnQueue.Empty();
+	ClearPool();
+
+	Super::Deinitialize();
+}
+
+void UYcEquipmentActorPoolSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (DeferredSpawnQueue.Num() > 0)
+	{
+		ProcessDeferredSpawns(YcEquipmentActorPoolCVars::DeferredSpawnBudgetMs * 0.001);
+	}
+}
+
+TStatId UYcEquipmentActorPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UYcEquipmentActorPoolSubsystem, STATGROUP_Tickables);
+}
+
+UYcEquipmentActorPoolSubsystem* UYcEquipmentActorPoolSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UYcEquipmentActorPoolSubsystem>() : nullptr;
+}
+
+bool UYcEquipmentActorPoolSubsystem::IsPoolingEnabled()
+{
+	return YcEquipmentActorPoolCVars::ActorPoolSize > 0;
+}
+
+bool UYcEquipmentActorPoolSubsystem::IsDeferredSpawnEnabled()
+{
+	return YcEquipmentActorPoolCVars::DeferredSpawnBudgetMs > 0.0f;
+}
+
+// ==================== 获取/归还 ====================
+
+AActor* UYcEquipmentActorPoolSubsystem::AcquireActor(const TSubclassOf<AActor> ActorClass, APawn* OwningPawn, bool& bOutReused)
+{
+	bOutReused = false;
+	if (!ActorClass)
+	{
+		return nullptr;
+	}
+
+	if (FYcEquipmentActorPool* Pool = Pools.Find(ActorClass.Get()))
+	{
+		while (Pool->FreeActors.Num() > 0)
+		{
+			AActor* Actor = Pool->FreeActors.Pop(EAllowShrinking::No);
+			DEC_DWORD_STAT(STAT_YcEquipment_PooledActors);
+			if (!IsValid(Actor))
+			{
+				continue;
+			}
+
+			// 恢复为刚生成时的状态，显示/休眠由装备实例按配置处理
+			if (Actor->GetIsReplicated())
+			{
+				Actor->SetNetDormancy(DORM_Awake);
+			}
+			Actor->SetOwner(OwningPawn);
+			Actor->SetInstigator(OwningPawn);
+			Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+			Actor->SetActorEnableCollision(Actor->GetClass()->GetDefaultObject<AActor>()->GetActorEnableCollision());
+
+			++Stats.NumReused;
+			bOutReused = true;
+			return Actor;
+		}
+	}
+
+	UWorld* World = GetWorld();
+	AActor* NewActor = World ? World->SpawnActorDeferred<AActor>(ActorClass, FTransform::Identity, OwningPawn) : nullptr;
+	if (!NewActor)
+	{
+		return nullptr;
+	}
+	NewActor->FinishSpawning(FTransform::Identity, true);
+
+	++Stats.NumSpawned;
+	return NewActor;
+}
+
+void UYcEquipmentActorPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	FYcEquipmentActorPool& Pool = Pools.FindOrAdd(Actor->GetClass());
+	if (Pool.FreeActors.Num() >= YcEquipmentActorPoolCVars::ActorPoolSize)
+	{
+		Actor->Destroy();
+		++Stats.NumDestroyed;
+		return;
+	}
+
+	// 先让Actor重置自身状态，再清除装备相关的数据
+	if (UYcEquipmentActorComponent* EquipComp = Actor->FindComponentByClass<UYcEquipmentActorComponent>())
+	{
+		EquipComp->ResetForPool();
+	}
+
+	Actor->DetachFromActor(FDetachmentTransformRules::KeepRelativeTransform);
+	UYcEquipmentInstance::SetActorVisualVisibility(Actor, false);
+	Actor->SetActorTickEnabled(false);
+	Actor->SetActorEnableCollision(false);
+	Actor->Tags = Actor->GetClass()->GetDefaultObject<AActor>()->Tags;
+	Actor->SetOwner(nullptr);
+	Actor->SetInstigator(nullptr);
+
+	if (Actor->GetIsReplicated())
+	{
+		// 清空的 EquipmentInst 需要先同步出去，客户端据此隐藏Actor，之后再进入休眠
+		Actor->ForceNetUpdate();
+		Actor->SetNetDormancy(DORM_DormantAll);
+	}
+
+	Pool.FreeActors.Add(Actor);
+	INC_DWORD_STAT(STAT_YcEquipment_PooledActors);
+	++Stats.NumReleased;
+}
+
+// ==================== 分帧生成 ====================
+
+void UYcEquipmentActorPoolSubsystem::QueueDeferredSpawn(UYcEquipmentInstance* Instance)
+{
+	if (Instance)
+	{
+		DeferredSpawnQueue.AddUnique(Instance);
+	}
+}
+
+int32 UYcEquipmentActorPoolSubsystem::ProcessDeferredSpawns(const double BudgetSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_YcEquipment_DeferredSpawn);
+
+	const double DeadlineSeconds = BudgetSeconds > 0.0 ? FPlatformTime::Seconds() + BudgetSeconds : 0.0;
+	int32 NumProcessed = 0;
+	int32 QueueIndex = 0;
+
+	// 每次至少生成一个，预算只决定是否继续
+	while (QueueIndex < DeferredSpawnQueue.Num())
+	{
+		UYcEquipmentInstance* Instance = DeferredSpawnQueue[QueueIndex].Get();
+		if (!Instance || !Instance->HasPendingActorSpawns())
+		{
+			// 实例已销毁、已被装备时补齐或已取消
+			++QueueIndex;
+			continue;
+		}
+
+		++NumProcessed;
+		if (!Instance->SpawnNextPendingActor_Internal())
+		{
+			++QueueIndex;
+		}
+
+		if (DeadlineSeconds > 0.0 && FPlatformTime::Seconds() >= DeadlineSeconds)
+		{
+			break;
+		}
+	}
+
+	DeferredSpawnQueue.RemoveAt(0, QueueIndex, EAllowShrinking::No);
+	return NumProcessed;
+}
+
+// ==================== 统计/清理 ====================
+
+FYcEquipmentActorPoolStats UYcEquipmentActorPoolSubsystem::GetPoolStats() const
+{
+	FYcEquipmentActorPoolStats Result = Stats;
+	for (const TPair<TObjectPtr<UClass>, FYcEquipmentActorPool>& Pair : Pools)
+	{
+		Result.NumPooled += Pair.Value.FreeActors.Num();
+	}
+	Result.NumPendingInstances = DeferredSpawnQueue.Num();
+	return Result;
+}
+
+void UYcEquipmentActorPoolSubsystem::ClearPool()
+{
+	for (TPair<TObjectPtr<UClass>, FYcEquipmentActorPool>& Pair : Pools)
+	{
+		for (AActor* Actor : Pair.Value.FreeActors)
+		{
+			if (IsValid(Actor))
+			{
+				Actor->Destroy();
+			}
+			DEC_DWORD_STAT(STAT_YcEquipment_PooledActors);
+		}
+	}
+	Pools.Empty();
+}
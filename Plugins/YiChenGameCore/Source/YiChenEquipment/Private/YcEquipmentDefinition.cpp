@@ -2,4 +2,17 @@
 
 #include "YcEquipmentDefinition.h"
 
-#include UE_INLINE_GENERATED_CPP_BY_NAME(YcEquipmentDefinition)
\ No newline at end of file
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcEquipmentDefinition)
+
+void FYcEquipmentDefinition::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		FragmentIndex.Build(Fragments);
+	}
+}
+
+void FYcEquipmentDefinition::OnDataTableChanged(const UDataTable* InDataTable, const FName InRowName)
+{
+	FragmentIndex.Reset();
+}
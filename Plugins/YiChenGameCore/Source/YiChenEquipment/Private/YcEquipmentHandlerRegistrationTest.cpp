@@ -0,0 +1,89 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcEquipmentSlotComponent.h"
+#include "YcInventoryOperationRouterComponent.h"
+#include "YiChenEquipment.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * 装备栏处理器注册流程校验（控制台命令，需在服务端/单机世界中执行）
+ *
+ * 组件不再通过 Tick 轮询 Router：未被控制时只记为等待状态，Pawn 被控制的那一刻注册处理器，
+ * 失去控制时从旧 Router 反注册并重新进入等待。全过程组件都不应注册 Tick。
+ */
+struct FYcEquipmentHandlerRegistrationTest
+{
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.TestHandlerRegistration: 需要在服务端或单机世界中执行"));
+			return;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		APawn* Pawn = World->SpawnActor<APawn>(SpawnParams);
+		APlayerController* Controller = World->SpawnActor<APlayerController>(SpawnParams);
+		if (!Pawn || !Controller)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.TestHandlerRegistration: 无法生成测试Actor"));
+			return;
+		}
+
+		UYcEquipmentSlotComponent* SlotComponent = NewObject<UYcEquipmentSlotComponent>(Pawn, TEXT("TestEquipmentSlot"));
+		SlotComponent->RegisterComponent();
+
+		int32 NumErrors = 0;
+		auto Check = [&NumErrors](const bool bCondition, const TCHAR* What)
+		{
+			if (!bCondition)
+			{
+				UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.TestHandlerRegistration: %s"), What);
+				++NumErrors;
+			}
+		};
+		auto CheckNotTicking = [&Check, SlotComponent](const TCHAR* Stage)
+		{
+			Check(!SlotComponent->PrimaryComponentTick.IsTickFunctionRegistered() && !SlotComponent->IsComponentTickEnabled(),
+				*FString::Printf(TEXT("%s: 组件不应注册或启用 Tick"), Stage));
+		};
+
+		// 未被控制：等待中，没有 Router
+		Check(SlotComponent->HasBegunPlay(), TEXT("组件未执行 BeginPlay"));
+		Check(!SlotComponent->bOperationHandlersRegistered && SlotComponent->bWaitingForRouter, TEXT("未被控制时应处于等待状态"));
+		CheckNotTicking(TEXT("等待期间"));
+
+		// 被控制：立即注册
+		Controller->Possess(Pawn);
+		Check(SlotComponent->bOperationHandlersRegistered && !SlotComponent->bWaitingForRouter, TEXT("被控制后应立即注册处理器"));
+		Check(UYcInventoryOperationRouterComponent::FindRouter(Pawn) != nullptr, TEXT("被控制后应能找到 Router"));
+		CheckNotTicking(TEXT("注册之后"));
+
+		// 失去控制：从旧 Router 反注册并回到等待；再次控制后重新注册
+		Controller->UnPossess();
+		Check(!SlotComponent->bOperationHandlersRegistered && SlotComponent->bWaitingForRouter, TEXT("失去控制后应回到等待状态"));
+		Controller->Possess(Pawn);
+		Check(SlotComponent->bOperationHandlersRegistered && !SlotComponent->bWaitingForRouter, TEXT("再次控制后应重新注册处理器"));
+		CheckNotTicking(TEXT("重新注册之后"));
+
+		Pawn->Destroy();
+		Check(!SlotComponent->bWaitingForRouter, TEXT("EndPlay 后不应再计入等待数量"));
+		Controller->Destroy();
+
+		UE_LOG(LogYcEquipment, Display, TEXT("Yc.Equipment.TestHandlerRegistration: %s (错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumErrors);
+	}
+};
+
+namespace YcEquipmentHandlerRegistrationTest
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdTest(
+		TEXT("Yc.Equipment.TestHandlerRegistration"),
+		TEXT("校验装备栏组件不依赖 Tick、在 Pawn 被控制时注册操作处理器：Yc.Equipment.TestHandlerRegistration"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcEquipmentHandlerRegistrationTest::Run));
+}
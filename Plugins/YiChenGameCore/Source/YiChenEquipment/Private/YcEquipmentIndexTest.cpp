@@ -0,0 +1,362 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcEquipmentManagerComponent.h"
+#include "YcGameplayTags.h"
+#include "YcInventoryItemInstance.h"
+#include "YiChenEquipment.h"
+#include "Engine/World.h"
+#include "Fragments/InventoryFragment_Equippable.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * 装备条目索引自检（控制台命令，需在服务端/单机世界中执行）
+ *
+ * 1. 权威端：通过装备管理组件创建、装备、销毁装备，每一步后对比索引查询与线性遍历的结果
+ * 2. 客户端：用独立的 FYcEquipmentList 按引擎 FastArray 的回调顺序模拟复制
+ *    （PreReplicatedRemove -> PostReplicatedAdd -> PostReplicatedChange -> RemoveAtSwap -> PostReplicatedReceive），
+ *    条目顺序与服务器不同，且部分条目的实例/物品引用晚于条目到达
+ *
+ * 通过各类型的测试接口注入物品定义、模拟复制，不依赖DataRegistry中的数据。
+ * 槽位标签借用已注册的原生标签，只作为索引键使用。
+ */
+struct FYcEquipmentIndexTest
+{
+	/** 改造前的 FindEntry：线性比较装备实例，SkippedIndices 为等待移除的条目 */
+	static int32 LinearFindByInstance(const FYcEquipmentList& List, const UYcEquipmentInstance* Instance, TArrayView<const int32> SkippedIndices = {})
+	{
+		const TArray<FYcEquipmentEntry>& Entries = List.GetEntries();
+		for (int32 i = 0; i < Entries.Num(); ++i)
+		{
+			if (Instance && Entries[i].GetInstance() == Instance && !SkippedIndices.Contains(i))
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/** 改造前的 FindEquipmentByItem：线性比较所属物品 */
+	static int32 LinearFindByItem(const FYcEquipmentList& List, const UYcInventoryItemInstance* ItemInstance, TArrayView<const int32> SkippedIndices = {})
+	{
+		const TArray<FYcEquipmentEntry>& Entries = List.GetEntries();
+		for (int32 i = 0; i < Entries.Num(); ++i)
+		{
+			if (ItemInstance && Entries[i].GetOwnerItemInstance() == ItemInstance && !SkippedIndices.Contains(i))
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/** 按槽位线性查找：优先已装备的条目，否则取第一个 */
+	static int32 LinearFindBySlot(const FYcEquipmentList& List, const FGameplayTag& SlotTag, TArrayView<const int32> SkippedIndices = {})
+	{
+		const TArray<FYcEquipmentEntry>& Entries = List.GetEntries();
+		int32 FirstIndex = INDEX_NONE;
+		for (int32 i = 0; i < Entries.Num(); ++i)
+		{
+			UYcEquipmentInstance* Instance = Entries[i].GetInstance();
+			const FYcEquipmentDefinition* EquipDef = Instance ? Instance->GetEquipmentDef() : nullptr;
+			if (!EquipDef || EquipDef->EquipmentSlot != SlotTag || SkippedIndices.Contains(i))
+			{
+				continue;
+			}
+			if (Instance->IsEquipped())
+			{
+				return i;
+			}
+			if (FirstIndex == INDEX_NONE)
+			{
+				FirstIndex = i;
+			}
+		}
+		return FirstIndex;
+	}
+
+	struct FFixture
+	{
+		TArray<FYcInventoryItemDefinition> Definitions;
+		TArray<FGameplayTag> SlotTags;
+		TArray<UYcInventoryItemInstance*> Items;
+		TArray<UYcEquipmentInstance*> Instances;
+		int32 NumErrors = 0;
+
+		/** 对比索引与线性查找；SkippedIndices 为已通知 PreReplicatedRemove、尚未真正移除的条目，不应再被查到 */
+		void Verify(const FYcEquipmentList& List, const TCHAR* Stage, TArrayView<const int32> SkippedIndices = {})
+		{
+			const int32 ErrorsBefore = NumErrors;
+			for (const UYcEquipmentInstance* Instance : Instances)
+			{
+				if (List.FindEntryIndex(Instance) != LinearFindByInstance(List, Instance, SkippedIndices))
+				{
+					++NumErrors;
+				}
+			}
+			for (const UYcInventoryItemInstance* Item : Items)
+			{
+				if (List.FindEntryIndexByItem(Item) != LinearFindByItem(List, Item, SkippedIndices))
+				{
+					++NumErrors;
+				}
+			}
+			for (const FGameplayTag& SlotTag : SlotTags)
+			{
+				if (List.FindEntryIndexBySlot(SlotTag) != LinearFindBySlot(List, SlotTag, SkippedIndices))
+				{
+					++NumErrors;
+				}
+			}
+			if (NumErrors != ErrorsBefore)
+			{
+				UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.IndexTest: %s: 索引与线性查找结果不一致 (%d 处)"), Stage, NumErrors - ErrorsBefore);
+			}
+		}
+	};
+
+	/**
+	 * 模拟一次 FastArray 接收，与引擎顺序一致：
+	 * 先读入整个数据包（追加新条目、补上已解析的引用），再依次调用
+	 * PreReplicatedRemove -> PostReplicatedAdd -> PostReplicatedChange，之后才 RemoveAtSwap，最后 PostReplicatedReceive
+	 */
+	static void ReceivePacket(FYcEquipmentList& ClientList, TArray<int32> RemovedIndices, const TArray<FYcEquipmentEntry>& NewEntries,
+		const TArray<const FYcEquipmentEntry*>& ResolvedEntries, FFixture& Fixture)
+	{
+		TArray<FYcEquipmentEntry>& ClientEntries = ClientList.GetEntriesForTesting();
+		RemovedIndices.Sort();
+
+		TArray<int32> AddedIndices;
+		for (const FYcEquipmentEntry& NewEntry : NewEntries)
+		{
+			AddedIndices.Add(ClientEntries.Add(NewEntry));
+		}
+		const int32 FinalSize = ClientEntries.Num() - RemovedIndices.Num();
+
+		// 引用解析完成：补上之前缺失的实例/物品指针
+		TArray<int32> ChangedIndices;
+		for (const FYcEquipmentEntry* Resolved : ResolvedEntries)
+		{
+			for (int32 i = 0; i < ClientEntries.Num(); ++i)
+			{
+				FYcEquipmentEntry& Entry = ClientEntries[i];
+				if ((Entry.GetInstance() && Entry.GetInstance() == Resolved->GetInstance())
+					|| (Entry.GetOwnerItemInstance() && Entry.GetOwnerItemInstance() == Resolved->GetOwnerItemInstance()))
+				{
+					Entry.SetReferencesForTesting(Resolved->GetInstance(), Resolved->GetOwnerItemInstance());
+					ChangedIndices.Add(i);
+					break;
+				}
+			}
+		}
+
+		if (RemovedIndices.Num() > 0)
+		{
+			ClientList.PreReplicatedRemove(RemovedIndices, FinalSize);
+		}
+		if (AddedIndices.Num() > 0)
+		{
+			ClientList.PostReplicatedAdd(AddedIndices, FinalSize);
+			Fixture.Verify(ClientList, TEXT("PostReplicatedAdd 之后"), RemovedIndices);
+		}
+		if (ChangedIndices.Num() > 0)
+		{
+			ClientList.PostReplicatedChange(ChangedIndices, FinalSize);
+			Fixture.Verify(ClientList, TEXT("PostReplicatedChange 之后"), RemovedIndices);
+		}
+
+		for (int32 i = RemovedIndices.Num() - 1; i >= 0; --i)
+		{
+			ClientEntries.RemoveAtSwap(RemovedIndices[i], EAllowShrinking::No);
+		}
+
+		ClientList.PostReplicatedReceive(FFastArraySerializer::FPostReplicatedReceiveParameters{});
+		Fixture.Verify(ClientList, TEXT("PostReplicatedReceive 之后"));
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.IndexTest: 需要在服务端或单机世界中执行"));
+			return;
+		}
+
+		const int32 NumItems = Args.Num() > 0 ? FMath::Max(4, FCString::Atoi(*Args[0])) : 16;
+		const int32 NumRounds = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 200;
+		const int32 Seed = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1337;
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		APawn* Pawn = World->SpawnActor<APawn>(SpawnParams);
+		if (!Pawn)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.IndexTest: 无法生成测试Actor"));
+			return;
+		}
+		UYcEquipmentManagerComponent* Manager = NewObject<UYcEquipmentManagerComponent>(Pawn, TEXT("TestEquipmentManager"));
+		Manager->RegisterComponent();
+
+		FFixture Fixture;
+		Fixture.SlotTags = { YcGameplayTags::InputTag_Move, YcGameplayTags::InputTag_Look_Mouse, YcGameplayTags::Ability_Behavior_SurvivesDeath };
+
+		// 先分配好定义数组，物品实例保存的是定义指针
+		Fixture.Definitions.SetNum(Fixture.SlotTags.Num());
+		for (int32 i = 0; i < Fixture.SlotTags.Num(); ++i)
+		{
+			FInventoryFragment_Equippable Equippable;
+			Equippable.EquipmentDef.EquipmentSlot = Fixture.SlotTags[i];
+			Fixture.Definitions[i].Fragments.Add(TInstancedStruct<FYcInventoryItemFragment>::Make<FInventoryFragment_Equippable>(Equippable));
+		}
+
+		// ---------------- 权威端 ----------------
+		const FYcEquipmentList& ServerList = Manager->GetEquipmentList();
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			UYcInventoryItemInstance* Item = NewObject<UYcInventoryItemInstance>(Pawn);
+			Item->SetItemDefForTesting(&Fixture.Definitions[i % Fixture.Definitions.Num()]);
+			Fixture.Items.Add(Item);
+			Fixture.Instances.Add(Manager->CreateEquipment(Item));
+		}
+		Fixture.Verify(ServerList, TEXT("创建装备之后"));
+
+		if (Manager->CreateEquipment(Fixture.Items[0]) != Fixture.Instances[0] || ServerList.GetEntries().Num() != NumItems)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.IndexTest: 重复创建应返回已有的装备实例"));
+			++Fixture.NumErrors;
+		}
+
+		// 每个槽位中装备排在后面的一件，槽位查询应优先返回已装备的实例
+		for (int32 i = NumItems - 1; i >= NumItems - Fixture.SlotTags.Num() && i >= 0; --i)
+		{
+			Manager->EquipItem(Fixture.Instances[i]);
+		}
+		Fixture.Verify(ServerList, TEXT("装备之后"));
+
+		// 从中间销毁，后续条目前移
+		Manager->DestroyEquipment(Fixture.Instances[1]);
+		Manager->DestroyEquipment(Fixture.Instances[NumItems / 2]);
+		Fixture.Verify(ServerList, TEXT("销毁装备之后"));
+
+		for (const int32 RecreateIndex : { 1, NumItems / 2 })
+		{
+			Fixture.Instances[RecreateIndex] = Manager->CreateEquipment(Fixture.Items[RecreateIndex]);
+		}
+		Fixture.Verify(ServerList, TEXT("重新创建之后"));
+
+		// ---------------- 客户端复制模拟 ----------------
+		FYcEquipmentList ClientList;
+		FRandomStream Random(Seed);
+
+		/** 服务器上的条目，客户端随机接收/移除 */
+		const TArray<FYcEquipmentEntry> ServerEntries = ServerList.GetEntries();
+		TArray<bool> bOnClient;
+		bOnClient.Init(false, ServerEntries.Num());
+
+		/** 引用尚未解析的条目（服务器条目下标） */
+		TArray<int32> Unresolved;
+
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			// 移除：只移除未装备的条目，避免触发装备实例的卸下流程
+			TArray<int32> RemovedIndices;
+			const int32 NumRemoves = Random.RandRange(0, 2);
+			const TArray<FYcEquipmentEntry>& ClientEntries = ClientList.GetEntries();
+			for (int32 r = 0; r < NumRemoves && ClientEntries.Num() > 0; ++r)
+			{
+				const int32 Index = Random.RandRange(0, ClientEntries.Num() - 1);
+				const FYcEquipmentEntry& Entry = ClientEntries[Index];
+				if (RemovedIndices.Contains(Index) || !Entry.GetInstance() || !Entry.GetOwnerItemInstance() || Entry.GetInstance()->IsEquipped())
+				{
+					continue;
+				}
+				RemovedIndices.Add(Index);
+				bOnClient[LinearFindByInstance(ServerList, Entry.GetInstance())] = false;
+			}
+
+			// 新增：部分条目的实例或物品引用尚未解析
+			TArray<FYcEquipmentEntry> NewEntries;
+			const int32 NumAdds = Random.RandRange(0, 3);
+			for (int32 a = 0; a < NumAdds; ++a)
+			{
+				const int32 ServerIndex = Random.RandRange(0, ServerEntries.Num() - 1);
+				if (bOnClient[ServerIndex])
+				{
+					continue;
+				}
+				bOnClient[ServerIndex] = true;
+
+				FYcEquipmentEntry& NewEntry = NewEntries.Add_GetRef(ServerEntries[ServerIndex]);
+				const int32 Unmapped = Random.RandRange(0, 3);
+				if (Unmapped == 0)
+				{
+					NewEntry.SetReferencesForTesting(nullptr, NewEntry.GetOwnerItemInstance());
+					Unresolved.Add(ServerIndex);
+				}
+				else if (Unmapped == 1)
+				{
+					NewEntry.SetReferencesForTesting(NewEntry.GetInstance(), nullptr);
+					Unresolved.Add(ServerIndex);
+				}
+			}
+
+			// 之前未解析的引用在本次到达（本次新增的条目留到下一轮）
+			TArray<const FYcEquipmentEntry*> ResolvedEntries;
+			for (int32 u = Unresolved.Num() - 1; u >= 0; --u)
+			{
+				const bool bAddedThisRound = NewEntries.ContainsByPredicate([&](const FYcEquipmentEntry& Entry)
+				{
+					return Entry.GetInstance() == ServerEntries[Unresolved[u]].GetInstance()
+						|| Entry.GetOwnerItemInstance() == ServerEntries[Unresolved[u]].GetOwnerItemInstance();
+				});
+				if (!bAddedThisRound && Random.RandRange(0, 1) == 0)
+				{
+					ResolvedEntries.Add(&ServerEntries[Unresolved[u]]);
+					Unresolved.RemoveAtSwap(u);
+				}
+			}
+
+			ReceivePacket(ClientList, RemovedIndices, NewEntries, ResolvedEntries, Fixture);
+
+			// 被移除的条目不再等待解析
+			Unresolved.RemoveAll([&](const int32 ServerIndex) { return !bOnClient[ServerIndex]; });
+		}
+
+		// 性能对比：按物品查找
+		uint64 Sink = 0;
+		const int32 NumLookups = 100000;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumLookups; ++i)
+		{
+			Sink += LinearFindByItem(ServerList, Fixture.Items[i % NumItems]);
+		}
+		const double LinearSeconds = FPlatformTime::Seconds() - StartTime;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumLookups; ++i)
+		{
+			Sink += ServerList.FindEntryIndexByItem(Fixture.Items[i % NumItems]);
+		}
+		const double IndexedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		Pawn->Destroy();
+
+		UE_LOG(LogYcEquipment, Display, TEXT("Yc.Equipment.IndexTest: %s (装备 %d 件, 复制模拟 %d 轮, 种子 %d, 错误 %d, 校验值 %llu)"),
+			Fixture.NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumItems, NumRounds, Seed, Fixture.NumErrors, Sink);
+		UE_LOG(LogYcEquipment, Display, TEXT("  按物品查找: 线性 %.1f ns / 索引 %.1f ns"),
+			LinearSeconds * 1e9 / NumLookups, IndexedSeconds * 1e9 / NumLookups);
+	}
+};
+
+namespace YcEquipmentIndexTest
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdTest(
+		TEXT("Yc.Equipment.IndexTest"),
+		TEXT("校验装备条目索引在权威端增删与客户端复制乱序下与线性查找一致：Yc.Equipment.IndexTest [装备数量=16] [复制轮数=200] [随机种子=1337]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcEquipmentIndexTest::Run));
+}
+
+#endif // #if !UE_BUILD_SHIPPING
@@ -3,6 +3,7 @@
 #include "YcEquipmentInstance.h"
 
 #include "YcEquipmentActorComponent.h"
+#include "YcEquipmentActorPoolSubsystem.h"
 #include "YcInventoryItemInstance.h"
 #include "YiChenEquipment.h"
 #include "Fragments/InventoryFragment_Equippable.h"
@@ -92,21 +93,18 @@ bool UYcEquipmentInstance::K2_GetEquipmentDef(FYcEquipmentDefinition& OutEquipme
 }
 
 TInstancedStruct<FYcEquipmentFragment> UYcEquipmentInstance::FindEquipmentFragment(const UScriptStruct* FragmentStructType)
+{
+	const TInstancedStruct<FYcEquipmentFragment>* Fragment = FindEquipmentFragmentPtr(FragmentStructType);
+	return Fragment ? *Fragment : TInstancedStruct<FYcEquipmentFragment>();
+}
+
+const TInstancedStruct<FYcEquipmentFragment>* UYcEquipmentInstance::FindEquipmentFragmentPtr(const UScriptStruct* FragmentStructType)
 {
 	if (!GetEquipmentDef() || !FragmentStructType)
 	{
-		return TInstancedStruct<FYcEquipmentFragment>();
-	}
-	
-	for (const auto& Fragment : EquipmentDef->Fragments)
-	{
-		if (Fragment.GetScriptStruct() == FragmentStructType)
-		{
-			return Fragment;
-		}
+		return nullptr;
 	}
-	
-	return TInstancedStruct<FYcEquipmentFragment>();
+	return EquipmentDef->FindFragment(FragmentStructType);
 }
 
 void UYcEquipmentInstance::OnEquipmentInstanceCreated(const FYcEquipmentDefinition& Definition)
@@ -165,6 +163,9 @@ void UYcEquipmentInstance::OnEquipped()
 {
 	UE_LOG(LogYcEquipment, Verbose, TEXT("OnEquipped: %s (AutoShow=%d)"), *GetNameSafe(this), bAutoShowEquipmentActors);
 	
+	// 装备后Fragment和蓝图都可能访问Actors，分帧生成尚未完成时先补齐
+	FlushPendingActorSpawns();
+	
 	// 遍历所有 Fragment 并调用 OnEquipped
 	if (const FYcEquipmentDefinition* EquipDef = GetEquipmentDef())
 	{
@@ -231,12 +232,9 @@ void UYcEquipmentInstance::BroadcastUnequippedEvent()
 
 void UYcEquipmentInstance::SpawnEquipmentActors(const TArray<FYcEquipmentActorToSpawn>& ActorsToSpawn)
 {
-	APawn* OwningPawn = GetPawn();
+	const APawn* OwningPawn = GetPawn();
 	if (!OwningPawn || OwningPawn->GetLocalRole() == ROLE_SimulatedProxy) return;
 	
-	const bool bIsServer = OwningPawn->HasAuthority();
-	const bool bIsLocallyControlled = OwningPawn->IsLocallyControlled();
-	
 	// 如果已经生成过Actors，不重复生成
 	if (bActorsSpawned)
 	{
@@ -244,50 +242,73 @@ void UYcEquipmentInstance::SpawnEquipmentActors(const TArray<FYcEquipmentActorTo
 		return;
 	}
 	
-	// 获取默认的附加组件
-	USceneComponent* AttachTarget = OwningPawn->GetRootComponent();	
-	if (const ACharacter* Char = Cast<ACharacter>(OwningPawn))	
+	PendingActorsToSpawn = ActorsToSpawn;
+	NextPendingActorIndex = 0;
+	bActorsSpawned = true;
+	
+	// 未装备时Actor本就隐藏，交给对象池子系统分帧生成
+	UYcEquipmentActorPoolSubsystem* PoolSubsystem = UYcEquipmentActorPoolSubsystem::Get(GetWorld());
+	if (PoolSubsystem && !IsEquipped() && UYcEquipmentActorPoolSubsystem::IsDeferredSpawnEnabled() && HasPendingActorSpawns())
 	{
-		AttachTarget = Char->GetMesh();
+		PoolSubsystem->QueueDeferredSpawn(this);
+		UE_LOG(LogYcEquipment, Verbose, TEXT("SpawnEquipmentActors: Queued %d actors for deferred spawn"), PendingActorsToSpawn.Num());
+		return;
 	}
+	
+	FlushPendingActorSpawns();
+}
 
-	for (const FYcEquipmentActorToSpawn& SpawnInfo : ActorsToSpawn)
+void UYcEquipmentInstance::FlushPendingActorSpawns()
+{
+	while (HasPendingActorSpawns() && SpawnNextPendingActor_Internal())
 	{
-		// 计算附加目标
-		USceneComponent* SpecifiedAttachTarget = OwningPawn->FindComponentByTag<USceneComponent>(SpawnInfo.ParentComponentTag);
-		USceneComponent* FinalAttachTarget = SpecifiedAttachTarget ? SpecifiedAttachTarget : AttachTarget;
-    
-		if (SpawnInfo.ActorToSpawn.IsNull()) continue;
-    
-		// 确定生成条件
-		bool bShouldSpawn = false;
-		TArray<TObjectPtr<AActor>>* TargetArray = nullptr;
-    
-		if (SpawnInfo.bReplicateActor && bIsServer)
-		{
-			bShouldSpawn = true;
-			TargetArray = &SpawnedActors;
-		}
-		else if (!SpawnInfo.bReplicateActor && bIsLocallyControlled)
+	}
+}
+
+bool UYcEquipmentInstance::SpawnNextPendingActor_Internal()
+{
+	APawn* OwningPawn = GetPawn();
+	if (!OwningPawn || !HasPendingActorSpawns())
+	{
+		PendingActorsToSpawn.Reset();
+		NextPendingActorIndex = 0;
+		return false;
+	}
+	
+	const FYcEquipmentActorToSpawn& SpawnInfo = PendingActorsToSpawn[NextPendingActorIndex++];
+	const bool bIsServer = OwningPawn->HasAuthority();
+	const bool bIsLocallyControlled = OwningPawn->IsLocallyControlled();
+	
+	// 确定生成条件
+	TArray<TObjectPtr<AActor>>* TargetArray = nullptr;
+	if (SpawnInfo.bReplicateActor && bIsServer)
+	{
+		TargetArray = &SpawnedActors;
+	}
+	else if (!SpawnInfo.bReplicateActor && bIsLocallyControlled)
+	{
+		TargetArray = &OwnerClientSpawnedActors;
+	}
+	
+	if (TargetArray && !SpawnInfo.ActorToSpawn.IsNull())
+	{
+		// 计算附加目标：默认附加到角色Mesh（非Character则为根组件）
+		USceneComponent* AttachTarget = OwningPawn->FindComponentByTag<USceneComponent>(SpawnInfo.ParentComponentTag);
+		if (!AttachTarget)
 		{
-			bShouldSpawn = true;
-			TargetArray = &OwnerClientSpawnedActors;
+			const ACharacter* Char = Cast<ACharacter>(OwningPawn);
+			AttachTarget = Char ? Char->GetMesh() : OwningPawn->GetRootComponent();
 		}
-    
-		if (!bShouldSpawn) continue;
-    
+		
 		// 加载Actor类
 		const TSubclassOf<AActor> ActorToSpawnClass = SpawnInfo.ActorToSpawn.LoadSynchronous();
 		if (!ActorToSpawnClass)
 		{
 			UE_LOG(LogYcEquipment, Error, TEXT("SpawnEquipmentActors: Failed to load actor class %s"), 
 				*SpawnInfo.ActorToSpawn.ToString());
-			continue;
 		}
-    
 		// 生成Actor
-		AActor* NewActor = SpawnEquipActorInternal(ActorToSpawnClass, SpawnInfo, FinalAttachTarget);
-		if (NewActor)
+		else if (AActor* NewActor = SpawnEquipActorInternal(ActorToSpawnClass, SpawnInfo, AttachTarget))
 		{
 			TargetArray->Add(NewActor);
 			
@@ -302,22 +323,26 @@ void UYcEquipmentInstance::SpawnEquipmentActors(const TArray<FYcEquipmentActorTo
 		}
 	}
 	
-	bActorsSpawned = true;
+	if (HasPendingActorSpawns())
+	{
+		return true;
+	}
+	
+	PendingActorsToSpawn.Reset();
+	NextPendingActorIndex = 0;
 	UE_LOG(LogYcEquipment, Verbose, TEXT("SpawnEquipmentActors: Spawned %d replicated actors, %d local actors"), 
 		SpawnedActors.Num(), OwnerClientSpawnedActors.Num());
+	return false;
 }
 
 void UYcEquipmentInstance::DestroyEquipmentActors()
 {
+	// 尚未分帧生成的Actor不再生成
+	PendingActorsToSpawn.Reset();
+	NextPendingActorIndex = 0;
+	
 	// 销毁服务器复制的Actors
-	for (AActor* Actor : SpawnedActors)
-	{
-		if (IsValid(Actor))
-		{
-			Actor->Destroy();
-		}
-	}
-	SpawnedActors.Empty();
+	ReleaseEquipmentActors_Internal(SpawnedActors);
 	
 	// 通知客户端销毁本地Actors
 	ClientDestroyLocalActors();
@@ -327,18 +352,32 @@ void UYcEquipmentInstance::DestroyEquipmentActors()
 
 void UYcEquipmentInstance::ClientDestroyLocalActors_Implementation()
 {
-	for (AActor* Actor : OwnerClientSpawnedActors)
+	ReleaseEquipmentActors_Internal(OwnerClientSpawnedActors);
+}
+
+void UYcEquipmentInstance::ReleaseEquipmentActors_Internal(TArray<TObjectPtr<AActor>>& Actors)
+{
+	UYcEquipmentActorPoolSubsystem* PoolSubsystem = UYcEquipmentActorPoolSubsystem::Get(GetWorld());
+	for (AActor* Actor : Actors)
 	{
-		if (IsValid(Actor))
+		if (!IsValid(Actor)) continue;
+		
+		if (PoolSubsystem)
+		{
+			PoolSubsystem->ReleaseActor(Actor);
+		}
+		else
 		{
 			Actor->Destroy();
 		}
 	}
-	OwnerClientSpawnedActors.Empty();
+	Actors.Empty();
 }
 
 AActor* UYcEquipmentInstance::FindSpawnedActorByTag(const FName Tag, const bool bReplicateActor)
 {
+	FlushPendingActorSpawns();
+	
 	const TArray<TObjectPtr<AActor>>& TargetArray = bReplicateActor ? SpawnedActors : OwnerClientSpawnedActors;
 	
 	for (AActor* Actor : TargetArray)
@@ -363,6 +402,9 @@ AActor* UYcEquipmentInstance::FindSpawnedActorByTag(const FName Tag, const bool
 
 void UYcEquipmentInstance::ShowEquipmentActors()
 {
+	// 分帧生成尚未完成时先补齐
+	FlushPendingActorSpawns();
+	
 	// 显示服务器复制的Actors
 	ShowReplicatedActors();
 	
@@ -552,7 +594,8 @@ void UYcEquipmentInstance::WakeActorFromDormant(AActor* Actor, bool bReplicated)
 	}
 	
 	Actor->SetActorTickEnabled(true);
-	Actor->SetActorEnableCollision(true);
+	// 恢复类默认的碰撞设置，默认关闭碰撞的Actor唤醒后仍保持关闭
+	Actor->SetActorEnableCollision(Actor->GetClass()->GetDefaultObject<AActor>()->GetActorEnableCollision());
 }
 
 void UYcEquipmentInstance::SetActorVisualVisibility(const AActor* Actor, const bool bVisible)
@@ -574,14 +617,24 @@ AActor* UYcEquipmentInstance::SpawnEquipActorInternal(
 	const FYcEquipmentActorToSpawn& SpawnInfo, 
 	USceneComponent* AttachTarget)
 {
-	AActor* NewActor = GetWorld()->SpawnActorDeferred<AActor>(ActorToSpawnClass, FTransform::Identity, GetPawn());
+	// 优先从对象池中复用
+	bool bReused = false;
+	AActor* NewActor = nullptr;
+	if (UYcEquipmentActorPoolSubsystem* PoolSubsystem = UYcEquipmentActorPoolSubsystem::Get(GetWorld()))
+	{
+		NewActor = PoolSubsystem->AcquireActor(ActorToSpawnClass, GetPawn(), bReused);
+	}
+	else if ((NewActor = GetWorld()->SpawnActorDeferred<AActor>(ActorToSpawnClass, FTransform::Identity, GetPawn())))
+	{
+		NewActor->FinishSpawning(FTransform::Identity, true);
+	}
+	
 	if (!NewActor)
 	{
 		UE_LOG(LogYcEquipment, Error, TEXT("SpawnEquipActorInternal: Failed to spawn actor"));
 		return nullptr;
 	}
 	
-	NewActor->FinishSpawning(FTransform::Identity, true);
 	NewActor->SetActorRelativeTransform(SpawnInfo.AttachTransform);
 	NewActor->AttachToComponent(AttachTarget, FAttachmentTransformRules::KeepRelativeTransform, SpawnInfo.AttachSocket);
 	NewActor->Tags.Append(SpawnInfo.ActorTags);
@@ -594,6 +647,11 @@ AActor* UYcEquipmentInstance::SpawnEquipActorInternal(
 		EquipComp->EquipmentInst = this;
 		EquipComp->EquipmentTags = SpawnInfo.ActorTags;
 		EquipComp->OnRep_EquipmentInst();
+		
+		if (bReused)
+		{
+			EquipComp->NotifyAcquiredFromPool();
+		}
 	}
 	else
 	{
@@ -22,15 +22,8 @@ UYcEquipmentInstance* UYcEquipmentLibrary::GetCurrentEquipmentInst(AActor* Owner
 TInstancedStruct<FYcEquipmentFragment> UYcEquipmentLibrary::FindEquipmentFragment(
 	const FYcEquipmentDefinition& EquipmentDef, const UScriptStruct* FragmentStructType)
 {
-	TInstancedStruct<FYcEquipmentFragment> NullStruct;
-	for (auto& Frag : EquipmentDef.Fragments)
-	{	
-		if (FragmentStructType == Frag.GetScriptStruct())
-		{
-			return Frag;
-		}
-	}
-	return NullStruct;
+	const TInstancedStruct<FYcEquipmentFragment>* Fragment = EquipmentDef.FindFragment(FragmentStructType);
+	return Fragment ? *Fragment : TInstancedStruct<FYcEquipmentFragment>();
 }
 
 void UYcEquipmentLibrary::GetEquipmentFragment(EYcEquipmentFragmentResult& ExecResult, const UYcEquipmentInstance* Equipment, const UScriptStruct* FragmentStructType, int32& OutFragment)
@@ -73,12 +66,12 @@ DEFINE_FUNCTION(UYcEquipmentLibrary::execGetEquipmentFragment)
 	else
 	{
 		P_NATIVE_BEGIN;
-		TInstancedStruct<FYcEquipmentFragment> TempFragment = Equipment->FindEquipmentFragment(FragmentStructType);
-		if (TempFragment.IsValid() && 
-			TempFragment.GetScriptStruct()->IsChildOf(OutFragmentProp->Struct))
+		const TInstancedStruct<FYcEquipmentFragment>* Fragment = Equipment->FindEquipmentFragmentPtr(FragmentStructType);
+		if (Fragment && Fragment->IsValid() && 
+			Fragment->GetScriptStruct()->IsChildOf(OutFragmentProp->Struct))
 		{
-			// 直接将 Fragment 的内存复制到输出参数
-			OutFragmentProp->Struct->CopyScriptStruct(OutFragmentPtr, TempFragment.GetMemory());
+			// 直接将定义中 Fragment 的内存复制到输出参数
+			OutFragmentProp->Struct->CopyScriptStruct(OutFragmentPtr, Fragment->GetMemory());
 			ExecResult = EYcEquipmentFragmentResult::Valid;
 		}
 		else
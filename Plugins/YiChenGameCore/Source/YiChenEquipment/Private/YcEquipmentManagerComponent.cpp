@@ -8,6 +8,7 @@
 #include "YcEquipmentInstance.h"
 #include "YcInventoryItemInstance.h"
 #include "YiChenEquipment.h"
+#include "Algo/BinarySearch.h"
 #include "Net/UnrealNetwork.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcEquipmentManagerComponent)
@@ -43,11 +44,22 @@ void FYcEquipmentList::PreReplicatedRemove(const TArrayView<int32> RemovedIndice
 			
 			UE_LOG(LogYcEquipment, Log, TEXT("PreReplicatedRemove: %s"), *Entry.GetDebugString());
 		}
+		UnindexEntry_Internal(Index);
 	}
+	
+	// FastArray 在 Add/Change 回调之后才以 RemoveAtSwap 移除条目，数组位置在 PostReplicatedReceive 中修正
+	bEntryPositionsDirty = true;
 }
 
 void FYcEquipmentList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
+	// 先登记所有新条目，下面的回调中查询装备时索引已完整
+	// 此时待移除的条目还没有被 RemoveAtSwap，新条目的下标仍然有效
+	for (const int32 Index : AddedIndices)
+	{
+		IndexEntry_Internal(Index);
+	}
+	
 	for (const int32 Index : AddedIndices)
 	{
 		FYcEquipmentEntry& Entry = Entries[Index];
@@ -79,32 +91,189 @@ void FYcEquipmentList::PostReplicatedChange(const TArrayView<int32> ChangedIndic
 			Entry.Instance->SetInstigator(Entry.OwnerItemInstance);
 			UE_LOG(LogYcEquipment, Verbose, TEXT("PostReplicatedChange: %s"), *Entry.GetDebugString());
 		}
+		
+		// 实例或物品引用可能刚解析完成，重新登记（下标在移除之前仍然有效）
+		IndexEntry_Internal(Index);
+	}
+}
+
+void FYcEquipmentList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	// 移除已经完成，其余条目的位置可能被 RemoveAtSwap 改变
+	if (bEntryPositionsDirty)
+	{
+		RebuildIndex_Internal();
 	}
 }
 
 // ============================================================================
-// FYcEquipmentList - 装备管理
+// FYcEquipmentList - 条目索引
 // ============================================================================
 
-UYcAbilitySystemComponent* FYcEquipmentList::GetAbilitySystemComponent() const
+int32 FYcEquipmentList::FindEntryIndex(const UYcEquipmentInstance* Instance) const
 {
-	check(OwnerComponent);
-	const AActor* OwningActor = OwnerComponent->GetOwner();
-	return Cast<UYcAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(OwningActor));
+	if (!Instance) return INDEX_NONE;
+	
+	EnsureIndex_Internal();
+	const int32* EntryIndex = InstanceToEntry.Find(FObjectKey(Instance));
+	return EntryIndex ? *EntryIndex : INDEX_NONE;
+}
+
+int32 FYcEquipmentList::FindEntryIndexByItem(const UYcInventoryItemInstance* ItemInstance) const
+{
+	if (!ItemInstance) return INDEX_NONE;
+	
+	EnsureIndex_Internal();
+	const int32* EntryIndex = ItemToEntry.Find(FObjectKey(ItemInstance));
+	return EntryIndex ? *EntryIndex : INDEX_NONE;
 }
 
-FYcEquipmentEntry* FYcEquipmentList::FindEntry(UYcEquipmentInstance* Instance)
+int32 FYcEquipmentList::FindEntryIndexBySlot(const FGameplayTag& SlotTag) const
 {
-	for (FYcEquipmentEntry& Entry : Entries)
+	if (!SlotTag.IsValid()) return INDEX_NONE;
+	
+	EnsureIndex_Internal();
+	const TArray<int32, TInlineAllocator<2>>* SlotEntries = SlotToEntries.Find(SlotTag);
+	if (!SlotEntries)
 	{
-		if (Entry.Instance == Instance)
+		return INDEX_NONE;
+	}
+	
+	for (const int32 EntryIndex : *SlotEntries)
+	{
+		const UYcEquipmentInstance* Instance = Entries[EntryIndex].Instance;
+		if (Instance && Instance->IsEquipped())
 		{
-			return &Entry;
+			return EntryIndex;
 		}
 	}
-	return nullptr;
+	return (*SlotEntries)[0];
 }
 
+void FYcEquipmentList::IndexEntry_Internal(const int32 EntryIndex) const
+{
+	if (!Entries.IsValidIndex(EntryIndex)) return;
+	
+	if (IndexedKeys.Num() < Entries.Num())
+	{
+		IndexedKeys.SetNum(Entries.Num());
+	}
+	UnindexEntry_Internal(EntryIndex);
+	
+	const FYcEquipmentEntry& Entry = Entries[EntryIndex];
+	FIndexedKeys& Keys = IndexedKeys[EntryIndex];
+	
+	// 客户端上实例的定义依赖Instigator（所属物品），物品定义未就绪时槽位暂时为空
+	const FYcEquipmentDefinition* EquipDef = Entry.Instance ? Entry.Instance->GetEquipmentDef() : nullptr;
+	Keys.bPending = !Entry.Instance || !Entry.OwnerItemInstance || !EquipDef;
+	if (Keys.bPending)
+	{
+		PendingEntries.Add(EntryIndex);
+	}
+	
+	if (Entry.Instance)
+	{
+		Keys.Instance = FObjectKey(Entry.Instance);
+		InstanceToEntry.Add(Keys.Instance, EntryIndex);
+	}
+	if (Entry.OwnerItemInstance)
+	{
+		Keys.Item = FObjectKey(Entry.OwnerItemInstance);
+		ItemToEntry.Add(Keys.Item, EntryIndex);
+	}
+	if (EquipDef && EquipDef->EquipmentSlot.IsValid())
+	{
+		Keys.Slot = EquipDef->EquipmentSlot;
+		TArray<int32, TInlineAllocator<2>>& SlotEntries = SlotToEntries.FindOrAdd(Keys.Slot);
+		SlotEntries.Insert(EntryIndex, Algo::LowerBound(SlotEntries, EntryIndex));
+	}
+}
+
+void FYcEquipmentList::UnindexEntry_Internal(const int32 EntryIndex) const
+{
+	if (!IndexedKeys.IsValidIndex(EntryIndex)) return;
+	
+	FIndexedKeys& Keys = IndexedKeys[EntryIndex];
+	if (Keys.Instance != FObjectKey())
+	{
+		if (const int32* Found = InstanceToEntry.Find(Keys.Instance); Found && *Found == EntryIndex)
+		{
+			InstanceToEntry.Remove(Keys.Instance);
+		}
+	}
+	if (Keys.Item != FObjectKey())
+	{
+		if (const int32* Found = ItemToEntry.Find(Keys.Item); Found && *Found == EntryIndex)
+		{
+			ItemToEntry.Remove(Keys.Item);
+		}
+	}
+	if (Keys.Slot.IsValid())
+	{
+		if (TArray<int32, TInlineAllocator<2>>* SlotEntries = SlotToEntries.Find(Keys.Slot))
+		{
+			SlotEntries->Remove(EntryIndex);
+			if (SlotEntries->IsEmpty())
+			{
+				SlotToEntries.Remove(Keys.Slot);
+			}
+		}
+	}
+	if (Keys.bPending)
+	{
+		PendingEntries.RemoveSwap(EntryIndex, EAllowShrinking::No);
+	}
+	Keys = FIndexedKeys();
+}
+
+void FYcEquipmentList::RebuildIndex_Internal() const
+{
+	IndexedKeys.Reset();
+	IndexedKeys.SetNum(Entries.Num());
+	InstanceToEntry.Reset();
+	ItemToEntry.Reset();
+	SlotToEntries.Reset();
+	PendingEntries.Reset();
+	
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		IndexEntry_Internal(EntryIndex);
+	}
+	bEntryPositionsDirty = false;
+}
+
+void FYcEquipmentList::EnsureIndex_Internal() const
+{
+	// 客户端在 PreReplicatedRemove 与实际移除之间位置仍然有效，只在数量不一致时重建
+	if (IndexedKeys.Num() != Entries.Num())
+	{
+		RebuildIndex_Internal();
+		return;
+	}
+	
+	// 只重试尚未解析完整的条目；重新登记会修改 PendingEntries，先取出
+	if (PendingEntries.Num() > 0)
+	{
+		const TArray<int32, TInlineAllocator<8>> EntriesToRetry(PendingEntries);
+		for (const int32 EntryIndex : EntriesToRetry)
+		{
+			IndexEntry_Internal(EntryIndex);
+		}
+	}
+}
+
+// ============================================================================
+// FYcEquipmentList - 装备管理
+// ============================================================================
+
+UYcAbilitySystemComponent* FYcEquipmentList::GetAbilitySystemComponent() const
+{
+	check(OwnerComponent);
+	const AActor* OwningActor = OwnerComponent->GetOwner();
+	return Cast<UYcAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(OwningActor));
+}
+
+
 UYcEquipmentInstance* FYcEquipmentList::CreateEntry(const FYcEquipmentDefinition& EquipmentDef, UYcInventoryItemInstance* ItemInstance)
 {
 	check(OwnerComponent);
@@ -117,14 +286,12 @@ UYcEquipmentInstance* FYcEquipmentList::CreateEntry(const FYcEquipmentDefinition
 	}
 	
 	// 检查是否已存在该物品的装备实例
-	for (const FYcEquipmentEntry& Entry : Entries)
+	const int32 ExistingIndex = FindEntryIndexByItem(ItemInstance);
+	if (ExistingIndex != INDEX_NONE)
 	{
-		if (Entry.OwnerItemInstance == ItemInstance)
-		{
-			UE_LOG(LogYcEquipment, Warning, TEXT("CreateEntry: Equipment already exists for item '%s'"), 
-				*ItemInstance->GetItemRegistryId().ToString());
-			return Entry.Instance;
-		}
+		UE_LOG(LogYcEquipment, Warning, TEXT("CreateEntry: Equipment already exists for item '%s'"), 
+			*ItemInstance->GetItemRegistryId().ToString());
+		return Entries[ExistingIndex].Instance;
 	}
 	
 	// 确定实例类型
@@ -148,6 +315,7 @@ UYcEquipmentInstance* FYcEquipmentList::CreateEntry(const FYcEquipmentDefinition
 	
 	// 标记网络同步
 	MarkItemDirty(NewEntry);
+	IndexEntry_Internal(Entries.Num() - 1);
 	
 	UE_LOG(LogYcEquipment, Log, TEXT("CreateEntry: Created equipment '%s' for item '%s'"), 
 		*GetNameSafe(NewEntry.Instance), *ItemInstance->GetItemRegistryId().ToString());
@@ -160,12 +328,13 @@ void FYcEquipmentList::EquipEntry(UYcEquipmentInstance* Instance)
 	check(OwnerComponent);
 	check(OwnerComponent->GetOwner()->HasAuthority());
 	
-	FYcEquipmentEntry* Entry = FindEntry(Instance);
-	if (!Entry)
+	const int32 EntryIndex = FindEntryIndex(Instance);
+	if (EntryIndex == INDEX_NONE)
 	{
 		UE_LOG(LogYcEquipment, Error, TEXT("EquipEntry: Equipment instance not found"));
 		return;
 	}
+	FYcEquipmentEntry& Entry = Entries[EntryIndex];
 	
 	if (Instance->IsEquipped())
 	{
@@ -182,7 +351,7 @@ void FYcEquipmentList::EquipEntry(UYcEquipmentInstance* Instance)
 			{
 				if (AbilitySet)
 				{
-					AbilitySet->GiveToAbilitySystem(ASC, &Entry->GrantedHandles, Instance);
+					AbilitySet->GiveToAbilitySystem(ASC, &Entry.GrantedHandles, Instance);
 				}
 			}
 		}
@@ -200,12 +369,13 @@ void FYcEquipmentList::UnequipEntry(UYcEquipmentInstance* Instance)
 	check(OwnerComponent);
 	check(OwnerComponent->GetOwner()->HasAuthority());
 	
-	FYcEquipmentEntry* Entry = FindEntry(Instance);
-	if (!Entry)
+	const int32 EntryIndex = FindEntryIndex(Instance);
+	if (EntryIndex == INDEX_NONE)
 	{
 		UE_LOG(LogYcEquipment, Error, TEXT("UnequipEntry: Equipment instance not found"));
 		return;
 	}
+	FYcEquipmentEntry& Entry = Entries[EntryIndex];
 	
 	if (!Instance->IsEquipped())
 	{
@@ -216,7 +386,7 @@ void FYcEquipmentList::UnequipEntry(UYcEquipmentInstance* Instance)
 	// 移除技能
 	if (UYcAbilitySystemComponent* ASC = GetAbilitySystemComponent())
 	{
-		Entry->GrantedHandles.RemoveFromAbilitySystem(ASC);
+		Entry.GrantedHandles.RemoveFromAbilitySystem(ASC);
 	}
 	
 	// 设置状态为未装备（会触发 OnRep 和 OnUnequipped）
@@ -231,34 +401,34 @@ void FYcEquipmentList::DestroyEntry(UYcEquipmentInstance* Instance)
 	check(OwnerComponent);
 	check(OwnerComponent->GetOwner()->HasAuthority());
 	
-	for (auto It = Entries.CreateIterator(); It; ++It)
+	const int32 EntryIndex = FindEntryIndex(Instance);
+	if (EntryIndex == INDEX_NONE)
 	{
-		FYcEquipmentEntry& Entry = *It;
-		if (Entry.Instance == Instance)
+		UE_LOG(LogYcEquipment, Warning, TEXT("DestroyEntry: Equipment instance not found"));
+		return;
+	}
+	
+	FYcEquipmentEntry& Entry = Entries[EntryIndex];
+	
+	// 如果处于已装备状态，先卸下
+	if (Instance->IsEquipped())
+	{
+		if (UYcAbilitySystemComponent* ASC = GetAbilitySystemComponent())
 		{
-			// 如果处于已装备状态，先卸下
-			if (Instance->IsEquipped())
-			{
-				if (UYcAbilitySystemComponent* ASC = GetAbilitySystemComponent())
-				{
-					Entry.GrantedHandles.RemoveFromAbilitySystem(ASC);
-				}
-				Instance->SetEquipmentState(EYcEquipmentState::Unequipped);
-			}
-			
-			// 销毁Actors
-			Instance->DestroyEquipmentActors();
-			
-			// 从列表移除
-			It.RemoveCurrent();
-			MarkArrayDirty();
-			
-			UE_LOG(LogYcEquipment, Log, TEXT("DestroyEntry: Destroyed equipment %s"), *GetNameSafe(Instance));
-			return;
+			Entry.GrantedHandles.RemoveFromAbilitySystem(ASC);
 		}
+		Instance->SetEquipmentState(EYcEquipmentState::Unequipped);
 	}
 	
-	UE_LOG(LogYcEquipment, Warning, TEXT("DestroyEntry: Equipment instance not found"));
+	// 销毁Actors
+	Instance->DestroyEquipmentActors();
+	
+	// 从列表移除，后续条目前移，重建索引
+	Entries.RemoveAt(EntryIndex);
+	MarkArrayDirty();
+	RebuildIndex_Internal();
+	
+	UE_LOG(LogYcEquipment, Log, TEXT("DestroyEntry: Destroyed equipment %s"), *GetNameSafe(Instance));
 }
 
 // ============================================================================
@@ -527,16 +697,14 @@ UYcEquipmentManagerComponent* UYcEquipmentManagerComponent::FindEquipmentManager
 
 UYcEquipmentInstance* UYcEquipmentManagerComponent::FindEquipmentByItem(UYcInventoryItemInstance* ItemInstance) const
 {
-	if (!ItemInstance) return nullptr;
-	
-	for (const FYcEquipmentEntry& Entry : EquipmentList.Entries)
-	{
-		if (Entry.OwnerItemInstance == ItemInstance)
-		{
-			return Entry.Instance;
-		}
-	}
-	return nullptr;
+	const int32 EntryIndex = EquipmentList.FindEntryIndexByItem(ItemInstance);
+	return EntryIndex != INDEX_NONE ? EquipmentList.Entries[EntryIndex].Instance : nullptr;
+}
+
+UYcEquipmentInstance* UYcEquipmentManagerComponent::FindEquipmentBySlot(const FGameplayTag SlotTag) const
+{
+	const int32 EntryIndex = EquipmentList.FindEntryIndexBySlot(SlotTag);
+	return EntryIndex != INDEX_NONE ? EquipmentList.Entries[EntryIndex].Instance : nullptr;
 }
 
 UYcEquipmentInstance* UYcEquipmentManagerComponent::GetEquippedItem() const
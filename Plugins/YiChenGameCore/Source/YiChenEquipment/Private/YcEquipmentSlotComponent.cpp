@@ -20,7 +20,9 @@
 #include "YcInventoryManagerComponent.h"
 #include "YcInventoryOperationRouterComponent.h"
 #include "Fragments/InventoryFragment_Equippable.h"
+#include "GameFramework/Controller.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
+#include "GameFramework/Pawn.h"
 #include "Net/UnrealNetwork.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "NativeGameplayTags.h"
@@ -28,6 +30,8 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcEquipmentSlotComponent)
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Slot Components Waiting For Router"), STAT_YcEquipment_SlotWaitingForRouter, STATGROUP_YcEquipment);
+
 // ============================================================================
 // Gameplay Tags
 // ============================================================================
@@ -48,8 +52,7 @@ UYcEquipmentSlotComponent::UYcEquipmentSlotComponent(const FObjectInitializer& O
 	: Super(ObjectInitializer)
 {
 	SetIsReplicatedByDefault(true);
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 void UYcEquipmentSlotComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -68,30 +71,67 @@ void UYcEquipmentSlotComponent::BeginPlay()
 
 	if (GetOwner() && GetOwner()->HasAuthority())
 	{
+		// Pawn 尚未被控制时 Router 不存在，等待 Controller 变化通知再注册，不再每帧轮询
+		if (APawn* Pawn = GetPawn<APawn>())
+		{
+			Pawn->ReceiveControllerChangedDelegate.AddUniqueDynamic(this, &ThisClass::HandleControllerChanged);
+		}
 		RegisterInventoryOperationHandlers();
-		SetComponentTickEnabled(!bOperationHandlersRegistered);
+		SetWaitingForRouter(!bOperationHandlersRegistered);
 	}
 }
 
 void UYcEquipmentSlotComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	if (APawn* Pawn = GetPawn<APawn>())
+	{
+		Pawn->ReceiveControllerChangedDelegate.RemoveDynamic(this, &ThisClass::HandleControllerChanged);
+	}
 	UnregisterInventoryOperationHandlers();
+	SetWaitingForRouter(false);
 	Super::EndPlay(EndPlayReason);
 }
 
-void UYcEquipmentSlotComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UYcEquipmentSlotComponent::HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	if (!GetOwner() || !GetOwner()->HasAuthority() || bOperationHandlersRegistered)
+	if (!GetOwner() || !GetOwner()->HasAuthority())
 	{
 		return;
 	}
 
-	RegisterInventoryOperationHandlers();
+	// 处理器登记在旧 Controller 的 Router 上，此时 FindRouter 已解析到新 Controller，需直接从旧 Router 反注册
 	if (bOperationHandlersRegistered)
 	{
-		SetComponentTickEnabled(false);
+		if (UYcInventoryOperationRouterComponent* OldRouter = OldController ? OldController->FindComponentByClass<UYcInventoryOperationRouterComponent>() : nullptr)
+		{
+			OldRouter->UnregisterOperationHandler(OpType_Equipment_Equip);
+			OldRouter->UnregisterOperationHandler(OpType_Equipment_Unequip);
+		}
+		bOperationHandlersRegistered = false;
+	}
+
+	if (NewController)
+	{
+		RegisterInventoryOperationHandlers();
+	}
+	SetWaitingForRouter(!bOperationHandlersRegistered);
+}
+
+void UYcEquipmentSlotComponent::SetWaitingForRouter(const bool bWaiting)
+{
+	if (bWaitingForRouter == bWaiting)
+	{
+		return;
+	}
+
+	bWaitingForRouter = bWaiting;
+	if (bWaiting)
+	{
+		INC_DWORD_STAT(STAT_YcEquipment_SlotWaitingForRouter);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_YcEquipment_SlotWaitingForRouter);
 	}
 }
 
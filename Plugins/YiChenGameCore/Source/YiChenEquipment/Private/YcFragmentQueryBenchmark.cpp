@@ -0,0 +1,162 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcEquipmentDefinition.h"
+#include "YiChenEquipment.h"
+#include "Fragments/InventoryFragment_Equippable.h"
+#include "Fragments/InventoryFragment_InitialItemStats.h"
+#include "Fragments/InventoryFragment_ItemTags.h"
+#include "Fragments/ItemFragment_DataAsset.h"
+#include "Fragments/YcEquipmentFragment.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * Fragment 查询性能对比（控制台命令）
+ *
+ * 模拟武器与 UI 代码中的高频查询：
+ * - UI：按结构体类型查找物品 Fragment（FindItemFragment，蓝图/脚本接口按值返回）
+ * - 武器：在装备定义上 GetTypedFragment<T>() 以及 FindEquipmentFragment
+ * 旧路径为改造前的线性遍历（按值返回时附带一次拷贝），新路径走定义上的类型索引并直接返回指针。
+ */
+namespace YcFragmentQueryBenchmark
+{
+	/** 改造前的 FindItemFragment / FindEquipmentFragment：线性比较结构体类型并按值返回 */
+	template <typename BaseFragmentType>
+	TInstancedStruct<BaseFragmentType> LegacyFindByValue(const TArray<TInstancedStruct<BaseFragmentType>>& Fragments, const UScriptStruct* FragmentStructType)
+	{
+		for (const auto& Fragment : Fragments)
+		{
+			if (FragmentStructType == Fragment.GetScriptStruct())
+			{
+				return Fragment;
+			}
+		}
+		return TInstancedStruct<BaseFragmentType>();
+	}
+
+	/** 改造前的 GetTypedFragment<T>()：线性 GetPtr */
+	template <typename FragmentType, typename BaseFragmentType>
+	const FragmentType* LegacyGetTyped(const TArray<TInstancedStruct<BaseFragmentType>>& Fragments)
+	{
+		for (const auto& Fragment : Fragments)
+		{
+			if (const FragmentType* TypedFragment = Fragment.template GetPtr<FragmentType>())
+			{
+				return TypedFragment;
+			}
+		}
+		return nullptr;
+	}
+
+	/** 前面放若干个无关 Fragment，查询的目标位于数组末尾附近，接近配置较多的武器物品 */
+	void BuildDefinitions(FYcInventoryItemDefinition& ItemDef, const int32 NumFillerFragments)
+	{
+		for (int32 i = 0; i < NumFillerFragments; ++i)
+		{
+			ItemDef.Fragments.Add(TInstancedStruct<FYcInventoryItemFragment>::Make<FYcInventoryItemFragment>());
+		}
+		ItemDef.Fragments.Add(TInstancedStruct<FYcInventoryItemFragment>::Make<FInventoryFragment_ItemTags>());
+		ItemDef.Fragments.Add(TInstancedStruct<FYcInventoryItemFragment>::Make<FInventoryFragment_InitialItemStats>());
+		ItemDef.Fragments.Add(TInstancedStruct<FYcInventoryItemFragment>::Make<FItemFragment_DataAsset>());
+
+		FInventoryFragment_Equippable Equippable;
+		for (int32 i = 0; i < NumFillerFragments; ++i)
+		{
+			Equippable.EquipmentDef.Fragments.Add(TInstancedStruct<FYcEquipmentFragment>::Make<FYcEquipmentFragment>());
+		}
+		Equippable.EquipmentDef.Fragments.Add(TInstancedStruct<FYcEquipmentFragment>::Make<FEquipmentFragment_QuickBarSlot>());
+		ItemDef.Fragments.Add(TInstancedStruct<FYcInventoryItemFragment>::Make<FInventoryFragment_Equippable>(Equippable));
+	}
+
+	void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumIterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+		const int32 NumFillerFragments = Args.Num() > 1 ? FMath::Max(0, FCString::Atoi(*Args[1])) : 8;
+
+		FYcInventoryItemDefinition ItemDef;
+		BuildDefinitions(ItemDef, NumFillerFragments);
+		const FInventoryFragment_Equippable* Equippable = ItemDef.GetTypedFragment<FInventoryFragment_Equippable>();
+		if (!Equippable)
+		{
+			UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.BenchmarkFragmentQuery: 无法构建测试物品定义"));
+			return;
+		}
+		const FYcEquipmentDefinition& EquipmentDef = Equippable->EquipmentDef;
+
+		const UScriptStruct* EquippableStruct = FInventoryFragment_Equippable::StaticStruct();
+		const UScriptStruct* DataAssetStruct = FItemFragment_DataAsset::StaticStruct();
+		const UScriptStruct* QuickBarSlotStruct = FEquipmentFragment_QuickBarSlot::StaticStruct();
+
+		// 正确性：索引查找与线性查找的结果必须指向同一个 Fragment
+		int32 NumErrors = 0;
+		auto Check = [&NumErrors](const bool bCondition, const TCHAR* What)
+		{
+			if (!bCondition)
+			{
+				UE_LOG(LogYcEquipment, Error, TEXT("Yc.Equipment.BenchmarkFragmentQuery: %s 与线性查找结果不一致"), What);
+				++NumErrors;
+			}
+		};
+		Check(ItemDef.FindFragment(EquippableStruct) == &ItemDef.Fragments.Last(), TEXT("FindFragment(Equippable)"));
+		Check(ItemDef.GetTypedFragment<FItemFragment_DataAsset>() == LegacyGetTyped<FItemFragment_DataAsset>(ItemDef.Fragments), TEXT("GetTypedFragment<DataAsset>"));
+		Check(ItemDef.GetTypedFragment<FYcInventoryItemFragment>() == LegacyGetTyped<FYcInventoryItemFragment>(ItemDef.Fragments), TEXT("GetTypedFragment<Base>"));
+		Check(ItemDef.FindFragment(FEquipmentFragment_QuickBarSlot::StaticStruct()) == nullptr, TEXT("FindFragment(类型不匹配)"));
+		Check(EquipmentDef.GetTypedFragment<FEquipmentFragment_QuickBarSlot>() == LegacyGetTyped<FEquipmentFragment_QuickBarSlot>(EquipmentDef.Fragments), TEXT("GetTypedFragment<QuickBarSlot>"));
+		Check(EquipmentDef.FindFragment(QuickBarSlotStruct) == &EquipmentDef.Fragments.Last(), TEXT("FindFragment(QuickBarSlot)"));
+
+		// 拷贝出的定义沿用同一份索引，下标依然有效
+		const FYcInventoryItemDefinition CopiedDef = ItemDef;
+		Check(CopiedDef.FindFragment(DataAssetStruct) == &CopiedDef.Fragments[NumFillerFragments + 2], TEXT("拷贝后的 FindFragment(DataAsset)"));
+
+		// 结果累加进校验值，避免查询被优化掉
+		uint64 Sink = 0;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			const TInstancedStruct<FYcInventoryItemFragment> EquippableCopy = LegacyFindByValue(ItemDef.Fragments, EquippableStruct);
+			const TInstancedStruct<FYcInventoryItemFragment> DataAssetCopy = LegacyFindByValue(ItemDef.Fragments, DataAssetStruct);
+			const TInstancedStruct<FYcEquipmentFragment> QuickBarCopy = LegacyFindByValue(EquipmentDef.Fragments, QuickBarSlotStruct);
+			Sink += EquippableCopy.IsValid() + DataAssetCopy.IsValid() + QuickBarCopy.IsValid();
+		}
+		const double LegacyByValueSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			Sink += (ItemDef.FindFragment(EquippableStruct) != nullptr) + (ItemDef.FindFragment(DataAssetStruct) != nullptr)
+				+ (EquipmentDef.FindFragment(QuickBarSlotStruct) != nullptr);
+		}
+		const double IndexedPtrSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			Sink += reinterpret_cast<UPTRINT>(LegacyGetTyped<FInventoryFragment_Equippable>(ItemDef.Fragments));
+			Sink += reinterpret_cast<UPTRINT>(LegacyGetTyped<FEquipmentFragment_QuickBarSlot>(EquipmentDef.Fragments));
+		}
+		const double LegacyTypedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			Sink += reinterpret_cast<UPTRINT>(ItemDef.GetTypedFragment<FInventoryFragment_Equippable>());
+			Sink += reinterpret_cast<UPTRINT>(EquipmentDef.GetTypedFragment<FEquipmentFragment_QuickBarSlot>());
+		}
+		const double IndexedTypedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const double QueriesPerLoop = 3.0 * NumIterations;
+		UE_LOG(LogYcEquipment, Display, TEXT("Yc.Equipment.BenchmarkFragmentQuery: %s (迭代 %d 次, 每个定义 %d 个无关Fragment, 错误 %d, 校验值 %llu)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumIterations, NumFillerFragments, NumErrors, Sink);
+		UE_LOG(LogYcEquipment, Display, TEXT("  按类型查找: 线性+拷贝 %.1f ns / 索引+指针 %.1f ns (%.1fx)"),
+			LegacyByValueSeconds * 1e9 / QueriesPerLoop, IndexedPtrSeconds * 1e9 / QueriesPerLoop,
+			IndexedPtrSeconds > 0.0 ? LegacyByValueSeconds / IndexedPtrSeconds : 0.0);
+		UE_LOG(LogYcEquipment, Display, TEXT("  GetTypedFragment: 线性 %.1f ns / 索引 %.1f ns (%.1fx)"),
+			LegacyTypedSeconds * 1e9 / (2.0 * NumIterations), IndexedTypedSeconds * 1e9 / (2.0 * NumIterations),
+			IndexedTypedSeconds > 0.0 ? LegacyTypedSeconds / IndexedTypedSeconds : 0.0);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+		TEXT("Yc.Equipment.BenchmarkFragmentQuery"),
+		TEXT("物品/装备定义 Fragment 查询的线性遍历与类型索引性能对比：Yc.Equipment.BenchmarkFragmentQuery [迭代次数=100000] [无关Fragment数量=8]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBenchmark));
+}
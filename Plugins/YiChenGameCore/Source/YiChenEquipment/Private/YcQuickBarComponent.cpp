@@ -54,8 +54,7 @@ UYcQuickBarComponent::UYcQuickBarComponent(const FObjectInitializer& ObjectIniti
 	: Super(ObjectInitializer)
 {
 	SetIsReplicatedByDefault(true);
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 void UYcQuickBarComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -84,10 +83,14 @@ void UYcQuickBarComponent::BeginPlay()
 
 	Super::BeginPlay();
 
+	// QuickBar 挂在 Controller 上，Router 也挂在同一个 Controller 上，BeginPlay 时一定能拿到，无需轮询
 	if (GetOwner() && GetOwner()->HasAuthority())
 	{
 		RegisterInventoryOperationHandlers();
-		SetComponentTickEnabled(!bOperationHandlersRegistered);
+		if (!bOperationHandlersRegistered)
+		{
+			UE_LOG(LogYcEquipment, Warning, TEXT("UYcQuickBarComponent: 无法在 %s 上找到或创建 Router，QuickBar 操作处理器未注册"), *GetNameSafe(GetOwner()));
+		}
 	}
 }
 
@@ -97,22 +100,6 @@ void UYcQuickBarComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 }
 
-void UYcQuickBarComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	if (!GetOwner() || !GetOwner()->HasAuthority() || bOperationHandlersRegistered)
-	{
-		return;
-	}
-
-	RegisterInventoryOperationHandlers();
-	if (bOperationHandlersRegistered)
-	{
-		SetComponentTickEnabled(false);
-	}
-}
-
 void UYcQuickBarComponent::RegisterInventoryOperationHandlers()
 {
 	if (bOperationHandlersRegistered)
@@ -13,6 +13,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEquipmentInstRep, UYcEquipmentInsta
 /** 装备状态变化委托 */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEquipmentStateChangedDelegate, UYcEquipmentInstance*, EquipmentInst);
 
+/** 装备Actor对象池复用/归还委托 */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEquipmentActorPoolDelegate, UYcEquipmentInstance*, EquipmentInst);
+
 /**
  * 装备Actor组件
  * 所有由装备实例生成的Actor都需要添加这个组件，用于：
@@ -20,10 +23,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEquipmentStateChangedDelegate, UYcE
  * - 存储装备配置的 Tags（解决 AActor::Tags 不复制的问题）
  * - 处理装备附加Actor在客户端同步生成后判断
  * - 响应装备/卸下事件，让 Actor 子类和蓝图能处理装备状态变化
+ * - 响应对象池复用/归还事件，让 Actor 子类和蓝图重置自身状态（见 UYcEquipmentActorPoolSubsystem）
  * 
  * 网络同步：
  * - 组件本身通过 SetIsReplicated(true) 复制到客户端
- * - EquipmentTags 使用 COND_InitialOnly 只在初始化时同步一次
+ * - EquipmentInst / EquipmentTags 在Actor被对象池复用时会变化，因此不再使用 COND_InitialOnly
  */
 UCLASS(meta=(BlueprintSpawnableComponent))
 class YICHENEQUIPMENT_API UYcEquipmentActorComponent : public UActorComponent
@@ -73,12 +77,27 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Equipment")
 	FEquipmentStateChangedDelegate OnUnequipped;
 	
+	/** 
+	 * 从对象池复用事件（仅在生成端：服务器/本地Actor的控制客户端）
+	 * 在新的装备实例完成设置后广播，参数为新的装备实例
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Equipment|Pool")
+	FEquipmentActorPoolDelegate OnAcquiredFromPool;
+	
+	/** 
+	 * 归还到对象池事件（仅在生成端：服务器/本地Actor的控制客户端）
+	 * 在清除装备数据之前广播，参数为旧的装备实例，Actor 应在此重置自身的运行时状态（弹药、特效、动画等）
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Equipment|Pool")
+	FEquipmentActorPoolDelegate OnReturnedToPool;
+	
 protected:
 	UFUNCTION()
 	void OnRep_EquipmentInst();
 
 private:
 	friend class UYcEquipmentInstance;
+	friend class UYcEquipmentActorPoolSubsystem;
 	
 	/** 
 	 * 通知装备状态变化（由 UYcEquipmentInstance 调用）
@@ -86,9 +105,15 @@ private:
 	 */
 	void NotifyEquipmentStateChanged(bool bEquipped) const;
 	
+	/** 通知已从对象池复用（由 UYcEquipmentInstance 在设置完新的装备实例后调用） */
+	void NotifyAcquiredFromPool() const;
+	
+	/** 广播归还事件并清除装备数据（由 UYcEquipmentActorPoolSubsystem 调用） */
+	void ResetForPool();
+	
 	/** 
 	 * 所属的装备实例
-	 * 使用 COND_InitialOnly 只在初始化时同步一次
+	 * 对象池复用时会指向新的装备实例，归还时置空
 	 * 特别说明: 实际上通过FYcEquipmentList::PostReplicatedAdd里设置也可以, 这样就无需额外的网络复制, 但是会增加代码复杂度综合权衡下来没有必要
 	 */
 	UPROPERTY(ReplicatedUsing=OnRep_EquipmentInst, VisibleInstanceOnly)
@@ -97,7 +122,7 @@ private:
 	/** 
 	 * 装备配置的 Tags
 	 * 由于 AActor::Tags 不会网络复制，这里单独存储并复制
-	 * 使用 COND_InitialOnly 只在初始化时同步一次（Tags 不会动态修改）
+	 * 同一装备实例内不会动态修改，仅在对象池复用时随装备实例一起变化
 	 */
 	UPROPERTY(Replicated, VisibleInstanceOnly)
 	TArray<FName> EquipmentTags;
@@ -0,0 +1,143 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "YcEquipmentActorPoolSubsystem.generated.h"
+
+class UYcEquipmentInstance;
+
+/**
+ * 同一Actor类的空闲装备Actor
+ */
+USTRUCT()
+struct FYcEquipmentActorPool
+{
+	GENERATED_BODY()
+
+	/** 已重置、等待复用的Actor */
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> FreeActors;
+};
+
+/**
+ * 装备Actor对象池统计信息
+ */
+USTRUCT(BlueprintType)
+struct YICHENEQUIPMENT_API FYcEquipmentActorPoolStats
+{
+	GENERATED_BODY()
+
+	/** 新生成的Actor数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int64 NumSpawned = 0;
+
+	/** 从池中复用的次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int64 NumReused = 0;
+
+	/** 归还到池中的次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int64 NumReleased = 0;
+
+	/** 池已满或对象池关闭时直接销毁的数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int64 NumDestroyed = 0;
+
+	/** 当前池中的空闲Actor数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 NumPooled = 0;
+
+	/** 等待分帧生成Actor的装备实例数量 */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 NumPendingInstances = 0;
+};
+
+/**
+ * 装备Actor对象池子系统
+ *
+ * 装备实例销毁Actor时（从装备栏卸下、从QuickBar移除等）不再直接销毁，而是按Actor类重置后放入池中，
+ * 下次生成同类装备Actor时直接复用，避免反复的Actor构造、组件注册和GC压力：
+ * - 复用/归还时通过 UYcEquipmentActorComponent 的 OnAcquiredFromPool / OnReturnedToPool 通知Actor重置自身状态
+ * - 每个Actor类最多保留 Yc.Equipment.ActorPoolSize 个空闲Actor，0 表示关闭对象池
+ * - 分帧生成：未装备状态下创建的装备实例（Actor本就隐藏），其Actor交给 Tick 在每帧
+ *   Yc.Equipment.DeferredSpawnBudgetMs 的预算内逐个生成；装备实例被装备或按Tag查询Actor时立即补齐
+ *
+ * 只有生成Actor的一端会放入池中：服务器上的复制Actor、控制客户端上的本地Actor。
+ */
+UCLASS()
+class YICHENEQUIPMENT_API UYcEquipmentActorPoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** 获取World中的对象池子系统，非游戏世界返回nullptr */
+	static UYcEquipmentActorPoolSubsystem* Get(const UWorld* World);
+
+	/** 对象池是否开启（Yc.Equipment.ActorPoolSize > 0） */
+	static bool IsPoolingEnabled();
+
+	/** 分帧生成是否开启（Yc.Equipment.DeferredSpawnBudgetMs > 0） */
+	static bool IsDeferredSpawnEnabled();
+
+	/**
+	 * 获取一个装备Actor
+	 * 池中有同类空闲Actor时唤醒后复用，否则生成新的Actor
+	 * @param ActorClass Actor类
+	 * @param OwningPawn 所属Pawn，作为Actor的Owner
+	 * @param bOutReused 是否为池中复用的Actor
+	 * @return Actor，生成失败返回nullptr
+	 */
+	AActor* AcquireActor(TSubclassOf<AActor> ActorClass, APawn* OwningPawn, bool& bOutReused);
+
+	/**
+	 * 归还一个装备Actor
+	 * 池未满时重置（分离、隐藏、关闭Tick和碰撞、复制Actor进入网络休眠）后放入池中，否则销毁
+	 * @param Actor 要归还的Actor
+	 */
+	void ReleaseActor(AActor* Actor);
+
+	/** 将装备实例加入分帧生成队列 */
+	void QueueDeferredSpawn(UYcEquipmentInstance* Instance);
+
+	/**
+	 * 按预算推进分帧生成
+	 * 正常情况下由 Tick 调用，测试时也可直接调用
+	 * @param BudgetSeconds 本次可用时间，<=0 表示不限时
+	 * @return 本次生成的Actor数
+	 */
+	int32 ProcessDeferredSpawns(double BudgetSeconds);
+
+	/** 是否还有等待分帧生成的装备实例 */
+	bool HasDeferredSpawns() const { return DeferredSpawnQueue.Num() > 0; }
+
+	/** 获取统计信息 */
+	UFUNCTION(BlueprintPure, Category = "Equipment|Pool")
+	FYcEquipmentActorPoolStats GetPoolStats() const;
+
+	/** 销毁池中所有空闲Actor */
+	UFUNCTION(BlueprintCallable, Category = "Equipment|Pool")
+	void ClearPool();
+
+private:
+	/** Actor类 -> 空闲Actor */
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FYcEquipmentActorPool> Pools;
+
+	/** 等待分帧生成Actor的装备实例，按加入顺序处理 */
+	TArray<TWeakObjectPtr<UYcEquipmentInstance>> DeferredSpawnQueue;
+
+	/** 统计信息（NumPooled/NumPendingInstances 在查询时计算） */
+	FYcEquipmentActorPoolStats Stats;
+};
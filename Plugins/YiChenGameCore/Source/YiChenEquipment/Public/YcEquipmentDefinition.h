@@ -6,6 +6,7 @@
 #include "GameplayTagContainer.h"
 #include "UObject/Object.h"
 #include "StructUtils/InstancedStruct.h"
+#include "Utils/YcFragmentIndex.h"
 #include "YcEquipmentDefinition.generated.h"
 
 class UYcEquipmentInstance;
@@ -175,11 +176,35 @@ struct YICHENEQUIPMENT_API FYcEquipmentDefinition : public FTableRowBase
 	template <typename FragmentType>
 	const FragmentType* GetTypedFragment() const
 	{
-		for (const auto& Fragment : Fragments)
-		{
-			const FragmentType* TypedFragment = Fragment.GetPtr<FragmentType>();
-			if (TypedFragment != nullptr) return TypedFragment;
-		}
-		return nullptr;
+		return FragmentIndex.template FindTyped<FragmentType>(Fragments);
 	}
+	
+	/**
+	 * 按结构体类型精确查找 Fragment
+	 * 返回定义中的 Fragment 本身，不产生拷贝
+	 */
+	const TInstancedStruct<FYcEquipmentFragment>* FindFragment(const UScriptStruct* FragmentStructType) const
+	{
+		return FragmentIndex.FindExact(Fragments, FragmentStructType);
+	}
+	
+	/** 反序列化完成后构建 Fragment 类型索引 */
+	void PostSerialize(const FArchive& Ar);
+	
+	//~ Begin FTableRowBase Interface
+	virtual void OnDataTableChanged(const UDataTable* InDataTable, const FName InRowName) override;
+	//~ End FTableRowBase Interface
+	
+private:
+	/** Fragment 类型 -> Fragments 下标，避免每次查询都线性遍历 Fragments */
+	TYcFragmentIndex<FYcEquipmentFragment> FragmentIndex;
+};
+
+template<>
+struct TStructOpsTypeTraits<FYcEquipmentDefinition> : public TStructOpsTypeTraitsBase2<FYcEquipmentDefinition>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
 };
\ No newline at end of file
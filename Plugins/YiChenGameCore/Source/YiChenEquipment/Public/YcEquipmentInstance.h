@@ -179,6 +179,9 @@ public:
 	 * - bReplicateActor=true: 在服务器生成，自动复制到客户端
 	 * - bReplicateActor=false: 仅在控制客户端本地生成
 	 * 
+	 * Actor优先从 UYcEquipmentActorPoolSubsystem 的对象池中复用；
+	 * 未装备状态下调用时交给对象池子系统分帧生成，装备或按Tag查询Actor时立即补齐。
+	 * 
 	 * @param ActorsToSpawn 要生成的Actor配置列表
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Equipment")
@@ -186,7 +189,7 @@ public:
 
 	/**
 	 * 销毁装备所生成的所有Actors
-	 * 会同时销毁服务器复制的Actor和本地Actor
+	 * 会同时销毁服务器复制的Actor和本地Actor，开启对象池时归还到池中；尚未分帧生成的Actor不再生成
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Equipment")
 	virtual void DestroyEquipmentActors();
@@ -198,6 +201,17 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Equipment")
 	bool HasSpawnedActors() const { return bActorsSpawned; }
 	
+	/**
+	 * 是否还有排队等待分帧生成的Actor
+	 * @return true表示SpawnedActors/OwnerClientSpawnedActors尚不完整
+	 */
+	UFUNCTION(BlueprintPure, Category = "Equipment")
+	bool HasPendingActorSpawns() const { return NextPendingActorIndex < PendingActorsToSpawn.Num(); }
+	
+	/** 立即生成所有排队等待分帧生成的Actor */
+	UFUNCTION(BlueprintCallable, Category = "Equipment")
+	void FlushPendingActorSpawns();
+	
 	/**
 	 * 根据Tag查找生成的Actor对象
 	 * @param Tag 要查找的ActorTag
@@ -293,6 +307,14 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Equipment")
 	TInstancedStruct<FYcEquipmentFragment> FindEquipmentFragment(const UScriptStruct* FragmentStructType);
 	
+	/**
+	 * C++版本：按结构体类型查找Fragment
+	 * 直接返回装备定义中的Fragment，不产生拷贝
+	 * @param FragmentStructType 目标Fragment结构类型
+	 * @return Fragment指针，如果不存在则返回nullptr
+	 */
+	const TInstancedStruct<FYcEquipmentFragment>* FindEquipmentFragmentPtr(const UScriptStruct* FragmentStructType);
+	
 	/**
 	 * 装备实例创建完成时的回调
 	 * 
@@ -385,12 +407,23 @@ private:
 	/** 让单个Actor进入休眠状态 */
 	void SetActorDormant(AActor* Actor, bool bReplicated);
 	
-	/** 让单个Actor从休眠状态唤醒 */
+	/** 让单个Actor从休眠状态唤醒，碰撞恢复为类默认设置 */
 	void WakeActorFromDormant(AActor* Actor, bool bReplicated);
 	
 	/** 内部函数：生成单个装备Actor */
 	AActor* SpawnEquipActorInternal(const TSubclassOf<AActor>& ActorToSpawnClass, const FYcEquipmentActorToSpawn& SpawnInfo, USceneComponent* AttachTarget);
 	
+	/**
+	 * 生成排队中的下一个Actor（由对象池子系统分帧调用）
+	 * @return 是否还有排队的Actor
+	 */
+	bool SpawnNextPendingActor_Internal();
+	
+	/** 归还（或销毁）一组装备Actor */
+	void ReleaseEquipmentActors_Internal(TArray<TObjectPtr<AActor>>& Actors);
+	
+	friend class UYcEquipmentActorPoolSubsystem;
+	
 public:
 	// ========================================================================
 	// 工具函数
@@ -466,7 +499,13 @@ protected:
 	/** 装备定义指针缓存 */
 	const FYcEquipmentDefinition* EquipmentDef = nullptr;
 	
-	/** 标记是否已经生成过装备Actors */
+	/** 排队等待生成的Actor配置，生成完成后清空 */
+	TArray<FYcEquipmentActorToSpawn> PendingActorsToSpawn;
+	
+	/** PendingActorsToSpawn中下一个要生成的位置 */
+	int32 NextPendingActorIndex = 0;
+	
+	/** 标记是否已经生成过装备Actors（包括已排队分帧生成） */
 	uint8 bActorsSpawned : 1;
 	
 	// ========================================================================
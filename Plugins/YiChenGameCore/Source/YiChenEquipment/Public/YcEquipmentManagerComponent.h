@@ -30,6 +30,21 @@ struct FYcEquipmentEntry : public FFastArraySerializerItem
 
 	FString GetDebugString() const;
 
+	/** 获取装备实例 */
+	UYcEquipmentInstance* GetInstance() const { return Instance; }
+
+	/** 获取装备所属的库存物品实例 */
+	UYcInventoryItemInstance* GetOwnerItemInstance() const { return OwnerItemInstance; }
+
+#if !UE_BUILD_SHIPPING
+	/** 仅供测试：直接设置实例与物品引用，用于模拟客户端上引用晚于条目到达（不标脏、不更新索引） */
+	void SetReferencesForTesting(UYcEquipmentInstance* InInstance, UYcInventoryItemInstance* InOwnerItemInstance)
+	{
+		Instance = InInstance;
+		OwnerItemInstance = InOwnerItemInstance;
+	}
+#endif // #if !UE_BUILD_SHIPPING
+
 private:
 	friend FYcEquipmentList;
 	friend UYcEquipmentManagerComponent;
@@ -76,6 +91,7 @@ struct FYcEquipmentList : public FFastArraySerializer
 	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
 	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
 
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
 	{
@@ -120,9 +136,45 @@ struct FYcEquipmentList : public FFastArraySerializer
 	 */
 	void DestroyEntry(UYcEquipmentInstance* Instance);
 
+	// ========================================================================
+	// 查询接口
+	// ========================================================================
+
+	/** 获取全部装备条目 */
+	const TArray<FYcEquipmentEntry>& GetEntries() const { return Entries; }
+
+	/** 按装备实例查找条目下标，不存在返回INDEX_NONE */
+	int32 FindEntryIndex(const UYcEquipmentInstance* Instance) const;
+
+	/** 按所属物品实例查找条目下标，不存在返回INDEX_NONE */
+	int32 FindEntryIndexByItem(const UYcInventoryItemInstance* ItemInstance) const;
+
+	/** 按装备槽位查找条目下标：优先返回已装备的条目，否则返回槽位中第一个条目 */
+	int32 FindEntryIndexBySlot(const FGameplayTag& SlotTag) const;
+
+#if !UE_BUILD_SHIPPING
+	/** 仅供测试：可修改的条目数组，用于按 FastArray 的回调顺序模拟客户端复制（不标脏、不更新索引） */
+	TArray<FYcEquipmentEntry>& GetEntriesForTesting() { return Entries; }
+#endif // #if !UE_BUILD_SHIPPING
+
 private:
 	UYcAbilitySystemComponent* GetAbilitySystemComponent() const;
-	FYcEquipmentEntry* FindEntry(UYcEquipmentInstance* Instance);
+
+	// ========================================================================
+	// 条目索引
+	// ========================================================================
+
+	/** 登记（或重新登记）Entries中指定位置的条目，条目的实例、物品或槽位变化后调用 */
+	void IndexEntry_Internal(int32 EntryIndex) const;
+
+	/** 从索引中移除指定位置已登记的键 */
+	void UnindexEntry_Internal(int32 EntryIndex) const;
+
+	/** 按当前Entries重建索引 */
+	void RebuildIndex_Internal() const;
+
+	/** 查询前确保索引可用：条目数量不一致时重建，补全尚未解析的键 */
+	void EnsureIndex_Internal() const;
 
 	friend UYcEquipmentManagerComponent;
 	
@@ -132,6 +184,46 @@ private:
 
 	UPROPERTY(NotReplicated, VisibleAnywhere)
 	TObjectPtr<UActorComponent> OwnerComponent;
+
+	/** 条目已登记到索引的键，与Entries一一对应 */
+	struct FIndexedKeys
+	{
+		/** 已登记的装备实例 */
+		FObjectKey Instance;
+
+		/** 已登记的所属物品实例 */
+		FObjectKey Item;
+
+		/** 已登记的装备槽位 */
+		FGameplayTag Slot;
+
+		/** 实例、物品或装备定义尚未复制到达，已加入PendingEntries，查询时再次尝试登记 */
+		bool bPending = false;
+	};
+
+	/**
+	 * 条目索引，用于O(1)查询
+	 * TMap不支持网络复制，在权威端的增删和FastArray的网络复制辅助函数中维护；
+	 * 只保存Entries下标而不保存条目指针。移除条目会移动其余条目的位置（服务器RemoveAt、客户端RemoveAtSwap），
+	 * 装备条目数量很少且移除不频繁，移除后直接重建。
+	 * 查询接口都是const，索引在查询时可能补全，因此声明为mutable，只应在游戏线程访问。
+	 */
+	mutable TArray<FIndexedKeys> IndexedKeys;
+
+	/** 装备实例 -> Entries下标 */
+	mutable TMap<FObjectKey, int32> InstanceToEntry;
+
+	/** 所属物品实例 -> Entries下标 */
+	mutable TMap<FObjectKey, int32> ItemToEntry;
+
+	/** 装备槽位 -> Entries下标（升序） */
+	mutable TMap<FGameplayTag, TArray<int32, TInlineAllocator<2>>> SlotToEntries;
+
+	/** 键尚未解析完整的条目下标，查询时只需重试这些条目 */
+	mutable TArray<int32> PendingEntries;
+
+	/** 客户端移除条目后数组位置待修正，在PostReplicatedReceive中重建 */
+	mutable bool bEntryPositionsDirty = false;
 };
 
 template <>
@@ -301,6 +393,15 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Equipment")
 	UYcEquipmentInstance* FindEquipmentByItem(UYcInventoryItemInstance* ItemInstance) const;
 	
+	/**
+	 * 根据装备槽位查找装备实例
+	 * 同一槽位存在多个装备实例时，优先返回已装备的实例
+	 * @param SlotTag 装备槽位标签（装备定义中的EquipmentSlot）
+	 * @return 该槽位上的装备实例，如果不存在则返回nullptr
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Equipment")
+	UYcEquipmentInstance* FindEquipmentBySlot(FGameplayTag SlotTag) const;
+	
 	/**
 	 * 获取当前已装备的装备实例
 	 * @return 当前已装备的装备实例，如果没有则返回nullptr
@@ -331,6 +432,9 @@ public:
 		return Cast<T>(GetFirstInstanceOfType(T::StaticClass()));
 	}
 	
+	/** 获取装备列表（只读） */
+	const FYcEquipmentList& GetEquipmentList() const { return EquipmentList; }
+	
 private:
 	friend struct FYcEquipmentList;
 	
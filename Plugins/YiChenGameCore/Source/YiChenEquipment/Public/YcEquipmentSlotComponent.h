@@ -6,6 +6,7 @@
 #include "Components/PawnComponent.h"
 #include "YcEquipmentSlotComponent.generated.h"
 
+class AController;
 class UYcInventoryItemInstance;
 class UYcInventoryManagerComponent;
 class UYcEquipmentManagerComponent;
@@ -44,7 +45,6 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	// 装备接口（仅服务器）
 
@@ -134,6 +134,16 @@ private:
 	/** 从 Router 反注册装备操作处理器。 */
 	void UnregisterInventoryOperationHandlers();
 
+	/**
+	 * Pawn 的 Controller 变化通知（服务端）。
+	 * Router 挂在 Controller 上：被控制时向新 Router 注册处理器，失去控制或更换 Controller 时从旧 Router 反注册。
+	 */
+	UFUNCTION()
+	void HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+	/** 更新等待 Router 的状态并同步统计计数。 */
+	void SetWaitingForRouter(bool bWaiting);
+
 	/** `Equipment.Equip` 的服务端校验逻辑。 */
 	bool ValidateEquipOperation(const FYcInventoryOperation& Operation, FString& OutReason) const;
 
@@ -157,6 +167,11 @@ private:
 	void ProjectUnequipOperationState(const FYcInventoryOperation& Operation, FYcInventoryProjectedState& InOutProjectedState) const;
 	/** 是否已经成功向 Router 注册操作处理器。 */
 	bool bOperationHandlersRegistered = false;
+
+	/** 是否正在等待 Pawn 被控制后注册处理器（计入 STAT_YcEquipment_SlotWaitingForRouter）。 */
+	bool bWaitingForRouter = false;
+
+	friend struct FYcEquipmentHandlerRegistrationTest;
 };
 
 /**
@@ -7,6 +7,8 @@
 
 YICHENEQUIPMENT_API DECLARE_LOG_CATEGORY_EXTERN(LogYcEquipment, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("YcEquipment"), STATGROUP_YcEquipment, STATCAT_Advanced);
+
 class FYiChenEquipmentModule : public IModuleInterface
 {
 public:
@@ -0,0 +1,115 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "StructUtils/InstancedStruct.h"
+
+/**
+ * Fragment 数组的类型索引：脚本结构体 -> Fragments 下标
+ *
+ * 供物品/装备定义使用，代替每次查询时线性遍历 Fragments 并比较结构体类型。
+ * - 精确索引：只记录 Fragment 自身的结构体类型，对应蓝图/脚本的 FindXxxFragment（按类型相等匹配）
+ * - 派生索引：同时记录 Fragment 的所有父结构体，对应 C++ 的 GetTypedFragment<T>()（按 IsChildOf 匹配）
+ * 两者都取数组中第一个匹配项，与原先的线性查找结果一致。
+ *
+ * 索引在定义反序列化完成后（PostSerialize）构建，定义被拷贝时随之拷贝；
+ * Fragments 数量变化或命中项类型不符时会在查询时重新构建，编辑器中修改数据表后应调用 Reset()。
+ * 重新构建不加锁，只应在游戏线程查询。
+ */
+template <typename BaseFragmentType>
+struct TYcFragmentIndex
+{
+	using FFragment = TInstancedStruct<BaseFragmentType>;
+	using FFragmentArray = TArray<FFragment>;
+
+	/** 按结构体类型精确查找 */
+	const FFragment* FindExact(const FFragmentArray& Fragments, const UScriptStruct* FragmentStructType) const
+	{
+		return Find(Fragments, FragmentStructType, false);
+	}
+
+	/** 查找第一个属于该类型（含派生类型）的 Fragment */
+	const FFragment* FindChildOf(const FFragmentArray& Fragments, const UScriptStruct* FragmentStructType) const
+	{
+		return Find(Fragments, FragmentStructType, true);
+	}
+
+	/** 按类型查找并返回 Fragment 指针 */
+	template <typename FragmentType>
+	const FragmentType* FindTyped(const FFragmentArray& Fragments) const
+	{
+		const FFragment* Fragment = FindChildOf(Fragments, FragmentType::StaticStruct());
+		return Fragment ? Fragment->template GetPtr<FragmentType>() : nullptr;
+	}
+
+	/** 根据当前 Fragments 重新构建索引 */
+	void Build(const FFragmentArray& Fragments) const
+	{
+		ExactIndices.Reset();
+		ChildOfIndices.Reset();
+		for (int32 Index = 0; Index < Fragments.Num(); ++Index)
+		{
+			const UScriptStruct* FragmentStruct = Fragments[Index].GetScriptStruct();
+			if (!FragmentStruct)
+			{
+				continue;
+			}
+
+			if (!ExactIndices.Contains(FragmentStruct))
+			{
+				ExactIndices.Add(FragmentStruct, Index);
+			}
+			for (const UStruct* Struct = FragmentStruct; Struct; Struct = Struct->GetSuperStruct())
+			{
+				if (!ChildOfIndices.Contains(Struct))
+				{
+					ChildOfIndices.Add(Struct, Index);
+				}
+			}
+		}
+		NumIndexedFragments = Fragments.Num();
+	}
+
+	/** 丢弃索引，下次查询时重新构建 */
+	void Reset()
+	{
+		ExactIndices.Reset();
+		ChildOfIndices.Reset();
+		NumIndexedFragments = INDEX_NONE;
+	}
+
+private:
+	const FFragment* Find(const FFragmentArray& Fragments, const UScriptStruct* FragmentStructType, const bool bAllowChildren) const
+	{
+		if (!FragmentStructType)
+		{
+			return nullptr;
+		}
+		if (NumIndexedFragments != Fragments.Num())
+		{
+			Build(Fragments);
+		}
+
+		const int32* Index = (bAllowChildren ? ChildOfIndices : ExactIndices).Find(FragmentStructType);
+		if (!Index)
+		{
+			return nullptr;
+		}
+
+		// 数量不变但内容被替换时（例如编辑器中修改了某个 Fragment 的类型）重新构建一次
+		const FFragment* Fragment = Fragments.IsValidIndex(*Index) ? &Fragments[*Index] : nullptr;
+		const UScriptStruct* FoundStruct = Fragment ? Fragment->GetScriptStruct() : nullptr;
+		const bool bMatches = FoundStruct && (bAllowChildren ? FoundStruct->IsChildOf(FragmentStructType) : FoundStruct == FragmentStructType);
+		if (!bMatches)
+		{
+			Build(Fragments);
+			Index = (bAllowChildren ? ChildOfIndices : ExactIndices).Find(FragmentStructType);
+			Fragment = Index ? &Fragments[*Index] : nullptr;
+		}
+		return Fragment;
+	}
+
+	mutable TMap<const UStruct*, int32> ExactIndices;
+	mutable TMap<const UStruct*, int32> ChildOfIndices;
+	mutable int32 NumIndexedFragments = INDEX_NONE;
+};
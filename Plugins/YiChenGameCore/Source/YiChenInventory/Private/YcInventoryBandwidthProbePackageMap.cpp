@@ -0,0 +1,238 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcInventoryBandwidthProbePackageMap.h"
+#include "YcInventoryItemInstance.h"
+#include "YcInventoryManagerComponent.h"
+#include "YcInventoryOperationBatch.h"
+#include "YiChenInventory.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UnrealType.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcInventoryBandwidthProbePackageMap)
+
+bool UYcInventoryBandwidthProbePackageMap::SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID)
+{
+	uint32 Guid = 0;
+	if (Ar.IsSaving() && Obj)
+	{
+		Guid = (FirstGuidValue + Objects.AddUnique(Obj)) * 2;
+	}
+
+	Ar.SerializeIntPacked(Guid);
+
+	if (Ar.IsLoading())
+	{
+		const int32 Index = static_cast<int32>(Guid / 2) - static_cast<int32>(FirstGuidValue);
+		Obj = Guid != 0 && Objects.IsValidIndex(Index) ? Objects[Index] : nullptr;
+	}
+	return true;
+}
+
+namespace YcInventoryOperationBatchBandwidth
+{
+	/**
+	 * 模拟逐个 RPC 发送时的参数序列化：参数非默认值时写 1 位标记，
+	 * 结构体按成员逐个调用 NetSerializeItem，没有原生 NetSerialize 的子结构体继续展开
+	 */
+	void SerializeLegacyProperty(FNetBitWriter& Writer, UPackageMap* Map, const FProperty* Property, void* Data)
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if (StructProperty && !(StructProperty->Struct->StructFlags & STRUCT_NetSerializeNative))
+		{
+			for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+			{
+				SerializeLegacyProperty(Writer, Map, *It, It->ContainerPtrToValuePtr<void>(Data));
+			}
+			return;
+		}
+		Property->NetSerializeItem(Writer, Map, Data);
+	}
+
+	int64 MeasureLegacyOperation(UPackageMap* Map, FYcInventoryOperation& Operation)
+	{
+		FNetBitWriter Writer(Map, 8192);
+		Writer.WriteBit(1);
+		for (TFieldIterator<FProperty> It(FYcInventoryOperation::StaticStruct()); It; ++It)
+		{
+			SerializeLegacyProperty(Writer, Map, *It, It->ContainerPtrToValuePtr<void>(&Operation));
+		}
+		return Writer.GetNumBits();
+	}
+
+	/** 旧回执：ClientReceiveInventoryOperationAck/Nack(int64 OpId, int32 NewRevision, FString Detail) */
+	int64 MeasureLegacyAck(int64 OpId, int32 NewRevision, FString Detail)
+	{
+		FNetBitWriter Writer(nullptr, 8192);
+		Writer.WriteBit(1);
+		Writer << OpId;
+		Writer.WriteBit(1);
+		Writer << NewRevision;
+		Writer.WriteBit(1);
+		Writer << Detail;
+		return Writer.GetNumBits();
+	}
+
+	bool IsSameOperation(const FYcInventoryOperation& A, const FYcInventoryOperation& B)
+	{
+		return A.OpId == B.OpId && A.OpType == B.OpType && A.BaseRevision == B.BaseRevision
+			&& A.RequestActor == B.RequestActor && A.RequestInventory == B.RequestInventory
+			&& A.SourceInventory == B.SourceInventory && A.TargetInventory == B.TargetInventory
+			&& A.ItemInstance == B.ItemInstance && A.StackCount == B.StackCount && A.GridTile == B.GridTile
+			&& A.bRotated == B.bRotated && A.SlotTag == B.SlotTag && A.SlotIndex == B.SlotIndex;
+	}
+
+	/**
+	 * 带宽测量：模拟一次"拾取全部"，对比逐个 RPC 与批量 RPC 的载荷位数，
+	 * 并把批次和回执读回校验内容一致
+	 */
+	void RunBandwidthTest(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumOps = FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 40, 1, FYcInventoryOperationBatch::MaxOperations);
+		const int32 NumNacks = FMath::Clamp(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 2, 0, NumOps);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		AActor* Actor = World->SpawnActor<AActor>(SpawnParams);
+		if (!Actor)
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.OperationBatchBandwidth: 无法生成测试Actor"));
+			return;
+		}
+
+		UYcInventoryManagerComponent* PlayerInventory = NewObject<UYcInventoryManagerComponent>(Actor);
+		UYcInventoryManagerComponent* ContainerInventory = NewObject<UYcInventoryManagerComponent>(Actor);
+		UYcInventoryBandwidthProbePackageMap* Map = NewObject<UYcInventoryBandwidthProbePackageMap>();
+
+		// 容器中的物品逐个转移到玩家背包
+		FYcInventoryOperationBatch Batch;
+		Batch.BatchId = 1;
+		for (int32 i = 0; i < NumOps; ++i)
+		{
+			FYcInventoryOperation& Op = Batch.Operations.AddDefaulted_GetRef();
+			Op.OpId = 100 + i;
+			Op.OpType = (i % 4 == 0) ? FName(TEXT("Inventory.SwapGrid")) : FName(TEXT("Container.Take"));
+			Op.BaseRevision = 37;
+			Op.ClientTimestamp = World->GetTimeSeconds();
+			Op.RequestActor = Actor;
+			Op.RequestInventory = PlayerInventory;
+			Op.SourceInventory = ContainerInventory;
+			Op.TargetInventory = PlayerInventory;
+			Op.ItemInstance = NewObject<UYcInventoryItemInstance>(Actor);
+			Op.StackCount = (i % 3 == 0) ? 30 : 1;
+			Op.GridTile = FIntPoint(i % 8, i / 8);
+			Op.bRotated = (i % 5 == 0);
+		}
+
+		// 最后一件直接装备，覆盖槽位标签字段；这里只需要任意一个已注册的标签
+		const FGameplayTag SlotTag = FGameplayTag::RequestGameplayTag(FName(TEXT("Yc.Inventory.Message.StackChanged")), false);
+		if (NumOps > 1 && SlotTag.IsValid())
+		{
+			FYcInventoryOperation& EquipOp = Batch.Operations.Last();
+			EquipOp.OpType = FName(TEXT("Equipment.Equip"));
+			EquipOp.SlotTag = SlotTag;
+			EquipOp.GridTile = FIntPoint::ZeroValue;
+		}
+
+		// 逐个 RPC 的载荷
+		// 回执按相同信息量对比：不带原因时 Detail 为空，带原因时只有 Nack 携带原因，与批量回执一致
+		const FString NackReason = TEXT("Container.Take target grid occupied.");
+		int64 LegacySubmitBits = 0;
+		int64 LegacyAckBits = 0;
+		int64 LegacyAckWithReasonsBits = 0;
+		for (int32 i = 0; i < NumOps; ++i)
+		{
+			const bool bNack = i < NumNacks;
+			const int32 NewRevision = bNack ? 37 : 38 + i;
+			LegacySubmitBits += MeasureLegacyOperation(Map, Batch.Operations[i]);
+			LegacyAckBits += MeasureLegacyAck(Batch.Operations[i].OpId, NewRevision, FString());
+			LegacyAckWithReasonsBits += MeasureLegacyAck(Batch.Operations[i].OpId, NewRevision, bNack ? NackReason : FString());
+		}
+
+		// 批量 RPC 的载荷
+		int32 NumErrors = 0;
+		FNetBitWriter BatchWriter(Map, 8192);
+		bool bSuccess = false;
+		Batch.NetSerialize(BatchWriter, Map, bSuccess);
+		NumErrors += bSuccess ? 0 : 1;
+
+		FYcInventoryOperationBatchResult Result;
+		Result.BatchId = Batch.BatchId;
+		Result.NewRevision = 37 + NumOps - NumNacks;
+		Result.Init(NumOps);
+		for (int32 i = 0; i < NumOps; ++i)
+		{
+			Result.AckBits[i] = i >= NumNacks;
+			if (i < NumNacks)
+			{
+				Result.ErrorCodes.Add(EYcInventoryOperationErrorCode::Rejected);
+			}
+		}
+
+		FNetBitWriter ResultWriter(Map, 8192);
+		Result.NetSerialize(ResultWriter, Map, bSuccess);
+		NumErrors += bSuccess ? 0 : 1;
+
+		Result.Reasons.Init(NackReason, NumNacks);
+		FNetBitWriter ResultWithReasonsWriter(Map, 8192);
+		Result.NetSerialize(ResultWithReasonsWriter, Map, bSuccess);
+		NumErrors += bSuccess ? 0 : 1;
+
+		// 读回校验
+		FNetBitReader BatchReader(Map, BatchWriter.GetData(), BatchWriter.GetNumBits());
+		FYcInventoryOperationBatch ReadBatch;
+		ReadBatch.NetSerialize(BatchReader, Map, bSuccess);
+		if (!bSuccess || ReadBatch.BatchId != Batch.BatchId || ReadBatch.Operations.Num() != NumOps)
+		{
+			++NumErrors;
+		}
+		else
+		{
+			for (int32 i = 0; i < NumOps; ++i)
+			{
+				if (!IsSameOperation(Batch.Operations[i], ReadBatch.Operations[i]))
+				{
+					UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.OperationBatchBandwidth: 第 %d 条操作读回不一致"), i);
+					++NumErrors;
+				}
+			}
+		}
+
+		FNetBitReader ResultReader(Map, ResultWithReasonsWriter.GetData(), ResultWithReasonsWriter.GetNumBits());
+		FYcInventoryOperationBatchResult ReadResult;
+		ReadResult.NetSerialize(ResultReader, Map, bSuccess);
+		if (!bSuccess || !(ReadResult.AckBits == Result.AckBits) || ReadResult.ErrorCodes != Result.ErrorCodes
+			|| ReadResult.Reasons != Result.Reasons || ReadResult.NewRevision != Result.NewRevision)
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.OperationBatchBandwidth: 回执读回不一致"));
+			++NumErrors;
+		}
+
+		Actor->Destroy();
+
+		const int64 LegacyTotal = LegacySubmitBits + LegacyAckBits;
+		const int64 BatchTotal = BatchWriter.GetNumBits() + ResultWriter.GetNumBits();
+		const int64 LegacyWithReasonsTotal = LegacySubmitBits + LegacyAckWithReasonsBits;
+		const int64 BatchWithReasonsTotal = BatchWriter.GetNumBits() + ResultWithReasonsWriter.GetNumBits();
+		UE_LOG(LogYcInventory, Display, TEXT("Yc.Inventory.OperationBatchBandwidth: %s (操作 %d，Nack %d，错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumOps, NumNacks, NumErrors);
+		UE_LOG(LogYcInventory, Display, TEXT("  逐个 RPC: 提交 %lld 字节 + 回执 %lld 字节（附带失败原因 %lld 字节），共 %d 个 RPC"),
+			(LegacySubmitBits + 7) / 8, (LegacyAckBits + 7) / 8, (LegacyAckWithReasonsBits + 7) / 8, NumOps * 2);
+		UE_LOG(LogYcInventory, Display, TEXT("  批量 RPC: 提交 %lld 字节 + 回执 %lld 字节（附带失败原因 %lld 字节），共 2 个 RPC"),
+			(BatchWriter.GetNumBits() + 7) / 8, (ResultWriter.GetNumBits() + 7) / 8, (ResultWithReasonsWriter.GetNumBits() + 7) / 8);
+		UE_LOG(LogYcInventory, Display, TEXT("  载荷压缩比: %.1fx，附带失败原因 %.1fx（未计入每个 RPC 自身的头部开销）"),
+			BatchTotal > 0 ? static_cast<double>(LegacyTotal) / BatchTotal : 0.0,
+			BatchWithReasonsTotal > 0 ? static_cast<double>(LegacyWithReasonsTotal) / BatchWithReasonsTotal : 0.0);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdBandwidthTest(
+		TEXT("Yc.Inventory.OperationBatchBandwidth"),
+		TEXT("库存操作批量 RPC 带宽对比：Yc.Inventory.OperationBatchBandwidth [操作数=40] [Nack数=2]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBandwidthTest));
+}
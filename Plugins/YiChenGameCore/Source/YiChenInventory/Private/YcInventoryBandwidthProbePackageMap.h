@@ -0,0 +1,30 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "UObject/CoreNet.h"
+#include "YcInventoryBandwidthProbePackageMap.generated.h"
+
+/**
+ * 带宽测量用的回环 PackageMap
+ *
+ * 不依赖网络连接：对象按首次出现顺序分配模拟 NetGUID，并像已完成导出的 GUID 一样按变长整数写入，
+ * 读取时再映射回同一个对象，用于在本地对网络序列化结果做写入/读回和位数统计。
+ */
+UCLASS(Transient)
+class UYcInventoryBandwidthProbePackageMap : public UPackageMap
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UPackageMap Interface
+	virtual bool SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID = nullptr) override;
+	//~ End UPackageMap Interface
+
+private:
+	/** 动态对象的 NetGUID 通常从较大的偶数开始，这里取相近的量级让位数统计更接近真实情况 */
+	static constexpr uint32 FirstGuidValue = 2048;
+
+	/** 已分配 GUID 的对象，下标即 GUID 序号 */
+	TArray<UObject*> Objects;
+};
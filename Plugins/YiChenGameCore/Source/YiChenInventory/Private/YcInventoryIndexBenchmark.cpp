@@ -0,0 +1,425 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcInventoryItemDefinition.h"
+#include "YcInventoryItemInstance.h"
+#include "YcInventoryManagerComponent.h"
+#include "YiChenInventory.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * 库存索引自检与性能对比（控制台命令）
+ *
+ * 通过测试接口给物品实例注入定义，不依赖DataRegistry中的数据，
+ * 因此可以在任意地图中运行。其余操作都只经过库存组件的公开接口。
+ */
+struct FYcInventoryIndexBenchmark
+{
+	/** 测试用的库存：临时Actor + 库存组件 + 本地物品定义 */
+	struct FFixture
+	{
+		AActor* Actor = nullptr;
+		UYcInventoryManagerComponent* Inventory = nullptr;
+		TArray<FYcInventoryItemDefinition> Definitions;
+
+		/** 期望状态：实例 -> 堆叠数量 */
+		TMap<UYcInventoryItemInstance*, int32> Expected;
+
+		int32 NextInstanceIndex = 0;
+
+		bool Initialize(UWorld* World, const int32 NumDefinitions)
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.ObjectFlags |= RF_Transient;
+			Actor = World->SpawnActor<AActor>(SpawnParams);
+			if (!Actor)
+			{
+				return false;
+			}
+
+			Inventory = NewObject<UYcInventoryManagerComponent>(Actor);
+			Inventory->RegisterComponent();
+
+			// 实例持有定义指针，数组创建后不能再扩容
+			Definitions.SetNum(NumDefinitions);
+			for (int32 i = 0; i < NumDefinitions; ++i)
+			{
+				Definitions[i].ItemId = FName(*FString::Printf(TEXT("IndexTest_Def_%d"), i));
+			}
+			return true;
+		}
+
+		void Shutdown()
+		{
+			if (Actor)
+			{
+				Actor->Destroy();
+				Actor = nullptr;
+			}
+		}
+
+		UYcInventoryItemInstance* AddInstance(const int32 StackCount)
+		{
+			const int32 InstanceIndex = NextInstanceIndex++;
+			UYcInventoryItemInstance* Instance = NewObject<UYcInventoryItemInstance>(Actor);
+			Instance->SetItemDefForTesting(&Definitions[InstanceIndex % Definitions.Num()]);
+			if (!Inventory->AddItemInstance(Instance, StackCount))
+			{
+				return nullptr;
+			}
+			Expected.Add(Instance, StackCount);
+			return Instance;
+		}
+	};
+
+	/** 对照期望状态逐项校验索引，返回错误数 */
+	static int32 Validate(FFixture& Fixture, const TCHAR* Phase)
+	{
+		int32 NumErrors = 0;
+		UYcInventoryManagerComponent* Inventory = Fixture.Inventory;
+
+		const int32 NumItems = Inventory->GetAllItemInstance().Num();
+		if (NumItems != Fixture.Expected.Num())
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("[%s] 条目数量不一致：%d / 期望 %d"), Phase, NumItems, Fixture.Expected.Num());
+			++NumErrors;
+		}
+
+		for (const TPair<UYcInventoryItemInstance*, int32>& Pair : Fixture.Expected)
+		{
+			UYcInventoryItemInstance* Instance = Pair.Key;
+			FYcInventoryItemEntry Entry;
+			if (!Inventory->FindItemById(Instance->GetItemInstId(), Entry) || Entry.GetInstance() != Instance || Entry.GetStackCount() != Pair.Value)
+			{
+				UE_LOG(LogYcInventory, Error, TEXT("[%s] FindItemById 结果错误：%s"), Phase, *Instance->GetItemInstId().ToString());
+				++NumErrors;
+			}
+			if (Inventory->GetStackCountByItemInstance(Instance) != Pair.Value)
+			{
+				UE_LOG(LogYcInventory, Error, TEXT("[%s] 堆叠数量错误：%s"), Phase, *Instance->GetItemInstId().ToString());
+				++NumErrors;
+			}
+
+			const FYcInventoryItemHandle Handle = Inventory->FindItemHandle(Instance->GetItemInstId());
+			if (Inventory->GetItemInstanceByHandle(Handle) != Instance || Inventory->GetStackCountByHandle(Handle) != Pair.Value)
+			{
+				UE_LOG(LogYcInventory, Error, TEXT("[%s] 句柄解析错误：%s"), Phase, *Instance->GetItemInstId().ToString());
+				++NumErrors;
+			}
+		}
+
+		for (const FYcInventoryItemDefinition& Def : Fixture.Definitions)
+		{
+			int32 ExpectedInstances = 0;
+			int32 ExpectedStacks = 0;
+			for (const TPair<UYcInventoryItemInstance*, int32>& Pair : Fixture.Expected)
+			{
+				if (Pair.Key->GetItemDef() == &Def)
+				{
+					++ExpectedInstances;
+					ExpectedStacks += Pair.Value;
+				}
+			}
+
+			if (Inventory->GetTotalItemCountByDefinition(Def) != ExpectedInstances || Inventory->GetTotalStackCountByDefinition(Def) != ExpectedStacks)
+			{
+				UE_LOG(LogYcInventory, Error, TEXT("[%s] 定义汇总错误：%s 实例 %d/%d 堆叠 %d/%d"), Phase, *Def.ItemId.ToString(),
+					Inventory->GetTotalItemCountByDefinition(Def), ExpectedInstances,
+					Inventory->GetTotalStackCountByDefinition(Def), ExpectedStacks);
+				++NumErrors;
+			}
+
+			UYcInventoryItemInstance* First = Inventory->FindFirstItemInstByDefinition(Def);
+			if ((First != nullptr) != (ExpectedInstances > 0) || (First && First->GetItemDef() != &Def))
+			{
+				UE_LOG(LogYcInventory, Error, TEXT("[%s] FindFirstItemInstByDefinition 结果错误：%s"), Phase, *Def.ItemId.ToString());
+				++NumErrors;
+			}
+		}
+
+		return NumErrors;
+	}
+
+	/**
+	 * 正确性自检：大量添加过程中条目数组会多次重新分配，之后交替消耗、移除、复用槽位，
+	 * 每一步都与暴力扫描得到的期望值对比，并确认被移除物品的旧句柄已失效
+	 */
+	static void RunIndexTest(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumItems = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 500;
+
+		FFixture Fixture;
+		if (!Fixture.Initialize(World, 16))
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.IndexTest: 无法生成测试Actor"));
+			return;
+		}
+
+		int32 NumErrors = 0;
+		TArray<UYcInventoryItemInstance*> Instances;
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			Instances.Add(Fixture.AddInstance(i % 7 + 1));
+		}
+
+		NumErrors += Validate(Fixture, TEXT("Add"));
+
+		// 每五个消耗一层，每三个整体移除
+		TArray<FYcInventoryItemHandle> RemovedHandles;
+		for (int32 i = 0; i < Instances.Num(); ++i)
+		{
+			UYcInventoryItemInstance* Instance = Instances[i];
+			if (i % 3 == 0)
+			{
+				RemovedHandles.Add(Fixture.Inventory->FindItemHandle(Instance->GetItemInstId()));
+				Fixture.Inventory->RemoveItemInstance(Instance);
+				Fixture.Expected.Remove(Instance);
+			}
+			else if (i % 5 == 0 && Fixture.Expected[Instance] > 1)
+			{
+				Fixture.Inventory->ConsumeItemInstance(Instance, 1);
+				--Fixture.Expected[Instance];
+			}
+		}
+		NumErrors += Validate(Fixture, TEXT("Remove"));
+
+		// 新物品会复用空闲槽位，旧句柄必须仍然失效
+		for (int32 i = 0; i < RemovedHandles.Num(); ++i)
+		{
+			Fixture.AddInstance(2);
+		}
+		NumErrors += Validate(Fixture, TEXT("Reuse"));
+
+		for (const FYcInventoryItemHandle& Handle : RemovedHandles)
+		{
+			if (Fixture.Inventory->GetItemInstanceByHandle(Handle) != nullptr)
+			{
+				UE_LOG(LogYcInventory, Error, TEXT("[Reuse] 已移除物品的句柄仍可解析：Slot %d"), Handle.Slot);
+				++NumErrors;
+			}
+		}
+
+		Fixture.Shutdown();
+
+		UE_LOG(LogYcInventory, Display, TEXT("Yc.Inventory.IndexTest: %s (物品 %d, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumItems, NumErrors);
+	}
+
+	/** 改造前的查询方式：线性扫描全部条目 */
+	static int32 LegacyStackCountByDefinition(const TArray<FYcInventoryItemEntry>& Entries, const FName DefinitionId)
+	{
+		int32 Total = 0;
+		for (const FYcInventoryItemEntry& Entry : Entries)
+		{
+			UYcInventoryItemInstance* Instance = Entry.GetInstance();
+			if (Instance && Instance->GetItemDef() && Instance->GetItemDef()->ItemId == DefinitionId)
+			{
+				Total += Entry.GetStackCount();
+			}
+		}
+		return Total;
+	}
+
+	static int32 LegacyStackCountByInstance(const TArray<FYcInventoryItemEntry>& Entries, const UYcInventoryItemInstance* Instance)
+	{
+		for (const FYcInventoryItemEntry& Entry : Entries)
+		{
+			if (Entry.GetInstance() == Instance)
+			{
+				return Entry.GetStackCount();
+			}
+		}
+		return 0;
+	}
+
+	/** 性能对比：线性扫描 vs 索引查询 */
+	static void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumItems = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 500;
+		const int32 NumQueries = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100000;
+
+		FFixture Fixture;
+		if (!Fixture.Initialize(World, 32))
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.BenchmarkIndex: 无法生成测试Actor"));
+			return;
+		}
+
+		TArray<UYcInventoryItemInstance*> Instances;
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			Instances.Add(Fixture.AddInstance(i % 7 + 1));
+		}
+
+		UYcInventoryManagerComponent* Inventory = Fixture.Inventory;
+		const int32 NumDefinitions = Fixture.Definitions.Num();
+
+		// 线性扫描的对象：与库存中条目相同的副本
+		TArray<FYcInventoryItemEntry> Entries;
+		Entries.Reserve(NumItems);
+		for (UYcInventoryItemInstance* Instance : Instances)
+		{
+			Inventory->FindItemById(Instance->GetItemInstId(), Entries.AddDefaulted_GetRef());
+		}
+
+		// 累加结果防止被优化掉，同时用于核对两种方式结果一致
+		int64 LegacyChecksum = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			LegacyChecksum += LegacyStackCountByDefinition(Entries, Fixture.Definitions[i % NumDefinitions].ItemId);
+			LegacyChecksum += LegacyStackCountByInstance(Entries, Instances[i % NumItems]);
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - StartTime;
+
+		int64 IndexedChecksum = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			IndexedChecksum += Inventory->GetTotalStackCountByDefinition(Fixture.Definitions[i % NumDefinitions]);
+			IndexedChecksum += Inventory->GetStackCountByItemInstance(Instances[i % NumItems]);
+		}
+		const double IndexedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		Fixture.Shutdown();
+
+		UE_LOG(LogYcInventory, Display, TEXT("Yc.Inventory.BenchmarkIndex: 物品 %d，查询 %d 次"), NumItems, NumQueries);
+		UE_LOG(LogYcInventory, Display, TEXT("  线性扫描: %.2f ms (%.1f ns/次)"), LegacySeconds * 1000.0, LegacySeconds * 1e9 / NumQueries);
+		UE_LOG(LogYcInventory, Display, TEXT("  索引查询: %.2f ms (%.1f ns/次)"), IndexedSeconds * 1000.0, IndexedSeconds * 1e9 / NumQueries);
+		UE_LOG(LogYcInventory, Display, TEXT("  加速比: %.1fx，结果%s"), IndexedSeconds > 0.0 ? LegacySeconds / IndexedSeconds : 0.0,
+			LegacyChecksum == IndexedChecksum ? TEXT("一致") : TEXT("不一致"));
+	}
+
+	/** 当前FName表中的名称数量 */
+	static int32 GetNumNames()
+	{
+		return FName::GetNumAnsiNames() + FName::GetNumWideNames();
+	}
+
+	/** 改造前的ItemId生成方式：随机数 + Printf，每次尝试都会向FName表写入新名称 */
+	static FName LegacyGenerateItemId(const TSet<FName>& UsedIds, const FName BaseId)
+	{
+		FName NextItemId = BaseId;
+		for (int32 Attempts = 0; Attempts < 1000; ++Attempts)
+		{
+			if (!UsedIds.Contains(NextItemId))
+			{
+				return NextItemId;
+			}
+			NextItemId = FName(*FString::Printf(TEXT("%s_%d"), *BaseId.ToString(), FMath::Rand()));
+		}
+		return NAME_None;
+	}
+
+	/**
+	 * ItemId分配测试：同一定义的大量物品加入库存，检查ItemId唯一性和FName表增长
+	 * 计时包含实例创建和入库的开销
+	 */
+	static void RunItemIdTest(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumIds = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+		const int32 NumLegacyIds = Args.Num() > 1 ? FMath::Max(0, FCString::Atoi(*Args[1])) : 10000;
+
+		FFixture Fixture;
+		if (!Fixture.Initialize(World, 1))
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.ItemIdTest: 无法生成测试Actor"));
+			return;
+		}
+
+		// 先占用不带后缀的ItemId，之后的分配都走序号分支
+		const FYcInventoryItemDefinition& Def = Fixture.Definitions[0];
+		UYcInventoryItemInstance* FirstInstance = NewObject<UYcInventoryItemInstance>(Fixture.Actor);
+		FirstInstance->SetItemDefForTesting(&Def);
+		Fixture.Inventory->AddItemInstance(FirstInstance, 1);
+
+		int32 NumErrors = 0;
+		if (FirstInstance->GetItemInstId() != Def.ItemId)
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.ItemIdTest: 第一份物品应使用ItemId，实际为 %s"), *FirstInstance->GetItemInstId().ToString());
+			++NumErrors;
+		}
+
+		TSet<FName> Ids;
+		Ids.Reserve(NumIds);
+		const int32 NamesBefore = GetNumNames();
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIds; ++i)
+		{
+			UYcInventoryItemInstance* Instance = NewObject<UYcInventoryItemInstance>(Fixture.Actor);
+			Instance->SetItemDefForTesting(&Def);
+			Fixture.Inventory->AddItemInstance(Instance, 1);
+
+			bool bAlreadyInSet = false;
+			Ids.Add(Instance->GetItemInstId(), &bAlreadyInSet);
+			if (bAlreadyInSet || Instance->GetItemInstId() == Def.ItemId)
+			{
+				++NumErrors;
+			}
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		const int32 NameGrowth = GetNumNames() - NamesBefore;
+		if (NameGrowth != 0)
+		{
+			++NumErrors;
+		}
+
+		// 对照：旧实现在少量物品上的FName增长
+		TSet<FName> LegacyIds;
+		LegacyIds.Add(Def.ItemId);
+		const int32 LegacyNamesBefore = GetNumNames();
+		const double LegacyStartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumLegacyIds; ++i)
+		{
+			LegacyIds.Add(LegacyGenerateItemId(LegacyIds, Def.ItemId));
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - LegacyStartTime;
+		const int32 LegacyNameGrowth = GetNumNames() - LegacyNamesBefore;
+
+		Fixture.Shutdown();
+
+		UE_LOG(LogYcInventory, Display, TEXT("Yc.Inventory.ItemIdTest: %s (错误 %d)"), NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumErrors);
+		UE_LOG(LogYcInventory, Display, TEXT("  新实现: %d 个ID，唯一 %d，耗时 %.2f ms (%.1f ns/个)，FName表增长 %d"),
+			NumIds, Ids.Num(), Seconds * 1000.0, Seconds * 1e9 / NumIds, NameGrowth);
+		UE_LOG(LogYcInventory, Display, TEXT("  旧实现: %d 个ID，耗时 %.2f ms，FName表增长 %d"),
+			NumLegacyIds, LegacySeconds * 1000.0, LegacyNameGrowth);
+	}
+};
+
+namespace YcInventoryIndexBenchmark
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdIndexTest(
+		TEXT("Yc.Inventory.IndexTest"),
+		TEXT("库存索引正确性自检：Yc.Inventory.IndexTest [物品数=500]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcInventoryIndexBenchmark::RunIndexTest));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+		TEXT("Yc.Inventory.BenchmarkIndex"),
+		TEXT("库存查询性能对比：Yc.Inventory.BenchmarkIndex [物品数=500] [查询次数=100000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcInventoryIndexBenchmark::RunBenchmark));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdItemIdTest(
+		TEXT("Yc.Inventory.ItemIdTest"),
+		TEXT("ItemId分配测试：Yc.Inventory.ItemIdTest [分配数量=100000] [旧实现对照数量=10000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcInventoryIndexBenchmark::RunItemIdTest));
+}
+
+#endif // #if !UE_BUILD_SHIPPING
@@ -10,3 +10,16 @@ void FYcInventoryItemFragment::OnInstanceCreated(UYcInventoryItemInstance* Insta
 {
 	//@TODO 当物品实例对象创建后Fragment可对此做出响应
 }
+
+void FYcInventoryItemDefinition::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		FragmentIndex.Build(Fragments);
+	}
+}
+
+void FYcInventoryItemDefinition::OnDataTableChanged(const UDataTable* InDataTable, const FName InRowName)
+{
+	FragmentIndex.Reset();
+}
@@ -93,17 +93,14 @@ bool UYcInventoryItemInstance::K2_GetItemDef(FYcInventoryItemDefinition& OutItem
 
 TInstancedStruct<FYcInventoryItemFragment> UYcInventoryItemInstance::FindItemFragment(const UScriptStruct* FragmentStructType)
 {
-	TInstancedStruct<FYcInventoryItemFragment> NullStruct;
-	if (!GetItemDef()) return NullStruct;
-	
-	for (const auto& Frag : ItemDef->Fragments)
-	{	
-		if (FragmentStructType == Frag.GetScriptStruct())
-		{
-			return Frag;
-		}
-	}
-	return NullStruct;
+	const TInstancedStruct<FYcInventoryItemFragment>* Fragment = FindItemFragmentPtr(FragmentStructType);
+	return Fragment ? *Fragment : TInstancedStruct<FYcInventoryItemFragment>();
+}
+
+const TInstancedStruct<FYcInventoryItemFragment>* UYcInventoryItemInstance::FindItemFragmentPtr(const UScriptStruct* FragmentStructType)
+{
+	if (!GetItemDef()) return nullptr;
+	return ItemDef->FindFragment(FragmentStructType);
 }
 
 void UYcInventoryItemInstance::AddStatTagStack(const FGameplayTag Tag, const int32 StackCount)
@@ -15,24 +15,16 @@
 TInstancedStruct<FYcInventoryItemFragment> UYcInventoryLibrary::FindItemFragment(const FYcInventoryItemDefinition& ItemDef,
                                                                                  const UScriptStruct* FragmentStructType)
 {
-	TInstancedStruct<FYcInventoryItemFragment> NullStruct;
-	for (auto& Frag : ItemDef.Fragments)
-	{	
-		if (FragmentStructType == Frag.GetScriptStruct())
-		{
-			return Frag;
-		}
-	}
-	return NullStruct;
+	const TInstancedStruct<FYcInventoryItemFragment>* Fragment = ItemDef.FindFragment(FragmentStructType);
+	return Fragment ? *Fragment : TInstancedStruct<FYcInventoryItemFragment>();
 }
 
 TInstancedStruct<FYcInventoryItemFragment> UYcInventoryLibrary::FindItemFragmentById(const FDataRegistryId ItemDefId,
 	const UScriptStruct* FragmentStructType)
 {
-	FYcInventoryItemDefinition ItemDef;
-	GetItemDefinition(ItemDefId, ItemDef);
-	
-	return FindItemFragment(ItemDef, FragmentStructType);
+	const FYcInventoryItemDefinition* ItemDef = FindItemDefinition(ItemDefId);
+	const TInstancedStruct<FYcInventoryItemFragment>* Fragment = ItemDef ? ItemDef->FindFragment(FragmentStructType) : nullptr;
+	return Fragment ? *Fragment : TInstancedStruct<FYcInventoryItemFragment>();
 }
 
 UYcInventoryManagerComponent* UYcInventoryLibrary::GetInventoryManagerComponent(const AActor* Actor)
@@ -41,40 +33,51 @@ UYcInventoryManagerComponent* UYcInventoryLibrary::GetInventoryManagerComponent(
 }
 
 bool UYcInventoryLibrary::GetItemDefinition(const FDataRegistryId& ItemDataRegistryId, FYcInventoryItemDefinition& OutItemDef)
+{
+	const FYcInventoryItemDefinition* ItemDef = FindItemDefinition(ItemDataRegistryId);
+	if (!ItemDef)
+	{
+		return false;
+	}
+	
+	OutItemDef = *ItemDef;
+	return true;
+}
+
+const FYcInventoryItemDefinition* UYcInventoryLibrary::FindItemDefinition(const FDataRegistryId& ItemDataRegistryId)
 {
 	// 验证ItemRegistryId有效性
 	if (!ItemDataRegistryId.IsValid())
 	{
-		UE_LOG(LogYcInventory, Error, TEXT("UYcInventoryLibrary::GetItemDefinition - ItemRegistryId is invalid."));
-		return false;
+		UE_LOG(LogYcInventory, Error, TEXT("UYcInventoryLibrary::FindItemDefinition - ItemRegistryId is invalid."));
+		return nullptr;
 	}
 	
 	// 从DataRegistry获取物品定义
 	const UDataRegistrySubsystem* Subsystem = UDataRegistrySubsystem::Get();
 	if (!Subsystem)
 	{
-		UE_LOG(LogYcInventory, Error, TEXT("UYcInventoryLibrary::GetItemDefinition - DataRegistrySubsystem not available."));
-		return false;
+		UE_LOG(LogYcInventory, Error, TEXT("UYcInventoryLibrary::FindItemDefinition - DataRegistrySubsystem not available."));
+		return nullptr;
 	}
 	
 	// 使用模板方法直接获取类型安全的指针
 	const FYcInventoryItemDefinition* ItemDef = Subsystem->GetCachedItem<FYcInventoryItemDefinition>(ItemDataRegistryId);
 	if (!ItemDef)
 	{
-		UE_LOG(LogYcInventory, Error, TEXT("UYcInventoryLibrary::GetItemDefinition - Failed to get ItemDef from DataRegistry: %s. Make sure the item is cached/acquired first."),
+		UE_LOG(LogYcInventory, Error, TEXT("UYcInventoryLibrary::FindItemDefinition - Failed to get ItemDef from DataRegistry: %s. Make sure the item is cached/acquired first."),
 			*ItemDataRegistryId.ToString());
-		return false;
+		return nullptr;
 	}
 	
 	// 检查物品是否启用
 	if (!ItemDef->bEnableItem)
 	{
-		UE_LOG(LogYcInventory, Warning, TEXT("UYcInventoryLibrary::GetItemDefinition - Item is disabled: %s"), *ItemDef->ItemId.ToString());
-		return false;
+		UE_LOG(LogYcInventory, Warning, TEXT("UYcInventoryLibrary::FindItemDefinition - Item is disabled: %s"), *ItemDef->ItemId.ToString());
+		return nullptr;
 	}
 	
-	OutItemDef = *ItemDef;
-	return true;
+	return ItemDef;
 }
 
 void UYcInventoryLibrary::LoadItemDefDataAssetAsync(UObject* WorldContextObject,
@@ -41,8 +41,11 @@ void FYcInventoryItemList::PreReplicatedRemove(const TArrayView<int32> RemovedIn
 		FYcInventoryItemEntry& Stack = Items[Index];
 		BroadcastChangeMessage(Stack, Stack.StackCount, 0);
 		Stack.LastObservedCount = 0;
-		RemoveItemToMap_Internal(Items[Index]);
+		RemoveItemFromIndex_Internal(Stack);
 	}
+
+	// FastArray 随后以 RemoveAtSwap 移除条目，数组位置在 PostReplicatedReceive 中修正
+	bItemPositionsDirty = true;
 }
 
 void FYcInventoryItemList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
@@ -52,7 +55,7 @@ void FYcInventoryItemList::PostReplicatedAdd(const TArrayView<int32> AddedIndice
 		FYcInventoryItemEntry& Stack = Items[Index];
 		BroadcastChangeMessage(Stack, 0, Stack.StackCount);
 		Stack.LastObservedCount = Stack.StackCount;
-		AddItemToMap_Internal(Items[Index]);
+		AddItemToIndex_Internal(Index);
 		
 		// 如果物品被添加了，但是Outer还不是库存组件的Owner，那么进行更新
 		// 服务器在添加的时候就会修改Outer，但由于没有网络复制，所以借助这里为客户端同步修改Outer
@@ -71,7 +74,15 @@ void FYcInventoryItemList::PostReplicatedChange(const TArrayView<int32> ChangedI
 		check(Stack.LastObservedCount != INDEX_NONE);
 		BroadcastChangeMessage(Stack, Stack.LastObservedCount, Stack.StackCount);
 		Stack.LastObservedCount = Stack.StackCount;
-		ChangeItemToMap_Internal(Items[Index]);
+		ChangeItemInIndex_Internal(Stack);
+	}
+}
+
+void FYcInventoryItemList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (bItemPositionsDirty)
+	{
+		RefreshItemPositions_Internal();
 	}
 }
 
@@ -148,7 +159,7 @@ UYcInventoryItemInstance* FYcInventoryItemList::AddItem(const FDataRegistryId& I
 	
 	// 设置ItemRegistryId（这会触发缓存物品定义）
 	NewItemEntry.Instance->SetItemRegistryId(ItemRegistryId);
-	NewItemEntry.Instance->SetItemInstId(GenerateNextItemId(NewItemEntry));
+	NewItemEntry.Instance->SetItemInstId(GenerateNextItemId(*ItemDef));
 	
 	// 从ItemDef中获取所有的Fragment，遍历调用Fragment->OnInstanceCreated通知
 	for (const auto& Fragment : ItemDef->Fragments)
@@ -161,7 +172,7 @@ UYcInventoryItemInstance* FYcInventoryItemList::AddItem(const FDataRegistryId& I
 	}
 	
 	NewItemEntry.StackCount = StackCount;
-	AddItemToMap_Internal(NewItemEntry);
+	AddItemToIndex_Internal(Items.Num() - 1);
 	MarkItemDirty(NewItemEntry);
 	
 	// 广播变化消息（权威端调用，客户端由FastArray辅助函数调用）
@@ -191,9 +202,11 @@ bool FYcInventoryItemList::AddItem(UYcInventoryItemInstance* Instance, const int
 		}
 	}
 	
+	EnsureUniqueItemId_Internal(Instance);
+	
 	NewItemEntry.Instance = Instance;
 	NewItemEntry.StackCount = StackCount;
-	AddItemToMap_Internal(NewItemEntry);
+	AddItemToIndex_Internal(Items.Num() - 1);
 	MarkItemDirty(NewItemEntry);
 	BroadcastChangeMessage(NewItemEntry, 0, NewItemEntry.StackCount);
 	
@@ -202,30 +215,108 @@ bool FYcInventoryItemList::AddItem(UYcInventoryItemInstance* Instance, const int
 
 bool FYcInventoryItemList::RemoveItem(UYcInventoryItemInstance* Instance)
 {
-	for (auto ItemEntryIt = Items.CreateIterator(); ItemEntryIt; ++ItemEntryIt)
+	const FYcInventoryItemHandle Handle = FindItemHandle(Instance);
+	const FYcInventoryItemEntry* ItemEntry = GetEntry(Handle);
+	if (!ItemEntry)
 	{
-		FYcInventoryItemEntry& ItemEntry = *ItemEntryIt;
-		if (ItemEntry.Instance == Instance)
-		{
-			RemoveItemToMap_Internal(ItemEntry);
-			BroadcastChangeMessage(ItemEntry, ItemEntry.StackCount, 0);
-			ItemEntryIt.RemoveCurrent();
-			MarkArrayDirty();
-			return true;
-		}
+		return false;
 	}
-	return false;
+
+	const int32 ItemIndex = IndexSlots[Handle.Slot].ItemIndex;
+	FYcInventoryItemEntry& RemovedEntry = Items[ItemIndex];
+	RemoveItemFromIndex_Internal(RemovedEntry);
+	BroadcastChangeMessage(RemovedEntry, RemovedEntry.StackCount, 0);
+
+	// 保持顺序移除，之后的条目前移一位
+	Items.RemoveAt(ItemIndex);
+	RefreshItemPositions_Internal(ItemIndex);
+	MarkArrayDirty();
+	return true;
 }
 
 bool FYcInventoryItemList::FindItemById(const FName& ItemId, FYcInventoryItemEntry& OutItemEntry)
 {
-	if (ItemId.IsNone()) return false;
-	if (!ItemsMap.Contains(ItemId)) return false;
+	const FYcInventoryItemEntry* ItemEntry = GetEntry(FindItemHandle(ItemId));
+	if (!ItemEntry) return false;
 	
-	OutItemEntry = *ItemsMap[ItemId];
+	OutItemEntry = *ItemEntry;
 	return true;
 }
 
+FYcInventoryItemHandle FYcInventoryItemList::FindItemHandle(const FName& ItemId)
+{
+	FYcInventoryItemHandle Handle;
+	if (ItemId.IsNone()) return Handle;
+
+	const int32* SlotPtr = ItemIdToSlot.Find(ItemId);
+	if (!SlotPtr && PendingIndexSlots.Num() > 0)
+	{
+		ResolvePendingIndexKeys_Internal();
+		SlotPtr = ItemIdToSlot.Find(ItemId);
+	}
+
+	if (SlotPtr)
+	{
+		Handle.Slot = *SlotPtr;
+		Handle.Generation = IndexSlots[*SlotPtr].Generation;
+	}
+	return Handle;
+}
+
+FYcInventoryItemHandle FYcInventoryItemList::FindItemHandle(const UYcInventoryItemInstance* Instance) const
+{
+	FYcInventoryItemHandle Handle;
+	if (!Instance) return Handle;
+
+	if (const int32* SlotPtr = InstanceToSlot.Find(FObjectKey(Instance)))
+	{
+		Handle.Slot = *SlotPtr;
+		Handle.Generation = IndexSlots[*SlotPtr].Generation;
+	}
+	return Handle;
+}
+
+const FYcInventoryItemEntry* FYcInventoryItemList::GetEntry(const FYcInventoryItemHandle& Handle) const
+{
+	if (!IndexSlots.IsValidIndex(Handle.Slot))
+	{
+		return nullptr;
+	}
+
+	const FIndexSlot& IndexSlot = IndexSlots[Handle.Slot];
+	if (IndexSlot.Generation != Handle.Generation || !Items.IsValidIndex(IndexSlot.ItemIndex))
+	{
+		return nullptr;
+	}
+
+	const FYcInventoryItemEntry& ItemEntry = Items[IndexSlot.ItemIndex];
+	return ItemEntry.IndexSlot == Handle.Slot ? &ItemEntry : nullptr;
+}
+
+FYcInventoryItemEntry* FYcInventoryItemList::GetEntry(const FYcInventoryItemHandle& Handle)
+{
+	return const_cast<FYcInventoryItemEntry*>(AsConst(*this).GetEntry(Handle));
+}
+
+int32 FYcInventoryItemList::GetInstanceCountByDefinition(const FName& ItemDefId)
+{
+	ResolvePendingIndexKeys_Internal();
+	const FDefinitionAggregate* Aggregate = DefinitionAggregates.Find(ItemDefId);
+	return Aggregate ? Aggregate->NumInstances : 0;
+}
+
+int32 FYcInventoryItemList::GetStackCountByDefinition(const FName& ItemDefId)
+{
+	ResolvePendingIndexKeys_Internal();
+	const FDefinitionAggregate* Aggregate = DefinitionAggregates.Find(ItemDefId);
+	return Aggregate ? Aggregate->TotalStackCount : 0;
+}
+
+void FYcInventoryItemList::MarkItemStackCountChanged(FYcInventoryItemEntry& ItemEntry)
+{
+	ChangeItemInIndex_Internal(ItemEntry);
+}
+
 void FYcInventoryItemList::BroadcastChangeMessage(const FYcInventoryItemEntry& ItemEntry, const int32 OldCount, const int32 NewCount) const
 {
 	FYcInventoryItemChangeMessage Message;
@@ -238,53 +329,214 @@ void FYcInventoryItemList::BroadcastChangeMessage(const FYcInventoryItemEntry& I
 	MessageSystem.BroadcastMessage(TAG_Yc_Inventory_Message_StackChanged, Message);
 }
 
-void FYcInventoryItemList::AddItemToMap_Internal(FYcInventoryItemEntry& Item)
+void FYcInventoryItemList::AddItemToIndex_Internal(const int32 ItemIndex)
 {
-	if (Item.Instance)
+	FYcInventoryItemEntry& Item = Items[ItemIndex];
+	if (!Item.Instance || Item.IndexSlot != INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 Slot = FreeIndexSlots.Num() > 0 ? FreeIndexSlots.Pop(EAllowShrinking::No) : IndexSlots.AddDefaulted();
+	FIndexSlot& IndexSlot = IndexSlots[Slot];
+	IndexSlot.ItemIndex = ItemIndex;
+	IndexSlot.Instance = FObjectKey(Item.Instance);
+	Item.IndexSlot = Slot;
+
+	InstanceToSlot.Add(IndexSlot.Instance, Slot);
+	ChangeItemInIndex_Internal(Item);
+}
+
+void FYcInventoryItemList::ChangeItemInIndex_Internal(FYcInventoryItemEntry& Item)
+{
+	if (Item.IndexSlot == INDEX_NONE)
+	{
+		// 客户端上Instance可能晚于条目本身到达，Add时未能登记，等Instance有效后在这里补登
+		if (Item.Instance)
+		{
+			const int32 ItemIndex = static_cast<int32>(&Item - Items.GetData());
+			if (Items.IsValidIndex(ItemIndex))
+			{
+				AddItemToIndex_Internal(ItemIndex);
+			}
+		}
+		return;
+	}
+
+	const int32 Slot = Item.IndexSlot;
+	FIndexSlot& IndexSlot = IndexSlots[Slot];
+
+	// ItemId
+	const FName ItemInstId = Item.Instance ? Item.Instance->GetItemInstId() : NAME_None;
+	if (IndexSlot.ItemInstId != ItemInstId)
+	{
+		const int32* ExistingSlot = ItemIdToSlot.Find(IndexSlot.ItemInstId);
+		if (ExistingSlot && *ExistingSlot == Slot)
+		{
+			ItemIdToSlot.Remove(IndexSlot.ItemInstId);
+		}
+		if (!ItemInstId.IsNone())
+		{
+			ItemIdToSlot.Add(ItemInstId, Slot);
+		}
+		IndexSlot.ItemInstId = ItemInstId;
+	}
+
+	// 按定义汇总（定义一旦登记不再变化，只需更新堆叠数量差值）
+	const FName DefinitionId = IndexSlot.DefinitionId.IsNone() && Item.Instance ? GetDefinitionKey(Item.Instance) : IndexSlot.DefinitionId;
+	if (DefinitionId != IndexSlot.DefinitionId)
+	{
+		FDefinitionAggregate& Aggregate = DefinitionAggregates.FindOrAdd(DefinitionId);
+		++Aggregate.NumInstances;
+		Aggregate.TotalStackCount += Item.StackCount;
+		IndexSlot.DefinitionId = DefinitionId;
+	}
+	else if (!DefinitionId.IsNone() && IndexSlot.StackCount != Item.StackCount)
+	{
+		DefinitionAggregates.FindChecked(DefinitionId).TotalStackCount += Item.StackCount - IndexSlot.StackCount;
+	}
+	IndexSlot.StackCount = Item.StackCount;
+
+	// 客户端上ItemInstance的属性可能晚于条目到达，记下来稍后补全
+	if ((ItemInstId.IsNone() || DefinitionId.IsNone()) && !PendingIndexSlots.Contains(Slot))
+	{
+		PendingIndexSlots.Add(Slot);
+	}
+}
+
+void FYcInventoryItemList::RemoveItemFromIndex_Internal(FYcInventoryItemEntry& Item)
+{
+	if (Item.IndexSlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 Slot = Item.IndexSlot;
+	FIndexSlot& IndexSlot = IndexSlots[Slot];
+
+	const int32* ExistingSlot = ItemIdToSlot.Find(IndexSlot.ItemInstId);
+	if (ExistingSlot && *ExistingSlot == Slot)
+	{
+		ItemIdToSlot.Remove(IndexSlot.ItemInstId);
+	}
+	InstanceToSlot.Remove(IndexSlot.Instance);
+
+	if (!IndexSlot.DefinitionId.IsNone())
 	{
-		ItemsMap.Add(Item.Instance->GetItemInstId(), &Item);
+		FDefinitionAggregate& Aggregate = DefinitionAggregates.FindChecked(IndexSlot.DefinitionId);
+		Aggregate.TotalStackCount -= IndexSlot.StackCount;
+		if (--Aggregate.NumInstances <= 0)
+		{
+			DefinitionAggregates.Remove(IndexSlot.DefinitionId);
+		}
 	}
+
+	PendingIndexSlots.RemoveSwap(Slot, EAllowShrinking::No);
+
+	// 代数加一，旧句柄全部失效
+	const uint32 NextGeneration = IndexSlot.Generation + 1;
+	IndexSlot = FIndexSlot();
+	IndexSlot.Generation = NextGeneration;
+	FreeIndexSlots.Add(Slot);
+
+	Item.IndexSlot = INDEX_NONE;
 }
 
-void FYcInventoryItemList::ChangeItemToMap_Internal(FYcInventoryItemEntry& Item)
+void FYcInventoryItemList::RefreshItemPositions_Internal(const int32 FirstIndex)
 {
-	if (Item.Instance)
+	for (int32 ItemIndex = FirstIndex; ItemIndex < Items.Num(); ++ItemIndex)
 	{
-		ItemsMap[Item.Instance->GetItemInstId()] = &Item;
+		const int32 Slot = Items[ItemIndex].IndexSlot;
+		if (Slot != INDEX_NONE)
+		{
+			IndexSlots[Slot].ItemIndex = ItemIndex;
+		}
 	}
+	bItemPositionsDirty = false;
 }
 
-void FYcInventoryItemList::RemoveItemToMap_Internal(const FYcInventoryItemEntry& Item)
+void FYcInventoryItemList::ResolvePendingIndexKeys_Internal()
 {
-	if (Item.Instance)
+	if (PendingIndexSlots.Num() == 0)
+	{
+		return;
+	}
+
+	if (bItemPositionsDirty)
 	{
-		ItemsMap.Remove(Item.Instance->GetItemInstId());
+		RefreshItemPositions_Internal();
 	}
+
+	// ChangeItemInIndex_Internal 会把仍未补全的槽位重新加入
+	TArray<int32> Slots = MoveTemp(PendingIndexSlots);
+	PendingIndexSlots.Reset();
+	for (const int32 Slot : Slots)
+	{
+		const int32 ItemIndex = IndexSlots[Slot].ItemIndex;
+		if (Items.IsValidIndex(ItemIndex))
+		{
+			ChangeItemInIndex_Internal(Items[ItemIndex]);
+		}
+	}
+}
+
+FName FYcInventoryItemList::GetDefinitionKey(UYcInventoryItemInstance* Instance)
+{
+	// 注册ID还没有复制到时不去查询DataRegistry，避免无意义的警告
+	const FYcInventoryItemDefinition* ItemDef = (Instance->ItemDef || Instance->GetItemRegistryId().IsValid()) ? Instance->GetItemDef() : nullptr;
+	return ItemDef ? ItemDef->ItemId : NAME_None;
 }
 
-FName FYcInventoryItemList::GenerateNextItemId(const FYcInventoryItemEntry& Item) const
+FName FYcInventoryItemList::GenerateNextItemId(const FYcInventoryItemDefinition& ItemDef)
 {
-	const FYcInventoryItemDefinition* ItemDef = Item.Instance ? Item.Instance->GetItemDef() : nullptr;
-	if (!ItemDef) return NAME_None;
+	// 第一份直接使用ItemId
+	if (!ItemIdToSlot.Contains(ItemDef.ItemId))
+	{
+		return ItemDef.ItemId;
+	}
 	
-	FName NextItemId = ItemDef->ItemId;
-	int32 Attempts = 0;
-	const int32 MaxAttempts = 1000; // 防止无限循环
+	if (ItemIdSalt == 0)
+	{
+		// 只依赖名称，同一关卡中的同一库存每次得到相同的盐值
+		const AActor* OwningActor = OwnerComponent ? OwnerComponent->GetOwner() : nullptr;
+		ItemIdSalt = HashCombine(GetTypeHash(GetFNameSafe(OwningActor)), GetTypeHash(GetFNameSafe(OwnerComponent))) & MaxItemIdSuffix;
+		ItemIdSalt = FMath::Max(ItemIdSalt, 1u);
+	}
 	
-	while (Attempts < MaxAttempts)
+	// 序号单调递增，只有物品从其他库存转移过来时才可能撞上，此时继续取下一个即可
+	for (;;)
 	{
-		if (!ItemsMap.Contains(NextItemId))
+		const uint32 Suffix = (ItemIdSalt + NextItemSerial++) & MaxItemIdSuffix;
+		if (Suffix == NAME_NO_NUMBER_INTERNAL)
+		{
+			continue;
+		}
+		
+		const FName NextItemId(ItemDef.ItemId, static_cast<int32>(Suffix));
+		if (!ItemIdToSlot.Contains(NextItemId))
 		{
 			return NextItemId;
 		}
-		const int32 AppendNo = FMath::Rand();
-		NextItemId = FName(*FString::Printf(TEXT("%s_%d"), *ItemDef->ItemId.ToString(), AppendNo));
-		++Attempts;
+	}
+}
+
+void FYcInventoryItemList::EnsureUniqueItemId_Internal(UYcInventoryItemInstance* Instance)
+{
+	const FName CurrentId = Instance->GetItemInstId();
+	if (!CurrentId.IsNone() && !ItemIdToSlot.Contains(CurrentId))
+	{
+		return;
+	}
+	
+	const FYcInventoryItemDefinition* ItemDef = Instance->GetItemDef();
+	if (!ItemDef)
+	{
+		UE_LOG(LogYcInventory, Warning, TEXT("FYcInventoryItemList::EnsureUniqueItemId_Internal - ItemDef unavailable, keep ItemInstId: %s"),
+			*CurrentId.ToString());
+		return;
 	}
 	
-	UE_LOG(LogYcInventory, Error, TEXT("FYcInventoryItemList::GenerateNextItemId - Failed to generate unique ID after %d attempts for: %s"),
-		MaxAttempts, *ItemDef->ItemId.ToString());
-	return NAME_None;
+	Instance->SetItemInstId(GenerateNextItemId(*ItemDef));
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -384,41 +636,32 @@ bool UYcInventoryManagerComponent::ConsumeItemInstance(UYcInventoryItemInstance*
 		return false;
 	}
 	
-	// @TODO 如果物品数量会很多的话这里还可以做一下性能优化
-	for (FYcInventoryItemEntry& ItemEntry : ItemList.Items)
+	FYcInventoryItemEntry* ItemEntry = ItemList.GetEntry(ItemList.FindItemHandle(ItemInstance));
+	if (!ItemEntry || ItemEntry->StackCount < StackCount)
 	{
-		if (ItemEntry.Instance != ItemInstance)
-		{
-			continue;
-		}
-
-		if (ItemEntry.StackCount < StackCount)
-		{
-			return false;
-		}
-
-		const int32 OldCount = ItemEntry.StackCount;
-		ItemEntry.StackCount -= StackCount;
+		return false;
+	}
 
-		if (ItemEntry.StackCount > 0)
-		{
-			ItemEntry.LastObservedCount = OldCount;
-			ItemList.MarkItemDirty(ItemEntry);
-			ItemList.BroadcastChangeMessage(ItemEntry, OldCount, ItemEntry.StackCount);
-			return true;
-		}
+	const int32 OldCount = ItemEntry->StackCount;
+	ItemEntry->StackCount -= StackCount;
 
-		// 剩余为0，走完整移除流程，确保FastArray与子对象复制状态一致。
-		ItemEntry.StackCount = 0;
-		const bool bRemoved = ItemList.RemoveItem(ItemInstance);
-		if (bRemoved && IsUsingRegisteredSubObjectList())
-		{
-			RemoveReplicatedSubObject(ItemInstance);
-		}
-		return bRemoved;
+	if (ItemEntry->StackCount > 0)
+	{
+		ItemEntry->LastObservedCount = OldCount;
+		ItemList.MarkItemStackCountChanged(*ItemEntry);
+		ItemList.MarkItemDirty(*ItemEntry);
+		ItemList.BroadcastChangeMessage(*ItemEntry, OldCount, ItemEntry->StackCount);
+		return true;
 	}
 
-	return false;
+	// 剩余为0，走完整移除流程，确保FastArray与子对象复制状态一致。
+	ItemEntry->StackCount = 0;
+	const bool bRemoved = ItemList.RemoveItem(ItemInstance);
+	if (bRemoved && IsUsingRegisteredSubObjectList())
+	{
+		RemoveReplicatedSubObject(ItemInstance);
+	}
+	return bRemoved;
 }
 
 UYcInventoryManagerComponent* UYcInventoryManagerComponent::FindInventoryManager(const AActor* Actor)
@@ -515,40 +758,45 @@ TArray<UYcInventoryItemInstance*> UYcInventoryManagerComponent::GetAllItemInstan
 
 UYcInventoryItemInstance* UYcInventoryManagerComponent::FindFirstItemInstByDefinition(const FYcInventoryItemDefinition& ItemDef) const
 {
-	const FYcInventoryItemEntry* const* ItemEntry = ItemList.ItemsMap.Find(ItemDef.ItemId);
-	if (ItemEntry == nullptr) return nullptr;
-	return (*ItemEntry)->Instance;
-}
-
-int32 UYcInventoryManagerComponent::GetTotalItemCountByDefinition(const FYcInventoryItemDefinition& ItemDef)
-{
-	int32 TotalCount = 0;
-	for (const FYcInventoryItemEntry& ItemEntry : ItemList.Items)
+	// 第一份实例直接占用定义的ItemId，通常一次查表即可命中
+	if (const int32* SlotPtr = ItemList.ItemIdToSlot.Find(ItemDef.ItemId))
 	{
-		if (IsValid(ItemEntry.Instance))
+		const int32 ItemIndex = ItemList.IndexSlots[*SlotPtr].ItemIndex;
+		if (ItemList.Items.IsValidIndex(ItemIndex))
 		{
-			const FYcInventoryItemDefinition* EntryItemDef = ItemEntry.Instance->GetItemDef();
-			if (EntryItemDef && EntryItemDef->ItemId == ItemDef.ItemId)
-			{
-				++TotalCount;
-			}
+			return ItemList.Items[ItemIndex].Instance;
 		}
 	}
-	return TotalCount;
-}
 
-int32 UYcInventoryManagerComponent::GetStackCountByItemInstance(const UYcInventoryItemInstance* ItemInstance) const
-{
-	for (const FYcInventoryItemEntry& ItemEntry : ItemList.Items)
+	// 第一份已被移除但仍有其他实例时按索引登记的定义查找
+	if (!ItemList.DefinitionAggregates.Contains(ItemDef.ItemId))
 	{
-		const UYcInventoryItemInstance* Instance = ItemEntry.Instance;
+		return nullptr;
+	}
 
-		if (IsValid(Instance) && ItemInstance == Instance)
+	for (const FYcInventoryItemEntry& ItemEntry : ItemList.Items)
+	{
+		if (ItemEntry.IndexSlot != INDEX_NONE && ItemList.IndexSlots[ItemEntry.IndexSlot].DefinitionId == ItemDef.ItemId)
 		{
-			return ItemEntry.StackCount;
+			return ItemEntry.Instance;
 		}
 	}
-	return 0;
+	return nullptr;
+}
+
+int32 UYcInventoryManagerComponent::GetTotalItemCountByDefinition(const FYcInventoryItemDefinition& ItemDef)
+{
+	return ItemList.GetInstanceCountByDefinition(ItemDef.ItemId);
+}
+
+int32 UYcInventoryManagerComponent::GetTotalStackCountByDefinition(const FYcInventoryItemDefinition& ItemDef)
+{
+	return ItemList.GetStackCountByDefinition(ItemDef.ItemId);
+}
+
+int32 UYcInventoryManagerComponent::GetStackCountByItemInstance(const UYcInventoryItemInstance* ItemInstance) const
+{
+	return GetStackCountByHandle(ItemList.FindItemHandle(ItemInstance));
 }
 
 bool UYcInventoryManagerComponent::FindItemById(const FName& ItemId, FYcInventoryItemEntry& OutItemEntry)
@@ -556,6 +804,23 @@ bool UYcInventoryManagerComponent::FindItemById(const FName& ItemId, FYcInventor
 	return ItemList.FindItemById(ItemId, OutItemEntry);
 }
 
+FYcInventoryItemHandle UYcInventoryManagerComponent::FindItemHandle(const FName& ItemId)
+{
+	return ItemList.FindItemHandle(ItemId);
+}
+
+UYcInventoryItemInstance* UYcInventoryManagerComponent::GetItemInstanceByHandle(const FYcInventoryItemHandle& Handle) const
+{
+	const FYcInventoryItemEntry* ItemEntry = ItemList.GetEntry(Handle);
+	return ItemEntry ? ItemEntry->Instance : nullptr;
+}
+
+int32 UYcInventoryManagerComponent::GetStackCountByHandle(const FYcInventoryItemHandle& Handle) const
+{
+	const FYcInventoryItemEntry* ItemEntry = ItemList.GetEntry(Handle);
+	return ItemEntry && IsValid(ItemEntry->Instance) ? ItemEntry->StackCount : 0;
+}
+
 bool UYcInventoryManagerComponent::ConsumeItemsByDefinition(const FYcInventoryItemDefinition& ItemDef, const int32 NumToConsume)
 {
 	AActor* OwningActor = GetOwner();
@@ -565,7 +830,7 @@ bool UYcInventoryManagerComponent::ConsumeItemsByDefinition(const FYcInventoryIt
 	}
 	
 	// @TODO 目前的实现方式并没有去消耗物品的StackCount,而是直接移除了物品
-	// 这里时间复杂度为O(n), 因为FindFirstItemStackByDefinition我们使用哈希表优化为了O(1)
+	// FindFirstItemInstByDefinition 通常一次查表即可命中
 	int32 TotalConsumed = 0;
 	while (TotalConsumed < NumToConsume)
 	{
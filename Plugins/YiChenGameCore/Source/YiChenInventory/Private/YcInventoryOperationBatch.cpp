@@ -0,0 +1,418 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcInventoryOperationBatch.h"
+
+#include "YcInventoryItemInstance.h"
+#include "YcInventoryManagerComponent.h"
+#include "YcInventoryOperationRouterComponent.h"
+#include "UObject/CoreNet.h"
+#include "GameFramework/Actor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcInventoryOperationBatch)
+
+namespace YcInventoryOperationBatch
+{
+	/** 常用 OpType 的操作码，Custom 表示使用批次内的名称表 */
+	enum class EOpCode : uint32
+	{
+		Custom,
+		InventorySwapGrid,
+		EquipmentEquip,
+		EquipmentUnequip,
+		QuickBarAdd,
+		QuickBarRemove,
+		Count
+	};
+
+	const FName& GetOpTypeName(const EOpCode Code)
+	{
+		static const FName Names[] =
+		{
+			NAME_None,
+			FName(TEXT("Inventory.SwapGrid")),
+			FName(TEXT("Equipment.Equip")),
+			FName(TEXT("Equipment.Unequip")),
+			FName(TEXT("QuickBar.Add")),
+			FName(TEXT("QuickBar.Remove")),
+		};
+		static_assert(UE_ARRAY_COUNT(Names) == static_cast<uint32>(EOpCode::Count), "OpCode name table out of date");
+		return Names[static_cast<uint32>(Code)];
+	}
+
+	EOpCode FindOpCode(const FName OpType)
+	{
+		for (uint32 Code = 1; Code < static_cast<uint32>(EOpCode::Count); ++Code)
+		{
+			if (GetOpTypeName(static_cast<EOpCode>(Code)) == OpType)
+			{
+				return static_cast<EOpCode>(Code);
+			}
+		}
+		return EOpCode::Custom;
+	}
+
+	/** 写入/读取 1 位，返回流中的值 */
+	bool SerializeBit(FArchive& Ar, const bool bValue)
+	{
+		uint8 Bit = bValue ? 1 : 0;
+		Ar.SerializeBits(&Bit, 1);
+		return Bit != 0;
+	}
+
+	/** 有符号数按 ZigZag 编码后写入变长整数，小的正负值都只占一个字节 */
+	void SerializeSignedPacked(FArchive& Ar, int32& Value)
+	{
+		uint32 Encoded = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+		Ar.SerializeIntPacked(Encoded);
+		if (Ar.IsLoading())
+		{
+			Value = static_cast<int32>(Encoded >> 1) ^ -static_cast<int32>(Encoded & 1);
+		}
+	}
+
+	void SerializeSignedPacked64(FArchive& Ar, int64& Value)
+	{
+		uint64 Encoded = (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63);
+		Ar.SerializeIntPacked64(Encoded);
+		if (Ar.IsLoading())
+		{
+			Value = static_cast<int64>(Encoded >> 1) ^ -static_cast<int64>(Encoded & 1);
+		}
+	}
+
+	/** 可选字段掩码 */
+	enum EOptionalField : uint8
+	{
+		Field_StackCount = 1 << 0,
+		Field_GridTile = 1 << 1,
+		Field_Rotated = 1 << 2,
+		Field_SlotTag = 1 << 3,
+		Field_SlotIndex = 1 << 4,
+		NumOptionalFieldBits = 5
+	};
+}
+
+// ==================== FYcInventoryOperationBatch ====================
+
+bool FYcInventoryOperationBatch::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	using namespace YcInventoryOperationBatch;
+
+	bOutSuccess = false;
+	if (!Map)
+	{
+		return true;
+	}
+
+	const bool bLoading = Ar.IsLoading();
+
+	uint32 NumOps = Operations.Num();
+	Ar.SerializeIntPacked(BatchId);
+	Ar.SerializeIntPacked(NumOps);
+	if (bLoading)
+	{
+		if (NumOps > static_cast<uint32>(MaxOperations))
+		{
+			Ar.SetError();
+			return true;
+		}
+		Operations.SetNum(NumOps);
+	}
+	if (NumOps == 0)
+	{
+		bOutSuccess = true;
+		return true;
+	}
+
+	// 批次内共用的时间戳
+	double ClientTimestamp = Operations[0].ClientTimestamp;
+	Ar << ClientTimestamp;
+
+	// 对象表：批次内出现的对象只发送一次，索引 0 表示空
+	TArray<UObject*> ObjectTable;
+	TMap<const UObject*, uint32> ObjectIndices;
+	TArray<FName> CustomOpTypes;
+	if (!bLoading)
+	{
+		auto AddObject = [&ObjectTable, &ObjectIndices](UObject* Object)
+		{
+			if (Object && !ObjectIndices.Contains(Object))
+			{
+				ObjectIndices.Add(Object, ObjectTable.Add(Object) + 1);
+			}
+		};
+		for (const FYcInventoryOperation& Op : Operations)
+		{
+			AddObject(Op.RequestActor);
+			AddObject(Op.RequestInventory);
+			AddObject(Op.SourceInventory);
+			AddObject(Op.TargetInventory);
+			AddObject(Op.ItemInstance);
+			if (FindOpCode(Op.OpType) == EOpCode::Custom)
+			{
+				CustomOpTypes.AddUnique(Op.OpType);
+			}
+		}
+	}
+
+	uint32 NumObjects = ObjectTable.Num();
+	Ar.SerializeIntPacked(NumObjects);
+	if (bLoading)
+	{
+		if (NumObjects > NumOps * 5)
+		{
+			Ar.SetError();
+			return true;
+		}
+		ObjectTable.SetNumZeroed(NumObjects);
+	}
+	for (UObject*& Object : ObjectTable)
+	{
+		Map->SerializeObject(Ar, UObject::StaticClass(), Object);
+	}
+
+	uint32 NumCustomOpTypes = CustomOpTypes.Num();
+	Ar.SerializeIntPacked(NumCustomOpTypes);
+	if (bLoading)
+	{
+		if (NumCustomOpTypes > NumOps)
+		{
+			Ar.SetError();
+			return true;
+		}
+		CustomOpTypes.SetNum(NumCustomOpTypes);
+	}
+	for (FName& OpTypeName : CustomOpTypes)
+	{
+		Ar << OpTypeName;
+	}
+
+	// 对象引用：与上一条相同时只写 1 位，否则写表索引
+	auto SerializeObjectRef = [&](UObject* Object, uint32& PrevIndex) -> UObject*
+	{
+		uint32 Index = (!bLoading && Object) ? ObjectIndices.FindChecked(Object) : 0;
+		if (SerializeBit(Ar, Index == PrevIndex))
+		{
+			Index = PrevIndex;
+		}
+		else
+		{
+			Ar.SerializeIntPacked(Index);
+		}
+		PrevIndex = Index;
+		return (Index > 0 && Index <= NumObjects) ? ObjectTable[Index - 1] : nullptr;
+	};
+
+	int64 PrevOpId = 0;
+	int32 PrevBaseRevision = 0;
+	uint32 PrevRequestActor = 0;
+	uint32 PrevRequestInventory = 0;
+	uint32 PrevSourceInventory = 0;
+	uint32 PrevTargetInventory = 0;
+	int32 PrevItemIndex = 0;
+
+	for (FYcInventoryOperation& Op : Operations)
+	{
+		// 操作码
+		uint32 OpCode = static_cast<uint32>(FindOpCode(Op.OpType));
+		Ar.SerializeInt(OpCode, static_cast<uint32>(EOpCode::Count));
+		if (OpCode == static_cast<uint32>(EOpCode::Custom))
+		{
+			uint32 NameIndex = bLoading ? 0 : CustomOpTypes.IndexOfByKey(Op.OpType);
+			Ar.SerializeIntPacked(NameIndex);
+			if (bLoading)
+			{
+				Op.OpType = CustomOpTypes.IsValidIndex(NameIndex) ? CustomOpTypes[NameIndex] : NAME_None;
+			}
+		}
+		else if (bLoading)
+		{
+			Op.OpType = OpCode < static_cast<uint32>(EOpCode::Count) ? GetOpTypeName(static_cast<EOpCode>(OpCode)) : NAME_None;
+		}
+		if (bLoading)
+		{
+			// 只查找已注册的 OpType，客户端发来的未知名称不会进入驻留表
+			Op.OpTypeIndex = UYcInventoryOperationRouterComponent::FindOperationTypeIndex(Op.OpType);
+		}
+
+		// OpId / BaseRevision 按差值编码，连续提交时通常只占一个字节
+		int64 OpIdDelta = Op.OpId - PrevOpId;
+		SerializeSignedPacked64(Ar, OpIdDelta);
+		int32 BaseRevisionDelta = Op.BaseRevision - PrevBaseRevision;
+		SerializeSignedPacked(Ar, BaseRevisionDelta);
+		if (bLoading)
+		{
+			Op.OpId = PrevOpId + OpIdDelta;
+			Op.BaseRevision = PrevBaseRevision + BaseRevisionDelta;
+			Op.ClientTimestamp = ClientTimestamp;
+		}
+		PrevOpId = Op.OpId;
+		PrevBaseRevision = Op.BaseRevision;
+
+		// 请求者与库存引用
+		UObject* RequestActor = SerializeObjectRef(Op.RequestActor, PrevRequestActor);
+		UObject* RequestInventory = SerializeObjectRef(Op.RequestInventory, PrevRequestInventory);
+		UObject* SourceInventory = SerializeObjectRef(Op.SourceInventory, PrevSourceInventory);
+		UObject* TargetInventory = SerializeObjectRef(Op.TargetInventory, PrevTargetInventory);
+
+		// 物品引用：批量操作中物品通常按出现顺序排列，索引差值多为 +1
+		int32 ItemIndex = (!bLoading && Op.ItemInstance) ? static_cast<int32>(ObjectIndices.FindChecked(Op.ItemInstance)) : 0;
+		int32 ItemIndexDelta = ItemIndex - PrevItemIndex;
+		SerializeSignedPacked(Ar, ItemIndexDelta);
+		ItemIndex = PrevItemIndex + ItemIndexDelta;
+		PrevItemIndex = ItemIndex;
+
+		if (bLoading)
+		{
+			Op.RequestActor = Cast<AActor>(RequestActor);
+			Op.RequestInventory = Cast<UYcInventoryManagerComponent>(RequestInventory);
+			Op.SourceInventory = Cast<UYcInventoryManagerComponent>(SourceInventory);
+			Op.TargetInventory = Cast<UYcInventoryManagerComponent>(TargetInventory);
+			Op.ItemInstance = (ItemIndex > 0 && ItemIndex <= static_cast<int32>(NumObjects)) ? Cast<UYcInventoryItemInstance>(ObjectTable[ItemIndex - 1]) : nullptr;
+		}
+
+		// 可选字段：等于默认值时不发送
+		uint8 Fields = 0;
+		if (!bLoading)
+		{
+			Fields |= Op.StackCount != 1 ? Field_StackCount : 0;
+			Fields |= Op.GridTile != FIntPoint::ZeroValue ? Field_GridTile : 0;
+			Fields |= Op.bRotated ? Field_Rotated : 0;
+			Fields |= Op.SlotTag.IsValid() ? Field_SlotTag : 0;
+			Fields |= Op.SlotIndex != INDEX_NONE ? Field_SlotIndex : 0;
+		}
+		Ar.SerializeBits(&Fields, NumOptionalFieldBits);
+
+		if (bLoading)
+		{
+			Op.StackCount = 1;
+			Op.GridTile = FIntPoint::ZeroValue;
+			Op.bRotated = (Fields & Field_Rotated) != 0;
+			Op.SlotTag = FGameplayTag();
+			Op.SlotIndex = INDEX_NONE;
+		}
+		if (Fields & Field_StackCount)
+		{
+			SerializeSignedPacked(Ar, Op.StackCount);
+		}
+		if (Fields & Field_GridTile)
+		{
+			SerializeSignedPacked(Ar, Op.GridTile.X);
+			SerializeSignedPacked(Ar, Op.GridTile.Y);
+		}
+		if (Fields & Field_SlotTag)
+		{
+			bool bTagSuccess = true;
+			Op.SlotTag.NetSerialize(Ar, Map, bTagSuccess);
+			if (!bTagSuccess)
+			{
+				Ar.SetError();
+				return true;
+			}
+		}
+		if (Fields & Field_SlotIndex)
+		{
+			SerializeSignedPacked(Ar, Op.SlotIndex);
+		}
+
+		if (Ar.IsError())
+		{
+			return true;
+		}
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+// ==================== FYcInventoryOperationBatchResult ====================
+
+void FYcInventoryOperationBatchResult::Init(const int32 NumOperations)
+{
+	AckBits.Init(false, NumOperations);
+	DeferredBits.Reset();
+	ErrorCodes.Reset();
+	Reasons.Reset();
+}
+
+bool FYcInventoryOperationBatchResult::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	using namespace YcInventoryOperationBatch;
+
+	bOutSuccess = false;
+	const bool bLoading = Ar.IsLoading();
+
+	Ar.SerializeIntPacked(BatchId);
+	SerializeSignedPacked(Ar, NewRevision);
+
+	uint32 NumOps = AckBits.Num();
+	Ar.SerializeIntPacked(NumOps);
+	if (bLoading)
+	{
+		if (NumOps > static_cast<uint32>(FYcInventoryOperationBatch::MaxOperations))
+		{
+			Ar.SetError();
+			return true;
+		}
+		Init(NumOps);
+	}
+
+	for (uint32 i = 0; i < NumOps; ++i)
+	{
+		AckBits[i] = SerializeBit(Ar, AckBits[i]);
+	}
+
+	// 延迟处理很少见，只有存在时才发送第二个位域
+	if (SerializeBit(Ar, DeferredBits.Contains(true)))
+	{
+		if (bLoading)
+		{
+			DeferredBits.Init(false, NumOps);
+		}
+		for (uint32 i = 0; i < NumOps; ++i)
+		{
+			DeferredBits[i] = SerializeBit(Ar, DeferredBits[i]);
+		}
+	}
+
+	int32 NumNacks = 0;
+	for (uint32 i = 0; i < NumOps; ++i)
+	{
+		NumNacks += (!AckBits[i] && !IsDeferred(i)) ? 1 : 0;
+	}
+
+	if (bLoading)
+	{
+		ErrorCodes.SetNum(NumNacks);
+	}
+	else if (!ensure(ErrorCodes.Num() == NumNacks))
+	{
+		ErrorCodes.SetNum(NumNacks);
+	}
+
+	for (EYcInventoryOperationErrorCode& ErrorCode : ErrorCodes)
+	{
+		uint32 Code = static_cast<uint32>(ErrorCode);
+		Ar.SerializeInt(Code, static_cast<uint32>(EYcInventoryOperationErrorCode::MAX));
+		ErrorCode = static_cast<EYcInventoryOperationErrorCode>(FMath::Min<uint32>(Code, static_cast<uint32>(EYcInventoryOperationErrorCode::Unknown)));
+	}
+
+	if (SerializeBit(Ar, NumNacks > 0 && Reasons.Num() == NumNacks))
+	{
+		if (bLoading)
+		{
+			Reasons.SetNum(NumNacks);
+		}
+		for (FString& Reason : Reasons)
+		{
+			Ar << Reason;
+		}
+	}
+	else if (bLoading)
+	{
+		Reasons.Reset();
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
@@ -0,0 +1,257 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcInventoryOperationDispatchBenchmark.h"
+
+#include "YcInventoryOperationRouterComponent.h"
+#include "YiChenInventory.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcInventoryOperationDispatchBenchmark)
+
+bool UYcInventoryDispatchBenchmarkHandler::ValidateOperation(const FYcInventoryOperation& Operation, FString& OutReason)
+{
+	return Operation.StackCount > 0;
+}
+
+bool UYcInventoryDispatchBenchmarkHandler::ExecuteOperation(const FYcInventoryOperation& Operation, FString& OutReason)
+{
+	++NumExecuted;
+	return true;
+}
+
+void UYcInventoryDispatchBenchmarkHandler::BuildOperationDelta(const FYcInventoryOperation& Operation, bool bSuccess, FYcInventoryOperationDelta& OutDelta)
+{
+}
+
+/**
+ * 库存操作分发性能对比（控制台命令）
+ *
+ * 旧路径：每次按 OpType 字符串做前缀匹配，脚本处理器每次调用都按函数名 FindFunction；
+ * 新路径：Router 的分发表 + 注册时解析好的 UFunction。
+ */
+struct FYcInventoryOperationDispatchBenchmark
+{
+	/** 改造前的解析方式：先精确匹配，再遍历全部处理器做字符串前缀匹配 */
+	static const FYcInventoryOperationHandler* LegacyResolve(const UYcInventoryOperationRouterComponent& Router, const FName& OpType)
+	{
+		if (const FYcInventoryOperationHandler* Exact = Router.RegisteredOperationHandlers.Find(OpType))
+		{
+			if (Exact->bEnabled)
+			{
+				return Exact;
+			}
+		}
+
+		const FYcInventoryOperationHandler* BestPrefix = nullptr;
+		for (const TPair<FName, FYcInventoryOperationHandler>& Pair : Router.RegisteredOperationHandlers)
+		{
+			const FYcInventoryOperationHandler& Candidate = Pair.Value;
+			if (!Candidate.bEnabled || !Candidate.bPrefixMatch)
+			{
+				continue;
+			}
+			if (!OpType.ToString().StartsWith(Pair.Key.ToString(), ESearchCase::CaseSensitive))
+			{
+				continue;
+			}
+			if (BestPrefix == nullptr || Candidate.Priority > BestPrefix->Priority)
+			{
+				BestPrefix = &Candidate;
+			}
+		}
+		return BestPrefix;
+	}
+
+	/** 改造前的脚本处理器：每次调用都按函数名查找 UFunction */
+	static FYcInventoryOperationHandler MakeLegacyScriptHandler(UObject* HandlerObject, const bool bPrefixMatch, const int32 Priority)
+	{
+		const TWeakObjectPtr<UObject> WeakHandlerObject(HandlerObject);
+		auto CallByName = [WeakHandlerObject](const FName FunctionName, const FYcInventoryOperation& Op, FString& OutReason)
+		{
+			UObject* TargetObject = WeakHandlerObject.Get();
+			UFunction* Function = IsValid(TargetObject) ? TargetObject->FindFunction(FunctionName) : nullptr;
+			if (!Function)
+			{
+				return false;
+			}
+
+			struct FParams
+			{
+				FYcInventoryOperation Operation;
+				FString OutReason;
+				bool ReturnValue;
+			};
+
+			FParams Params;
+			Params.Operation = Op;
+			Params.ReturnValue = false;
+			TargetObject->ProcessEvent(Function, &Params);
+			OutReason = Params.OutReason;
+			return Params.ReturnValue;
+		};
+
+		FYcInventoryOperationHandler Handler;
+		Handler.bPrefixMatch = bPrefixMatch;
+		Handler.Priority = Priority;
+		Handler.Validate.BindLambda([CallByName](const FYcInventoryOperation& Op, FString& OutReason)
+		{
+			return CallByName(GET_FUNCTION_NAME_CHECKED(UYcInventoryDispatchBenchmarkHandler, ValidateOperation), Op, OutReason);
+		});
+		Handler.Execute.BindLambda([CallByName](const FYcInventoryOperation& Op, FString& OutReason)
+		{
+			return CallByName(GET_FUNCTION_NAME_CHECKED(UYcInventoryDispatchBenchmarkHandler, ExecuteOperation), Op, OutReason);
+		});
+		return Handler;
+	}
+
+	/** 两个 Router 注册同样的一组处理器：原生精确匹配、脚本精确/前缀匹配，以及一批不会命中的前缀 */
+	static void RegisterHandlers(UYcInventoryOperationRouterComponent& Router, UYcInventoryDispatchBenchmarkHandler* ScriptHandler, const bool bLegacy, int32& NativeCounter)
+	{
+		FYcInventoryOperationHandler NativeHandler;
+		NativeHandler.Validate.BindLambda([](const FYcInventoryOperation& Op, FString& OutReason) { return Op.StackCount > 0; });
+		NativeHandler.Execute.BindLambda([&NativeCounter](const FYcInventoryOperation& Op, FString& OutReason) { ++NativeCounter; return true; });
+		Router.RegisterOperationHandler(TEXT("Equipment.Equip"), NativeHandler);
+		Router.RegisterOperationHandler(TEXT("Equipment.Unequip"), NativeHandler);
+		Router.RegisterOperationHandler(TEXT("QuickBar.Add"), NativeHandler);
+		Router.RegisterOperationHandler(TEXT("QuickBar.Remove"), NativeHandler);
+
+		const FName ValidateName = GET_FUNCTION_NAME_CHECKED(UYcInventoryDispatchBenchmarkHandler, ValidateOperation);
+		const FName ExecuteName = GET_FUNCTION_NAME_CHECKED(UYcInventoryDispatchBenchmarkHandler, ExecuteOperation);
+		const FName BuildDeltaName = GET_FUNCTION_NAME_CHECKED(UYcInventoryDispatchBenchmarkHandler, BuildOperationDelta);
+		auto RegisterScript = [&](const TCHAR* Key, const bool bPrefixMatch, const int32 Priority)
+		{
+			if (bLegacy)
+			{
+				Router.RegisterOperationHandler(Key, MakeLegacyScriptHandler(ScriptHandler, bPrefixMatch, Priority));
+			}
+			else
+			{
+				Router.RegisterScriptOperationHandler(Key, ScriptHandler, ValidateName, ExecuteName, BuildDeltaName, bPrefixMatch, Priority);
+			}
+		};
+		RegisterScript(TEXT("Inventory.SwapGrid"), false, 0);
+		RegisterScript(TEXT("Container."), true, -1);
+		RegisterScript(TEXT("Search."), true, -1);
+
+		FYcInventoryOperationHandler DecoyHandler;
+		DecoyHandler.bPrefixMatch = true;
+		for (int32 i = 0; i < 8; ++i)
+		{
+			Router.RegisterOperationHandler(FName(*FString::Printf(TEXT("Plugin%d."), i)), DecoyHandler);
+		}
+	}
+
+	static void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumOps = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		AActor* Actor = World->SpawnActor<AActor>(SpawnParams);
+		if (!Actor)
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.BenchmarkOperationDispatch: 无法生成测试Actor"));
+			return;
+		}
+
+		UYcInventoryDispatchBenchmarkHandler* LegacyScriptHandler = NewObject<UYcInventoryDispatchBenchmarkHandler>(Actor);
+		UYcInventoryDispatchBenchmarkHandler* CompiledScriptHandler = NewObject<UYcInventoryDispatchBenchmarkHandler>(Actor);
+		UYcInventoryOperationRouterComponent* LegacyRouter = NewObject<UYcInventoryOperationRouterComponent>(Actor);
+		UYcInventoryOperationRouterComponent* CompiledRouter = NewObject<UYcInventoryOperationRouterComponent>(Actor);
+
+		int32 LegacyNativeCount = 0;
+		int32 CompiledNativeCount = 0;
+		RegisterHandlers(*LegacyRouter, LegacyScriptHandler, true, LegacyNativeCount);
+		RegisterHandlers(*CompiledRouter, CompiledScriptHandler, false, CompiledNativeCount);
+
+		// 混合操作：原生精确、脚本精确、脚本前缀、未注册
+		const FName OpTypes[] =
+		{
+			TEXT("Inventory.SwapGrid"), TEXT("Container.Take"), TEXT("Container.Put"), TEXT("Search.Open"),
+			TEXT("Equipment.Equip"), TEXT("Equipment.Unequip"), TEXT("QuickBar.Add"), TEXT("Unknown.Operation"),
+		};
+		TArray<FYcInventoryOperation> Operations;
+		Operations.SetNum(UE_ARRAY_COUNT(OpTypes));
+		for (int32 i = 0; i < Operations.Num(); ++i)
+		{
+			// 与收到操作时一样只解析一次分发下标
+			Operations[i].OpType = OpTypes[i];
+			Operations[i].OpTypeIndex = UYcInventoryOperationRouterComponent::FindOperationTypeIndex(OpTypes[i]);
+		}
+
+		auto Dispatch = [](const FYcInventoryOperationHandler* Handler, const FYcInventoryOperation& Op)
+		{
+			if (!Handler)
+			{
+				return false;
+			}
+			FString Reason;
+			if (Handler->Validate.IsBound() && !Handler->Validate.Execute(Op, Reason))
+			{
+				return false;
+			}
+			return Handler->Execute.IsBound() && Handler->Execute.Execute(Op, Reason);
+		};
+
+		int32 LegacySucceeded = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumOps; ++i)
+		{
+			const FYcInventoryOperation& Op = Operations[i % Operations.Num()];
+			LegacySucceeded += Dispatch(LegacyResolve(*LegacyRouter, Op.OpType), Op) ? 1 : 0;
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - StartTime;
+
+		int32 CompiledSucceeded = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumOps; ++i)
+		{
+			const FYcInventoryOperation& Op = Operations[i % Operations.Num()];
+			CompiledSucceeded += Dispatch(CompiledRouter->ResolveOperationHandler(Op), Op) ? 1 : 0;
+		}
+		const double CompiledSeconds = FPlatformTime::Seconds() - StartTime;
+
+		// 只比较解析部分
+		int32 LegacyResolved = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumOps; ++i)
+		{
+			LegacyResolved += LegacyResolve(*LegacyRouter, Operations[i % Operations.Num()].OpType) ? 1 : 0;
+		}
+		const double LegacyResolveSeconds = FPlatformTime::Seconds() - StartTime;
+
+		int32 CompiledResolved = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumOps; ++i)
+		{
+			CompiledResolved += CompiledRouter->ResolveOperationHandler(Operations[i % Operations.Num()]) ? 1 : 0;
+		}
+		const double CompiledResolveSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const bool bConsistent = LegacySucceeded == CompiledSucceeded && LegacyResolved == CompiledResolved
+			&& LegacyNativeCount == CompiledNativeCount && LegacyScriptHandler->NumExecuted == CompiledScriptHandler->NumExecuted;
+
+		Actor->Destroy();
+
+		UE_LOG(LogYcInventory, Display, TEXT("Yc.Inventory.BenchmarkOperationDispatch: %d 次混合操作，结果%s"), NumOps, bConsistent ? TEXT("一致") : TEXT("不一致"));
+		UE_LOG(LogYcInventory, Display, TEXT("  完整分发: 旧 %.2f ms / 新 %.2f ms (%.1fx)"),
+			LegacySeconds * 1000.0, CompiledSeconds * 1000.0, CompiledSeconds > 0.0 ? LegacySeconds / CompiledSeconds : 0.0);
+		UE_LOG(LogYcInventory, Display, TEXT("  仅解析:   旧 %.2f ms / 新 %.2f ms (%.1fx)"),
+			LegacyResolveSeconds * 1000.0, CompiledResolveSeconds * 1000.0, CompiledResolveSeconds > 0.0 ? LegacyResolveSeconds / CompiledResolveSeconds : 0.0);
+	}
+};
+
+namespace YcInventoryOperationDispatchBenchmark
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+		TEXT("Yc.Inventory.BenchmarkOperationDispatch"),
+		TEXT("库存操作分发性能对比：Yc.Inventory.BenchmarkOperationDispatch [操作数=100000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcInventoryOperationDispatchBenchmark::RunBenchmark));
+}
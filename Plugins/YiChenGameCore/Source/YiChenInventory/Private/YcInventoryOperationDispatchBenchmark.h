@@ -0,0 +1,30 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "UObject/Object.h"
+#include "YcInventoryOperationTypes.h"
+#include "YcInventoryOperationDispatchBenchmark.generated.h"
+
+/**
+ * 分发性能测试用的脚本风格处理器
+ * 以 UFUNCTION 形式提供与脚本组件相同签名的校验/执行/增量构建函数，通过函数名注册到 Router
+ */
+UCLASS(Transient)
+class UYcInventoryDispatchBenchmarkHandler : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION()
+	bool ValidateOperation(const FYcInventoryOperation& Operation, FString& OutReason);
+
+	UFUNCTION()
+	bool ExecuteOperation(const FYcInventoryOperation& Operation, FString& OutReason);
+
+	UFUNCTION()
+	void BuildOperationDelta(const FYcInventoryOperation& Operation, bool bSuccess, FYcInventoryOperationDelta& OutDelta);
+
+	/** 执行次数，用于核对两种分发路径调用次数一致 */
+	int32 NumExecuted = 0;
+};
@@ -12,6 +12,8 @@
 #include "GameFramework/Pawn.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeExit.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcInventoryOperationRouterComponent)
 
@@ -25,6 +27,85 @@ namespace
 		return OpType.ToString().StartsWith(Prefix.ToString(), ESearchCase::CaseSensitive);
 	}
 
+	/** 已注册的 OpType / 前缀 -> 驻留ID，所有 Router 共享，只在注册处理器时写入，只增不减 */
+	struct FOperationTypeTable
+	{
+		TMap<FName, int32> Ids;
+
+		/** 按驻留ID排列的名称字符串，用于前缀匹配 */
+		TArray<FString> Names;
+	};
+
+	FOperationTypeTable& GetOperationTypeTable()
+	{
+		static FOperationTypeTable OperationTypeTable;
+		return OperationTypeTable;
+	}
+
+	/**
+	 * 撤销某个 Pending 操作对一个槽位的写入
+	 * 它是最后的写入者时，槽位回退为前一个写入者的值；没有其他写入者时移除该槽位
+	 */
+	template <typename KeyType, typename FindWritesFuncType>
+	void RevertProjectedSlot(TMap<KeyType, TArray<int64>>& SlotWriters, TMap<KeyType, TObjectPtr<UYcInventoryItemInstance>>& Slots,
+		const KeyType& Key, const int64 OpId, FindWritesFuncType&& FindWrites)
+	{
+		TArray<int64>* Writers = SlotWriters.Find(Key);
+		if (!Writers)
+		{
+			return;
+		}
+
+		const bool bWasLastWriter = !Writers->IsEmpty() && Writers->Last() == OpId;
+		Writers->RemoveSingle(OpId);
+		if (Writers->IsEmpty())
+		{
+			SlotWriters.Remove(Key);
+			Slots.Remove(Key);
+		}
+		else if (bWasLastWriter)
+		{
+			Slots.Add(Key, FindWrites(Writers->Last()).FindChecked(Key));
+		}
+	}
+
+	/**
+	 * 脚本处理器的函数绑定
+	 * 注册时解析一次 UFunction，之后只在函数失效或对象的类变化（脚本热重载会重新实例化类）时重新查找
+	 */
+	struct FScriptHandlerFunction
+	{
+		TWeakObjectPtr<UObject> Object;
+		FName FunctionName;
+		TWeakObjectPtr<UFunction> Function;
+		TWeakObjectPtr<const UClass> ResolvedClass;
+
+		FScriptHandlerFunction(UObject* InObject, const FName InFunctionName)
+			: Object(InObject)
+			, FunctionName(InFunctionName)
+		{
+		}
+
+		/** 返回可调用的函数，对象或函数不存在时返回 nullptr */
+		UFunction* Resolve(UObject*& OutTarget)
+		{
+			OutTarget = Object.Get();
+			if (!IsValid(OutTarget) || FunctionName.IsNone())
+			{
+				return nullptr;
+			}
+
+			UFunction* ResolvedFunction = Function.Get();
+			if (!ResolvedFunction || ResolvedClass.Get() != OutTarget->GetClass())
+			{
+				ResolvedFunction = OutTarget->FindFunction(FunctionName);
+				Function = ResolvedFunction;
+				ResolvedClass = OutTarget->GetClass();
+			}
+			return ResolvedFunction;
+		}
+	};
+
 	AController* ResolveOwningController(const AActor* Actor)
 	{
 		if (!Actor)
@@ -58,6 +139,30 @@ namespace
 	}
 }
 
+namespace YcInventoryOperationRouter
+{
+	static bool bBatchOperations = true;
+	static FAutoConsoleVariableRef CVarBatchOperations(
+		TEXT("Yc.Inventory.OperationBatch.Enabled"),
+		bBatchOperations,
+		TEXT("客户端是否将同一帧提交的库存操作合并为一个 RPC 发送"),
+		ECVF_Default);
+
+	static bool bSendNackReasons = true;
+	static FAutoConsoleVariableRef CVarSendNackReasons(
+		TEXT("Yc.Inventory.OperationBatch.SendNackReasons"),
+		bSendNackReasons,
+		TEXT("批次回执中是否附带 Nack 的失败原因字符串（关闭时只发送错误码）"),
+		ECVF_Default);
+
+	static bool bVerifyProjectedState = false;
+	static FAutoConsoleVariableRef CVarVerifyProjectedState(
+		TEXT("Yc.Inventory.ProjectedState.Verify"),
+		bVerifyProjectedState,
+		TEXT("每次预测态变化后与按 Pending 队列完整重建的结果比对，不一致时输出错误日志（测试用，开销较大）"),
+		ECVF_Default);
+}
+
 UYcInventoryOperationRouterComponent::UYcInventoryOperationRouterComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -66,6 +171,16 @@ UYcInventoryOperationRouterComponent::UYcInventoryOperationRouterComponent(const
 	RegisterDefaultOperationHandlers();
 }
 
+void UYcInventoryOperationRouterComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(BatchFlushHandle);
+	BatchFlushHandle.Reset();
+	OutgoingBatch.Operations.Reset();
+	InFlightBatches.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 UYcInventoryOperationRouterComponent* UYcInventoryOperationRouterComponent::FindRouter(const AActor* Actor)
 {
 	if (!Actor)
@@ -139,13 +254,15 @@ int64 UYcInventoryOperationRouterComponent::SubmitInventoryOperation(UYcInventor
 	{
 		InOperation.ClientTimestamp = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
 	}
+	InOperation.OpTypeIndex = FindOperationTypeIndex(InOperation.OpType);
 
+	RevertPendingProjection(InOperation.OpId);
 	PendingOperationOrder.Remove(InOperation.OpId);
 	PendingOperations.Add(InOperation.OpId, InOperation);
 	PendingOperationOrder.Add(InOperation.OpId);
 	ProjectedOperationRevision = AuthoritativeOperationRevision + PendingOperations.Num();
 	LogOperationTrace(TEXT("Submit"), InOperation, TEXT("Submitted"));
-	RefreshProjectedStateFromAuthoritative(InOperation);
+	ApplyPendingProjection(InOperation);
 	BroadcastOperationStateMessage(EYcInventoryOperationEvent::Submitted, InOperation, TEXT("Submitted"));
 	BroadcastProjectedStateChanged(EYcInventoryOperationEvent::Submitted, InOperation);
 
@@ -157,17 +274,89 @@ int64 UYcInventoryOperationRouterComponent::SubmitInventoryOperation(UYcInventor
 	}
 	else if (bSendToServer)
 	{
-		ServerSubmitInventoryOperation(InOperation);
+		if (YcInventoryOperationRouter::bBatchOperations)
+		{
+			QueueOperationForBatch(InOperation);
+		}
+		else
+		{
+			ServerSubmitInventoryOperation(InOperation);
+		}
 	}
 
 	return InOperation.OpId;
 }
 
+TArray<int64> UYcInventoryOperationRouterComponent::SubmitInventoryOperationBatch(UYcInventoryManagerComponent* CallingInventory, const TArray<FYcInventoryOperation>& InOperations)
+{
+	TArray<int64> OpIds;
+	OpIds.Reserve(InOperations.Num());
+	for (const FYcInventoryOperation& Operation : InOperations)
+	{
+		OpIds.Add(SubmitInventoryOperation(CallingInventory, Operation, true));
+	}
+	FlushOperationBatch();
+	return OpIds;
+}
+
+void UYcInventoryOperationRouterComponent::QueueOperationForBatch(const FYcInventoryOperation& InOperation)
+{
+	OutgoingBatch.Operations.Add(InOperation);
+	if (OutgoingBatch.Operations.Num() >= FYcInventoryOperationBatch::MaxOperations)
+	{
+		FlushOperationBatch();
+		return;
+	}
+
+	// 在本帧 Actor Tick 之后、网络发送之前统一发出
+	if (!BatchFlushHandle.IsValid())
+	{
+		BatchFlushHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandleWorldPostActorTick);
+	}
+}
+
+void UYcInventoryOperationRouterComponent::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		FlushOperationBatch();
+	}
+}
+
+void UYcInventoryOperationRouterComponent::FlushOperationBatch()
+{
+	if (BatchFlushHandle.IsValid())
+	{
+		FWorldDelegates::OnWorldPostActorTick.Remove(BatchFlushHandle);
+		BatchFlushHandle.Reset();
+	}
+
+	if (OutgoingBatch.Operations.Num() == 0)
+	{
+		return;
+	}
+
+	OutgoingBatch.BatchId = NextBatchId++;
+	TArray<int64>& OpIds = InFlightBatches.Add(OutgoingBatch.BatchId);
+	OpIds.Reserve(OutgoingBatch.Operations.Num());
+	for (const FYcInventoryOperation& Operation : OutgoingBatch.Operations)
+	{
+		OpIds.Add(Operation.OpId);
+	}
+
+	ServerSubmitInventoryOperationBatch(OutgoingBatch);
+	OutgoingBatch.Operations.Reset();
+}
+
 void UYcInventoryOperationRouterComponent::ServerSubmitInventoryOperation_Implementation(const FYcInventoryOperation& InOperation)
 {
+	// 分发下标不复制，收到后在本地解析
+	FYcInventoryOperation Operation = InOperation;
+	Operation.OpTypeIndex = FindOperationTypeIndex(Operation.OpType);
+
 	int32 NewRevision = 0;
 	FString Detail;
-	switch (HandleServerSubmit(InOperation, NewRevision, Detail))
+	switch (HandleServerSubmit(Operation, NewRevision, Detail))
 	{
 	case EYcInventoryOperationProcessResult::Succeeded:
 		ClientReceiveInventoryOperationAck(InOperation.OpId, NewRevision, Detail);
@@ -183,18 +372,72 @@ void UYcInventoryOperationRouterComponent::ServerSubmitInventoryOperation_Implem
 	}
 }
 
-EYcInventoryOperationProcessResult UYcInventoryOperationRouterComponent::HandleServerSubmit(const FYcInventoryOperation& InOperation, int32& OutRevision, FString& OutDetail)
+void UYcInventoryOperationRouterComponent::ServerSubmitInventoryOperationBatch_Implementation(const FYcInventoryOperationBatch& Batch)
+{
+	ClientReceiveInventoryOperationBatchResult(HandleServerSubmitBatch(Batch));
+}
+
+FYcInventoryOperationBatchResult UYcInventoryOperationRouterComponent::HandleServerSubmitBatch(const FYcInventoryOperationBatch& Batch)
 {
+	FYcInventoryOperationBatchResult Result;
+	Result.BatchId = Batch.BatchId;
+	Result.Init(Batch.Operations.Num());
+
+	TArray<FString> Reasons;
+	for (int32 Index = 0; Index < Batch.Operations.Num(); ++Index)
+	{
+		int32 NewRevision = 0;
+		FString Detail;
+		EYcInventoryOperationErrorCode ErrorCode = EYcInventoryOperationErrorCode::None;
+		switch (HandleServerSubmit(Batch.Operations[Index], NewRevision, Detail, &ErrorCode))
+		{
+		case EYcInventoryOperationProcessResult::Succeeded:
+			Result.AckBits[Index] = true;
+			break;
+		case EYcInventoryOperationProcessResult::Deferred:
+			if (Result.DeferredBits.Num() == 0)
+			{
+				Result.DeferredBits.Init(false, Batch.Operations.Num());
+			}
+			Result.DeferredBits[Index] = true;
+			break;
+		default:
+			Result.ErrorCodes.Add(ErrorCode == EYcInventoryOperationErrorCode::None ? EYcInventoryOperationErrorCode::Unknown : ErrorCode);
+			Reasons.Add(MoveTemp(Detail));
+			break;
+		}
+	}
+
+	Result.NewRevision = AuthoritativeOperationRevision;
+	if (YcInventoryOperationRouter::bSendNackReasons)
+	{
+		Result.Reasons = MoveTemp(Reasons);
+	}
+	return Result;
+}
+
+EYcInventoryOperationProcessResult UYcInventoryOperationRouterComponent::HandleServerSubmit(const FYcInventoryOperation& InOperation, int32& OutRevision, FString& OutDetail, EYcInventoryOperationErrorCode* OutErrorCode)
+{
+	EYcInventoryOperationErrorCode ErrorCode = EYcInventoryOperationErrorCode::None;
+	ON_SCOPE_EXIT
+	{
+		if (OutErrorCode)
+		{
+			*OutErrorCode = ErrorCode;
+		}
+	};
+
 	if (!GetOwner() || !GetOwner()->HasAuthority())
 	{
 		OutRevision = AuthoritativeOperationRevision;
 		OutDetail = TEXT("ServerSubmit must run on authority.");
+		ErrorCode = EYcInventoryOperationErrorCode::NotAuthority;
 		return EYcInventoryOperationProcessResult::Failed;
 	}
 
 	FString Reason;
 	FString DeltaSummary;
-	switch (ExecuteOperationOnServer(InOperation, Reason, DeltaSummary))
+	switch (ExecuteOperationOnServer(InOperation, Reason, DeltaSummary, ErrorCode))
 	{
 	case EYcInventoryOperationProcessResult::Succeeded:
 		++AuthoritativeOperationRevision;
@@ -215,6 +458,7 @@ EYcInventoryOperationProcessResult UYcInventoryOperationRouterComponent::HandleS
 		NotifyInventoryOperationNack(InOperation.OpId, AuthoritativeOperationRevision, TEXT("Unknown operation process result."));
 		OutRevision = AuthoritativeOperationRevision;
 		OutDetail = TEXT("Unknown operation process result.");
+		ErrorCode = EYcInventoryOperationErrorCode::Unknown;
 		return EYcInventoryOperationProcessResult::Failed;
 	}
 	return EYcInventoryOperationProcessResult::Failed;
@@ -242,6 +486,7 @@ void UYcInventoryOperationRouterComponent::NotifyInventoryOperationAck(const int
 	{
 		FYcInventoryOperationDelta Delta;
 		Delta.Summary = DeltaSummary;
+		RevertPendingProjection(OpId);
 		BroadcastOperationStateMessage(EYcInventoryOperationEvent::Acked, OpCopy, DeltaSummary, &Delta);
 		BroadcastProjectedStateChanged(EYcInventoryOperationEvent::Acked, OpCopy);
 		LogOperationTrace(TEXT("Ack"), OpCopy, DeltaSummary);
@@ -262,7 +507,7 @@ void UYcInventoryOperationRouterComponent::NotifyInventoryOperationNack(const in
 		Delta.Summary = Reason;
 		BroadcastOperationStateMessage(EYcInventoryOperationEvent::Nacked, OpCopy, Reason, &Delta);
 		LogOperationTrace(TEXT("Nack"), OpCopy, Reason);
-		RebuildProjectedStateFromPending(OpId);
+		RevertPendingProjection(OpId);
 		BroadcastProjectedStateChanged(EYcInventoryOperationEvent::Nacked, OpCopy);
 	}
 }
@@ -287,7 +532,7 @@ void UYcInventoryOperationRouterComponent::HandleClientReceiveAck(const int64 Op
 
 		FYcInventoryOperationDelta Delta;
 		Delta.Summary = DeltaSummary;
-		RefreshProjectedStateFromAuthoritative(OpCopy);
+		RevertPendingProjection(OpId);
 		BroadcastOperationStateMessage(EYcInventoryOperationEvent::Acked, OpCopy, DeltaSummary, &Delta);
 		BroadcastProjectedStateChanged(EYcInventoryOperationEvent::Acked, OpCopy);
 		LogOperationTrace(TEXT("Ack"), OpCopy, DeltaSummary);
@@ -303,20 +548,111 @@ void UYcInventoryOperationRouterComponent::HandleClientReceiveNack(const int64 O
 		const FYcInventoryOperation OpCopy = *PendingOp;
 		PendingOperations.Remove(OpId);
 		PendingOperationOrder.Remove(OpId);
+		ProjectedOperationRevision = AuthoritativeOperationRevision + PendingOperations.Num();
 
 		FYcInventoryOperationDelta Delta;
 		Delta.Summary = Reason;
 		BroadcastOperationStateMessage(EYcInventoryOperationEvent::Nacked, OpCopy, Reason, &Delta);
 		LogOperationTrace(TEXT("Nack"), OpCopy, Reason);
-		RebuildProjectedStateFromPending(OpId);
+		RevertPendingProjection(OpId);
 		BroadcastProjectedStateChanged(EYcInventoryOperationEvent::Nacked, OpCopy);
 	}
 }
 
+void UYcInventoryOperationRouterComponent::ClientReceiveInventoryOperationBatchResult_Implementation(const FYcInventoryOperationBatchResult& Result)
+{
+	HandleClientReceiveBatchResult(Result);
+}
+
+void UYcInventoryOperationRouterComponent::HandleClientReceiveBatchResult(const FYcInventoryOperationBatchResult& Result)
+{
+	TArray<int64> OpIds;
+	if (!InFlightBatches.RemoveAndCopyValue(Result.BatchId, OpIds))
+	{
+		UE_LOG(LogYcInventory, Warning, TEXT("[OpBatch] Unknown batch result: batchId=%u"), Result.BatchId);
+		return;
+	}
+
+	if (OpIds.Num() != Result.AckBits.Num())
+	{
+		UE_LOG(LogYcInventory, Warning, TEXT("[OpBatch] Batch size mismatch: batchId=%u sent=%d results=%d"), Result.BatchId, OpIds.Num(), Result.AckBits.Num());
+	}
+
+	int32 NackIndex = 0;
+	const int32 NumResults = FMath::Min(OpIds.Num(), Result.AckBits.Num());
+	for (int32 Index = 0; Index < NumResults; ++Index)
+	{
+		if (Result.AckBits[Index])
+		{
+			HandleClientReceiveAck(OpIds[Index], Result.NewRevision, TEXT("Ack"));
+		}
+		else if (!Result.IsDeferred(Index))
+		{
+			const EYcInventoryOperationErrorCode ErrorCode = Result.ErrorCodes.IsValidIndex(NackIndex) ? Result.ErrorCodes[NackIndex] : EYcInventoryOperationErrorCode::Unknown;
+			const FString Reason = Result.Reasons.IsValidIndex(NackIndex) && !Result.Reasons[NackIndex].IsEmpty()
+				? Result.Reasons[NackIndex]
+				: StaticEnum<EYcInventoryOperationErrorCode>()->GetNameStringByValue(static_cast<int64>(ErrorCode));
+			++NackIndex;
+			HandleClientReceiveNack(OpIds[Index], Result.NewRevision, Reason);
+		}
+	}
+}
+
 void UYcInventoryOperationRouterComponent::RegisterDefaultOperationHandlers()
 {
 	RegisteredOperationHandlers.Reset();
 	RegisteredHandlerOwners.Reset();
+	InvalidateDispatchTable();
+}
+
+int32 UYcInventoryOperationRouterComponent::InternOperationType(const FName OpTypeOrPrefix)
+{
+	check(IsInGameThread());
+	FOperationTypeTable& Table = GetOperationTypeTable();
+	if (const int32* ExistingId = Table.Ids.Find(OpTypeOrPrefix))
+	{
+		return *ExistingId;
+	}
+	Table.Names.Add(OpTypeOrPrefix.ToString());
+	return Table.Ids.Add(OpTypeOrPrefix, Table.Ids.Num());
+}
+
+int32 UYcInventoryOperationRouterComponent::FindOperationTypeIndex(const FName OpType)
+{
+	check(IsInGameThread());
+	if (OpType.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	// 偶数下标：与驻留名称完全相同的 OpType；奇数下标：以该驻留名称为最长前缀的其他 OpType。
+	// 两者能匹配到的处理器集合各自只取决于这个驻留名称，因此可以共用分发表中的一格。
+	const FOperationTypeTable& Table = GetOperationTypeTable();
+	if (const int32* ExactId = Table.Ids.Find(OpType))
+	{
+		return *ExactId * 2;
+	}
+
+	// 所有处理器的 Key 都已驻留，没有任何驻留名称是它的前缀时不可能有处理器
+	const FString OpTypeString = OpType.ToString();
+	int32 BestId = INDEX_NONE;
+	int32 BestLength = 0;
+	for (int32 Id = 0; Id < Table.Names.Num(); ++Id)
+	{
+		const FString& Name = Table.Names[Id];
+		if (Name.Len() > BestLength && OpTypeString.StartsWith(Name, ESearchCase::CaseSensitive))
+		{
+			BestId = Id;
+			BestLength = Name.Len();
+		}
+	}
+	return BestId != INDEX_NONE ? BestId * 2 + 1 : INDEX_NONE;
+}
+
+void UYcInventoryOperationRouterComponent::InvalidateDispatchTable()
+{
+	DispatchTable.Reset();
+	DispatchResolved.Reset();
 }
 
 bool UYcInventoryOperationRouterComponent::RegisterOperationHandler(const FName& OpTypeOrPrefix, const FYcInventoryOperationHandler& Handler)
@@ -326,8 +662,10 @@ bool UYcInventoryOperationRouterComponent::RegisterOperationHandler(const FName&
 		return false;
 	}
 
+	InternOperationType(OpTypeOrPrefix);
 	RegisteredOperationHandlers.Add(OpTypeOrPrefix, Handler);
 	RegisteredHandlerOwners.Remove(OpTypeOrPrefix);
+	InvalidateDispatchTable();
 	return true;
 }
 
@@ -335,6 +673,7 @@ bool UYcInventoryOperationRouterComponent::UnregisterOperationHandler(const FNam
 {
 	const bool bRemoved = RegisteredOperationHandlers.Remove(OpTypeOrPrefix) > 0;
 	RegisteredHandlerOwners.Remove(OpTypeOrPrefix);
+	InvalidateDispatchTable();
 	return bRemoved;
 }
 
@@ -359,6 +698,10 @@ bool UYcInventoryOperationRouterComponent::UnregisterOperationHandlersByOwner(co
 		RegisteredOperationHandlers.Remove(Key);
 		RegisteredHandlerOwners.Remove(Key);
 	}
+	if (KeysToRemove.Num() > 0)
+	{
+		InvalidateDispatchTable();
+	}
 	return KeysToRemove.Num() > 0;
 }
 
@@ -369,28 +712,46 @@ bool UYcInventoryOperationRouterComponent::RegisterScriptOperationHandler(const
 		return false;
 	}
 
-	const TWeakObjectPtr<UObject> WeakHandlerObject(HandlerObject);
+	// 注册时解析函数，防止注册成功但运行时才发现函数名错误。
+	const TSharedRef<FScriptHandlerFunction> ValidateFunction = MakeShared<FScriptHandlerFunction>(HandlerObject, ValidateFunctionName);
+	const TSharedRef<FScriptHandlerFunction> ExecuteFunction = MakeShared<FScriptHandlerFunction>(HandlerObject, ExecuteFunctionName);
+	const TSharedRef<FScriptHandlerFunction> BuildDeltaFunction = MakeShared<FScriptHandlerFunction>(HandlerObject, BuildDeltaFunctionName);
+	{
+		UObject* TargetObject = nullptr;
+		if (!ValidateFunctionName.IsNone() && !ValidateFunction->Resolve(TargetObject))
+		{
+			return false;
+		}
+		if (!ExecuteFunction->Resolve(TargetObject))
+		{
+			return false;
+		}
+		if (!BuildDeltaFunctionName.IsNone() && !BuildDeltaFunction->Resolve(TargetObject))
+		{
+			return false;
+		}
+	}
+
 	FYcInventoryOperationHandler Handler;
 	Handler.bPrefixMatch = bPrefixMatch;
 	Handler.Priority = Priority;
-	Handler.Validate.BindLambda([WeakHandlerObject, ValidateFunctionName](const FYcInventoryOperation& Op, FString& OutReason)
+	Handler.Validate.BindLambda([ValidateFunction](const FYcInventoryOperation& Op, FString& OutReason)
 	{
-		UObject* TargetObject = WeakHandlerObject.Get();
+		UObject* TargetObject = nullptr;
+		UFunction* ValidateFn = ValidateFunction->Resolve(TargetObject);
 		if (!IsValid(TargetObject))
 		{
 			OutReason = TEXT("Script handler object missing.");
 			return false;
 		}
 
-		if (ValidateFunctionName.IsNone())
+		if (ValidateFunction->FunctionName.IsNone())
 		{
 			return true;
 		}
-
-		UFunction* ValidateFn = TargetObject->FindFunction(ValidateFunctionName);
 		if (!ValidateFn)
 		{
-			OutReason = FString::Printf(TEXT("Validate function not found: %s"), *ValidateFunctionName.ToString());
+			OutReason = FString::Printf(TEXT("Validate function not found: %s"), *ValidateFunction->FunctionName.ToString());
 			return false;
 		}
 
@@ -412,19 +773,18 @@ bool UYcInventoryOperationRouterComponent::RegisterScriptOperationHandler(const
 		}
 		return Params.ReturnValue;
 	});
-	Handler.Execute.BindLambda([WeakHandlerObject, ExecuteFunctionName](const FYcInventoryOperation& Op, FString& OutReason)
+	Handler.Execute.BindLambda([ExecuteFunction](const FYcInventoryOperation& Op, FString& OutReason)
 	{
-		UObject* TargetObject = WeakHandlerObject.Get();
+		UObject* TargetObject = nullptr;
+		UFunction* ExecuteFn = ExecuteFunction->Resolve(TargetObject);
 		if (!IsValid(TargetObject))
 		{
 			OutReason = TEXT("Script handler object missing.");
 			return false;
 		}
-
-		UFunction* ExecuteFn = TargetObject->FindFunction(ExecuteFunctionName);
 		if (!ExecuteFn)
 		{
-			OutReason = FString::Printf(TEXT("Execute function not found: %s"), *ExecuteFunctionName.ToString());
+			OutReason = FString::Printf(TEXT("Execute function not found: %s"), *ExecuteFunction->FunctionName.ToString());
 			return false;
 		}
 
@@ -446,20 +806,10 @@ bool UYcInventoryOperationRouterComponent::RegisterScriptOperationHandler(const
 		}
 		return Params.ReturnValue;
 	});
-	Handler.BuildDelta.BindLambda([WeakHandlerObject, BuildDeltaFunctionName](const FYcInventoryOperation& Op, bool bSuccess, FYcInventoryOperationDelta& OutDelta)
+	Handler.BuildDelta.BindLambda([BuildDeltaFunction](const FYcInventoryOperation& Op, bool bSuccess, FYcInventoryOperationDelta& OutDelta)
 	{
-		if (BuildDeltaFunctionName.IsNone())
-		{
-			return;
-		}
-
-		UObject* TargetObject = WeakHandlerObject.Get();
-		if (!IsValid(TargetObject))
-		{
-			return;
-		}
-
-		UFunction* BuildDeltaFn = TargetObject->FindFunction(BuildDeltaFunctionName);
+		UObject* TargetObject = nullptr;
+		UFunction* BuildDeltaFn = BuildDeltaFunction->Resolve(TargetObject);
 		if (!BuildDeltaFn)
 		{
 			return;
@@ -480,29 +830,10 @@ bool UYcInventoryOperationRouterComponent::RegisterScriptOperationHandler(const
 		OutDelta = Params.OutDelta;
 	});
 
-	// 预校验：防止注册成功但运行时才发现函数名错误。
-	{
-		UObject* TargetObject = WeakHandlerObject.Get();
-		if (!TargetObject)
-		{
-			return false;
-		}
-		if (!ValidateFunctionName.IsNone() && !TargetObject->FindFunction(ValidateFunctionName))
-		{
-			return false;
-		}
-		if (!TargetObject->FindFunction(ExecuteFunctionName))
-		{
-			return false;
-		}
-		if (!BuildDeltaFunctionName.IsNone() && !TargetObject->FindFunction(BuildDeltaFunctionName))
-		{
-			return false;
-		}
-	}
-
+	InternOperationType(OpTypeOrPrefix);
 	RegisteredOperationHandlers.Add(OpTypeOrPrefix, Handler);
 	RegisteredHandlerOwners.Add(OpTypeOrPrefix, HandlerObject);
+	InvalidateDispatchTable();
 	return true;
 }
 
@@ -529,7 +860,33 @@ bool UYcInventoryOperationRouterComponent::UnregisterScriptOperationHandler(cons
 	return UnregisterOperationHandler(OpTypeOrPrefix);
 }
 
-const FYcInventoryOperationHandler* UYcInventoryOperationRouterComponent::ResolveOperationHandler(const FName& OpType) const
+const FYcInventoryOperationHandler* UYcInventoryOperationRouterComponent::ResolveOperationHandler(const FYcInventoryOperation& Operation) const
+{
+	// 分发下标在提交或收到操作时已解析，这里只在注册表变化后的第一次查询时做前缀匹配
+	const int32 DispatchIndex = Operation.OpTypeIndex;
+	if (DispatchIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	if (DispatchResolved.IsValidIndex(DispatchIndex) && DispatchResolved[DispatchIndex])
+	{
+		return DispatchTable[DispatchIndex];
+	}
+
+	if (DispatchIndex >= DispatchTable.Num())
+	{
+		DispatchTable.SetNumZeroed(DispatchIndex + 1);
+		DispatchResolved.Add(false, DispatchIndex + 1 - DispatchResolved.Num());
+	}
+
+	const FYcInventoryOperationHandler* Handler = ResolveOperationHandlerUncached(Operation.OpType);
+	DispatchTable[DispatchIndex] = Handler;
+	DispatchResolved[DispatchIndex] = true;
+	return Handler;
+}
+
+const FYcInventoryOperationHandler* UYcInventoryOperationRouterComponent::ResolveOperationHandlerUncached(const FName& OpType) const
 {
 	if (const FYcInventoryOperationHandler* Exact = RegisteredOperationHandlers.Find(OpType))
 	{
@@ -591,69 +948,153 @@ bool UYcInventoryOperationRouterComponent::ExecuteOperationWithHandler(const FYc
 	return bSuccess;
 }
 
-EYcInventoryOperationProcessResult UYcInventoryOperationRouterComponent::ExecuteOperationOnServer(const FYcInventoryOperation& InOperation, FString& OutReason, FString& OutDeltaSummary)
+EYcInventoryOperationProcessResult UYcInventoryOperationRouterComponent::ExecuteOperationOnServer(const FYcInventoryOperation& InOperation, FString& OutReason, FString& OutDeltaSummary, EYcInventoryOperationErrorCode& OutErrorCode)
 {
 	if (!GetOwner() || !GetOwner()->HasAuthority())
 	{
 		OutReason = TEXT("Must execute on authority.");
+		OutErrorCode = EYcInventoryOperationErrorCode::NotAuthority;
 		return EYcInventoryOperationProcessResult::Failed;
 	}
 
 	if (InOperation.OpType.IsNone())
 	{
 		OutReason = TEXT("OpType is none.");
+		OutErrorCode = EYcInventoryOperationErrorCode::InvalidOpType;
 		return EYcInventoryOperationProcessResult::Failed;
 	}
 
-	const FYcInventoryOperationHandler* Handler = ResolveOperationHandler(InOperation.OpType);
+	const FYcInventoryOperationHandler* Handler = ResolveOperationHandler(InOperation);
 	if (!Handler)
 	{
 		OutReason = FString::Printf(TEXT("Unsupported OpType: %s"), *InOperation.OpType.ToString());
+		OutErrorCode = EYcInventoryOperationErrorCode::UnsupportedOpType;
 		return EYcInventoryOperationProcessResult::Failed;
 	}
 
 	if (!ValidateOperationWithHandler(InOperation, *Handler, OutReason))
 	{
+		OutErrorCode = EYcInventoryOperationErrorCode::Rejected;
 		return EYcInventoryOperationProcessResult::Failed;
 	}
 
 	if (!ExecuteOperationWithHandler(InOperation, *Handler, OutReason, OutDeltaSummary))
 	{
+		OutErrorCode = EYcInventoryOperationErrorCode::Rejected;
 		return EYcInventoryOperationProcessResult::Failed;
 	}
 
 	return EYcInventoryOperationProcessResult::Succeeded;
 }
 
-void UYcInventoryOperationRouterComponent::RebuildProjectedStateFromPending(int64 NackedOpId)
+void UYcInventoryOperationRouterComponent::ApplyPendingProjection(const FYcInventoryOperation& Operation)
 {
-	ProjectedState = FYcInventoryProjectedState();
-	ProjectedOperationRevision = AuthoritativeOperationRevision;
+	// 投影到空状态，得到的就是该操作写入的全部条目
+	FYcInventoryProjectedState& Writes = PendingProjections.Add(Operation.OpId);
+	ProjectOperation(Operation, Writes);
+
+	for (const TPair<FName, int32>& Pair : Writes.InventoryGridRevision)
+	{
+		ProjectedState.InventoryGridRevision.FindOrAdd(Pair.Key) += Pair.Value;
+		++GridRevisionWriterCounts.FindOrAdd(Pair.Key);
+	}
+	for (const TPair<FGameplayTag, TObjectPtr<UYcInventoryItemInstance>>& Pair : Writes.EquipmentSlots)
+	{
+		ProjectedState.EquipmentSlots.Add(Pair.Key, Pair.Value);
+		EquipmentSlotWriters.FindOrAdd(Pair.Key).Add(Operation.OpId);
+	}
+	for (const TPair<int32, TObjectPtr<UYcInventoryItemInstance>>& Pair : Writes.QuickBarSlots)
+	{
+		ProjectedState.QuickBarSlots.Add(Pair.Key, Pair.Value);
+		QuickBarSlotWriters.FindOrAdd(Pair.Key).Add(Operation.OpId);
+	}
+}
+
+void UYcInventoryOperationRouterComponent::RevertPendingProjection(const int64 OpId)
+{
+	FYcInventoryProjectedState Writes;
+	if (!PendingProjections.RemoveAndCopyValue(OpId, Writes))
+	{
+		return;
+	}
+
+	for (const TPair<FName, int32>& Pair : Writes.InventoryGridRevision)
+	{
+		int32& NumWriters = GridRevisionWriterCounts.FindChecked(Pair.Key);
+		if (--NumWriters == 0)
+		{
+			GridRevisionWriterCounts.Remove(Pair.Key);
+			ProjectedState.InventoryGridRevision.Remove(Pair.Key);
+		}
+		else
+		{
+			ProjectedState.InventoryGridRevision.FindChecked(Pair.Key) -= Pair.Value;
+		}
+	}
+	for (const TPair<FGameplayTag, TObjectPtr<UYcInventoryItemInstance>>& Pair : Writes.EquipmentSlots)
+	{
+		RevertProjectedSlot(EquipmentSlotWriters, ProjectedState.EquipmentSlots, Pair.Key, OpId,
+			[this](const int64 WriterId) -> const TMap<FGameplayTag, TObjectPtr<UYcInventoryItemInstance>>&
+			{
+				return PendingProjections.FindChecked(WriterId).EquipmentSlots;
+			});
+	}
+	for (const TPair<int32, TObjectPtr<UYcInventoryItemInstance>>& Pair : Writes.QuickBarSlots)
+	{
+		RevertProjectedSlot(QuickBarSlotWriters, ProjectedState.QuickBarSlots, Pair.Key, OpId,
+			[this](const int64 WriterId) -> const TMap<int32, TObjectPtr<UYcInventoryItemInstance>>&
+			{
+				return PendingProjections.FindChecked(WriterId).QuickBarSlots;
+			});
+	}
+}
+
+void UYcInventoryOperationRouterComponent::BuildProjectedStateFromPending(FYcInventoryProjectedState& OutState) const
+{
+	OutState = FYcInventoryProjectedState();
 	for (const int64 PendingId : PendingOperationOrder)
 	{
-		if (FYcInventoryOperation* PendingOp = PendingOperations.Find(PendingId))
+		if (const FYcInventoryOperation* PendingOp = PendingOperations.Find(PendingId))
 		{
-			++ProjectedOperationRevision;
-			RefreshProjectedStateFromAuthoritative(*PendingOp);
-			const FString Detail = FString::Printf(TEXT("ReprojectedAfterNack(%lld)"), NackedOpId);
-			BroadcastOperationStateMessage(EYcInventoryOperationEvent::Submitted, *PendingOp, Detail);
-			BroadcastProjectedStateChanged(EYcInventoryOperationEvent::Submitted, *PendingOp);
+			ProjectOperation(*PendingOp, OutState);
 		}
 	}
 }
 
-void UYcInventoryOperationRouterComponent::RefreshProjectedStateFromAuthoritative(const FYcInventoryOperation& Operation)
+bool UYcInventoryOperationRouterComponent::VerifyProjectedState(const TCHAR* Context) const
+{
+	FYcInventoryProjectedState Expected;
+	BuildProjectedStateFromPending(Expected);
+
+	const bool bGridRevisionMatches = Expected.InventoryGridRevision.OrderIndependentCompareEqual(ProjectedState.InventoryGridRevision);
+	const bool bEquipmentSlotsMatch = Expected.EquipmentSlots.OrderIndependentCompareEqual(ProjectedState.EquipmentSlots);
+	const bool bQuickBarSlotsMatch = Expected.QuickBarSlots.OrderIndependentCompareEqual(ProjectedState.QuickBarSlots);
+	if (bGridRevisionMatches && bEquipmentSlotsMatch && bQuickBarSlotsMatch)
+	{
+		return true;
+	}
+
+	UE_LOG(LogYcInventory, Error, TEXT("[ProjectedState] %s 后增量预测态与完整重建不一致：网格版本号=%s 装备槽=%s 快捷栏=%s | %s"),
+		Context,
+		bGridRevisionMatches ? TEXT("一致") : TEXT("不一致"),
+		bEquipmentSlotsMatch ? TEXT("一致") : TEXT("不一致"),
+		bQuickBarSlotsMatch ? TEXT("一致") : TEXT("不一致"),
+		*GetOperationStateSnapshot());
+	return false;
+}
+
+void UYcInventoryOperationRouterComponent::ProjectOperation(const FYcInventoryOperation& Operation, FYcInventoryProjectedState& InOutState) const
 {
 	if (Operation.TargetInventory)
 	{
-		int32& Revision = ProjectedState.InventoryGridRevision.FindOrAdd(Operation.TargetInventory->GetFName());
+		int32& Revision = InOutState.InventoryGridRevision.FindOrAdd(Operation.TargetInventory->GetFName());
 		++Revision;
 	}
-	if (const FYcInventoryOperationHandler* Handler = ResolveOperationHandler(Operation.OpType))
+	if (const FYcInventoryOperationHandler* Handler = ResolveOperationHandler(Operation))
 	{
 		if (Handler->ProjectState.IsBound())
 		{
-			Handler->ProjectState.Execute(Operation, ProjectedState);
+			Handler->ProjectState.Execute(Operation, InOutState);
 		}
 	}
 }
@@ -684,6 +1125,11 @@ void UYcInventoryOperationRouterComponent::BroadcastOperationStateMessage(const
 
 void UYcInventoryOperationRouterComponent::BroadcastProjectedStateChanged(const EYcInventoryOperationEvent Event, const FYcInventoryOperation& Operation)
 {
+	if (YcInventoryOperationRouter::bVerifyProjectedState)
+	{
+		VerifyProjectedState(*UEnum::GetValueAsString(Event));
+	}
+
 	if (!GetWorld())
 	{
 		return;
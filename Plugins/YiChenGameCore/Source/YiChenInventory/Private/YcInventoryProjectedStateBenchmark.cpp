@@ -0,0 +1,224 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcInventoryItemInstance.h"
+#include "YcInventoryManagerComponent.h"
+#include "YcInventoryOperationRouterComponent.h"
+#include "YiChenInventory.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+/**
+ * 预测态维护性能对比（控制台命令）
+ *
+ * 保持固定数量的 Pending 操作，反复随机 Nack 其中一个再提交一个新操作：
+ * 旧路径每次 Nack 都清空预测态并按 Pending 队列逐个重新投影；新路径只撤销该操作自己的写入。
+ * 旧路径 Nack 时还会为每个 Pending 操作重新广播消息，这部分开销不计入对比。
+ */
+struct FYcInventoryProjectedStateBenchmark
+{
+	struct FFixture
+	{
+		AActor* Actor = nullptr;
+		UYcInventoryOperationRouterComponent* LegacyRouter = nullptr;
+		UYcInventoryOperationRouterComponent* IncrementalRouter = nullptr;
+		TArray<UYcInventoryManagerComponent*> Inventories;
+		TArray<UYcInventoryItemInstance*> Items;
+		int64 NextOpId = 1;
+
+		static constexpr int32 NumQuickBarSlots = 10;
+
+		bool Init(UWorld* World)
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.ObjectFlags |= RF_Transient;
+			Actor = World->SpawnActor<AActor>(SpawnParams);
+			if (!Actor)
+			{
+				return false;
+			}
+
+			LegacyRouter = NewObject<UYcInventoryOperationRouterComponent>(Actor);
+			IncrementalRouter = NewObject<UYcInventoryOperationRouterComponent>(Actor);
+			RegisterHandlers(*LegacyRouter);
+			RegisterHandlers(*IncrementalRouter);
+
+			Inventories.Add(NewObject<UYcInventoryManagerComponent>(Actor, TEXT("BenchmarkInventoryA")));
+			Inventories.Add(NewObject<UYcInventoryManagerComponent>(Actor, TEXT("BenchmarkInventoryB")));
+			for (int32 i = 0; i < 8; ++i)
+			{
+				Items.Add(NewObject<UYcInventoryItemInstance>(Actor));
+			}
+			return true;
+		}
+
+		void Shutdown()
+		{
+			if (Actor)
+			{
+				Actor->Destroy();
+				Actor = nullptr;
+			}
+		}
+
+		/** 与快捷栏组件相同的投影逻辑 */
+		static void RegisterHandlers(UYcInventoryOperationRouterComponent& Router)
+		{
+			FYcInventoryOperationHandler AddHandler;
+			AddHandler.ProjectState.BindLambda([](const FYcInventoryOperation& Op, FYcInventoryProjectedState& State)
+			{
+				State.QuickBarSlots.Add(Op.SlotIndex, Op.ItemInstance);
+			});
+			Router.RegisterOperationHandler(TEXT("QuickBar.Add"), AddHandler);
+
+			FYcInventoryOperationHandler RemoveHandler;
+			RemoveHandler.ProjectState.BindLambda([](const FYcInventoryOperation& Op, FYcInventoryProjectedState& State)
+			{
+				State.QuickBarSlots.Add(Op.SlotIndex, nullptr);
+			});
+			Router.RegisterOperationHandler(TEXT("QuickBar.Remove"), RemoveHandler);
+		}
+
+		FYcInventoryOperation MakeOperation()
+		{
+			FYcInventoryOperation Op;
+			Op.OpId = NextOpId++;
+			const bool bRemove = Op.OpId % 5 == 0;
+			Op.OpType = bRemove ? FName(TEXT("QuickBar.Remove")) : FName(TEXT("QuickBar.Add"));
+			Op.OpTypeIndex = UYcInventoryOperationRouterComponent::FindOperationTypeIndex(Op.OpType);
+			Op.SlotIndex = static_cast<int32>((Op.OpId * 7) % NumQuickBarSlots);
+			Op.ItemInstance = bRemove ? nullptr : Items[static_cast<int32>(Op.OpId % Items.Num())];
+			Op.TargetInventory = Inventories[static_cast<int32>(Op.OpId % Inventories.Num())];
+			return Op;
+		}
+	};
+
+	/** 改造前的 Nack 处理：清空预测态后按 Pending 队列逐个重新投影 */
+	static void LegacyRebuild(UYcInventoryOperationRouterComponent& Router)
+	{
+		Router.ProjectedState = FYcInventoryProjectedState();
+		for (const int64 PendingId : Router.PendingOperationOrder)
+		{
+			if (const FYcInventoryOperation* PendingOp = Router.PendingOperations.Find(PendingId))
+			{
+				Router.ProjectOperation(*PendingOp, Router.ProjectedState);
+			}
+		}
+	}
+
+	static void SubmitPending(UYcInventoryOperationRouterComponent& Router, const FYcInventoryOperation& Op, const bool bIncremental)
+	{
+		Router.PendingOperations.Add(Op.OpId, Op);
+		Router.PendingOperationOrder.Add(Op.OpId);
+		if (bIncremental)
+		{
+			Router.ApplyPendingProjection(Op);
+		}
+		else
+		{
+			Router.ProjectOperation(Op, Router.ProjectedState);
+		}
+	}
+
+	static void NackPending(UYcInventoryOperationRouterComponent& Router, const int64 OpId, const bool bIncremental)
+	{
+		Router.PendingOperations.Remove(OpId);
+		Router.PendingOperationOrder.Remove(OpId);
+		if (bIncremental)
+		{
+			Router.RevertPendingProjection(OpId);
+		}
+		else
+		{
+			LegacyRebuild(Router);
+		}
+	}
+
+	/** 随机 Nack 一个 Pending 操作并补交一个新操作，两个 Router 使用相同的随机序列 */
+	static double RunChurn(FFixture& Fixture, UYcInventoryOperationRouterComponent& Router, const bool bIncremental, const int32 NumIterations, const bool bVerifyEachStep, int32& OutNumErrors)
+	{
+		FRandomStream Stream(0x5EED);
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			const int64 NackedId = Router.PendingOperationOrder[Stream.RandRange(0, Router.PendingOperationOrder.Num() - 1)];
+			NackPending(Router, NackedId, bIncremental);
+			if (bVerifyEachStep && !Router.VerifyProjectedState(TEXT("Nack")))
+			{
+				++OutNumErrors;
+			}
+
+			SubmitPending(Router, Fixture.MakeOperation(), bIncremental);
+			if (bVerifyEachStep && !Router.VerifyProjectedState(TEXT("Submit")))
+			{
+				++OutNumErrors;
+			}
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	static void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumPending = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+		const int32 NumIterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 2000;
+
+		FFixture Fixture;
+		if (!Fixture.Init(World))
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.BenchmarkProjectedState: 无法生成测试Actor"));
+			return;
+		}
+
+		// 两个 Router 填入相同的 Pending 队列
+		const int64 FirstOpId = Fixture.NextOpId;
+		for (int32 i = 0; i < NumPending; ++i)
+		{
+			SubmitPending(*Fixture.IncrementalRouter, Fixture.MakeOperation(), true);
+		}
+		Fixture.NextOpId = FirstOpId;
+		for (int32 i = 0; i < NumPending; ++i)
+		{
+			SubmitPending(*Fixture.LegacyRouter, Fixture.MakeOperation(), false);
+		}
+
+		int32 NumErrors = 0;
+		const int64 ChurnFirstOpId = Fixture.NextOpId;
+		const double LegacySeconds = RunChurn(Fixture, *Fixture.LegacyRouter, false, NumIterations, false, NumErrors);
+		Fixture.NextOpId = ChurnFirstOpId;
+		const double IncrementalSeconds = RunChurn(Fixture, *Fixture.IncrementalRouter, true, NumIterations, false, NumErrors);
+
+		const FYcInventoryProjectedState& Legacy = Fixture.LegacyRouter->ProjectedState;
+		const FYcInventoryProjectedState& Incremental = Fixture.IncrementalRouter->ProjectedState;
+		if (!Legacy.InventoryGridRevision.OrderIndependentCompareEqual(Incremental.InventoryGridRevision)
+			|| !Legacy.EquipmentSlots.OrderIndependentCompareEqual(Incremental.EquipmentSlots)
+			|| !Legacy.QuickBarSlots.OrderIndependentCompareEqual(Incremental.QuickBarSlots))
+		{
+			UE_LOG(LogYcInventory, Error, TEXT("Yc.Inventory.BenchmarkProjectedState: 两种路径的最终预测态不一致"));
+			++NumErrors;
+		}
+
+		// 计时之外再逐步校验增量结果与完整重建一致
+		RunChurn(Fixture, *Fixture.IncrementalRouter, true, FMath::Min(NumIterations, 500), true, NumErrors);
+
+		Fixture.Shutdown();
+
+		UE_LOG(LogYcInventory, Display, TEXT("Yc.Inventory.BenchmarkProjectedState: %s (Pending %d, Nack+提交 %d 次, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumPending, NumIterations, NumErrors);
+		UE_LOG(LogYcInventory, Display, TEXT("  完整重建 %.2f ms / 增量维护 %.2f ms (%.1fx)"),
+			LegacySeconds * 1000.0, IncrementalSeconds * 1000.0, IncrementalSeconds > 0.0 ? LegacySeconds / IncrementalSeconds : 0.0);
+	}
+};
+
+namespace YcInventoryProjectedStateBenchmark
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+		TEXT("Yc.Inventory.BenchmarkProjectedState"),
+		TEXT("预测态增量维护与完整重建的性能对比及一致性校验：Yc.Inventory.BenchmarkProjectedState [Pending数量=200] [迭代次数=2000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcInventoryProjectedStateBenchmark::RunBenchmark));
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "StructUtils/InstancedStruct.h"
+#include "Utils/YcFragmentIndex.h"
 #include "YcInventoryItemDefinition.generated.h"
 
 class UYcInventoryItemInstance;
@@ -56,11 +57,32 @@ struct YICHENINVENTORY_API FYcInventoryItemDefinition : public FTableRowBase
 	template <typename FragmentType>
 	const FragmentType* GetTypedFragment() const
 	{
-		for (const auto& Fragment : Fragments)
-		{
-			const FragmentType* TypedFragment = Fragment.GetPtr<FragmentType>();
-			if (TypedFragment != nullptr) return TypedFragment;
-		}
-		return nullptr;
+		return FragmentIndex.template FindTyped<FragmentType>(Fragments);
 	}
+	
+	/** 按结构体类型精确查找Fragment, 返回定义中的Fragment本身, 不产生拷贝 */
+	const TInstancedStruct<FYcInventoryItemFragment>* FindFragment(const UScriptStruct* FragmentStructType) const
+	{
+		return FragmentIndex.FindExact(Fragments, FragmentStructType);
+	}
+	
+	/** 反序列化完成后构建Fragment类型索引 */
+	void PostSerialize(const FArchive& Ar);
+	
+	//~ Begin FTableRowBase Interface
+	virtual void OnDataTableChanged(const UDataTable* InDataTable, const FName InRowName) override;
+	//~ End FTableRowBase Interface
+	
+private:
+	/** Fragment类型 -> Fragments下标, 避免每次查询都线性遍历Fragments */
+	TYcFragmentIndex<FYcInventoryItemFragment> FragmentIndex;
+};
+
+template<>
+struct TStructOpsTypeTraits<FYcInventoryItemDefinition> : public TStructOpsTypeTraitsBase2<FYcInventoryItemDefinition>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
 };
\ No newline at end of file
@@ -47,6 +47,14 @@ public:
 	 * @return 物品定义指针，如果不存在则返回nullptr
 	 */
 	const FYcInventoryItemDefinition* GetItemDef();
+
+#if !UE_BUILD_SHIPPING
+	/**
+	 * 仅供测试：直接指定物品定义，不经过DataRegistry
+	 * 定义的生命周期由调用者保证长于实例
+	 */
+	void SetItemDefForTesting(const FYcInventoryItemDefinition* InItemDef) { ItemDef = InItemDef; }
+#endif // #if !UE_BUILD_SHIPPING
 	
 	/**
 	 * 蓝图版本：获取物品定义
@@ -88,6 +96,14 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Inventory")
 	TInstancedStruct<FYcInventoryItemFragment> FindItemFragment(const UScriptStruct* FragmentStructType);
 	
+	/**
+	 * C++版本：按结构体类型查找Fragment
+	 * 直接返回ItemDef中的Fragment，不产生拷贝
+	 * @param FragmentStructType 目标Fragment结构类型
+	 * @return Fragment指针，如果不存在则返回nullptr
+	 */
+	const TInstancedStruct<FYcInventoryItemFragment>* FindItemFragmentPtr(const UScriptStruct* FragmentStructType);
+	
 	/**
 	 * C++版本：获取特定类型的Fragment
 	 * 效率最高，推荐在C++中使用
@@ -98,12 +114,7 @@ public:
 	const FragmentType* GetTypedFragment()
 	{
 		if (!GetItemDef()) return nullptr;
-		for (const auto& Fragment : ItemDef->Fragments)
-		{
-			const FragmentType* TypedFragment = Fragment.GetPtr<FragmentType>();
-			if (TypedFragment != nullptr) return TypedFragment;
-		}
-		return nullptr;
+		return ItemDef->GetTypedFragment<FragmentType>();
 	}
 	
 	//~=============================================================================
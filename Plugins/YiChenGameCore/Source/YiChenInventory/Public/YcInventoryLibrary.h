@@ -59,6 +59,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Inventory")
 	static bool GetItemDefinition(const FDataRegistryId& ItemDataRegistryId, FYcInventoryItemDefinition& ItemDef);
 	
+	/**
+	 * C++版本：通过DataRegistryId获取物品定义, 直接返回DataRegistry缓存中的定义, 不产生拷贝
+	 * @param ItemDataRegistryId 物品的数据注册表ID
+	 * @return 物品定义指针，获取失败或物品被禁用时返回 nullptr
+	 */
+	static const FYcInventoryItemDefinition* FindItemDefinition(const FDataRegistryId& ItemDataRegistryId);
+	
 	/**
 	 * 通过DataRegistryId异步加载物品定义中的所有数据资产
 	 * 可用于预加载物品资产，避免运行时卡顿
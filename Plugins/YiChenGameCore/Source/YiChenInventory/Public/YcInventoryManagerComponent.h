@@ -5,6 +5,7 @@
 #include "DataRegistryId.h"
 #include "Components/ActorComponent.h"
 #include "Net/Serialization/FastArraySerializer.h"
+#include "UObject/ObjectKey.h"
 #include "YcInventoryManagerComponent.generated.h"
 
 struct FYcInventoryItemDefinition;
@@ -38,6 +39,25 @@ struct YICHENINVENTORY_API FYcInventoryItemChangeMessage
 	int32 Delta = 0;
 };
 
+/**
+ * 库存物品句柄
+ * 由索引槽位和代数组成。槽位记录物品当前在 Items 数组中的位置，数组重新分配、
+ * 移除元素导致位置变化时由索引修正；物品移除后槽位代数加一，旧句柄随之失效。
+ */
+struct YICHENINVENTORY_API FYcInventoryItemHandle
+{
+	/** 索引槽位 */
+	int32 Slot = INDEX_NONE;
+
+	/** 获取句柄时的槽位代数 */
+	uint32 Generation = 0;
+
+	bool IsValid() const { return Slot != INDEX_NONE; }
+
+	bool operator==(const FYcInventoryItemHandle& Other) const { return Slot == Other.Slot && Generation == Other.Generation; }
+	bool operator!=(const FYcInventoryItemHandle& Other) const { return !(*this == Other); }
+};
+
 /**
  * 库存中的单个ItemInstance的包装结构体
  * 用于FastArray网络同步
@@ -51,6 +71,12 @@ struct YICHENINVENTORY_API FYcInventoryItemEntry : public FFastArraySerializerIt
 
 	FString GetDebugString() const;
 
+	/** 获取Item实例对象 */
+	UYcInventoryItemInstance* GetInstance() const { return Instance; }
+
+	/** 获取物品堆叠数量 */
+	int32 GetStackCount() const { return StackCount; }
+
 private:
 	friend FYcInventoryItemList;
 	friend UYcInventoryManagerComponent;
@@ -66,6 +92,9 @@ private:
 	/** 最后一次修改前的数量（用于计算Delta） */
 	UPROPERTY(NotReplicated, BlueprintReadOnly, VisibleInstanceOnly, meta = (AllowPrivateAccess = "true"))
 	int32 LastObservedCount = INDEX_NONE;
+
+	/** 在库存索引中的槽位（本地数据，不复制） */
+	int32 IndexSlot = INDEX_NONE;
 };
 
 /**
@@ -85,6 +114,7 @@ public:
 	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
 	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
 	//~ End FFastArraySerializer Interface
 
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
@@ -123,13 +153,41 @@ public:
 	bool RemoveItem(UYcInventoryItemInstance* Instance);
 	
 	/**
-	 * 在ItemsMap中通过ItemId快速查找Item数据条目
+	 * 通过ItemId在索引中快速查找Item数据条目
 	 * @param ItemId 要查找的ItemId
 	 * @param OutItemEntry 找到的Item数据条目
 	 * @return 是否成功找到
 	 */
 	bool FindItemById(const FName& ItemId, FYcInventoryItemEntry& OutItemEntry);
 
+	//~=============================================================================
+	// 索引查询（均为 O(1)）
+
+	/** 通过ItemId查找物品句柄，未找到返回无效句柄 */
+	FYcInventoryItemHandle FindItemHandle(const FName& ItemId);
+
+	/** 通过物品实例查找物品句柄，未找到返回无效句柄 */
+	FYcInventoryItemHandle FindItemHandle(const UYcInventoryItemInstance* Instance) const;
+
+	/**
+	 * 通过句柄获取Item数据条目
+	 * 返回的指针只在下一次修改Items之前有效，不要长期持有
+	 * @return 句柄已失效时返回nullptr
+	 */
+	const FYcInventoryItemEntry* GetEntry(const FYcInventoryItemHandle& Handle) const;
+	FYcInventoryItemEntry* GetEntry(const FYcInventoryItemHandle& Handle);
+
+	/** 某个物品定义在库存中的实例数量 */
+	int32 GetInstanceCountByDefinition(const FName& ItemDefId);
+
+	/** 某个物品定义在库存中所有实例的堆叠数量总和 */
+	int32 GetStackCountByDefinition(const FName& ItemDefId);
+
+	/**
+	 * 修改条目的堆叠数量后调用，更新按定义汇总的数量（仅权威端，客户端由FastArray辅助函数调用）
+	 */
+	void MarkItemStackCountChanged(FYcInventoryItemEntry& ItemEntry);
+
 private:
 	/**
 	 * 广播Item发生变化的消息
@@ -139,16 +197,35 @@ private:
 	 */
 	void BroadcastChangeMessage(const FYcInventoryItemEntry& ItemEntry, int32 OldCount, int32 NewCount) const;
 
-	void AddItemToMap_Internal(FYcInventoryItemEntry& Item);
-	void ChangeItemToMap_Internal(FYcInventoryItemEntry& Item);
-	void RemoveItemToMap_Internal(const FYcInventoryItemEntry& Item);
+	/** 为Items中指定位置的条目分配索引槽位 */
+	void AddItemToIndex_Internal(int32 ItemIndex);
+
+	/** 条目的ItemId、定义或堆叠数量可能变化，同步到索引 */
+	void ChangeItemInIndex_Internal(FYcInventoryItemEntry& Item);
+
+	/** 释放条目的索引槽位，槽位代数加一 */
+	void RemoveItemFromIndex_Internal(FYcInventoryItemEntry& Item);
+
+	/** 从FirstIndex开始修正槽位记录的数组位置 */
+	void RefreshItemPositions_Internal(int32 FirstIndex = 0);
+
+	/** 补全复制时尚未到达的ItemId/物品定义（客户端上ItemInstance的属性可能晚于条目到达） */
+	void ResolvePendingIndexKeys_Internal();
+
+	/** 获取物品实例用于汇总的定义ID，定义尚不可用时返回NAME_None */
+	static FName GetDefinitionKey(UYcInventoryItemInstance* Instance);
 	
 	/**
 	 * 生成下一个不重复的ItemId
 	 * 同一个物品的第一份会占用ItemId，如果超过了堆叠数量需要新建另一份
-	 * 此时不能再延用ItemId，使用这个函数生成带后缀的唯一ID
+	 * 此时不能再延用ItemId，改为 ItemId + 数字后缀。
+	 * 后缀 = 盐值 + 单调递增序号，直接写入FName自带的数字部分，
+	 * 与ItemId共用名称表条目，不会增加FName表。只能在权威端调用。
 	 */
-	FName GenerateNextItemId(const FYcInventoryItemEntry& Item) const;
+	FName GenerateNextItemId(const FYcInventoryItemDefinition& ItemDef);
+
+	/** 物品加入列表前确保其ItemId有效且不与已有物品重复，必要时重新分配 */
+	void EnsureUniqueItemId_Internal(UYcInventoryItemInstance* Instance);
 	
 	friend UYcInventoryManagerComponent;
 	
@@ -156,12 +233,76 @@ private:
 	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, meta = (AllowPrivateAccess = "true"))
 	TArray<FYcInventoryItemEntry> Items;
 	
+	/** 索引槽位 */
+	struct FIndexSlot
+	{
+		/** 条目在Items中的位置 */
+		int32 ItemIndex = INDEX_NONE;
+
+		/** 槽位代数，释放时加一 */
+		uint32 Generation = 0;
+
+		/** 已计入定义汇总的堆叠数量 */
+		int32 StackCount = 0;
+
+		/** 已登记的ItemId */
+		FName ItemInstId;
+
+		/** 已登记的物品定义ID */
+		FName DefinitionId;
+
+		/** 已登记的物品实例 */
+		FObjectKey Instance;
+	};
+
+	/** 按物品定义汇总的数量 */
+	struct FDefinitionAggregate
+	{
+		/** 实例数量 */
+		int32 NumInstances = 0;
+
+		/** 堆叠数量总和 */
+		int32 TotalStackCount = 0;
+	};
+
+	/**
+	 * 物品索引，用于O(1)查询
+	 * TMap不支持网络复制，在FastArray的网络复制辅助函数和权威端的增删改中手动维护；
+	 * 只保存槽位号而不保存条目指针，Items重新分配不会产生悬空指针
+	 */
+	TArray<FIndexSlot> IndexSlots;
+
+	/** 空闲的索引槽位 */
+	TArray<int32> FreeIndexSlots;
+
+	/** ItemId -> 索引槽位 */
+	TMap<FName, int32> ItemIdToSlot;
+
+	/** 物品实例 -> 索引槽位 */
+	TMap<FObjectKey, int32> InstanceToSlot;
+
+	/** 物品定义ID -> 汇总数量 */
+	TMap<FName, FDefinitionAggregate> DefinitionAggregates;
+
+	/** ItemId或物品定义尚未登记的槽位 */
+	TArray<int32> PendingIndexSlots;
+
+	/** 客户端移除条目后数组位置待修正 */
+	bool bItemPositionsDirty = false;
+
+	/** ItemId数字后缀的上限，FName的数字部分按int32显示，保持为正数 */
+	static constexpr uint32 MaxItemIdSuffix = 0x7FFFFFFF;
+
+	/** 下一个ItemId序号，只增不减，同一列表生成的ID不会重复 */
+	UPROPERTY(NotReplicated)
+	uint32 NextItemSerial = 0;
+
 	/**
-	 * 映射表，用于快速查询
-	 * TMap查询速度>TArray，但TMap在UE中不支持网络复制
-	 * 在FastArray的三个网络复制辅助函数中手动操作以保证数据一致性
+	 * ItemId盐值，首次分配时由所属Actor和组件名确定（0表示尚未确定）
+	 * 让不同库存生成的后缀落在不同区间，物品在库存间转移时通常可以保留原ID
 	 */
-	TMap<FName, FYcInventoryItemEntry*> ItemsMap;
+	UPROPERTY(NotReplicated)
+	uint32 ItemIdSalt = 0;
 	
 	UPROPERTY(NotReplicated)
 	TObjectPtr<UActorComponent> OwnerComponent;
@@ -301,6 +442,14 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = Inventory, BlueprintPure)
 	int32 GetTotalItemCountByDefinition(const FYcInventoryItemDefinition& ItemDef);
+
+	/**
+	 * 查找某个物品定义在库存中所有实例的StackCount总和
+	 * @param ItemDef 目标ItemDef
+	 * @return 堆叠数量总和
+	 */
+	UFUNCTION(BlueprintCallable, Category = Inventory, BlueprintPure)
+	int32 GetTotalStackCountByDefinition(const FYcInventoryItemDefinition& ItemDef);
 	
 	/**
 	 * 获取ItemInstance的StackCount
@@ -311,13 +460,22 @@ public:
 	int32 GetStackCountByItemInstance(const UYcInventoryItemInstance* ItemInstance) const;
 	
 	/**
-	 * 在ItemsMap中通过ItemId快速查找Item数据条目
+	 * 通过ItemId快速查找Item数据条目
 	 * @param ItemId 要查找的ItemId
 	 * @param OutItemEntry 找到的Item数据条目
 	 * @return 是否成功找到
 	 */
 	UFUNCTION(BlueprintCallable, Category = Inventory, BlueprintPure)
 	bool FindItemById(const FName& ItemId, FYcInventoryItemEntry& OutItemEntry);
+
+	/** 通过ItemId查找物品句柄（仅 C++） */
+	FYcInventoryItemHandle FindItemHandle(const FName& ItemId);
+
+	/** 通过句柄获取物品实例，句柄失效返回nullptr（仅 C++） */
+	UYcInventoryItemInstance* GetItemInstanceByHandle(const FYcInventoryItemHandle& Handle) const;
+
+	/** 通过句柄获取堆叠数量，句柄失效返回0（仅 C++） */
+	int32 GetStackCountByHandle(const FYcInventoryItemHandle& Handle) const;
 	
 private:
 	/** 基于FastArray进行网络复制的库存物品列表 */
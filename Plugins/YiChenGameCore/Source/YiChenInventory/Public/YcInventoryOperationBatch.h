@@ -0,0 +1,115 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "YcInventoryOperationTypes.h"
+#include "YcInventoryOperationBatch.generated.h"
+
+class UPackageMap;
+
+/** 服务端拒绝操作的错误码（批量回执中代替完整的失败原因字符串）。 */
+UENUM(BlueprintType)
+enum class EYcInventoryOperationErrorCode : uint8
+{
+	/** 无错误。 */
+	None,
+	/** 处理器校验或执行失败，具体原因见 Reason。 */
+	Rejected,
+	/** OpType 为空。 */
+	InvalidOpType,
+	/** 没有匹配的处理器。 */
+	UnsupportedOpType,
+	/** 不在权威端。 */
+	NotAuthority,
+	/** 未知的处理结果。 */
+	Unknown,
+
+	MAX UMETA(Hidden)
+};
+
+/**
+ * 一帧内提交的库存操作批次（客户端 -> 服务端）。
+ *
+ * 自定义 NetSerialize，相比逐个 RPC 发送 FYcInventoryOperation：
+ * - 常用 OpType 编码为操作码，其余 OpType 在批次内只发送一次名称
+ * - 对象引用在批次内去重，按表索引发送；请求者/库存与上一条相同时只占 1 位
+ * - OpId、BaseRevision、物品引用按与上一条的差值编码
+ * - 数量、坐标等使用变长整数，等于默认值时只占 1 位
+ * 批次内所有操作共用第一条操作的 ClientTimestamp。
+ */
+USTRUCT()
+struct YICHENINVENTORY_API FYcInventoryOperationBatch
+{
+	GENERATED_BODY()
+
+	/** 单个批次最多容纳的操作数量，超过时提前发送。 */
+	static constexpr int32 MaxOperations = 128;
+
+	/** 批次序号，用于与回执对应。 */
+	UPROPERTY()
+	uint32 BatchId = 0;
+
+	/** 批次中的操作，顺序即服务端执行顺序。 */
+	UPROPERTY()
+	TArray<FYcInventoryOperation> Operations;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FYcInventoryOperationBatch> : public TStructOpsTypeTraitsBase2<FYcInventoryOperationBatch>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+/**
+ * 批量操作回执（服务端 -> 客户端）。
+ *
+ * 每条操作的结果压缩为位域：1 = Ack，0 = Nack；
+ * 只有存在延迟处理的操作时才额外发送延迟位域。
+ * Nack 附带错误码，失败原因字符串可选（见 Yc.Inventory.OperationBatch.SendNackReasons）。
+ */
+USTRUCT()
+struct YICHENINVENTORY_API FYcInventoryOperationBatchResult
+{
+	GENERATED_BODY()
+
+	/** 对应的批次序号。 */
+	uint32 BatchId = 0;
+
+	/** 处理完批次后的权威版本号。 */
+	int32 NewRevision = 0;
+
+	/** 各操作是否成功。 */
+	TBitArray<> AckBits;
+
+	/** 各操作是否延迟处理（为空表示没有延迟处理的操作）。 */
+	TBitArray<> DeferredBits;
+
+	/** 按顺序排列的 Nack 错误码（不含延迟处理的操作）。 */
+	TArray<EYcInventoryOperationErrorCode> ErrorCodes;
+
+	/** 与 ErrorCodes 一一对应的失败原因，可为空。 */
+	TArray<FString> Reasons;
+
+	/** 按操作数量初始化位域。 */
+	void Init(int32 NumOperations);
+
+	/** 操作是否延迟处理。 */
+	bool IsDeferred(int32 Index) const { return DeferredBits.IsValidIndex(Index) && DeferredBits[Index]; }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FYcInventoryOperationBatchResult> : public TStructOpsTypeTraitsBase2<FYcInventoryOperationBatchResult>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Components/ActorComponent.h"
+#include "YcInventoryOperationBatch.h"
 #include "YcInventoryOperationTypes.h"
 #include "YcInventoryOperationRouterComponent.generated.h"
 
@@ -56,6 +57,10 @@ class YICHENINVENTORY_API UYcInventoryOperationRouterComponent : public UActorCo
 public:
 	UYcInventoryOperationRouterComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	//~ Begin UActorComponent Interface
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~ End UActorComponent Interface
+
 	/** 查找 Actor 关联的 Router（优先走 Controller 链路）。 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Inventory)
 	static UYcInventoryOperationRouterComponent* FindRouter(const AActor* Actor);
@@ -64,17 +69,38 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Inventory)
 	static UYcInventoryOperationRouterComponent* FindOrCreateRouter(AActor* Actor);
 
-	/** 提交统一操作（客户端入队预测，必要时转发到服务端）。 */
+	/**
+	 * 提交统一操作（客户端入队预测，必要时转发到服务端）。
+	 * 客户端发往服务端的操作会先进入本帧批次，在本帧 Actor Tick 结束后合并为一个 RPC 发送。
+	 */
 	UFUNCTION(BlueprintCallable, Category = Inventory)
 	int64 SubmitInventoryOperation(UYcInventoryManagerComponent* CallingInventory, FYcInventoryOperation InOperation, bool bSendToServer);
 
+	/** 批量提交操作（拾取全部/整理等），客户端立即合并发送。返回各操作的 OpId。 */
+	UFUNCTION(BlueprintCallable, Category = Inventory)
+	TArray<int64> SubmitInventoryOperationBatch(UYcInventoryManagerComponent* CallingInventory, const TArray<FYcInventoryOperation>& InOperations);
+
+	/** 立即发送本帧尚未发送的操作批次。 */
+	void FlushOperationBatch();
+
 	/** 服务端统一入口：执行校验 / 路由 / 回执。 */
-	EYcInventoryOperationProcessResult HandleServerSubmit(const FYcInventoryOperation& InOperation, int32& OutRevision, FString& OutDetail);
+	EYcInventoryOperationProcessResult HandleServerSubmit(const FYcInventoryOperation& InOperation, int32& OutRevision, FString& OutDetail, EYcInventoryOperationErrorCode* OutErrorCode = nullptr);
+
+	/** 服务端按顺序执行一个批次并生成位域回执。 */
+	FYcInventoryOperationBatchResult HandleServerSubmitBatch(const FYcInventoryOperationBatch& Batch);
 
 	/** 客户端向服务端提交统一操作。 */
 	UFUNCTION(Server, Reliable)
 	void ServerSubmitInventoryOperation(const FYcInventoryOperation& InOperation);
 
+	/** 客户端向服务端提交一帧内的操作批次。 */
+	UFUNCTION(Server, Reliable)
+	void ServerSubmitInventoryOperationBatch(const FYcInventoryOperationBatch& Batch);
+
+	/** 服务端向客户端下发批次回执。 */
+	UFUNCTION(Client, Reliable)
+	void ClientReceiveInventoryOperationBatchResult(const FYcInventoryOperationBatchResult& Result);
+
 	/** 服务端向客户端下发操作 Ack。 */
 	UFUNCTION(Client, Reliable)
 	void ClientReceiveInventoryOperationAck(int64 OpId, int32 NewRevision, const FString& DeltaSummary);
@@ -97,6 +123,9 @@ public:
 	/** 客户端收到服务端 Nack 后的处理入口。 */
 	void HandleClientReceiveNack(int64 OpId, int32 NewRevision, const FString& Reason);
 
+	/** 客户端收到批次回执后的处理入口（逐条转为 Ack / Nack）。 */
+	void HandleClientReceiveBatchResult(const FYcInventoryOperationBatchResult& Result);
+
 	/** 获取当前权威版本号。 */
 	UFUNCTION(BlueprintCallable, Category = Inventory)
 	int32 GetAuthoritativeOperationRevision() const { return AuthoritativeOperationRevision; }
@@ -126,7 +155,13 @@ public:
 	/** 根据处理器拥有者批量反注册。 */
 	bool UnregisterOperationHandlersByOwner(const UObject* HandlerOwner);
 
-	/** 脚本组件注册通用操作处理器（通过函数名反射绑定）。 */
+	/**
+	 * 解析 OpType 的分发下标，不会写入驻留表。
+	 * 精确注册过的 OpType 对应其驻留ID，其余 OpType 对应最长的已注册前缀；都没有时返回 INDEX_NONE。
+	 */
+	static int32 FindOperationTypeIndex(FName OpType);
+
+	/** 脚本组件注册通用操作处理器（注册时按函数名解析 UFunction，脚本热重载后自动重新解析）。 */
 	UFUNCTION(BlueprintCallable, Category = Inventory)
 	bool RegisterScriptOperationHandler(const FName& OpTypeOrPrefix, UObject* HandlerObject, FName ValidateFunctionName, FName ExecuteFunctionName, FName BuildDeltaFunctionName, bool bPrefixMatch, int32 Priority = 0);
 
@@ -138,11 +173,26 @@ private:
 	/** 注册内置默认处理器。 */
 	void RegisterDefaultOperationHandlers();
 
-	/** 根据 OpType 解析处理器（先精确匹配，再前缀匹配）。 */
-	const FYcInventoryOperationHandler* ResolveOperationHandler(const FName& OpType) const;
+	/** 为处理器的 OpType 或前缀分配驻留ID（稠密、全局唯一），只在注册处理器时调用。 */
+	static int32 InternOperationType(FName OpTypeOrPrefix);
+
+	/** 按操作已解析的分发下标取处理器，结果缓存在分发表中。 */
+	const FYcInventoryOperationHandler* ResolveOperationHandler(const FYcInventoryOperation& Operation) const;
+
+	/** 不经过分发表解析处理器（先精确匹配，再前缀匹配）。 */
+	const FYcInventoryOperationHandler* ResolveOperationHandlerUncached(const FName& OpType) const;
+
+	/** 处理器增删后清空分发表。 */
+	void InvalidateDispatchTable();
 
 	/** 服务端执行单次操作（校验 + 执行）。 */
-	EYcInventoryOperationProcessResult ExecuteOperationOnServer(const FYcInventoryOperation& InOperation, FString& OutReason, FString& OutDeltaSummary);
+	EYcInventoryOperationProcessResult ExecuteOperationOnServer(const FYcInventoryOperation& InOperation, FString& OutReason, FString& OutDeltaSummary, EYcInventoryOperationErrorCode& OutErrorCode);
+
+	/** 将操作加入本帧批次，首次加入时注册帧末发送。 */
+	void QueueOperationForBatch(const FYcInventoryOperation& InOperation);
+
+	/** 帧末发送批次。 */
+	void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
 
 	/** 执行处理器校验委托。 */
 	bool ValidateOperationWithHandler(const FYcInventoryOperation& InOperation, const FYcInventoryOperationHandler& Handler, FString& OutReason) const;
@@ -150,8 +200,17 @@ private:
 	/** 执行处理器执行/增量构建委托。 */
 	bool ExecuteOperationWithHandler(const FYcInventoryOperation& InOperation, const FYcInventoryOperationHandler& Handler, FString& OutReason, FString& OutDeltaSummary);
 
-	/** Nack 后按 Pending 队列重建预测态。 */
-	void RebuildProjectedStateFromPending(int64 NackedOpId);
+	/** 将 Pending 操作的投影写入预测态，并记录该操作写入的条目。 */
+	void ApplyPendingProjection(const FYcInventoryOperation& Operation);
+
+	/** Ack/Nack 后撤销该操作的投影，被它覆盖的槽位回退到更早的 Pending 操作写入的值。 */
+	void RevertPendingProjection(int64 OpId);
+
+	/** 按 Pending 队列从头重建预测态（一致性校验用）。 */
+	void BuildProjectedStateFromPending(FYcInventoryProjectedState& OutState) const;
+
+	/** 校验增量维护的预测态与完整重建的结果一致。 */
+	bool VerifyProjectedState(const TCHAR* Context) const;
 
 	/** 广播操作状态消息。 */
 	void BroadcastOperationStateMessage(EYcInventoryOperationEvent Event, const FYcInventoryOperation& Operation, const FString& Detail, const FYcInventoryOperationDelta* Delta = nullptr);
@@ -162,8 +221,8 @@ private:
 	/** 记录单次操作链路日志。 */
 	void LogOperationTrace(const TCHAR* Stage, const FYcInventoryOperation& Operation, const FString& Detail) const;
 
-	/** 将一次操作投影到 ProjectedState。 */
-	void RefreshProjectedStateFromAuthoritative(const FYcInventoryOperation& Operation);
+	/** 将一次操作投影到指定的预测态。 */
+	void ProjectOperation(const FYcInventoryOperation& Operation, FYcInventoryProjectedState& InOutState) const;
 
 	/** 权威版本号（由服务端推进）。 */
 	UPROPERTY(Transient)
@@ -189,9 +248,44 @@ private:
 	UPROPERTY(Transient)
 	FYcInventoryProjectedState ProjectedState;
 
+	/** 各 Pending 操作写入预测态的条目（OpId -> 写入内容，网格版本号为增量）。 */
+	UPROPERTY(Transient)
+	TMap<int64, FYcInventoryProjectedState> PendingProjections;
+
+	/** 各网格版本号的 Pending 写入者数量，归零时移除该条目。 */
+	TMap<FName, int32> GridRevisionWriterCounts;
+
+	/** 各装备槽的 Pending 写入者（按提交顺序，最后一个即当前值的来源）。 */
+	TMap<FGameplayTag, TArray<int64>> EquipmentSlotWriters;
+
+	/** 各快捷栏槽位的 Pending 写入者（按提交顺序，最后一个即当前值的来源）。 */
+	TMap<int32, TArray<int64>> QuickBarSlotWriters;
+
+	friend struct FYcInventoryProjectedStateBenchmark;
+
 	/** 已注册处理器表（Key 为 OpType 或前缀）。 */
 	TMap<FName, FYcInventoryOperationHandler> RegisteredOperationHandlers;
 
 	/** 已注册处理器拥有者索引（用于按拥有者批量反注册）。 */
 	TMap<FName, TWeakObjectPtr<const UObject>> RegisteredHandlerOwners;
+
+	/** 分发表（下标为 FindOperationTypeIndex 的结果，值为解析出的处理器，nullptr 表示没有处理器）。 */
+	mutable TArray<const FYcInventoryOperationHandler*> DispatchTable;
+
+	/** 分发表中已解析的条目。 */
+	mutable TBitArray<> DispatchResolved;
+
+	friend struct FYcInventoryOperationDispatchBenchmark;
+
+	/** 本帧待发送的操作批次。 */
+	FYcInventoryOperationBatch OutgoingBatch;
+
+	/** 已发送、等待回执的批次（BatchId -> 按顺序的 OpId）。 */
+	TMap<uint32, TArray<int64>> InFlightBatches;
+
+	/** 下一个批次序号。 */
+	uint32 NextBatchId = 1;
+
+	/** 帧末发送批次的委托句柄。 */
+	FDelegateHandle BatchFlushHandle;
 };
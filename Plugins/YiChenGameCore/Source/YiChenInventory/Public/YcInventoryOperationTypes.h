@@ -137,6 +137,9 @@ struct YICHENINVENTORY_API FYcInventoryOperation
 	/** 槽位索引参数（快捷栏类操作）。 */
 	UPROPERTY(BlueprintReadWrite, Category = Inventory)
 	int32 SlotIndex = INDEX_NONE;
+
+	/** 分发下标，由 Router 在提交和收到操作时解析，INDEX_NONE 表示没有可用的处理器（本地数据，不复制）。 */
+	int32 OpTypeIndex = INDEX_NONE;
 };
 
 /** 操作状态变化消息（用于 UI 订阅）。 */
@@ -184,7 +187,10 @@ DECLARE_DELEGATE_RetVal_TwoParams(bool, FYcInventoryOperationValidateDelegate, c
 DECLARE_DELEGATE_RetVal_TwoParams(bool, FYcInventoryOperationExecuteDelegate, const FYcInventoryOperation&, FString&);
 /** 增量构建委托：根据执行结果输出 Delta。 */
 DECLARE_DELEGATE_ThreeParams(FYcInventoryOperationBuildDeltaDelegate, const FYcInventoryOperation&, bool /*bSuccess*/, FYcInventoryOperationDelta& /*OutDelta*/);
-/** 预测态投影委托：将操作结果投影到 Router 预测态。 */
+/**
+ * 预测态投影委托：将操作结果投影到 Router 预测态。
+ * 只按操作内容写入条目，不读取已有条目：Router 会把操作投影到空状态来记录它的写入，Ack/Nack 时据此增量撤销。
+ */
 DECLARE_DELEGATE_TwoParams(FYcInventoryOperationProjectStateDelegate, const FYcInventoryOperation&, FYcInventoryProjectedState& /*InOutProjectedState*/);
 
 /** Router 中注册的操作处理器配置。 */
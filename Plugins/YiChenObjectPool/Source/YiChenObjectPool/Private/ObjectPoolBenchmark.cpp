@@ -0,0 +1,361 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "ObjectPoolBenchmark.h"
+#include "ObjectPoolContainer.h"
+#include "ObjectPoolSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ObjectPoolBenchmark)
+
+namespace ObjectPoolBenchmark
+{
+	/**
+	 * 改造前的池簿记实现，仅用于性能对比
+	 * 全局临界区 + 可用索引数组 + 对象到索引映射，释放时线性检查是否重复释放
+	 */
+	class FLegacyPool
+	{
+	public:
+		void Add(UObject* Object)
+		{
+			const int32 Index = AllObjects.Add(Object);
+			AvailableIndices.Add(Index);
+			ObjectToIndexMap.Add(Object, Index);
+		}
+
+		UObject* Acquire()
+		{
+			FScopeLock Lock(&PoolLock);
+			while (AvailableIndices.Num() > 0)
+			{
+				const int32 Index = AvailableIndices.Pop(EAllowShrinking::No);
+				UObject* Obj = AllObjects[Index].Get();
+				if (!IsValid(Obj))
+				{
+					continue;
+				}
+				if (IPoolableObject* Poolable = Cast<IPoolableObject>(Obj); Poolable && !Poolable->CanBeAcquired())
+				{
+					continue;
+				}
+				return Obj;
+			}
+			return nullptr;
+		}
+
+		bool Release(UObject* Object)
+		{
+			FScopeLock Lock(&PoolLock);
+			const int32* IndexPtr = ObjectToIndexMap.Find(Object);
+			if (!IndexPtr || AvailableIndices.Contains(*IndexPtr))
+			{
+				return false;
+			}
+			AvailableIndices.Add(*IndexPtr);
+			return true;
+		}
+
+	private:
+		TArray<TWeakObjectPtr<UObject>> AllObjects;
+		TArray<int32> AvailableIndices;
+		TMap<UObject*, int32> ObjectToIndexMap;
+		FCriticalSection PoolLock;
+	};
+
+	/** 每个线程一次持有的对象数量 */
+	constexpr int32 ObjectsHeldPerIteration = 4;
+
+	FObjectPoolConfig MakeConfig(int32 PoolSize)
+	{
+		FObjectPoolConfig Config;
+		Config.PoolID = TEXT("ObjectPoolBenchmark");
+		Config.ObjectClass = UObjectPoolBenchmarkObject::StaticClass();
+		Config.InitialSize = PoolSize;
+		Config.MaxSize = PoolSize;
+		Config.bAllowGrowth = false;
+		Config.bAllowShrink = false;
+		return Config;
+	}
+
+	/**
+	 * 获取/释放吞吐量对比
+	 * 用法：Yc.ObjectPool.Benchmark [线程数=8] [每线程迭代次数=100000]
+	 */
+	void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumThreads = FMath::Max(1, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 8);
+		const int32 NumIterations = FMath::Max(1, Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 100000);
+		const int32 PoolSize = NumThreads * ObjectsHeldPerIteration;
+		const double NumOps = static_cast<double>(NumThreads) * NumIterations * ObjectsHeldPerIteration * 2;
+
+		FObjectPoolContainer Pool;
+		Pool.Initialize(World, MakeConfig(PoolSize));
+
+		FLegacyPool LegacyPool;
+		TArray<UObject*> LegacyObjects;
+		for (int32 i = 0; i < PoolSize; ++i)
+		{
+			UObject* Object = NewObject<UObjectPoolBenchmarkObject>(World);
+			LegacyObjects.Add(Object);
+			LegacyPool.Add(Object);
+		}
+
+		const double LegacyStart = FPlatformTime::Seconds();
+		ParallelFor(NumThreads, [&LegacyPool, NumIterations](int32)
+		{
+			UObject* Held[ObjectsHeldPerIteration];
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (UObject*& Object : Held)
+				{
+					Object = LegacyPool.Acquire();
+				}
+				for (UObject* Object : Held)
+				{
+					LegacyPool.Release(Object);
+				}
+			}
+		});
+		const double LegacySeconds = FPlatformTime::Seconds() - LegacyStart;
+
+		const double ObjectStart = FPlatformTime::Seconds();
+		ParallelFor(NumThreads, [&Pool, NumIterations](int32)
+		{
+			UObject* Held[ObjectsHeldPerIteration];
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (UObject*& Object : Held)
+				{
+					Object = Pool.Acquire();
+				}
+				for (UObject* Object : Held)
+				{
+					Pool.Release(Object);
+				}
+			}
+		});
+		const double ObjectSeconds = FPlatformTime::Seconds() - ObjectStart;
+
+		const double HandleStart = FPlatformTime::Seconds();
+		ParallelFor(NumThreads, [&Pool, NumIterations](int32)
+		{
+			FObjectPoolHandle Held[ObjectsHeldPerIteration];
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (FObjectPoolHandle& Handle : Held)
+				{
+					Pool.Acquire(Handle);
+				}
+				for (const FObjectPoolHandle& Handle : Held)
+				{
+					Pool.Release(Handle);
+				}
+			}
+		});
+		const double HandleSeconds = FPlatformTime::Seconds() - HandleStart;
+
+		Pool.Shutdown();
+		for (UObject* Object : LegacyObjects)
+		{
+			Object->MarkAsGarbage();
+		}
+
+		UE_LOG(LogObjectPool, Display, TEXT("ObjectPool Benchmark: %d 线程 x %d 次迭代, 每次持有 %d 个对象"), NumThreads, NumIterations, ObjectsHeldPerIteration);
+		UE_LOG(LogObjectPool, Display, TEXT("  旧实现(临界区):   %.3f s, %.2f M ops/s"), LegacySeconds, NumOps / LegacySeconds / 1e6);
+		UE_LOG(LogObjectPool, Display, TEXT("  无锁池(按对象):   %.3f s, %.2f M ops/s"), ObjectSeconds, NumOps / ObjectSeconds / 1e6);
+		UE_LOG(LogObjectPool, Display, TEXT("  无锁池(按句柄):   %.3f s, %.2f M ops/s"), HandleSeconds, NumOps / HandleSeconds / 1e6);
+	}
+
+	/**
+	 * 多线程压力测试
+	 * 校验：同一对象不会同时被两个线程持有；重复释放和过期句柄释放都被拒绝；结束时计数一致
+	 * 用法：Yc.ObjectPool.StressTest [线程数=8] [每线程迭代次数=200000]
+	 */
+	void RunStressTest(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumThreads = FMath::Max(1, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 8);
+		const int32 NumIterations = FMath::Max(1, Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 200000);
+
+		// 对象数量少于线程持有总数，保证出现池耗尽和激烈竞争
+		const int32 PoolSize = FMath::Max(1, NumThreads * ObjectsHeldPerIteration / 2);
+
+		FObjectPoolContainer Pool;
+		Pool.Initialize(World, MakeConfig(PoolSize));
+
+		// 每个槽位当前的持有线程（0 表示无人持有）
+		TUniquePtr<std::atomic<int32>[]> SlotOwners = MakeUnique<std::atomic<int32>[]>(PoolSize);
+		for (int32 Index = 0; Index < PoolSize; ++Index)
+		{
+			SlotOwners[Index].store(0);
+		}
+
+		std::atomic<int32> OwnershipViolations{0};
+		std::atomic<int32> AcceptedDoubleReleases{0};
+		std::atomic<int32> AcceptedStaleReleases{0};
+		std::atomic<int64> SuccessfulAcquires{0};
+
+		const double StartTime = FPlatformTime::Seconds();
+		ParallelFor(NumThreads, [&](int32 ThreadIndex)
+		{
+			FObjectPoolHandle Held[ObjectsHeldPerIteration];
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (FObjectPoolHandle& Handle : Held)
+				{
+					if (Pool.Acquire(Handle) == nullptr)
+					{
+						continue;
+					}
+
+					SuccessfulAcquires.fetch_add(1, std::memory_order_relaxed);
+					if (SlotOwners[Handle.Index].exchange(ThreadIndex + 1) != 0)
+					{
+						OwnershipViolations.fetch_add(1);
+					}
+				}
+
+				for (const FObjectPoolHandle& Handle : Held)
+				{
+					if (!Handle.IsValid())
+					{
+						continue;
+					}
+
+					SlotOwners[Handle.Index].store(0);
+					Pool.Release(Handle);
+
+					// 同一句柄再次释放必须失败（对象可能已被其他线程重新获取，代数已变化）
+					if ((Iteration & 7) == 0 && Pool.Release(Handle))
+					{
+						AcceptedDoubleReleases.fetch_add(1);
+					}
+
+					// 伪造的过期句柄必须失败
+					if ((Iteration & 15) == 0)
+					{
+						FObjectPoolHandle Stale = Handle;
+						Stale.Generation -= 1;
+						if (Pool.Release(Stale))
+						{
+							AcceptedStaleReleases.fetch_add(1);
+						}
+					}
+				}
+			}
+		});
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		const FObjectPoolStats Stats = Pool.GetStats();
+		const bool bCountsConsistent = Stats.ActiveCount == 0 && Stats.AvailableCount == Stats.TotalCount && Stats.TotalCount == PoolSize;
+		const bool bPassed = OwnershipViolations == 0 && AcceptedDoubleReleases == 0 && AcceptedStaleReleases == 0 && bCountsConsistent;
+
+		Pool.Shutdown();
+
+		UE_LOG(LogObjectPool, Display, TEXT("ObjectPool StressTest %s: %d 线程 x %d 次迭代, 池大小 %d, 用时 %.3f s"),
+			bPassed ? TEXT("PASSED") : TEXT("FAILED"), NumThreads, NumIterations, PoolSize, Seconds);
+		UE_LOG(LogObjectPool, Display, TEXT("  成功获取 %lld 次, 获取失败(池耗尽) %lld 次"), SuccessfulAcquires.load(), Stats.AcquireFailCount);
+		UE_LOG(LogObjectPool, Display, TEXT("  重复持有 %d, 重复释放被接受 %d, 过期句柄被接受 %d, 计数一致 %s"),
+			OwnershipViolations.load(), AcceptedDoubleReleases.load(), AcceptedStaleReleases.load(), bCountsConsistent ? TEXT("是") : TEXT("否"));
+	}
+
+	/**
+	 * 分帧预热测试，可在无渲染的服务器/-nullrhi 环境下运行
+	 * 逐帧调用 ProcessWarmup 模拟 Tick，校验：没有任何一帧超出预算；预热结束后对象数量达到目标
+	 * 用法：Yc.ObjectPool.WarmupTest [对象数=2000] [预算毫秒=Yc.ObjectPool.WarmupBudgetMs] [Actor]
+	 */
+	void RunWarmupTest(const TArray<FString>& Args, UWorld* World)
+	{
+		UObjectPoolSubsystem* Subsystem = World ? World->GetSubsystem<UObjectPoolSubsystem>() : nullptr;
+		if (!Subsystem)
+		{
+			UE_LOG(LogObjectPool, Warning, TEXT("ObjectPool WarmupTest: 当前世界没有 ObjectPoolSubsystem"));
+			return;
+		}
+
+		const IConsoleVariable* BudgetCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Yc.ObjectPool.WarmupBudgetMs"));
+		if (!BudgetCVar || BudgetCVar->GetFloat() <= 0.0f)
+		{
+			UE_LOG(LogObjectPool, Warning, TEXT("ObjectPool WarmupTest: Yc.ObjectPool.WarmupBudgetMs <= 0，分帧预热已关闭"));
+			return;
+		}
+
+		const int32 NumObjects = FMath::Max(1, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 2000);
+		const float BudgetMs = Args.Num() > 1 ? FCString::Atof(*Args[1]) : BudgetCVar->GetFloat();
+		const double BudgetSeconds = FMath::Max(BudgetMs, 0.01f) * 0.001;
+		const bool bUseActors = Args.Num() > 2 && Args[2].Equals(TEXT("Actor"), ESearchCase::IgnoreCase);
+
+		FObjectPoolConfig Config = MakeConfig(NumObjects);
+		Config.PoolID = TEXT("ObjectPoolWarmupTest");
+		Config.bWarmupOnRegister = false;
+		if (bUseActors)
+		{
+			Config.ObjectClass = AActor::StaticClass();
+		}
+
+		Subsystem->UnregisterPool(Config.PoolID);
+		if (!Subsystem->RegisterPool(Config))
+		{
+			return;
+		}
+
+		Subsystem->WarmupPool(Config.PoolID);
+
+		// 队列里可能还有其他池，测试同样覆盖它们
+		const int32 MaxFrames = NumObjects * 4 + 64;
+		int32 NumFrames = 0;
+		int32 OverBudgetFrames = 0;
+		double MaxFrameSeconds = 0.0;
+		const double StartTime = FPlatformTime::Seconds();
+		while (Subsystem->IsWarmingUp() && NumFrames < MaxFrames)
+		{
+			const double FrameStart = FPlatformTime::Seconds();
+			Subsystem->ProcessWarmup(BudgetSeconds);
+			const double FrameSeconds = FPlatformTime::Seconds() - FrameStart;
+
+			MaxFrameSeconds = FMath::Max(MaxFrameSeconds, FrameSeconds);
+			OverBudgetFrames += FrameSeconds > BudgetSeconds ? 1 : 0;
+			++NumFrames;
+		}
+		const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+		FObjectPoolStats Stats;
+		Subsystem->GetPoolStats(Config.PoolID, Stats);
+		Subsystem->UnregisterPool(Config.PoolID);
+
+		const bool bCompleted = !Subsystem->IsWarmingUp() && Stats.TotalCount == NumObjects;
+		const bool bPassed = bCompleted && OverBudgetFrames == 0;
+
+		UE_LOG(LogObjectPool, Display, TEXT("ObjectPool WarmupTest %s: %d 个%s, 预算 %.2f ms/帧"),
+			bPassed ? TEXT("PASSED") : TEXT("FAILED"), NumObjects, bUseActors ? TEXT("Actor") : TEXT("UObject"), BudgetMs);
+		UE_LOG(LogObjectPool, Display, TEXT("  %d 帧, 单帧最大 %.3f ms, 超预算 %d 帧, 总耗时 %.3f ms, 完成 %s (%d/%d)"),
+			NumFrames, MaxFrameSeconds * 1000.0, OverBudgetFrames, TotalSeconds * 1000.0,
+			bCompleted ? TEXT("是") : TEXT("否"), Stats.TotalCount, NumObjects);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+		TEXT("Yc.ObjectPool.Benchmark"),
+		TEXT("对象池获取/释放吞吐量对比：Yc.ObjectPool.Benchmark [线程数=8] [每线程迭代次数=100000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBenchmark));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdStressTest(
+		TEXT("Yc.ObjectPool.StressTest"),
+		TEXT("对象池多线程压力测试：Yc.ObjectPool.StressTest [线程数=8] [每线程迭代次数=200000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunStressTest));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdWarmupTest(
+		TEXT("Yc.ObjectPool.WarmupTest"),
+		TEXT("对象池分帧预热测试：Yc.ObjectPool.WarmupTest [对象数=2000] [预算毫秒] [Actor]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunWarmupTest));
+}
@@ -0,0 +1,17 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "ObjectPoolBenchmark.generated.h"
+
+/**
+ * 对象池性能测试/压力测试使用的空对象
+ * 不实现 IPoolableObject，测试结果只反映池自身的簿记开销
+ */
+UCLASS(Transient, NotBlueprintable)
+class UObjectPoolBenchmarkObject : public UObject
+{
+	GENERATED_BODY()
+};
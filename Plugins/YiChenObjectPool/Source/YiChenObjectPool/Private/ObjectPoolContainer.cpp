@@ -5,7 +5,27 @@
 
 DEFINE_LOG_CATEGORY(LogObjectPool);
 
+namespace ObjectPoolFreeList
+{
+	/** 空闲链表头打包：低 32 位为槽位索引，高 32 位为 ABA 计数 */
+	FORCEINLINE uint64 Pack(int32 Index, uint32 Tag)
+	{
+		return (static_cast<uint64>(Tag) << 32) | static_cast<uint32>(Index);
+	}
+
+	FORCEINLINE int32 UnpackIndex(uint64 Head)
+	{
+		return static_cast<int32>(static_cast<uint32>(Head));
+	}
+
+	FORCEINLINE uint32 UnpackTag(uint64 Head)
+	{
+		return static_cast<uint32>(Head >> 32);
+	}
+}
+
 FObjectPoolContainer::FObjectPoolContainer()
+	: FreeListHead(ObjectPoolFreeList::Pack(INDEX_NONE, 0))
 {
 }
 
@@ -14,48 +34,50 @@ FObjectPoolContainer::~FObjectPoolContainer()
 	Shutdown();
 }
 
-bool FObjectPoolContainer::Initialize(UWorld* InWorld, const FObjectPoolConfig& InConfig)
+bool FObjectPoolContainer::Initialize(UWorld* InWorld, const FObjectPoolConfig& InConfig, bool bDeferWarmup)
 {
-	FScopeLock Lock(&PoolLock);
-
-	if (bIsInitialized)
 	{
-		UE_LOG(LogObjectPool, Warning, TEXT("Pool [%s] already initialized"), *InConfig.PoolID.ToString());
-		return false;
-	}
+		FScopeLock Lock(&StructureLock);
 
-	if (!InConfig.IsValid())
-	{
-		UE_LOG(LogObjectPool, Error, TEXT("Invalid pool config for [%s]"), *InConfig.PoolID.ToString());
-		return false;
-	}
+		if (bIsInitialized)
+		{
+			UE_LOG(LogObjectPool, Warning, TEXT("Pool [%s] already initialized"), *InConfig.PoolID.ToString());
+			return false;
+		}
 
-	if (!InWorld)
-	{
-		UE_LOG(LogObjectPool, Error, TEXT("World is null for pool [%s]"), *InConfig.PoolID.ToString());
-		return false;
-	}
+		if (!InConfig.IsValid())
+		{
+			UE_LOG(LogObjectPool, Error, TEXT("Invalid pool config for [%s]"), *InConfig.PoolID.ToString());
+			return false;
+		}
 
-	World = InWorld;
-	Config = InConfig;
+		if (!InWorld)
+		{
+			UE_LOG(LogObjectPool, Error, TEXT("World is null for pool [%s]"), *InConfig.PoolID.ToString());
+			return false;
+		}
 
-	// 检测是否为Actor类
-	bIsActorPool = Config.bIsActorPool || Config.ObjectClass->IsChildOf(AActor::StaticClass());
+		World = InWorld;
+		Config = InConfig;
 
-	// 预分配内存
-	const int32 ReserveSize = Config.MaxSize > 0 ? Config.MaxSize : Config.InitialSize * 2;
-	AllObjects.Reserve(ReserveSize);
-	AvailableIndices.Reserve(ReserveSize);
+		// 检测是否为Actor类
+		bIsActorPool = Config.bIsActorPool || Config.ObjectClass->IsChildOf(AActor::StaticClass());
+		bIsPoolableClass = Config.ObjectClass->ImplementsInterface(UPoolableObject::StaticClass());
 
-	bIsInitialized = true;
+		// 预分配映射表
+		const int32 ReserveSize = FMath::Min(Config.MaxSize > 0 ? Config.MaxSize : Config.InitialSize * 2, MaxCapacity);
+		ObjectToIndexMap.Reserve(ReserveSize);
 
-	UE_LOG(LogObjectPool, Log, TEXT("Pool [%s] initialized (Class: %s, IsActor: %s)"),
-		*Config.PoolID.ToString(),
-		*Config.ObjectClass->GetName(),
-		bIsActorPool ? TEXT("Yes") : TEXT("No"));
+		bIsInitialized = true;
+
+		UE_LOG(LogObjectPool, Log, TEXT("Pool [%s] initialized (Class: %s, IsActor: %s)"),
+			*Config.PoolID.ToString(),
+			*Config.ObjectClass->GetName(),
+			bIsActorPool ? TEXT("Yes") : TEXT("No"));
+	}
 
-	// 预热
-	if (Config.bWarmupOnRegister && Config.InitialSize > 0)
+	// 预热在锁外进行
+	if (Config.bWarmupOnRegister && !bDeferWarmup && Config.InitialSize > 0)
 	{
 		Warmup(Config.InitialSize);
 	}
@@ -65,121 +87,156 @@ bool FObjectPoolContainer::Initialize(UWorld* InWorld, const FObjectPoolConfig&
 
 void FObjectPoolContainer::Shutdown()
 {
-	FScopeLock Lock(&PoolLock);
-
-	if (!bIsInitialized)
+	TArray<UObject*> RemovedObjects;
 	{
-		return;
-	}
+		FScopeLock Lock(&StructureLock);
 
-	UE_LOG(LogObjectPool, Log, TEXT("Shutting down pool [%s]"), *Config.PoolID.ToString());
+		if (!bIsInitialized)
+		{
+			return;
+		}
 
-	// 销毁所有对象
-	for (const TWeakObjectPtr<UObject>& WeakObj : AllObjects)
-	{
-		if (UObject* Obj = WeakObj.Get())
+		UE_LOG(LogObjectPool, Log, TEXT("Shutting down pool [%s]"), *Config.PoolID.ToString());
+
+		// 摘出所有对象
+		const int32 SlotCount = NumSlots.load(std::memory_order_acquire);
+		RemovedObjects.Reserve(SlotCount);
+		for (int32 Index = 0; Index < SlotCount; ++Index)
 		{
-			// 通知对象即将被移除
-			if (IPoolableObject* Poolable = Cast<IPoolableObject>(Obj))
+			if (UObject* Obj = GetSlot(Index).Object.Get())
 			{
-				Poolable->OnRemovedFromPool();
+				RemovedObjects.Add(Obj);
 			}
-			DestroyObject(Obj);
 		}
+
+		// 槽位块留到析构时释放：子系统注销池时，其他调用者可能仍持有池的共享引用并正在访问槽位，
+		// 例如激活/停用回调中注销了当前池
+
+		{
+			FWriteScopeLock MapLock(ObjectMapLock);
+			ObjectToIndexMap.Empty();
+		}
+
+		EmptySlots.Empty();
+		NumSlots.store(0, std::memory_order_release);
+		FreeListHead.store(ObjectPoolFreeList::Pack(INDEX_NONE, 0), std::memory_order_release);
+		TotalCount.store(0, std::memory_order_relaxed);
+		AvailableCount.store(0, std::memory_order_relaxed);
+		ActiveCount.store(0, std::memory_order_relaxed);
+		bIsInitialized = false;
 	}
 
-	AllObjects.Empty();
-	AvailableIndices.Empty();
-	ObjectToIndexMap.Empty();
-	ActiveCount = 0;
-	bIsInitialized = false;
+	// 销毁在锁外进行
+	DestroyRemovedObjects(RemovedObjects);
 }
 
 
-void FObjectPoolContainer::Warmup(int32 Count)
+int32 FObjectPoolContainer::Warmup(int32 Count, double DeadlineSeconds)
 {
-	FScopeLock Lock(&PoolLock);
+	check(IsInGameThread());
 
 	if (!bIsInitialized)
 	{
-		return;
+		return 0;
 	}
 
-	const int32 TargetCount = (Count < 0) ? Config.InitialSize : Count;
-	const int32 CurrentCount = AllObjects.Num();
-	int32 ToCreate = TargetCount - CurrentCount;
+	const int32 ToCreate = GetWarmupDeficit(Count);
+	if (ToCreate <= 0)
+	{
+		return 0;
+	}
 
-	if (Config.MaxSize > 0)
+	if (DeadlineSeconds <= 0.0)
 	{
-		ToCreate = FMath::Min(ToCreate, Config.MaxSize - CurrentCount);
+		UE_LOG(LogObjectPool, Log, TEXT("Warming up pool [%s]: creating %d objects"), *Config.PoolID.ToString(), ToCreate);
 	}
 
-	if (ToCreate <= 0)
+	return CreatePooledObjects(ToCreate, DeadlineSeconds);
+}
+
+int32 FObjectPoolContainer::GetWarmupDeficit(int32 Count) const
+{
+	if (!bIsInitialized)
 	{
-		return;
+		return 0;
 	}
 
-	UE_LOG(LogObjectPool, Log, TEXT("Warming up pool [%s]: creating %d objects"), *Config.PoolID.ToString(), ToCreate);
+	const int32 TargetCount = (Count < 0) ? Config.InitialSize : Count;
+	const int32 CurrentCount = GetTotalCount();
+	int32 Deficit = TargetCount - CurrentCount;
 
-	for (int32 i = 0; i < ToCreate; ++i)
+	if (Config.MaxSize > 0)
 	{
-		UObject* NewObj = CreateObject();
-		if (NewObj)
-		{
-			const int32 Index = AllObjects.Add(NewObj);
-			AvailableIndices.Add(Index);
-			ObjectToIndexMap.Add(NewObj, Index);
-			DeactivateObject(NewObj);
-		}
+		Deficit = FMath::Min(Deficit, Config.MaxSize - CurrentCount);
 	}
+
+	return FMath::Max(0, Deficit);
 }
 
 UObject* FObjectPoolContainer::Acquire()
 {
-	FScopeLock Lock(&PoolLock);
+	FObjectPoolHandle Handle;
+	return Acquire(Handle);
+}
+
+UObject* FObjectPoolContainer::Acquire(FObjectPoolHandle& OutHandle)
+{
+	OutHandle.Reset();
 
 	if (!bIsInitialized)
 	{
 		return nullptr;
 	}
 
-	TotalAcquireCount++;
+	checkf(!RequiresGameThread() || IsInGameThread(), TEXT("Pool [%s] activates objects on acquire and must be used on the game thread"), *Config.PoolID.ToString());
+
+	TotalAcquireCount.fetch_add(1, std::memory_order_relaxed);
+
+	// 暂时不能获取的对象，结束后放回空闲链表
+	TArray<int32, TInlineAllocator<8>> SkippedSlots;
 
-	// 尝试从可用队列获取
-	while (AvailableIndices.Num() > 0)
+	auto TryAcquireFromFreeList = [this, &SkippedSlots, &OutHandle]() -> UObject*
 	{
-		const int32 Index = AvailableIndices.Pop(EAllowShrinking::No);
-		
-		if (!AllObjects.IsValidIndex(Index))
+		int32 Index;
+		while ((Index = PopFreeSlot()) != INDEX_NONE)
 		{
-			continue;
-		}
+			AvailableCount.fetch_sub(1, std::memory_order_relaxed);
 
-		UObject* Obj = AllObjects[Index].Get();
-		if (!IsValid(Obj))
-		{
-			continue;
-		}
+			FSlot& Slot = GetSlot(Index);
+			UObject* Obj = Slot.Object.Get();
+			if (!IsValid(Obj))
+			{
+				continue;
+			}
 
-		// 检查接口
-		IPoolableObject* Poolable = Cast<IPoolableObject>(Obj);
-		if (Poolable && !Poolable->CanBeAcquired())
-		{
-			continue;
-		}
+			// 检查接口
+			IPoolableObject* Poolable = Cast<IPoolableObject>(Obj);
+			if (Poolable && !Poolable->CanBeAcquired())
+			{
+				SkippedSlots.Add(Index);
+				continue;
+			}
 
-		// 激活对象
-		ActivateObject(Obj);
-		ActiveCount++;
-		PeakActiveCount = FMath::Max(PeakActiveCount, ActiveCount);
+			// 槽位已从空闲链表中取出，只有当前线程持有，直接清除在池标记
+			const uint32 State = Slot.State.load(std::memory_order_relaxed);
+			Slot.State.store(State & ~InPoolBit, std::memory_order_release);
 
-		return Obj;
-	}
+			OutHandle.Index = Index;
+			OutHandle.Generation = State >> 1;
+
+			UpdatePeakActiveCount(ActiveCount.fetch_add(1, std::memory_order_relaxed) + 1);
+
+			return Obj;
+		}
+		return nullptr;
+	};
 
-	// 池耗尽，尝试扩容
-	if (Config.bAllowGrowth)
+	UObject* Result = TryAcquireFromFreeList();
+
+	// 池耗尽，尝试扩容（创建对象只能在游戏线程进行）
+	if (!Result && Config.bAllowGrowth && IsInGameThread())
 	{
-		const int32 CurrentCount = AllObjects.Num();
+		const int32 CurrentCount = GetTotalCount();
 		if (Config.MaxSize == 0 || CurrentCount < Config.MaxSize)
 		{
 			const int32 GrowAmount = Config.MaxSize > 0 
@@ -188,77 +245,285 @@ UObject* FObjectPoolContainer::Acquire()
 
 			if (GrowAmount > 0)
 			{
-				// 临时解锁以避免死锁
-				PoolLock.Unlock();
 				Grow(GrowAmount);
-				PoolLock.Lock();
 
 				// 再次尝试获取
-				if (AvailableIndices.Num() > 0)
-				{
-					const int32 Index = AvailableIndices.Pop(EAllowShrinking::No);
-					if (AllObjects.IsValidIndex(Index))
-					{
-						UObject* Obj = AllObjects[Index].Get();
-						if (IsValid(Obj))
-						{
-							ActivateObject(Obj);
-							ActiveCount++;
-							PeakActiveCount = FMath::Max(PeakActiveCount, ActiveCount);
-							return Obj;
-						}
-					}
-				}
+				Result = TryAcquireFromFreeList();
 			}
 		}
 	}
 
+	for (const int32 Index : SkippedSlots)
+	{
+		PushFreeSlot(Index);
+	}
+
+	if (Result)
+	{
+		// 槽位已归当前调用者，激活在上面的游戏线程检查保护下进行
+		if (RequiresGameThread())
+		{
+			ActivateObject(Result);
+		}
+		return Result;
+	}
+
 	// 获取失败
-	AcquireFailCount++;
-	UE_LOG(LogObjectPool, Warning, TEXT("Pool [%s] exhausted! Total: %d, Active: %d, Max: %d"),
-		*Config.PoolID.ToString(), AllObjects.Num(), ActiveCount, Config.MaxSize);
+	AcquireFailCount.fetch_add(1, std::memory_order_relaxed);
+	LogExhausted();
 
 	return nullptr;
 }
 
-bool FObjectPoolContainer::Release(UObject* Object)
+void FObjectPoolContainer::LogExhausted()
 {
-	FScopeLock Lock(&PoolLock);
+	// 多线程高频获取时池耗尽可能每次迭代都发生，限流避免刷屏
+	const uint64 NowCycles = FPlatformTime::Cycles64();
+	uint64 LastCycles = LastExhaustedLogCycles.load(std::memory_order_relaxed);
+	if (LastCycles != 0 && FPlatformTime::ToSeconds64(NowCycles - LastCycles) < 1.0)
+	{
+		return;
+	}
 
+	if (!LastExhaustedLogCycles.compare_exchange_strong(LastCycles, NowCycles, std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	const int64 FailCount = AcquireFailCount.load(std::memory_order_relaxed);
+	const int64 NewFailures = FailCount - LastExhaustedLogFailCount.exchange(FailCount, std::memory_order_relaxed);
+	UE_LOG(LogObjectPool, Warning, TEXT("Pool [%s] exhausted! Total: %d, Active: %d, Max: %d (%lld failed acquires since last report)"),
+		*Config.PoolID.ToString(), GetTotalCount(), GetActiveCount(), Config.MaxSize, NewFailures);
+}
+
+bool FObjectPoolContainer::Release(UObject* Object)
+{
 	if (!bIsInitialized || !IsValid(Object))
 	{
 		return false;
 	}
 
-	const int32* IndexPtr = ObjectToIndexMap.Find(Object);
-	if (!IndexPtr)
+	const int32 Index = FindSlotIndex(Object);
+	if (Index == INDEX_NONE)
 	{
 		UE_LOG(LogObjectPool, Warning, TEXT("Object [%s] not managed by pool [%s]"),
 			*Object->GetName(), *Config.PoolID.ToString());
 		return false;
 	}
 
-	const int32 Index = *IndexPtr;
+	return ReleaseSlot(Index, nullptr);
+}
 
-	// 检查是否已在可用队列中
-	if (AvailableIndices.Contains(Index))
+bool FObjectPoolContainer::Release(const FObjectPoolHandle& Handle, UObject** OutObject)
+{
+	if (!bIsInitialized || !Handle.IsValid() || Handle.Index >= NumSlots.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	return ReleaseSlot(Handle.Index, &Handle.Generation, OutObject);
+}
+
+bool FObjectPoolContainer::Contains(const UObject* Object) const
+{
+	return Object && FindSlotIndex(Object) != INDEX_NONE;
+}
+
+bool FObjectPoolContainer::ReleaseSlot(int32 Index, const uint32* ExpectedGeneration, UObject** OutObject)
+{
+	checkf(!RequiresGameThread() || IsInGameThread(), TEXT("Pool [%s] deactivates objects on release and must be used on the game thread"), *Config.PoolID.ToString());
+
+	FSlot& Slot = GetSlot(Index);
+
+	uint32 State = Slot.State.load(std::memory_order_acquire);
+
+	// 已在池中：重复释放
+	if (State & InPoolBit)
+	{
+		return false;
+	}
+
+	// 代数不匹配：句柄已过期
+	const uint32 Generation = State >> 1;
+	if (ExpectedGeneration && *ExpectedGeneration != Generation)
+	{
+		return false;
+	}
+
+	// 代数加一并标记在池中，并发的重复释放只有一个能成功
+	const uint32 NewState = ((Generation + 1) << 1) | InPoolBit;
+	if (!Slot.State.compare_exchange_strong(State, NewState, std::memory_order_acq_rel, std::memory_order_relaxed))
 	{
 		return false;
 	}
 
 	// 停用对象
-	DeactivateObject(Object);
+	UObject* Obj = Slot.Object.Get();
+	if (RequiresGameThread())
+	{
+		DeactivateObject(Obj);
+	}
+
+	// 放回空闲链表
+	ActiveCount.fetch_sub(1, std::memory_order_relaxed);
+	PushFreeSlot(Index);
 
-	// 添加到可用队列
-	AvailableIndices.Add(Index);
-	ActiveCount = FMath::Max(0, ActiveCount - 1);
+	if (OutObject)
+	{
+		*OutObject = Obj;
+	}
+
+	return true;
+}
+
+int32 FObjectPoolContainer::PopFreeSlot()
+{
+	uint64 Head = FreeListHead.load(std::memory_order_acquire);
+	for (;;)
+	{
+		const int32 Index = ObjectPoolFreeList::UnpackIndex(Head);
+		if (Index == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+
+		// 读到的 NextFree 可能已过期，此时 ABA 计数不同，CAS 会失败并重试
+		const int32 Next = GetSlot(Index).NextFree.load(std::memory_order_relaxed);
+		const uint64 NewHead = ObjectPoolFreeList::Pack(Next, ObjectPoolFreeList::UnpackTag(Head) + 1);
+		if (FreeListHead.compare_exchange_weak(Head, NewHead, std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			return Index;
+		}
+	}
+}
+
+void FObjectPoolContainer::PushFreeSlot(int32 Index)
+{
+	FSlot& Slot = GetSlot(Index);
+
+	uint64 Head = FreeListHead.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		Slot.NextFree.store(ObjectPoolFreeList::UnpackIndex(Head), std::memory_order_relaxed);
+		const uint64 NewHead = ObjectPoolFreeList::Pack(Index, ObjectPoolFreeList::UnpackTag(Head) + 1);
+		if (FreeListHead.compare_exchange_weak(Head, NewHead, std::memory_order_release, std::memory_order_relaxed))
+		{
+			break;
+		}
+	}
+
+	AvailableCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+int32 FObjectPoolContainer::FindSlotIndex(const UObject* Object) const
+{
+	FReadScopeLock MapLock(ObjectMapLock);
+	const int32* IndexPtr = ObjectToIndexMap.Find(FObjectKey(Object));
+	return IndexPtr ? *IndexPtr : INDEX_NONE;
+}
+
+void FObjectPoolContainer::UpdatePeakActiveCount(int32 NewActiveCount)
+{
+	int32 Peak = PeakActiveCount.load(std::memory_order_relaxed);
+	while (NewActiveCount > Peak && !PeakActiveCount.compare_exchange_weak(Peak, NewActiveCount, std::memory_order_relaxed))
+	{
+	}
+}
+
+int32 FObjectPoolContainer::CreatePooledObjects(int32 Count, double DeadlineSeconds)
+{
+	int32 Created = 0;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		// 限时创建：预计下一个对象会超出截止时间就停止
+		const double CreateStart = FPlatformTime::Seconds();
+		if (DeadlineSeconds > 0.0 && CreateStart + AverageCreateSeconds > DeadlineSeconds)
+		{
+			break;
+		}
+
+		// 生成时不持有锁，生成回调可以重入池接口
+		UObject* NewObj = CreatePoolObject(World.Get(), Config);
+		if (!NewObj)
+		{
+			continue;
+		}
+
+		if (!AddPooledObject(NewObj))
+		{
+			DestroyObject(NewObj);
+			break;
+		}
+		++Created;
+
+		const double CreateSeconds = FPlatformTime::Seconds() - CreateStart;
+		AverageCreateSeconds = AverageCreateSeconds > 0.0 ? FMath::Lerp(AverageCreateSeconds, CreateSeconds, 0.125) : CreateSeconds;
+	}
+
+	return Created;
+}
+
+bool FObjectPoolContainer::AddPooledObject(UObject* Object)
+{
+	if (!IsValid(Object))
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&StructureLock);
+
+	if (!bIsInitialized || (Config.MaxSize > 0 && GetTotalCount() >= Config.MaxSize))
+	{
+		return false;
+	}
+
+	// 优先复用收缩空出的槽位，否则分配新槽位
+	int32 Index = INDEX_NONE;
+	if (EmptySlots.Num() > 0)
+	{
+		Index = EmptySlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		const int32 SlotCount = NumSlots.load(std::memory_order_relaxed);
+		if (SlotCount >= MaxCapacity)
+		{
+			UE_LOG(LogObjectPool, Warning, TEXT("Pool [%s] reached max capacity %d"), *Config.PoolID.ToString(), MaxCapacity);
+			return false;
+		}
+
+		TUniquePtr<FSlot[]>& Chunk = Chunks[SlotCount / SlotsPerChunk];
+		if (!Chunk.IsValid())
+		{
+			Chunk = MakeUnique<FSlot[]>(SlotsPerChunk);
+		}
+
+		Index = SlotCount;
+		NumSlots.store(SlotCount + 1, std::memory_order_release);
+	}
+
+	FSlot& Slot = GetSlot(Index);
+	Slot.Object = Object;
+	Slot.ObjectKey = FObjectKey(Object);
+
+	// 代数加一，槽位上一个对象的句柄全部失效
+	const uint32 Generation = (Slot.State.load(std::memory_order_relaxed) >> 1) + 1;
+	Slot.State.store((Generation << 1) | InPoolBit, std::memory_order_relaxed);
+
+	{
+		FWriteScopeLock MapLock(ObjectMapLock);
+		ObjectToIndexMap.Add(Slot.ObjectKey, Index);
+	}
+
+	TotalCount.fetch_add(1, std::memory_order_relaxed);
+	PushFreeSlot(Index);
 
 	return true;
 }
 
 void FObjectPoolContainer::Grow(int32 Amount)
 {
-	FScopeLock Lock(&PoolLock);
+	check(IsInGameThread());
 
 	if (!bIsInitialized || Amount <= 0)
 	{
@@ -268,7 +533,7 @@ void FObjectPoolContainer::Grow(int32 Amount)
 	int32 ActualAmount = Amount;
 	if (Config.MaxSize > 0)
 	{
-		ActualAmount = FMath::Min(Amount, Config.MaxSize - AllObjects.Num());
+		ActualAmount = FMath::Min(Amount, Config.MaxSize - GetTotalCount());
 	}
 
 	if (ActualAmount <= 0)
@@ -278,91 +543,85 @@ void FObjectPoolContainer::Grow(int32 Amount)
 
 	UE_LOG(LogObjectPool, Log, TEXT("Growing pool [%s] by %d"), *Config.PoolID.ToString(), ActualAmount);
 
-	for (int32 i = 0; i < ActualAmount; ++i)
-	{
-		UObject* NewObj = CreateObject();
-		if (NewObj)
-		{
-			const int32 Index = AllObjects.Add(NewObj);
-			AvailableIndices.Add(Index);
-			ObjectToIndexMap.Add(NewObj, Index);
-			DeactivateObject(NewObj);
-		}
-	}
+	CreatePooledObjects(ActualAmount);
 
 	GrowthCount++;
 }
 
 void FObjectPoolContainer::Shrink()
 {
-	FScopeLock Lock(&PoolLock);
+	TArray<UObject*> RemovedObjects;
+	Shrink(RemovedObjects);
+	DestroyRemovedObjects(RemovedObjects);
+}
+
+int32 FObjectPoolContainer::Shrink(TArray<UObject*>& OutRemovedObjects)
+{
+	FScopeLock Lock(&StructureLock);
 
 	if (!bIsInitialized || !Config.bAllowShrink)
 	{
-		return;
+		return 0;
 	}
 
-	const int32 TotalCount = AllObjects.Num();
-	if (TotalCount == 0)
+	const int32 CurrentTotal = GetTotalCount();
+	if (CurrentTotal == 0)
 	{
-		return;
+		return 0;
 	}
 
-	const float IdleRatio = static_cast<float>(AvailableIndices.Num()) / TotalCount;
+	const float IdleRatio = static_cast<float>(GetAvailableCount()) / CurrentTotal;
 	if (IdleRatio < Config.ShrinkThreshold)
 	{
-		return;
+		return 0;
 	}
 
 	// 保留至少InitialSize个对象
-	const int32 TargetCount = FMath::Max(Config.InitialSize, ActiveCount + Config.GrowthStep);
-	const int32 ToRemove = TotalCount - TargetCount;
+	const int32 TargetCount = FMath::Max(Config.InitialSize, GetActiveCount() + Config.GrowthStep);
+	const int32 ToRemove = CurrentTotal - TargetCount;
 
 	if (ToRemove <= 0)
 	{
-		return;
+		return 0;
 	}
 
 	UE_LOG(LogObjectPool, Log, TEXT("Shrinking pool [%s]: removing %d objects"), *Config.PoolID.ToString(), ToRemove);
 
 	int32 Removed = 0;
-	for (int32 i = AvailableIndices.Num() - 1; i >= 0 && Removed < ToRemove; --i)
+	int32 Index;
+	while (Removed < ToRemove && (Index = PopFreeSlot()) != INDEX_NONE)
 	{
-		const int32 Index = AvailableIndices[i];
-		if (!AllObjects.IsValidIndex(Index))
-		{
-			AvailableIndices.RemoveAt(i);
-			continue;
-		}
+		AvailableCount.fetch_sub(1, std::memory_order_relaxed);
 
-		UObject* Obj = AllObjects[Index].Get();
-		if (!IsValid(Obj))
+		FSlot& Slot = GetSlot(Index);
+
+		// 只摘出，通知和销毁由调用者在锁外进行
+		if (UObject* Obj = Slot.Object.Get())
 		{
-			AvailableIndices.RemoveAt(i);
-			AllObjects[Index].Reset();
-			continue;
+			OutRemovedObjects.Add(Obj);
 		}
 
-		// 通知并销毁
-		if (IPoolableObject* Poolable = Cast<IPoolableObject>(Obj))
 		{
-			Poolable->OnRemovedFromPool();
+			FWriteScopeLock MapLock(ObjectMapLock);
+			ObjectToIndexMap.Remove(Slot.ObjectKey);
 		}
 
-		ObjectToIndexMap.Remove(Obj);
-		DestroyObject(Obj);
-		AllObjects[Index].Reset();
-		AvailableIndices.RemoveAt(i);
+		// 清除在池标记并使旧句柄失效，槽位留给下次扩容复用
+		const uint32 Generation = (Slot.State.load(std::memory_order_relaxed) >> 1) + 1;
+		Slot.State.store(Generation << 1, std::memory_order_relaxed);
+		Slot.Object.Reset();
+		Slot.ObjectKey = FObjectKey();
+		EmptySlots.Add(Index);
+
+		TotalCount.fetch_sub(1, std::memory_order_relaxed);
 		Removed++;
 	}
 
-	// 压缩数组（可选，会影响性能但减少内存）
-	// AllObjects.RemoveAll([](const TWeakObjectPtr<UObject>& P) { return !P.IsValid(); });
-
 	ShrinkCount++;
+	return Removed;
 }
 
-void FObjectPoolContainer::CheckShrinkage(float CurrentTime)
+void FObjectPoolContainer::CheckShrinkage(float CurrentTime, TArray<UObject*>& OutRemovedObjects)
 {
 	if (!bIsInitialized || !Config.bAllowShrink)
 	{
@@ -372,51 +631,70 @@ void FObjectPoolContainer::CheckShrinkage(float CurrentTime)
 	if (CurrentTime - LastShrinkCheckTime >= Config.ShrinkCheckInterval)
 	{
 		LastShrinkCheckTime = CurrentTime;
-		Shrink();
+		Shrink(OutRemovedObjects);
+	}
+}
+
+void FObjectPoolContainer::DestroyRemovedObjects(const TArray<UObject*>& RemovedObjects)
+{
+	check(IsInGameThread());
+
+	for (UObject* Obj : RemovedObjects)
+	{
+		if (!IsValid(Obj))
+		{
+			continue;
+		}
+
+		// 通知对象即将被移除
+		if (IPoolableObject* Poolable = Cast<IPoolableObject>(Obj))
+		{
+			Poolable->OnRemovedFromPool();
+		}
+		DestroyObject(Obj);
 	}
 }
 
 
 FObjectPoolStats FObjectPoolContainer::GetStats() const
 {
-	FScopeLock Lock(&PoolLock);
-
 	FObjectPoolStats Stats;
 	Stats.PoolID = Config.PoolID;
 	Stats.ClassName = Config.ObjectClass ? Config.ObjectClass->GetName() : TEXT("None");
-	Stats.TotalCount = AllObjects.Num();
-	Stats.ActiveCount = ActiveCount;
-	Stats.AvailableCount = AvailableIndices.Num();
-	Stats.PeakActiveCount = PeakActiveCount;
-	Stats.TotalAcquireCount = TotalAcquireCount;
-	Stats.AcquireFailCount = AcquireFailCount;
+	Stats.TotalCount = GetTotalCount();
+	Stats.ActiveCount = GetActiveCount();
+	Stats.AvailableCount = GetAvailableCount();
+	Stats.PeakActiveCount = PeakActiveCount.load(std::memory_order_relaxed);
+	Stats.TotalAcquireCount = TotalAcquireCount.load(std::memory_order_relaxed);
+	Stats.AcquireFailCount = AcquireFailCount.load(std::memory_order_relaxed);
 	Stats.GrowthCount = GrowthCount;
 	Stats.ShrinkCount = ShrinkCount;
-	Stats.UsageRate = Stats.TotalCount > 0 ? static_cast<float>(ActiveCount) / Stats.TotalCount : 0.0f;
+	Stats.UsageRate = Stats.TotalCount > 0 ? static_cast<float>(Stats.ActiveCount) / Stats.TotalCount : 0.0f;
 	Stats.bIsActorPool = bIsActorPool;
 
 	return Stats;
 }
 
-UObject* FObjectPoolContainer::CreateObject()
+UObject* FObjectPoolContainer::CreatePoolObject(UWorld* InWorld, const FObjectPoolConfig& InConfig)
 {
-	UWorld* WorldPtr = World.Get();
-	if (!WorldPtr || !Config.ObjectClass)
+	check(IsInGameThread());
+
+	if (!InWorld || !InConfig.ObjectClass)
 	{
 		return nullptr;
 	}
 
 	UObject* NewObj = nullptr;
 
-	if (bIsActorPool)
+	if (InConfig.ObjectClass->IsChildOf(AActor::StaticClass()))
 	{
 		// Actor需要通过SpawnActor创建
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 		SpawnParams.ObjectFlags |= RF_Transient;
 
-		NewObj = WorldPtr->SpawnActor<AActor>(
-			static_cast<TSubclassOf<AActor>>(Config.ObjectClass),
+		NewObj = InWorld->SpawnActor<AActor>(
+			static_cast<TSubclassOf<AActor>>(InConfig.ObjectClass),
 			FVector::ZeroVector,
 			FRotator::ZeroRotator,
 			SpawnParams
@@ -425,13 +703,16 @@ UObject* FObjectPoolContainer::CreateObject()
 	else
 	{
 		// 普通UObject使用NewObject
-		NewObj = NewObject<UObject>(WorldPtr, Config.ObjectClass);
+		NewObj = NewObject<UObject>(InWorld, InConfig.ObjectClass);
 		if (NewObj)
 		{
 			NewObj->SetFlags(RF_Transient);
 		}
 	}
 
+	// 新对象以休眠状态入池
+	DeactivateObject(NewObj);
+
 	return NewObj;
 }
 
@@ -442,12 +723,9 @@ void FObjectPoolContainer::DestroyObject(UObject* Object)
 		return;
 	}
 
-	if (bIsActorPool)
+	if (AActor* Actor = Cast<AActor>(Object))
 	{
-		if (AActor* Actor = Cast<AActor>(Object))
-		{
-			Actor->Destroy();
-		}
+		Actor->Destroy();
 	}
 	else
 	{
@@ -470,14 +748,11 @@ void FObjectPoolContainer::ActivateObject(UObject* Object)
 	}
 
 	// Actor特殊处理
-	if (bIsActorPool)
+	if (AActor* Actor = Cast<AActor>(Object))
 	{
-		if (AActor* Actor = Cast<AActor>(Object))
-		{
-			Actor->SetActorHiddenInGame(false);
-			Actor->SetActorEnableCollision(true);
-			Actor->SetActorTickEnabled(true);
-		}
+		Actor->SetActorHiddenInGame(false);
+		Actor->SetActorEnableCollision(true);
+		Actor->SetActorTickEnabled(true);
 	}
 }
 
@@ -497,14 +772,11 @@ void FObjectPoolContainer::DeactivateObject(UObject* Object)
 	}
 
 	// Actor特殊处理
-	if (bIsActorPool)
+	if (AActor* Actor = Cast<AActor>(Object))
 	{
-		if (AActor* Actor = Cast<AActor>(Object))
-		{
-			Actor->SetActorHiddenInGame(true);
-			Actor->SetActorEnableCollision(false);
-			Actor->SetActorTickEnabled(false);
-			Actor->SetActorLocation(FVector::ZeroVector);
-		}
+		Actor->SetActorHiddenInGame(true);
+		Actor->SetActorEnableCollision(false);
+		Actor->SetActorTickEnabled(false);
+		Actor->SetActorLocation(FVector::ZeroVector);
 	}
 }
@@ -0,0 +1,157 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "ObjectPoolWarmupScheduler.h"
+#include "ObjectPoolContainer.h"
+
+int32 FObjectPoolWarmupScheduler::FindRequest(FName PoolID) const
+{
+	return Queue.IndexOfByPredicate([PoolID](const FRequest& Request) { return Request.PoolID == PoolID; });
+}
+
+void FObjectPoolWarmupScheduler::Enqueue(FName PoolID, int32 Count)
+{
+	check(IsInGameThread());
+
+	FObjectPoolWarmupPoolInfo Info;
+	if (!GetPoolInfo(PoolID, Info))
+	{
+		return;
+	}
+
+	const int32 ExistingIndex = FindRequest(PoolID);
+
+	FRequest NewRequest;
+	NewRequest.PoolID = PoolID;
+	NewRequest.TargetCount = (Count < 0) ? Info.DefaultCount : Count;
+	NewRequest.Priority = Info.Priority;
+	NewRequest.ExpectedDemand = Info.ExpectedDemand;
+
+	if (ExistingIndex != INDEX_NONE)
+	{
+		NewRequest.TargetCount = FMath::Max(NewRequest.TargetCount, Queue[ExistingIndex].TargetCount);
+	}
+
+	const int32 Deficit = GetDeficit(PoolID, NewRequest.TargetCount);
+
+	if (ExistingIndex != INDEX_NONE)
+	{
+		TotalCount += FMath::Max(0, Deficit - Queue[ExistingIndex].Remaining);
+		Queue.RemoveAt(ExistingIndex);
+	}
+	else
+	{
+		TotalCount += FMath::Max(0, Deficit);
+	}
+
+	if (Deficit <= 0)
+	{
+		return;
+	}
+
+	NewRequest.Remaining = Deficit;
+	Queue.Add(NewRequest);
+
+	// 优先级高的先预热，同优先级按预期需求量
+	Queue.StableSort([](const FRequest& A, const FRequest& B)
+	{
+		return A.Priority != B.Priority ? A.Priority > B.Priority : A.ExpectedDemand > B.ExpectedDemand;
+	});
+}
+
+FObjectPoolWarmupResult FObjectPoolWarmupScheduler::Process(double BudgetSeconds)
+{
+	check(IsInGameThread());
+
+	FObjectPoolWarmupResult Result;
+	if (Queue.Num() == 0)
+	{
+		return Result;
+	}
+
+	const double Deadline = BudgetSeconds > 0.0 ? FPlatformTime::Seconds() + BudgetSeconds : 0.0;
+
+	while (Queue.Num() > 0)
+	{
+		// 按值复制，创建对象的回调可能重入修改队列
+		const FRequest Request = Queue[0];
+
+		const int32 Deficit = GetDeficit(Request.PoolID, Request.TargetCount);
+		if (Deficit <= 0)
+		{
+			// 已达到目标或池已注销，剩余部分视为完成
+			CreatedCount += Request.Remaining;
+			Queue.RemoveAt(0);
+			continue;
+		}
+
+		// 预计下一个对象会超出截止时间就停止，本次还没有进展时至少创建一个
+		const double CreateStart = FPlatformTime::Seconds();
+		if (Deadline > 0.0 && Result.NumCreated > 0 && CreateStart + AverageCreateSeconds.FindRef(Request.PoolID) > Deadline)
+		{
+			break;
+		}
+
+		const bool bCreated = CreateObject(Request.PoolID);
+		const double CreateSeconds = FPlatformTime::Seconds() - CreateStart;
+
+		const int32 RequestIndex = FindRequest(Request.PoolID);
+		if (!bCreated)
+		{
+			const int32 Remaining = RequestIndex != INDEX_NONE ? Queue[RequestIndex].Remaining : 0;
+			UE_LOG(LogObjectPool, Warning, TEXT("Pool [%s] warmup aborted: failed to create objects, %d remaining"),
+				*Request.PoolID.ToString(), Remaining);
+
+			CreatedCount += Remaining;
+			if (RequestIndex != INDEX_NONE)
+			{
+				Queue.RemoveAt(RequestIndex);
+			}
+			continue;
+		}
+
+		++Result.NumCreated;
+
+		double& Average = AverageCreateSeconds.FindOrAdd(Request.PoolID);
+		Average = Average > 0.0 ? FMath::Lerp(Average, CreateSeconds, 0.125) : CreateSeconds;
+
+		if (RequestIndex != INDEX_NONE)
+		{
+			FRequest& Current = Queue[RequestIndex];
+			const int32 NewDeficit = FMath::Max(0, GetDeficit(Current.PoolID, Current.TargetCount));
+			CreatedCount += FMath::Max(0, Current.Remaining - NewDeficit);
+			Current.Remaining = NewDeficit;
+
+			if (NewDeficit <= 0)
+			{
+				Queue.RemoveAt(RequestIndex);
+			}
+		}
+	}
+
+	Result.CreatedCount = CreatedCount;
+	Result.TotalCount = TotalCount;
+	Result.bProgressChanged = CreatedCount != ReportedCreatedCount || TotalCount != ReportedTotalCount;
+
+	ReportedCreatedCount = CreatedCount;
+	ReportedTotalCount = TotalCount;
+
+	if (Queue.Num() == 0)
+	{
+		UE_LOG(LogObjectPool, Log, TEXT("Pool warmup complete: %d objects"), TotalCount);
+		CreatedCount = 0;
+		TotalCount = 0;
+		ReportedCreatedCount = 0;
+		ReportedTotalCount = 0;
+	}
+
+	return Result;
+}
+
+void FObjectPoolWarmupScheduler::Reset()
+{
+	Queue.Empty();
+	TotalCount = 0;
+	CreatedCount = 0;
+	ReportedCreatedCount = 0;
+	ReportedTotalCount = 0;
+}
@@ -3,10 +3,27 @@
 #include "ObjectPoolSubsystem.h"
 #include "ObjectPoolContainer.h"
 #include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
 #include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ObjectPoolSubsystem)
 
+// ==================== 性能计数器声明 ====================
+DECLARE_STATS_GROUP(TEXT("YcObjectPool"), STATGROUP_YcObjectPool, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("ProcessWarmup"), STAT_YcObjectPool_ProcessWarmup, STATGROUP_YcObjectPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WarmupCreated"), STAT_YcObjectPool_WarmupCreated, STATGROUP_YcObjectPool);
+
+// ==================== 控制台变量定义 ====================
+namespace YcObjectPoolCVars
+{
+	static float WarmupBudgetMs = 2.0f;
+	static FAutoConsoleVariableRef CVarWarmupBudgetMs(
+		TEXT("Yc.ObjectPool.WarmupBudgetMs"),
+		WarmupBudgetMs,
+		TEXT("对象池分帧预热每帧的时间预算（毫秒），<=0 表示不分帧，预热请求立即完成"),
+		ECVF_Default);
+}
+
 void UObjectPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -23,9 +40,52 @@ void UObjectPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 		);
 	}
 
+	// 预热调度器回调，查询时持有读锁，生成对象时不持有任何锁
+	WarmupScheduler.GetPoolInfo = [this](FName PoolID, FObjectPoolWarmupPoolInfo& OutInfo)
+	{
+		FReadScopeLock Lock(PoolsLock);
+
+		const TSharedPtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
+		if (!PoolPtr || !PoolPtr->IsValid())
+		{
+			return false;
+		}
+
+		OutInfo.DefaultCount = (*PoolPtr)->GetConfig().InitialSize;
+		OutInfo.Priority = (*PoolPtr)->GetConfig().WarmupPriority;
+		OutInfo.ExpectedDemand = (*PoolPtr)->GetExpectedDemand();
+		return true;
+	};
+	WarmupScheduler.GetDeficit = [this](FName PoolID, int32 TargetCount)
+	{
+		FReadScopeLock Lock(PoolsLock);
+
+		const TSharedPtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
+		return PoolPtr && PoolPtr->IsValid() ? (*PoolPtr)->GetWarmupDeficit(TargetCount) : 0;
+	};
+	WarmupScheduler.CreateObject = [this](FName PoolID)
+	{
+		return CreateWarmupObject(PoolID);
+	};
+
 	UE_LOG(LogObjectPool, Log, TEXT("ObjectPoolSubsystem initialized"));
 }
 
+void UObjectPoolSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (WarmupScheduler.IsWarmingUp())
+	{
+		ProcessWarmup(YcObjectPoolCVars::WarmupBudgetMs * 0.001);
+	}
+}
+
+TStatId UObjectPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UObjectPoolSubsystem, STATGROUP_Tickables);
+}
+
 void UObjectPoolSubsystem::Deinitialize()
 {
 	// 清理定时器
@@ -36,6 +96,7 @@ void UObjectPoolSubsystem::Deinitialize()
 
 	// 清理所有池
 	ClearAllPools();
+	WarmupScheduler.Reset();
 
 	UE_LOG(LogObjectPool, Log, TEXT("ObjectPoolSubsystem deinitialized"));
 
@@ -53,27 +114,34 @@ bool UObjectPoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 bool UObjectPoolSubsystem::RegisterPool(const FObjectPoolConfig& Config)
 {
-	FScopeLock Lock(&SubsystemLock);
-
 	if (!Config.IsValid())
 	{
 		UE_LOG(LogObjectPool, Warning, TEXT("Invalid pool config"));
 		return false;
 	}
 
-	if (Pools.Contains(Config.PoolID))
+	if (HasPool(Config.PoolID))
 	{
 		UE_LOG(LogObjectPool, Warning, TEXT("Pool [%s] already exists"), *Config.PoolID.ToString());
 		return false;
 	}
 
-	TUniquePtr<FObjectPoolContainer> NewPool = MakeUnique<FObjectPoolContainer>();
-	if (!NewPool->Initialize(GetWorld(), Config))
+	// 预热交给预热队列分帧完成
+	TSharedPtr<FObjectPoolContainer> NewPool = MakeShared<FObjectPoolContainer>();
+	if (!NewPool->Initialize(GetWorld(), Config, /*bDeferWarmup*/ true))
 	{
 		return false;
 	}
 
-	Pools.Add(Config.PoolID, MoveTemp(NewPool));
+	{
+		FWriteScopeLock Lock(PoolsLock);
+		Pools.Add(Config.PoolID, MoveTemp(NewPool));
+	}
+
+	if (Config.bWarmupOnRegister && Config.InitialSize > 0)
+	{
+		EnqueueWarmup(Config.PoolID, Config.InitialSize);
+	}
 
 	UE_LOG(LogObjectPool, Log, TEXT("Registered pool [%s]"), *Config.PoolID.ToString());
 	return true;
@@ -81,24 +149,23 @@ bool UObjectPoolSubsystem::RegisterPool(const FObjectPoolConfig& Config)
 
 void UObjectPoolSubsystem::UnregisterPool(FName PoolID)
 {
-	FScopeLock Lock(&SubsystemLock);
-
-	TUniquePtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
-	if (!PoolPtr)
+	TSharedPtr<FObjectPoolContainer> Pool;
 	{
-		return;
-	}
+		FWriteScopeLock Lock(PoolsLock);
+		TSharedPtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
+		if (!PoolPtr)
+		{
+			return;
+		}
 
-	(*PoolPtr)->Shutdown();
-	Pools.Remove(PoolID);
+		Pool = MoveTemp(*PoolPtr);
+		Pools.Remove(PoolID);
+	}
 
-	// 清理映射
-	for (auto It = ObjectToPoolMap.CreateIterator(); It; ++It)
+	// 销毁对象在锁外进行
+	if (Pool.IsValid())
 	{
-		if (It.Value() == PoolID)
-		{
-			It.RemoveCurrent();
-		}
+		Pool->Shutdown();
 	}
 
 	BroadcastEvent(PoolID, EObjectPoolEventType::Cleared, nullptr);
@@ -107,26 +174,32 @@ void UObjectPoolSubsystem::UnregisterPool(FName PoolID)
 
 bool UObjectPoolSubsystem::HasPool(FName PoolID) const
 {
-	FScopeLock Lock(&SubsystemLock);
+	FReadScopeLock Lock(PoolsLock);
 	return Pools.Contains(PoolID);
 }
 
 
 UObject* UObjectPoolSubsystem::AcquireObject(FName PoolID)
 {
-	FScopeLock Lock(&SubsystemLock);
+	FObjectPoolHandle Handle;
+	return AcquireObjectWithHandle(PoolID, Handle);
+}
 
-	TUniquePtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
-	if (!PoolPtr || !PoolPtr->IsValid())
+UObject* UObjectPoolSubsystem::AcquireObjectWithHandle(FName PoolID, FObjectPoolHandle& OutHandle)
+{
+	const TSharedPtr<FObjectPoolContainer> Pool = FindPool(PoolID);
+	if (!Pool.IsValid())
 	{
 		UE_LOG(LogObjectPool, Warning, TEXT("Pool [%s] not found"), *PoolID.ToString());
 		return nullptr;
 	}
 
-	UObject* Object = (*PoolPtr)->Acquire();
+	// 获取、扩容和激活都在锁外进行，回调中可以安全地重入子系统
+	UObject* Object = Pool->Acquire(OutHandle);
+
+	// 事件在锁外广播，监听者可以安全地回调子系统
 	if (Object)
 	{
-		ObjectToPoolMap.Add(Object, PoolID);
 		BroadcastEvent(PoolID, EObjectPoolEventType::Acquired, Object);
 	}
 	else
@@ -149,60 +222,179 @@ bool UObjectPoolSubsystem::ReleaseObject(UObject* Object)
 		return false;
 	}
 
-	FScopeLock Lock(&SubsystemLock);
+	FName PoolID;
+	TSharedPtr<FObjectPoolContainer> Pool;
+	{
+		FReadScopeLock Lock(PoolsLock);
+		Pool = FindOwningPool(Object, PoolID);
+	}
 
-	const FName* PoolIDPtr = ObjectToPoolMap.Find(Object);
-	if (!PoolIDPtr)
+	if (!Pool.IsValid())
 	{
 		UE_LOG(LogObjectPool, Warning, TEXT("Object [%s] not managed by any pool"), *Object->GetName());
 		return false;
 	}
 
-	const FName PoolID = *PoolIDPtr;
-	TUniquePtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
-	if (!PoolPtr || !PoolPtr->IsValid())
+	// 停用在锁外进行
+	const bool bReleased = Pool->Release(Object);
+	if (bReleased)
+	{
+		BroadcastEvent(PoolID, EObjectPoolEventType::Released, Object);
+	}
+
+	return bReleased;
+}
+
+bool UObjectPoolSubsystem::ReleaseObjectByHandle(FName PoolID, const FObjectPoolHandle& Handle)
+{
+	const TSharedPtr<FObjectPoolContainer> Pool = FindPool(PoolID);
+	if (!Pool.IsValid())
 	{
 		return false;
 	}
 
-	if ((*PoolPtr)->Release(Object))
+	// 停用在锁外进行
+	UObject* Object = nullptr;
+	const bool bReleased = Pool->Release(Handle, &Object);
+
+	// 对象已被 GC 时不广播，监听者拿不到有效对象
+	if (bReleased && Object)
 	{
 		BroadcastEvent(PoolID, EObjectPoolEventType::Released, Object);
-		return true;
 	}
 
-	return false;
+	return bReleased;
 }
 
-void UObjectPoolSubsystem::WarmupPool(FName PoolID, int32 Count)
+TSharedPtr<FObjectPoolContainer> UObjectPoolSubsystem::FindPool(FName PoolID) const
 {
-	FScopeLock Lock(&SubsystemLock);
+	FReadScopeLock Lock(PoolsLock);
+	return Pools.FindRef(PoolID);
+}
 
-	TUniquePtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
-	if (PoolPtr && PoolPtr->IsValid())
+TSharedPtr<FObjectPoolContainer> UObjectPoolSubsystem::FindOwningPool(const UObject* Object, FName& OutPoolID) const
+{
+	// 可池化对象自带池ID，直接定位
+	if (const IPoolableObject* Poolable = Cast<const IPoolableObject>(Object))
 	{
-		(*PoolPtr)->Warmup(Count);
+		const FName PoolID = Poolable->GetPoolIdentifier();
+		const TSharedPtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
+		if (PoolPtr && PoolPtr->IsValid() && (*PoolPtr)->Contains(Object))
+		{
+			OutPoolID = PoolID;
+			return *PoolPtr;
+		}
 	}
+
+	// 否则逐个池查找（池的数量通常很少）
+	for (const auto& Pair : Pools)
+	{
+		if (Pair.Value.IsValid() && Pair.Value->Contains(Object))
+		{
+			OutPoolID = Pair.Key;
+			return Pair.Value;
+		}
+	}
+
+	return nullptr;
+}
+
+void UObjectPoolSubsystem::WarmupPool(FName PoolID, int32 Count)
+{
+	EnqueueWarmup(PoolID, Count);
 }
 
 void UObjectPoolSubsystem::WarmupAllPools()
 {
-	FScopeLock Lock(&SubsystemLock);
+	TArray<FName> PoolIDs;
+	{
+		FReadScopeLock Lock(PoolsLock);
+		Pools.GetKeys(PoolIDs);
+	}
 
-	for (auto& Pair : Pools)
+	for (const FName& PoolID : PoolIDs)
 	{
-		if (Pair.Value.IsValid())
+		EnqueueWarmup(PoolID, INDEX_NONE);
+	}
+}
+
+void UObjectPoolSubsystem::FlushWarmup()
+{
+	ProcessWarmup(0.0);
+}
+
+float UObjectPoolSubsystem::GetWarmupProgress() const
+{
+	return WarmupScheduler.GetProgress();
+}
+
+void UObjectPoolSubsystem::EnqueueWarmup(FName PoolID, int32 Count)
+{
+	WarmupScheduler.Enqueue(PoolID, Count);
+
+	// 不分帧时保持原有行为，立即完成
+	if (YcObjectPoolCVars::WarmupBudgetMs <= 0.0f)
+	{
+		ProcessWarmup(0.0);
+	}
+}
+
+bool UObjectPoolSubsystem::CreateWarmupObject(FName PoolID)
+{
+	// 复制配置后释放锁，生成回调可以安全地回调子系统
+	FObjectPoolConfig Config;
+	{
+		const TSharedPtr<FObjectPoolContainer> Pool = FindPool(PoolID);
+		if (!Pool.IsValid())
 		{
-			Pair.Value->Warmup();
+			return false;
 		}
+		Config = Pool->GetConfig();
+	}
+
+	UObject* PooledObject = FObjectPoolContainer::CreatePoolObject(GetWorld(), Config);
+	if (!PooledObject)
+	{
+		return false;
 	}
+
+	// 生成期间池可能已被注销或替换，重新查找
+	bool bAdded = false;
+	const TSharedPtr<FObjectPoolContainer> Pool = FindPool(PoolID);
+	if (Pool.IsValid() && Pool->GetConfig().ObjectClass == Config.ObjectClass)
+	{
+		bAdded = Pool->AddPooledObject(PooledObject);
+	}
+
+	if (!bAdded)
+	{
+		FObjectPoolContainer::DestroyObject(PooledObject);
+	}
+
+	return bAdded;
+}
+
+int32 UObjectPoolSubsystem::ProcessWarmup(double BudgetSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_YcObjectPool_ProcessWarmup);
+
+	const FObjectPoolWarmupResult Result = WarmupScheduler.Process(BudgetSeconds);
+
+	INC_DWORD_STAT_BY(STAT_YcObjectPool_WarmupCreated, Result.NumCreated);
+
+	if (Result.bProgressChanged && OnWarmupProgress.IsBound())
+	{
+		OnWarmupProgress.Broadcast(Result.CreatedCount, Result.TotalCount);
+	}
+
+	return Result.NumCreated;
 }
 
 bool UObjectPoolSubsystem::GetPoolStats(FName PoolID, FObjectPoolStats& OutStats) const
 {
-	FScopeLock Lock(&SubsystemLock);
+	FReadScopeLock Lock(PoolsLock);
 
-	const TUniquePtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
+	const TSharedPtr<FObjectPoolContainer>* PoolPtr = Pools.Find(PoolID);
 	if (!PoolPtr || !PoolPtr->IsValid())
 	{
 		return false;
@@ -214,7 +406,7 @@ bool UObjectPoolSubsystem::GetPoolStats(FName PoolID, FObjectPoolStats& OutStats
 
 TArray<FObjectPoolStats> UObjectPoolSubsystem::GetAllPoolStats() const
 {
-	FScopeLock Lock(&SubsystemLock);
+	FReadScopeLock Lock(PoolsLock);
 
 	TArray<FObjectPoolStats> AllStats;
 	AllStats.Reserve(Pools.Num());
@@ -253,23 +445,40 @@ void UObjectPoolSubsystem::PrintAllPoolStats() const
 
 void UObjectPoolSubsystem::ShrinkAllPools()
 {
-	FScopeLock Lock(&SubsystemLock);
-
-	for (auto& Pair : Pools)
+	TArray<FName> ShrunkPools;
+	TArray<UObject*> RemovedObjects;
 	{
-		if (Pair.Value.IsValid())
+		FReadScopeLock Lock(PoolsLock);
+
+		for (auto& Pair : Pools)
 		{
-			Pair.Value->Shrink();
-			BroadcastEvent(Pair.Key, EObjectPoolEventType::Shrunk, nullptr);
+			if (Pair.Value.IsValid())
+			{
+				Pair.Value->Shrink(RemovedObjects);
+				ShrunkPools.Add(Pair.Key);
+			}
 		}
 	}
+
+	// 销毁在锁外进行，销毁回调可以安全地回调子系统
+	FObjectPoolContainer::DestroyRemovedObjects(RemovedObjects);
+
+	for (const FName& PoolID : ShrunkPools)
+	{
+		BroadcastEvent(PoolID, EObjectPoolEventType::Shrunk, nullptr);
+	}
 }
 
 void UObjectPoolSubsystem::ClearAllPools()
 {
-	FScopeLock Lock(&SubsystemLock);
+	TMap<FName, TSharedPtr<FObjectPoolContainer>> RemovedPools;
+	{
+		FWriteScopeLock Lock(PoolsLock);
+		RemovedPools = MoveTemp(Pools);
+		Pools.Reset();
+	}
 
-	for (auto& Pair : Pools)
+	for (auto& Pair : RemovedPools)
 	{
 		if (Pair.Value.IsValid())
 		{
@@ -277,29 +486,33 @@ void UObjectPoolSubsystem::ClearAllPools()
 			BroadcastEvent(Pair.Key, EObjectPoolEventType::Cleared, nullptr);
 		}
 	}
-
-	Pools.Empty();
-	ObjectToPoolMap.Empty();
 }
 
 void UObjectPoolSubsystem::CheckPoolsShrinkage()
 {
-	FScopeLock Lock(&SubsystemLock);
-
 	const float CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
 
-	for (auto& Pair : Pools)
+	TArray<UObject*> RemovedObjects;
 	{
-		if (Pair.Value.IsValid())
+		FReadScopeLock Lock(PoolsLock);
+
+		for (auto& Pair : Pools)
 		{
-			Pair.Value->CheckShrinkage(CurrentTime);
+			if (Pair.Value.IsValid())
+			{
+				Pair.Value->CheckShrinkage(CurrentTime, RemovedObjects);
+			}
 		}
 	}
+
+	// 销毁在锁外进行
+	FObjectPoolContainer::DestroyRemovedObjects(RemovedObjects);
 }
 
 void UObjectPoolSubsystem::BroadcastEvent(FName PoolID, EObjectPoolEventType EventType, UObject* Object)
 {
-	if (OnPoolEvent.IsBound())
+	// 动态委托只能在游戏线程广播，其他线程的获取/释放不发事件
+	if (OnPoolEvent.IsBound() && IsInGameThread())
 	{
 		OnPoolEvent.Broadcast(PoolID, EventType, Object);
 	}
@@ -5,14 +5,50 @@
 #include "CoreMinimal.h"
 #include "IPoolableObject.h"
 #include "ObjectPoolTypes.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
 
 DECLARE_LOG_CATEGORY_EXTERN(LogObjectPool, Log, All);
 
+/**
+ * 对象池句柄
+ *
+ * 由槽位索引和代数组成。对象每次回池时槽位代数加一，
+ * 旧句柄随之失效，因此重复释放和释放过期句柄都能以 O(1) 检测出来。
+ */
+struct YICHENOBJECTPOOL_API FObjectPoolHandle
+{
+	/** 槽位索引 */
+	int32 Index = INDEX_NONE;
+
+	/** 获取时的槽位代数 */
+	uint32 Generation = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	void Reset() { Index = INDEX_NONE; Generation = 0; }
+
+	bool operator==(const FObjectPoolHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	bool operator!=(const FObjectPoolHandle& Other) const { return !(*this == Other); }
+};
+
 /**
  * 单个对象池容器（非UCLASS，纯C++实现以获得最佳性能）
- * 
+ *
  * 管理单一类型对象的池化。支持UObject和AActor。
- * 使用索引队列而非指针队列，减少内存碎片。
+ *
+ * 实现要点：
+ * - 槽位按块分配，块指针数组容量固定，扩容不会移动已有槽位，其他线程可随时按索引访问
+ * - 空闲槽位组成侵入式空闲链表（Treiber 栈），链表头带 ABA 计数，获取/释放均为无锁 CAS
+ * - 每个槽位的状态字 = (代数 << 1) | 是否在池中，释放时一次 CAS 同时完成重复释放检测和代数递增
+ * - 只有创建/销毁对象的操作（预热、扩容、收缩、关闭）需要加锁，且只能在游戏线程执行
+ * - 对象在锁外生成后再加锁放入池；收缩和关闭在锁内只把对象摘出池，销毁在锁外进行，
+ *   生成/销毁回调可以安全地重入池接口
+ *
+ * 线程安全：
+ * - Acquire/Release 的簿记部分可在任意线程并发调用
+ * - 激活/停用需要在游戏线程执行：Actor 池和实现 IPoolableObject 的池只能在游戏线程获取/释放，
+ *   普通 UObject 池没有激活/停用逻辑，可在任意线程获取/释放；非游戏线程获取时池耗尽不会扩容
  */
 class YICHENOBJECTPOOL_API FObjectPoolContainer
 {
@@ -20,29 +56,85 @@ public:
 	FObjectPoolContainer();
 	~FObjectPoolContainer();
 
-	/** 初始化池 */
-	bool Initialize(UWorld* InWorld, const FObjectPoolConfig& InConfig);
+	/**
+	 * 初始化池
+	 * @param bDeferWarmup 为 true 时忽略 bWarmupOnRegister，由调用者稍后分帧预热
+	 */
+	bool Initialize(UWorld* InWorld, const FObjectPoolConfig& InConfig, bool bDeferWarmup = false);
 
-	/** 关闭池，销毁所有对象 */
+	/** 关闭池，销毁所有对象，之后的获取/释放都会失败 */
 	void Shutdown();
 
-	/** 预热池 */
-	void Warmup(int32 Count = -1);
+	/**
+	 * 预热池
+	 * @param Count 目标总数，-1 使用配置的 InitialSize
+	 * @param DeadlineSeconds 截止时间（FPlatformTime::Seconds），0 表示不限时；
+	 *        按平均创建耗时预测，下一个对象会超时就停止
+	 * @return 本次创建的数量
+	 */
+	int32 Warmup(int32 Count = -1, double DeadlineSeconds = 0.0);
+
+	/**
+	 * 按配置生成一个处于休眠状态的对象，不放入任何池（仅游戏线程，不能持有任何池锁）
+	 * 分帧预热在锁外生成，再用 AddPooledObject 放入池
+	 */
+	static UObject* CreatePoolObject(UWorld* InWorld, const FObjectPoolConfig& InConfig);
+
+	/**
+	 * 把 CreatePoolObject 生成的对象放入池
+	 * @return 池未初始化或已满时返回 false，对象由调用者用 DestroyObject 销毁
+	 */
+	bool AddPooledObject(UObject* Object);
+
+	/** 销毁单个对象（仅游戏线程） */
+	static void DestroyObject(UObject* Object);
+
+	/** 距离预热目标还差多少个对象（已考虑 MaxSize） */
+	int32 GetWarmupDeficit(int32 Count = -1) const;
+
+	/** 预期需求量：取初始大小和历史峰值中较大者，用于安排预热顺序 */
+	int32 GetExpectedDemand() const { return FMath::Max(Config.InitialSize, PeakActiveCount.load(std::memory_order_relaxed)); }
 
 	/** 获取对象 */
 	UObject* Acquire();
 
+	/**
+	 * 获取对象，同时返回句柄
+	 * @param OutHandle 输出句柄，用于 O(1) 释放
+	 */
+	UObject* Acquire(FObjectPoolHandle& OutHandle);
+
 	/** 释放对象 */
 	bool Release(UObject* Object);
 
+	/**
+	 * 按句柄释放对象，不需要查找对象到槽位的映射
+	 * @param OutObject 释放成功时输出句柄对应的对象
+	 * @return 句柄过期或重复释放时返回 false
+	 */
+	bool Release(const FObjectPoolHandle& Handle, UObject** OutObject = nullptr);
+
+	/** 对象是否由此池管理 */
+	bool Contains(const UObject* Object) const;
+
 	/** 扩容 */
 	void Grow(int32 Amount);
 
-	/** 收缩 */
+	/** 收缩并销毁多余的空闲对象 */
 	void Shrink();
 
-	/** 检查是否需要收缩 */
-	void CheckShrinkage(float CurrentTime);
+	/**
+	 * 收缩，只把多余的空闲对象摘出池，不销毁
+	 * 调用者释放自己持有的锁后用 DestroyRemovedObjects 销毁
+	 * @return 摘出的数量
+	 */
+	int32 Shrink(TArray<UObject*>& OutRemovedObjects);
+
+	/** 检查是否需要收缩，摘出的对象同样由调用者销毁 */
+	void CheckShrinkage(float CurrentTime, TArray<UObject*>& OutRemovedObjects);
+
+	/** 通知并销毁已摘出池的对象（仅游戏线程，不能持有任何池锁） */
+	static void DestroyRemovedObjects(const TArray<UObject*>& RemovedObjects);
 
 	/** 获取统计信息 */
 	FObjectPoolStats GetStats() const;
@@ -54,26 +146,72 @@ public:
 	bool IsInitialized() const { return bIsInitialized; }
 
 	/** 获取可用数量 */
-	int32 GetAvailableCount() const { return AvailableIndices.Num(); }
+	int32 GetAvailableCount() const { return AvailableCount.load(std::memory_order_relaxed); }
 
 	/** 获取总数量 */
-	int32 GetTotalCount() const { return AllObjects.Num(); }
+	int32 GetTotalCount() const { return TotalCount.load(std::memory_order_relaxed); }
 
 	/** 获取活跃数量 */
-	int32 GetActiveCount() const { return ActiveCount; }
+	int32 GetActiveCount() const { return ActiveCount.load(std::memory_order_relaxed); }
+
+	/** 单个池最多容纳的对象数量 */
+	static constexpr int32 SlotsPerChunk = 256;
+	static constexpr int32 MaxChunks = 512;
+	static constexpr int32 MaxCapacity = SlotsPerChunk * MaxChunks;
 
 private:
-	/** 创建单个对象 */
-	UObject* CreateObject();
+	/** 槽位 */
+	struct FSlot
+	{
+		/** 池化对象，只在持有 StructureLock 且槽位不在空闲链表中时写入 */
+		TWeakObjectPtr<UObject> Object;
+
+		/** 对象键，对象被 GC 后仍可用于清理映射 */
+		FObjectKey ObjectKey;
 
-	/** 销毁单个对象 */
-	void DestroyObject(UObject* Object);
+		/** (代数 << 1) | 是否在池中 */
+		std::atomic<uint32> State{0};
+
+		/** 空闲链表中的下一个槽位 */
+		std::atomic<int32> NextFree{INDEX_NONE};
+	};
+
+	static constexpr uint32 InPoolBit = 1;
+
+	FSlot& GetSlot(int32 Index) const { return Chunks[Index / SlotsPerChunk][Index % SlotsPerChunk]; }
+
+	/** 从空闲链表弹出一个槽位，链表为空返回 INDEX_NONE */
+	int32 PopFreeSlot();
+
+	/** 将槽位压入空闲链表 */
+	void PushFreeSlot(int32 Index);
+
+	/** 按槽位状态释放，ExpectedGeneration 为 nullptr 时不校验代数 */
+	bool ReleaseSlot(int32 Index, const uint32* ExpectedGeneration, UObject** OutObject = nullptr);
+
+	/** 获取/释放时是否需要激活/停用对象（需要游戏线程） */
+	bool RequiresGameThread() const { return bIsActorPool || bIsPoolableClass; }
+
+	/** 池耗尽警告，每个池每秒最多输出一次 */
+	void LogExhausted();
+
+	/**
+	 * 逐个生成对象并放入空闲链表，生成时不持有 StructureLock，返回创建数量
+	 * @param DeadlineSeconds 截止时间，0 表示不限时
+	 */
+	int32 CreatePooledObjects(int32 Count, double DeadlineSeconds = 0.0);
+
+	/** 查找对象所在槽位 */
+	int32 FindSlotIndex(const UObject* Object) const;
+
+	/** 更新峰值活跃数 */
+	void UpdatePeakActiveCount(int32 NewActiveCount);
 
 	/** 激活对象 */
-	void ActivateObject(UObject* Object);
+	static void ActivateObject(UObject* Object);
 
 	/** 停用对象 */
-	void DeactivateObject(UObject* Object);
+	static void DeactivateObject(UObject* Object);
 
 private:
 	/** 池配置 */
@@ -82,26 +220,47 @@ private:
 	/** 所属世界 */
 	TWeakObjectPtr<UWorld> World;
 
-	/** 所有对象 */
-	TArray<TWeakObjectPtr<UObject>> AllObjects;
+	/** 槽位块，块一旦分配直到析构才释放（关闭后仍可能有调用者在访问） */
+	TUniquePtr<FSlot[]> Chunks[MaxChunks];
+
+	/** 已分配的槽位数量 */
+	std::atomic<int32> NumSlots{0};
+
+	/** 空闲链表头：低 32 位为槽位索引，高 32 位为 ABA 计数 */
+	std::atomic<uint64> FreeListHead;
+
+	/** 收缩后空出来的槽位，扩容时优先复用（需持有 StructureLock） */
+	TArray<int32> EmptySlots;
+
+	/** 对象到槽位的映射，只在创建/销毁对象时写入 */
+	TMap<FObjectKey, int32> ObjectToIndexMap;
 
-	/** 可用对象索引队列 */
-	TArray<int32> AvailableIndices;
+	/** 保护 ObjectToIndexMap */
+	mutable FRWLock ObjectMapLock;
 
-	/** 对象到索引的映射 */
-	TMap<UObject*, int32> ObjectToIndexMap;
+	/** 持有对象的槽位数 */
+	std::atomic<int32> TotalCount{0};
+
+	/** 空闲链表中的槽位数 */
+	std::atomic<int32> AvailableCount{0};
 
 	/** 活跃对象数 */
-	int32 ActiveCount = 0;
+	std::atomic<int32> ActiveCount{0};
 
 	/** 峰值活跃数 */
-	int32 PeakActiveCount = 0;
+	std::atomic<int32> PeakActiveCount{0};
 
 	/** 总获取次数 */
-	int64 TotalAcquireCount = 0;
+	std::atomic<int64> TotalAcquireCount{0};
 
 	/** 获取失败次数 */
-	int64 AcquireFailCount = 0;
+	std::atomic<int64> AcquireFailCount{0};
+
+	/** 上次输出池耗尽警告的时间（FPlatformTime::Cycles64） */
+	std::atomic<uint64> LastExhaustedLogCycles{0};
+
+	/** 上次输出警告时的获取失败次数 */
+	std::atomic<int64> LastExhaustedLogFailCount{0};
 
 	/** 扩容次数 */
 	int32 GrowthCount = 0;
@@ -112,12 +271,18 @@ private:
 	/** 上次收缩检查时间 */
 	float LastShrinkCheckTime = 0.0f;
 
+	/** 创建单个对象的平均耗时（秒），分帧预热时用于预测是否会超出截止时间 */
+	double AverageCreateSeconds = 0.0;
+
 	/** 是否已初始化 */
 	bool bIsInitialized = false;
 
 	/** 是否为Actor池 */
 	bool bIsActorPool = false;
 
-	/** 临界区（线程安全） */
-	mutable FCriticalSection PoolLock;
+	/** 对象类是否实现 IPoolableObject */
+	bool bIsPoolableClass = false;
+
+	/** 创建/销毁对象时持有（预热、扩容、收缩、关闭） */
+	mutable FCriticalSection StructureLock;
 };
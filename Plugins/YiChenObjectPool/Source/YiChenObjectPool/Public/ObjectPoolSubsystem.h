@@ -5,9 +5,11 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "ObjectPoolTypes.h"
+#include "ObjectPoolWarmupScheduler.h"
 #include "ObjectPoolSubsystem.generated.h"
 
 class FObjectPoolContainer;
+struct FObjectPoolHandle;
 
 /**
  * 通用对象池子系统
@@ -24,9 +26,23 @@ class FObjectPoolContainer;
  * 2. 注册池: RegisterPool(Config)
  * 3. 获取对象: AcquireObject<T>(PoolID) 或 AcquireObject(PoolID)
  * 4. 释放对象: ReleaseObject(Object)
+ * 
+ * C++ 中可使用句柄版本（AcquireObjectWithHandle / ReleaseObjectByHandle），
+ * 释放时不需要查找对象所属的池和槽位。
+ * 池的注册/注销只能在游戏线程进行。获取/释放只在查找池时短暂持有读锁，
+ * 拿到池的共享引用后即释放锁，再执行获取/释放、扩容和激活/停用，
+ * 因此池的回调（OnAcquiredFromPool/OnReleasedToPool、扩容生成的 Actor 的 BeginPlay）
+ * 可以安全地注册/注销池或从其他池获取对象。
+ *
+ * 预热：
+ * - 注册时和 WarmupPool 只把池加入预热队列，由 Tick 在每帧 Yc.ObjectPool.WarmupBudgetMs 的预算内分帧创建
+ * - 队列按 WarmupPriority、预期需求量（初始大小与历史峰值的较大者）从高到低处理
+ * - 调度由 FObjectPoolWarmupScheduler 完成，对象在 PoolsLock 外生成，再加锁放入池
+ * - 加载界面可轮询 IsWarmingUp / GetWarmupProgress，或绑定 OnWarmupProgress
+ * 测试：Yc.ObjectPool.WarmupTest [对象数] [预算毫秒]
  */
 UCLASS()
-class YICHENOBJECTPOOL_API UObjectPoolSubsystem : public UWorldSubsystem
+class YICHENOBJECTPOOL_API UObjectPoolSubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
@@ -37,6 +53,11 @@ public:
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 	//~ End USubsystem Interface
 
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
 	/**
 	 * 注册对象池
 	 * @param Config 池配置
@@ -90,7 +111,20 @@ public:
 	bool ReleaseObject(UObject* Object);
 
 	/**
-	 * 预热指定池
+	 * 获取对象，同时返回句柄（仅 C++）
+	 * @param PoolID 池标识符
+	 * @param OutHandle 输出句柄，用于 ReleaseObjectByHandle
+	 */
+	UObject* AcquireObjectWithHandle(FName PoolID, FObjectPoolHandle& OutHandle);
+
+	/**
+	 * 按句柄释放对象（仅 C++）
+	 * @return 句柄过期或重复释放时返回 false
+	 */
+	bool ReleaseObjectByHandle(FName PoolID, const FObjectPoolHandle& Handle);
+
+	/**
+	 * 预热指定池（加入分帧预热队列）
 	 * @param PoolID 池标识符
 	 * @param Count 预热数量，-1使用配置的InitialSize
 	 */
@@ -98,11 +132,33 @@ public:
 	void WarmupPool(FName PoolID, int32 Count = -1);
 
 	/**
-	 * 预热所有池
+	 * 预热所有池（加入分帧预热队列）
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ObjectPool")
 	void WarmupAllPools();
 
+	/**
+	 * 立即完成队列中所有预热，不受每帧预算限制
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ObjectPool")
+	void FlushWarmup();
+
+	/** 是否还有未完成的预热 */
+	UFUNCTION(BlueprintPure, Category = "ObjectPool")
+	bool IsWarmingUp() const { return WarmupScheduler.IsWarmingUp(); }
+
+	/** 本轮预热进度 (0.0 - 1.0)，没有预热时为 1.0 */
+	UFUNCTION(BlueprintPure, Category = "ObjectPool")
+	float GetWarmupProgress() const;
+
+	/**
+	 * 按预算推进一次预热
+	 * 正常情况下由 Tick 调用，测试时也可直接调用
+	 * @param BudgetSeconds 本次可用时间，<=0 表示不限时
+	 * @return 本次创建的对象数
+	 */
+	int32 ProcessWarmup(double BudgetSeconds);
+
 	/**
 	 * 获取池统计信息
 	 */
@@ -138,23 +194,39 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "ObjectPool|Events")
 	FOnObjectPoolEvent OnPoolEvent;
 
+	/** 分帧预热进度委托，进度变化时广播 */
+	UPROPERTY(BlueprintAssignable, Category = "ObjectPool|Events")
+	FOnObjectPoolWarmupProgress OnWarmupProgress;
+
 protected:
 	/** 定时检查收缩 */
 	void CheckPoolsShrinkage();
 
-	/** 广播事件 */
+	/** 广播事件（仅游戏线程） */
 	void BroadcastEvent(FName PoolID, EObjectPoolEventType EventType, UObject* Object = nullptr);
 
+	/** 查找池并返回共享引用，调用者不需要持有 PoolsLock */
+	TSharedPtr<FObjectPoolContainer> FindPool(FName PoolID) const;
+
+	/** 查找对象所属的池（需持有 PoolsLock） */
+	TSharedPtr<FObjectPoolContainer> FindOwningPool(const UObject* Object, FName& OutPoolID) const;
+
+	/** 加入预热队列，已在队列中时合并目标数量（仅游戏线程） */
+	void EnqueueWarmup(FName PoolID, int32 Count);
+
+	/** 在锁外生成一个对象，再加锁放入池（预热调度器回调） */
+	bool CreateWarmupObject(FName PoolID);
+
 private:
-	/** 所有池容器 */
-	TMap<FName, TUniquePtr<FObjectPoolContainer>> Pools;
+	/** 分帧预热调度 */
+	FObjectPoolWarmupScheduler WarmupScheduler;
 
-	/** 对象到池ID的映射 */
-	TMap<TWeakObjectPtr<UObject>, FName> ObjectToPoolMap;
+	/** 所有池容器，共享引用保证注销期间仍在使用的池不会被释放 */
+	TMap<FName, TSharedPtr<FObjectPoolContainer>> Pools;
 
 	/** 收缩检查定时器 */
 	FTimerHandle ShrinkCheckTimerHandle;
 
-	/** 临界区 */
-	mutable FCriticalSection SubsystemLock;
+	/** 保护 Pools 映射本身，不在持有期间调用池的任何可能回调用户代码的接口 */
+	mutable FRWLock PoolsLock;
 };
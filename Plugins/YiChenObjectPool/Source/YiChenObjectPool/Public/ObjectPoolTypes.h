@@ -49,10 +49,14 @@ struct YICHENOBJECTPOOL_API FObjectPoolConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool", meta = (ClampMin = "1.0"))
 	float ShrinkCheckInterval = 30.0f;
 
-	/** 是否在注册时立即预热 */
+	/** 是否在注册时预热（由子系统分帧完成，见 Yc.ObjectPool.WarmupBudgetMs） */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool")
 	bool bWarmupOnRegister = true;
 
+	/** 预热优先级，数值越大越先预热；相同优先级按预期需求量从大到小 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool")
+	int32 WarmupPriority = 0;
+
 	/** 是否为Actor池（自动检测，但可手动指定） */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool")
 	bool bIsActorPool = false;
@@ -149,3 +153,10 @@ enum class EObjectPoolEventType : uint8
 
 /** 对象池事件委托 */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnObjectPoolEvent, FName, PoolID, EObjectPoolEventType, EventType, UObject*, Object);
+
+/**
+ * 分帧预热进度委托
+ * @param CreatedCount 本轮预热已创建的对象数
+ * @param TotalCount 本轮预热需要创建的对象总数，两者相等表示预热完成
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnObjectPoolWarmupProgress, int32, CreatedCount, int32, TotalCount);
@@ -0,0 +1,125 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 池的预热参数，由池的拥有者在调度器查询时填充
+ */
+struct FObjectPoolWarmupPoolInfo
+{
+	/** 请求数量为 -1 时使用的目标总数 */
+	int32 DefaultCount = 0;
+
+	/** 预热优先级，数值越大越先预热 */
+	int32 Priority = 0;
+
+	/** 预期需求量，同优先级时数值越大越先预热 */
+	int32 ExpectedDemand = 0;
+};
+
+/**
+ * 一次 Process 的结果
+ */
+struct FObjectPoolWarmupResult
+{
+	/** 本次创建的对象数 */
+	int32 NumCreated = 0;
+
+	/** 本轮已创建（或放弃）的对象数 */
+	int32 CreatedCount = 0;
+
+	/** 本轮需要创建的对象总数 */
+	int32 TotalCount = 0;
+
+	/** 进度与上次报告相比是否变化，只有变化时才需要广播 */
+	bool bProgressChanged = false;
+};
+
+/**
+ * 对象池分帧预热调度器
+ *
+ * 通用对象池和子弹池共用。调度器只管理预热队列、排序、每帧预算和进度，
+ * 池的查询和对象的创建通过回调交给拥有者：
+ * - 队列按优先级、预期需求量从高到低处理
+ * - 逐个对象创建，按该池的平均创建耗时预测，下一个会超出截止时间就停止；每次至少创建一个以保证推进
+ * - 调用 CreateObject 时调度器不持有任何引用或锁，回调中重入 Enqueue 是安全的；
+ *   拥有者应在锁外创建对象，再加锁放入池
+ *
+ * 仅游戏线程使用。
+ */
+class YICHENOBJECTPOOL_API FObjectPoolWarmupScheduler
+{
+public:
+	/** 查询池的预热参数，池不存在时返回 false */
+	TFunction<bool(FName PoolID, FObjectPoolWarmupPoolInfo& OutInfo)> GetPoolInfo;
+
+	/** 池距离目标总数还差多少（已考虑池的最大容量），池不存在时返回 0 */
+	TFunction<int32(FName PoolID, int32 TargetCount)> GetDeficit;
+
+	/** 创建一个对象并放入池，返回是否成功 */
+	TFunction<bool(FName PoolID)> CreateObject;
+
+	/**
+	 * 加入预热队列，已在队列中时合并目标数量
+	 * @param Count 目标总数，-1 使用池的默认数量
+	 */
+	void Enqueue(FName PoolID, int32 Count);
+
+	/**
+	 * 按预算推进预热
+	 * @param BudgetSeconds 本次可用时间，<=0 表示不限时
+	 */
+	FObjectPoolWarmupResult Process(double BudgetSeconds);
+
+	/** 是否还有未完成的预热 */
+	bool IsWarmingUp() const { return Queue.Num() > 0; }
+
+	/** 本轮预热进度 (0.0 - 1.0)，没有预热时为 1.0 */
+	float GetProgress() const { return TotalCount > 0 ? static_cast<float>(CreatedCount) / TotalCount : 1.0f; }
+
+	/** 本轮已创建（或放弃）的对象数 */
+	int32 GetCreatedCount() const { return CreatedCount; }
+
+	/** 本轮需要创建的对象总数 */
+	int32 GetTotalCount() const { return TotalCount; }
+
+	/** 清空队列和进度 */
+	void Reset();
+
+private:
+	/** 预热请求 */
+	struct FRequest
+	{
+		FName PoolID;
+
+		/** 目标总数 */
+		int32 TargetCount = 0;
+
+		int32 Priority = 0;
+
+		int32 ExpectedDemand = 0;
+
+		/** 还需创建的数量 */
+		int32 Remaining = 0;
+	};
+
+	int32 FindRequest(FName PoolID) const;
+
+	/** 预热队列，按优先级、预期需求量从高到低排列 */
+	TArray<FRequest> Queue;
+
+	/** 本轮预热需要创建的对象总数 */
+	int32 TotalCount = 0;
+
+	/** 本轮预热已创建（或放弃）的对象数 */
+	int32 CreatedCount = 0;
+
+	/** 上次报告的进度 */
+	int32 ReportedCreatedCount = 0;
+	int32 ReportedTotalCount = 0;
+
+	/** 每个池创建单个对象的平均耗时（秒） */
+	TMap<FName, double> AverageCreateSeconds;
+};
@@ -0,0 +1,218 @@
+﻿// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcRedDotManagerSubsystem.h"
+#include "YiChenRedDotSystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * 红点批量发放压力测试（控制台命令）
+ *
+ * 模拟一次性发放大量物品: 每轮对根标签下的所有叶子标签循环调用 AddRedDotCount(+1), 每个节点都挂一个
+ * PartialMatch 监听者（相当于每个页签都有一个红点控件）, 分别使用改造前的同步穿透和当前的逐帧合并处理, 对比:
+ * - 每轮的耗时与监听者回调次数
+ * - 两种方式最终得到的各节点数量是否一致
+ * - 合并处理时每个节点每次 Flush 是否最多只通知一次
+ *
+ * 使用单独创建的红点管理器实例, 不影响游戏中的红点数据。
+ */
+struct FYcRedDotBenchmark
+{
+	struct FRunResult
+	{
+		double TotalMs = 0.0;
+		int64 NumCallbacks = 0;
+		TMap<FGameplayTag, int32> Counts;
+	};
+
+	// 改造前的 AddRedDotCount: 每次修改都沿父标签逐级累加并立即通知监听者
+	static void LegacyAddRedDotCount(UYcRedDotManagerSubsystem& RedDots, FGameplayTag RedDotTag, int32 Count)
+	{
+		FRedDotInfo& Info = RedDots.GetOrCreateRedDotInfo(RedDotTag);
+		if (Info.Count == 0 && Count <= 0) return;
+
+		const int32 OldCount = Info.Count;
+		Info.Count = FMath::Max(Info.Count + Count, 0);
+		Info.Delta = Info.Count == 0 ? -OldCount : Count;
+		Info.Tag = RedDotTag;
+		Info.TriggerTime = FDateTime::Now();
+
+		const int32 Delta = Info.Delta;
+		bool bOnInitialTag = true;
+		for (FGameplayTag Tag = RedDotTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+		{
+			FRedDotInfo* ParentRedDotInfo = &RedDots.GetOrCreateRedDotInfo(Tag);
+			if (!bOnInitialTag)
+			{
+				ParentRedDotInfo->Count += Delta;
+			}
+
+			if (const UYcRedDotManagerSubsystem::FYcRedDotListenerList* pList = RedDots.ListenerMap.Find(Tag))
+			{
+				TArray<FYcRedDotStateChangedListenerData> ListenerArray(pList->Listeners);
+				for (const FYcRedDotStateChangedListenerData& Listener : ListenerArray)
+				{
+					if (!bOnInitialTag && Listener.MatchType != EYcRedDotTagMatch::PartialMatch) continue;
+					if (!Listener.ReceivedCallback.IsSet()) continue;
+					Listener.ReceivedCallback(RedDotTag, ParentRedDotInfo);
+				}
+			}
+			bOnInitialTag = false;
+		}
+	}
+
+	static FRunResult RunRounds(UYcRedDotManagerSubsystem& RedDots, const TArray<FGameplayTag>& Leaves, const int32 NumItems, const int32 NumRounds,
+		const bool bLegacy, const int64& NumCallbacks, TMap<FGameplayTag, int32>& CallsPerNode, int32& NumErrors)
+	{
+		RedDots.RedDotStates.Reset();
+		RedDots.InvalidateBranchTable();
+		RedDots.DirtyNodes.Reset();
+
+		FRunResult Result;
+		const int64 CallbacksBefore = NumCallbacks;
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			CallsPerNode.Reset();
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumItems; ++i)
+			{
+				if (bLegacy)
+				{
+					LegacyAddRedDotCount(RedDots, Leaves[i % Leaves.Num()], 1);
+				}
+				else
+				{
+					RedDots.AddRedDotCount(Leaves[i % Leaves.Num()], 1);
+				}
+			}
+			if (!bLegacy)
+			{
+				RedDots.FlushRedDotChanges();
+			}
+			Result.TotalMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			if (!bLegacy)
+			{
+				for (const TPair<FGameplayTag, int32>& Pair : CallsPerNode)
+				{
+					if (Pair.Value > 1)
+					{
+						UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.BenchmarkBulkGrant: %s 在一次 Flush 中被通知了 %d 次"), *Pair.Key.ToString(), Pair.Value);
+						++NumErrors;
+					}
+				}
+			}
+		}
+
+		Result.NumCallbacks = NumCallbacks - CallbacksBefore;
+		for (const TPair<FGameplayTag, FRedDotInfo>& Pair : RedDots.RedDotStates)
+		{
+			Result.Counts.Add(Pair.Key, Pair.Value.Count);
+		}
+		return Result;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		if (!GameInstance)
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.BenchmarkBulkGrant: 需要在有 GameInstance 的游戏世界中执行"));
+			return;
+		}
+
+		const int32 NumItems = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+		const int32 NumRounds = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100;
+		const FGameplayTag RootTag = FGameplayTag::RequestGameplayTag(Args.Num() > 2 ? FName(*Args[2]) : FName(TEXT("UI.RedDot")), false);
+		if (!RootTag.IsValid())
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.BenchmarkBulkGrant: 根标签不存在"));
+			return;
+		}
+
+		// 根标签下没有子标签的标签作为发放目标, 所有节点（包括根标签的父标签）都挂监听者
+		UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+		const FGameplayTagContainer Descendants = TagsManager.RequestGameplayTagChildren(RootTag);
+		TArray<FGameplayTag> Leaves;
+		TArray<FGameplayTag> ListenedTags;
+		for (const FGameplayTag& Tag : Descendants)
+		{
+			ListenedTags.Add(Tag);
+			if (TagsManager.RequestGameplayTagChildren(Tag).IsEmpty())
+			{
+				Leaves.Add(Tag);
+			}
+		}
+		if (Leaves.Num() == 0)
+		{
+			Leaves.Add(RootTag);
+		}
+		for (FGameplayTag Tag = RootTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+		{
+			ListenedTags.Add(Tag);
+		}
+
+		IConsoleVariable* DeferCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Yc.RedDot.DeferPropagation"));
+		if (!DeferCVar)
+		{
+			return;
+		}
+		const bool bSavedDefer = DeferCVar->GetBool();
+		DeferCVar->Set(true, ECVF_SetByConsole);
+
+		UYcRedDotManagerSubsystem* RedDots = NewObject<UYcRedDotManagerSubsystem>(GameInstance);
+
+		int64 NumCallbacks = 0;
+		TMap<FGameplayTag, int32> CallsPerNode;
+		for (const FGameplayTag& Tag : ListenedTags)
+		{
+			RedDots->RegisterRedDotStateChangedListener(Tag, [&NumCallbacks, &CallsPerNode, Tag](FGameplayTag, const FRedDotInfo* Info)
+			{
+				++NumCallbacks;
+				++CallsPerNode.FindOrAdd(Tag);
+			}, EYcRedDotTagMatch::PartialMatch, false);
+		}
+
+		int32 NumErrors = 0;
+		const FRunResult Legacy = RunRounds(*RedDots, Leaves, NumItems, NumRounds, true, NumCallbacks, CallsPerNode, NumErrors);
+		const FRunResult Batched = RunRounds(*RedDots, Leaves, NumItems, NumRounds, false, NumCallbacks, CallsPerNode, NumErrors);
+
+		// 两种方式得到的各节点数量必须一致
+		for (const TPair<FGameplayTag, int32>& Pair : Legacy.Counts)
+		{
+			const int32* BatchedCount = Batched.Counts.Find(Pair.Key);
+			if (!BatchedCount || *BatchedCount != Pair.Value)
+			{
+				UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.BenchmarkBulkGrant: %s 数量不一致 (同步 %d, 合并 %d)"),
+					*Pair.Key.ToString(), Pair.Value, BatchedCount ? *BatchedCount : -1);
+				++NumErrors;
+			}
+		}
+		const int32* RootCount = Batched.Counts.Find(RootTag);
+		if (!RootCount || *RootCount != NumItems * NumRounds)
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.BenchmarkBulkGrant: 根标签数量 %d, 应为 %d"), RootCount ? *RootCount : -1, NumItems * NumRounds);
+			++NumErrors;
+		}
+
+		DeferCVar->Set(bSavedDefer, ECVF_SetByConsole);
+		RedDots->ListenerMap.Reset();
+		RedDots->RedDotStates.Reset();
+		RedDots->MarkAsGarbage();
+
+		UE_LOG(LogYcRedDot, Display, TEXT("Yc.RedDot.BenchmarkBulkGrant: %s (每轮发放 %d 个, 共 %d 轮, %d 个叶子标签, %d 个监听节点, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumItems, NumRounds, Leaves.Num(), ListenedTags.Num(), NumErrors);
+		UE_LOG(LogYcRedDot, Display, TEXT("  同步穿透: 每轮 %.3f ms, 回调 %lld 次"), Legacy.TotalMs / NumRounds, Legacy.NumCallbacks);
+		UE_LOG(LogYcRedDot, Display, TEXT("  逐帧合并: 每轮 %.3f ms, 回调 %lld 次"), Batched.TotalMs / NumRounds, Batched.NumCallbacks);
+	}
+};
+
+namespace YcRedDotBenchmark
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkBulkGrant(
+		TEXT("Yc.RedDot.BenchmarkBulkGrant"),
+		TEXT("对比同步穿透与逐帧合并处理批量发放红点的耗时和回调次数：Yc.RedDot.BenchmarkBulkGrant [每轮发放数量=100] [轮数=100] [根标签=UI.RedDot]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcRedDotBenchmark::Run));
+}
@@ -4,6 +4,10 @@
 #include "YcRedDotManagerSubsystem.h"
 
 #include "YiChenRedDotSystem.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcRedDotManagerSubsystem)
@@ -22,12 +26,51 @@
 // ==================== 性能计数器声明 ====================
 DECLARE_STATS_GROUP(TEXT("YcRedDot"), STATGROUP_YcRedDot, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("AddRedDotCount"), STAT_YcRedDot_AddRedDotCount, STATGROUP_YcRedDot);
-DECLARE_CYCLE_STAT(TEXT("BroadcastRedDotChangedForward"), STAT_YcRedDot_BroadcastRedDotChangedForward, STATGROUP_YcRedDot);
+DECLARE_CYCLE_STAT(TEXT("FlushRedDotChanges"), STAT_YcRedDot_FlushRedDotChanges, STATGROUP_YcRedDot);
+DECLARE_CYCLE_STAT(TEXT("ResolvePendingRedDotCounts"), STAT_YcRedDot_ResolvePendingRedDotCounts, STATGROUP_YcRedDot);
 DECLARE_CYCLE_STAT(TEXT("FindAllChildTags"), STAT_YcRedDot_FindAllChildTags, STATGROUP_YcRedDot);
-DECLARE_CYCLE_STAT(TEXT("InvalidateTagHierarchyCache"), STAT_YcRedDot_InvalidateTagHierarchyCache, STATGROUP_YcRedDot);
+DECLARE_CYCLE_STAT(TEXT("RebuildBranchTable"), STAT_YcRedDot_RebuildBranchTable, STATGROUP_YcRedDot);
+DECLARE_CYCLE_STAT(TEXT("SaveRedDotSnapshot"), STAT_YcRedDot_SaveRedDotSnapshot, STATGROUP_YcRedDot);
+DECLARE_CYCLE_STAT(TEXT("LoadRedDotSnapshot"), STAT_YcRedDot_LoadRedDotSnapshot, STATGROUP_YcRedDot);
 DECLARE_CYCLE_STAT(TEXT("ClearRedDotStateInBranch"), STAT_YcRedDot_ClearRedDotStateInBranch, STATGROUP_YcRedDot);
 DECLARE_CYCLE_STAT(TEXT("RegisterRedDotStateChangedListener"), STAT_YcRedDot_RegisterRedDotStateChangedListener, STATGROUP_YcRedDot);
 DECLARE_CYCLE_STAT(TEXT("BroadcastRedDotCleared"), STAT_YcRedDot_BroadcastRedDotCleared, STATGROUP_YcRedDot);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RedDot Changes"), STAT_YcRedDot_NumChanges, STATGROUP_YcRedDot);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Resolved Parent Nodes"), STAT_YcRedDot_NumResolvedNodes, STATGROUP_YcRedDot);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Notified Nodes"), STAT_YcRedDot_NumNotifiedNodes, STATGROUP_YcRedDot);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listener Callbacks"), STAT_YcRedDot_NumListenerCallbacks, STATGROUP_YcRedDot);
+
+namespace YcRedDotCVars
+{
+	static bool bDeferPropagation = true;
+	static FAutoConsoleVariableRef CVarDeferPropagation(
+		TEXT("Yc.RedDot.DeferPropagation"),
+		bDeferPropagation,
+		TEXT("红点数量变化是否合并到每帧统一穿透和通知，false 表示每次修改后立即穿透并通知监听者"),
+		ECVF_Default);
+
+	// 监听者回调中不断产生新变化时, 单次 Flush 最多处理的轮数, 剩余的留到下一帧
+	static constexpr int32 MaxFlushPasses = 8;
+}
+
+// ==================== 红点快照格式 ====================
+// 头部: Magic(uint32) Version(uint32) 标签表哈希(uint32) 条目数(packed)
+// 条目: 与上一条目的标签网络索引差(packed) 节点自身数量(zigzag + packed), 按网络索引升序排列
+namespace YcRedDotSnapshot
+{
+	static constexpr uint32 Magic = 0x53445259; // "YRDS"
+	static constexpr uint32 Version = 1;
+
+	static uint32 ZigZagEncode(int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	static int32 ZigZagDecode(uint32 Value)
+	{
+		return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+	}
+}
 
 void FYcRedDotStateChangedListenerHandle::Unregister()
 {
@@ -79,6 +122,11 @@ void UYcRedDotManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 void UYcRedDotManagerSubsystem::Deinitialize()
 {
 	RedDotStates.Empty();
+	DirtyNodes.Empty();
+	bHasUnresolvedCounts = false;
+	BranchTable.Empty();
+	BranchIndices.Empty();
+	bBranchTableDirty = true;
 	Super::Deinitialize();
 }
 
@@ -87,6 +135,31 @@ bool UYcRedDotManagerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 	return true;
 }
 
+void UYcRedDotManagerSubsystem::Tick(float DeltaTime)
+{
+	FlushRedDotChanges();
+}
+
+ETickableTickType UYcRedDotManagerSubsystem::GetTickableTickType() const
+{
+	return ETickableTickType::Conditional;
+}
+
+bool UYcRedDotManagerSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && DirtyNodes.Num() > 0;
+}
+
+TStatId UYcRedDotManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UYcRedDotManagerSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UYcRedDotManagerSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
 void UYcRedDotManagerSubsystem::RegisterRedDotTag(FGameplayTag RedDotTag)
 {
 	if (!RedDotTag.IsValid())
@@ -95,10 +168,7 @@ void UYcRedDotManagerSubsystem::RegisterRedDotTag(FGameplayTag RedDotTag)
 		return;
 	}
 	
-	// 清理该标签相关的缓存，确保后续查询能获取最新的子标签
-	InvalidateTagHierarchyCache(RedDotTag);
-	
-	// 初始化该标签的红点信息
+	// 初始化该标签的红点信息, 新标签会使分支表过期
 	FRedDotInfo& Info = GetOrCreateRedDotInfo(RedDotTag);
 }
 
@@ -113,6 +183,12 @@ void UYcRedDotManagerSubsystem::AddRedDotCount(FGameplayTag RedDotTag, int32 Cou
 	}
 	
 	
+	// 减少时需要按最新的数量做下限限制, 所以先结算子节点尚未穿透上来的差量
+	if (Count < 0)
+	{
+		ResolvePendingRedDotCounts();
+	}
+	
 	FRedDotInfo& Info = GetOrCreateRedDotInfo(RedDotTag);
 	
 	if (Info.Count == 0 && Count <= 0) return;
@@ -124,14 +200,78 @@ void UYcRedDotManagerSubsystem::AddRedDotCount(FGameplayTag RedDotTag, int32 Cou
 	// 计算更新差量, 如果当前值为0了, 那么差量就是-OldCount, 否则为新传入的增量Count
 	Info.Delta = Info.Count == 0 ? -OldCount : Count;
 	Info.Tag = RedDotTag;
-	Info.TriggerTime = FDateTime::Now();
 	
-	// 应用更新, 广播更新事件
+	// 应用更新, 穿透和通知在 FlushRedDotChanges() 中统一处理
 	UpdateRedDotState(RedDotTag, Info);
+	
+	if (!YcRedDotCVars::bDeferPropagation)
+	{
+		FlushRedDotChanges();
+	}
+}
+
+void UYcRedDotManagerSubsystem::FlushRedDotChanges()
+{
+	// 在监听者回调中调用时, 新的变化由外层的循环继续处理
+	if (bFlushingRedDotChanges)
+	{
+		return;
+	}
+	
+	YC_REDDOT_SCOPE_CYCLE_COUNTER(FlushRedDotChanges);
+	TGuardValue<bool> FlushGuard(bFlushingRedDotChanges, true);
+	
+	for (int32 Pass = 0; Pass < YcRedDotCVars::MaxFlushPasses && DirtyNodes.Num() > 0; ++Pass)
+	{
+		ResolvePendingRedDotCounts();
+		
+		// 取出本轮的脏节点, 回调中产生的新变化会进入下一轮
+		TArray<TPair<FGameplayTag, FYcRedDotDirtyNode>> DirtyArray = DirtyNodes.Array();
+		DirtyNodes.Reset();
+		
+		// 由深到浅通知, 子节点的界面先于父节点刷新
+		DirtyArray.Sort([](const TPair<FGameplayTag, FYcRedDotDirtyNode>& A, const TPair<FGameplayTag, FYcRedDotDirtyNode>& B)
+		{
+			return A.Value.Depth > B.Value.Depth;
+		});
+		
+		const FDateTime TriggerTime = GetFrameTriggerTime();
+		INC_DWORD_STAT_BY(STAT_YcRedDot_NumNotifiedNodes, DirtyArray.Num());
+		
+		for (const TPair<FGameplayTag, FYcRedDotDirtyNode>& Pair : DirtyArray)
+		{
+			const FGameplayTag& Tag = Pair.Key;
+			const FYcRedDotDirtyNode& Node = Pair.Value;
+			
+			FRedDotInfo* Info = RedDotStates.Find(Tag);
+			if (Info == nullptr) continue;
+			Info->Tag = Tag;
+			Info->Delta = Node.FrameDelta;
+			Info->TriggerTime = TriggerTime;
+			
+			const FYcRedDotListenerList* pList = ListenerMap.Find(Tag);
+			if (pList == nullptr) continue;
+			
+			// 回调中可能修改红点数据导致 RedDotStates 扩容, 因此传递副本而不是容器内的指针
+			const FRedDotInfo InfoSnapshot = *Info;
+			// 复制以防在处理回调时出现删除情况
+			TArray<FYcRedDotStateChangedListenerData> ListenerArray(pList->Listeners);
+			for (const FYcRedDotStateChangedListenerData& Listener : ListenerArray)
+			{
+				// 仅由子节点穿透上来的变化, 只通知 PartialMatch 的监听者
+				if (!Node.bDirectChange && Listener.MatchType != EYcRedDotTagMatch::PartialMatch) continue;
+				if (!Listener.ReceivedCallback.IsSet()) continue;
+				INC_DWORD_STAT(STAT_YcRedDot_NumListenerCallbacks);
+				Listener.ReceivedCallback(Listener.MatchType == EYcRedDotTagMatch::ExactMatch ? Tag : Node.ChangedTag, &InfoSnapshot);
+			}
+		}
+	}
 }
 
 bool UYcRedDotManagerSubsystem::GetRedDotInfo(const FGameplayTag& RedDotTag, FRedDotInfo& InOutInfo)
 {
+	ResolvePendingRedDotCounts();
+	
 	if (const FRedDotInfo* Info = RedDotStates.Find(RedDotTag))
 	{
 		InOutInfo = *Info;
@@ -143,6 +283,9 @@ bool UYcRedDotManagerSubsystem::GetRedDotInfo(const FGameplayTag& RedDotTag, FRe
 
 bool UYcRedDotManagerSubsystem::IsRedDotActive(const FGameplayTag& RedDotTag) const
 {
+	// 结算只会把子节点已发生的变化累加到父节点, 不改变对外可见的语义
+	const_cast<UYcRedDotManagerSubsystem*>(this)->ResolvePendingRedDotCounts();
+	
 	if (const FRedDotInfo* Info = RedDotStates.Find(RedDotTag))
 	{
 		return Info->Count > 0;
@@ -153,6 +296,8 @@ bool UYcRedDotManagerSubsystem::IsRedDotActive(const FGameplayTag& RedDotTag) co
 
 TArray<FGameplayTag> UYcRedDotManagerSubsystem::GetAllActiveRedDotTags() const
 {
+	const_cast<UYcRedDotManagerSubsystem*>(this)->ResolvePendingRedDotCounts();
+	
 	TArray<FGameplayTag> ActiveTags;
     
 	for (const auto& Pair : RedDotStates)
@@ -168,6 +313,8 @@ TArray<FGameplayTag> UYcRedDotManagerSubsystem::GetAllActiveRedDotTags() const
 
 void UYcRedDotManagerSubsystem::GetAllRedDotInfos(TArray<FRedDotInfo>& InOutRedDots)
 {
+	ResolvePendingRedDotCounts();
+	
 	for (const auto& Pair : RedDotStates)
 	{
 		InOutRedDots.Add(Pair.Value);
@@ -180,35 +327,35 @@ void UYcRedDotManagerSubsystem::ClearRedDotStateInBranch(const FGameplayTag& Par
 	
 	if (!ParentTag.IsValid()) return;
 	
+	// 先结算尚未穿透的差量, 保证父节点清零时扣除的是完整的数量, 且子节点的差量不会在清理后再穿透上来
+	ResolvePendingRedDotCounts();
+	
 	// 父节点向上更新穿透数据
 	FRedDotInfo& ParentInfo = GetOrCreateRedDotInfo(ParentTag);
 	ParentInfo.Tag = ParentTag;
 	ParentInfo.Delta = -ParentInfo.Count;
 	ParentInfo.Count = 0;
-	ParentInfo.TriggerTime = FDateTime::Now();
 	UpdateRedDotState(ParentTag, ParentInfo);
 	BroadcastRedDotCleared(ParentTag);
 	
-	TArray<FGameplayTag> TagsToUpdate;
-    
-	// 添加父标签
-	TagsToUpdate.Add(ParentTag);
-	
-	// 添加所有子标签
+	// 所有子标签, 从分支表的连续区间中复制, 提供者回调中注册新标签导致分支表重建也不会影响遍历
 	TArray<FGameplayTag> ChildTags = FindAllChildTags(ParentTag);
-	TagsToUpdate.Append(ChildTags);
 	
-	// 子节点全部直接置零,并调用回调通知更新RedDotState
+	// 子节点全部直接置零, 标记为脏节点由 FlushRedDotChanges() 通知监听者, 父节点已经清零所以不再向上穿透
 	for (const FGameplayTag& Tag : ChildTags)
 	{
 		FRedDotInfo& Info = GetOrCreateRedDotInfo(Tag);
 		Info.Tag = Tag;
 		Info.Delta = 0;
 		Info.Count = 0;
-		Info.TriggerTime = FDateTime::Now();
-		BroadcastRedDotChangedSingle(Tag, &Info);
+		MarkRedDotDirty(Tag, 0, false);
 		BroadcastRedDotCleared(Tag);
 	}
+	
+	if (!YcRedDotCVars::bDeferPropagation)
+	{
+		FlushRedDotChanges();
+	}
 }
 
 FYcRedDotStateChangedListenerHandle UYcRedDotManagerSubsystem::RegisterRedDotStateChangedListener(FGameplayTag RedDotTag,
@@ -228,61 +375,6 @@ FYcRedDotStateChangedListenerHandle UYcRedDotManagerSubsystem::RegisterRedDotSta
 	return Handle;
 }
 
-void UYcRedDotManagerSubsystem::BroadcastRedDotChangedForward(FGameplayTag RedDotTag, const FRedDotInfo* RedDotInfo)
-{
-	YC_REDDOT_SCOPE_CYCLE_COUNTER(BroadcastRedDotChangedForward);
-	
-	// 标记是否为初始标签, 因为我们会在循环中向前寻找父标签， 只有在第一次循环才是使用的初始标签
-	bool bOnInitialTag = true;
-	// 本次更新的差量, 用于叠加到父节点进行数量变化的透传
-	int Delta = RedDotInfo->Delta;
-	for (FGameplayTag Tag = RedDotTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
-	{
-		// 必须用GetOrCreateRedDotInfo(), 以确保ParentTag能被注册在RedDotStates中, 否则会丢失父级节点统计数据
-		FRedDotInfo* ParentRedDotInfo = &GetOrCreateRedDotInfo(Tag);
-		check(ParentRedDotInfo); // 必须保证有效, 否则层级数据就不完整了
-		
-		// 对父节点进行数量变化的透传
-		if (!bOnInitialTag)
-		{
-			ParentRedDotInfo->Count += Delta;
-		}
-		
-		// 如果存在监听者, 就调用监听者回调通知数量发生改变
-		const FYcRedDotListenerList* pList = ListenerMap.Find(Tag);
-		if(pList != nullptr)
-		{
-			// 复制以防在处理回调时出现删除情况
-			TArray<FYcRedDotStateChangedListenerData> ListenerArray(pList->Listeners);
-			// 遍历当前标签的监听列表
-			for (const FYcRedDotStateChangedListenerData& Listener : ListenerArray)
-			{
-				// !bOnInitialTag代表当前标签是发生变化的标签的父标签, 父标签的监听匹配类型需要是PartialMatch才进行调用
-				if (!bOnInitialTag && Listener.MatchType != EYcRedDotTagMatch::PartialMatch) continue;
-				if (!Listener.ReceivedCallback.IsSet()) continue;
-				Listener.ReceivedCallback(RedDotTag, ParentRedDotInfo);
-			}
-		}
-		bOnInitialTag = false; // 第一次循环结束及后续都保持初始标记为false, 代表正在遍历父级标签
-	}
-}
-
-void UYcRedDotManagerSubsystem::BroadcastRedDotChangedSingle(FGameplayTag RedDotTag, const FRedDotInfo* RedDotInfo)
-{
-	const FYcRedDotListenerList* pList = &ListenerMap.FindOrAdd(RedDotTag);
-	if (pList == nullptr) return;
-	// 复制以防在处理回调时出现删除情况
-	TArray<FYcRedDotStateChangedListenerData> ListenerArray(pList->Listeners);
-	// 遍历当前标签的监听列表
-	for (const FYcRedDotStateChangedListenerData& Listener : ListenerArray)
-	{
-		if (Listener.ReceivedCallback.IsSet())
-		{
-			Listener.ReceivedCallback(RedDotTag, RedDotInfo);
-		}
-	}
-}
-
 void UYcRedDotManagerSubsystem::BroadcastRedDotCleared(FGameplayTag RedDotTag)
 {
 	const FYcRedDotListenerList* pList = &ListenerMap.FindOrAdd(RedDotTag);
@@ -312,19 +404,15 @@ FYcRedDotDataProviderHandle UYcRedDotManagerSubsystem::RegisterRedDotDataProvide
 
 FRedDotInfo& UYcRedDotManagerSubsystem::GetOrCreateRedDotInfo(const FGameplayTag& RedDotTag)
 {
-	bool bContains = RedDotStates.Contains(RedDotTag);
 	FRedDotInfo* Info = RedDotStates.Find(RedDotTag);
-	if (!bContains)
-	{
-		// 先前不存在, 是新建的, 所以需要清理该标签相关的缓存，确保后续查询能获取最新的子标签
-		InvalidateTagHierarchyCache(RedDotTag);
-	}
-	
 	if (!Info)
 	{
+		// 先前不存在, 是新建的, 所以需要标记分支表过期，确保后续查询能获取最新的子标签
+		InvalidateBranchTable();
+		
 		Info = &RedDotStates.Add(RedDotTag);
 		Info->Tag = RedDotTag;
-		Info->TriggerTime = FDateTime::Now();
+		Info->TriggerTime = GetFrameTriggerTime();
 	}
     
 	return *Info;
@@ -332,23 +420,148 @@ FRedDotInfo& UYcRedDotManagerSubsystem::GetOrCreateRedDotInfo(const FGameplayTag
 
 void UYcRedDotManagerSubsystem::UpdateRedDotState(const FGameplayTag& RedDotTag, const FRedDotInfo& NewInfo)
 {
-	// 广播全局委托, 通知节点发生变化
-	BroadcastRedDotChangedForward(RedDotTag, &NewInfo);
+	// 记录为脏节点, 差量在结算时向上穿透, 通知在当帧 Flush 时统一进行
+	MarkRedDotDirty(RedDotTag, NewInfo.Delta);
+}
+
+UYcRedDotManagerSubsystem::FYcRedDotDirtyNode& UYcRedDotManagerSubsystem::FindOrAddDirtyNode(const FGameplayTag& RedDotTag, int32 Depth)
+{
+	if (FYcRedDotDirtyNode* Node = DirtyNodes.Find(RedDotTag))
+	{
+		return *Node;
+	}
+	
+	// 调用方不知道深度时才沿父标签逐级计算, 由子节点穿透上来的父节点直接使用子节点深度减一
+	if (Depth <= 0)
+	{
+		for (FGameplayTag Tag = RedDotTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+		{
+			++Depth;
+		}
+	}
+	
+	FYcRedDotDirtyNode& Node = DirtyNodes.Add(RedDotTag);
+	Node.Depth = Depth;
+	Node.ChangedTag = RedDotTag;
+	return Node;
+}
+
+void UYcRedDotManagerSubsystem::MarkRedDotDirty(const FGameplayTag& RedDotTag, int32 Delta, bool bPropagate)
+{
+	INC_DWORD_STAT(STAT_YcRedDot_NumChanges);
+	
+	FYcRedDotDirtyNode& Node = FindOrAddDirtyNode(RedDotTag);
+	Node.bDirectChange = true;
+	Node.ChangedTag = RedDotTag;
+	Node.FrameDelta += Delta;
+	if (bPropagate && Delta != 0)
+	{
+		Node.PendingDelta += Delta;
+		bHasUnresolvedCounts = true;
+	}
+}
+
+void UYcRedDotManagerSubsystem::ResolvePendingRedDotCounts()
+{
+	if (!bHasUnresolvedCounts)
+	{
+		return;
+	}
+	bHasUnresolvedCounts = false;
+	
+	YC_REDDOT_SCOPE_CYCLE_COUNTER(ResolvePendingRedDotCounts);
+	
+	// 按深度分组, 由深到浅逐层处理, 父节点在其所有子节点处理完后才处理, 所以每个节点只会向上穿透一次
+	TArray<TArray<FGameplayTag>, TInlineAllocator<8>> TagsByDepth;
+	for (TPair<FGameplayTag, FYcRedDotDirtyNode>& Pair : DirtyNodes)
+	{
+		if (Pair.Value.PendingDelta != 0)
+		{
+			if (TagsByDepth.Num() <= Pair.Value.Depth)
+			{
+				TagsByDepth.SetNum(Pair.Value.Depth + 1);
+			}
+			TagsByDepth[Pair.Value.Depth].Add(Pair.Key);
+			Pair.Value.bQueuedForResolve = true;
+		}
+	}
+	
+	for (int32 Depth = TagsByDepth.Num() - 1; Depth > 1; --Depth)
+	{
+		for (const FGameplayTag& Tag : TagsByDepth[Depth])
+		{
+			// 父节点加入 DirtyNodes 时可能扩容, 先把子节点的数据取出来
+			FYcRedDotDirtyNode& Node = DirtyNodes.FindChecked(Tag);
+			const int32 Delta = Node.PendingDelta;
+			const FGameplayTag ChangedTag = Node.ChangedTag;
+			Node.PendingDelta = 0;
+			Node.bQueuedForResolve = false;
+			
+			const FGameplayTag ParentTag = Tag.RequestDirectParent();
+			if (Delta == 0 || !ParentTag.IsValid()) continue;
+			
+			// 必须用GetOrCreateRedDotInfo(), 以确保ParentTag能被注册在RedDotStates中, 否则会丢失父级节点统计数据
+			GetOrCreateRedDotInfo(ParentTag).Count += Delta;
+			INC_DWORD_STAT(STAT_YcRedDot_NumResolvedNodes);
+			
+			FYcRedDotDirtyNode& ParentNode = FindOrAddDirtyNode(ParentTag, Depth - 1);
+			ParentNode.PendingDelta += Delta;
+			ParentNode.FrameDelta += Delta;
+			ParentNode.ChangedTag = ChangedTag;
+			if (!ParentNode.bQueuedForResolve)
+			{
+				ParentNode.bQueuedForResolve = true;
+				TagsByDepth[Depth - 1].Add(ParentTag);
+			}
+		}
+	}
+	
+	// 根节点没有父节点, 只需清除差量
+	if (TagsByDepth.Num() > 1)
+	{
+		for (const FGameplayTag& Tag : TagsByDepth[1])
+		{
+			FYcRedDotDirtyNode& Node = DirtyNodes.FindChecked(Tag);
+			Node.PendingDelta = 0;
+			Node.bQueuedForResolve = false;
+		}
+	}
+}
+
+const FDateTime& UYcRedDotManagerSubsystem::GetFrameTriggerTime()
+{
+	if (CachedTriggerTimeFrame != GFrameCounter)
+	{
+		CachedTriggerTime = FDateTime::Now();
+		CachedTriggerTimeFrame = GFrameCounter;
+	}
+	return CachedTriggerTime;
 }
 
 TArray<FGameplayTag> UYcRedDotManagerSubsystem::FindAllChildTags(const FGameplayTag& ParentTag) const
 {
 	YC_REDDOT_SCOPE_CYCLE_COUNTER(FindAllChildTags);
 	
-	// 检查缓存，如果存在直接返回
-	if (const TArray<FGameplayTag>* CachedChildren = TagHierarchyCache.Find(ParentTag))
+	if (bBranchTableDirty)
 	{
-		return *CachedChildren;
+		const_cast<UYcRedDotManagerSubsystem*>(this)->RebuildBranchTable();
 	}
-    
+	
 	TArray<FGameplayTag> AllChildren;
+	
+	// 已注册的父标签, 子标签就是分支表中紧随其后的连续区间
+	if (const int32* ParentIndex = BranchIndices.Find(ParentTag))
+	{
+		const int32 End = BranchTable[*ParentIndex].End;
+		AllChildren.Reserve(End - *ParentIndex - 1);
+		for (int32 Index = *ParentIndex + 1; Index < End; ++Index)
+		{
+			AllChildren.Add(BranchTable[Index].Tag);
+		}
+		return AllChildren;
+	}
     
-	// 遍历所有标签，查找子标签
+	// 父标签本身没有注册, 遍历所有标签查找子标签
 	for (const auto& Pair : RedDotStates)
 	{
 		if (Pair.Key.MatchesTag(ParentTag) && Pair.Key != ParentTag)
@@ -356,33 +569,221 @@ TArray<FGameplayTag> UYcRedDotManagerSubsystem::FindAllChildTags(const FGameplay
 			AllChildren.Add(Pair.Key);
 		}
 	}
-    
-	// 更新缓存
-	const_cast<UYcRedDotManagerSubsystem*>(this)->TagHierarchyCache.Add(ParentTag, AllChildren);
 	return AllChildren;
 }
 
-void UYcRedDotManagerSubsystem::InvalidateTagHierarchyCache(const FGameplayTag& NewTag)
+void UYcRedDotManagerSubsystem::InvalidateBranchTable()
 {
-	YC_REDDOT_SCOPE_CYCLE_COUNTER(InvalidateTagHierarchyCache);
+	bBranchTableDirty = true;
+}
+
+void UYcRedDotManagerSubsystem::RebuildBranchTable()
+{
+	YC_REDDOT_SCOPE_CYCLE_COUNTER(RebuildBranchTable);
+	
+	bBranchTableDirty = false;
 	
-	if (!NewTag.IsValid())
+	// 把分隔符替换为最小的字符后排序, 子标签一定紧跟在父标签之后（例如 A.B.C 排在 A.B-X 之前）
+	TArray<TPair<FString, FGameplayTag>> SortKeys;
+	SortKeys.Reserve(RedDotStates.Num());
+	for (const auto& Pair : RedDotStates)
 	{
-		return;
+		FString Key = Pair.Key.ToString();
+		Key.ReplaceCharInline(TEXT('.'), TEXT('\x01'));
+		SortKeys.Emplace(MoveTemp(Key), Pair.Key);
 	}
+	SortKeys.Sort([](const TPair<FString, FGameplayTag>& A, const TPair<FString, FGameplayTag>& B) { return A.Key < B.Key; });
+	
+	BranchTable.Reset(SortKeys.Num());
+	BranchIndices.Reset();
+	BranchIndices.Reserve(SortKeys.Num());
 	
-	// 使用迭代器遍历缓存，清理所有包含 NewTag 作为子标签的父标签缓存, 以便后续访问时构建新的完整的子标签缓存, 避免丢失新的子标签
-	for (auto It = TagHierarchyCache.CreateIterator(); It; ++It)
+	// 栈中保存当前标签的所有祖先, 遇到不属于栈顶子树的标签时, 栈顶子树到此结束
+	TArray<int32, TInlineAllocator<16>> AncestorStack;
+	for (int32 Index = 0; Index < SortKeys.Num(); ++Index)
 	{
-		const FGameplayTag& CachedParentTag = It.Key();
+		const FGameplayTag& Tag = SortKeys[Index].Value;
+		while (AncestorStack.Num() > 0 && !Tag.MatchesTag(BranchTable[AncestorStack.Last()].Tag))
+		{
+			BranchTable[AncestorStack.Pop(EAllowShrinking::No)].End = Index;
+		}
 		
-		// 检查 NewTag 是否是 CachedParentTag 的子标签
-		// 如果 NewTag 匹配 CachedParentTag 且不相等，说明 NewTag 是 CachedParentTag 的子标签
-		if (NewTag.MatchesTag(CachedParentTag) && NewTag != CachedParentTag)
+		FYcRedDotBranchEntry& Entry = BranchTable.AddDefaulted_GetRef();
+		Entry.Tag = Tag;
+		BranchIndices.Add(Tag, Index);
+		AncestorStack.Add(Index);
+	}
+	while (AncestorStack.Num() > 0)
+	{
+		BranchTable[AncestorStack.Pop(EAllowShrinking::No)].End = SortKeys.Num();
+	}
+}
+
+bool UYcRedDotManagerSubsystem::SaveRedDotSnapshot(TArray<uint8>& OutData)
+{
+	YC_REDDOT_SCOPE_CYCLE_COUNTER(SaveRedDotSnapshot);
+	
+	ResolvePendingRedDotCounts();
+	
+	// 节点数量 = 自身数量 + 直接子节点数量之和, 只保存自身数量, 加载时再聚合出父节点
+	TMap<FGameplayTag, int32> OwnCounts;
+	OwnCounts.Reserve(RedDotStates.Num());
+	for (const auto& Pair : RedDotStates)
+	{
+		if (Pair.Value.Count == 0) continue;
+		OwnCounts.FindOrAdd(Pair.Key) += Pair.Value.Count;
+		
+		const FGameplayTag ParentTag = Pair.Key.RequestDirectParent();
+		if (ParentTag.IsValid())
+		{
+			OwnCounts.FindOrAdd(ParentTag) -= Pair.Value.Count;
+		}
+	}
+	
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	TArray<TPair<FGameplayTagNetIndex, int32>> Entries;
+	Entries.Reserve(OwnCounts.Num());
+	for (const TPair<FGameplayTag, int32>& Pair : OwnCounts)
+	{
+		if (Pair.Value == 0) continue;
+		
+		const FGameplayTagNetIndex NetIndex = TagsManager.GetNetIndexFromTag(Pair.Key);
+		if (NetIndex == INVALID_TAGNETINDEX)
 		{
-			It.RemoveCurrent();
+			UE_LOG(LogYcRedDot, Warning, TEXT("SaveRedDotSnapshot: 标签 %s 没有网络索引, 无法保存快照"), *Pair.Key.ToString());
+			return false;
 		}
+		Entries.Emplace(NetIndex, Pair.Value);
+	}
+	Entries.Sort([](const TPair<FGameplayTagNetIndex, int32>& A, const TPair<FGameplayTagNetIndex, int32>& B) { return A.Key < B.Key; });
+	
+	OutData.Reset();
+	FMemoryWriter Writer(OutData);
+	uint32 Magic = YcRedDotSnapshot::Magic;
+	uint32 Version = YcRedDotSnapshot::Version;
+	uint32 TagTableHash = TagsManager.GetNetworkGameplayTagNodeIndexHash();
+	uint32 NumEntries = Entries.Num();
+	Writer << Magic << Version << TagTableHash;
+	Writer.SerializeIntPacked(NumEntries);
+	
+	uint32 PreviousNetIndex = 0;
+	for (const TPair<FGameplayTagNetIndex, int32>& Entry : Entries)
+	{
+		uint32 NetIndexDelta = Entry.Key - PreviousNetIndex;
+		uint32 EncodedCount = YcRedDotSnapshot::ZigZagEncode(Entry.Value);
+		Writer.SerializeIntPacked(NetIndexDelta);
+		Writer.SerializeIntPacked(EncodedCount);
+		PreviousNetIndex = Entry.Key;
+	}
+	return true;
+}
+
+bool UYcRedDotManagerSubsystem::LoadRedDotSnapshot(const TArray<uint8>& Data)
+{
+	YC_REDDOT_SCOPE_CYCLE_COUNTER(LoadRedDotSnapshot);
+	
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	
+	// 先完整解析并校验, 数据有问题时不修改当前红点数据
+	FMemoryReader Reader(Data);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint32 TagTableHash = 0;
+	uint32 NumEntries = 0;
+	Reader << Magic << Version << TagTableHash;
+	Reader.SerializeIntPacked(NumEntries);
+	if (Reader.IsError() || Magic != YcRedDotSnapshot::Magic || Version != YcRedDotSnapshot::Version)
+	{
+		UE_LOG(LogYcRedDot, Warning, TEXT("LoadRedDotSnapshot: 快照数据无效或版本不支持"));
+		return false;
+	}
+	if (TagTableHash != TagsManager.GetNetworkGameplayTagNodeIndexHash())
+	{
+		UE_LOG(LogYcRedDot, Warning, TEXT("LoadRedDotSnapshot: 标签表已变化, 快照无法使用"));
+		return false;
+	}
+	// 每个条目至少占 2 字节, 防止损坏的条目数导致过量分配
+	if (NumEntries > static_cast<uint32>(Data.Num()) / 2)
+	{
+		UE_LOG(LogYcRedDot, Warning, TEXT("LoadRedDotSnapshot: 快照条目数 %u 与数据大小不符"), NumEntries);
+		return false;
 	}
+	
+	TArray<TPair<FGameplayTag, int32>> Entries;
+	Entries.Reserve(NumEntries);
+	uint32 NetIndex = 0;
+	for (uint32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+	{
+		uint32 NetIndexDelta = 0;
+		uint32 EncodedCount = 0;
+		Reader.SerializeIntPacked(NetIndexDelta);
+		Reader.SerializeIntPacked(EncodedCount);
+		NetIndex += NetIndexDelta;
+		
+		const FGameplayTag Tag = NetIndex < INVALID_TAGNETINDEX
+			? TagsManager.RequestGameplayTagFromNetIndex(static_cast<FGameplayTagNetIndex>(NetIndex))
+			: FGameplayTag();
+		if (Reader.IsError() || !Tag.IsValid())
+		{
+			UE_LOG(LogYcRedDot, Warning, TEXT("LoadRedDotSnapshot: 快照第 %u 个条目无效"), EntryIndex);
+			return false;
+		}
+		Entries.Emplace(Tag, YcRedDotSnapshot::ZigZagDecode(EncodedCount));
+	}
+	if (!Reader.AtEnd())
+	{
+		UE_LOG(LogYcRedDot, Warning, TEXT("LoadRedDotSnapshot: 快照末尾存在多余数据"));
+		return false;
+	}
+	
+	// 加载前的变化先正常通知, 之后记录有监听者的节点原来的数量, 加载完成后只通知其中数量变化的节点
+	FlushRedDotChanges();
+	ResolvePendingRedDotCounts();
+	TMap<FGameplayTag, int32> ListenedOldCounts;
+	for (const TPair<FGameplayTag, FYcRedDotListenerList>& Pair : ListenerMap)
+	{
+		if (Pair.Value.Listeners.Num() > 0)
+		{
+			const FRedDotInfo* Info = RedDotStates.Find(Pair.Key);
+			ListenedOldCounts.Add(Pair.Key, Info ? Info->Count : 0);
+		}
+	}
+	
+	const FDateTime TriggerTime = GetFrameTriggerTime();
+	for (auto& Pair : RedDotStates)
+	{
+		Pair.Value.Count = 0;
+		Pair.Value.Delta = 0;
+		Pair.Value.TriggerTime = TriggerTime;
+	}
+	DirtyNodes.Reset();
+	
+	// 写入各节点自身的数量, 再由深到浅一次性聚合到父节点, 每个父节点只处理一次
+	for (const TPair<FGameplayTag, int32>& Entry : Entries)
+	{
+		GetOrCreateRedDotInfo(Entry.Key).Count += Entry.Value;
+		FindOrAddDirtyNode(Entry.Key).PendingDelta += Entry.Value;
+	}
+	bHasUnresolvedCounts = Entries.Num() > 0;
+	ResolvePendingRedDotCounts();
+	DirtyNodes.Reset();
+	
+	for (const TPair<FGameplayTag, int32>& Pair : ListenedOldCounts)
+	{
+		const FRedDotInfo* Info = RedDotStates.Find(Pair.Key);
+		const int32 NewCount = Info ? Info->Count : 0;
+		if (NewCount == Pair.Value) continue;
+		
+		FYcRedDotDirtyNode& Node = FindOrAddDirtyNode(Pair.Key);
+		Node.bDirectChange = true;
+		Node.FrameDelta = NewCount - Pair.Value;
+	}
+	
+	if (!YcRedDotCVars::bDeferPropagation)
+	{
+		FlushRedDotChanges();
+	}
+	return true;
 }
 
 void UYcRedDotManagerSubsystem::UnregisterStateChangedListener(FYcRedDotStateChangedListenerHandle Handle)
@@ -0,0 +1,385 @@
+﻿// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "YcRedDotManagerSubsystem.h"
+#include "YiChenRedDotSystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * 红点快照测试（控制台命令）
+ *
+ * Yc.RedDot.TestSnapshot: 随机构建一组红点数据（包含直接修改父节点、减少数量和清理分支）, 验证:
+ * - 保存后加载到新的管理器, 所有节点数量一致, 再次保存得到的数据完全相同
+ * - 加载到已有数据的管理器时, 只有数量发生变化的监听节点收到通知
+ * - 截断、魔数错误、末尾多余数据的快照加载失败且不修改现有数据
+ * - 分支表查询的子标签与遍历所有红点的结果一致, 加载后清理分支的结果与原数据一致
+ *
+ * Yc.RedDot.BenchmarkSnapshotLoad: 对比逐条重放 AddRedDotCount 与加载快照恢复大量标签的耗时,
+ * 以及遍历查找子标签与分支表区间查找的耗时。
+ *
+ * 都使用单独创建的红点管理器实例, 不影响游戏中的红点数据。
+ */
+struct FYcRedDotSnapshotTest
+{
+	static UYcRedDotManagerSubsystem* CreateManager(UGameInstance* GameInstance)
+	{
+		return NewObject<UYcRedDotManagerSubsystem>(GameInstance);
+	}
+
+	static void DestroyManager(UYcRedDotManagerSubsystem* RedDots)
+	{
+		RedDots->ListenerMap.Reset();
+		RedDots->RedDotStates.Reset();
+		RedDots->DirtyNodes.Reset();
+		RedDots->MarkAsGarbage();
+	}
+
+	static TMap<FGameplayTag, int32> CollectCounts(UYcRedDotManagerSubsystem& RedDots)
+	{
+		RedDots.ResolvePendingRedDotCounts();
+		TMap<FGameplayTag, int32> Counts;
+		for (const TPair<FGameplayTag, FRedDotInfo>& Pair : RedDots.RedDotStates)
+		{
+			if (Pair.Value.Count != 0)
+			{
+				Counts.Add(Pair.Key, Pair.Value.Count);
+			}
+		}
+		return Counts;
+	}
+
+	static void CompareCounts(const TMap<FGameplayTag, int32>& Expected, const TMap<FGameplayTag, int32>& Actual, const TCHAR* Label, int32& NumErrors)
+	{
+		if (Expected.OrderIndependentCompareEqual(Actual))
+		{
+			return;
+		}
+		UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: %s: 红点数量不一致 (期望 %d 个非零节点, 实际 %d 个)"), Label, Expected.Num(), Actual.Num());
+		for (const TPair<FGameplayTag, int32>& Pair : Expected)
+		{
+			const int32* ActualCount = Actual.Find(Pair.Key);
+			if (!ActualCount || *ActualCount != Pair.Value)
+			{
+				UE_LOG(LogYcRedDot, Error, TEXT("  %s: 期望 %d, 实际 %d"), *Pair.Key.ToString(), Pair.Value, ActualCount ? *ActualCount : 0);
+			}
+		}
+		++NumErrors;
+	}
+
+	// 取已注册的标签, 深的标签优先, 让测试数据有完整的层级
+	static TArray<FGameplayTag> CollectTags(const int32 MaxTags)
+	{
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, /*OnlyIncludeDictionaryTags=*/ false);
+		TArray<FGameplayTag> Tags = AllTags.GetGameplayTagArray();
+		Tags.Sort([](const FGameplayTag& A, const FGameplayTag& B) { return A.GetGameplayTagParents().Num() > B.GetGameplayTagParents().Num(); });
+		if (Tags.Num() > MaxTags)
+		{
+			Tags.SetNum(MaxTags);
+		}
+		return Tags;
+	}
+
+	static void BuildRandomState(UYcRedDotManagerSubsystem& RedDots, const TArray<FGameplayTag>& Tags, FRandomStream& Random, const int32 NumOperations)
+	{
+		for (int32 i = 0; i < NumOperations; ++i)
+		{
+			const FGameplayTag& Tag = Tags[Random.RandHelper(Tags.Num())];
+			if (i % 7 == 6)
+			{
+				RedDots.AddRedDotCount(Tag, -1);
+			}
+			else if (i % 11 == 10 && Tag.RequestDirectParent().IsValid())
+			{
+				// 直接修改父节点, 父节点自身也有数量
+				RedDots.AddRedDotCount(Tag.RequestDirectParent(), Random.RandRange(1, 3));
+			}
+			else
+			{
+				RedDots.AddRedDotCount(Tag, Random.RandRange(1, 3));
+			}
+		}
+		RedDots.FlushRedDotChanges();
+	}
+
+	static void RunTest(const TArray<FString>& Args, UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		if (!GameInstance)
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: 需要在有 GameInstance 的游戏世界中执行"));
+			return;
+		}
+
+		const TArray<FGameplayTag> Tags = CollectTags(200);
+		if (Tags.Num() == 0)
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: 没有已注册的标签"));
+			return;
+		}
+
+		int32 NumErrors = 0;
+		FRandomStream Random(20250117);
+
+		UYcRedDotManagerSubsystem* Source = CreateManager(GameInstance);
+		BuildRandomState(*Source, Tags, Random, 500);
+		const FGameplayTag BranchTag = Tags[0].RequestDirectParent().IsValid() ? Tags[0].RequestDirectParent() : Tags[0];
+		Source->ClearRedDotStateInBranch(BranchTag);
+		Source->AddRedDotCount(Tags[0], 2);
+		Source->FlushRedDotChanges();
+		const TMap<FGameplayTag, int32> SourceCounts = CollectCounts(*Source);
+
+		// 1. 保存后加载到新的管理器
+		TArray<uint8> SourceData;
+		if (!Source->SaveRedDotSnapshot(SourceData))
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: 保存快照失败"));
+			++NumErrors;
+		}
+
+		UYcRedDotManagerSubsystem* Loaded = CreateManager(GameInstance);
+		if (!Loaded->LoadRedDotSnapshot(SourceData))
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: 加载快照失败"));
+			++NumErrors;
+		}
+		CompareCounts(SourceCounts, CollectCounts(*Loaded), TEXT("加载到新的管理器"), NumErrors);
+
+		TArray<uint8> ReloadedData;
+		Loaded->SaveRedDotSnapshot(ReloadedData);
+		if (ReloadedData != SourceData)
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: 加载后再次保存的快照与原快照不同 (%d / %d 字节)"), ReloadedData.Num(), SourceData.Num());
+			++NumErrors;
+		}
+
+		// 2. 分支表查询与遍历结果一致
+		for (const TPair<FGameplayTag, FRedDotInfo>& Pair : Loaded->RedDotStates)
+		{
+			TSet<FGameplayTag> Expected;
+			for (const TPair<FGameplayTag, FRedDotInfo>& Other : Loaded->RedDotStates)
+			{
+				if (Other.Key.MatchesTag(Pair.Key) && Other.Key != Pair.Key)
+				{
+					Expected.Add(Other.Key);
+				}
+			}
+			const TArray<FGameplayTag> Children = Loaded->FindAllChildTags(Pair.Key);
+			if (Children.Num() != Expected.Num() || Children.ContainsByPredicate([&Expected](const FGameplayTag& Child) { return !Expected.Contains(Child); }))
+			{
+				UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: %s 的子标签与遍历结果不一致 (%d / %d)"), *Pair.Key.ToString(), Children.Num(), Expected.Num());
+				++NumErrors;
+			}
+		}
+
+		// 3. 加载后清理分支, 与原数据清理同一分支的结果一致
+		const FGameplayTag ClearTag = Tags.Last().RequestDirectParent().IsValid() ? Tags.Last().RequestDirectParent() : Tags.Last();
+		Source->ClearRedDotStateInBranch(ClearTag);
+		Loaded->ClearRedDotStateInBranch(ClearTag);
+		Source->FlushRedDotChanges();
+		Loaded->FlushRedDotChanges();
+		CompareCounts(CollectCounts(*Source), CollectCounts(*Loaded), TEXT("加载后清理分支"), NumErrors);
+
+		// 4. 加载到已有数据的管理器, 只通知数量变化的监听节点
+		TMap<FGameplayTag, int32> CallsPerTag;
+		TArray<FGameplayTag> ListenedTags;
+		Loaded->RedDotStates.GetKeys(ListenedTags);
+		for (const FGameplayTag& Tag : ListenedTags)
+		{
+			Loaded->RegisterRedDotStateChangedListener(Tag, [&CallsPerTag, Tag](FGameplayTag, const FRedDotInfo*) { ++CallsPerTag.FindOrAdd(Tag); },
+				EYcRedDotTagMatch::PartialMatch, false);
+		}
+		const TMap<FGameplayTag, int32> CountsBeforeReload = CollectCounts(*Loaded);
+		Loaded->LoadRedDotSnapshot(SourceData);
+		Loaded->FlushRedDotChanges();
+		const TMap<FGameplayTag, int32> CountsAfterReload = CollectCounts(*Loaded);
+		CompareCounts(SourceCounts, CountsAfterReload, TEXT("加载到已有数据的管理器"), NumErrors);
+		for (const FGameplayTag& Tag : ListenedTags)
+		{
+			const int32* Before = CountsBeforeReload.Find(Tag);
+			const int32* After = CountsAfterReload.Find(Tag);
+			const bool bChanged = (Before ? *Before : 0) != (After ? *After : 0);
+			const int32* NumCalls = CallsPerTag.Find(Tag);
+			if ((NumCalls ? *NumCalls : 0) != (bChanged ? 1 : 0))
+			{
+				UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: %s 加载后被通知 %d 次, 数量%s变化"),
+					*Tag.ToString(), NumCalls ? *NumCalls : 0, bChanged ? TEXT("有") : TEXT("没有"));
+				++NumErrors;
+			}
+		}
+
+		// 5. 损坏的快照加载失败, 且不修改现有数据
+		TArray<TPair<const TCHAR*, TArray<uint8>>> CorruptedData;
+		CorruptedData.Emplace(TEXT("截断"), TArray<uint8>(SourceData.GetData(), SourceData.Num() - 1));
+		CorruptedData.Emplace(TEXT("魔数错误"), SourceData);
+		CorruptedData.Last().Value[0] ^= 0xFF;
+		CorruptedData.Emplace(TEXT("末尾多余数据"), SourceData);
+		CorruptedData.Last().Value.Add(0);
+		CorruptedData.Emplace(TEXT("空数据"), TArray<uint8>());
+		for (const TPair<const TCHAR*, TArray<uint8>>& Pair : CorruptedData)
+		{
+			if (Loaded->LoadRedDotSnapshot(Pair.Value))
+			{
+				UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: %s的快照不应加载成功"), Pair.Key);
+				++NumErrors;
+			}
+			CompareCounts(SourceCounts, CollectCounts(*Loaded), Pair.Key, NumErrors);
+		}
+
+		// 6. 空红点的快照, 加载后清空所有数量
+		UYcRedDotManagerSubsystem* Empty = CreateManager(GameInstance);
+		TArray<uint8> EmptyData;
+		Empty->SaveRedDotSnapshot(EmptyData);
+		if (!Loaded->LoadRedDotSnapshot(EmptyData) || CollectCounts(*Loaded).Num() != 0)
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.TestSnapshot: 加载空快照后仍有红点"));
+			++NumErrors;
+		}
+		Loaded->FlushRedDotChanges();
+
+		DestroyManager(Source);
+		DestroyManager(Loaded);
+		DestroyManager(Empty);
+
+		UE_LOG(LogYcRedDot, Display, TEXT("Yc.RedDot.TestSnapshot: %s (%d 个标签, %d 个非零节点, 快照 %d 字节, 空快照 %d 字节, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), Tags.Num(), SourceCounts.Num(), SourceData.Num(), EmptyData.Num(), NumErrors);
+	}
+
+	static void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		if (!GameInstance)
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.BenchmarkSnapshotLoad: 需要在有 GameInstance 的游戏世界中执行"));
+			return;
+		}
+
+		const int32 NumRequestedTags = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 5000;
+		const int32 NumIterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20;
+
+		// 快照以标签网络索引为键, 只能使用已注册的标签
+		const TArray<FGameplayTag> Tags = CollectTags(NumRequestedTags);
+		if (Tags.Num() == 0)
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.BenchmarkSnapshotLoad: 没有已注册的标签"));
+			return;
+		}
+		if (Tags.Num() < NumRequestedTags)
+		{
+			UE_LOG(LogYcRedDot, Warning, TEXT("Yc.RedDot.BenchmarkSnapshotLoad: 只有 %d 个已注册的标签, 少于请求的 %d 个"), Tags.Num(), NumRequestedTags);
+		}
+
+		int32 NumErrors = 0;
+
+		// 数据源: 每个标签一次 AddRedDotCount
+		UYcRedDotManagerSubsystem* Source = CreateManager(GameInstance);
+		for (int32 i = 0; i < Tags.Num(); ++i)
+		{
+			Source->AddRedDotCount(Tags[i], 1 + i % 3);
+		}
+		Source->FlushRedDotChanges();
+		const TMap<FGameplayTag, int32> SourceCounts = CollectCounts(*Source);
+
+		TArray<uint8> Data;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Source->SaveRedDotSnapshot(Data);
+		}
+		const double SaveMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+		// 改造前登录时的做法: 逐条重放数据源事件
+		double ReplayMs = 0.0;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			UYcRedDotManagerSubsystem* RedDots = CreateManager(GameInstance);
+			StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Tags.Num(); ++i)
+			{
+				RedDots->AddRedDotCount(Tags[i], 1 + i % 3);
+			}
+			RedDots->FlushRedDotChanges();
+			ReplayMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			DestroyManager(RedDots);
+		}
+		ReplayMs /= NumIterations;
+
+		double LoadMs = 0.0;
+		UYcRedDotManagerSubsystem* Loaded = nullptr;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			if (Loaded)
+			{
+				DestroyManager(Loaded);
+			}
+			Loaded = CreateManager(GameInstance);
+			StartTime = FPlatformTime::Seconds();
+			if (!Loaded->LoadRedDotSnapshot(Data))
+			{
+				++NumErrors;
+			}
+			Loaded->FlushRedDotChanges();
+			LoadMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		}
+		LoadMs /= NumIterations;
+		CompareCounts(SourceCounts, CollectCounts(*Loaded), TEXT("加载快照"), NumErrors);
+
+		// 子标签查询: 改造前遍历所有红点 vs 分支表区间
+		TArray<FGameplayTag> QueryTags;
+		Loaded->RedDotStates.GetKeys(QueryTags);
+		QueryTags.SetNum(FMath::Min(QueryTags.Num(), 200));
+
+		StartTime = FPlatformTime::Seconds();
+		int64 NumScanChildren = 0;
+		for (const FGameplayTag& ParentTag : QueryTags)
+		{
+			for (const TPair<FGameplayTag, FRedDotInfo>& Pair : Loaded->RedDotStates)
+			{
+				NumScanChildren += (Pair.Key.MatchesTag(ParentTag) && Pair.Key != ParentTag) ? 1 : 0;
+			}
+		}
+		const double ScanUs = (FPlatformTime::Seconds() - StartTime) * 1e6 / FMath::Max(1, QueryTags.Num());
+
+		Loaded->InvalidateBranchTable();
+		StartTime = FPlatformTime::Seconds();
+		Loaded->RebuildBranchTable();
+		const double RebuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		StartTime = FPlatformTime::Seconds();
+		int64 NumRangeChildren = 0;
+		for (const FGameplayTag& ParentTag : QueryTags)
+		{
+			NumRangeChildren += Loaded->FindAllChildTags(ParentTag).Num();
+		}
+		const double RangeUs = (FPlatformTime::Seconds() - StartTime) * 1e6 / FMath::Max(1, QueryTags.Num());
+		if (NumScanChildren != NumRangeChildren)
+		{
+			UE_LOG(LogYcRedDot, Error, TEXT("Yc.RedDot.BenchmarkSnapshotLoad: 子标签数量不一致 (遍历 %lld, 分支表 %lld)"), NumScanChildren, NumRangeChildren);
+			++NumErrors;
+		}
+
+		const int32 NumNodes = Loaded->RedDotStates.Num();
+		DestroyManager(Source);
+		DestroyManager(Loaded);
+
+		UE_LOG(LogYcRedDot, Display, TEXT("Yc.RedDot.BenchmarkSnapshotLoad: %s (%d 个标签, 聚合后 %d 个节点, 快照 %d 字节, %d 次, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), Tags.Num(), NumNodes, Data.Num(), NumIterations, NumErrors);
+		UE_LOG(LogYcRedDot, Display, TEXT("  恢复: 逐条重放 %.3f ms / 加载快照 %.3f ms, 保存快照 %.3f ms"), ReplayMs, LoadMs, SaveMs);
+		UE_LOG(LogYcRedDot, Display, TEXT("  子标签查询: 遍历 %.2f us / 分支表 %.2f us, 重建分支表 %.3f ms"), ScanUs, RangeUs, RebuildMs);
+	}
+};
+
+namespace YcRedDotSnapshotTest
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdTestSnapshot(
+		TEXT("Yc.RedDot.TestSnapshot"),
+		TEXT("红点快照保存/加载的往返测试：Yc.RedDot.TestSnapshot"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcRedDotSnapshotTest::RunTest));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkSnapshotLoad(
+		TEXT("Yc.RedDot.BenchmarkSnapshotLoad"),
+		TEXT("对比逐条重放与加载快照恢复红点的耗时：Yc.RedDot.BenchmarkSnapshotLoad [标签数量=5000] [次数=20]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcRedDotSnapshotTest::RunBenchmark));
+}
@@ -5,6 +5,7 @@
 #include "GameplayTagContainer.h"
 #include "YcRedDotTypes.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
 #include "YcRedDotManagerSubsystem.generated.h"
 
 class UYcRedDotConditionBase;
@@ -91,9 +92,14 @@ private:
 
 /**
  * 红点系统管理子系统, 提供红点系统的交互函数
+ *
+ * 红点数量的修改不会立即向上穿透和通知监听者, 而是记录到脏节点集合中, 每帧 Tick 时统一处理:
+ * 先由深到浅逐层把差量累加到父节点, 再按同样的顺序通知监听者, 每个受影响的节点每帧最多通知一次
+ * 查询接口会先结算未处理的数量差量, 保证读到的数量始终是最新的
+ * 可通过 Yc.RedDot.DeferPropagation=0 恢复为每次修改立即穿透并通知
  */
 UCLASS(BlueprintType, meta = (DisplayName = "Yc Red Dot Manager"))
-class YICHENREDDOTSYSTEM_API UYcRedDotManagerSubsystem : public UGameInstanceSubsystem
+class YICHENREDDOTSYSTEM_API UYcRedDotManagerSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 public:
@@ -118,6 +124,15 @@ public:
 	virtual void Deinitialize() override;
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 	//~ End USubsystem Interface
+
+	//~ Begin FTickableObjectBase Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	//~ End FTickableObjectBase Interface
 	
 	/**
 	 * 注册红点标签，初始化其状态数据
@@ -134,10 +149,18 @@ public:
 	 * @param Count 变化量。正数表示增加，负数表示减少。默认为 0
 	 * @note 如果红点数量为 0 且 Count <= 0，则不会触发任何更新
 	 * @note 红点数量不会低于 0，会被自动限制在 [0, +∞) 范围内
-	 * @note 该函数会自动计算 Delta（变化量）并触发 BroadcastRedDotChangedForward，实现数据穿透
+	 * @note 目标节点的数量立即更新, 向父节点的穿透和监听者通知合并到当帧的 FlushRedDotChanges() 中统一处理
 	 */
 	UFUNCTION(BlueprintCallable, Category = "RedDot|Management")
 	void AddRedDotCount(FGameplayTag RedDotTag, int32 Count = 0);
+
+	/**
+	 * 立即处理所有待处理的红点变化: 由深到浅结算父节点数量, 再通知受影响节点的监听者
+	 * @note 每帧 Tick 时会自动调用, 只有需要在同一帧内立即刷新界面时才需要手动调用
+	 * @note 在监听者回调中产生的新变化会在同一次调用中继续处理
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RedDot|Management")
+	void FlushRedDotChanges();
 	
 	/**
 	 * 获取指定红点标签的信息
@@ -179,9 +202,30 @@ public:
 	 *   2. 调用 BroadcastRedDotCleared(ParentTag) 通知红点标签所有提供者
 	 *   3. 将所有子标签的 Count 设置为 0，并调用 BroadcastRedDotCleared 通知相关的提供者让它们清除红点数据状态
 	 * @note 仅会处理已注册在 RedDotStates 中的标签
+	 * @note 子标签通过分支表中的连续区间获取, 不需要遍历所有红点
 	 */
 	UFUNCTION(BlueprintCallable, Category = "RedDot|Batch")
 	void ClearRedDotStateInBranch(const FGameplayTag& ParentTag);
+
+	/**
+	 * 把所有红点数量保存为紧凑的二进制快照, 用于存档或登录时快速恢复
+	 * @param OutData 输出的快照数据
+	 * @return 保存成功返回 true
+	 * @note 只保存每个节点自身（不含子节点聚合部分）不为 0 的数量, 以标签网络索引排序后差分编码
+	 * @note 快照中记录了标签表的哈希, 标签表变化后旧快照无法加载, 需要重新由数据源构建红点
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RedDot|Persistence")
+	bool SaveRedDotSnapshot(TArray<uint8>& OutData);
+
+	/**
+	 * 从快照恢复所有红点数量, 替换当前的红点数据
+	 * @param Data SaveRedDotSnapshot() 保存的快照数据
+	 * @return 加载成功返回 true; 数据损坏或标签表已变化时返回 false, 此时当前红点数据不会被修改
+	 * @note 父节点数量按深度由深到浅一次性聚合, 过程中不逐个节点广播
+	 * @note 加载完成后只有注册了监听者的节点会收到一次通知（在下一次 FlushRedDotChanges() 时）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RedDot|Persistence")
+	bool LoadRedDotSnapshot(const TArray<uint8>& Data);
 	
 	/**
 	 * 注册红点状态变化监听者
@@ -190,7 +234,7 @@ public:
 	 * @param MatchType 标签匹配规则。ExactMatch 仅接收该标签的变化；PartialMatch 接收该标签及其子标签的变化
 	 * @param bUnregisterOnWorldDestroyed 世界销毁时是否自动注销该监听
 	 * @return 监听 Handle，用于后续注销监听。调用 Handle.Unregister() 可手动注销
-	 * @note 回调函数会在 BroadcastRedDotChangedForward 中被调用
+	 * @note 回调函数会在 FlushRedDotChanges 中被调用, 同一节点每帧最多回调一次, 参数中的 Delta 为该节点本帧累计的变化量
 	 * @note 如果 MatchType 为 PartialMatch，当父标签变化时，子标签的监听者也会收到通知
 	 */
 	FYcRedDotStateChangedListenerHandle RegisterRedDotStateChangedListener(
@@ -212,32 +256,46 @@ protected:
 	/** 获取或创建红点信息 */
 	FRedDotInfo& GetOrCreateRedDotInfo(const FGameplayTag& RedDotTag);
 	
-	/** 更新红点状态（内部使用） */
+	/** 更新红点状态（内部使用）, 将该节点标记为脏节点, 其 Delta 在下次结算时向上穿透 */
 	void UpdateRedDotState(const FGameplayTag& RedDotTag, const FRedDotInfo& NewInfo);
+
+	/**
+	 * 将红点节点标记为脏节点, 等待下次 FlushRedDotChanges() 时通知监听者
+	 * @param RedDotTag 发生变化的红点标签
+	 * @param Delta 该节点自身数量的变化量, 结算时累加到所有父节点
+	 * @param bPropagate 是否需要把 Delta 穿透到父节点, 清理子节点时不需要
+	 */
+	void MarkRedDotDirty(const FGameplayTag& RedDotTag, int32 Delta, bool bPropagate = true);
+
+	/**
+	 * 结算所有脏节点尚未穿透的差量: 按标签深度由深到浅逐层累加到父节点, 每个节点只处理一次
+	 * @note 只更新数量不通知监听者, 查询接口在读取前会先调用该函数
+	 */
+	void ResolvePendingRedDotCounts();
+
+	/** 获取当前帧的红点更新时间, 每帧只读取一次系统时间 */
+	const FDateTime& GetFrameTriggerTime();
 	
 	/**
 	 * 查找指定父标签下的所有子标签
 	 * @param ParentTag 父标签
 	 * @return 该父标签下的所有子标签数组
-	 * @note 使用 TagHierarchyCache 进行缓存以加速查询
-	 * @note 当新标签被注册时，会自动清理相关的缓存条目
+	 * @note 已注册的父标签直接复制分支表中的连续区间, 未注册的父标签才会遍历 RedDotStates
+	 * @note 分支表过期时会先重建
 	 */
 	TArray<FGameplayTag> FindAllChildTags(const FGameplayTag& ParentTag) const;
 	
 	/**
-	 * 清理指定标签的所有相关缓存
-	 * 当新标签被注册时调用，清理所有可能受影响的父标签缓存
-	 * @param NewTag 新注册的标签
-	 * @note 该函数会遍历 TagHierarchyCache，移除所有包含 NewTag 作为子标签的缓存条目
-	 * @note 例如：注册 A.B.C.D.E 时，会清理 A、A.B、A.B.C、A.B.C.D 的缓存
+	 * 标记分支表过期, 当新标签被注册时调用
+	 * @note 只设置标记, 在下次查询子标签时统一重建, 批量注册标签（例如加载快照）时不会重复重建
 	 */
-	void InvalidateTagHierarchyCache(const FGameplayTag& NewTag);
-	
-	/** 向前(向上)穿透广播红点变化事件, 可以实现正确的红点数据穿透更新  */
-	void BroadcastRedDotChangedForward(FGameplayTag RedDotTag, const FRedDotInfo* RedDotInfo);
-	
-	/** 单一节点广播红点变化事件, 用于清理子节点红点数据 */
-	void BroadcastRedDotChangedSingle(FGameplayTag RedDotTag, const FRedDotInfo* RedDotInfo);
+	void InvalidateBranchTable();
+
+	/**
+	 * 重建分支表: 把所有已注册的标签按层级顺序排列, 使每个标签的所有子标签紧跟在它后面
+	 * 并记录每个标签子树结束的位置
+	 */
+	void RebuildBranchTable();
 	
 	/** 清理目标红点, 内部调用所有相关提供者的清理事件回调函数, 以实现通知提供者清理数据 */
 	void BroadcastRedDotCleared(FGameplayTag RedDotTag);
@@ -260,15 +318,71 @@ private:
 	UPROPERTY()
 	TMap<FGameplayTag, FRedDotInfo> RedDotStates;
     
+	/** 分支表条目 */
+	struct FYcRedDotBranchEntry
+	{
+		FGameplayTag Tag;
+
+		/** 该标签子树结束的位置（不包含）, 子标签为 [自身位置 + 1, End) 区间 */
+		int32 End = 0;
+	};
+
 	/**
-	 * 标签层级关系缓存，用于加速子标签查询
-	 * Key: 父标签
-	 * Value: 该父标签下的所有子标签数组
+	 * 分支表, 用于把子标签查询变成连续区间的访问
+	 * 所有已注册标签按层级顺序排列, 例如 A, A.B, A.B.C, A.D, E
 	 * @note 在 FindAllChildTags() 中使用，避免重复遍历 RedDotStates
-	 * @note 当新标签被注册时，InvalidateTagHierarchyCache() 会自动清理所有相关的缓存条目
-	 * @note 缓存失效机制确保了动态注册的新标签不会被遗漏
+	 * @note 当新标签被注册时，InvalidateBranchTable() 将其标记为过期, 下次使用时重建
+	 */
+	TArray<FYcRedDotBranchEntry> BranchTable;
+
+	/** 标签在 BranchTable 中的位置 */
+	TMap<FGameplayTag, int32> BranchIndices;
+
+	/** 分支表是否需要重建 */
+	bool bBranchTableDirty = true;
+
+	/** 本帧发生变化、等待结算和通知的红点节点 */
+	struct FYcRedDotDirtyNode
+	{
+		/** 还未穿透到父节点的差量 */
+		int32 PendingDelta = 0;
+
+		/** 本帧累计的差量, 通知时写入 FRedDotInfo::Delta */
+		int32 FrameDelta = 0;
+
+		/** 标签深度（A 为 1, A.B 为 2）, 结算和通知都按深度由深到浅进行 */
+		int32 Depth = 0;
+
+		/** 最近一次导致该节点变化的标签, 作为 PartialMatch 监听者回调的标签参数 */
+		FGameplayTag ChangedTag;
+
+		/** 该节点自身是否被直接修改, 只有直接修改才会通知 ExactMatch 监听者 */
+		bool bDirectChange = false;
+
+		/** 是否已加入本次结算的深度分组, 避免重复处理 */
+		bool bQueuedForResolve = false;
+	};
+
+	/** 获取或创建脏节点数据 */
+	FYcRedDotDirtyNode& FindOrAddDirtyNode(const FGameplayTag& RedDotTag, int32 Depth = 0);
+
+	/**
+	 * 脏节点集合
+	 * Key: 红点标签
+	 * Value: 该节点本帧的变化数据
+	 * @note 由 AddRedDotCount() 和 ClearRedDotStateInBranch() 写入, 在 FlushRedDotChanges() 中处理并清空
 	 */
-	TMap<FGameplayTag, TArray<FGameplayTag>> TagHierarchyCache;
+	TMap<FGameplayTag, FYcRedDotDirtyNode> DirtyNodes;
+
+	/** 是否存在尚未穿透到父节点的差量 */
+	bool bHasUnresolvedCounts = false;
+
+	/** 是否正在 FlushRedDotChanges() 中, 回调中产生的变化由外层继续处理 */
+	bool bFlushingRedDotChanges = false;
+
+	/** 当前帧缓存的更新时间, 见 GetFrameTriggerTime() */
+	FDateTime CachedTriggerTime;
+	uint64 CachedTriggerTimeFrame = MAX_uint64;
 	
 	/**
 	 * 红点监听者和数据提供者包装
@@ -292,11 +406,13 @@ private:
 	 * Key: 红点标签
 	 * Value: 该标签的监听者和提供者列表（FYcRedDotListenerList）
 	 * @note 通过 RegisterRedDotStateChangedListener() 和 RegisterRedDotDataProvider() 进行修改
-	 * @note 在 BroadcastRedDotChangedForward()、BroadcastRedDotChangedSingle() 和 BroadcastRedDotCleared() 中查询
+	 * @note 在 FlushRedDotChanges() 和 BroadcastRedDotCleared() 中查询
 	 * @note 当监听者或提供者列表为空时，会从 ListenerMap 中移除该标签条目
 	 */
 	TMap<FGameplayTag, FYcRedDotListenerList> ListenerMap;
 	
 	friend FYcRedDotStateChangedListenerHandle;
 	friend FYcRedDotDataProviderHandle;
+	friend struct FYcRedDotBenchmark;
+	friend struct FYcRedDotSnapshotTest;
 };
@@ -0,0 +1,26 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "AbilitySystem/Tasks/YcAbilityTask_WaitTick.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcAbilityTask_WaitTick)
+
+UYcAbilityTask_WaitTick::UYcAbilityTask_WaitTick(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bTickingTask = true;
+}
+
+UYcAbilityTask_WaitTick* UYcAbilityTask_WaitTick::WaitTick(UGameplayAbility* OwningAbility, FName TaskInstanceName)
+{
+	return NewAbilityTask<UYcAbilityTask_WaitTick>(OwningAbility, TaskInstanceName);
+}
+
+void UYcAbilityTask_WaitTick::TickTask(float DeltaTime)
+{
+	Super::TickTask(DeltaTime);
+
+	if (ShouldBroadcastAbilityTaskDelegates())
+	{
+		OnTick.Broadcast(DeltaTime);
+	}
+}
@@ -4,11 +4,124 @@
 #include "Weapons/Attachments/YcWeaponAttachmentComponent.h"
 #include "Weapons/YcWeaponActor.h"
 #include "DataRegistrySubsystem.h"
+#include "Algo/StableSort.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcAttachmentTypes)
 
 DEFINE_LOG_CATEGORY(LogYcAttachment);
 
+// ═══════════════════════════════════════════════════════════════
+// FYcStatModifierIndex 方法实现
+// ═══════════════════════════════════════════════════════════════
+
+void FYcStatModifierIndex::Reset()
+{
+	PendingEntries.Reset();
+	Modifiers.Reset();
+	Spans.Reset();
+}
+
+void FYcStatModifierIndex::Add(const FYcStatModifier& Modifier)
+{
+	if (!Modifier.StatTag.IsValid())
+	{
+		return;
+	}
+
+	// 查询父Tag时也需要命中子Tag的修改器，因此在整条Tag链上都登记一次
+	const FGameplayTagContainer TagChain = Modifier.StatTag.GetGameplayTagParents();
+	for (const FGameplayTag& Tag : TagChain)
+	{
+		PendingEntries.Emplace(Tag, Modifier);
+	}
+}
+
+void FYcStatModifierIndex::Finalize()
+{
+	Modifiers.Reset();
+	Spans.Reset();
+
+	// 计数排序：先统计每个属性的修改器数量，再计算分段起点
+	for (const TPair<FGameplayTag, FYcStatModifier>& Entry : PendingEntries)
+	{
+		++Spans.FindOrAdd(Entry.Key).Num;
+	}
+
+	int32 Offset = 0;
+	for (TPair<FGameplayTag, FSpan>& Pair : Spans)
+	{
+		Pair.Value.Start = Offset;
+		Offset += Pair.Value.Num;
+		Pair.Value.Num = 0;
+	}
+
+	// 按添加顺序写入各自的分段
+	Modifiers.SetNum(Offset);
+	for (const TPair<FGameplayTag, FYcStatModifier>& Entry : PendingEntries)
+	{
+		FSpan& Span = Spans.FindChecked(Entry.Key);
+		Modifiers[Span.Start + Span.Num++] = Entry.Value;
+	}
+
+	// 段内按优先级稳定排序，同优先级保持配件顺序
+	for (const TPair<FGameplayTag, FSpan>& Pair : Spans)
+	{
+		Algo::StableSortBy(MakeArrayView(Modifiers.GetData() + Pair.Value.Start, Pair.Value.Num), &FYcStatModifier::Priority);
+	}
+
+	PendingEntries.Reset();
+}
+
+TConstArrayView<FYcStatModifier> FYcStatModifierIndex::Find(const FGameplayTag& StatTag) const
+{
+	if (const FSpan* Span = Spans.Find(StatTag))
+	{
+		return MakeArrayView(Modifiers.GetData() + Span->Start, Span->Num);
+	}
+	return TConstArrayView<FYcStatModifier>();
+}
+
+float FYcStatModifierIndex::Evaluate(TConstArrayView<FYcStatModifier> InModifiers, float BaseValue)
+{
+	if (InModifiers.Num() == 0)
+	{
+		return BaseValue;
+	}
+	
+	float AddSum = 0.0f;
+	float MultiplySum = 0.0f;
+	bool bHasOverride = false;
+	float OverrideValue = 0.0f;
+	
+	// 分类收集修改器
+	for (const FYcStatModifier& Modifier : InModifiers)
+	{
+		switch (Modifier.Operation)
+		{
+		case EYcStatModifierOp::Override:
+			// Override取最后一个
+			bHasOverride = true;
+			OverrideValue = Modifier.Value;
+			break;
+			
+		case EYcStatModifierOp::Add:
+			AddSum += Modifier.Value;
+			break;
+			
+		case EYcStatModifierOp::Multiply:
+			MultiplySum += Modifier.Value;
+			break;
+		}
+	}
+	
+	// Override直接覆盖基础值，否则先加法，后乘法
+	if (bHasOverride)
+	{
+		return OverrideValue;
+	}
+	return (BaseValue + AddSum) * (1.0f + MultiplySum);
+}
+
 // ═══════════════════════════════════════════════════════════════
 // FYcAttachmentInstance 方法实现
 // ═══════════════════════════════════════════════════════════════
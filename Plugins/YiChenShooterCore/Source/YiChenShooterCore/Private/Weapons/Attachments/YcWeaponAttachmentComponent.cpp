@@ -13,6 +13,13 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcWeaponAttachmentComponent)
 
+DECLARE_STATS_GROUP(TEXT("YcAttachment"), STATGROUP_YcAttachment, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RebuildModifierIndex"), STAT_YcAttachment_RebuildModifierIndex, STATGROUP_YcAttachment);
+DECLARE_DWORD_COUNTER_STAT(TEXT("IndexedModifiers"), STAT_YcAttachment_IndexedModifiers, STATGROUP_YcAttachment);
+
+/** 配件定义未解析时重试重建修改器索引的间隔（秒） */
+static constexpr float YcModifierIndexRetryInterval = 0.5f;
+
 UYcWeaponAttachmentComponent::UYcWeaponAttachmentComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -262,22 +269,57 @@ TArray<FGameplayTag> UYcWeaponAttachmentComponent::GetInstalledAttachmentIds() c
 
 TArray<FYcStatModifier> UYcWeaponAttachmentComponent::GetModifiersForStat(FGameplayTag StatTag) const
 {
-	TArray<FYcStatModifier> Result;
+	const TConstArrayView<FYcStatModifier> Modifiers = ModifierIndex.Find(StatTag);
+	return TArray<FYcStatModifier>(Modifiers.GetData(), Modifiers.Num());
+}
+
+TConstArrayView<FYcStatModifier> UYcWeaponAttachmentComponent::FindModifiersForStat(FGameplayTag StatTag) const
+{
+	return ModifierIndex.Find(StatTag);
+}
+
+float UYcWeaponAttachmentComponent::CalculateFinalStatValue(FGameplayTag StatTag, float BaseValue) const
+{
+	return FYcStatModifierIndex::Evaluate(ModifierIndex.Find(StatTag), BaseValue);
+}
+
+TMap<FGameplayTag, float> UYcWeaponAttachmentComponent::CalculateFinalStatValues(
+	const TMap<FGameplayTag, float>& StatBaseValues) const
+{
+	TMap<FGameplayTag, float> Result;
+	Result.Reserve(StatBaseValues.Num());
+	
+	for (const auto& Pair : StatBaseValues)
+	{
+		Result.Add(Pair.Key, CalculateFinalStatValue(Pair.Key, Pair.Value));
+	}
+	
+	return Result;
+}
+
+void UYcWeaponAttachmentComponent::RebuildModifierIndex()
+{
+	SCOPE_CYCLE_COUNTER(STAT_YcAttachment_RebuildModifierIndex);
+
+	ModifierIndex.Reset();
+	bModifierIndexDirty = false;
 	
 	for (const FYcAttachmentInstance& Instance : AttachmentArray.Items)
 	{
 		if (!Instance.IsValid()) continue;
 		
 		const FYcAttachmentDefinition* Def = Instance.GetDefinition();
-		if (!Def) continue;
+		if (!Def)
+		{
+			// 定义尚未解析（如客户端收到复制时 DataRegistry 还未缓存），索引缺少该配件的修改器
+			bModifierIndexDirty = true;
+			continue;
+		}
 		
 		// 收集配件的修改器
 		for (const FYcStatModifier& Modifier : Def->StatModifiers)
 		{
-			if (Modifier.StatTag.MatchesTag(StatTag))
-			{
-				Result.Add(Modifier);
-			}
+			ModifierIndex.Add(Modifier);
 		}
 		
 		// 收集调校修改器
@@ -285,93 +327,40 @@ TArray<FYcStatModifier> UYcWeaponAttachmentComponent::GetModifiersForStat(FGamep
 		{
 			for (const FYcAttachmentTuningParam& Param : Def->TuningParams)
 			{
-				if (!Param.StatTag.MatchesTag(StatTag)) continue;
 				const float* TuningValue = Instance.TuningValues.Find(Param.StatTag);
 				if (!TuningValue || FMath::IsNearlyZero(*TuningValue)) continue;
 				
-				FYcStatModifier TuningModifier;
-				TuningModifier.StatTag = Param.StatTag;
-				TuningModifier.Operation = Param.Operation;
-				TuningModifier.Value = *TuningValue;
-				TuningModifier.Priority = 100; // 调校修改器优先级较低，最后应用
-				Result.Add(TuningModifier);
+				// 调校修改器优先级较低，最后应用
+				ModifierIndex.Add(FYcStatModifier(Param.StatTag, Param.Operation, *TuningValue, 100));
 			}
 		}
 	}
 	
-	// 按优先级排序
-	Result.Sort([](const FYcStatModifier& A, const FYcStatModifier& B)
-	{
-		return A.Priority < B.Priority;
-	});
-	
-	return Result;
+	ModifierIndex.Finalize();
+	SET_DWORD_STAT(STAT_YcAttachment_IndexedModifiers, ModifierIndex.Num());
 }
 
-
-float UYcWeaponAttachmentComponent::CalculateFinalStatValue(FGameplayTag StatTag, float BaseValue) const
+void UYcWeaponAttachmentComponent::RetryDirtyModifierIndex()
 {
-	const TArray<FYcStatModifier> Modifiers = GetModifiersForStat(StatTag);
-	
-	if (Modifiers.Num() == 0)
+	if (bModifierIndexDirty)
 	{
-		return BaseValue;
-	}
-	
-	float FinalValue = BaseValue;
-	float AddSum = 0.0f;
-	float MultiplySum = 0.0f;
-	bool bHasOverride = false;
-	float OverrideValue = 0.0f;
-	
-	// 分类收集修改器
-	for (const FYcStatModifier& Modifier : Modifiers)
-	{
-		switch (Modifier.Operation)
+		for (const FYcAttachmentInstance& Instance : AttachmentArray.Items)
 		{
-		case EYcStatModifierOp::Override:
-			// Override取最后一个
-			bHasOverride = true;
-			OverrideValue = Modifier.Value;
-			break;
-			
-		case EYcStatModifierOp::Add:
-			AddSum += Modifier.Value;
-			break;
-			
-		case EYcStatModifierOp::Multiply:
-			MultiplySum += Modifier.Value;
-			break;
+			if (Instance.IsValid() && !Instance.GetDefinition())
+			{
+				// 仍有定义未解析，等待下次重试
+				return;
+			}
 		}
 	}
 	
-	// 应用修改器
-	if (bHasOverride)
-	{
-		// Override直接覆盖基础值
-		FinalValue = OverrideValue;
-	}
-	else
-	{
-		// 先加法，后乘法
-		FinalValue = BaseValue + AddSum;
-		FinalValue = FinalValue * (1.0f + MultiplySum);
-	}
-	
-	return FinalValue;
-}
-
-TMap<FGameplayTag, float> UYcWeaponAttachmentComponent::CalculateFinalStatValues(
-	const TMap<FGameplayTag, float>& StatBaseValues) const
-{
-	TMap<FGameplayTag, float> Result;
+	GetWorld()->GetTimerManager().ClearTimer(ModifierIndexRetryTimer);
 	
-	for (const auto& Pair : StatBaseValues)
+	// 期间没有其他变化重建过索引时，用已解析的定义重建并通知武器实例
+	if (bModifierIndexDirty)
 	{
-		Result.Add(Pair.Key, CalculateFinalStatValue(Pair.Key, Pair.Value));
+		NotifyStatsChanged();
 	}
-	
-	return Result;
 }
 
 bool UYcWeaponAttachmentComponent::SetTuningValue(FGameplayTag SlotType, FGameplayTag StatTag, float Value)
@@ -442,6 +431,20 @@ int32 UYcWeaponAttachmentComponent::FindSlotIndex(FGameplayTag SlotType) const
 
 void UYcWeaponAttachmentComponent::NotifyStatsChanged()
 {
+	// 所有配件安装/卸载/调校变化（含 Fast Array 复制回调）都经过这里，先重建修改器索引
+	RebuildModifierIndex();
+	
+	// 有配件定义未解析时定时重试，避免缓存缺少修改器的索引后不再刷新
+	const UWorld* World = GetWorld();
+	if (bModifierIndexDirty && World)
+	{
+		FTimerManager& TimerManager = World->GetTimerManager();
+		if (!TimerManager.IsTimerActive(ModifierIndexRetryTimer))
+		{
+			TimerManager.SetTimer(ModifierIndexRetryTimer, this, &ThisClass::RetryDirtyModifierIndex, YcModifierIndexRetryInterval, true);
+		}
+	}
+	
 	// 通知武器实例重算属性（WeaponInstance 负责广播属性变化消息）
 	if (UYcHitScanWeaponInstance* Weapon = WeaponInstance.Get())
 	{
@@ -2,6 +2,8 @@
 
 #include "Weapons/Fragments/YcFragment_WeaponStats.h"
 
+#include "YiChenShooterCore.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcFragment_WeaponStats)
 
 FYcFragment_WeaponStats::FYcFragment_WeaponStats()
@@ -60,3 +62,88 @@ FYcFragment_WeaponStats::FYcFragment_WeaponStats()
 	, ADSMoveSpeedMultiplier(0.8f)
 {
 }
+
+// ==================== 查找表 ====================
+
+void FYcWeaponStatsLookupTables::BakeDamageFalloff(const FRichCurve* Curve)
+{
+	DamageFalloff.Reset();
+	MaxFalloffError = 0.0f;
+
+	if (Curve == nullptr || Curve->IsEmpty())
+	{
+		return;
+	}
+
+	DamageFalloff.SetNumUninitialized(FalloffResolution + 1);
+	for (int32 Index = 0; Index <= FalloffResolution; ++Index)
+	{
+		DamageFalloff[Index] = FMath::Clamp(Curve->Eval(static_cast<float>(Index) / FalloffResolution), 0.0f, 1.0f);
+	}
+
+	// 精度校验：在每段的中点对比插值结果与曲线原值
+	for (int32 Index = 0; Index < FalloffResolution; ++Index)
+	{
+		const float DistancePercent = (Index + 0.5f) / FalloffResolution;
+		const float Expected = FMath::Clamp(Curve->Eval(DistancePercent), 0.0f, 1.0f);
+		MaxFalloffError = FMath::Max(MaxFalloffError, FMath::Abs(EvaluateDamageFalloff(DistancePercent) - Expected));
+	}
+}
+
+void FYcWeaponStatsLookupTables::BakeRecoilPattern(TConstArrayView<FYcRecoilPatternPoint> Pattern, int32 LoopStart)
+{
+	RecoilPitch.Reset(Pattern.Num());
+	RecoilYaw.Reset(Pattern.Num());
+	for (const FYcRecoilPatternPoint& Point : Pattern)
+	{
+		RecoilPitch.Add(Point.Pitch);
+		RecoilYaw.Add(Point.Yaw);
+	}
+
+	// 超出轨迹长度后从 LoopStart 开始循环
+	RecoilLoopStart = Pattern.Num() > 0 ? FMath::Clamp(LoopStart, 0, Pattern.Num() - 1) : 0;
+	RecoilLoopLength = FMath::Max(1, Pattern.Num() - RecoilLoopStart);
+}
+
+void FYcWeaponStatsLookupTables::BakeHitZoneStatTags(const TMap<FGameplayTag, float>& HitZoneMultipliers)
+{
+	HitZoneStatTags.Reset(HitZoneMultipliers.Num());
+	for (const auto& Pair : HitZoneMultipliers)
+	{
+		// 例如：Gameplay.Character.Zone.Head -> Weapon.Stat.Damage.Zone.Head
+		const FString StatTagString = Pair.Key.ToString().Replace(TEXT("Gameplay.Character.Zone"), TEXT("Weapon.Stat.Damage.Zone"));
+		const FGameplayTag StatTag = FGameplayTag::RequestGameplayTag(FName(*StatTagString), false);
+		if (StatTag.IsValid())
+		{
+			HitZoneStatTags.Emplace(Pair.Key, StatTag);
+		}
+	}
+}
+
+const FYcWeaponStatsLookupTables& FYcFragment_WeaponStats::GetLookupTables() const
+{
+	if (!LookupTables.bBaked)
+	{
+		BakeLookupTables();
+	}
+	return LookupTables;
+}
+
+void FYcFragment_WeaponStats::BakeLookupTables() const
+{
+	LookupTables.BakeDamageFalloff(DamageFalloffCurve.GetRichCurveConst());
+	LookupTables.BakeRecoilPattern(bUseRecoilPattern ? TConstArrayView<FYcRecoilPatternPoint>(RecoilPattern) : TConstArrayView<FYcRecoilPatternPoint>(), RecoilPatternLoopStart);
+	LookupTables.BakeHitZoneStatTags(HitZoneDamageMultipliers);
+	LookupTables.bBaked = true;
+
+	UE_CLOG(LookupTables.MaxFalloffError > FYcWeaponStatsLookupTables::FalloffErrorTolerance, LogYcShooterCore, Warning,
+		TEXT("武器伤害衰减曲线变化过于剧烈，查找表插值误差 %.4f 超过 %.4f"), LookupTables.MaxFalloffError, FYcWeaponStatsLookupTables::FalloffErrorTolerance);
+}
+
+void FYcFragment_WeaponStats::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		BakeLookupTables();
+	}
+}
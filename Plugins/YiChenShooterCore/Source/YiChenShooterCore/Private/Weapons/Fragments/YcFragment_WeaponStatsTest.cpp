@@ -0,0 +1,166 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Weapons/Fragments/YcFragment_WeaponStats.h"
+#include "YiChenShooterCore.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * 武器数值查找表精度测试（控制台命令）
+ *
+ * 用几条典型的衰减曲线和弹道轨迹配置 FYcFragment_WeaponStats 并烘焙查找表：
+ * - 伤害衰减：在 0-1 上均匀密集采样，对比 EvaluateDamageFalloff 与 DamageFalloffCurve 原值（限制在 0-1），
+ *   最大误差不能超过容差（默认 FYcWeaponStatsLookupTables::FalloffErrorTolerance）
+ * - 弹道轨迹：对比 GetRecoilPatternPoint 与直接按 RecoilPattern / RecoilPatternLoopStart 循环取值的结果，
+ *   覆盖多轮循环、越界的循环起始索引和未启用弹道轨迹的情况，必须完全一致
+ */
+struct FYcWeaponStatsLookupTest
+{
+	struct FCurveKey
+	{
+		float Time;
+		float Value;
+		ERichCurveInterpMode InterpMode;
+	};
+
+	/** 按原先的逐次求值方式计算衰减倍率 */
+	static float ReferenceDamageFalloff(const FYcFragment_WeaponStats& Stats, float DistancePercent)
+	{
+		const FRichCurve* Curve = Stats.DamageFalloffCurve.GetRichCurveConst();
+		if (Curve->IsEmpty())
+		{
+			return 1.0f;
+		}
+		return FMath::Clamp(Curve->Eval(FMath::Clamp(DistancePercent, 0.0f, 1.0f)), 0.0f, 1.0f);
+	}
+
+	/** 按原先直接读取 RecoilPattern 的方式计算弹道轨迹点 */
+	static FYcRecoilPatternPoint ReferenceRecoilPoint(const FYcFragment_WeaponStats& Stats, int32 ShotIndex)
+	{
+		const TArray<FYcRecoilPatternPoint>& Pattern = Stats.RecoilPattern;
+		if (!Stats.bUseRecoilPattern || Pattern.Num() == 0)
+		{
+			return FYcRecoilPatternPoint();
+		}
+		if (ShotIndex < Pattern.Num())
+		{
+			return Pattern[ShotIndex];
+		}
+
+		const int32 LoopStart = FMath::Clamp(Stats.RecoilPatternLoopStart, 0, Pattern.Num() - 1);
+		const int32 LoopLength = Pattern.Num() - LoopStart;
+		return Pattern[LoopStart + (ShotIndex - Pattern.Num()) % LoopLength];
+	}
+
+	/** 返回最大误差 */
+	static float TestFalloffCurve(TConstArrayView<FCurveKey> Keys, int32 NumSamples)
+	{
+		FYcFragment_WeaponStats Stats;
+		FRichCurve* Curve = Stats.DamageFalloffCurve.GetRichCurve();
+		for (const FCurveKey& Key : Keys)
+		{
+			Curve->SetKeyInterpMode(Curve->AddKey(Key.Time, Key.Value), Key.InterpMode);
+		}
+		Curve->AutoSetTangents();
+		Stats.BakeLookupTables();
+
+		const FYcWeaponStatsLookupTables& Tables = Stats.GetLookupTables();
+		float MaxError = 0.0f;
+		for (int32 Sample = 0; Sample <= NumSamples; ++Sample)
+		{
+			const float DistancePercent = static_cast<float>(Sample) / NumSamples;
+			MaxError = FMath::Max(MaxError, FMath::Abs(Tables.EvaluateDamageFalloff(DistancePercent) - ReferenceDamageFalloff(Stats, DistancePercent)));
+		}
+		return MaxError;
+	}
+
+	/** 返回不一致的射击次数 */
+	static int32 TestRecoilPattern(int32 NumPoints, int32 LoopStart, bool bUseRecoilPattern)
+	{
+		FYcFragment_WeaponStats Stats;
+		Stats.bUseRecoilPattern = bUseRecoilPattern;
+		Stats.RecoilPatternLoopStart = LoopStart;
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			Stats.RecoilPattern.Emplace(0.3f + Index * 0.05f, FMath::Sin(Index * 0.7f) * 0.2f);
+		}
+		Stats.BakeLookupTables();
+
+		const FYcWeaponStatsLookupTables& Tables = Stats.GetLookupTables();
+		int32 NumMismatches = 0;
+		for (int32 ShotIndex = 0; ShotIndex < FMath::Max(1, NumPoints) * 4; ++ShotIndex)
+		{
+			const FYcRecoilPatternPoint Expected = ReferenceRecoilPoint(Stats, ShotIndex);
+			const FYcRecoilPatternPoint Actual = Tables.GetRecoilPatternPoint(ShotIndex);
+			NumMismatches += (Actual.Pitch != Expected.Pitch || Actual.Yaw != Expected.Yaw) ? 1 : 0;
+		}
+		return NumMismatches;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumSamples = Args.Num() > 0 ? FMath::Max(FYcWeaponStatsLookupTables::FalloffResolution, FCString::Atoi(*Args[0])) : 100000;
+		const float Tolerance = Args.Num() > 1 ? FMath::Max(0.0f, FCString::Atof(*Args[1])) : FYcWeaponStatsLookupTables::FalloffErrorTolerance;
+
+		struct FCurveCase
+		{
+			const TCHAR* Name;
+			TArray<FCurveKey> Keys;
+		};
+		const FCurveCase CurveCases[] = {
+			{ TEXT("无衰减"), {} },
+			{ TEXT("线性"), { { 0.0f, 1.0f, RCIM_Linear }, { 1.0f, 0.3f, RCIM_Linear } } },
+			{ TEXT("步枪"), { { 0.0f, 1.0f, RCIM_Cubic }, { 0.3f, 1.0f, RCIM_Cubic }, { 0.6f, 0.7f, RCIM_Cubic }, { 1.0f, 0.5f, RCIM_Cubic } } },
+			{ TEXT("霰弹枪"), { { 0.0f, 1.0f, RCIM_Cubic }, { 0.1f, 0.8f, RCIM_Cubic }, { 0.25f, 0.3f, RCIM_Cubic }, { 1.0f, 0.1f, RCIM_Cubic } } },
+			{ TEXT("超出0-1"), { { 0.0f, 1.2f, RCIM_Cubic }, { 0.5f, 0.4f, RCIM_Cubic }, { 1.0f, -0.2f, RCIM_Cubic } } },
+		};
+
+		int32 NumErrors = 0;
+		for (const FCurveCase& Case : CurveCases)
+		{
+			const float MaxError = TestFalloffCurve(Case.Keys, NumSamples);
+			const bool bPassed = MaxError <= Tolerance;
+			NumErrors += bPassed ? 0 : 1;
+
+			UE_LOG(LogYcShooterCore, Display, TEXT("  伤害衰减 %s: 最大误差 %.5f%s"),
+				Case.Name, MaxError, bPassed ? TEXT("") : TEXT(" <- 超出容差"));
+		}
+
+		struct FRecoilCase
+		{
+			int32 NumPoints;
+			int32 LoopStart;
+			bool bUseRecoilPattern;
+		};
+		const FRecoilCase RecoilCases[] = {
+			{ 30, 0, true },
+			{ 30, 10, true },
+			{ 30, 29, true },
+			{ 30, 100, true },
+			{ 30, -5, true },
+			{ 1, 0, true },
+			{ 0, 0, true },
+			{ 30, 10, false },
+		};
+
+		for (const FRecoilCase& Case : RecoilCases)
+		{
+			const int32 NumMismatches = TestRecoilPattern(Case.NumPoints, Case.LoopStart, Case.bUseRecoilPattern);
+			NumErrors += NumMismatches > 0 ? 1 : 0;
+
+			UE_LOG(LogYcShooterCore, Display, TEXT("  弹道轨迹 %d 点, 循环起始 %d%s: 不一致 %d 发%s"),
+				Case.NumPoints, Case.LoopStart, Case.bUseRecoilPattern ? TEXT("") : TEXT(" (未启用)"),
+				NumMismatches, NumMismatches == 0 ? TEXT("") : TEXT(" <- 不一致"));
+		}
+
+		UE_LOG(LogYcShooterCore, Display, TEXT("Yc.Weapon.TestLookupTables: %s (每条曲线采样 %d 次, 容差 %.4f, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumSamples + 1, Tolerance, NumErrors);
+	}
+};
+
+namespace YcWeaponStatsLookupTest
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdTestLookupTables(
+		TEXT("Yc.Weapon.TestLookupTables"),
+		TEXT("密集采样对比武器数值查找表与衰减曲线、弹道轨迹原值：Yc.Weapon.TestLookupTables [采样次数=100000] [容差=0.01]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcWeaponStatsLookupTest::Run));
+}
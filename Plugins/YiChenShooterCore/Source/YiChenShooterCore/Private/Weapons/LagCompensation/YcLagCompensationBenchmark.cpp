@@ -0,0 +1,146 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Weapons/LagCompensation/YcLagCompensationSubsystem.h"
+#include "YiChenShooterCore.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * 延迟补偿历史查询/命中校验基准测试（控制台命令）
+ *
+ * 使用单独创建的 FYcRewindHistory 填充合成的移动轨迹，不依赖当前世界中的 Pawn：
+ * - 历史查询：随机时刻 SampleVolume 的平均耗时
+ * - 命中校验：回溯 + 起点钳制 + 重新检测的平均耗时
+ * 同时检查瞄准回溯位置的射线被接受、伪造起点或瞄准当前位置的射线被拒绝。
+ */
+struct FYcLagCompensationBenchmark
+{
+	static constexpr double FrameTime = 1.0 / 30.0;
+	static constexpr float PawnSpeed = 600.0f;
+
+	/** 合成轨迹：每个槽位沿 X 轴匀速移动，槽位之间沿 Y 轴间隔排列 */
+	static FVector GetPawnLocation(int32 Slot, double Time)
+	{
+		return FVector(PawnSpeed * Time, Slot * 300.0, 90.0);
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumPawns = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 64;
+		const int32 NumLookups = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100000;
+		const int32 NumFrames = 128;
+
+		FYcRewindHistory History;
+		History.Initialize(NumFrames, NumPawns);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double Time = Frame * FrameTime;
+			const int32 PhysicalFrame = History.BeginFrame(Time);
+			for (int32 Slot = 0; Slot < NumPawns; ++Slot)
+			{
+				FYcRewindHitVolume Volume;
+				Volume.Center = GetPawnLocation(Slot, Time);
+				Volume.Radius = 34.0f;
+				Volume.HalfHeight = 88.0f;
+				History.WriteVolume(PhysicalFrame, Slot, Volume);
+			}
+		}
+
+		const double OldestTime = History.GetOldestTime();
+		const double NewestTime = History.GetNewestTime();
+		FRandomStream Random(12345);
+
+		// 1. 历史查询
+		double Checksum = 0.0;
+		const double LookupStart = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumLookups; ++i)
+		{
+			FYcRewindHitVolume Volume;
+			if (History.SampleVolume(Random.RandHelper(NumPawns), Random.FRandRange(static_cast<float>(OldestTime), static_cast<float>(NewestTime)), Volume))
+			{
+				Checksum += Volume.Center.X;
+			}
+		}
+		const double LookupMs = (FPlatformTime::Seconds() - LookupStart) * 1000.0;
+
+		// 2. 命中校验：射击者站在原点后方，瞄准目标在回溯时刻的位置
+		const FVector ServerViewLocation(-1000.0, 0.0, 150.0);
+		const float MaxRange = 100000.0f;
+		int32 NumErrors = 0;
+		int32 NumAccepted = 0;
+
+		const double ValidateStart = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumLookups; ++i)
+		{
+			const int32 Slot = Random.RandHelper(NumPawns);
+			const double RewindTime = Random.FRandRange(static_cast<float>(OldestTime), static_cast<float>(NewestTime));
+			const FVector TargetLocation = GetPawnLocation(Slot, RewindTime);
+
+			FYcRewindHitVolume Volume;
+			if (!History.SampleVolume(Slot, RewindTime, Volume))
+			{
+				++NumErrors;
+				continue;
+			}
+
+			const FVector TraceStart = UYcLagCompensationSubsystem::ClampTraceStart(ServerViewLocation, ServerViewLocation);
+			const FVector AimDir = (TargetLocation - TraceStart).GetSafeNormal();
+			const FVector ImpactPoint = TargetLocation - AimDir * Volume.Radius;
+			if (UYcLagCompensationSubsystem::TraceRewoundVolume(Volume, TraceStart, TraceStart + AimDir * MaxRange, ImpactPoint, 0.0f))
+			{
+				++NumAccepted;
+			}
+		}
+		const double ValidateMs = (FPlatformTime::Seconds() - ValidateStart) * 1000.0;
+
+		if (NumAccepted != NumLookups)
+		{
+			UE_LOG(LogYcShooterCore, Error, TEXT("Yc.LagCompensation.Benchmark: 瞄准回溯位置的命中只接受了 %d/%d"), NumAccepted, NumLookups);
+			++NumErrors;
+		}
+
+		// 3. 反作弊检查：取一个移动中的目标，回溯 0.2 秒
+		{
+			const int32 Slot = NumPawns / 2;
+			const double RewindTime = NewestTime - 0.2;
+			const FVector RewoundLocation = GetPawnLocation(Slot, RewindTime);
+			const FVector CurrentLocation = GetPawnLocation(Slot, NewestTime);
+
+			FYcRewindHitVolume Volume;
+			History.SampleVolume(Slot, RewindTime, Volume);
+
+			// 伪造起点：客户端声称在目标身边开火，起点被钳制回服务端视点后射线与命中点不再一致
+			const FVector SpoofedStart = RewoundLocation - FVector(0.0, 100.0, 0.0);
+			const FVector ClampedStart = UYcLagCompensationSubsystem::ClampTraceStart(SpoofedStart, ServerViewLocation);
+			const FVector SpoofedDir = (RewoundLocation - SpoofedStart).GetSafeNormal();
+			const FVector SpoofedImpact = RewoundLocation - SpoofedDir * Volume.Radius;
+			if (UYcLagCompensationSubsystem::TraceRewoundVolume(Volume, ClampedStart, ClampedStart + SpoofedDir * MaxRange, SpoofedImpact, 0.0f))
+			{
+				UE_LOG(LogYcShooterCore, Error, TEXT("Yc.LagCompensation.Benchmark: 伪造射线起点的命中未被拒绝"));
+				++NumErrors;
+			}
+
+			// 瞄准目标当前位置（客户端看不到的位置）：回溯后的胶囊体已不在射线上
+			const FVector CurrentDir = (CurrentLocation - ServerViewLocation).GetSafeNormal();
+			const FVector CurrentImpact = CurrentLocation - CurrentDir * Volume.Radius;
+			if (UYcLagCompensationSubsystem::TraceRewoundVolume(Volume, ServerViewLocation, ServerViewLocation + CurrentDir * MaxRange, CurrentImpact, 0.0f))
+			{
+				UE_LOG(LogYcShooterCore, Error, TEXT("Yc.LagCompensation.Benchmark: 瞄准未回溯位置的命中未被拒绝"));
+				++NumErrors;
+			}
+		}
+
+		UE_LOG(LogYcShooterCore, Display, TEXT("Yc.LagCompensation.Benchmark: %s (%d 个 Pawn × %d 帧, %d 次查询, 历史占用 %llu 字节, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumPawns, NumFrames, NumLookups,
+			static_cast<uint64>(History.GetAllocatedSize()), NumErrors);
+		UE_LOG(LogYcShooterCore, Display, TEXT("  历史查询: 共 %.3f ms, 每次 %.1f ns (校验和 %.0f)"), LookupMs, LookupMs * 1.0e6 / NumLookups, Checksum);
+		UE_LOG(LogYcShooterCore, Display, TEXT("  命中校验: 共 %.3f ms, 每次 %.1f ns"), ValidateMs, ValidateMs * 1.0e6 / NumLookups);
+	}
+};
+
+namespace YcLagCompensationBenchmark
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+		TEXT("Yc.LagCompensation.Benchmark"),
+		TEXT("测试延迟补偿历史查询与命中校验的耗时，并检查伪造命中会被拒绝：Yc.LagCompensation.Benchmark [Pawn数量=64] [查询次数=100000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcLagCompensationBenchmark::Run));
+}
@@ -0,0 +1,524 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Weapons/LagCompensation/YcLagCompensationSubsystem.h"
+
+#include "EngineUtils.h"
+#include "YiChenShooterCore.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcLagCompensationSubsystem)
+
+// ==================== 性能计数器声明 ====================
+DECLARE_STATS_GROUP(TEXT("YcLagCompensation"), STATGROUP_YcLagCompensation, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("CaptureSnapshot"), STAT_YcLagCompensation_CaptureSnapshot, STATGROUP_YcLagCompensation);
+DECLARE_CYCLE_STAT(TEXT("ValidateHit"), STAT_YcLagCompensation_ValidateHit, STATGROUP_YcLagCompensation);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("TrackedPawns"), STAT_YcLagCompensation_TrackedPawns, STATGROUP_YcLagCompensation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HitsValidated"), STAT_YcLagCompensation_HitsValidated, STATGROUP_YcLagCompensation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HitsRejected"), STAT_YcLagCompensation_HitsRejected, STATGROUP_YcLagCompensation);
+
+// ==================== 控制台变量定义 ====================
+namespace YcLagCompensationCVars
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("Yc.LagCompensation.Enabled"),
+		bEnabled,
+		TEXT("是否在服务端对客户端上报的命中进行延迟补偿校验"),
+		ECVF_Default);
+
+	static float MaxRewindTime = 0.5f;
+	static FAutoConsoleVariableRef CVarMaxRewindTime(
+		TEXT("Yc.LagCompensation.MaxRewindTime"),
+		MaxRewindTime,
+		TEXT("服务端最多回溯的时间（秒），超出的回溯时刻会被钳制"),
+		ECVF_Default);
+
+	static float InterpDelay = 0.1f;
+	static FAutoConsoleVariableRef CVarInterpDelay(
+		TEXT("Yc.LagCompensation.InterpDelay"),
+		InterpDelay,
+		TEXT("客户端显示模拟代理时的插值延迟（秒），回溯时刻 = 当前时间 - (RTT/2 + 插值延迟)"),
+		ECVF_Default);
+
+	static float HitTolerance = 40.0f;
+	static FAutoConsoleVariableRef CVarHitTolerance(
+		TEXT("Yc.LagCompensation.HitTolerance"),
+		HitTolerance,
+		TEXT("回溯命中判定的容差（单位：uu），用于吸收插值误差和附加在Pawn上的武器等部件"),
+		ECVF_Default);
+
+	static float TraceStartTolerance = 150.0f;
+	static FAutoConsoleVariableRef CVarTraceStartTolerance(
+		TEXT("Yc.LagCompensation.TraceStartTolerance"),
+		TraceStartTolerance,
+		TEXT("客户端射线起点与服务端视点的最大偏差（单位：uu），超出时起点被钳制回服务端视点附近"),
+		ECVF_Default);
+
+	static int32 HistoryFrames = 128;
+	static FAutoConsoleVariableRef CVarHistoryFrames(
+		TEXT("Yc.LagCompensation.HistoryFrames"),
+		HistoryFrames,
+		TEXT("回溯历史保存的帧数（世界初始化时读取）"),
+		ECVF_Default);
+
+	static int32 MaxTrackedPawns = 128;
+	static FAutoConsoleVariableRef CVarMaxTrackedPawns(
+		TEXT("Yc.LagCompensation.MaxTrackedPawns"),
+		MaxTrackedPawns,
+		TEXT("回溯历史最多记录的Pawn数量（世界初始化时读取）"),
+		ECVF_Default);
+}
+
+
+// ==================== FYcRewindHistory ====================
+
+void FYcRewindHistory::Initialize(int32 InFrameCapacity, int32 InSlotCapacity)
+{
+	FrameCapacity = FMath::Max(2, InFrameCapacity);
+	SlotCapacity = FMath::Max(1, InSlotCapacity);
+	HeadFrame = 0;
+	NumFrames = 0;
+
+	const int32 NumElements = FrameCapacity * SlotCapacity;
+	FrameTimes.SetNumZeroed(FrameCapacity);
+	CenterX.SetNumZeroed(NumElements);
+	CenterY.SetNumZeroed(NumElements);
+	CenterZ.SetNumZeroed(NumElements);
+	Radius.SetNumZeroed(NumElements);
+	HalfHeight.SetNumZeroed(NumElements);
+}
+
+int32 FYcRewindHistory::BeginFrame(double Time)
+{
+	check(FrameCapacity > 0);
+
+	int32 PhysicalFrame;
+	if (NumFrames < FrameCapacity)
+	{
+		PhysicalFrame = ToPhysicalFrame(NumFrames);
+		++NumFrames;
+	}
+	else
+	{
+		// 缓冲区已满，覆盖最旧的一帧
+		PhysicalFrame = HeadFrame;
+		HeadFrame = (HeadFrame + 1) % FrameCapacity;
+	}
+
+	FrameTimes[PhysicalFrame] = Time;
+	return PhysicalFrame;
+}
+
+void FYcRewindHistory::WriteVolume(int32 PhysicalFrame, int32 Slot, const FYcRewindHitVolume& Volume)
+{
+	const int32 Index = ToIndex(PhysicalFrame, Slot);
+	CenterX[Index] = static_cast<float>(Volume.Center.X);
+	CenterY[Index] = static_cast<float>(Volume.Center.Y);
+	CenterZ[Index] = static_cast<float>(Volume.Center.Z);
+	Radius[Index] = Volume.Radius;
+	HalfHeight[Index] = Volume.HalfHeight;
+}
+
+void FYcRewindHistory::ClearSlot(int32 Slot)
+{
+	// 只需清除 Radius，Radius 为 0 即表示无效
+	for (int32 Frame = 0; Frame < FrameCapacity; ++Frame)
+	{
+		Radius[ToIndex(Frame, Slot)] = 0.0f;
+	}
+}
+
+bool FYcRewindHistory::ReadVolume(int32 PhysicalFrame, int32 Slot, FYcRewindHitVolume& OutVolume) const
+{
+	const int32 Index = ToIndex(PhysicalFrame, Slot);
+	OutVolume.Radius = Radius[Index];
+	if (OutVolume.Radius <= 0.0f)
+	{
+		return false;
+	}
+
+	OutVolume.Center = FVector(CenterX[Index], CenterY[Index], CenterZ[Index]);
+	OutVolume.HalfHeight = HalfHeight[Index];
+	return true;
+}
+
+int32 FYcRewindHistory::FindLogicalFrameAtOrBefore(double Time) const
+{
+	// 环形缓冲区的帧时间按逻辑下标单调递增，可直接二分
+	int32 Low = 0;
+	int32 High = NumFrames - 1;
+	int32 Result = INDEX_NONE;
+
+	while (Low <= High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if (FrameTimes[ToPhysicalFrame(Mid)] <= Time)
+		{
+			Result = Mid;
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid - 1;
+		}
+	}
+
+	return Result;
+}
+
+bool FYcRewindHistory::SampleVolume(int32 Slot, double Time, FYcRewindHitVolume& OutVolume) const
+{
+	if (NumFrames == 0 || Slot < 0 || Slot >= SlotCapacity)
+	{
+		return false;
+	}
+
+	const int32 Older = FindLogicalFrameAtOrBefore(Time);
+
+	// 早于最旧帧：钳制到最旧帧
+	if (Older == INDEX_NONE)
+	{
+		return ReadVolume(ToPhysicalFrame(0), Slot, OutVolume);
+	}
+
+	// 晚于最新帧：钳制到最新帧
+	if (Older == NumFrames - 1)
+	{
+		return ReadVolume(ToPhysicalFrame(Older), Slot, OutVolume);
+	}
+
+	const int32 OlderFrame = ToPhysicalFrame(Older);
+	const int32 NewerFrame = ToPhysicalFrame(Older + 1);
+
+	FYcRewindHitVolume OlderVolume;
+	FYcRewindHitVolume NewerVolume;
+	const bool bOlderValid = ReadVolume(OlderFrame, Slot, OlderVolume);
+	const bool bNewerValid = ReadVolume(NewerFrame, Slot, NewerVolume);
+
+	// 任意一帧无效（Pawn 刚注册或刚注销）时直接使用有效的一帧
+	if (!bOlderValid || !bNewerValid)
+	{
+		OutVolume = bOlderValid ? OlderVolume : NewerVolume;
+		return bOlderValid || bNewerValid;
+	}
+
+	const double FrameDelta = FrameTimes[NewerFrame] - FrameTimes[OlderFrame];
+	const float Alpha = FrameDelta > UE_SMALL_NUMBER ? static_cast<float>((Time - FrameTimes[OlderFrame]) / FrameDelta) : 1.0f;
+
+	OutVolume.Center = FMath::Lerp(OlderVolume.Center, NewerVolume.Center, Alpha);
+	OutVolume.Radius = FMath::Lerp(OlderVolume.Radius, NewerVolume.Radius, Alpha);
+	OutVolume.HalfHeight = FMath::Lerp(OlderVolume.HalfHeight, NewerVolume.HalfHeight, Alpha);
+	return true;
+}
+
+SIZE_T FYcRewindHistory::GetAllocatedSize() const
+{
+	return FrameTimes.GetAllocatedSize()
+		+ CenterX.GetAllocatedSize() + CenterY.GetAllocatedSize() + CenterZ.GetAllocatedSize()
+		+ Radius.GetAllocatedSize() + HalfHeight.GetAllocatedSize();
+}
+
+
+// ==================== UYcLagCompensationSubsystem ====================
+
+void UYcLagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	History.Initialize(YcLagCompensationCVars::HistoryFrames, YcLagCompensationCVars::MaxTrackedPawns);
+	SlotPawns.Reserve(History.GetSlotCapacity());
+}
+
+void UYcLagCompensationSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+
+	SET_DWORD_STAT(STAT_YcLagCompensation_TrackedPawns, 0);
+
+	SlotPawns.Reset();
+	PawnToSlot.Reset();
+	FreeSlots.Reset();
+	bIsRecording = false;
+
+	Super::Deinitialize();
+}
+
+bool UYcLagCompensationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (const UWorld* World = Cast<UWorld>(Outer))
+	{
+		return World->IsGameWorld();
+	}
+	return false;
+}
+
+void UYcLagCompensationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 只有服务端需要记录回溯历史
+	if (InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	bIsRecording = true;
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::CaptureSnapshot);
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::OnActorSpawned));
+
+	// 注册已经存在的 Pawn
+	for (TActorIterator<APawn> It(&InWorld); It; ++It)
+	{
+		TrackPawn(*It);
+	}
+
+	UE_LOG(LogYcShooterCore, Log, TEXT("LagCompensation 已启用：%d 帧 × %d 槽位，历史占用 %llu 字节"),
+		YcLagCompensationCVars::HistoryFrames, History.GetSlotCapacity(), static_cast<uint64>(History.GetAllocatedSize()));
+}
+
+void UYcLagCompensationSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (APawn* Pawn = Cast<APawn>(Actor))
+	{
+		TrackPawn(Pawn);
+	}
+}
+
+void UYcLagCompensationSubsystem::TrackPawn(APawn* Pawn)
+{
+	if (!bIsRecording || !IsValid(Pawn) || PawnToSlot.Contains(Pawn))
+	{
+		return;
+	}
+
+	int32 Slot = INDEX_NONE;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+		// 槽位之前属于其他 Pawn，清除旧的历史数据避免回溯到错误的位置
+		History.ClearSlot(Slot);
+		SlotPawns[Slot] = Pawn;
+	}
+	else if (SlotPawns.Num() < History.GetSlotCapacity())
+	{
+		Slot = SlotPawns.Add(Pawn);
+	}
+	else
+	{
+		UE_LOG(LogYcShooterCore, Warning, TEXT("LagCompensation 槽位已满(%d)，Pawn %s 不会被回溯校验"),
+			History.GetSlotCapacity(), *GetNameSafe(Pawn));
+		return;
+	}
+
+	PawnToSlot.Add(Pawn, Slot);
+	INC_DWORD_STAT(STAT_YcLagCompensation_TrackedPawns);
+}
+
+void UYcLagCompensationSubsystem::UntrackPawn(const APawn* Pawn)
+{
+	int32 Slot = INDEX_NONE;
+	if (PawnToSlot.RemoveAndCopyValue(Pawn, Slot))
+	{
+		SlotPawns[Slot] = TObjectKey<APawn>();
+		FreeSlots.Add(Slot);
+		DEC_DWORD_STAT(STAT_YcLagCompensation_TrackedPawns);
+	}
+}
+
+FYcRewindHitVolume UYcLagCompensationSubsystem::BuildHitVolume(const APawn* Pawn)
+{
+	FYcRewindHitVolume Volume;
+
+	if (const UCapsuleComponent* Capsule = Cast<UCapsuleComponent>(Pawn->GetRootComponent()))
+	{
+		Volume.Center = Capsule->GetComponentLocation();
+		Volume.Radius = Capsule->GetScaledCapsuleRadius();
+		Volume.HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	}
+	else if (const USceneComponent* Root = Pawn->GetRootComponent())
+	{
+		// 非胶囊体根组件：用包围盒近似为直立胶囊体
+		const FBoxSphereBounds& Bounds = Root->Bounds;
+		Volume.Center = Bounds.Origin;
+		Volume.Radius = static_cast<float>(FMath::Max(Bounds.BoxExtent.X, Bounds.BoxExtent.Y));
+		Volume.HalfHeight = static_cast<float>(FMath::Max<double>(Bounds.BoxExtent.Z, Volume.Radius));
+	}
+
+	return Volume;
+}
+
+void UYcLagCompensationSubsystem::CaptureSnapshot(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld() || !bIsRecording)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_YcLagCompensation_CaptureSnapshot);
+
+	const int32 Frame = History.BeginFrame(InWorld->GetTimeSeconds());
+
+	for (int32 Slot = 0; Slot < SlotPawns.Num(); ++Slot)
+	{
+		const APawn* Pawn = SlotPawns[Slot].ResolveObjectPtr();
+		if (!IsValid(Pawn))
+		{
+			// 已销毁的 Pawn 自动注销
+			if (SlotPawns[Slot] != TObjectKey<APawn>())
+			{
+				PawnToSlot.Remove(SlotPawns[Slot]);
+				SlotPawns[Slot] = TObjectKey<APawn>();
+				FreeSlots.Add(Slot);
+				DEC_DWORD_STAT(STAT_YcLagCompensation_TrackedPawns);
+			}
+
+			History.WriteVolume(Frame, Slot, FYcRewindHitVolume());
+			continue;
+		}
+
+		History.WriteVolume(Frame, Slot, BuildHitVolume(Pawn));
+	}
+}
+
+const APawn* UYcLagCompensationSubsystem::ResolveHitPawn(const AActor* HitActor)
+{
+	if (HitActor == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (const APawn* Pawn = Cast<APawn>(HitActor))
+	{
+		return Pawn;
+	}
+
+	// 命中附加在 Pawn 上的 Actor（武器、装备等）
+	return Cast<APawn>(HitActor->GetAttachParentActor());
+}
+
+bool UYcLagCompensationSubsystem::GetRewoundHitVolume(const APawn* Pawn, double Time, FYcRewindHitVolume& OutVolume) const
+{
+	const int32* Slot = PawnToSlot.Find(Pawn);
+	if (!Slot)
+	{
+		return false;
+	}
+
+	return History.SampleVolume(*Slot, Time, OutVolume);
+}
+
+double UYcLagCompensationSubsystem::GetRewindTime(const AController* Shooter) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// 射击者看到的是 RTT/2 之前的服务器状态，再加上模拟代理的插值延迟
+	double Latency = YcLagCompensationCVars::InterpDelay;
+	if (const APlayerState* PlayerState = Shooter ? Shooter->PlayerState : nullptr)
+	{
+		Latency += PlayerState->GetPingInMilliseconds() * 0.5f / 1000.0f;
+	}
+
+	const double MinTime = FMath::Max(Now - YcLagCompensationCVars::MaxRewindTime, History.GetOldestTime());
+	const double MaxTime = FMath::Max(MinTime, FMath::Min(Now, History.GetNewestTime()));
+	return FMath::Clamp(Now - Latency, MinTime, MaxTime);
+}
+
+FVector UYcLagCompensationSubsystem::ClampTraceStart(const FVector& ClientTraceStart, const FVector& ServerViewLocation)
+{
+	const FVector Offset = ClientTraceStart - ServerViewLocation;
+	return ServerViewLocation + Offset.GetClampedToMaxSize(YcLagCompensationCVars::TraceStartTolerance);
+}
+
+bool UYcLagCompensationSubsystem::TraceRewoundVolume(const FYcRewindHitVolume& Volume, const FVector& TraceStart, const FVector& TraceEnd,
+	const FVector& ImpactPoint, float SweepRadius)
+{
+	const float Tolerance = YcLagCompensationCVars::HitTolerance + SweepRadius;
+
+	// 胶囊体中轴线段
+	const float SegmentHalfLength = FMath::Max(0.0f, Volume.HalfHeight - Volume.Radius);
+	const FVector SegmentOffset(0.0f, 0.0f, SegmentHalfLength);
+	const FVector CapsuleA = Volume.Center - SegmentOffset;
+	const FVector CapsuleB = Volume.Center + SegmentOffset;
+
+	// 1. 服务端射线必须穿过回溯后的胶囊体
+	FVector PointOnTrace;
+	FVector PointOnCapsule;
+	FMath::SegmentDistToSegmentSafe(TraceStart, TraceEnd, CapsuleA, CapsuleB, PointOnTrace, PointOnCapsule);
+	if (FVector::Dist(PointOnTrace, PointOnCapsule) > Volume.Radius + Tolerance)
+	{
+		return false;
+	}
+
+	// 2. 命中点必须落在回溯后的胶囊体表面附近
+	if (FMath::PointDistToSegment(ImpactPoint, CapsuleA, CapsuleB) > Volume.Radius + YcLagCompensationCVars::HitTolerance)
+	{
+		return false;
+	}
+
+	// 3. 命中点必须落在服务端射线附近，防止命中点与射线方向不一致
+	return FMath::PointDistToSegment(ImpactPoint, TraceStart, TraceEnd) <= Tolerance;
+}
+
+bool UYcLagCompensationSubsystem::ValidateHit(const FHitResult& Hit, const AController* Shooter, float SweepRadius, float MaxRange) const
+{
+	if (!bIsRecording || !YcLagCompensationCVars::bEnabled)
+	{
+		return true;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_YcLagCompensation_ValidateHit);
+
+	// 场景命中不做回溯校验
+	const APawn* HitPawn = ResolveHitPawn(Hit.GetActor());
+	if (HitPawn == nullptr)
+	{
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_YcLagCompensation_HitsValidated);
+
+	// 射击者已失效时无法确定服务端视点，拒绝对 Pawn 的命中
+	const APawn* ShooterPawn = Shooter ? Shooter->GetPawn() : nullptr;
+	if (ShooterPawn == nullptr)
+	{
+		INC_DWORD_STAT(STAT_YcLagCompensation_HitsRejected);
+		return false;
+	}
+
+	FYcRewindHitVolume Volume;
+	if (!GetRewoundHitVolume(HitPawn, GetRewindTime(Shooter), Volume))
+	{
+		// 没有历史数据（如刚生成的 Pawn），无法校验，信任客户端
+		return true;
+	}
+
+	// 只采信客户端的射击方向，起点钳制到服务端视点附近，射程使用武器的最大射程
+	const FVector TraceStart = ClampTraceStart(Hit.TraceStart, ShooterPawn->GetPawnViewLocation());
+	const FVector AimDir = (Hit.TraceEnd - Hit.TraceStart).GetSafeNormal();
+	if (AimDir.IsNearlyZero())
+	{
+		INC_DWORD_STAT(STAT_YcLagCompensation_HitsRejected);
+		return false;
+	}
+
+	const FVector TraceEnd = TraceStart + AimDir * MaxRange;
+	if (!TraceRewoundVolume(Volume, TraceStart, TraceEnd, Hit.ImpactPoint, SweepRadius))
+	{
+		INC_DWORD_STAT(STAT_YcLagCompensation_HitsRejected);
+		return false;
+	}
+
+	return true;
+}
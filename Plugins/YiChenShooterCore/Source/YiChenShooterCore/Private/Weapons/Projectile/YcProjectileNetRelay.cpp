@@ -0,0 +1,46 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Weapons/Projectile/YcProjectileNetRelay.h"
+
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcProjectileNetRelay)
+
+AYcProjectileNetRelay::AYcProjectileNetRelay(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+
+	// 没有需要复制的属性，只使用 RPC；不可靠多播随 Actor 的网络更新发出，
+	// 更新频率必须足够高，否则生成和命中会被延迟到下一次更新
+	SetNetUpdateFrequency(100.0f);
+}
+
+void AYcProjectileNetRelay::MulticastSpawnProjectiles_Implementation(const TArray<FYcProjectileSpawnRecord>& Records)
+{
+	if (UYcProjectileSimulationSubsystem* Simulation = GetClientSimulation())
+	{
+		Simulation->HandleReplicatedSpawns(Records);
+	}
+}
+
+void AYcProjectileNetRelay::MulticastProjectileImpacts_Implementation(const TArray<FYcProjectileImpact>& Impacts)
+{
+	if (UYcProjectileSimulationSubsystem* Simulation = GetClientSimulation())
+	{
+		Simulation->HandleReplicatedImpacts(Impacts);
+	}
+}
+
+UYcProjectileSimulationSubsystem* AYcProjectileNetRelay::GetClientSimulation() const
+{
+	if (HasAuthority())
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UYcProjectileSimulationSubsystem>() : nullptr;
+}
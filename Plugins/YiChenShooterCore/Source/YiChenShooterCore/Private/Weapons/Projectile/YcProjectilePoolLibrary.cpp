@@ -2,6 +2,8 @@
 
 #include "Weapons/Projectile/YcProjectilePoolLibrary.h"
 #include "Engine/World.h"
+#include "Weapons/Projectile/YcProjectileSimulationSettings.h"
+#include "Weapons/Projectile/YcProjectileSimulationSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcProjectilePoolLibrary)
 
@@ -54,6 +56,20 @@ AYcProjectileBase* UYcProjectilePoolLibrary::FireProjectileWithParams(
 	FName PoolID,
 	const FYcProjectileInitParams& Params)
 {
+	// 配置为数据驱动模拟的子弹池：服务端交给模拟子系统，客户端的表现由网络中继复制下来
+	if (GetDefault<UYcProjectileSimulationSettings>()->IsSimulatedPool(PoolID))
+	{
+		const UWorld* World = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+		if (World && World->GetNetMode() != NM_Client)
+		{
+			if (UYcProjectileSimulationSubsystem* Simulation = World->GetSubsystem<UYcProjectileSimulationSubsystem>())
+			{
+				Simulation->FireProjectile(Params);
+			}
+		}
+		return nullptr;
+	}
+
 	UYcProjectilePoolSubsystem* PoolSubsystem = GetProjectilePoolSubsystem(WorldContextObject);
 	if (!PoolSubsystem)
 	{
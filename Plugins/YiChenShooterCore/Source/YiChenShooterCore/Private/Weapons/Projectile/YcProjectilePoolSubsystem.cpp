@@ -1,13 +1,26 @@
 // Copyright (c) 2025 YiChen. All Rights Reserved.
 
 #include "Weapons/Projectile/YcProjectilePoolSubsystem.h"
+#include "Engine/GameInstance.h"
 #include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "LoadingScreenManager.h"
 #include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcProjectilePoolSubsystem)
 
 DEFINE_LOG_CATEGORY_STATIC(LogProjectilePool, Log, All);
 
+namespace YcProjectilePoolCVars
+{
+	static float WarmupBudgetMs = 2.0f;
+	static FAutoConsoleVariableRef CVarWarmupBudgetMs(
+		TEXT("Yc.Projectile.PoolWarmupBudgetMs"),
+		WarmupBudgetMs,
+		TEXT("子弹对象池分帧预热每帧的时间预算（毫秒），<=0 表示不分帧，预热请求立即完成"),
+		ECVF_Default);
+}
+
 void UYcProjectilePoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -24,8 +37,41 @@ void UYcProjectilePoolSubsystem::Initialize(FSubsystemCollectionBase& Collection
 			10.0f, // 每10秒检查一次
 			true
 		);
+
+		// 预热未完成时让加载界面继续显示
+		if (UGameInstance* GameInstance = World->GetGameInstance())
+		{
+			if (ULoadingScreenManager* LoadingScreenManager = GameInstance->GetSubsystem<ULoadingScreenManager>())
+			{
+				LoadingScreenManager->RegisterLoadingProcessor(this);
+			}
+		}
 	}
 
+	// 预热调度器回调
+	WarmupScheduler.GetPoolInfo = [this](FName PoolID, FObjectPoolWarmupPoolInfo& OutInfo)
+	{
+		const FYcProjectilePoolData* PoolData = Pools.Find(PoolID);
+		if (!PoolData)
+		{
+			return false;
+		}
+
+		OutInfo.DefaultCount = PoolData->Config.InitialPoolSize;
+		OutInfo.Priority = PoolData->Config.WarmupPriority;
+		OutInfo.ExpectedDemand = PoolData->GetExpectedDemand();
+		return true;
+	};
+	WarmupScheduler.GetDeficit = [this](FName PoolID, int32 TargetCount)
+	{
+		const FYcProjectilePoolData* PoolData = Pools.Find(PoolID);
+		return PoolData ? FMath::Max(0, FMath::Min(TargetCount, PoolData->Config.MaxPoolSize) - PoolData->GetTotalCount()) : 0;
+	};
+	WarmupScheduler.CreateObject = [this](FName PoolID)
+	{
+		return CreateWarmupProjectile(PoolID);
+	};
+
 	UE_LOG(LogProjectilePool, Log, TEXT("ProjectilePoolSubsystem initialized"));
 }
 
@@ -35,10 +81,19 @@ void UYcProjectilePoolSubsystem::Deinitialize()
 	if (UWorld* World = GetWorld())
 	{
 		World->GetTimerManager().ClearTimer(ShrinkCheckTimerHandle);
+
+		if (UGameInstance* GameInstance = World->GetGameInstance())
+		{
+			if (ULoadingScreenManager* LoadingScreenManager = GameInstance->GetSubsystem<ULoadingScreenManager>())
+			{
+				LoadingScreenManager->UnregisterLoadingProcessor(this);
+			}
+		}
 	}
 
 	// 清理所有池
 	ClearAllPools();
+	WarmupScheduler.Reset();
 
 	bIsInitialized = false;
 
@@ -57,6 +112,31 @@ bool UYcProjectilePoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 	return false;
 }
 
+void UYcProjectilePoolSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (WarmupScheduler.IsWarmingUp())
+	{
+		ProcessWarmup(YcProjectilePoolCVars::WarmupBudgetMs * 0.001);
+	}
+}
+
+TStatId UYcProjectilePoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UYcProjectilePoolSubsystem, STATGROUP_Tickables);
+}
+
+bool UYcProjectilePoolSubsystem::ShouldShowLoadingScreen(FString& OutReason) const
+{
+	if (IsWarmingUp())
+	{
+		OutReason = FString::Printf(TEXT("Projectile pool warmup %d/%d"), WarmupScheduler.GetCreatedCount(), WarmupScheduler.GetTotalCount());
+		return true;
+	}
+	return false;
+}
+
 bool UYcProjectilePoolSubsystem::RegisterPool(const FYcProjectilePoolConfig& Config)
 {
 	if (Config.PoolID.IsNone())
@@ -151,6 +231,13 @@ AYcProjectileBase* UYcProjectilePoolSubsystem::AcquireProjectile(FName PoolID, c
 
 		GrowPool(PoolID, GrowthAmount);
 
+		// 生成回调可能注册新池导致 Pools 重新分配，重新查找
+		PoolData = Pools.Find(PoolID);
+		if (!PoolData)
+		{
+			return nullptr;
+		}
+
 		// 再次尝试获取
 		if (PoolData->AvailableIndices.Num() > 0)
 		{
@@ -209,48 +296,57 @@ void UYcProjectilePoolSubsystem::ReleaseProjectile(AYcProjectileBase* Projectile
 
 void UYcProjectilePoolSubsystem::WarmupPool(FName PoolID, int32 Count)
 {
-	FYcProjectilePoolData* PoolData = Pools.Find(PoolID);
-	if (!PoolData)
+	if (!Pools.Contains(PoolID))
 	{
 		UE_LOG(LogProjectilePool, Warning, TEXT("Cannot warmup pool [%s]: not found"), *PoolID.ToString());
 		return;
 	}
 
-	const int32 TargetCount = (Count < 0) ? PoolData->Config.InitialPoolSize : Count;
-	const int32 CurrentCount = PoolData->AllProjectiles.Num();
-	const int32 ToCreate = FMath::Min(TargetCount - CurrentCount, PoolData->Config.MaxPoolSize - CurrentCount);
+	WarmupScheduler.Enqueue(PoolID, Count);
 
-	if (ToCreate <= 0)
+	// 不分帧时保持原有行为，立即完成
+	if (YcProjectilePoolCVars::WarmupBudgetMs <= 0.0f)
 	{
-		return;
+		ProcessWarmup(0.0);
 	}
+}
 
-	UE_LOG(LogProjectilePool, Log, TEXT("Warming up pool [%s]: creating %d projectiles"), *PoolID.ToString(), ToCreate);
+void UYcProjectilePoolSubsystem::WarmupAllPools()
+{
+	TArray<FName> PoolIDs;
+	Pools.GetKeys(PoolIDs);
 
-	for (int32 i = 0; i < ToCreate; ++i)
+	for (const FName& PoolID : PoolIDs)
 	{
-		AYcProjectileBase* Projectile = CreateProjectileInstance(PoolData->Config);
-		if (Projectile)
-		{
-			const int32 Index = PoolData->AllProjectiles.Add(Projectile);
-			PoolData->AvailableIndices.Add(Index);
-			ProjectileToPoolMap.Add(Projectile, PoolID);
-
-			// 绑定回收事件
-			Projectile->OnProjectileRecycled.AddDynamic(this, &UYcProjectilePoolSubsystem::OnProjectileRecycled);
-		}
+		WarmupPool(PoolID);
 	}
+}
 
-	UE_LOG(LogProjectilePool, Log, TEXT("Pool [%s] warmup complete: %d total projectiles"),
-		*PoolID.ToString(), PoolData->AllProjectiles.Num());
+void UYcProjectilePoolSubsystem::FlushWarmup()
+{
+	ProcessWarmup(0.0);
 }
 
-void UYcProjectilePoolSubsystem::WarmupAllPools()
+float UYcProjectilePoolSubsystem::GetWarmupProgress() const
 {
-	for (auto& Pair : Pools)
+	return WarmupScheduler.GetProgress();
+}
+
+int32 UYcProjectilePoolSubsystem::ProcessWarmup(double BudgetSeconds)
+{
+	const FObjectPoolWarmupResult Result = WarmupScheduler.Process(BudgetSeconds);
+
+	if (Result.bProgressChanged && OnWarmupProgress.IsBound())
 	{
-		WarmupPool(Pair.Key);
+		OnWarmupProgress.Broadcast(Result.CreatedCount, Result.TotalCount);
 	}
+
+	return Result.NumCreated;
+}
+
+bool UYcProjectilePoolSubsystem::CreateWarmupProjectile(FName PoolID)
+{
+	return AddProjectilesToPool(PoolID, 1) > 0;
 }
 
 bool UYcProjectilePoolSubsystem::GetPoolStats(FName PoolID, FYcProjectilePoolStats& OutStats) const
@@ -377,18 +473,46 @@ void UYcProjectilePoolSubsystem::GrowPool(FName PoolID, int32 GrowthAmount)
 
 	UE_LOG(LogProjectilePool, Log, TEXT("Growing pool [%s] by %d"), *PoolID.ToString(), ActualGrowth);
 
-	for (int32 i = 0; i < ActualGrowth; ++i)
+	AddProjectilesToPool(PoolID, ActualGrowth);
+}
+
+int32 UYcProjectilePoolSubsystem::AddProjectilesToPool(FName PoolID, int32 Count)
+{
+	int32 Created = 0;
+	for (int32 i = 0; i < Count; ++i)
 	{
-		AYcProjectileBase* Projectile = CreateProjectileInstance(PoolData->Config);
-		if (Projectile)
+		// 复制配置，生成期间不持有池数据的引用
+		const FYcProjectilePoolData* PoolData = Pools.Find(PoolID);
+		if (!PoolData || PoolData->GetTotalCount() >= PoolData->Config.MaxPoolSize)
 		{
-			const int32 Index = PoolData->AllProjectiles.Add(Projectile);
-			PoolData->AvailableIndices.Add(Index);
-			ProjectileToPoolMap.Add(Projectile, PoolID);
+			break;
+		}
+		const FYcProjectilePoolConfig Config = PoolData->Config;
 
-			Projectile->OnProjectileRecycled.AddDynamic(this, &UYcProjectilePoolSubsystem::OnProjectileRecycled);
+		AYcProjectileBase* Projectile = CreateProjectileInstance(Config);
+		if (!Projectile)
+		{
+			continue;
 		}
+
+		// 生成回调可能注册/注销池导致 Pools 重新分配，重新查找
+		FYcProjectilePoolData* CurrentPoolData = Pools.Find(PoolID);
+		if (!CurrentPoolData || CurrentPoolData->Config.ProjectileClass != Config.ProjectileClass)
+		{
+			Projectile->Destroy();
+			break;
+		}
+
+		const int32 Index = CurrentPoolData->AllProjectiles.Add(Projectile);
+		CurrentPoolData->AvailableIndices.Add(Index);
+		ProjectileToPoolMap.Add(Projectile, PoolID);
+
+		// 绑定回收事件
+		Projectile->OnProjectileRecycled.AddDynamic(this, &UYcProjectilePoolSubsystem::OnProjectileRecycled);
+		++Created;
 	}
+
+	return Created;
 }
 
 void UYcProjectilePoolSubsystem::ShrinkPool(FName PoolID)
@@ -0,0 +1,619 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Weapons/Projectile/YcProjectileSimulationSubsystem.h"
+
+#include "YiChenShooterCore.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "Kismet/GameplayStatics.h"
+#include "Weapons/Projectile/YcProjectileNetRelay.h"
+#include "Weapons/Projectile/YcProjectileSimulationSettings.h"
+#include "Engine/LevelBounds.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(YcProjectileSimulationSubsystem)
+
+// ==================== 性能计数器声明 ====================
+DECLARE_STATS_GROUP(TEXT("YcProjectile"), STATGROUP_YcProjectile, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Simulate"), STAT_YcProjectile_Simulate, STATGROUP_YcProjectile);
+DECLARE_CYCLE_STAT(TEXT("Sweep"), STAT_YcProjectile_Sweep, STATGROUP_YcProjectile);
+DECLARE_CYCLE_STAT(TEXT("FlushNetRecords"), STAT_YcProjectile_FlushNetRecords, STATGROUP_YcProjectile);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ActiveProjectiles"), STAT_YcProjectile_Active, STATGROUP_YcProjectile);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impacts"), STAT_YcProjectile_Impacts, STATGROUP_YcProjectile);
+
+// ==================== 控制台变量定义 ====================
+namespace YcProjectileCVars
+{
+	static int32 MaxActive = 16384;
+	static FAutoConsoleVariableRef CVarMaxActive(
+		TEXT("Yc.Projectile.MaxActive"),
+		MaxActive,
+		TEXT("数据驱动子弹模拟同时存在的子弹上限，超出时发射失败"),
+		ECVF_Default);
+
+	static float FrameBudgetMs = 2.0f;
+	static FAutoConsoleVariableRef CVarFrameBudgetMs(
+		TEXT("Yc.Projectile.FrameBudgetMs"),
+		FrameBudgetMs,
+		TEXT("数据驱动子弹模拟每帧的时间预算（毫秒），超出时输出警告，<=0 表示不检查"),
+		ECVF_Default);
+
+	static float MaxLatencyCompensation = 0.5f;
+	static FAutoConsoleVariableRef CVarMaxLatencyCompensation(
+		TEXT("Yc.Projectile.MaxLatencyCompensation"),
+		MaxLatencyCompensation,
+		TEXT("客户端收到子弹生成参数时最多向前推算的时间（秒）"),
+		ECVF_Default);
+
+	static float RecentImpactLifetime = 2.0f;
+	static FAutoConsoleVariableRef CVarRecentImpactLifetime(
+		TEXT("Yc.Projectile.RecentImpactLifetime"),
+		RecentImpactLifetime,
+		TEXT("客户端记住命中先于生成参数到达的子弹ID的时间（秒），期间到达的生成参数会被丢弃"),
+		ECVF_Default);
+
+	static bool bParallelSweeps = true;
+	static FAutoConsoleVariableRef CVarParallelSweeps(
+		TEXT("Yc.Projectile.ParallelSweeps"),
+		bParallelSweeps,
+		TEXT("是否在工作线程上按批次并行执行模拟子弹的扫掠检测"),
+		ECVF_Default);
+
+	static int32 SweepBatchSize = 128;
+	static FAutoConsoleVariableRef CVarSweepBatchSize(
+		TEXT("Yc.Projectile.SweepBatchSize"),
+		SweepBatchSize,
+		TEXT("并行扫掠检测时每批处理的子弹数量，子弹数量不超过一批时在游戏线程执行"),
+		ECVF_Default);
+
+	/** 扫掠检测不需要忽略发射者 */
+	static constexpr uint32 NoIgnoredActor = MAX_uint32;
+
+	/** 与 AYcProjectileBase 的碰撞组件使用同一碰撞预设 */
+	static const FName CollisionProfileName(TEXT("Projectile"));
+}
+
+namespace YcProjectileSimulationCommands
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmark(
+		TEXT("Yc.Projectile.Benchmark"),
+		TEXT("在当前世界中生成指定数量的模拟子弹并推进若干帧，输出平均每帧耗时。参数：[数量=10000] [帧数=120]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&UYcProjectileSimulationSubsystem::RunBenchmark));
+}
+
+// ==================== 生命周期 ====================
+
+void UYcProjectileSimulationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+}
+
+void UYcProjectileSimulationSubsystem::Deinitialize()
+{
+	for (const TWeakObjectPtr<AActor>& Proxy : VisualProxies)
+	{
+		if (AActor* ProxyActor = Proxy.Get())
+		{
+			ProxyActor->Destroy();
+		}
+	}
+
+	ProjectileIds.Reset();
+	Positions.Reset();
+	Velocities.Reset();
+	MaxSpeeds.Reset();
+	GravityScales.Reset();
+	RemainingLifeSpans.Reset();
+	CollisionRadii.Reset();
+	Damages.Reset();
+	Instigators.Reset();
+	InstigatorControllers.Reset();
+	VisualProxies.Reset();
+	IdToIndex.Reset();
+	PendingSpawnRecords.Reset();
+	PendingImpactRecords.Reset();
+	RecentImpactExpireTimes.Reset();
+
+	SET_DWORD_STAT(STAT_YcProjectile_Active, 0);
+
+	Super::Deinitialize();
+}
+
+bool UYcProjectileSimulationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (const UWorld* World = Cast<UWorld>(Outer))
+	{
+		return World->IsGameWorld();
+	}
+	return false;
+}
+
+void UYcProjectileSimulationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const ENetMode NetMode = InWorld.GetNetMode();
+	bHasAuthority = NetMode != NM_Client;
+	bSpawnVisualProxies = NetMode != NM_DedicatedServer;
+
+	if (bSpawnVisualProxies)
+	{
+		VisualProxyClass = GetDefault<UYcProjectileSimulationSettings>()->VisualProxyClass.LoadSynchronous();
+	}
+
+	// 有客户端连接的服务器才需要网络中继
+	if (NetMode == NM_DedicatedServer || NetMode == NM_ListenServer)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		NetRelay = InWorld.SpawnActor<AYcProjectileNetRelay>(SpawnParams);
+	}
+}
+
+TStatId UYcProjectileSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UYcProjectileSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UYcProjectileSimulationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double StartTime = FPlatformTime::Seconds();
+	Simulate(DeltaTime);
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	if (YcProjectileCVars::FrameBudgetMs > 0.0f && ElapsedMs > YcProjectileCVars::FrameBudgetMs)
+	{
+		UE_LOG(LogYcShooterCore, Verbose, TEXT("ProjectileSimulation: %d 颗子弹耗时 %.3f ms，超出预算 %.3f ms"),
+			ProjectileIds.Num(), ElapsedMs, YcProjectileCVars::FrameBudgetMs);
+	}
+
+	FlushNetRecords();
+}
+
+// ==================== 发射与模拟 ====================
+
+int32 UYcProjectileSimulationSubsystem::FireProjectile(const FYcProjectileInitParams& Params)
+{
+	if (!bHasAuthority)
+	{
+		UE_LOG(LogYcShooterCore, Warning, TEXT("ProjectileSimulation: FireProjectile 只能在服务端调用"));
+		return INDEX_NONE;
+	}
+
+	if (ProjectileIds.Num() >= YcProjectileCVars::MaxActive)
+	{
+		UE_LOG(LogYcShooterCore, Warning, TEXT("ProjectileSimulation: 子弹数量达到上限 %d"), YcProjectileCVars::MaxActive);
+		return INDEX_NONE;
+	}
+
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+
+	FYcProjectileSpawnRecord Record;
+	Record.ProjectileId = NextProjectileId;
+	Record.Origin = Params.SpawnLocation;
+	Record.Velocity = Params.Direction.GetSafeNormal() * Params.InitialSpeed;
+	Record.MaxSpeed = Params.MaxSpeed;
+	Record.GravityScale = Params.bEnableGravity ? Params.GravityScale : 0.0f;
+	Record.LifeSpan = Params.LifeSpan;
+	Record.CollisionRadius = Params.CollisionRadius;
+	Record.SpawnServerTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+	Record.Instigator = Params.Instigator.Get();
+
+	// ID 只需在同一世界内唯一，回绕后跳过 INDEX_NONE
+	NextProjectileId = NextProjectileId == MAX_int32 ? 0 : NextProjectileId + 1;
+
+	AddProjectile(Record, Params.Damage, Params.InstigatorController.Get());
+
+	if (NetRelay.IsValid())
+	{
+		PendingSpawnRecords.Add(Record);
+	}
+
+	return Record.ProjectileId;
+}
+
+void UYcProjectileSimulationSubsystem::Simulate(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_YcProjectile_Simulate);
+
+	const int32 NumProjectiles = ProjectileIds.Num();
+	SET_DWORD_STAT(STAT_YcProjectile_Active, NumProjectiles);
+	if (NumProjectiles == 0 || DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	const float GravityZ = World->GetGravityZ();
+
+	// 1. 积分：连续数组上的紧凑循环，不做任何查询
+	SweepEnds.SetNumUninitialized(NumProjectiles, EAllowShrinking::No);
+	PendingRemovals.Reset();
+	PendingHits.Reset();
+
+	for (int32 Index = 0; Index < NumProjectiles; ++Index)
+	{
+		FVector& Velocity = Velocities[Index];
+		Velocity.Z += GravityZ * GravityScales[Index] * DeltaTime;
+		Velocity = Velocity.GetClampedToMaxSize(MaxSpeeds[Index]);
+
+		SweepEnds[Index] = Positions[Index] + Velocity * DeltaTime;
+		RemainingLifeSpans[Index] -= DeltaTime;
+	}
+
+	// 2. 碰撞：服务端批量扫掠，客户端只做表现，命中以服务端复制为准
+	if (bHasAuthority)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_YcProjectile_Sweep);
+
+		// 发射者在游戏线程解析，工作线程只做物理查询
+		SweepIgnoredActorIds.SetNumUninitialized(NumProjectiles, EAllowShrinking::No);
+		for (int32 Index = 0; Index < NumProjectiles; ++Index)
+		{
+			const AActor* Instigator = Instigators[Index].Get();
+			SweepIgnoredActorIds[Index] = Instigator ? Instigator->GetUniqueID() : YcProjectileCVars::NoIgnoredActor;
+		}
+		SweepHits.SetNum(NumProjectiles, EAllowShrinking::No);
+		SweepHitFlags.SetNumUninitialized(NumProjectiles, EAllowShrinking::No);
+
+		// 每批共用一份查询参数，批次之间互不依赖
+		const int32 BatchSize = FMath::Max(1, YcProjectileCVars::SweepBatchSize);
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumProjectiles, BatchSize);
+		ParallelFor(NumBatches, [&](int32 BatchIndex)
+		{
+			FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(YcProjectileSimulation), false);
+			QueryParams.bReturnPhysicalMaterial = true;
+
+			const int32 EndIndex = FMath::Min(NumProjectiles, (BatchIndex + 1) * BatchSize);
+			for (int32 Index = BatchIndex * BatchSize; Index < EndIndex; ++Index)
+			{
+				QueryParams.ClearIgnoredSourceObjects();
+				if (SweepIgnoredActorIds[Index] != YcProjectileCVars::NoIgnoredActor)
+				{
+					QueryParams.AddIgnoredActor(SweepIgnoredActorIds[Index]);
+				}
+
+				const float Radius = CollisionRadii[Index];
+				const bool bHit = Radius > 0.0f
+					? World->SweepSingleByProfile(SweepHits[Index], Positions[Index], SweepEnds[Index], FQuat::Identity,
+						YcProjectileCVars::CollisionProfileName, FCollisionShape::MakeSphere(Radius), QueryParams)
+					: World->LineTraceSingleByProfile(SweepHits[Index], Positions[Index], SweepEnds[Index],
+						YcProjectileCVars::CollisionProfileName, QueryParams);
+				SweepHitFlags[Index] = bHit ? 1 : 0;
+			}
+		}, !YcProjectileCVars::bParallelSweeps || NumBatches < 2);
+
+		for (int32 Index = 0; Index < NumProjectiles; ++Index)
+		{
+			if (SweepHitFlags[Index])
+			{
+				PendingHits.Emplace(Index, MoveTemp(SweepHits[Index]));
+				PendingRemovals.Add(Index);
+			}
+			else if (RemainingLifeSpans[Index] <= 0.0f)
+			{
+				PendingRemovals.Add(Index);
+			}
+		}
+	}
+	else
+	{
+		for (int32 Index = 0; Index < NumProjectiles; ++Index)
+		{
+			if (RemainingLifeSpans[Index] <= 0.0f)
+			{
+				PendingRemovals.Add(Index);
+			}
+		}
+	}
+
+	// 3. 写回位置并同步表现代理
+	Swap(Positions, SweepEnds);
+	if (bSpawnVisualProxies)
+	{
+		for (int32 Index = 0; Index < NumProjectiles; ++Index)
+		{
+			if (AActor* Proxy = VisualProxies[Index].Get())
+			{
+				Proxy->SetActorLocationAndRotation(Positions[Index], Velocities[Index].Rotation());
+			}
+		}
+	}
+
+	// 4. 处理命中：先复制出需要的数据，移除子弹后再应用伤害，
+	//    避免伤害回调中发射新子弹导致数组在遍历中被修改
+	struct FPendingImpact
+	{
+		FYcProjectileImpact Impact;
+		FHitResult Hit;
+		FVector Direction;
+		float Damage;
+		TWeakObjectPtr<AActor> Instigator;
+		TWeakObjectPtr<AController> InstigatorController;
+	};
+	TArray<FPendingImpact, TInlineAllocator<16>> Impacts;
+	Impacts.Reserve(PendingHits.Num());
+	for (TPair<int32, FHitResult>& PendingHit : PendingHits)
+	{
+		const int32 Index = PendingHit.Key;
+		FPendingImpact& Pending = Impacts.AddDefaulted_GetRef();
+		Pending.Impact.ProjectileId = ProjectileIds[Index];
+		Pending.Impact.ImpactPoint = PendingHit.Value.ImpactPoint;
+		Pending.Impact.ImpactNormal = PendingHit.Value.ImpactNormal;
+		Pending.Impact.HitActor = PendingHit.Value.GetActor();
+		Pending.Hit = MoveTemp(PendingHit.Value);
+		Pending.Direction = Velocities[Index].GetSafeNormal();
+		Pending.Damage = Damages[Index];
+		Pending.Instigator = Instigators[Index];
+		Pending.InstigatorController = InstigatorControllers[Index];
+	}
+
+	// 从后往前移除，RemoveAtSwap 换来的元素下标更大，已经处理过
+	for (int32 RemovalIndex = PendingRemovals.Num() - 1; RemovalIndex >= 0; --RemovalIndex)
+	{
+		RemoveProjectileAt(PendingRemovals[RemovalIndex]);
+	}
+
+	INC_DWORD_STAT_BY(STAT_YcProjectile_Impacts, Impacts.Num());
+	for (FPendingImpact& Pending : Impacts)
+	{
+		ApplyImpact(Pending.Impact, Pending.Hit, Pending.Damage, Pending.Direction,
+			Pending.Instigator.Get(), Pending.InstigatorController.Get());
+	}
+}
+
+void UYcProjectileSimulationSubsystem::ApplyImpact(FYcProjectileImpact& Impact, const FHitResult& Hit, float Damage,
+	const FVector& Direction, AActor* Instigator, AController* InstigatorController)
+{
+	// 与 AYcBulletProjectile 一致，使用通用伤害接口
+	if (AActor* HitActor = Impact.HitActor)
+	{
+		Impact.AppliedDamage = Damage;
+		UGameplayStatics::ApplyPointDamage(HitActor, Damage, Direction, Hit, InstigatorController, Instigator, nullptr);
+	}
+
+	OnProjectileImpact.Broadcast(Impact);
+
+	if (NetRelay.IsValid())
+	{
+		PendingImpactRecords.Add(Impact);
+	}
+}
+
+// ==================== SoA 数组管理 ====================
+
+int32 UYcProjectileSimulationSubsystem::AddProjectile(const FYcProjectileSpawnRecord& Record, float Damage, AController* InstigatorController)
+{
+	const int32 Index = ProjectileIds.Add(Record.ProjectileId);
+	Positions.Add(Record.Origin);
+	Velocities.Add(Record.Velocity);
+	MaxSpeeds.Add(Record.MaxSpeed > 0.0f ? Record.MaxSpeed : UE_BIG_NUMBER);
+	GravityScales.Add(Record.GravityScale);
+	RemainingLifeSpans.Add(Record.LifeSpan);
+	CollisionRadii.Add(Record.CollisionRadius);
+	Damages.Add(Damage);
+	Instigators.Add(Record.Instigator.Get());
+	InstigatorControllers.Add(InstigatorController);
+
+	AActor* Proxy = nullptr;
+	if (bSpawnVisualProxies && VisualProxyClass)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Proxy = GetWorld()->SpawnActor<AActor>(VisualProxyClass, Record.Origin, Record.Velocity.Rotation(), SpawnParams);
+		if (Proxy)
+		{
+			Proxy->SetActorEnableCollision(false);
+		}
+	}
+	VisualProxies.Add(Proxy);
+
+	IdToIndex.Add(Record.ProjectileId, Index);
+	return Index;
+}
+
+void UYcProjectileSimulationSubsystem::RemoveProjectileAt(int32 Index)
+{
+	if (AActor* Proxy = VisualProxies[Index].Get())
+	{
+		Proxy->Destroy();
+	}
+
+	IdToIndex.Remove(ProjectileIds[Index]);
+
+	ProjectileIds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MaxSpeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	GravityScales.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingLifeSpans.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CollisionRadii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Damages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Instigators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	InstigatorControllers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VisualProxies.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// 末尾元素被换到了 Index，更新它的映射
+	if (ProjectileIds.IsValidIndex(Index))
+	{
+		IdToIndex.Add(ProjectileIds[Index], Index);
+	}
+}
+
+void UYcProjectileSimulationSubsystem::RemoveProjectileById(int32 ProjectileId)
+{
+	if (const int32* Index = IdToIndex.Find(ProjectileId))
+	{
+		RemoveProjectileAt(*Index);
+	}
+}
+
+// ==================== 网络 ====================
+
+void UYcProjectileSimulationSubsystem::FlushNetRecords()
+{
+	AYcProjectileNetRelay* Relay = NetRelay.Get();
+	if (!Relay || (PendingSpawnRecords.IsEmpty() && PendingImpactRecords.IsEmpty()))
+	{
+		PendingSpawnRecords.Reset();
+		PendingImpactRecords.Reset();
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_YcProjectile_FlushNetRecords);
+
+	// 按批次拆分，单个 RPC 不超过 MaxRecordsPerRPC 条
+	TArray<FYcProjectileSpawnRecord> SpawnBatch;
+	for (int32 Start = 0; Start < PendingSpawnRecords.Num(); Start += AYcProjectileNetRelay::MaxRecordsPerRPC)
+	{
+		const int32 Count = FMath::Min(AYcProjectileNetRelay::MaxRecordsPerRPC, PendingSpawnRecords.Num() - Start);
+		SpawnBatch.Reset();
+		SpawnBatch.Append(PendingSpawnRecords.GetData() + Start, Count);
+		Relay->MulticastSpawnProjectiles(SpawnBatch);
+	}
+
+	TArray<FYcProjectileImpact> ImpactBatch;
+	for (int32 Start = 0; Start < PendingImpactRecords.Num(); Start += AYcProjectileNetRelay::MaxRecordsPerRPC)
+	{
+		const int32 Count = FMath::Min(AYcProjectileNetRelay::MaxRecordsPerRPC, PendingImpactRecords.Num() - Start);
+		ImpactBatch.Reset();
+		ImpactBatch.Append(PendingImpactRecords.GetData() + Start, Count);
+		Relay->MulticastProjectileImpacts(ImpactBatch);
+	}
+
+	PendingSpawnRecords.Reset();
+	PendingImpactRecords.Reset();
+}
+
+void UYcProjectileSimulationSubsystem::HandleReplicatedSpawns(TConstArrayView<FYcProjectileSpawnRecord> Records)
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const double ServerNow = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+	const float GravityZ = GetWorld()->GetGravityZ();
+
+	for (const FYcProjectileSpawnRecord& Record : Records)
+	{
+		// 已在模拟中，或命中已经先到达
+		if (IdToIndex.Contains(Record.ProjectileId) || RecentImpactExpireTimes.Remove(Record.ProjectileId) > 0)
+		{
+			continue;
+		}
+
+		const int32 Index = AddProjectile(Record, 0.0f, nullptr);
+
+		// 补偿网络延迟：按发射后经过的时间把子弹推到当前位置
+		const float Elapsed = FMath::Clamp(static_cast<float>(ServerNow - Record.SpawnServerTime), 0.0f, YcProjectileCVars::MaxLatencyCompensation);
+		if (Elapsed > 0.0f)
+		{
+			const FVector Gravity(0.0f, 0.0f, GravityZ * Record.GravityScale);
+			Positions[Index] += Velocities[Index] * Elapsed + 0.5f * Gravity * Elapsed * Elapsed;
+			Velocities[Index] += Gravity * Elapsed;
+			RemainingLifeSpans[Index] -= Elapsed;
+		}
+	}
+}
+
+void UYcProjectileSimulationSubsystem::HandleReplicatedImpacts(TConstArrayView<FYcProjectileImpact> Impacts)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (auto It = RecentImpactExpireTimes.CreateIterator(); It; ++It)
+	{
+		if (It.Value() <= Now)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const FYcProjectileImpact& Impact : Impacts)
+	{
+		if (const int32* Index = IdToIndex.Find(Impact.ProjectileId))
+		{
+			RemoveProjectileAt(*Index);
+		}
+		else
+		{
+			// 生成参数还没到（或已丢失），记住ID以丢弃迟到的生成参数
+			RecentImpactExpireTimes.Add(Impact.ProjectileId, Now + YcProjectileCVars::RecentImpactLifetime);
+		}
+		OnProjectileImpact.Broadcast(Impact);
+	}
+}
+
+// ==================== 性能测试 ====================
+
+void UYcProjectileSimulationSubsystem::RunBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	UYcProjectileSimulationSubsystem* Simulation = World ? World->GetSubsystem<UYcProjectileSimulationSubsystem>() : nullptr;
+	if (!Simulation || !Simulation->bHasAuthority)
+	{
+		UE_LOG(LogYcShooterCore, Warning, TEXT("Yc.Projectile.Benchmark 需要在服务端或单机的游戏世界中执行"));
+		return;
+	}
+
+	const int32 NumProjectiles = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+	const int32 NumFrames = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 120;
+	constexpr float FixedDeltaTime = 1.0f / 60.0f;
+
+	// 在关卡包围盒内生成，测量的积分、查询和命中移除开销与实际游戏一致
+	// 伤害为 0，不写入网络记录，也不生成表现代理
+	const TSubclassOf<AActor> SavedProxyClass = Simulation->VisualProxyClass;
+	Simulation->VisualProxyClass = nullptr;
+
+	FBox SpawnBounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+	if (!SpawnBounds.IsValid)
+	{
+		SpawnBounds = FBox(FVector(-5000.0f, -5000.0f, 0.0f), FVector(5000.0f, 5000.0f, 2000.0f));
+	}
+
+	FRandomStream Random(NumProjectiles);
+	TArray<int32> BenchmarkIds;
+	BenchmarkIds.Reserve(NumProjectiles);
+	for (int32 Index = 0; Index < NumProjectiles; ++Index)
+	{
+		FYcProjectileSpawnRecord Record;
+		Record.ProjectileId = Simulation->NextProjectileId;
+		Simulation->NextProjectileId = Simulation->NextProjectileId == MAX_int32 ? 0 : Simulation->NextProjectileId + 1;
+		Record.Origin = FVector(
+			Random.FRandRange(SpawnBounds.Min.X, SpawnBounds.Max.X),
+			Random.FRandRange(SpawnBounds.Min.Y, SpawnBounds.Max.Y),
+			Random.FRandRange(SpawnBounds.Min.Z, SpawnBounds.Max.Z));
+		Record.Velocity = Random.GetUnitVector() * 10000.0f;
+		Record.MaxSpeed = 15000.0f;
+		Record.GravityScale = 1.0f;
+		Record.LifeSpan = NumFrames * FixedDeltaTime + 1.0f;
+		Record.CollisionRadius = (Index & 1) ? 5.0f : 0.0f;
+
+		Simulation->AddProjectile(Record, 0.0f, nullptr);
+		BenchmarkIds.Add(Record.ProjectileId);
+	}
+
+	double TotalMs = 0.0;
+	double WorstMs = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		const double FrameStart = FPlatformTime::Seconds();
+		Simulation->Simulate(FixedDeltaTime);
+		const double FrameMs = (FPlatformTime::Seconds() - FrameStart) * 1000.0;
+		TotalMs += FrameMs;
+		WorstMs = FMath::Max(WorstMs, FrameMs);
+	}
+
+	int32 NumSurvived = 0;
+	for (const int32 ProjectileId : BenchmarkIds)
+	{
+		NumSurvived += Simulation->IdToIndex.Contains(ProjectileId) ? 1 : 0;
+		Simulation->RemoveProjectileById(ProjectileId);
+	}
+	Simulation->PendingImpactRecords.Reset();
+	Simulation->VisualProxyClass = SavedProxyClass;
+
+	const double AverageMs = TotalMs / NumFrames;
+	UE_LOG(LogYcShooterCore, Display,
+		TEXT("Yc.Projectile.Benchmark: %d 颗子弹 × %d 帧（命中移除 %d 颗），平均 %.3f ms/帧，最差 %.3f ms/帧，预算 %.3f ms -> %s"),
+		NumProjectiles, NumFrames, NumProjectiles - NumSurvived, AverageMs, WorstMs, YcProjectileCVars::FrameBudgetMs,
+		(YcProjectileCVars::FrameBudgetMs <= 0.0f || AverageMs <= YcProjectileCVars::FrameBudgetMs) ? TEXT("通过") : TEXT("超出预算"));
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Weapons/YcFireScheduler.h"
+
+#include "Weapons/Fragments/YcFragment_WeaponStats.h"
+
+void FYcFireScheduler::Start(double Now, double LastShotTime, EYcFireMode FireMode, double InShotInterval, int32 InBurstCount, double InBurstInterval)
+{
+	ShotInterval = FMath::Max(InShotInterval, UE_KINDA_SMALL_NUMBER);
+	BurstInterval = FMath::Max(InBurstInterval, UE_KINDA_SMALL_NUMBER);
+	ShotsInBurst = 0;
+	bHasFired = false;
+	bStopAfterBurst = false;
+	bActive = true;
+
+	switch (FireMode)
+	{
+	case EYcFireMode::Auto:
+		BurstCount = 0;
+		bRepeatBursts = false;
+		break;
+
+	case EYcFireMode::SemiAuto:
+		BurstCount = 1;
+		bRepeatBursts = false;
+		break;
+
+	case EYcFireMode::BurstAuto:
+		BurstCount = FMath::Max(1, InBurstCount);
+		bRepeatBursts = true;
+		break;
+
+	case EYcFireMode::BurstSingle:
+		BurstCount = FMath::Max(1, InBurstCount);
+		bRepeatBursts = false;
+		break;
+	}
+
+	// 遵守射速限制：距离上一发不足一个间隔时，等到间隔结束
+	NextShotTime = FMath::Max(Now, LastShotTime + ShotInterval);
+	LastEmittedShotTime = LastShotTime;
+}
+
+void FYcFireScheduler::Advance(double Now, int32 MaxShots, TArray<FYcScheduledShot, TInlineAllocator<8>>& OutShots)
+{
+	while (bActive && NextShotTime <= Now)
+	{
+		if (OutShots.Num() >= MaxShots)
+		{
+			// 单帧射击数量达到上限，丢弃积压的射击，从当前时间重新开始计时
+			NextShotTime = Now + ShotInterval;
+			break;
+		}
+
+		FYcScheduledShot& Shot = OutShots.AddDefaulted_GetRef();
+		Shot.Time = NextShotTime;
+		Shot.BurstShotIndex = ShotsInBurst;
+
+		LastEmittedShotTime = NextShotTime;
+		bHasFired = true;
+		++ShotsInBurst;
+
+		// 全自动：固定间隔累加
+		if (BurstCount == 0)
+		{
+			NextShotTime += ShotInterval;
+			continue;
+		}
+
+		// 当前轮未结束：继续本轮
+		if (ShotsInBurst < BurstCount)
+		{
+			NextShotTime += ShotInterval;
+			continue;
+		}
+
+		// 当前轮结束
+		ShotsInBurst = 0;
+		if (!bRepeatBursts || bStopAfterBurst)
+		{
+			bActive = false;
+			break;
+		}
+
+		NextShotTime += BurstInterval;
+	}
+}
+
+void FYcFireScheduler::RequestStopAfterBurst()
+{
+	bStopAfterBurst = true;
+
+	// 正处于两轮连射之间，没有需要完成的连射
+	// 尚未射出第一发时（等待射速冷却）仍然完成第一轮连射
+	if (bHasFired && ShotsInBurst == 0)
+	{
+		bActive = false;
+	}
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Weapons/YcFireScheduler.h"
+#include "YiChenShooterCore.h"
+#include "HAL/IConsoleManager.h"
+#include "Weapons/Fragments/YcFragment_WeaponStats.h"
+
+/**
+ * 射速稳定性测试（控制台命令）
+ *
+ * 以多个模拟帧间隔（含随机抖动的帧间隔）驱动 FYcFireScheduler，
+ * 统计每秒射出的子弹数，检查与配置的射速之间的误差不超过容差：
+ * - 全自动：每秒发数 = 1 / ShotInterval
+ * - 连射(按住自动)：每秒发数 = BurstCount / ((BurstCount - 1) * ShotInterval + BurstInterval)
+ * 同时检查相邻两发的亚帧时间间隔与配置一致，不受帧间隔影响。
+ */
+struct FYcFireSchedulerTest
+{
+	struct FRunResult
+	{
+		int32 NumShots = 0;
+		double MaxSpacingError = 0.0;
+	};
+
+	/** 模拟以 FrameDelta 为帧间隔（JitterAlpha 为随机抖动比例）开火 Duration 秒 */
+	static FRunResult Simulate(EYcFireMode FireMode, double ShotInterval, int32 BurstCount, double BurstInterval,
+		double FrameDelta, float JitterAlpha, double Duration, int32 MaxShotsPerFrame)
+	{
+		FYcFireScheduler Scheduler;
+		Scheduler.Start(0.0, -1000.0, FireMode, ShotInterval, BurstCount, BurstInterval);
+
+		FRandomStream Random(FMath::FloorToInt(FrameDelta * 100000.0));
+		FRunResult Result;
+		double LastShotTime = 0.0;
+		double Now = 0.0;
+
+		TArray<FYcScheduledShot, TInlineAllocator<8>> DueShots;
+		while (Scheduler.IsActive())
+		{
+			DueShots.Reset();
+			Scheduler.Advance(Now, MaxShotsPerFrame, DueShots);
+
+			for (const FYcScheduledShot& Shot : DueShots)
+			{
+				// 同一轮内的相邻两发间隔必须为 ShotInterval
+				if (Result.NumShots > 0 && Shot.BurstShotIndex > 0)
+				{
+					Result.MaxSpacingError = FMath::Max(Result.MaxSpacingError, FMath::Abs((Shot.Time - LastShotTime) - ShotInterval));
+				}
+				LastShotTime = Shot.Time;
+				++Result.NumShots;
+			}
+
+			if (Now >= Duration)
+			{
+				break;
+			}
+
+			const double Jitter = JitterAlpha > 0.0f ? Random.FRandRange(-JitterAlpha, JitterAlpha) : 0.0f;
+			Now = FMath::Min(Now + FrameDelta * (1.0 + Jitter), Duration);
+		}
+
+		return Result;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		const float RoundsPerMinute = Args.Num() > 0 ? FMath::Max(1.0f, FCString::Atof(*Args[0])) : 900.0f;
+		const double Duration = Args.Num() > 1 ? FMath::Max(1.0f, FCString::Atof(*Args[1])) : 30.0;
+		const float TolerancePercent = Args.Num() > 2 ? FMath::Max(0.01f, FCString::Atof(*Args[2])) : 1.0f;
+
+		const double ShotInterval = 60.0 / RoundsPerMinute;
+		const int32 BurstCount = 3;
+		const double BurstInterval = ShotInterval * 3.0;
+
+		const IConsoleVariable* MaxShotsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Yc.Weapon.MaxShotsPerFrame"));
+		const int32 MaxShotsPerFrame = FMath::Max(1, MaxShotsCVar ? MaxShotsCVar->GetInt() : 8);
+
+		struct FFrameCase
+		{
+			double FrameDelta;
+			float JitterAlpha;
+		};
+		const FFrameCase FrameCases[] = {
+			{ 1.0 / 144.0, 0.0f },
+			{ 1.0 / 60.0, 0.0f },
+			{ 1.0 / 30.0, 0.0f },
+			{ 1.0 / 20.0, 0.0f },
+			{ 1.0 / 10.0, 0.0f },
+			{ 1.0 / 30.0, 0.5f },
+		};
+
+		struct FModeCase
+		{
+			const TCHAR* Name;
+			EYcFireMode FireMode;
+			double ExpectedShotsPerSecond;
+		};
+		const FModeCase ModeCases[] = {
+			{ TEXT("全自动"), EYcFireMode::Auto, 1.0 / ShotInterval },
+			{ TEXT("连射"), EYcFireMode::BurstAuto, BurstCount / ((BurstCount - 1) * ShotInterval + BurstInterval) },
+		};
+
+		int32 NumErrors = 0;
+		for (const FModeCase& Mode : ModeCases)
+		{
+			for (const FFrameCase& Frame : FrameCases)
+			{
+				const FRunResult Result = Simulate(Mode.FireMode, ShotInterval, BurstCount, BurstInterval,
+					Frame.FrameDelta, Frame.JitterAlpha, Duration, MaxShotsPerFrame);
+
+				// 计时从 0 开始且首发立即射出，统计窗口内的发数比区间数多一发
+				const double ShotsPerSecond = FMath::Max(0, Result.NumShots - 1) / Duration;
+				const double ErrorPercent = FMath::Abs(ShotsPerSecond - Mode.ExpectedShotsPerSecond) / Mode.ExpectedShotsPerSecond * 100.0;
+				const bool bPassed = ErrorPercent <= TolerancePercent && Result.MaxSpacingError < 1.0e-6;
+				if (!bPassed)
+				{
+					++NumErrors;
+				}
+
+				UE_LOG(LogYcShooterCore, Display, TEXT("  %s %6.1f Hz%s: %d 发, %.2f 发/秒 (期望 %.2f, 误差 %.2f%%, 最大间隔误差 %.2e 秒)%s"),
+					Mode.Name, 1.0 / Frame.FrameDelta, Frame.JitterAlpha > 0.0f ? TEXT(" (抖动)") : TEXT(""),
+					Result.NumShots, ShotsPerSecond, Mode.ExpectedShotsPerSecond, ErrorPercent, Result.MaxSpacingError,
+					bPassed ? TEXT("") : TEXT(" <- 超出容差"));
+			}
+		}
+
+		UE_LOG(LogYcShooterCore, Display, TEXT("Yc.Weapon.TestFireRate: %s (射速 %.0f RPM, 模拟 %.1f 秒, 容差 %.2f%%, 单帧最多 %d 发, 错误 %d)"),
+			NumErrors == 0 ? TEXT("PASSED") : TEXT("FAILED"), RoundsPerMinute, Duration, TolerancePercent, MaxShotsPerFrame, NumErrors);
+	}
+};
+
+namespace YcFireSchedulerTest
+{
+	static FAutoConsoleCommandWithWorldAndArgs CmdTestFireRate(
+		TEXT("Yc.Weapon.TestFireRate"),
+		TEXT("以多种帧间隔驱动射击调度器，检查每秒发数与配置射速的误差：Yc.Weapon.TestFireRate [射速RPM=900] [模拟秒数=30] [容差百分比=1]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FYcFireSchedulerTest::Run));
+}
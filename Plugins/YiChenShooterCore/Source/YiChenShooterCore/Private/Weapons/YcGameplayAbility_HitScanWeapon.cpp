@@ -12,6 +12,10 @@
 #include "Weapons/YcHitScanWeaponInstance.h"
 #include "Weapons/YcWeaponStateComponent.h"
 #include "Weapons/Fragments/YcFragment_WeaponStats.h"
+#include "Weapons/LagCompensation/YcLagCompensationSubsystem.h"
+#include "AbilitySystem/Tasks/YcAbilityTask_WaitTick.h"
+#include "Async/ParallelFor.h"
+#include "EngineUtils.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcGameplayAbility_HitScanWeapon)
 
@@ -42,12 +46,71 @@ namespace YcConsoleVariables
 		DrawBulletHitRadius,
 		TEXT("当启用子弹命中调试绘制时，命中点球体的半径（单位：uu）"),
 		ECVF_Default);
+
+	// 单帧最多射出的子弹数量，防止长时间卡顿后一帧内射出整个弹匣
+	static int32 MaxShotsPerFrame = 8;
+	static FAutoConsoleVariableRef CVarMaxShotsPerFrame(
+		TEXT("Yc.Weapon.MaxShotsPerFrame"),
+		MaxShotsPerFrame,
+		TEXT("射击调度器单帧最多射出的子弹数量，超出的射击会被丢弃"),
+		ECVF_Default);
+
+	// 是否并行执行同一发子弹中多颗弹丸的射线检测
+	static bool bParallelPelletTraces = true;
+	static FAutoConsoleVariableRef CVarParallelPelletTraces(
+		TEXT("Yc.Weapon.ParallelPelletTraces"),
+		bParallelPelletTraces,
+		TEXT("是否并行执行同一发子弹中多颗弹丸（霰弹枪）的射线检测"),
+		ECVF_Default);
+
+	// 弹丸数量达到此值时才并行检测，数量太少时任务分发的开销大于收益
+	static int32 ParallelPelletTraceThreshold = 4;
+	static FAutoConsoleVariableRef CVarParallelPelletTraceThreshold(
+		TEXT("Yc.Weapon.ParallelPelletTraceThreshold"),
+		ParallelPelletTraceThreshold,
+		TEXT("单发子弹的弹丸数量达到此值时才并行执行射线检测"),
+		ECVF_Default);
 }
 
+// ==================== 性能统计 ====================
+DECLARE_STATS_GROUP(TEXT("YcWeaponTrace"), STATGROUP_YcWeaponTrace, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("TraceBulletsInCartridge"), STAT_YcWeaponTrace_Cartridge, STATGROUP_YcWeaponTrace);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pellets Traced"), STAT_YcWeaponTrace_Pellets, STATGROUP_YcWeaponTrace);
+
 
 // 武器射击阻止标签 - 如果玩家拥有此标签，武器射击将被阻止/取消
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_WeaponFireBlocked, "Ability.Weapon.NoFiring");
 
+/**
+ * 获取目标数据条目的项目扩展类型，类型不匹配时返回 nullptr
+ */
+static const FYcGameplayAbilityTargetData_SingleTargetHit* GetYcSingleTargetHit(const FGameplayAbilityTargetDataHandle& TargetData, int32 Index)
+{
+	const FGameplayAbilityTargetData* Data = TargetData.Get(Index);
+	if (Data == nullptr || !Data->GetScriptStruct()->IsChildOf(FYcGameplayAbilityTargetData_SingleTargetHit::StaticStruct()))
+	{
+		return nullptr;
+	}
+	return static_cast<const FYcGameplayAbilityTargetData_SingleTargetHit*>(Data);
+}
+
+/**
+ * 按条件过滤目标数据，只保留 ShouldKeep 返回 true 的条目
+ */
+static void FilterTargetData(FGameplayAbilityTargetDataHandle& TargetData, TFunctionRef<bool(int32 Index)> ShouldKeep)
+{
+	FGameplayAbilityTargetDataHandle Filtered;
+	Filtered.UniqueId = TargetData.UniqueId;
+	for (int32 i = 0; i < TargetData.Num(); ++i)
+	{
+		if (ShouldKeep(i))
+		{
+			Filtered.Data.Add(TargetData.Data[i]);
+		}
+	}
+	TargetData = MoveTemp(Filtered);
+}
+
 /**
  * 基于正态分布的锥形随机方向生成函数
  * 用于计算子弹在扩散范围内的随机偏移方向
@@ -197,6 +260,12 @@ void UYcGameplayAbility_HitScanWeapon::EndAbility(const FGameplayAbilitySpecHand
 		MyAbilityComponent->AbilityTargetDataSetDelegate(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey()).Remove(OnTargetDataReadyCallbackDelegateHandle);
 		MyAbilityComponent->ConsumeClientReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey());
 
+		// 3. 重置射击状态（射击 Task 会随技能结束自动销毁）
+		FireScheduler.Stop();
+		FireTickTask = nullptr;
+		bIsFiring = false;
+		bPendingEndAbility = false;
+
 		Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
 	}
 }
@@ -205,6 +274,13 @@ void UYcGameplayAbility_HitScanWeapon::EndAbility(const FGameplayAbilitySpecHand
 // ==================== 射击瞄准入口 ====================
 
 void UYcGameplayAbility_HitScanWeapon::StartHitScanWeaponTargeting(bool bIsAiming, bool bIsCrouching)
+{
+	// 单发射击：以当前时间作为射击时间
+	const double Now = GetWorld()->GetTimeSeconds();
+	StartHitScanWeaponTargetingBatch(MakeArrayView(&Now, 1), bIsAiming, bIsCrouching);
+}
+
+void UYcGameplayAbility_HitScanWeapon::StartHitScanWeaponTargetingBatch(TConstArrayView<double> ShotTimes, bool bIsAiming, bool bIsCrouching)
 {
 	check(CurrentActorInfo);
 
@@ -227,20 +303,28 @@ void UYcGameplayAbility_HitScanWeapon::StartHitScanWeaponTargeting(bool bIsAimin
 	// 这允许客户端在等待服务器确认之前预测性地执行操作
 	FScopedPredictionWindow ScopedPrediction(MyAbilityComponent, CurrentActivationInfo.GetActivationPredictionKey());
 
-	TArray<FHitResult> FoundHits;
-	// 在本地执行射线检测
-	PerformLocalTargeting(/*out*/ FoundHits, bIsAiming);
-
 	// 将命中结果转换为TargetData
 	FGameplayAbilityTargetDataHandle TargetData;
 	// UniqueId用于服务器确认命中标记
 	TargetData.UniqueId = WeaponStateComponent ? WeaponStateComponent->GetUnconfirmedServerSideHitMarkerCount() : 0;
 
-	if (FoundHits.Num() > 0)
+	// 为这批射击生成唯一的弹药ID，每发子弹的ID依次递增
+	// 同一发子弹的所有弹丸共享相同的CartridgeID
+	const int32 BaseCartridgeID = FMath::Rand();
+
+	TArray<FHitResult> AllHits;
+	FVector2D BatchRecoil = FVector2D::ZeroVector;
+
+	for (int32 ShotIndex = 0; ShotIndex < ShotTimes.Num(); ++ShotIndex)
 	{
-		// 为这次射击生成唯一的弹药ID
-		// 同一次射击的所有弹丸共享相同的CartridgeID
-		const int32 CartridgeID = FMath::Rand();
+		TArray<FHitResult> FoundHits;
+		LastShotRecoil = FVector2D::ZeroVector;
+
+		// 在本地执行射线检测
+		PerformLocalTargeting(/*out*/ FoundHits, bIsAiming);
+		BatchRecoil += LastShotRecoil;
+
+		const int32 CartridgeID = BaseCartridgeID + ShotIndex;
 
 		for (const FHitResult& FoundHit : FoundHits)
 		{
@@ -251,14 +335,19 @@ void UYcGameplayAbility_HitScanWeapon::StartHitScanWeaponTargeting(bool bIsAimin
 
 			TargetData.Add(NewTargetData);
 		}
+
+		AllHits.Append(FoundHits);
 	}
 
+	// 同一帧内的多发子弹后坐力累加，由蓝图统一应用
+	LastShotRecoil = BatchRecoil;
+
 	// 发送命中标记信息到武器状态组件
 	// 用于在UI上显示命中反馈（等待服务器确认）
 	const bool bProjectileWeapon = false;
 	if (!bProjectileWeapon && (WeaponStateComponent != nullptr))
 	{
-		WeaponStateComponent->AddUnconfirmedServerSideHitMarkers(TargetData, FoundHits);
+		WeaponStateComponent->AddUnconfirmedServerSideHitMarkers(TargetData, AllHits);
 	}
 
 	// 立即处理目标数据（触发回调）
@@ -315,16 +404,209 @@ void UYcGameplayAbility_HitScanWeapon::PerformLocalTargeting(TArray<FHitResult>&
 }
 
 
-// ==================== 弹丸射线检测 ====================
+// ==================== 弹丸批量射线检测 ====================
+
+/**
+ * 单颗弹丸的检测数据
+ * 同一发子弹的所有弹丸先统一生成方向，再批量执行检测，最后在游戏线程按弹丸顺序汇总结果
+ */
+struct FYcPelletTrace
+{
+	FVector EndTrace = FVector::ZeroVector;
+
+	/** 物理查询的原始结果，工作线程只写入这里，不解析命中的 Actor */
+	TArray<FHitResult> QueryHits;
+
+	/** 第一阶段：线性检测结果 */
+	TArray<FHitResult> Hits;
+
+	/** 第二阶段：球形扫描结果 */
+	TArray<FHitResult> SweepHits;
+
+	/** 本颗弹丸的最终命中 */
+	FHitResult Impact;
+
+	/** 线性检测没有命中 Pawn，需要球形扫描 */
+	bool bNeedsSweep = false;
+};
+
+/**
+ * 底层物理查询，使用预先构建好的查询参数
+ * 只执行物理查询，不访问 UObject 状态，可以在工作线程中执行
+ */
+static void YcWeaponQuery(const UWorld* World, const FVector& StartTrace, const FVector& EndTrace, float SweepRadius,
+	const FCollisionQueryParams& TraceParams, ECollisionChannel TraceChannel, TArray<FHitResult>& OutQueryHits)
+{
+	// 根据SweepRadius决定检测方式
+	if (SweepRadius > 0.0f)
+	{
+		// 球形扫描检测：使用指定半径的球体进行扫描
+		// 可以命中在球体半径范围内的目标（子弹吸附效果）
+		World->SweepMultiByChannel(OutQueryHits, StartTrace, EndTrace, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(SweepRadius), TraceParams);
+	}
+	else
+	{
+		// 线性射线检测：精确的直线检测
+		World->LineTraceMultiByChannel(OutQueryHits, StartTrace, EndTrace, TraceChannel, TraceParams);
+	}
+}
+
+/**
+ * 整理物理查询结果，需要比较命中对象，只能在游戏线程执行
+ * @return 最后一个命中结果，没有命中时返回只记录了起点和终点的结果
+ */
+static FHitResult YcCollectWeaponHits(const FVector& StartTrace, const FVector& EndTrace, const TArray<FHitResult>& QueryHits,
+	TArray<FHitResult>& OutHitResults)
+{
+	FHitResult Hit(ForceInit);
+	if (QueryHits.Num() > 0)
+	{
+		// 过滤输出列表，防止对同一Actor多次命中
+		// 这是为了防止单颗子弹对同一目标造成多次伤害
+		// （使用重叠检测时可能会对同一Actor产生多个命中结果）
+		for (const FHitResult& CurHitResult : QueryHits)
+		{
+			// 检查当前命中的Actor是否已经在输出列表中
+			auto Pred = [&CurHitResult](const FHitResult& Other)
+			{
+				return Other.HitObjectHandle == CurHitResult.HitObjectHandle;
+			};
+
+			// 只添加未重复的命中结果
+			if (!OutHitResults.ContainsByPredicate(Pred))
+			{
+				OutHitResults.Add(CurHitResult);
+			}
+		}
+
+		// 返回最后一个命中结果
+		Hit = OutHitResults.Last();
+	}
+	else
+	{
+		// 没有命中任何目标，记录射线的起点和终点
+		Hit.TraceStart = StartTrace;
+		Hit.TraceEnd = EndTrace;
+	}
+
+	return Hit;
+}
+
+/** 底层射线检测：物理查询 + 整理结果（游戏线程） */
+static FHitResult YcWeaponTrace(const UWorld* World, const FVector& StartTrace, const FVector& EndTrace, float SweepRadius,
+	const FCollisionQueryParams& TraceParams, ECollisionChannel TraceChannel, TArray<FHitResult>& OutHitResults)
+{
+	TArray<FHitResult> QueryHits;
+	YcWeaponQuery(World, StartTrace, EndTrace, SweepRadius, TraceParams, TraceChannel, QueryHits);
+	return YcCollectWeaponHits(StartTrace, EndTrace, QueryHits, OutHitResults);
+}
+
+/**
+ * 球形扫描命中 Pawn 时，判断是否采用扫描结果
+ *
+ * 如果在SweepHits中命中Pawn之前存在阻挡物，且该阻挡物也存在于LineHits中，
+ * 则说明Pawn被遮挡了，应该使用原始的线性检测结果。
+ * 
+ * 示例场景：
+ * 1. Pawn在墙后：线性检测命中墙，球形扫描"穿墙"命中Pawn
+ *    -> 因为墙同时存在于两个结果中，所以使用线性检测结果（Pawn被遮挡）
+ * 
+ * 2. Pawn站在墙边缘：线性检测命中墙，球形扫描命中墙边的Pawn
+ *    -> 如果墙不在Pawn之前，则可以命中Pawn（子弹吸附效果）
+ */
+static void YcResolveSweepFallback(TArray<FHitResult>& LineHits, const TArray<FHitResult>& SweepHits, int32 FirstPawnIdx)
+{
+	for (int32 Idx = 0; Idx < FirstPawnIdx; ++Idx)
+	{
+		const FHitResult& CurHitResult = SweepHits[Idx];
+
+		// 检查当前命中物是否也存在于线性检测结果中
+		auto Pred = [&CurHitResult](const FHitResult& Other)
+		{
+			return Other.HitObjectHandle == CurHitResult.HitObjectHandle;
+		};
+		
+		// 如果是阻挡命中且存在于线性检测结果中，则不使用球形扫描结果
+		if (CurHitResult.bBlockingHit && LineHits.ContainsByPredicate(Pred))
+		{
+			return;
+		}
+	}
+
+	LineHits = SweepHits;
+}
+
+/**
+ * 批量执行一发子弹中所有弹丸的两阶段检测
+ * 1. 所有弹丸的线性检测
+ * 2. 线性检测未命中 Pawn 的弹丸统一进行球形扫描，并在游戏线程一次性处理遮挡判断
+ * 两个阶段内的物理查询互不依赖，弹丸数量达到阈值时并行执行；
+ * 解析命中的 Actor/Pawn 需要访问 UObject，每个阶段的查询结束后在游戏线程串行处理
+ */
+static void YcTracePelletBatch(const UWorld* World, const FVector& StartTrace, TArrayView<FYcPelletTrace> Pellets, float SweepRadius,
+	const FCollisionQueryParams& TraceParams, ECollisionChannel TraceChannel, bool bParallel)
+{
+	check(IsInGameThread());
+
+	// 第一阶段：精确线性射线检测（工作线程只做物理查询）
+	ParallelFor(Pellets.Num(), [&](int32 PelletIndex)
+	{
+		FYcPelletTrace& Pellet = Pellets[PelletIndex];
+		Pellet.QueryHits.Reset();
+		YcWeaponQuery(World, StartTrace, Pellet.EndTrace, /*SweepRadius=*/ 0.0f, TraceParams, TraceChannel, Pellet.QueryHits);
+	}, !bParallel);
+
+	// 游戏线程整理结果并收集需要球形扫描的弹丸
+	TArray<int32, TInlineAllocator<16>> SweepIndices;
+	for (int32 PelletIndex = 0; PelletIndex < Pellets.Num(); ++PelletIndex)
+	{
+		FYcPelletTrace& Pellet = Pellets[PelletIndex];
+		Pellet.Impact = YcCollectWeaponHits(StartTrace, Pellet.EndTrace, Pellet.QueryHits, Pellet.Hits);
+		Pellet.bNeedsSweep = SweepRadius > 0.0f && UYcGameplayAbility_HitScanWeapon::FindFirstPawnHitResult(Pellet.Hits) == INDEX_NONE;
+		if (Pellet.bNeedsSweep)
+		{
+			SweepIndices.Add(PelletIndex);
+		}
+	}
+
+	if (SweepIndices.IsEmpty())
+	{
+		return;
+	}
+
+	// 第二阶段：需要球形扫描的弹丸一次性执行
+	ParallelFor(SweepIndices.Num(), [&](int32 SweepIndex)
+	{
+		FYcPelletTrace& Pellet = Pellets[SweepIndices[SweepIndex]];
+		Pellet.QueryHits.Reset();
+		YcWeaponQuery(World, StartTrace, Pellet.EndTrace, SweepRadius, TraceParams, TraceChannel, Pellet.QueryHits);
+	}, !bParallel || SweepIndices.Num() < YcConsoleVariables::ParallelPelletTraceThreshold);
+
+	for (const int32 PelletIndex : SweepIndices)
+	{
+		FYcPelletTrace& Pellet = Pellets[PelletIndex];
+		Pellet.Impact = YcCollectWeaponHits(StartTrace, Pellet.EndTrace, Pellet.QueryHits, Pellet.SweepHits);
+
+		// 检查球形扫描是否命中了Pawn
+		const int32 FirstPawnIdx = UYcGameplayAbility_HitScanWeapon::FindFirstPawnHitResult(Pellet.SweepHits);
+		if (Pellet.SweepHits.IsValidIndex(FirstPawnIdx))
+		{
+			YcResolveSweepFallback(Pellet.Hits, Pellet.SweepHits, FirstPawnIdx);
+		}
+	}
+}
 
 void UYcGameplayAbility_HitScanWeapon::TraceBulletsInCartridge(const FHitScanWeaponFiringInput& InputData,
                                                               TArray<FHitResult>& OutHits)
 {
+	SCOPE_CYCLE_COUNTER(STAT_YcWeaponTrace_Cartridge);
+
 	UYcHitScanWeaponInstance* WeaponData = InputData.WeaponData;
 	check(WeaponData);
 	
 	// 获取单发子弹产生的弹丸数量（普通武器为1，霰弹枪可能为8-12）
 	const int32 BulletsPerCartridge = WeaponData->GetBulletsPerCartridge();
+	INC_DWORD_STAT_BY(STAT_YcWeaponTrace_Pellets, BulletsPerCartridge);
 
 	// 获取当前扩散参数
 	// 瞄准时使用ADS扩散（通常为0），腰射时使用HipFire扩散
@@ -338,26 +620,43 @@ void UYcGameplayAbility_HitScanWeapon::TraceBulletsInCartridge(const FHitScanWea
 	{
 		ActualSpreadAngle = BaseSpreadAngle * SpreadMultiplier;
 	}
+
+	// 将扩散角度转换为弧度（半角）
+	const float HalfSpreadAngleInRadians = FMath::DegreesToRadians(ActualSpreadAngle * 0.5f);
 	
-	// 为每颗弹丸执行射线检测
-	for (int32 BulletIndex = 0; BulletIndex < BulletsPerCartridge; ++BulletIndex)
+	// 为每颗弹丸生成方向（随机数不是线程安全的，在游戏线程统一生成）
+	TArray<FYcPelletTrace, TInlineAllocator<12>> Pellets;
+	Pellets.SetNum(BulletsPerCartridge);
+	for (FYcPelletTrace& Pellet : Pellets)
 	{
-		// 将扩散角度转换为弧度（半角）
-		const float HalfSpreadAngleInRadians = FMath::DegreesToRadians(ActualSpreadAngle * 0.5f);
-
 		// 使用正态分布在扩散锥内生成随机方向
 		// SpreadExponent控制分布密度，值越大弹着点越集中于中心
 		const FVector BulletDir = VRandConeNormalDistribution(InputData.AimDir, HalfSpreadAngleInRadians, WeaponData->GetSpreadExponent());
 
 		// 计算这颗弹丸的射线终点
-		const FVector EndTrace = InputData.StartTrace + (BulletDir * WeaponData->GetMaxDamageRange());
-		FVector HitLocation = EndTrace;
+		Pellet.EndTrace = InputData.StartTrace + (BulletDir * WeaponData->GetMaxDamageRange());
+	}
 
-		TArray<FHitResult> AllImpacts;
+	// 查询参数和忽略列表每发子弹只构建一次，所有弹丸共用
+	FCollisionQueryParams TraceParams;
+	const ECollisionChannel TraceChannel = BuildWeaponTraceParams(/*bIsSimulated=*/ false, TraceParams);
 
-		// 执行单条射线检测
-		FHitResult Impact = DoSingleBulletTrace(InputData.StartTrace, EndTrace, WeaponData->GetBulletTraceSweepRadius(), /*bIsSimulated=*/ false, /*out*/ AllImpacts);
+	const bool bParallel = YcConsoleVariables::bParallelPelletTraces && BulletsPerCartridge >= YcConsoleVariables::ParallelPelletTraceThreshold;
+	YcTracePelletBatch(GetWorld(), InputData.StartTrace, Pellets, WeaponData->GetBulletTraceSweepRadius(), TraceParams, TraceChannel, bParallel);
 
+	// 按弹丸顺序汇总结果
+	for (FYcPelletTrace& Pellet : Pellets)
+	{
+		// 调试绘制：显示射线轨迹
+#if ENABLE_DRAW_DEBUG
+		if (YcConsoleVariables::DrawBulletTracesDuration > 0.0f)
+		{
+			static float DebugThickness = 1.0f;
+			DrawDebugLine(GetWorld(), InputData.StartTrace, Pellet.EndTrace, FColor::Green, false, YcConsoleVariables::DrawBulletTracesDuration, 0, DebugThickness);
+		}
+#endif // ENABLE_DRAW_DEBUG
+
+		FHitResult& Impact = Pellet.Impact;
 		const AActor* HitActor = Impact.GetActor();
 
 		if (HitActor)
@@ -371,12 +670,10 @@ void UYcGameplayAbility_HitScanWeapon::TraceBulletsInCartridge(const FHitScanWea
 #endif
 
 			// 将所有命中结果添加到输出列表
-			if (AllImpacts.Num() > 0)
+			if (Pellet.Hits.Num() > 0)
 			{
-				OutHits.Append(AllImpacts);
+				OutHits.Append(Pellet.Hits);
 			}
-
-			HitLocation = Impact.ImpactPoint;
 		}
 
 		// 确保OutHits中至少有一个条目
@@ -386,8 +683,8 @@ void UYcGameplayAbility_HitScanWeapon::TraceBulletsInCartridge(const FHitScanWea
 			if (!Impact.bBlockingHit)
 			{
 				// 将"假命中"位置设置为射线终点
-				Impact.Location = EndTrace;
-				Impact.ImpactPoint = EndTrace;
+				Impact.Location = Pellet.EndTrace;
+				Impact.ImpactPoint = Pellet.EndTrace;
 			}
 
 			OutHits.Add(Impact);
@@ -410,8 +707,6 @@ FHitResult UYcGameplayAbility_HitScanWeapon::DoSingleBulletTrace(const FVector&
 	}
 #endif // ENABLE_DRAW_DEBUG
 	
-	FHitResult Impact;
-	
 	/**
 	 * 两阶段射线检测策略：
 	 * 1. 首先进行精确的线性射线检测（SweepRadius=0）
@@ -420,134 +715,52 @@ FHitResult UYcGameplayAbility_HitScanWeapon::DoSingleBulletTrace(const FVector&
 	 * 这种策略的优点：
 	 * - 优先使用精确检测，保证命中判定的准确性
 	 * - 球形扫描作为后备，提供"子弹吸附"效果，改善射击手感
+	 *
+	 * 与弹丸批量检测共用同一实现，单条检测即只有一颗弹丸的批次
 	 */
-	
-	// 第一阶段：精确线性射线检测
-	if (FindFirstPawnHitResult(OutHits) == INDEX_NONE)
+
+	// 传入的结果中已经命中了 Pawn，不需要再检测
+	if (FindFirstPawnHitResult(OutHits) != INDEX_NONE)
 	{
-		Impact = WeaponTrace(StartTrace, EndTrace, /*SweepRadius=*/ 0.0f, bIsSimulated, /*out*/ OutHits);
+		return FHitResult();
 	}
-	
-	// 第二阶段：如果第一阶段未命中Pawn且支持球形扫描，则进行扫描检测
-	if (FindFirstPawnHitResult(OutHits) == INDEX_NONE)
-	{
-		if (SweepRadius > 0.0f)
-		{
-			TArray<FHitResult> SweepHits;
-			Impact = WeaponTrace(StartTrace, EndTrace, SweepRadius, bIsSimulated, /*out*/ SweepHits);
 
-			// 检查球形扫描是否命中了Pawn
-			const int32 FirstPawnIdx = FindFirstPawnHitResult(SweepHits);
-			if (SweepHits.IsValidIndex(FirstPawnIdx))
-			{
-				/**
-				 * 重要的遮挡判断逻辑：
-				 * 
-				 * 如果在SweepHits中命中Pawn之前存在阻挡物，且该阻挡物也存在于OutHits中，
-				 * 则说明Pawn被遮挡了，应该使用原始的线性检测结果。
-				 * 
-				 * 示例场景：
-				 * 1. Pawn在墙后：线性检测命中墙，球形扫描"穿墙"命中Pawn
-				 *    -> 因为墙同时存在于两个结果中，所以使用线性检测结果（Pawn被遮挡）
-				 * 
-				 * 2. Pawn站在墙边缘：线性检测命中墙，球形扫描命中墙边的Pawn
-				 *    -> 如果墙不在Pawn之前，则可以命中Pawn（子弹吸附效果）
-				 */
-				bool bUseSweepHits = true;
-				for (int32 Idx = 0; Idx < FirstPawnIdx; ++Idx)
-				{
-					const FHitResult& CurHitResult = SweepHits[Idx];
+	FCollisionQueryParams TraceParams;
+	const ECollisionChannel TraceChannel = BuildWeaponTraceParams(bIsSimulated, TraceParams);
 
-					// 检查当前命中物是否也存在于线性检测结果中
-					auto Pred = [&CurHitResult](const FHitResult& Other)
-					{
-						return Other.HitObjectHandle == CurHitResult.HitObjectHandle;
-					};
-					
-					// 如果是阻挡命中且存在于线性检测结果中，则不使用球形扫描结果
-					if (CurHitResult.bBlockingHit && OutHits.ContainsByPredicate(Pred))
-					{
-						bUseSweepHits = false;
-						break;
-					}
-				}
-
-				if (bUseSweepHits)
-				{
-					OutHits = SweepHits;
-				}
-			}
-		}
-	}
+	FYcPelletTrace Pellet;
+	Pellet.EndTrace = EndTrace;
+	Pellet.Hits = MoveTemp(OutHits);
+	YcTracePelletBatch(GetWorld(), StartTrace, MakeArrayView(&Pellet, 1), SweepRadius, TraceParams, TraceChannel, /*bParallel=*/ false);
 
-	return Impact;
+	OutHits = MoveTemp(Pellet.Hits);
+	return Pellet.Impact;
 }
 
 
 // ==================== 底层射线检测实现 ====================
 
-FHitResult UYcGameplayAbility_HitScanWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace,
-                                                        float SweepRadius, bool bIsSimulated, TArray<FHitResult>& OutHitResults) const
+ECollisionChannel UYcGameplayAbility_HitScanWeapon::BuildWeaponTraceParams(bool bIsSimulated, FCollisionQueryParams& OutTraceParams) const
 {
-	TArray<FHitResult> HitResults;
-	
 	// 配置碰撞查询参数
-	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace), /*bTraceComplex=*/ true, /*IgnoreActor=*/ GetAvatarActorFromActorInfo());
-	TraceParams.bReturnPhysicalMaterial = true;  // 返回物理材质信息（用于判断命中部位、播放对应特效等）
-	AddAdditionalTraceIgnoreActors(TraceParams);  // 添加额外的忽略Actor
+	OutTraceParams = FCollisionQueryParams(SCENE_QUERY_STAT(WeaponTrace), /*bTraceComplex=*/ true, /*IgnoreActor=*/ GetAvatarActorFromActorInfo());
+	OutTraceParams.bReturnPhysicalMaterial = true;  // 返回物理材质信息（用于判断命中部位、播放对应特效等）
+	AddAdditionalTraceIgnoreActors(OutTraceParams);  // 添加额外的忽略Actor
 	
 #if !(UE_BUILD_TEST || UE_BUILD_SHIPPING)
-	TraceParams.bDebugQuery = bDebugQuery;  // 调试模式下启用查询调试
+	OutTraceParams.bDebugQuery = bDebugQuery;  // 调试模式下启用查询调试
 #endif
 	
 	// 获取射线检测使用的碰撞通道
-	const ECollisionChannel TraceChannel = DetermineTraceChannel(TraceParams, bIsSimulated);
-	
-	// 根据SweepRadius决定检测方式
-	if (SweepRadius > 0.0f)
-	{
-		// 球形扫描检测：使用指定半径的球体进行扫描
-		// 可以命中在球体半径范围内的目标（子弹吸附效果）
-		GetWorld()->SweepMultiByChannel(HitResults, StartTrace, EndTrace, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(SweepRadius), TraceParams);
-	}
-	else
-	{
-		// 线性射线检测：精确的直线检测
-		GetWorld()->LineTraceMultiByChannel(HitResults, StartTrace, EndTrace, TraceChannel, TraceParams);
-	}
-	
-	FHitResult Hit(ForceInit);
-	if (HitResults.Num() > 0)
-	{
-		// 过滤输出列表，防止对同一Actor多次命中
-		// 这是为了防止单颗子弹对同一目标造成多次伤害
-		// （使用重叠检测时可能会对同一Actor产生多个命中结果）
-		for (FHitResult& CurHitResult : HitResults)
-		{
-			// 检查当前命中的Actor是否已经在输出列表中
-			auto Pred = [&CurHitResult](const FHitResult& Other)
-			{
-				return Other.HitObjectHandle == CurHitResult.HitObjectHandle;
-			};
-
-			// 只添加未重复的命中结果
-			if (!OutHitResults.ContainsByPredicate(Pred))
-			{
-				OutHitResults.Add(CurHitResult);
-			}
-		}
-
-		// 返回最后一个命中结果
-		Hit = OutHitResults.Last();
-	}
-	else
-	{
-		// 没有命中任何目标，记录射线的起点和终点
-		Hit.TraceStart = StartTrace;
-		Hit.TraceEnd = EndTrace;
-	}
+	return DetermineTraceChannel(OutTraceParams, bIsSimulated);
+}
 
-	return Hit;
+FHitResult UYcGameplayAbility_HitScanWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace,
+                                                        float SweepRadius, bool bIsSimulated, TArray<FHitResult>& OutHitResults) const
+{
+	FCollisionQueryParams TraceParams;
+	const ECollisionChannel TraceChannel = BuildWeaponTraceParams(bIsSimulated, TraceParams);
+	return YcWeaponTrace(GetWorld(), StartTrace, EndTrace, SweepRadius, TraceParams, TraceChannel, OutHitResults);
 }
 
 void UYcGameplayAbility_HitScanWeapon::AddAdditionalTraceIgnoreActors(FCollisionQueryParams& TraceParams) const
@@ -597,6 +810,18 @@ void UYcGameplayAbility_HitScanWeapon::OnTargetDataReadyCallback(const FGameplay
 	// 使用MoveTemp确保游戏代码中的回调不会使数据失效
 	FGameplayAbilityTargetDataHandle LocalTargetDataHandle(MoveTemp(const_cast<FGameplayAbilityTargetDataHandle&>(InData)));
 
+	// 统计本批次包含的射击（每发子弹拥有唯一的CartridgeID），每发子弹各提交一次消耗
+	// 需要在服务端剔除命中之前统计：命中被拒绝的子弹同样消耗弹药
+	TArray<int32, TInlineAllocator<8>> CartridgeIDs;
+	for (int32 i = 0; i < LocalTargetDataHandle.Num(); ++i)
+	{
+		if (const FYcGameplayAbilityTargetData_SingleTargetHit* SingleTargetHit = GetYcSingleTargetHit(LocalTargetDataHandle, i))
+		{
+			CartridgeIDs.AddUnique(SingleTargetHit->CartridgeID);
+		}
+	}
+	const int32 NumShots = FMath::Max(1, CartridgeIDs.Num());
+
 	// 判断是否需要通知服务器
 	// 条件：本地控制 且 没有网络权威（即客户端玩家）
 	// Listen Server的玩家拥有网络权威，不需要发送RPC
@@ -608,7 +833,7 @@ void UYcGameplayAbility_HitScanWeapon::OnTargetDataReadyCallback(const FGameplay
 		MyAbilityComponent->CallServerSetReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey(), LocalTargetDataHandle, ApplicationTag, MyAbilityComponent->ScopedPredictionKey);
 	}
 
-	// @TODO: 实现TargetData验证逻辑
+	// 射击本身始终有效（消耗弹药），单个命中是否可信由服务端逐条校验
 	const bool bIsTargetDataValid = true;
 
 #if WITH_SERVER_CODE
@@ -616,31 +841,68 @@ void UYcGameplayAbility_HitScanWeapon::OnTargetDataReadyCallback(const FGameplay
 	if (const AController* Controller = GetControllerFromActorInfo();
 		Controller->GetLocalRole() == ROLE_Authority)
 	{
+		// 校验远程客户端上报的命中，本地控制的权威端（Listen Server/单机）的命中本身就是权威结果
+		TArray<uint8> RejectedHits;
+		if (!CurrentActorInfo->IsLocallyControlled())
+		{
+			ValidateClientTargetData(LocalTargetDataHandle, /*out*/ RejectedHits);
+		}
+
 		// 确认命中标记
 		if (UYcWeaponStateComponent* WeaponStateComponent = Controller->FindComponentByClass<UYcWeaponStateComponent>())
 		{
-			TArray<uint8> HitReplaces;
+			TArray<uint8> HitReplaces = RejectedHits;
 			for (uint8 i = 0; (i < LocalTargetDataHandle.Num()) && (i < 255); ++i)
 			{
 				if (const FGameplayAbilityTargetData_SingleTargetHit* SingleTargetHit = static_cast<FGameplayAbilityTargetData_SingleTargetHit*>(LocalTargetDataHandle.Get(i)))
 				{
 					// 如果命中被验证替换，加入确认列表
-					// @TODO: 实现真正的服务器端命中验证逻辑
 					if (SingleTargetHit->bHitReplaced)
 					{
-						HitReplaces.Add(i);
+						HitReplaces.AddUnique(i);
 					}
 				}
 			}
 			// 服务器发起Client RPC，确认客户端的目标数据
 			WeaponStateComponent->ClientConfirmTargetData(LocalTargetDataHandle.UniqueId, bIsTargetDataValid, HitReplaces);
 		}
+
+		// 移除未通过校验的命中，蓝图只会收到可信的命中结果
+		if (RejectedHits.Num() > 0)
+		{
+			FilterTargetData(LocalTargetDataHandle, [&RejectedHits](int32 Index)
+			{
+				return !RejectedHits.Contains(static_cast<uint8>(Index));
+			});
+		}
 	}
 #endif //WITH_SERVER_CODE
 
 	// 检查是否还有弹药，并提交技能
+	// 第一发提交完整的技能（冷却+消耗），同批次的后续射击只提交消耗（射击间隔由调度器控制）
+	int32 NumCommittedShots = 0;
 	if (bIsTargetDataValid && CommitAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo))
 	{
+		NumCommittedShots = 1;
+		while (NumCommittedShots < NumShots && CommitAbilityCost(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo))
+		{
+			++NumCommittedShots;
+		}
+	}
+
+	if (NumCommittedShots > 0)
+	{
+		// 弹药不足以支付整批射击：丢弃未提交射击的命中结果
+		if (NumCommittedShots < NumShots)
+		{
+			const TArrayView<const int32> CommittedCartridgeIDs = MakeArrayView(CartridgeIDs.GetData(), NumCommittedShots);
+			FilterTargetData(LocalTargetDataHandle, [&LocalTargetDataHandle, &CommittedCartridgeIDs](int32 Index)
+			{
+				const FYcGameplayAbilityTargetData_SingleTargetHit* SingleTargetHit = GetYcSingleTargetHit(LocalTargetDataHandle, Index);
+				return SingleTargetHit == nullptr || CommittedCartridgeIDs.Contains(SingleTargetHit->CartridgeID);
+			});
+		}
+
 		// 调用蓝图事件，让蓝图处理后续逻辑
 		// 例如：应用伤害效果、播放特效、显示伤害数字
 		OnRangedWeaponTargetDataReady(LocalTargetDataHandle);
@@ -663,6 +925,42 @@ void UYcGameplayAbility_HitScanWeapon::OnTargetDataReadyCallback(const FGameplay
 }
 
 
+void UYcGameplayAbility_HitScanWeapon::ValidateClientTargetData(const FGameplayAbilityTargetDataHandle& TargetData, TArray<uint8>& OutRejectedHits) const
+{
+	const UYcLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UYcLagCompensationSubsystem>();
+	if (LagCompensation == nullptr || !LagCompensation->IsRecording())
+	{
+		return;
+	}
+
+	const UYcHitScanWeaponInstance* WeaponData = GetWeaponInstance();
+	if (WeaponData == nullptr)
+	{
+		return;
+	}
+
+	const AController* Shooter = GetControllerFromActorInfo();
+	const float SweepRadius = WeaponData->GetBulletTraceSweepRadius();
+	const float MaxRange = WeaponData->GetMaxDamageRange();
+
+	for (int32 i = 0; (i < TargetData.Num()) && (i < 255); ++i)
+	{
+		const FYcGameplayAbilityTargetData_SingleTargetHit* SingleTargetHit = GetYcSingleTargetHit(TargetData, i);
+		if (SingleTargetHit == nullptr)
+		{
+			continue;
+		}
+
+		if (!LagCompensation->ValidateHit(SingleTargetHit->HitResult, Shooter, SweepRadius, MaxRange))
+		{
+			UE_LOG(LogYcShooterCore, Verbose, TEXT("服务端拒绝命中：目标=%s，服务端回溯时刻=%.3f"),
+				*GetNameSafe(SingleTargetHit->HitResult.GetActor()), LagCompensation->GetRewindTime(Shooter));
+			OutRejectedHits.Add(static_cast<uint8>(i));
+		}
+	}
+}
+
+
 // ==================== 后坐力应用 ====================
 
 void UYcGameplayAbility_HitScanWeapon::ApplyRecoilToController(float RecoilPitch, float RecoilYaw)
@@ -850,40 +1148,37 @@ void UYcGameplayAbility_HitScanWeapon::StartFiring()
 	// 缓存射击状态
 	bCurrentShotIsCrouching = false; // @TODO 实现下蹲状态获取
 	bIsFiring = true;
-	bWantsToStopFiring = false;
-	CurrentBurstShotCount = 0;
 
 	// 触发射击开始事件
 	OnFiringStarted();
 
-	// 检查是否可以立即射击（射速限制）
 	const UWorld* World = GetWorld();
 	if (!World)
 	{
 		return;
 	}
 
-	const double CurrentTime = World->GetTimeSeconds();
+	// 初始化射击调度器，射速限制（距上一发的间隔）由调度器处理
 	const float FireInterval = GetFireInterval();
-	const double TimeSinceLastShot = CurrentTime - LastShotTime;
-
-	if (TimeSinceLastShot >= FireInterval)
-	{
-		// 可以立即射击
-		FireShot();
-	}
-	else
+	FireScheduler.Start(
+		World->GetTimeSeconds(),
+		LastShotTime,
+		WeaponData->GetFireMode(),
+		FireInterval,
+		WeaponData->GetBurstCount(),
+		FireInterval * WeaponData->GetBurstIntervalMultiplier()
+	);
+
+	// 启动逐帧 Task 推进调度器
+	if (!FireTickTask)
 	{
-		// 需要等待射速冷却，设置Timer
-		const float RemainingTime = FireInterval - static_cast<float>(TimeSinceLastShot);
-		World->GetTimerManager().SetTimer(
-			FireTimerHandle,
-			this,
-			&UYcGameplayAbility_HitScanWeapon::OnFireTimerTick,
-			RemainingTime,
-			false
-		);
+		FireTickTask = UYcAbilityTask_WaitTick::WaitTick(this);
+		FireTickTask->OnTick.AddUObject(this, &ThisClass::OnFireTick);
+		FireTickTask->ReadyForActivation();
 	}
+
+	// 射速冷却已结束时立即射出第一发
+	ProcessScheduledShots();
 }
 
 void UYcGameplayAbility_HitScanWeapon::StopFiring(bool bEndAbilityWhenDone)
@@ -917,185 +1212,89 @@ void UYcGameplayAbility_HitScanWeapon::StopFiring(bool bEndAbilityWhenDone)
 	switch (FireMode)
 	{
 	case EYcFireMode::Auto:
-		// 全自动：立即停止
-		bIsFiring = false;
-		if (const UWorld* World = GetWorld())
-		{
-			World->GetTimerManager().ClearTimer(FireTimerHandle);
-		}
-		OnFiringStopped();
-		if (bPendingEndAbility)
-		{
-			bPendingEndAbility = false;
-			K2_EndAbility();
-		}
-		break;
-
 	case EYcFireMode::SemiAuto:
-		// 半自动：立即停止
-		bIsFiring = false;
-		if (const UWorld* World = GetWorld())
-		{
-			World->GetTimerManager().ClearTimer(FireTimerHandle);
-		}
-		OnFiringStopped();
-		if (bPendingEndAbility)
-		{
-			bPendingEndAbility = false;
-			K2_EndAbility();
-		}
+		// 全自动/半自动：立即停止
+		FinishFiring();
 		break;
 
 	case EYcFireMode::BurstAuto:
 	case EYcFireMode::BurstSingle:
-		// 连射模式：标记想要停止，等当前连射完成后停止
+		// 连射模式：等当前连射完成后停止
 		// 技能会在连射完成后自动结束（如果bPendingEndAbility为true）
-		bWantsToStopFiring = true;
+		FireScheduler.RequestStopAfterBurst();
+		if (!FireScheduler.IsActive())
+		{
+			FinishFiring();
+		}
 		break;
 	}
 }
 
-void UYcGameplayAbility_HitScanWeapon::FireShot()
+void UYcGameplayAbility_HitScanWeapon::OnFireTick(float DeltaTime)
 {
-	UYcHitScanWeaponInstance* WeaponData = GetWeaponInstance();
-	if (!WeaponData)
-	{
-		bIsFiring = false;
-		return;
-	}
+	ProcessScheduledShots();
+}
 
+void UYcGameplayAbility_HitScanWeapon::ProcessScheduledShots()
+{
 	const UWorld* World = GetWorld();
-	if (!World)
+	if (!bIsFiring || !World)
 	{
-		bIsFiring = false;
 		return;
 	}
 
-	// 记录射击时间
-	LastShotTime = World->GetTimeSeconds();
-
-	// 触发单次射击事件
-	OnShotFired(CurrentBurstShotCount);
+	// 取出所有在本帧内到期的射击（可能多发，每发带有精确的亚帧时间）
+	TArray<FYcScheduledShot, TInlineAllocator<8>> DueShots;
+	FireScheduler.Advance(World->GetTimeSeconds(), FMath::Max(1, YcConsoleVariables::MaxShotsPerFrame), DueShots);
 
-	// 执行实际射击
-	StartHitScanWeaponTargeting(IsAiming(), bCurrentShotIsCrouching);
+	if (DueShots.Num() > 0)
+	{
+		FireShots(DueShots);
+	}
 
-	// 更新连射计数
-	CurrentBurstShotCount++;
+	// 射击过程中可能因弹药不足而结束技能，此时 bIsFiring 已被重置
+	if (bIsFiring && !FireScheduler.IsActive())
+	{
+		FinishFiring();
+	}
+}
 
-	// 根据射击模式决定后续行为
-	const EYcFireMode FireMode = WeaponData->GetFireMode();
-	const float FireInterval = GetFireInterval();
-	const float BurstInterval = FireInterval * WeaponData->GetBurstIntervalMultiplier();
+void UYcGameplayAbility_HitScanWeapon::FireShots(TConstArrayView<FYcScheduledShot> Shots)
+{
+	// 记录射击时间
+	LastShotTime = Shots.Last().Time;
 
-	switch (FireMode)
+	TArray<double, TInlineAllocator<8>> ShotTimes;
+	ShotTimes.Reserve(Shots.Num());
+	for (const FYcScheduledShot& Shot : Shots)
 	{
-	case EYcFireMode::Auto:
-		// 全自动：继续射击
-		if (bIsFiring && !bWantsToStopFiring)
-		{
-			World->GetTimerManager().SetTimer(
-				FireTimerHandle,
-				this,
-				&UYcGameplayAbility_HitScanWeapon::OnFireTimerTick,
-				FireInterval,
-				false
-			);
-		}
-		break;
+		// 触发单次射击事件
+		OnShotFired(Shot.BurstShotIndex);
+		ShotTimes.Add(Shot.Time);
+	}
 
-	case EYcFireMode::SemiAuto:
-		// 半自动：射击一发后停止
-		bIsFiring = false;
-		CurrentBurstShotCount = 0;
-		OnFiringStopped();
-		break;
+	// 执行实际射击：整批射击共用一次 TargetData 回调和一次 ServerRPC
+	StartHitScanWeaponTargetingBatch(ShotTimes, IsAiming(), bCurrentShotIsCrouching);
+}
 
-	case EYcFireMode::BurstAuto:
-		// 连射(按住自动)：检查是否完成当前连射
-		if (CurrentBurstShotCount >= WeaponData->GetBurstCount())
-		{
-			// 当前连射完成，重置计数
-			CurrentBurstShotCount = 0;
-			
-			if (bWantsToStopFiring)
-			{
-				// 玩家已松开射击键，停止射击
-				bIsFiring = false;
-				bWantsToStopFiring = false;
-				World->GetTimerManager().ClearTimer(FireTimerHandle);
-				OnFiringStopped();
-				
-				// 如果需要结束技能
-				if (bPendingEndAbility)
-				{
-					bPendingEndAbility = false;
-					K2_EndAbility();
-				}
-			}
-			else
-			{
-				// 玩家仍在按住射击键，等待连射间隔后开始下一轮连射
-				World->GetTimerManager().SetTimer(
-					FireTimerHandle,
-					this,
-					&UYcGameplayAbility_HitScanWeapon::OnFireTimerTick,
-					BurstInterval,
-					false
-				);
-			}
-		}
-		else
-		{
-			// 继续当前连射
-			World->GetTimerManager().SetTimer(
-				FireTimerHandle,
-				this,
-				&UYcGameplayAbility_HitScanWeapon::OnFireTimerTick,
-				FireInterval,
-				false
-			);
-		}
-		break;
+void UYcGameplayAbility_HitScanWeapon::FinishFiring()
+{
+	bIsFiring = false;
+	FireScheduler.Stop();
 
-	case EYcFireMode::BurstSingle:
-		// 连射(单次)：检查是否完成当前连射
-		if (CurrentBurstShotCount >= WeaponData->GetBurstCount())
-		{
-			// 当前连射完成，停止射击（需要松开再按才能继续）
-			bIsFiring = false;
-			bWantsToStopFiring = false;
-			World->GetTimerManager().ClearTimer(FireTimerHandle);
-			CurrentBurstShotCount = 0;
-			OnFiringStopped();
-			
-			// 如果需要结束技能
-			if (bPendingEndAbility)
-			{
-				bPendingEndAbility = false;
-				K2_EndAbility();
-			}
-		}
-		else
-		{
-			// 继续当前连射
-			World->GetTimerManager().SetTimer(
-				FireTimerHandle,
-				this,
-				&UYcGameplayAbility_HitScanWeapon::OnFireTimerTick,
-				FireInterval,
-				false
-			);
-		}
-		break;
+	if (FireTickTask)
+	{
+		FireTickTask->EndTask();
+		FireTickTask = nullptr;
 	}
-}
 
-void UYcGameplayAbility_HitScanWeapon::OnFireTimerTick()
-{
-	if (bIsFiring)
+	OnFiringStopped();
+
+	// 如果需要结束技能
+	if (bPendingEndAbility)
 	{
-		FireShot();
+		bPendingEndAbility = false;
+		K2_EndAbility();
 	}
 }
 
@@ -1148,3 +1347,94 @@ FGameplayTag UYcGameplayAbility_HitScanWeapon::GetHitZoneFromTargetData(const FG
 	// 通过武器实例映射 PhysicalMaterial -> HitZone
 	return WeaponData->GetHitZoneFromPhysicalMaterial(HitResult->PhysMaterial.Get());
 }
+
+
+// ==================== 性能测试 ====================
+
+/**
+ * 霰弹枪弹丸检测性能测试
+ * 从世界中第一个 Pawn 的视角连续射击，对比逐弹丸构建参数的串行检测与按发批量的检测
+ * 用法：Yc.Weapon.BenchmarkPelletTraces [弹丸数=12] [发数=600] [扫描半径=0]
+ */
+static void RunPelletTraceBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	const int32 NumPellets = FMath::Max(1, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 12);
+	const int32 NumCartridges = FMath::Max(1, Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 600);
+	const float SweepRadius = FMath::Max(0.0f, Args.Num() > 2 ? FCString::Atof(*Args[2]) : 0.0f);
+
+	TActorIterator<APawn> PawnIt(World);
+	if (!PawnIt)
+	{
+		UE_LOG(LogYcShooterCore, Warning, TEXT("BenchmarkPelletTraces: 世界中没有 Pawn，无法确定射击视角"));
+		return;
+	}
+
+	const APawn* SourcePawn = *PawnIt;
+	FVector StartTrace;
+	FRotator ViewRotation;
+	SourcePawn->GetActorEyesViewPoint(StartTrace, ViewRotation);
+	const FVector AimDir = ViewRotation.Vector();
+
+	constexpr float MaxRange = 10000.0f;
+	const float HalfConeRadians = FMath::DegreesToRadians(5.0f);
+	const ECollisionChannel TraceChannel = Yc_TraceChannel_Weapon;
+
+	// 预先生成所有弹丸方向，两种方式检测完全相同的射线
+	TArray<FYcPelletTrace> Pellets;
+	Pellets.SetNum(NumPellets * NumCartridges);
+	for (FYcPelletTrace& Pellet : Pellets)
+	{
+		Pellet.EndTrace = StartTrace + FMath::VRandCone(AimDir, HalfConeRadians) * MaxRange;
+	}
+
+	auto MakeTraceParams = [SourcePawn]()
+	{
+		FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace), /*bTraceComplex=*/ true, SourcePawn);
+		TraceParams.bReturnPhysicalMaterial = true;
+		TArray<AActor*> AttachedActors;
+		SourcePawn->GetAttachedActors(AttachedActors);
+		TraceParams.AddIgnoredActors(AttachedActors);
+		return TraceParams;
+	};
+
+	// 逐弹丸构建参数、串行检测（改造前的做法）
+	const double PerPelletStart = FPlatformTime::Seconds();
+	for (FYcPelletTrace& Pellet : Pellets)
+	{
+		Pellet.Hits.Reset();
+		Pellet.SweepHits.Reset();
+		const FCollisionQueryParams TraceParams = MakeTraceParams();
+		YcTracePelletBatch(World, StartTrace, MakeArrayView(&Pellet, 1), SweepRadius, TraceParams, TraceChannel, /*bParallel=*/ false);
+	}
+	const double PerPelletMs = (FPlatformTime::Seconds() - PerPelletStart) * 1000.0;
+
+	// 每发子弹构建一次参数，批量检测
+	const double BatchedStart = FPlatformTime::Seconds();
+	for (int32 CartridgeIndex = 0; CartridgeIndex < NumCartridges; ++CartridgeIndex)
+	{
+		TArrayView<FYcPelletTrace> Cartridge = MakeArrayView(Pellets.GetData() + CartridgeIndex * NumPellets, NumPellets);
+		for (FYcPelletTrace& Pellet : Cartridge)
+		{
+			Pellet.Hits.Reset();
+			Pellet.SweepHits.Reset();
+		}
+		const FCollisionQueryParams TraceParams = MakeTraceParams();
+		const bool bParallel = YcConsoleVariables::bParallelPelletTraces && NumPellets >= YcConsoleVariables::ParallelPelletTraceThreshold;
+		YcTracePelletBatch(World, StartTrace, Cartridge, SweepRadius, TraceParams, TraceChannel, bParallel);
+	}
+	const double BatchedMs = (FPlatformTime::Seconds() - BatchedStart) * 1000.0;
+
+	UE_LOG(LogYcShooterCore, Display, TEXT("BenchmarkPelletTraces: %d 发 x %d 弹丸, 扫描半径 %.1f"), NumCartridges, NumPellets, SweepRadius);
+	UE_LOG(LogYcShooterCore, Display, TEXT("  逐弹丸串行: %.3f ms (%.2f us/发)"), PerPelletMs, PerPelletMs * 1000.0 / NumCartridges);
+	UE_LOG(LogYcShooterCore, Display, TEXT("  按发批量:   %.3f ms (%.2f us/发)"), BatchedMs, BatchedMs * 1000.0 / NumCartridges);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkPelletTraces(
+	TEXT("Yc.Weapon.BenchmarkPelletTraces"),
+	TEXT("霰弹枪弹丸检测性能测试：Yc.Weapon.BenchmarkPelletTraces [弹丸数=12] [发数=600] [扫描半径=0]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunPelletTraceBenchmark));
@@ -3,6 +3,7 @@
 #include "Weapons/YcHitScanWeaponInstance.h"
 
 #include "YcAbilitySystemComponent.h"
+#include "YiChenShooterCore.h"
 #include "Weapons/YcWeaponMessages.h"
 #include "Weapons/Fragments/YcFragment_WeaponStats.h"
 #include "Weapons/Attachments/YcFragment_WeaponAttachments.h"
@@ -14,9 +15,14 @@
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameFramework/Pawn.h"
 #include "Net/UnrealNetwork.h"
+#include "UObject/UObjectIterator.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(YcHitScanWeaponInstance)
 
+DECLARE_STATS_GROUP(TEXT("YcWeapon"), STATGROUP_YcWeapon, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RecalculateStats"), STAT_YcWeapon_RecalculateStats, STATGROUP_YcWeapon);
+DECLARE_CYCLE_STAT(TEXT("ResolveHitZone"), STAT_YcWeapon_ResolveHitZone, STATGROUP_YcWeapon);
+
 UYcHitScanWeaponInstance::UYcHitScanWeaponInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -49,6 +55,14 @@ void UYcHitScanWeaponInstance::OnEquipmentInstanceCreated(const FYcEquipmentDefi
 	// 从Definition获取武器数值Fragment
 	WeaponStatsFragment = Definition.GetTypedFragment<FYcFragment_WeaponStats>();
 
+#if WITH_EDITOR
+	// 编辑器中曲线和弹道可能在加载后被修改，每次创建实例时重新烘焙
+	if (WeaponStatsFragment)
+	{
+		WeaponStatsFragment->BakeLookupTables();
+	}
+#endif
+
 	// 从Definition获取配件配置Fragment
 	AttachmentsFragment = Definition.GetTypedFragment<FYcFragment_WeaponAttachments>();
 
@@ -106,12 +120,6 @@ float UYcHitScanWeaponInstance::GetDistanceAttenuation(float Distance, const FGa
 		return 1.0f;
 	}
 
-	// 如果没有配置伤害衰减曲线，返回 1.0（无衰减）
-	if (WeaponStatsFragment->DamageFalloffCurve.GetRichCurveConst()->IsEmpty())
-	{
-		return 1.0f;
-	}
-
 	// 计算距离百分比（相对于最大射程）
 	const float MaxRange = ComputedStats.MaxDamageRange;
 	if (MaxRange <= 0.0f)
@@ -119,78 +127,64 @@ float UYcHitScanWeaponInstance::GetDistanceAttenuation(float Distance, const FGa
 		return 1.0f;
 	}
 
-	const float DistancePercent = FMath::Clamp(Distance / MaxRange, 0.0f, 1.0f);
-
-	// 从曲线中采样伤害倍率
-	const float DamageMultiplier = WeaponStatsFragment->DamageFalloffCurve.GetRichCurveConst()->Eval(DistancePercent);
-
-	// 确保倍率在合理范围内
-	return FMath::Clamp(DamageMultiplier, 0.0f, 1.0f);
+	// 从烘焙好的查找表中采样伤害倍率（未配置衰减曲线时返回 1.0）
+	return WeaponStatsFragment->GetLookupTables().EvaluateDamageFalloff(Distance / MaxRange);
 }
 
 float UYcHitScanWeaponInstance::GetPhysicalMaterialMultiplier(const UPhysicalMaterial* PhysicalMaterial,
 	const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags) const
 {
-	// 默认倍率为 1.0（基础伤害）
-	float DamageMultiplier = 1.0f;
+	return FindOrResolveHitZone(PhysicalMaterial).DamageMultiplier;
+}
 
-	// 尝试转换为带 Tag 的物理材质
-	const UYcPhysicalMaterialWithTags* TaggedMaterial = Cast<UYcPhysicalMaterialWithTags>(PhysicalMaterial);
-	if (!TaggedMaterial || TaggedMaterial->Tags.IsEmpty())
-	{
-		// 如果不是带 Tag 的物理材质，或者没有 Tag，返回默认倍率
-		return DamageMultiplier;
-	}
+FGameplayTag UYcHitScanWeaponInstance::GetHitZoneFromPhysicalMaterial(const UPhysicalMaterial* PhysicalMaterial) const
+{
+	return FindOrResolveHitZone(PhysicalMaterial).ZoneTag;
+}
 
-	// 遍历命中区域伤害倍率映射表，查找匹配的 Tag
-	for (const auto& Pair : ComputedStats.HitZoneDamageMultipliers)
-	{
-		const FGameplayTag& ZoneTag = Pair.Key;
-		const float Multiplier = Pair.Value;
+const UYcHitScanWeaponInstance::FHitZoneEntry& UYcHitScanWeaponInstance::FindOrResolveHitZone(const UPhysicalMaterial* PhysicalMaterial) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_YcWeapon_ResolveHitZone);
 
-		// 检查物理材质是否包含此区域 Tag
-		if (TaggedMaterial->Tags.HasTag(ZoneTag))
-		{
-			// 找到匹配的 Tag，使用对应的倍率
-			DamageMultiplier = Multiplier;
-			break; // 使用第一个匹配的倍率
-		}
+	const TObjectKey<UPhysicalMaterial> MaterialKey(PhysicalMaterial);
+	if (const FHitZoneEntry* Cached = HitZoneCache.Find(MaterialKey))
+	{
+		return *Cached;
 	}
 
-	return DamageMultiplier;
-}
+	// 默认倍率为 1.0（基础伤害），没有匹配区域时同样缓存，避免重复解析
+	FHitZoneEntry Entry;
 
-FGameplayTag UYcHitScanWeaponInstance::GetHitZoneFromPhysicalMaterial(const UPhysicalMaterial* PhysicalMaterial) const
-{
 	// 尝试转换为带 Tag 的物理材质
 	const UYcPhysicalMaterialWithTags* TaggedMaterial = Cast<UYcPhysicalMaterialWithTags>(PhysicalMaterial);
-	if (!TaggedMaterial || TaggedMaterial->Tags.IsEmpty())
+	if (TaggedMaterial && !TaggedMaterial->Tags.IsEmpty())
 	{
-		return FGameplayTag();
-	}
-
-	// 遍历命中区域伤害倍率映射表，查找匹配的 Tag
-	for (const auto& Pair : ComputedStats.HitZoneDamageMultipliers)
-	{
-		const FGameplayTag& ZoneTag = Pair.Key;
-
-		// 检查物理材质是否包含此区域 Tag
-		if (TaggedMaterial->Tags.HasTag(ZoneTag))
+		// 遍历命中区域伤害倍率映射表，查找匹配的 Tag
+		for (const auto& Pair : ComputedStats.HitZoneDamageMultipliers)
 		{
-			return ZoneTag;
+			// 检查物理材质是否包含此区域 Tag，使用第一个匹配的倍率
+			if (TaggedMaterial->Tags.HasTag(Pair.Key))
+			{
+				Entry.ZoneTag = Pair.Key;
+				Entry.DamageMultiplier = Pair.Value;
+				break;
+			}
 		}
 	}
 
-	return FGameplayTag();
+	return HitZoneCache.Add(MaterialKey, Entry);
 }
 
 
 void UYcHitScanWeaponInstance::RecalculateStats()
 {
+	SCOPE_CYCLE_COUNTER(STAT_YcWeapon_RecalculateStats);
+
 	if (!WeaponStatsFragment)
 	{
 		// 没有配置Fragment，使用默认值
 		ComputedStats = FYcComputedWeaponStats();
+		StatValues.ReadFrom(ComputedStats);
 		return;
 	}
 
@@ -242,12 +236,17 @@ void UYcHitScanWeaponInstance::RecalculateStats()
 	ComputedStats.ADSFOVMultiplier = Stats.ADSFOVMultiplier;
 	ComputedStats.ADSMoveSpeedMultiplier = Stats.ADSMoveSpeedMultiplier;
 
+	StatValues.ReadFrom(ComputedStats);
+
 	// 应用配件修改器
 	if (AttachmentComponent)
 	{
 		ApplyAttachmentModifiers();
 	}
 
+	// 命中区域倍率可能已变化，重新解析
+	HitZoneCache.Reset();
+
 	// 广播属性变化消息（供 UI 和其他解耦系统监听）
 	BroadcastStatsChangedMessage();
 }
@@ -270,94 +269,27 @@ void UYcHitScanWeaponInstance::ApplyAttachmentModifiers()
 		return;
 	}
 
-	// 使用宏简化属性应用
-	#define APPLY_ATTACHMENT_MODIFIER(StatName, StatTag) \
-		ComputedStats.StatName = AttachmentComponent->CalculateFinalStatValue( \
-			FGameplayTag::RequestGameplayTag(FName(TEXT(StatTag))), ComputedStats.StatName)
-
-	// 射击参数
-	APPLY_ATTACHMENT_MODIFIER(FireRate, "Weapon.Stat.FireRate");
-	APPLY_ATTACHMENT_MODIFIER(MaxDamageRange, "Weapon.Stat.Range.Max");
-	APPLY_ATTACHMENT_MODIFIER(BulletTraceSweepRadius, "Weapon.Stat.BulletRadius");
-
-	// 伤害参数
-	APPLY_ATTACHMENT_MODIFIER(BaseDamage, "Weapon.Stat.Damage.Base");
-	APPLY_ATTACHMENT_MODIFIER(HeadshotMultiplier, "Weapon.Stat.Damage.HeadshotMultiplier");
-	APPLY_ATTACHMENT_MODIFIER(ArmorPenetration, "Weapon.Stat.Damage.ArmorPenetration");
+	// 按属性表顺序对扁平数组应用修改器，Tag 已在模块启动时解析
+	for (int32 StatIndex = 0; StatIndex < YcWeaponStat::Num; ++StatIndex)
+	{
+		const FGameplayTag& StatTag = YcWeaponStat::GetStatTag(static_cast<EYcWeaponStat>(StatIndex));
+		StatValues[StatIndex] = AttachmentComponent->CalculateFinalStatValue(StatTag, StatValues[StatIndex]);
+	}
+	StatValues.WriteTo(ComputedStats);
 
-	// 命中区域伤害倍率（批量应用配件修正）
-	// 为每个命中区域倍率应用配件修改器
+	// 命中区域伤害倍率（应用配件修正）
 	// 例如：穿甲弹可以提升护甲部位的伤害倍率
-	if (!ComputedStats.HitZoneDamageMultipliers.IsEmpty())
+	// 区域 Tag 对应的属性 Tag 已在武器定义加载时烘焙，这里不做字符串转换
+	if (WeaponStatsFragment && !ComputedStats.HitZoneDamageMultipliers.IsEmpty())
 	{
-		// 构建基础值映射表
-		TMap<FGameplayTag, float> BaseMultipliers;
-		for (const auto& Pair : ComputedStats.HitZoneDamageMultipliers)
+		for (const TPair<FGameplayTag, FGameplayTag>& ZoneStat : WeaponStatsFragment->GetLookupTables().GetHitZoneStatTags())
 		{
-			// 为每个命中区域构建对应的 Stat Tag
-			// 例如：Gameplay.Character.Zone.Head -> Weapon.Stat.Damage.Zone.Head
-			const FString ZoneTagString = Pair.Key.ToString();
-			const FString StatTagString = ZoneTagString.Replace(TEXT("Gameplay.Character.Zone"), TEXT("Weapon.Stat.Damage.Zone"));
-			const FGameplayTag StatTag = FGameplayTag::RequestGameplayTag(FName(*StatTagString), false);
-			
-			if (StatTag.IsValid())
+			if (float* Multiplier = ComputedStats.HitZoneDamageMultipliers.Find(ZoneStat.Key))
 			{
-				BaseMultipliers.Add(StatTag, Pair.Value);
-			}
-		}
-
-		// 批量应用配件修改器
-		if (!BaseMultipliers.IsEmpty())
-		{
-			const TMap<FGameplayTag, float> ModifiedMultipliers = AttachmentComponent->CalculateFinalStatValues(BaseMultipliers);
-			
-			// 更新命中区域倍率
-			for (const auto& Pair : ModifiedMultipliers)
-			{
-				// 将 Stat Tag 转换回 Zone Tag
-				// 例如：Weapon.Stat.Damage.Zone.Head -> Gameplay.Character.Zone.Head
-				const FString StatTagString = Pair.Key.ToString();
-				const FString ZoneTagString = StatTagString.Replace(TEXT("Weapon.Stat.Damage.Zone"), TEXT("Gameplay.Character.Zone"));
-				const FGameplayTag ZoneTag = FGameplayTag::RequestGameplayTag(FName(*ZoneTagString), false);
-				
-				if (ZoneTag.IsValid())
-				{
-					ComputedStats.HitZoneDamageMultipliers.Add(ZoneTag, Pair.Value);
-				}
+				*Multiplier = AttachmentComponent->CalculateFinalStatValue(ZoneStat.Value, *Multiplier);
 			}
 		}
 	}
-
-	// 弹药参数
-	APPLY_ATTACHMENT_MODIFIER(MagazineSize, "Weapon.Stat.Magazine.Size");
-	APPLY_ATTACHMENT_MODIFIER(MaxReserveAmmo, "Weapon.Stat.Magazine.ReserveMax");
-	APPLY_ATTACHMENT_MODIFIER(ReloadTime, "Weapon.Stat.Reload.Time");
-	APPLY_ATTACHMENT_MODIFIER(TacticalReloadTime, "Weapon.Stat.Reload.TacticalTime");
-
-	// 扩散参数
-	APPLY_ATTACHMENT_MODIFIER(HipFireBaseSpread, "Weapon.Stat.Spread.HipFire.Base");
-	APPLY_ATTACHMENT_MODIFIER(HipFireMaxSpread, "Weapon.Stat.Spread.HipFire.Max");
-	APPLY_ATTACHMENT_MODIFIER(HipFireSpreadPerShot, "Weapon.Stat.Spread.HipFire.PerShot");
-	APPLY_ATTACHMENT_MODIFIER(ADSBaseSpread, "Weapon.Stat.Spread.ADS.Base");
-	APPLY_ATTACHMENT_MODIFIER(ADSMaxSpread, "Weapon.Stat.Spread.ADS.Max");
-	APPLY_ATTACHMENT_MODIFIER(ADSSpreadPerShot, "Weapon.Stat.Spread.ADS.PerShot");
-	APPLY_ATTACHMENT_MODIFIER(SpreadRecoveryRate, "Weapon.Stat.Spread.Recovery");
-
-	// 后坐力参数
-	APPLY_ATTACHMENT_MODIFIER(VerticalRecoilMin, "Weapon.Stat.Recoil.Vertical.Min");
-	APPLY_ATTACHMENT_MODIFIER(VerticalRecoilMax, "Weapon.Stat.Recoil.Vertical.Max");
-	APPLY_ATTACHMENT_MODIFIER(HorizontalRecoilMin, "Weapon.Stat.Recoil.Horizontal.Min");
-	APPLY_ATTACHMENT_MODIFIER(HorizontalRecoilMax, "Weapon.Stat.Recoil.Horizontal.Max");
-	APPLY_ATTACHMENT_MODIFIER(ADSRecoilMultiplier, "Weapon.Stat.Recoil.ADSMultiplier");
-	APPLY_ATTACHMENT_MODIFIER(HipFireRecoilMultiplier, "Weapon.Stat.Recoil.HipFireMultiplier");
-	APPLY_ATTACHMENT_MODIFIER(RecoilRecoveryRate, "Weapon.Stat.Recoil.Recovery");
-
-	// 瞄准参数
-	APPLY_ATTACHMENT_MODIFIER(AimDownSightTime, "Weapon.Stat.ADS.Time");
-	APPLY_ATTACHMENT_MODIFIER(ADSFOVMultiplier, "Weapon.Stat.ADS.FOVMultiplier");
-	APPLY_ATTACHMENT_MODIFIER(ADSMoveSpeedMultiplier, "Weapon.Stat.ADS.MoveSpeed");
-
-	#undef APPLY_ATTACHMENT_MODIFIER
 }
 
 void UYcHitScanWeaponInstance::SetAttachmentComponent(UYcWeaponAttachmentComponent* InComponent)
@@ -671,29 +603,8 @@ FYcRecoilPatternPoint UYcHitScanWeaponInstance::GetRecoilPatternPoint(int32 Shot
 		return FYcRecoilPatternPoint();
 	}
 
-	const TArray<FYcRecoilPatternPoint>& Pattern = WeaponStatsFragment->RecoilPattern;
-	if (Pattern.Num() == 0)
-	{
-		return FYcRecoilPatternPoint();
-	}
-
-	// 如果索引在数组范围内，直接返回
-	if (ShotIndex < Pattern.Num())
-	{
-		return Pattern[ShotIndex];
-	}
-
-	// 超出范围，从LoopStart开始循环
-	const int32 LoopStart = FMath::Clamp(WeaponStatsFragment->RecoilPatternLoopStart, 0, Pattern.Num() - 1);
-	const int32 LoopLength = Pattern.Num() - LoopStart;
-
-	if (LoopLength <= 0)
-	{
-		return Pattern.Last();
-	}
-
-	const int32 LoopIndex = (ShotIndex - Pattern.Num()) % LoopLength;
-	return Pattern[LoopStart + LoopIndex];
+	// 超出轨迹长度后的循环区间已在烘焙时计算好
+	return WeaponStatsFragment->GetLookupTables().GetRecoilPatternPoint(ShotIndex);
 }
 
 FVector2D UYcHitScanWeaponInstance::GenerateRandomRecoil() const
@@ -924,3 +835,99 @@ void UYcHitScanWeaponInstance::UpdateWeaponTags()
 			*GetName(), *WeaponTags.ToStringSimple());
 	}
 }
+
+// ==================== 性能测试 ====================
+
+namespace YcHitZoneBenchmark
+{
+	/**
+	 * 命中区域解析性能测试
+	 * 对比改造前每次命中线性遍历倍率表与当前按物理材质缓存的查找，并检查两者结果一致
+	 * 缓存路径通过公开的 GetPhysicalMaterialMultiplier 访问
+	 */
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 NumHits = FMath::Max(1, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000);
+
+		// 使用已存在的武器实例和带 Tag 的物理材质
+		const UYcHitScanWeaponInstance* Weapon = nullptr;
+		for (TObjectIterator<UYcHitScanWeaponInstance> It; It; ++It)
+		{
+			if (!It->IsTemplate() && !It->GetComputedStats().HitZoneDamageMultipliers.IsEmpty())
+			{
+				Weapon = *It;
+				break;
+			}
+		}
+
+		TArray<const UPhysicalMaterial*> Materials;
+		for (TObjectIterator<UYcPhysicalMaterialWithTags> It; It; ++It)
+		{
+			if (!It->IsTemplate())
+			{
+				Materials.Add(*It);
+			}
+		}
+
+		if (!Weapon || Materials.IsEmpty())
+		{
+			UE_LOG(LogYcShooterCore, Warning, TEXT("Yc.Weapon.BenchmarkHitZone: 需要一个配置了命中区域倍率的武器实例和至少一个 UYcPhysicalMaterialWithTags"));
+			return;
+		}
+
+		const TMap<FGameplayTag, float>& Multipliers = Weapon->GetComputedStats().HitZoneDamageMultipliers;
+
+		// 改造前的做法：每次命中遍历倍率表并逐个 HasTag
+		auto ResolveLinear = [&Multipliers](const UPhysicalMaterial* PhysicalMaterial)
+		{
+			const UYcPhysicalMaterialWithTags* TaggedMaterial = Cast<UYcPhysicalMaterialWithTags>(PhysicalMaterial);
+			if (TaggedMaterial && !TaggedMaterial->Tags.IsEmpty())
+			{
+				for (const TPair<FGameplayTag, float>& Pair : Multipliers)
+				{
+					if (TaggedMaterial->Tags.HasTag(Pair.Key))
+					{
+						return Pair.Value;
+					}
+				}
+			}
+			return 1.0f;
+		};
+
+		int32 NumMismatches = 0;
+		for (const UPhysicalMaterial* Material : Materials)
+		{
+			if (!FMath::IsNearlyEqual(ResolveLinear(Material), Weapon->GetPhysicalMaterialMultiplier(Material)))
+			{
+				UE_LOG(LogYcShooterCore, Error, TEXT("Yc.Weapon.BenchmarkHitZone: 材质 %s 的倍率不一致 (线性 %.3f, 缓存 %.3f)"),
+					*GetNameSafe(Material), ResolveLinear(Material), Weapon->GetPhysicalMaterialMultiplier(Material));
+				++NumMismatches;
+			}
+		}
+
+		float Checksum = 0.0f;
+		const double LinearStart = FPlatformTime::Seconds();
+		for (int32 HitIndex = 0; HitIndex < NumHits; ++HitIndex)
+		{
+			Checksum += ResolveLinear(Materials[HitIndex % Materials.Num()]);
+		}
+		const double LinearMs = (FPlatformTime::Seconds() - LinearStart) * 1000.0;
+
+		const double CachedStart = FPlatformTime::Seconds();
+		for (int32 HitIndex = 0; HitIndex < NumHits; ++HitIndex)
+		{
+			Checksum -= Weapon->GetPhysicalMaterialMultiplier(Materials[HitIndex % Materials.Num()]);
+		}
+		const double CachedMs = (FPlatformTime::Seconds() - CachedStart) * 1000.0;
+
+		UE_LOG(LogYcShooterCore, Display, TEXT("Yc.Weapon.BenchmarkHitZone: %s (%d 次命中, %d 种材质, %d 个命中区域, 不一致 %d, 校验差值 %.3f)"),
+			NumMismatches == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumHits, Materials.Num(), Multipliers.Num(), NumMismatches, Checksum);
+		UE_LOG(LogYcShooterCore, Display, TEXT("  线性遍历: %.3f ms (%.1f ns/次)"), LinearMs, LinearMs * 1e6 / NumHits);
+		UE_LOG(LogYcShooterCore, Display, TEXT("  缓存查找: %.3f ms (%.1f ns/次)"), CachedMs, CachedMs * 1e6 / NumHits);
+	}
+
+	static FAutoConsoleCommand CmdBenchmarkHitZone(
+		TEXT("Yc.Weapon.BenchmarkHitZone"),
+		TEXT("命中区域解析性能测试：Yc.Weapon.BenchmarkHitZone [命中次数=100000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
@@ -0,0 +1,207 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#include "Weapons/YcWeaponStatTable.h"
+
+#include "YiChenShooterCore.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+#include "Weapons/YcHitScanWeaponInstance.h"
+#include "Weapons/YcWeaponStatTags.h"
+#include "Weapons/Attachments/YcWeaponAttachmentComponent.h"
+
+namespace YcWeaponStat
+{
+	/** 属性 -> 原生Tag，模块启动时填充 */
+	static TStaticArray<FGameplayTag, Num> StatTags;
+
+	/** Tag -> 属性，模块启动时填充 */
+	static TMap<FGameplayTag, EYcWeaponStat> TagToStat;
+
+	void InitializeStatTable()
+	{
+		int32 Index = 0;
+#define YC_WEAPON_STAT_TAG(Field, TagName) StatTags[Index++] = YcWeaponStatTags::TagName;
+		YC_WEAPON_STAT_LIST(YC_WEAPON_STAT_TAG)
+#undef YC_WEAPON_STAT_TAG
+		check(Index == Num);
+
+		TagToStat.Reset();
+		TagToStat.Reserve(Num);
+		for (int32 StatIndex = 0; StatIndex < Num; ++StatIndex)
+		{
+			TagToStat.Add(StatTags[StatIndex], static_cast<EYcWeaponStat>(StatIndex));
+		}
+	}
+
+	const FGameplayTag& GetStatTag(EYcWeaponStat Stat)
+	{
+		check(Stat < EYcWeaponStat::Count);
+		return StatTags[static_cast<int32>(Stat)];
+	}
+
+	EYcWeaponStat FindStatByTag(const FGameplayTag& StatTag)
+	{
+		const EYcWeaponStat* Found = TagToStat.Find(StatTag);
+		return Found ? *Found : EYcWeaponStat::Count;
+	}
+}
+
+void FYcWeaponStatValues::ReadFrom(const FYcComputedWeaponStats& Stats)
+{
+#define YC_WEAPON_STAT_READ(Field, TagName) Set(EYcWeaponStat::Field, static_cast<float>(Stats.Field));
+	YC_WEAPON_STAT_LIST(YC_WEAPON_STAT_READ)
+#undef YC_WEAPON_STAT_READ
+}
+
+void FYcWeaponStatValues::WriteTo(FYcComputedWeaponStats& Stats) const
+{
+#define YC_WEAPON_STAT_WRITE(Field, TagName) Stats.Field = static_cast<decltype(Stats.Field)>(Get(EYcWeaponStat::Field));
+	YC_WEAPON_STAT_LIST(YC_WEAPON_STAT_WRITE)
+#undef YC_WEAPON_STAT_WRITE
+}
+
+// ==================== 性能对比 ====================
+
+namespace YcWeaponStatTableCommands
+{
+	/**
+	 * 改造前的 ApplyAttachmentModifiers：每个属性都由字符串构造 FName 并向 TagManager 请求Tag，
+	 * 命中区域倍率在区域Tag与属性Tag之间做字符串替换
+	 */
+	static void LegacyApplyAttachmentModifiers(const UYcWeaponAttachmentComponent& Attachments, const TArray<FString>& TagStrings,
+		FYcComputedWeaponStats& Stats)
+	{
+#define YC_LEGACY_APPLY_MODIFIER(Field, TagName) \
+		Stats.Field = static_cast<decltype(Stats.Field)>(Attachments.CalculateFinalStatValue( \
+			FGameplayTag::RequestGameplayTag(FName(*TagStrings[static_cast<int32>(EYcWeaponStat::Field)])), Stats.Field));
+		YC_WEAPON_STAT_LIST(YC_LEGACY_APPLY_MODIFIER)
+#undef YC_LEGACY_APPLY_MODIFIER
+
+		if (!Stats.HitZoneDamageMultipliers.IsEmpty())
+		{
+			TMap<FGameplayTag, float> BaseMultipliers;
+			for (const TPair<FGameplayTag, float>& Pair : Stats.HitZoneDamageMultipliers)
+			{
+				const FString StatTagString = Pair.Key.ToString().Replace(TEXT("Gameplay.Character.Zone"), TEXT("Weapon.Stat.Damage.Zone"));
+				const FGameplayTag StatTag = FGameplayTag::RequestGameplayTag(FName(*StatTagString), false);
+				if (StatTag.IsValid())
+				{
+					BaseMultipliers.Add(StatTag, Pair.Value);
+				}
+			}
+
+			for (const TPair<FGameplayTag, float>& Pair : Attachments.CalculateFinalStatValues(BaseMultipliers))
+			{
+				const FString ZoneTagString = Pair.Key.ToString().Replace(TEXT("Weapon.Stat.Damage.Zone"), TEXT("Gameplay.Character.Zone"));
+				const FGameplayTag ZoneTag = FGameplayTag::RequestGameplayTag(FName(*ZoneTagString), false);
+				if (ZoneTag.IsValid())
+				{
+					Stats.HitZoneDamageMultipliers.Add(ZoneTag, Pair.Value);
+				}
+			}
+		}
+	}
+
+	/**
+	 * 在真实的武器实例上对比改造前后的配件属性计算开销，并检查两者结果一致
+	 * 优先使用当前世界中已有的武器实例（含已安装配件），没有时创建一个临时实例
+	 * 用法：Yc.Weapon.BenchmarkStatTable [每个实例的重复次数，默认10000]
+	 */
+	static void BenchmarkStatTable(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumIterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+		TArray<UYcHitScanWeaponInstance*> Weapons;
+		for (TObjectIterator<UYcHitScanWeaponInstance> It; It; ++It)
+		{
+			if (!It->IsTemplate() && It->GetWorld() == World && It->GetAttachmentComponent())
+			{
+				Weapons.Add(*It);
+			}
+		}
+
+		UYcHitScanWeaponInstance* TransientWeapon = nullptr;
+		if (Weapons.IsEmpty())
+		{
+			TransientWeapon = NewObject<UYcHitScanWeaponInstance>(GetTransientPackage());
+			TransientWeapon->SetAttachmentComponent(NewObject<UYcWeaponAttachmentComponent>(TransientWeapon));
+			Weapons.Add(TransientWeapon);
+		}
+
+		TArray<FString> TagStrings;
+		TagStrings.Reserve(YcWeaponStat::Num);
+		for (int32 StatIndex = 0; StatIndex < YcWeaponStat::Num; ++StatIndex)
+		{
+			TagStrings.Add(YcWeaponStat::GetStatTag(static_cast<EYcWeaponStat>(StatIndex)).ToString());
+		}
+
+		double LegacyMs = 0.0;
+		double TableMs = 0.0;
+		int32 NumMismatches = 0;
+
+		for (UYcHitScanWeaponInstance* Weapon : Weapons)
+		{
+			const UYcWeaponAttachmentComponent& Attachments = *Weapon->GetAttachmentComponent();
+			const FYcComputedWeaponStats SavedStats = Weapon->ComputedStats;
+			const FYcWeaponStatValues SavedValues = Weapon->StatValues;
+
+			FYcComputedWeaponStats LegacyStats;
+			const double LegacyStart = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				LegacyStats = SavedStats;
+				LegacyApplyAttachmentModifiers(Attachments, TagStrings, LegacyStats);
+			}
+			LegacyMs += (FPlatformTime::Seconds() - LegacyStart) * 1000.0;
+
+			// 与 RecalculateStats 相同：先读入扁平数组，再应用修改器
+			const double TableStart = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Weapon->ComputedStats = SavedStats;
+				Weapon->StatValues.ReadFrom(SavedStats);
+				Weapon->ApplyAttachmentModifiers();
+			}
+			TableMs += (FPlatformTime::Seconds() - TableStart) * 1000.0;
+
+			// 两种方式的结果必须一致
+			FYcWeaponStatValues LegacyValues;
+			LegacyValues.ReadFrom(LegacyStats);
+			for (int32 StatIndex = 0; StatIndex < YcWeaponStat::Num; ++StatIndex)
+			{
+				if (!FMath::IsNearlyEqual(LegacyValues[StatIndex], Weapon->StatValues[StatIndex]))
+				{
+					UE_LOG(LogYcShooterCore, Error, TEXT("Yc.Weapon.BenchmarkStatTable: %s 的属性 %s 不一致 (旧 %f, 新 %f)"),
+						*GetNameSafe(Weapon), *TagStrings[StatIndex], LegacyValues[StatIndex], Weapon->StatValues[StatIndex]);
+					++NumMismatches;
+				}
+			}
+			if (!LegacyStats.HitZoneDamageMultipliers.OrderIndependentCompareEqual(Weapon->ComputedStats.HitZoneDamageMultipliers))
+			{
+				UE_LOG(LogYcShooterCore, Error, TEXT("Yc.Weapon.BenchmarkStatTable: %s 的命中区域倍率不一致"), *GetNameSafe(Weapon));
+				++NumMismatches;
+			}
+
+			Weapon->ComputedStats = SavedStats;
+			Weapon->StatValues = SavedValues;
+		}
+
+		if (TransientWeapon)
+		{
+			TransientWeapon->MarkAsGarbage();
+		}
+
+		const int32 NumCalls = Weapons.Num() * NumIterations;
+		UE_LOG(LogYcShooterCore, Display,
+			TEXT("Yc.Weapon.BenchmarkStatTable: %s (%d 个武器实例%s, 每个 %d 次, %d 个属性, 不一致 %d)"),
+			NumMismatches == 0 ? TEXT("PASSED") : TEXT("FAILED"), Weapons.Num(), TransientWeapon ? TEXT("(临时实例，无配件)") : TEXT(""),
+			NumIterations, YcWeaponStat::Num, NumMismatches);
+		UE_LOG(LogYcShooterCore, Display, TEXT("  字符串查Tag: 共 %.3f ms, 每次 %.3f us"), LegacyMs, LegacyMs * 1000.0 / NumCalls);
+		UE_LOG(LogYcShooterCore, Display, TEXT("  属性表:     共 %.3f ms, 每次 %.3f us"), TableMs, TableMs * 1000.0 / NumCalls);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkStatTable(
+		TEXT("Yc.Weapon.BenchmarkStatTable"),
+		TEXT("在武器实例上对比改造前后应用配件属性修改器的耗时，并检查结果一致。参数：每个实例的重复次数(默认10000)"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkStatTable));
+}
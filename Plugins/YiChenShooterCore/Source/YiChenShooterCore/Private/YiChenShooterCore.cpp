@@ -3,6 +3,7 @@
 #include "YiChenShooterCore.h"
 
 #include "GameplayTagsManager.h"
+#include "Weapons/YcWeaponStatTable.h"
 
 #define LOCTEXT_NAMESPACE "FYiChenShooterCoreModule"
 
@@ -13,6 +14,9 @@ void FYiChenShooterCoreModule::StartupModule()
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 	// 扫描插件Config/Tags目录下的GameplayTag配置文件
 	UGameplayTagsManager::Get().AddTagIniSearchPath(FPaths::ProjectPluginsDir() / TEXT("YiChenShooterCore/Config/Tags"));
+
+	// 缓存武器属性表的原生Tag，之后重新计算武器数值时不再查询TagManager
+	YcWeaponStat::InitializeStatTable();
 }
 
 void FYiChenShooterCoreModule::ShutdownModule()
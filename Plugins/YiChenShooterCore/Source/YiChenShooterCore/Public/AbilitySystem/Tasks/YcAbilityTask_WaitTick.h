@@ -0,0 +1,35 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "YcAbilityTask_WaitTick.generated.h"
+
+/**
+ * 每帧触发的 AbilityTask
+ *
+ * 在技能激活期间每帧回调一次，技能结束时自动销毁。
+ * 用于需要逐帧推进状态的技能逻辑（如射击调度器），避免每帧重新设置 FTimer。
+ *
+ * 仅提供 C++ 原生委托，使用方式：
+ *   UYcAbilityTask_WaitTick* Task = UYcAbilityTask_WaitTick::WaitTick(this);
+ *   Task->OnTick.AddUObject(this, &ThisClass::HandleTick);
+ *   Task->ReadyForActivation();
+ */
+UCLASS()
+class YICHENSHOOTERCORE_API UYcAbilityTask_WaitTick : public UAbilityTask
+{
+	GENERATED_BODY()
+
+public:
+	UYcAbilityTask_WaitTick(const FObjectInitializer& ObjectInitializer);
+
+	/** 创建每帧触发的 Task */
+	static UYcAbilityTask_WaitTick* WaitTick(UGameplayAbility* OwningAbility, FName TaskInstanceName = NAME_None);
+
+	virtual void TickTask(float DeltaTime) override;
+
+	/** 每帧回调，参数为帧间隔时间 */
+	TMulticastDelegate<void(float)> OnTick;
+};
@@ -86,6 +86,53 @@ struct YICHENSHOOTERCORE_API FYcStatModifier
 	int32 Priority;
 };
 
+/**
+ * FYcStatModifierIndex - 按属性索引的修改器缓存
+ * 
+ * 所有修改器按属性分段存放在一段连续内存中，每段已按 Priority 排序。
+ * 修改器会同时登记到其 StatTag 及所有父Tag下，与 MatchesTag 的层级匹配语义保持一致。
+ * 由配件组件在配件安装/卸载/调校变化时整体重建，查询时无内存分配。
+ */
+struct YICHENSHOOTERCORE_API FYcStatModifierIndex
+{
+	/** 清空索引（保留已分配的内存） */
+	void Reset();
+
+	/** 添加一个修改器，重建期间调用 */
+	void Add(const FYcStatModifier& Modifier);
+
+	/** 结束重建：按属性分段并在段内按优先级排序 */
+	void Finalize();
+
+	/** 获取指定属性的修改器（已排序），不存在时返回空 */
+	TConstArrayView<FYcStatModifier> Find(const FGameplayTag& StatTag) const;
+
+	/** 修改器总数（含父Tag下的重复登记） */
+	int32 Num() const { return Modifiers.Num(); }
+
+	/**
+	 * 将一组已排序的修改器应用到基础值
+	 * Override 取最后一个并直接覆盖；否则先累加 Add，再乘以 (1 + Multiply之和)
+	 */
+	static float Evaluate(TConstArrayView<FYcStatModifier> InModifiers, float BaseValue);
+
+private:
+	struct FSpan
+	{
+		int32 Start = 0;
+		int32 Num = 0;
+	};
+
+	/** 重建期间的 (登记Tag, 修改器) 列表，按添加顺序 */
+	TArray<TPair<FGameplayTag, FYcStatModifier>> PendingEntries;
+
+	/** 按属性分段的修改器连续缓冲区 */
+	TArray<FYcStatModifier> Modifiers;
+
+	/** 属性Tag -> 在 Modifiers 中的分段 */
+	TMap<FGameplayTag, FSpan> Spans;
+};
+
 
 /**
  * FYcAttachmentTuningParam - 配件调校参数定义
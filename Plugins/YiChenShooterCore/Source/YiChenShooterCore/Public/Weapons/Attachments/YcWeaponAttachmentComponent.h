@@ -190,6 +190,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Attachment|Stats")
 	TArray<FYcStatModifier> GetModifiersForStat(FGameplayTag StatTag) const;
 
+	/**
+	 * 获取指定属性的所有修改器（C++ 版本，无内存分配）
+	 * 返回的视图指向内部索引，配件变化后失效
+	 */
+	TConstArrayView<FYcStatModifier> FindModifiersForStat(FGameplayTag StatTag) const;
+
 	/**
 	 * 计算属性最终值
 	 * 
@@ -305,6 +311,15 @@ protected:
 	/** 是否已初始化 */
 	bool bInitialized = false;
 
+	/** 按属性索引的修改器缓存，配件变化时在 NotifyStatsChanged 中重建 */
+	FYcStatModifierIndex ModifierIndex;
+
+	/** 修改器索引重建时是否有已安装配件的定义尚未解析，为 true 时定时重试，解析后重新重建 */
+	bool bModifierIndexDirty = false;
+
+	/** 重试解析配件定义的定时器 */
+	FTimerHandle ModifierIndexRetryTimer;
+
 	// ════════════════════════════════════════════════════════════════════════
 	// 内部函数
 	// ════════════════════════════════════════════════════════════════════════
@@ -312,9 +327,15 @@ protected:
 	/** 查找槽位索引 */
 	int32 FindSlotIndex(FGameplayTag SlotType) const;
 
-	/** 通知武器实例重算属性 */
+	/** 重建修改器索引并通知武器实例重算属性 */
 	void NotifyStatsChanged();
 
+	/** 根据已安装配件及其调校值重建修改器索引 */
+	void RebuildModifierIndex();
+
+	/** 定时重试解析配件定义，全部解析后重建修改器索引并通知武器实例重算属性 */
+	void RetryDirtyModifierIndex();
+
 	/** 
 	 * 从 DataRegistry 获取配件定义
 	 * @param AttachmentId 配件的 DataRegistry ID
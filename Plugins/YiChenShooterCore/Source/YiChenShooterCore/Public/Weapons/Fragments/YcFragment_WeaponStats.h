@@ -53,6 +53,84 @@ struct YICHENSHOOTERCORE_API FYcRecoilPatternPoint
 	float Yaw;
 };
 
+/**
+ * FYcWeaponStatsLookupTables - 武器数值查找表
+ * 
+ * 由 FYcFragment_WeaponStats 在加载时烘焙，同一武器定义的所有实例共享：
+ * - 伤害衰减：将衰减曲线按固定分辨率采样，运行时线性插值，不再逐次求值 RichCurve
+ * - 弹道轨迹：Pitch/Yaw 连续存放，循环区间预先计算，运行时直接按下标取值
+ * - 命中区域：区域 Tag 对应的配件属性 Tag（Gameplay.Character.Zone.X -> Weapon.Stat.Damage.Zone.X）
+ */
+struct YICHENSHOOTERCORE_API FYcWeaponStatsLookupTables
+{
+	/** 衰减曲线采样段数（采样点数 = 段数 + 1） */
+	static constexpr int32 FalloffResolution = 128;
+
+	/** 查找表与衰减曲线原值之间允许的最大插值误差 */
+	static constexpr float FalloffErrorTolerance = 0.01f;
+
+	/** 烘焙衰减曲线，曲线为空时不衰减 */
+	void BakeDamageFalloff(const FRichCurve* Curve);
+
+	/** 烘焙弹道轨迹 */
+	void BakeRecoilPattern(TConstArrayView<FYcRecoilPatternPoint> Pattern, int32 LoopStart);
+
+	/** 烘焙命中区域 Tag 到配件属性 Tag 的映射，没有对应属性 Tag 的区域不参与配件修正 */
+	void BakeHitZoneStatTags(const TMap<FGameplayTag, float>& HitZoneMultipliers);
+
+	/**
+	 * 查询伤害衰减倍率
+	 * @param DistancePercent 距离百分比（0-1，相对于最大射程）
+	 * @return 伤害倍率（0-1）
+	 */
+	float EvaluateDamageFalloff(float DistancePercent) const
+	{
+		if (DamageFalloff.IsEmpty())
+		{
+			return 1.0f;
+		}
+
+		const float Position = FMath::Clamp(DistancePercent, 0.0f, 1.0f) * FalloffResolution;
+		const int32 Index = FMath::Min(static_cast<int32>(Position), FalloffResolution - 1);
+		return FMath::Lerp(DamageFalloff[Index], DamageFalloff[Index + 1], Position - Index);
+	}
+
+	/** 查询第 ShotIndex 发的弹道轨迹点，超出轨迹长度后按循环区间取值 */
+	FYcRecoilPatternPoint GetRecoilPatternPoint(int32 ShotIndex) const
+	{
+		const int32 NumPoints = RecoilPitch.Num();
+		if (NumPoints == 0 || ShotIndex < 0)
+		{
+			return FYcRecoilPatternPoint();
+		}
+
+		const int32 Index = ShotIndex < NumPoints ? ShotIndex : RecoilLoopStart + (ShotIndex - NumPoints) % RecoilLoopLength;
+		return FYcRecoilPatternPoint(RecoilPitch[Index], RecoilYaw[Index]);
+	}
+
+	bool HasRecoilPattern() const { return !RecoilPitch.IsEmpty(); }
+
+	/** 命中区域 Tag -> 配件属性 Tag */
+	TConstArrayView<TPair<FGameplayTag, FGameplayTag>> GetHitZoneStatTags() const { return HitZoneStatTags; }
+
+	/** 是否已烘焙 */
+	bool bBaked = false;
+
+	/** 烘焙时在采样点之间测得的最大插值误差（相对曲线原值） */
+	float MaxFalloffError = 0.0f;
+
+private:
+	/** 衰减倍率采样（已限制在 0-1），为空表示不衰减 */
+	TArray<float> DamageFalloff;
+
+	TArray<float> RecoilPitch;
+	TArray<float> RecoilYaw;
+	int32 RecoilLoopStart = 0;
+	int32 RecoilLoopLength = 1;
+
+	TArray<TPair<FGameplayTag, FGameplayTag>> HitZoneStatTags;
+};
+
 
 /**
  * FYcFragment_WeaponStats - 武器核心数值配置Fragment
@@ -474,6 +552,22 @@ struct YICHENSHOOTERCORE_API FYcFragment_WeaponStats : public FYcEquipmentFragme
 		meta=(DisplayName="移动速度乘数", ClampMin=0.1, ClampMax=1.0))
 	float ADSMoveSpeedMultiplier;
 
+	// ════════════════════════════════════════════════════════════════════════
+	// 查找表
+	// ════════════════════════════════════════════════════════════════════════
+
+	/**
+	 * 获取烘焙好的查找表，尚未烘焙时先烘焙
+	 * Fragment 存放在武器定义中，同一定义的所有武器实例共享一份查找表
+	 */
+	const FYcWeaponStatsLookupTables& GetLookupTables() const;
+
+	/** 根据当前配置重新烘焙查找表（编辑器中修改曲线或弹道后调用） */
+	void BakeLookupTables() const;
+
+	/** 加载（含 Cook 后的资产）完成时烘焙查找表 */
+	void PostSerialize(const FArchive& Ar);
+
 	// ════════════════════════════════════════════════════════════════════════
 	// Fragment 接口
 	// ════════════════════════════════════════════════════════════════════════
@@ -483,4 +577,17 @@ struct YICHENSHOOTERCORE_API FYcFragment_WeaponStats : public FYcEquipmentFragme
 		return FString::Printf(TEXT("WeaponStats: Damage=%.1f, FireRate=%.0f, MagSize=%d"), 
 			BaseDamage, FireRate, MagazineSize);
 	}
+
+private:
+	/** 烘焙结果，运行时数据不参与序列化 */
+	mutable FYcWeaponStatsLookupTables LookupTables;
+};
+
+template<>
+struct TStructOpsTypeTraits<FYcFragment_WeaponStats> : public TStructOpsTypeTraitsBase2<FYcFragment_WeaponStats>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
 };
@@ -0,0 +1,192 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "YcLagCompensationSubsystem.generated.h"
+
+class AController;
+class APawn;
+struct FHitResult;
+
+/**
+ * 单个 Pawn 在某一时刻的命中体（胶囊体）
+ * 胶囊体轴向固定为世界 Z 轴（与 ACharacter 的胶囊体一致）
+ */
+struct YICHENSHOOTERCORE_API FYcRewindHitVolume
+{
+	FVector Center = FVector::ZeroVector;
+	float Radius = 0.0f;
+	float HalfHeight = 0.0f;
+
+	bool IsValid() const { return Radius > 0.0f; }
+};
+
+/**
+ * FYcRewindHistory - 命中体回溯历史（环形缓冲区）
+ *
+ * 内存布局：
+ * - 帧数(FrameCapacity) × 槽位数(SlotCapacity) 固定容量，初始化后不再分配内存
+ * - 每个字段单独一段连续数组(SoA)，下标为 Frame * SlotCapacity + Slot
+ *   回溯单个槽位时只访问需要的字段，缓存友好
+ * - FrameTimes 按写入顺序单调递增，逻辑下标 0 为最旧帧，查找使用二分 O(log n)
+ *
+ * 空槽位的 Radius 为 0，表示该帧没有有效的命中体
+ */
+struct YICHENSHOOTERCORE_API FYcRewindHistory
+{
+	/** 初始化容量并清空历史 */
+	void Initialize(int32 InFrameCapacity, int32 InSlotCapacity);
+
+	/** 开始写入新的一帧，帧满时覆盖最旧的一帧，返回物理帧下标 */
+	int32 BeginFrame(double Time);
+
+	/** 写入指定物理帧中某个槽位的命中体 */
+	void WriteVolume(int32 PhysicalFrame, int32 Slot, const FYcRewindHitVolume& Volume);
+
+	/** 清除某个槽位在所有帧中的数据（槽位被重新分配给其他 Pawn 时调用） */
+	void ClearSlot(int32 Slot);
+
+	/**
+	 * 获取槽位在指定时刻的命中体，相邻两帧之间线性插值
+	 * 时间超出历史范围时钳制到最旧/最新帧
+	 * @return 是否找到有效的命中体
+	 */
+	bool SampleVolume(int32 Slot, double Time, FYcRewindHitVolume& OutVolume) const;
+
+	int32 GetNumFrames() const { return NumFrames; }
+	int32 GetSlotCapacity() const { return SlotCapacity; }
+	double GetOldestTime() const { return NumFrames > 0 ? FrameTimes[ToPhysicalFrame(0)] : 0.0; }
+	double GetNewestTime() const { return NumFrames > 0 ? FrameTimes[ToPhysicalFrame(NumFrames - 1)] : 0.0; }
+
+	/** 占用的内存字节数（固定） */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 ToPhysicalFrame(int32 LogicalFrame) const { return (HeadFrame + LogicalFrame) % FrameCapacity; }
+	int32 ToIndex(int32 PhysicalFrame, int32 Slot) const { return PhysicalFrame * SlotCapacity + Slot; }
+
+	/** 二分查找最后一个时间 <= Time 的逻辑帧下标，Time 早于最旧帧时返回 INDEX_NONE */
+	int32 FindLogicalFrameAtOrBefore(double Time) const;
+
+	bool ReadVolume(int32 PhysicalFrame, int32 Slot, FYcRewindHitVolume& OutVolume) const;
+
+	int32 FrameCapacity = 0;
+	int32 SlotCapacity = 0;
+	int32 HeadFrame = 0;
+	int32 NumFrames = 0;
+
+	TArray<double> FrameTimes;
+	TArray<float> CenterX;
+	TArray<float> CenterY;
+	TArray<float> CenterZ;
+	TArray<float> Radius;
+	TArray<float> HalfHeight;
+};
+
+/**
+ * UYcLagCompensationSubsystem - 服务端延迟补偿子系统
+ *
+ * 每个游戏世界一个实例，仅在拥有网络权威的世界(服务器/单机)中工作：
+ * 1. 每帧 Actor Tick 结束后记录所有 Pawn 的命中体快照到 FYcRewindHistory
+ * 2. 服务端收到客户端上报的命中时，按射击者的 RTT/2 + 客户端插值延迟计算回溯时刻，
+ *    以服务端视点修正射线起点后，对回溯后的命中体重新做射线检测
+ *
+ * 客户端上报的数据只采信射击方向，射线起点、射程和回溯时刻均由服务端决定。
+ * 只对 Pawn 命中做回溯校验，场景命中（墙体等静态物体）不需要回溯，直接接受。
+ *
+ * 相关控制台变量：
+ * - Yc.LagCompensation.Enabled              是否启用命中校验
+ * - Yc.LagCompensation.MaxRewindTime        最大回溯时间（秒）
+ * - Yc.LagCompensation.InterpDelay          客户端模拟代理的插值延迟（秒）
+ * - Yc.LagCompensation.HitTolerance         命中判定容差（uu）
+ * - Yc.LagCompensation.TraceStartTolerance  射线起点与服务端视点的最大偏差（uu）
+ */
+UCLASS()
+class YICHENSHOOTERCORE_API UYcLagCompensationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End USubsystem Interface
+
+	/** 是否正在记录回溯历史（仅服务端为 true） */
+	bool IsRecording() const { return bIsRecording; }
+
+	/**
+	 * 校验客户端声明的命中
+	 * @param Hit 客户端上报的命中结果
+	 * @param Shooter 射击者的控制器，用于获取服务端视点和网络延迟
+	 * @param SweepRadius 武器的射线扫描半径
+	 * @param MaxRange 武器的最大射程
+	 * @return 命中是否可信；非 Pawn 命中或无法回溯时返回 true，射击者无效时返回 false
+	 */
+	bool ValidateHit(const FHitResult& Hit, const AController* Shooter, float SweepRadius, float MaxRange) const;
+
+	/**
+	 * 计算射击者开火时所看到的服务器时刻：当前时间 - (RTT/2 + 客户端插值延迟)
+	 * 结果钳制在最大回溯时间和已记录的历史范围内
+	 */
+	double GetRewindTime(const AController* Shooter) const;
+
+	/** 将客户端上报的射线起点钳制到服务端视点附近（Yc.LagCompensation.TraceStartTolerance） */
+	static FVector ClampTraceStart(const FVector& ClientTraceStart, const FVector& ServerViewLocation);
+
+	/**
+	 * 对回溯后的命中体重新做射线检测
+	 * @param Volume 回溯后的命中体
+	 * @param TraceStart 服务端修正后的射线起点
+	 * @param TraceEnd 射线终点
+	 * @param ImpactPoint 客户端上报的命中点，必须同时落在射线和命中体附近
+	 * @param SweepRadius 射线扫描半径
+	 */
+	static bool TraceRewoundVolume(const FYcRewindHitVolume& Volume, const FVector& TraceStart, const FVector& TraceEnd,
+		const FVector& ImpactPoint, float SweepRadius);
+
+	/**
+	 * 获取 Pawn 在指定时刻的命中体
+	 * @return 是否找到有效的历史数据
+	 */
+	bool GetRewoundHitVolume(const APawn* Pawn, double Time, FYcRewindHitVolume& OutVolume) const;
+
+	/** 手动注册需要回溯的 Pawn（生成的 Pawn 会自动注册） */
+	void TrackPawn(APawn* Pawn);
+
+	/** 手动注销 Pawn（销毁的 Pawn 会在下一次快照时自动注销） */
+	void UntrackPawn(const APawn* Pawn);
+
+protected:
+	/** 每帧 Actor Tick 结束后记录快照 */
+	void CaptureSnapshot(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	void OnActorSpawned(AActor* Actor);
+
+	/** 将命中的 Actor 解析为对应的 Pawn（可能是附加在 Pawn 上的武器等） */
+	static const APawn* ResolveHitPawn(const AActor* HitActor);
+
+	static FYcRewindHitVolume BuildHitVolume(const APawn* Pawn);
+
+private:
+	FYcRewindHistory History;
+
+	/** 槽位 -> Pawn，空槽位为默认值 */
+	TArray<TObjectKey<APawn>> SlotPawns;
+
+	/** Pawn -> 槽位 */
+	TMap<TObjectKey<APawn>, int32> PawnToSlot;
+
+	/** 空闲槽位 */
+	TArray<int32> FreeSlots;
+
+	FDelegateHandle PostActorTickHandle;
+	FDelegateHandle ActorSpawnedHandle;
+
+	bool bIsRecording = false;
+};
@@ -70,6 +70,10 @@ struct YICHENSHOOTERCORE_API FYcProjectileInitParams
 	/** 重力缩放 */
 	UPROPERTY(BlueprintReadWrite, Category = "Projectile")
 	float GravityScale = 1.0f;
+
+	/** 碰撞半径，0 表示使用射线检测（仅 UYcProjectileSimulationSubsystem 使用，Actor 子弹使用碰撞组件的半径） */
+	UPROPERTY(BlueprintReadWrite, Category = "Projectile")
+	float CollisionRadius = 5.0f;
 };
 
 /**
@@ -0,0 +1,40 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "YcProjectileSimulationSubsystem.h"
+#include "YcProjectileNetRelay.generated.h"
+
+/**
+ * AYcProjectileNetRelay - 模拟子弹的网络中继
+ *
+ * 由服务端的 UYcProjectileSimulationSubsystem 生成，每个世界一个，始终相关。
+ * 所有模拟子弹共用这一个 Actor 通道，只批量发送生成参数和命中结果，
+ * 客户端收到后转交给本地的模拟子系统。
+ * 生成参数丢失只会少一颗表现用的子弹，使用不可靠多播；命中结果丢失会留下一直飞行的子弹，使用可靠多播。
+ */
+UCLASS(NotPlaceable, Transient)
+class YICHENSHOOTERCORE_API AYcProjectileNetRelay : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	AYcProjectileNetRelay(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** 单次 RPC 最多携带的记录数，避免超过单个网络包的大小 */
+	static constexpr int32 MaxRecordsPerRPC = 64;
+
+	/** 批量发送生成参数 */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastSpawnProjectiles(const TArray<FYcProjectileSpawnRecord>& Records);
+
+	/** 批量发送命中结果，可能先于对应的生成参数到达 */
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastProjectileImpacts(const TArray<FYcProjectileImpact>& Impacts);
+
+protected:
+	/** 获取本地模拟子系统，服务端（含主机）不处理自己发出的记录 */
+	UYcProjectileSimulationSubsystem* GetClientSimulation() const;
+};
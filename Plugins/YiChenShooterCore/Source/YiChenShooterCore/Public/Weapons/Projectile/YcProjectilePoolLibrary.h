@@ -39,7 +39,7 @@ public:
 	 * @param Instigator 发射者
 	 * @param Damage 伤害值
 	 * @param Speed 初始速度
-	 * @return 发射的子弹，如果失败则返回nullptr
+	 * @return 发射的子弹，如果失败或该池配置为数据驱动模拟（UYcProjectileSimulationSettings::SimulatedPoolIDs）则返回nullptr
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ProjectilePool", meta = (WorldContext = "WorldContextObject"))
 	static AYcProjectileBase* FireProjectile(
@@ -54,6 +54,7 @@ public:
 
 	/**
 	 * 快速发射子弹（完整参数版本）
+	 * 配置为数据驱动模拟的池由 UYcProjectileSimulationSubsystem 在服务端发射，返回nullptr
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ProjectilePool", meta = (WorldContext = "WorldContextObject"))
 	static AYcProjectileBase* FireProjectileWithParams(
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "LoadingProcessInterface.h"
+#include "ObjectPoolWarmupScheduler.h"
 #include "YcProjectileBase.h"
 #include "YcProjectilePoolSubsystem.generated.h"
 
@@ -46,6 +48,10 @@ struct YICHENSHOOTERCORE_API FYcProjectilePoolConfig
 	/** 收缩检查间隔（秒） */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool", meta = (ClampMin = "1.0"))
 	float ShrinkCheckInterval = 30.0f;
+
+	/** 预热优先级，数值越大越先预热；相同优先级按预期需求量从大到小 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pool")
+	int32 WarmupPriority = 0;
 };
 
 /**
@@ -92,6 +98,9 @@ struct FYcProjectilePoolData
 	{ 
 		return AllProjectiles.Num() > 0 ? static_cast<float>(ActiveCount) / AllProjectiles.Num() : 0.0f; 
 	}
+
+	/** 预期需求量：取初始大小和历史峰值中较大者，用于安排预热顺序 */
+	int32 GetExpectedDemand() const { return FMath::Max(Config.InitialPoolSize, PeakActiveCount); }
 };
 
 /**
@@ -127,6 +136,9 @@ struct YICHENSHOOTERCORE_API FYcProjectilePoolStats
 	float UsageRate = 0.0f;
 };
 
+/** 分帧预热进度委托，CreatedCount == TotalCount 表示预热完成 */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnProjectilePoolWarmupProgress, int32, CreatedCount, int32, TotalCount);
+
 /**
  * 子弹对象池子系统
  * 
@@ -135,10 +147,11 @@ struct YICHENSHOOTERCORE_API FYcProjectilePoolStats
  * - 动态扩容/收缩
  * - 网络游戏优化
  * - 性能监控和统计
- * - 预热机制
+ * - 分帧预热：WarmupPool 只加入队列，Tick 在每帧 Yc.Projectile.PoolWarmupBudgetMs 的预算内生成，
+ *   按 WarmupPriority、预期需求量排序；调度与通用对象池共用 FObjectPoolWarmupScheduler；预热未完成时加载界面保持显示
  */
 UCLASS()
-class YICHENSHOOTERCORE_API UYcProjectilePoolSubsystem : public UWorldSubsystem
+class YICHENSHOOTERCORE_API UYcProjectilePoolSubsystem : public UTickableWorldSubsystem, public ILoadingProcessInterface
 {
 	GENERATED_BODY()
 
@@ -149,6 +162,15 @@ public:
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 	//~ End USubsystem Interface
 
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	//~ Begin ILoadingProcessInterface
+	virtual bool ShouldShowLoadingScreen(FString& OutReason) const override;
+	//~ End ILoadingProcessInterface
+
 	/**
 	 * 注册一个子弹池
 	 * @param Config 池配置
@@ -181,7 +203,7 @@ public:
 	void ReleaseProjectile(AYcProjectileBase* Projectile);
 
 	/**
-	 * 预热指定池（预先创建对象）
+	 * 预热指定池（加入分帧预热队列）
 	 * @param PoolID 池标识符
 	 * @param Count 预热数量，-1表示使用配置的InitialPoolSize
 	 */
@@ -189,11 +211,33 @@ public:
 	void WarmupPool(FName PoolID, int32 Count = -1);
 
 	/**
-	 * 预热所有已注册的池
+	 * 预热所有已注册的池（加入分帧预热队列）
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ProjectilePool")
 	void WarmupAllPools();
 
+	/**
+	 * 立即完成队列中所有预热，不受每帧预算限制
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ProjectilePool")
+	void FlushWarmup();
+
+	/** 是否还有未完成的预热 */
+	UFUNCTION(BlueprintPure, Category = "ProjectilePool")
+	bool IsWarmingUp() const { return WarmupScheduler.IsWarmingUp(); }
+
+	/** 本轮预热进度 (0.0 - 1.0)，没有预热时为 1.0 */
+	UFUNCTION(BlueprintPure, Category = "ProjectilePool")
+	float GetWarmupProgress() const;
+
+	/**
+	 * 按预算推进一次预热
+	 * 正常情况下由 Tick 调用，测试时也可直接调用
+	 * @param BudgetSeconds 本次可用时间，<=0 表示不限时
+	 * @return 本次生成的子弹数
+	 */
+	int32 ProcessWarmup(double BudgetSeconds);
+
 	/**
 	 * 获取池统计信息
 	 * @param PoolID 池标识符
@@ -231,6 +275,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "ProjectilePool")
 	bool HasPool(FName PoolID) const { return Pools.Contains(PoolID); }
 
+	/** 分帧预热进度委托，进度变化时广播 */
+	UPROPERTY(BlueprintAssignable, Category = "ProjectilePool|Events")
+	FOnProjectilePoolWarmupProgress OnWarmupProgress;
+
 protected:
 	/** 创建单个子弹实例 */
 	AYcProjectileBase* CreateProjectileInstance(const FYcProjectilePoolConfig& Config);
@@ -238,6 +286,16 @@ protected:
 	/** 扩容池 */
 	void GrowPool(FName PoolID, int32 GrowthAmount);
 
+	/**
+	 * 生成子弹并加入池
+	 * 生成期间不持有池数据的引用，每颗生成后重新查找池
+	 * @return 生成的数量
+	 */
+	int32 AddProjectilesToPool(FName PoolID, int32 Count);
+
+	/** 生成一颗子弹加入池（预热调度器回调） */
+	bool CreateWarmupProjectile(FName PoolID);
+
 	/** 收缩池 */
 	void ShrinkPool(FName PoolID);
 
@@ -257,6 +315,9 @@ private:
 	UPROPERTY()
 	TMap<TObjectPtr<AYcProjectileBase>, FName> ProjectileToPoolMap;
 
+	/** 分帧预热调度 */
+	FObjectPoolWarmupScheduler WarmupScheduler;
+
 	/** 收缩检查定时器 */
 	FTimerHandle ShrinkCheckTimerHandle;
 
@@ -0,0 +1,32 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+#include "YcProjectileSimulationSettings.generated.h"
+
+/**
+ * 数据驱动子弹模拟的项目设置（Project Settings -> YiChen Projectile Simulation）
+ *
+ * 说明：
+ * - SimulatedPoolIDs 中的子弹池通过 UYcProjectilePoolLibrary 发射时，改由 UYcProjectileSimulationSubsystem 模拟，
+ *   不再为每颗子弹生成 Actor 和网络通道。
+ * - VisualProxyClass 为非专用服务器上每颗模拟子弹生成的本地表现 Actor。
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "YiChen Projectile Simulation"))
+class YICHENSHOOTERCORE_API UYcProjectileSimulationSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** 表现代理类，为空则不生成（只保留命中事件） */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Visual")
+	TSoftClassPtr<AActor> VisualProxyClass;
+
+	/** 改用数据驱动模拟发射的子弹池ID，UYcProjectilePoolLibrary 对这些池返回 nullptr */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Routing")
+	TArray<FName> SimulatedPoolIDs;
+
+	/** 该子弹池是否改用数据驱动模拟 */
+	bool IsSimulatedPool(FName PoolID) const { return SimulatedPoolIDs.Contains(PoolID); }
+};
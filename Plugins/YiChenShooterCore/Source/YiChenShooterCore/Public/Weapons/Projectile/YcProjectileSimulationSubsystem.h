@@ -0,0 +1,243 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/NetSerialization.h"
+#include "YcProjectileBase.h"
+#include "YcProjectileSimulationSubsystem.generated.h"
+
+class AYcProjectileNetRelay;
+
+/**
+ * 模拟子弹的生成参数（网络复制）
+ * 客户端只需要初始状态即可自行推算整条弹道
+ */
+USTRUCT()
+struct YICHENSHOOTERCORE_API FYcProjectileSpawnRecord
+{
+	GENERATED_BODY()
+
+	/** 子弹ID（服务端分配） */
+	UPROPERTY()
+	int32 ProjectileId = INDEX_NONE;
+
+	/** 发射位置 */
+	UPROPERTY()
+	FVector_NetQuantize10 Origin;
+
+	/** 初速度 */
+	UPROPERTY()
+	FVector_NetQuantize Velocity;
+
+	/** 最大速度 */
+	UPROPERTY()
+	float MaxSpeed = 0.0f;
+
+	/** 重力缩放，0 表示不受重力影响 */
+	UPROPERTY()
+	float GravityScale = 0.0f;
+
+	/** 存活时间 */
+	UPROPERTY()
+	float LifeSpan = 0.0f;
+
+	/** 碰撞半径，0 表示使用射线检测 */
+	UPROPERTY()
+	float CollisionRadius = 0.0f;
+
+	/** 发射时的服务器时间，客户端据此补偿网络延迟 */
+	UPROPERTY()
+	double SpawnServerTime = 0.0;
+
+	/** 发射者 */
+	UPROPERTY()
+	TObjectPtr<AActor> Instigator;
+};
+
+/**
+ * 模拟子弹的命中结果（网络复制）
+ */
+USTRUCT(BlueprintType)
+struct YICHENSHOOTERCORE_API FYcProjectileImpact
+{
+	GENERATED_BODY()
+
+	/** 子弹ID */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile")
+	int32 ProjectileId = INDEX_NONE;
+
+	/** 命中位置 */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile")
+	FVector_NetQuantize10 ImpactPoint;
+
+	/** 命中法线 */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile")
+	FVector_NetQuantizeNormal ImpactNormal;
+
+	/** 命中的Actor */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile")
+	TObjectPtr<AActor> HitActor;
+
+	/** 造成的伤害（仅服务端有效） */
+	UPROPERTY(BlueprintReadOnly, NotReplicated, Category = "Projectile")
+	float AppliedDamage = 0.0f;
+};
+
+/** 模拟子弹命中委托 */
+DECLARE_MULTICAST_DELEGATE_OneParam(FYcOnSimulatedProjectileImpact, const FYcProjectileImpact&);
+
+/**
+ * UYcProjectileSimulationSubsystem - 数据驱动的子弹模拟子系统
+ *
+ * 与每颗子弹一个 AYcProjectileBase 不同，这里所有子弹以 SoA 数组存放
+ * （位置、速度、重力缩放、剩余寿命、发射者等各自一段连续数组），每帧统一推进：
+ * 1. 积分：一次循环更新所有子弹的速度并计算本帧终点
+ * 2. 碰撞：服务端按批次并行执行所有子弹的扫掠检测（碰撞预设与 AYcProjectileBase 相同），
+ *    工作线程只做物理查询，命中结果回到游戏线程统一处理
+ * 3. 移除：命中和超时的子弹用 RemoveAtSwap 从数组中移除
+ *
+ * 网络：
+ * - 不为子弹创建 Actor 通道，只通过 AYcProjectileNetRelay 批量复制生成参数和命中结果
+ * - 客户端根据生成参数自行推算弹道（仅表现），命中以服务端为准
+ * - 命中可能先于生成参数到达，客户端短时间内记住这些子弹ID，丢弃随后到达的生成参数
+ * - 表现层可选：在 UYcProjectileSimulationSettings 中设置 VisualProxyClass 后，
+ *   非专用服务器会为每颗子弹生成一个本地跟随的 Actor
+ * - UYcProjectilePoolLibrary 发射 UYcProjectileSimulationSettings::SimulatedPoolIDs 中的子弹池时会转到本子系统
+ *
+ * 相关控制台变量：
+ * - Yc.Projectile.MaxActive     同时存在的子弹上限
+ * - Yc.Projectile.FrameBudgetMs 每帧模拟预算（毫秒），超出时输出警告
+ * - Yc.Projectile.ParallelSweeps / Yc.Projectile.SweepBatchSize 扫掠检测的并行开关与每批子弹数
+ * 性能测试：Yc.Projectile.Benchmark [数量] [帧数]
+ */
+UCLASS()
+class YICHENSHOOTERCORE_API UYcProjectileSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/**
+	 * 发射一颗模拟子弹（仅服务端）
+	 * @param Params 初始化参数，与对象池子弹共用
+	 * @return 子弹ID，失败返回 INDEX_NONE
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Projectile|Simulation")
+	int32 FireProjectile(const FYcProjectileInitParams& Params);
+
+	/** 当前模拟中的子弹数量 */
+	UFUNCTION(BlueprintPure, Category = "Projectile|Simulation")
+	int32 GetNumProjectiles() const { return ProjectileIds.Num(); }
+
+	/**
+	 * 推进所有子弹
+	 * 正常情况下由 Tick 调用，性能测试时也可直接调用
+	 */
+	void Simulate(float DeltaTime);
+
+	/** 命中事件（服务端为权威命中，客户端为复制下来的命中，可用于播放特效） */
+	FYcOnSimulatedProjectileImpact OnProjectileImpact;
+
+protected:
+	friend class AYcProjectileNetRelay;
+
+	/** 客户端收到生成参数 */
+	void HandleReplicatedSpawns(TConstArrayView<FYcProjectileSpawnRecord> Records);
+
+	/** 客户端收到命中结果 */
+	void HandleReplicatedImpacts(TConstArrayView<FYcProjectileImpact> Impacts);
+
+	/** 将本帧产生的生成参数和命中结果批量发送给客户端 */
+	void FlushNetRecords();
+
+	/** 添加一颗子弹到 SoA 数组，返回下标 */
+	int32 AddProjectile(const FYcProjectileSpawnRecord& Record, float Damage, AController* InstigatorController);
+
+	/** 用 RemoveAtSwap 移除指定下标的子弹 */
+	void RemoveProjectileAt(int32 Index);
+
+	/** 按ID移除子弹，不存在时忽略 */
+	void RemoveProjectileById(int32 ProjectileId);
+
+	/** 服务端处理命中：应用伤害并广播 */
+	void ApplyImpact(FYcProjectileImpact& Impact, const FHitResult& Hit, float Damage, const FVector& Direction,
+		AActor* Instigator, AController* InstigatorController);
+
+	/** 控制台命令：性能测试 */
+	static void RunBenchmark(const TArray<FString>& Args, UWorld* World);
+
+private:
+	// ==================== SoA 数据 ====================
+
+	TArray<int32> ProjectileIds;
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> MaxSpeeds;
+	TArray<float> GravityScales;
+	TArray<float> RemainingLifeSpans;
+	TArray<float> CollisionRadii;
+	TArray<float> Damages;
+	TArray<TWeakObjectPtr<AActor>> Instigators;
+	TArray<TWeakObjectPtr<AController>> InstigatorControllers;
+	TArray<TWeakObjectPtr<AActor>> VisualProxies;
+
+	/** 子弹ID -> 数组下标 */
+	TMap<int32, int32> IdToIndex;
+
+	// ==================== 每帧临时数据（复用内存） ====================
+
+	/** 本帧终点 */
+	TArray<FVector> SweepEnds;
+
+	/** 本帧扫掠检测需要忽略的发射者ID，在游戏线程解析，工作线程只读 */
+	TArray<uint32> SweepIgnoredActorIds;
+
+	/** 本帧扫掠检测结果，仅 SweepHitFlags 非 0 的元素有效 */
+	TArray<FHitResult> SweepHits;
+	TArray<uint8> SweepHitFlags;
+
+	/** 本帧需要移除的下标（升序） */
+	TArray<int32> PendingRemovals;
+
+	/** 本帧命中（下标, 命中结果） */
+	TArray<TPair<int32, FHitResult>> PendingHits;
+
+	// ==================== 网络 ====================
+
+	/** 待发送的生成参数 */
+	TArray<FYcProjectileSpawnRecord> PendingSpawnRecords;
+
+	/** 待发送的命中结果 */
+	TArray<FYcProjectileImpact> PendingImpactRecords;
+
+	/** 客户端：命中先于生成参数到达的子弹ID -> 过期时间，用于丢弃迟到的生成参数 */
+	TMap<int32, double> RecentImpactExpireTimes;
+
+	/** 服务端生成的网络中继 */
+	TWeakObjectPtr<AYcProjectileNetRelay> NetRelay;
+
+	/** 表现代理类，开始游戏时从 UYcProjectileSimulationSettings 加载，为空则不生成 */
+	UPROPERTY(Transient)
+	TSubclassOf<AActor> VisualProxyClass;
+
+	int32 NextProjectileId = 0;
+
+	/** 是否由本端计算命中（服务器/单机） */
+	bool bHasAuthority = false;
+
+	/** 是否生成表现代理（非专用服务器） */
+	bool bSpawnVisualProxies = false;
+};
@@ -0,0 +1,93 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EYcFireMode : uint8;
+
+/**
+ * 调度产生的单发射击
+ */
+struct YICHENSHOOTERCORE_API FYcScheduledShot
+{
+	/** 精确的射击时间（世界时间，秒），可能位于两帧之间 */
+	double Time = 0.0;
+
+	/** 当前连射中的第几发（从0开始），全自动模式下为连续射击的序号 */
+	int32 BurstShotIndex = 0;
+};
+
+/**
+ * FYcFireScheduler - 基于时间累加器的射击调度器
+ *
+ * 与每发子弹重新设置一次 FTimer 不同，调度器只记录"下一发的精确时间"：
+ * 每帧调用 Advance() 时，输出所有落在本帧内的射击及其亚帧时间戳。
+ * 因此实际射速与帧率无关，低 Tick 率的服务器上高射速武器也不会丢失子弹。
+ *
+ * 射击模式映射：
+ * - 全自动：无限连射，间隔为 ShotInterval
+ * - 半自动：单发后结束
+ * - 连射(按住自动)：每轮 BurstCount 发，轮间隔为 BurstInterval，直到请求停止
+ * - 连射(单次)：一轮 BurstCount 发后结束
+ */
+struct YICHENSHOOTERCORE_API FYcFireScheduler
+{
+	/**
+	 * 开始调度
+	 * @param Now 当前世界时间
+	 * @param LastShotTime 上一发的时间，用于遵守射速限制（连续点按不能超过射速）
+	 * @param FireMode 射击模式
+	 * @param InShotInterval 两发之间的间隔（秒）
+	 * @param InBurstCount 每轮连射的发数（仅连射模式使用）
+	 * @param InBurstInterval 两轮连射之间的间隔（秒）
+	 */
+	void Start(double Now, double LastShotTime, EYcFireMode FireMode, double InShotInterval, int32 InBurstCount, double InBurstInterval);
+
+	/**
+	 * 推进到指定时间，输出所有到期的射击
+	 * @param Now 当前世界时间
+	 * @param MaxShots 单次最多输出的射击数量，超出的部分会被丢弃（防止长时间卡顿后一帧内射出整个弹匣）
+	 * @param OutShots 输出到期的射击，按时间顺序排列
+	 */
+	void Advance(double Now, int32 MaxShots, TArray<FYcScheduledShot, TInlineAllocator<8>>& OutShots);
+
+	/** 立即停止调度 */
+	void Stop() { bActive = false; }
+
+	/**
+	 * 请求在当前连射结束后停止
+	 * 如果当前处于两轮连射之间的等待，会立即停止
+	 */
+	void RequestStopAfterBurst();
+
+	/** 是否仍在调度中 */
+	bool IsActive() const { return bActive; }
+
+	/** 下一发的时间 */
+	double GetNextShotTime() const { return NextShotTime; }
+
+	/** 最近一发的时间 */
+	double GetLastShotTime() const { return LastEmittedShotTime; }
+
+private:
+	double NextShotTime = 0.0;
+	double LastEmittedShotTime = 0.0;
+	double ShotInterval = 0.1;
+	double BurstInterval = 0.1;
+
+	/** 每轮发数，0 表示无限（全自动） */
+	int32 BurstCount = 0;
+
+	/** 当前轮已射出的发数 */
+	int32 ShotsInBurst = 0;
+
+	/** 一轮结束后是否继续下一轮 */
+	bool bRepeatBursts = false;
+
+	/** 本次调度是否已射出过子弹 */
+	bool bHasFired = false;
+
+	bool bStopAfterBurst = false;
+	bool bActive = false;
+};
@@ -3,9 +3,11 @@
 #pragma once
 
 #include "Ability/YcGameplayAbility_FromEquipment.h"
+#include "Weapons/YcFireScheduler.h"
 #include "YcGameplayAbility_HitScanWeapon.generated.h"
 
 class UYcHitScanWeaponInstance;
+class UYcAbilityTask_WaitTick;
 
 /**
  * EYcAbilityTargetingSource - 技能瞄准来源枚举
@@ -40,6 +42,9 @@ enum class EYcAbilityTargetingSource : uint8
  * - 全自动：按住持续射击
  * - 半自动：每次按下射击一发
  * - 点射：每次按下射击固定数量子弹
+ * 
+ * 射击节奏由 FYcFireScheduler 逐帧推进：同一帧内到期的多发子弹会一起检测，
+ * 并打包进同一个 TargetData 中发送给服务器（一帧最多一次 RPC），射速与帧率无关。
  */
 UCLASS()
 class YICHENSHOOTERCORE_API UYcGameplayAbility_HitScanWeapon : public UYcGameplayAbility_FromEquipment
@@ -134,6 +139,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Weapon|Firing|Advanced")
 	void StartHitScanWeaponTargeting(bool bIsAiming = false, bool bIsCrouching = false);
 
+	/**
+	 * 批量射击：对每个射击时间各执行一次射线检测，所有命中打包进同一个 TargetData
+	 * @param ShotTimes 每发子弹的精确射击时间（本地世界时间）
+	 */
+	void StartHitScanWeaponTargetingBatch(TConstArrayView<double> ShotTimes, bool bIsAiming, bool bIsCrouching);
+
 	/**
 	 * 从目标数据中获取命中部位的 GameplayTag
 	 * 用于在应用伤害 GE 时设置 HitZone
@@ -143,6 +154,9 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="Weapon|Damage")
 	FGameplayTag GetHitZoneFromTargetData(const FGameplayAbilityTargetDataHandle& TargetData, int32 Index = 0) const;
+
+	/** 查找第一个命中 Pawn（或附加在 Pawn 上的 Actor）的结果索引，没有则返回 INDEX_NONE */
+	static int32 FindFirstPawnHitResult(const TArray<FHitResult>& HitResults);
 	
 protected:
 	struct FHitScanWeaponFiringInput
@@ -161,18 +175,36 @@ protected:
 	void TraceBulletsInCartridge(const FHitScanWeaponFiringInput& InputData, OUT TArray<FHitResult>& OutHits);
 	FHitResult DoSingleBulletTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHits) const;
 	FHitResult WeaponTrace(const FVector& StartTrace, const FVector& EndTrace, float SweepRadius, bool bIsSimulated, OUT TArray<FHitResult>& OutHitResults) const;
+
+	/**
+	 * 构建武器射线检测的查询参数（忽略列表、物理材质等）
+	 * 同一发子弹的所有弹丸共用一份，避免每颗弹丸重复构建
+	 * @return 射线检测使用的碰撞通道
+	 */
+	ECollisionChannel BuildWeaponTraceParams(bool bIsSimulated, OUT FCollisionQueryParams& OutTraceParams) const;
 	virtual void AddAdditionalTraceIgnoreActors(FCollisionQueryParams& TraceParams) const;
 	virtual ECollisionChannel DetermineTraceChannel(FCollisionQueryParams& TraceParams, bool bIsSimulated) const;
 	void OnTargetDataReadyCallback(const FGameplayAbilityTargetDataHandle& InData, FGameplayTag ApplicationTag);
+
+	/**
+	 * 服务端校验客户端上报的目标数据
+	 * 按服务端根据 RTT 计算的回溯时刻回溯 Pawn 命中体，重新检测命中是否可信
+	 * @param TargetData 客户端上报的目标数据
+	 * @param OutRejectedHits 输出未通过校验的命中索引
+	 */
+	void ValidateClientTargetData(const FGameplayAbilityTargetDataHandle& TargetData, OUT TArray<uint8>& OutRejectedHits) const;
 	
-	static int32 FindFirstPawnHitResult(const TArray<FHitResult>& HitResults);
 	FVector GetWeaponTargetingSourceLocation() const;
 	FTransform GetTargetingTransform(const APawn* SourcePawn, EYcAbilityTargetingSource Source) const;
 
-	/** 执行单次射击 */
-	void FireShot();
-	/** 射击Timer回调 */
-	void OnFireTimerTick();
+	/** 推进射击调度器，射出所有到期的子弹 */
+	void ProcessScheduledShots();
+	/** 射击逐帧回调 */
+	void OnFireTick(float DeltaTime);
+	/** 执行同一帧内到期的一批射击 */
+	void FireShots(TConstArrayView<FYcScheduledShot> Shots);
+	/** 结束射击状态（调度完成或松开射击键） */
+	void FinishFiring();
 	/** 计算射击间隔时间（秒） */
 	float GetFireInterval() const;
 	
@@ -188,9 +220,11 @@ private:
 
 	// 射击状态
 	bool bIsFiring = false;
-	bool bWantsToStopFiring = false;
 	bool bPendingEndAbility = false;  // 等待连射完成后结束技能
-	int32 CurrentBurstShotCount = 0;
-	FTimerHandle FireTimerHandle;
+	FYcFireScheduler FireScheduler;
 	double LastShotTime = 0.0;
+
+	/** 射击期间逐帧推进调度器的 Task */
+	UPROPERTY()
+	TObjectPtr<UYcAbilityTask_WaitTick> FireTickTask;
 };
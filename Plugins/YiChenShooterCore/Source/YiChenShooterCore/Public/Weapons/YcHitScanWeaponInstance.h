@@ -6,11 +6,13 @@
 #include "YcAbilitySourceInterface.h"
 #include "YcWeaponInstance.h"
 #include "Weapons/Fragments/YcFragment_WeaponStats.h"
+#include "Weapons/YcWeaponStatTable.h"
 #include "Tickable.h"
 #include "YcHitScanWeaponInstance.generated.h"
 
 struct FYcRecoilPatternPoint;
 struct FYcFragment_WeaponAttachments;
+class UPhysicalMaterial;
 class UYcWeaponAttachmentComponent;
 
 /**
@@ -194,6 +196,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Weapon|Stats")
 	const FYcComputedWeaponStats& GetComputedStats() const { return ComputedStats; }
 
+	/** 按索引获取可被配件修改的属性值（基础 + 配件修正） */
+	float GetStatValue(EYcWeaponStat Stat) const { return StatValues.Get(Stat); }
+
 	/** 获取基础配置Fragment */
 	const FYcFragment_WeaponStats* GetWeaponStatsFragment() const { return WeaponStatsFragment; }
 
@@ -324,6 +329,9 @@ public:
 	/** 计算后的数值缓存（配件修正后） */
 	FYcComputedWeaponStats ComputedStats;
 
+	/** 可被配件修改的属性扁平数组，与 ComputedStats 中对应字段保持一致 */
+	FYcWeaponStatValues StatValues;
+
 	/** 重新计算数值（配件变化时调用） */
 	void RecalculateStats();
 
@@ -364,6 +372,22 @@ public:
 
 
 private:
+	/** 物理材质对应的命中区域和伤害倍率 */
+	struct FHitZoneEntry
+	{
+		FGameplayTag ZoneTag;
+		float DamageMultiplier = 1.0f;
+	};
+
+	/**
+	 * 物理材质 -> 命中区域缓存
+	 * 每种材质首次命中时解析一次，之后每次命中只需一次哈希查找；数值重算（配件变化）时清空
+	 */
+	mutable TMap<TObjectKey<UPhysicalMaterial>, FHitZoneEntry> HitZoneCache;
+
+	/** 查找物理材质对应的命中区域，未缓存时解析并写入缓存 */
+	const FHitZoneEntry& FindOrResolveHitZone(const UPhysicalMaterial* PhysicalMaterial) const;
+
 	/** 更新扩散状态 */
 	void UpdateSpread(float DeltaSeconds);
 
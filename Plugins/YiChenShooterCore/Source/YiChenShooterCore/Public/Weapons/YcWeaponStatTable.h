@@ -0,0 +1,108 @@
+// Copyright (c) 2025 YiChen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Containers/StaticArray.h"
+
+struct FYcComputedWeaponStats;
+
+/**
+ * 可被配件修改的武器属性列表
+ *
+ * 每一项为 (FYcComputedWeaponStats 字段名, YcWeaponStatTags 中的原生Tag名)
+ * EYcWeaponStat 枚举、属性Tag表以及与 FYcComputedWeaponStats 之间的读写均由此列表展开生成，
+ * 新增可修改属性时只需在此处添加一行（并在 YcWeaponStatTags 中定义对应的原生Tag）
+ */
+#define YC_WEAPON_STAT_LIST(OP) \
+	/* 射击参数 */ \
+	OP(FireRate,                Weapon_Stat_FireRate) \
+	OP(MaxDamageRange,          Weapon_Stat_Range_Max) \
+	OP(BulletTraceSweepRadius,  Weapon_Stat_BulletRadius) \
+	/* 伤害参数 */ \
+	OP(BaseDamage,              Weapon_Stat_Damage_Base) \
+	OP(HeadshotMultiplier,      Weapon_Stat_Damage_HeadshotMultiplier) \
+	OP(ArmorPenetration,        Weapon_Stat_Damage_ArmorPenetration) \
+	/* 弹药参数 */ \
+	OP(MagazineSize,            Weapon_Stat_Magazine_Size) \
+	OP(MaxReserveAmmo,          Weapon_Stat_Magazine_ReserveMax) \
+	OP(ReloadTime,              Weapon_Stat_Reload_Time) \
+	OP(TacticalReloadTime,      Weapon_Stat_Reload_TacticalTime) \
+	/* 扩散参数 */ \
+	OP(HipFireBaseSpread,       Weapon_Stat_Spread_HipFire_Base) \
+	OP(HipFireMaxSpread,        Weapon_Stat_Spread_HipFire_Max) \
+	OP(HipFireSpreadPerShot,    Weapon_Stat_Spread_HipFire_PerShot) \
+	OP(ADSBaseSpread,           Weapon_Stat_Spread_ADS_Base) \
+	OP(ADSMaxSpread,            Weapon_Stat_Spread_ADS_Max) \
+	OP(ADSSpreadPerShot,        Weapon_Stat_Spread_ADS_PerShot) \
+	OP(SpreadRecoveryRate,      Weapon_Stat_Spread_Recovery) \
+	/* 后坐力参数 */ \
+	OP(VerticalRecoilMin,       Weapon_Stat_Recoil_Vertical_Min) \
+	OP(VerticalRecoilMax,       Weapon_Stat_Recoil_Vertical_Max) \
+	OP(HorizontalRecoilMin,     Weapon_Stat_Recoil_Horizontal_Min) \
+	OP(HorizontalRecoilMax,     Weapon_Stat_Recoil_Horizontal_Max) \
+	OP(ADSRecoilMultiplier,     Weapon_Stat_Recoil_ADSMultiplier) \
+	OP(HipFireRecoilMultiplier, Weapon_Stat_Recoil_HipFireMultiplier) \
+	OP(RecoilRecoveryRate,      Weapon_Stat_Recoil_Recovery) \
+	/* 瞄准参数 */ \
+	OP(AimDownSightTime,        Weapon_Stat_ADS_Time) \
+	OP(ADSFOVMultiplier,        Weapon_Stat_ADS_FOVMultiplier) \
+	OP(ADSMoveSpeedMultiplier,  Weapon_Stat_ADS_MoveSpeed)
+
+/**
+ * EYcWeaponStat - 可被配件修改的武器属性索引
+ * 枚举值即为 FYcWeaponStatValues 中的数组下标
+ */
+enum class EYcWeaponStat : uint8
+{
+#define YC_WEAPON_STAT_ENUM(Field, TagName) Field,
+	YC_WEAPON_STAT_LIST(YC_WEAPON_STAT_ENUM)
+#undef YC_WEAPON_STAT_ENUM
+	Count
+};
+
+namespace YcWeaponStat
+{
+	/** 属性数量 */
+	inline constexpr int32 Num = static_cast<int32>(EYcWeaponStat::Count);
+
+	/** 获取属性对应的原生Tag（启动时已解析，无需查询TagManager） */
+	YICHENSHOOTERCORE_API const FGameplayTag& GetStatTag(EYcWeaponStat Stat);
+
+	/**
+	 * 根据Tag精确查找属性
+	 * @return 找到的属性，未找到时返回 EYcWeaponStat::Count
+	 */
+	YICHENSHOOTERCORE_API EYcWeaponStat FindStatByTag(const FGameplayTag& StatTag);
+
+	/** 模块启动时调用，缓存所有属性的原生Tag并建立反向索引 */
+	void InitializeStatTable();
+}
+
+/**
+ * FYcWeaponStatValues - 可修改武器属性的扁平数组
+ *
+ * 按 EYcWeaponStat 下标连续存放，重新计算数值时只需对这段连续内存做一次循环，
+ * 不再有 FName 哈希或 GameplayTag 查询
+ * 整数属性（弹匣容量等）同样以 float 存储，写回 FYcComputedWeaponStats 时截断
+ */
+struct YICHENSHOOTERCORE_API FYcWeaponStatValues
+{
+	FYcWeaponStatValues() : Values(InPlace, 0.0f) {}
+
+	float Get(EYcWeaponStat Stat) const { return Values[static_cast<int32>(Stat)]; }
+	void Set(EYcWeaponStat Stat, float Value) { Values[static_cast<int32>(Stat)] = Value; }
+
+	float& operator[](int32 Index) { return Values[Index]; }
+	float operator[](int32 Index) const { return Values[Index]; }
+
+	/** 从计算后的数值结构体读取所有可修改属性 */
+	void ReadFrom(const FYcComputedWeaponStats& Stats);
+
+	/** 将所有可修改属性写回计算后的数值结构体 */
+	void WriteTo(FYcComputedWeaponStats& Stats) const;
+
+private:
+	TStaticArray<float, YcWeaponStat::Num> Values;
+};
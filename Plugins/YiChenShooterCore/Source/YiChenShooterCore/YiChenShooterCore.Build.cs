@@ -30,6 +30,8 @@ public class YiChenShooterCore : ModuleRules
 				"ModularGameplay", 
 				"YiChenEquipment",
 				"DataRegistry",
+				"CommonLoadingScreen",
+				"YiChenObjectPool",
 				"UMG"
 				// ... add other public dependencies that you statically link with here ...
 			}
@@ -47,6 +49,7 @@ public class YiChenShooterCore : ModuleRules
 				"YiChenGameplay",
 				"YiChenCombatCore",
 				"GameplayAbilities",
+				"GameplayTasks",
 				"GameplayTags",
 				"GameplayMessageRuntime",
 				"YiChenTeams",
@@ -54,7 +57,8 @@ public class YiChenShooterCore : ModuleRules
 				"AIModule",
 				"ModularGameplayActors",
 				"NetCore",
-				"Niagara"
+				"Niagara",
+				"DeveloperSettings"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);